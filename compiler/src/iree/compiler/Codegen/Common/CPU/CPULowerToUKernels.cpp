@@ -63,8 +63,10 @@ class CPULowerToUKernelsPass
     : public impl::CPULowerToUKernelsPassBase<CPULowerToUKernelsPass> {
 public:
   using Base::Base;
-  explicit CPULowerToUKernelsPass(bool skipIntermediateRoundings) {
+  CPULowerToUKernelsPass(bool skipIntermediateRoundings,
+                         bool fastApproximations) {
     this->skipIntermediateRoundings = skipIntermediateRoundings;
+    this->fastApproximations = fastApproximations;
   }
   void getDependentDialects(DialectRegistry &registry) const override {
     registry.insert<IREE::Codegen::IREECodegenDialect>();
@@ -163,7 +165,8 @@ getUKernelGenericReturnTypes(IREE::HAL::ExecutableTargetAttr targetAttr,
 /// into a call to the microkernel.
 static FailureOr<IREE::Codegen::UKernelOpInterface>
 matchDAGForUKernel(RewriterBase &rewriter, linalg::Mmt4DOp op,
-                   bool skipIntermediateRoundings) {
+                   bool skipIntermediateRoundings,
+                   bool /*fastApproximations*/) {
   auto targetAttr = IREE::HAL::ExecutableTargetAttr::lookup(op);
   const char ukernelName[] = "mmt4d";
   if (!targetAttr || !hasUkernel(targetAttr.getConfiguration(), ukernelName)) {
@@ -267,7 +270,8 @@ matchDAGForUKernel(RewriterBase &rewriter, linalg::Mmt4DOp op,
 
 static FailureOr<IREE::Codegen::UKernelOpInterface>
 matchDAGForUKernel(RewriterBase &rewriter, linalg::PackOp op,
-                   bool /*skipIntermediateRoundings*/) {
+                   bool /*skipIntermediateRoundings*/,
+                   bool /*fastApproximations*/) {
   auto targetAttr = IREE::HAL::ExecutableTargetAttr::lookup(op);
   const char ukernelName[] = "pack";
   if (!targetAttr || !hasUkernel(targetAttr.getConfiguration(), ukernelName)) {
@@ -390,7 +394,8 @@ matchDAGForUKernel(RewriterBase &rewriter, linalg::PackOp op,
 
 static FailureOr<IREE::Codegen::UKernelOpInterface>
 matchDAGForUKernel(RewriterBase &rewriter, linalg::UnPackOp op,
-                   bool /*skipIntermediateRoundings*/) {
+                   bool /*skipIntermediateRoundings*/,
+                   bool /*fastApproximations*/) {
   auto targetAttr = IREE::HAL::ExecutableTargetAttr::lookup(op);
   const char ukernelName[] = "unpack";
   if (!targetAttr || !hasUkernel(targetAttr.getConfiguration(), ukernelName)) {
@@ -476,6 +481,56 @@ matchDAGForUKernel(RewriterBase &rewriter, linalg::UnPackOp op,
       genericMicroKernelOp.getOperation());
 }
 
+/// Matches a linalg.softmax over the innermost dimension of a 2D tensor and
+/// converts it into a call to the softmax microkernel, which normalizes one row
+/// at a time. Higher-rank softmax ops are rank-reduced to this form by
+/// CPUPrepareUkernels after tiling the leading dimensions to 1.
+static FailureOr<IREE::Codegen::UKernelOpInterface>
+matchDAGForUKernel(RewriterBase &rewriter, linalg::SoftmaxOp op,
+                   bool /*skipIntermediateRoundings*/,
+                   bool fastApproximations) {
+  auto targetAttr = IREE::HAL::ExecutableTargetAttr::lookup(op);
+  const char ukernelName[] = "softmax";
+  if (!isSoftmaxUkernelCandidate(op)) {
+    return failure();
+  }
+  Value in = op.getInput();
+  Value out = op.getOutput();
+  auto outType = cast<ShapedType>(out.getType());
+  if (outType.getRank() != 2) {
+    return rewriter.notifyMatchFailure(op, "expected output to be 2D");
+  }
+  Type elemType = outType.getElementType();
+  uint32_t flags = 0;
+  if (elemType.isF32()) {
+    flags = IREE_UK_FLAG_NORMALIZE_TYPE_F32F32;
+  } else if (elemType.isF16()) {
+    flags = IREE_UK_FLAG_NORMALIZE_TYPE_F16F16;
+  } else if (elemType.isBF16()) {
+    flags = IREE_UK_FLAG_NORMALIZE_TYPE_BF16BF16;
+  } else {
+    return rewriter.notifyMatchFailure(op, "unsupported element type");
+  }
+  if (fastApproximations) {
+    flags |= IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  }
+
+  Location loc = op.getLoc();
+  Value size0 = tensor::DimOp::create(rewriter, loc, in, 0);
+  Value size1 = tensor::DimOp::create(rewriter, loc, in, 1);
+  Value flagsVal = arith::ConstantOp::create(rewriter, loc,
+                                             rewriter.getI32IntegerAttr(flags));
+  auto fn = getFnNameAndDefAttrs(ukernelName, rewriter, targetAttr);
+  SmallVector<Type> returnTypes =
+      getUKernelGenericReturnTypes(targetAttr, outType);
+  auto genericMicroKernelOp = IREE::Codegen::UKernelGenericOp::create(
+      rewriter, loc, returnTypes, fn.name, in, out,
+      ValueRange{size0, size1, flagsVal},
+      /*fn_def_attrs=*/rewriter.getDictionaryAttr(fn.defAttrs),
+      /*num_strided_outer_dims=*/1);
+  return cast<IREE::Codegen::UKernelOpInterface>(
+      genericMicroKernelOp.getOperation());
+}
 static uint32_t
 getFlagForUserAndOperandTypes(IREE::Encoding::EncodingAttr encoding,
                               ArrayRef<Type> operandTypes) {
@@ -523,7 +578,8 @@ static uint32_t getFlagForIndex(int64_t operandIndex) {
 
 static FailureOr<IREE::Codegen::UKernelOpInterface>
 matchDAGForUKernel(RewriterBase &rewriter, IREE::Codegen::QueryTileSizesOp op,
-                   bool /*skipIntermediateRoundings*/) {
+                   bool /*skipIntermediateRoundings*/,
+                   bool /*fastApproximations*/) {
   auto targetAttr = IREE::HAL::ExecutableTargetAttr::lookup(op);
   const char ukernelName[] = "query_tile_sizes.2d";
   if (!targetAttr || !hasUkernel(targetAttr.getConfiguration(), ukernelName)) {
@@ -604,9 +660,11 @@ using TargetPredicate = std::function<bool(IREE::HAL::ExecutableTargetAttr)>;
 template <typename OpType>
 struct LowerToUKernelPattern : OpRewritePattern<OpType> {
   LowerToUKernelPattern(MLIRContext *context, TargetPredicate targetPredicate,
-                        bool skipIntermediateRoundings = false)
+                        bool skipIntermediateRoundings = false,
+                        bool fastApproximations = false)
       : OpRewritePattern<OpType>(context), targetPredicate(targetPredicate),
-        skipIntermediateRoundings(skipIntermediateRoundings) {}
+        skipIntermediateRoundings(skipIntermediateRoundings),
+        fastApproximations(fastApproximations) {}
 
   LogicalResult matchAndRewrite(OpType op,
                                 PatternRewriter &rewriter) const override {
@@ -615,7 +673,8 @@ struct LowerToUKernelPattern : OpRewritePattern<OpType> {
       return failure();
     }
     FailureOr<IREE::Codegen::UKernelOpInterface> ukernelOp =
-        matchDAGForUKernel(rewriter, op, skipIntermediateRoundings);
+        matchDAGForUKernel(rewriter, op, skipIntermediateRoundings,
+                           fastApproximations);
     if (failed(ukernelOp)) {
       return rewriter.notifyMatchFailure(
           op, "failed to find microkernel op to replace with");
@@ -628,6 +687,7 @@ struct LowerToUKernelPattern : OpRewritePattern<OpType> {
 
   TargetPredicate targetPredicate;
   bool skipIntermediateRoundings;
+  bool fastApproximations;
 };
 
 } // namespace
@@ -652,6 +712,11 @@ void CPULowerToUKernelsPass::runOnOperation() {
                   LowerToUKernelPattern<linalg::PackOp>,
                   LowerToUKernelPattern<linalg::UnPackOp>>(
       context, allTargets, skipIntermediateRoundings);
+  // Softmax is not in the default set of ukernels: unless it is explicitly
+  // requested in the ukernels attribute, it is decomposed and fused with its
+  // neighbors instead. See isSoftmaxUkernelCandidate.
+  patterns.insert<LowerToUKernelPattern<linalg::SoftmaxOp>>(
+      context, allTargets, skipIntermediateRoundings, fastApproximations);
   // These patterns are inherently specific to the VMVX backend.
   patterns.insert<LowerToUKernelPattern<IREE::Codegen::QueryTileSizesOp>>(
       context, isVMVXBackend);
@@ -661,8 +726,10 @@ void CPULowerToUKernelsPass::runOnOperation() {
 }
 
 std::unique_ptr<OperationPass<>>
-createCPULowerToUKernelsPass(bool skipIntermediateRoundings) {
-  return std::make_unique<CPULowerToUKernelsPass>(skipIntermediateRoundings);
+createCPULowerToUKernelsPass(bool skipIntermediateRoundings,
+                             bool fastApproximations) {
+  return std::make_unique<CPULowerToUKernelsPass>(skipIntermediateRoundings,
+                                                  fastApproximations);
 }
 
 } // namespace mlir::iree_compiler
@@ -396,6 +396,52 @@ struct Convert5DUnPackto4DUnPackPattern
   }
 };
 
+/// Pattern to convert linalg.softmax ops over the innermost dimension whose
+/// outer dimensions, except the last one, are all 1 into 2D softmax ops. The
+/// softmax ukernel only takes 2D operands.
+struct ConvertNDSoftmaxTo2DSoftmaxPattern
+    : public OpRewritePattern<linalg::SoftmaxOp> {
+  using Base::Base;
+
+  LogicalResult matchAndRewrite(linalg::SoftmaxOp softmaxOp,
+                                PatternRewriter &rewriter) const override {
+    if (!isSoftmaxUkernelCandidate(softmaxOp)) {
+      return rewriter.notifyMatchFailure(softmaxOp, "not a ukernel candidate");
+    }
+    auto outType = cast<RankedTensorType>(softmaxOp.getOutput().getType());
+    int64_t rank = outType.getRank();
+    if (rank <= 2) {
+      return failure();
+    }
+    for (int64_t dim = 0; dim < rank - 2; ++dim) {
+      if (outType.getDimSize(dim) != 1) {
+        return rewriter.notifyMatchFailure(softmaxOp,
+                                           "outer dims need to be tiled to 1");
+      }
+    }
+
+    Location loc = softmaxOp.getLoc();
+    auto inType = cast<RankedTensorType>(softmaxOp.getInput().getType());
+    auto reducedInType = RankedTensorType::get(
+        inType.getShape().take_back(2), inType.getElementType());
+    auto reducedOutType = RankedTensorType::get(
+        outType.getShape().take_back(2), outType.getElementType());
+    auto reducedIn = tensor::createCanonicalRankReducingExtractSliceOp(
+        rewriter, loc, softmaxOp.getInput(), reducedInType);
+    auto reducedOut = tensor::createCanonicalRankReducingExtractSliceOp(
+        rewriter, loc, softmaxOp.getOutput(), reducedOutType);
+
+    auto newSoftmaxOp = linalg::SoftmaxOp::create(
+        rewriter, loc, TypeRange{reducedOutType}, reducedIn, reducedOut,
+        /*dimension=*/1);
+
+    auto insertSliceOp = tensor::createCanonicalRankReducingInsertSliceOp(
+        rewriter, loc, newSoftmaxOp.getResult()[0], softmaxOp.getOutput());
+    rewriter.replaceOp(softmaxOp, insertSliceOp);
+    return success();
+  }
+};
+
 struct CPUPrepareUkernelsPass
     : public impl::CPUPrepareUkernelsPassBase<CPUPrepareUkernelsPass> {
   void getDependentDialects(DialectRegistry &registry) const override {
@@ -427,6 +473,9 @@ void CPUPrepareUkernelsPass::runOnOperation() {
     tileNonPackedDimsFor5DPUnpackOps(rewriter, funcOp);
     patterns.add<Convert5DUnPackto4DUnPackPattern>(ctx);
   }
+  if (targetAttr && hasUkernel(targetAttr.getConfiguration(), "softmax")) {
+    patterns.add<ConvertNDSoftmaxTo2DSoftmaxPattern>(ctx);
+  }
 
   // Canonicalize extract and insert slice ops created during the conversion.
   tensor::populateMergeConsecutiveInsertExtractSlicePatterns(patterns);
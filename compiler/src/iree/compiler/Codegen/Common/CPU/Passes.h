@@ -24,7 +24,8 @@ namespace mlir::iree_compiler {
 //------------------------------------------------------------------------------
 
 std::unique_ptr<OperationPass<>>
-createCPULowerToUKernelsPass(bool skipIntermediateRoundings);
+createCPULowerToUKernelsPass(bool skipIntermediateRoundings,
+                             bool fastApproximations = false);
 
 /// Adds CPU bufferization passes to the pipeline.
 void addCPUBufferizePasses(OpPassManager &funcPassManager);
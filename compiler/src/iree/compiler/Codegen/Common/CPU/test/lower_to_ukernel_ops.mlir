@@ -1,5 +1,6 @@
 // RUN: iree-opt --split-input-file --pass-pipeline="builtin.module(func.func(iree-codegen-cpu-lower-to-ukernels{skip-intermediate-roundings=true},cse,canonicalize))" %s | FileCheck %s
 // RUN: iree-opt --split-input-file --pass-pipeline="builtin.module(func.func(iree-codegen-cpu-lower-to-ukernels{skip-intermediate-roundings=false},cse,canonicalize))" %s | FileCheck %s --check-prefix=NOSKIPROUND
+// RUN: iree-opt --split-input-file --pass-pipeline="builtin.module(func.func(iree-codegen-cpu-lower-to-ukernels{fast-approximations=true},cse,canonicalize))" %s | FileCheck %s --check-prefix=FASTAPPROX
 
 func.func @mmt4d_f32f32f32(%arg0 : tensor<?x?x16x1xf32>, %arg1 : tensor<?x?x16x1xf32>,
     %arg2 : tensor<?x?x16x16xf32>) -> tensor<?x?x16x16xf32> attributes {
@@ -597,3 +598,70 @@ func.func @mmt4d_i16u4i32_extend_producers(%arg0: tensor<10x10x1x8xi16>, %arg1:
 // CHECK-SAME:       ins(%[[ARG0]], %[[ARG1]] :
 // CHECK-SAME:       outs(%[[ARG2]] :
 //      CHECK:   return %[[MICRO_KERNEL]]#0
+
+// -----
+
+func.func @softmax_f32(%arg0 : tensor<?x?xf32>, %arg1 : tensor<?x?xf32>) -> tensor<?x?xf32> attributes {
+  hal.executable.target = #hal.executable.target<"llvm-cpu", "xyz", {ukernels = "softmax", target_triple="x86_64-xyz-xyz", cpu_features="+avx512f"}>
+} {
+  %0 = linalg.softmax dimension(1) ins(%arg0 : tensor<?x?xf32>) outs(%arg1 : tensor<?x?xf32>) -> tensor<?x?xf32>
+  return %0 : tensor<?x?xf32>
+}
+// CHECK-LABEL: func @softmax_f32(
+// CHECK-SAME:     %[[ARG0:[a-zA-Z0-9]+]]: tensor<?x?xf32>
+// CHECK-SAME:     %[[ARG1:[a-zA-Z0-9]+]]: tensor<?x?xf32>
+//  CHECK-DAG:   %[[C0:.+]] = arith.constant 0 : index
+//  CHECK-DAG:   %[[C1:.+]] = arith.constant 1 : index
+//  CHECK-DAG:   %[[FLAGS:.+]] = arith.constant 1 : i32
+//  CHECK-DAG:   %[[SIZE0:.+]] = tensor.dim %[[ARG0]], %[[C0]]
+//  CHECK-DAG:   %[[SIZE1:.+]] = tensor.dim %[[ARG0]], %[[C1]]
+//      CHECK:   %[[MICRO_KERNEL:.+]]:2 = iree_codegen.ukernel.generic "iree_uk_softmax"
+// CHECK-SAME:       ins(%[[ARG0]] :
+// CHECK-SAME:       outs(%[[ARG1]] :
+// CHECK-SAME:       (%[[SIZE0]], %[[SIZE1]], %[[FLAGS]] :
+//      CHECK:   return %[[MICRO_KERNEL]]#0
+// FASTAPPROX-LABEL: func @softmax_f32(
+//  FASTAPPROX-DAG:   %[[FLAGS:.+]] = arith.constant 257 : i32
+//      FASTAPPROX:   iree_codegen.ukernel.generic "iree_uk_softmax"
+// FASTAPPROX-SAME:       %[[FLAGS]] :
+
+// -----
+
+func.func @softmax_f16(%arg0 : tensor<16x?xf16>, %arg1 : tensor<16x?xf16>) -> tensor<16x?xf16> attributes {
+  hal.executable.target = #hal.executable.target<"llvm-cpu", "xyz", {ukernels = "all", target_triple="aarch64-xyz-xyz", cpu_features=""}>
+} {
+  %0 = linalg.softmax dimension(1) ins(%arg0 : tensor<16x?xf16>) outs(%arg1 : tensor<16x?xf16>) -> tensor<16x?xf16>
+  return %0 : tensor<16x?xf16>
+}
+// CHECK-LABEL: func @softmax_f16(
+// CHECK-SAME:     %[[ARG0:[a-zA-Z0-9]+]]: tensor<16x?xf16>
+// CHECK-SAME:     %[[ARG1:[a-zA-Z0-9]+]]: tensor<16x?xf16>
+//  CHECK-DAG:   %[[FLAGS:.+]] = arith.constant 2 : i32
+//      CHECK:   iree_codegen.ukernel.generic "iree_uk_softmax"
+// CHECK-SAME:       ins(%[[ARG0]] :
+// CHECK-SAME:       outs(%[[ARG1]] :
+// CHECK-SAME:       %[[FLAGS]] :
+
+// -----
+
+func.func @softmax_not_innermost_dim(%arg0 : tensor<?x?xf32>, %arg1 : tensor<?x?xf32>) -> tensor<?x?xf32> attributes {
+  hal.executable.target = #hal.executable.target<"llvm-cpu", "xyz", {ukernels = "softmax", target_triple="x86_64-xyz-xyz", cpu_features="+avx512f"}>
+} {
+  %0 = linalg.softmax dimension(0) ins(%arg0 : tensor<?x?xf32>) outs(%arg1 : tensor<?x?xf32>) -> tensor<?x?xf32>
+  return %0 : tensor<?x?xf32>
+}
+// CHECK-LABEL: func @softmax_not_innermost_dim(
+//      CHECK:   linalg.softmax
+//  CHECK-NOT:   iree_codegen.ukernel.generic
+
+// -----
+
+func.func @softmax_no_ukernel(%arg0 : tensor<?x?xf32>, %arg1 : tensor<?x?xf32>) -> tensor<?x?xf32> attributes {
+  hal.executable.target = #hal.executable.target<"llvm-cpu", "xyz", {ukernels = "mmt4d", target_triple="x86_64-xyz-xyz", cpu_features="+avx512f"}>
+} {
+  %0 = linalg.softmax dimension(1) ins(%arg0 : tensor<?x?xf32>) outs(%arg1 : tensor<?x?xf32>) -> tensor<?x?xf32>
+  return %0 : tensor<?x?xf32>
+}
+// CHECK-LABEL: func @softmax_no_ukernel(
+//      CHECK:   linalg.softmax
+//  CHECK-NOT:   iree_codegen.ukernel.generic
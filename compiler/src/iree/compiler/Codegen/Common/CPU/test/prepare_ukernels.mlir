@@ -271,3 +271,35 @@ func.func @unpack_outer_dim_transpose(%arg0: tensor<4x8x29241x16x16xf32>) -> ten
 // CHECK:           }
 // CHECK:           return %[[RES]] : tensor<29241x128x64xf32>
 // CHECK:         }
+
+// -----
+
+func.func @softmax_3d_to_2d(%arg0: tensor<1x?x?xf32>, %arg1: tensor<1x?x?xf32>) -> tensor<1x?x?xf32> attributes {
+  hal.executable.target = #hal.executable.target<"llvm-cpu", "xyz", {ukernels = "softmax", target_triple="x86_64-xyz-xyz", cpu_features=""}>
+} {
+  %0 = linalg.softmax dimension(2) ins(%arg0 : tensor<1x?x?xf32>) outs(%arg1 : tensor<1x?x?xf32>) -> tensor<1x?x?xf32>
+  return %0 : tensor<1x?x?xf32>
+}
+// CHECK-LABEL: func.func @softmax_3d_to_2d(
+// CHECK-SAME:    %[[ARG0:[a-zA-Z0-9]+]]
+// CHECK-SAME:    %[[ARG1:[a-zA-Z0-9]+]]
+// CHECK:         %[[IN:.+]] = tensor.extract_slice %[[ARG0]]
+// CHECK-SAME:      : tensor<1x?x?xf32> to tensor<?x?xf32>
+// CHECK:         %[[OUT:.+]] = tensor.extract_slice %[[ARG1]]
+// CHECK-SAME:      : tensor<1x?x?xf32> to tensor<?x?xf32>
+// CHECK:         %[[SOFTMAX:.+]] = linalg.softmax dimension(1)
+// CHECK-SAME:      ins(%[[IN]] : tensor<?x?xf32>) outs(%[[OUT]] : tensor<?x?xf32>)
+// CHECK:         %[[RES:.+]] = tensor.insert_slice %[[SOFTMAX]] into %[[ARG1]]
+// CHECK:         return %[[RES]]
+
+// -----
+
+func.func @softmax_3d_non_unit_outer_dim(%arg0: tensor<2x?x?xf32>, %arg1: tensor<2x?x?xf32>) -> tensor<2x?x?xf32> attributes {
+  hal.executable.target = #hal.executable.target<"llvm-cpu", "xyz", {ukernels = "softmax", target_triple="x86_64-xyz-xyz", cpu_features=""}>
+} {
+  %0 = linalg.softmax dimension(2) ins(%arg0 : tensor<2x?x?xf32>) outs(%arg1 : tensor<2x?x?xf32>) -> tensor<2x?x?xf32>
+  return %0 : tensor<2x?x?xf32>
+}
+// CHECK-LABEL: func.func @softmax_3d_non_unit_outer_dim(
+// CHECK:         linalg.softmax dimension(2)
+// CHECK-SAME:      tensor<2x?x?xf32>
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
 #include "iree/compiler/Codegen/Common/Passes.h"
+#include "iree/compiler/Codegen/Utils/Utils.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/Linalg/Transforms/Transforms.h"
@@ -90,6 +91,10 @@ static LogicalResult convertSoftmaxToGenerics(mlir::FunctionOpInterface funcOp,
   SmallVector<Operation *> toDelete;
   SmallVector<Operation *> softmaxOpsToDecompose;
   funcOp.walk([&](linalg::SoftmaxOp softmaxOp) {
+    // Ops that will be lowered to a ukernel are kept whole.
+    if (isSoftmaxUkernelCandidate(softmaxOp)) {
+      return;
+    }
     softmaxOpsToDecompose.push_back(softmaxOp);
   });
   OpBuilder::InsertionGuard guard(rewriter);
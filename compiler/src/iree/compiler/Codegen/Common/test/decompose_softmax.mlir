@@ -103,3 +103,19 @@ func.func @do_not_fuse_gather(%arg0: tensor<4096x64xi64>, %arg1: tensor<4096x64x
 //         CHECK:    linalg.generic {{.*}}
 //         CHECK:      tensor.extract {{.*}} : tensor<4096x64xf32>
 // CHECK-COUNT-3:    linalg.generic
+
+// -----
+
+func.func @softmax_ukernel(%arg0: tensor<2x16x32xf32>) -> tensor<2x16x32xf32> attributes {
+  hal.executable.target = #hal.executable.target<"llvm-cpu", "xyz", {ukernels = "softmax", target_triple="x86_64-xyz-xyz", cpu_features=""}>
+} {
+  %0 = tensor.empty() : tensor<2x16x32xf32>
+  %1 = linalg.softmax dimension(2) ins(%arg0 : tensor<2x16x32xf32>) outs(%0: tensor<2x16x32xf32>) -> tensor<2x16x32xf32>
+  return %1 : tensor<2x16x32xf32>
+}
+// Softmax ops that are lowered to a ukernel are not decomposed.
+// CHECK-LABEL: func.func @softmax_ukernel(
+//       CHECK:   linalg.softmax dimension(2)
+//   CHECK-NOT:   linalg.generic
+// CHECK-NO-FUSE-LABEL: func.func @softmax_ukernel(
+//       CHECK-NO-FUSE:   linalg.softmax dimension(2)
@@ -440,11 +440,37 @@ getMinTilingSizesForEachDim(mlir::FunctionOpInterface entryPointFn,
   return minTileSizes;
 }
 
+/// Returns the number of threads expected to execute the dispatch containing
+/// `op`. Dispatches marked hot by a runtime profile applied with
+/// `--iree-hal-profile-use=` use the number of processors observed executing
+/// them and all others use `--iree-llvmcpu-number-of-threads`.
+static int64_t getNumberOfRuntimeThreads(Operation *op) {
+  auto funcOp = op->getParentOfType<mlir::FunctionOpInterface>();
+  std::optional<IREE::HAL::ExecutableExportOp> exportOp =
+      funcOp ? getEntryPoint(funcOp) : std::nullopt;
+  if (!exportOp) {
+    return clNumberOfRuntimeThreads;
+  }
+  // NOTE: set by the iree-hal-apply-dispatch-profile pass.
+  auto profileAttr = (*exportOp)->getAttrOfType<DictionaryAttr>("iree.profile");
+  if (!profileAttr || !profileAttr.get("hot")) {
+    return clNumberOfRuntimeThreads;
+  }
+  auto processorCountAttr = profileAttr.getAs<IntegerAttr>("processor_count");
+  if (!processorCountAttr || processorCountAttr.getInt() <= 0) {
+    return clNumberOfRuntimeThreads;
+  }
+  LDBG() << "Using profiled processor count " << processorCountAttr.getInt()
+         << " for " << exportOp->getSymName();
+  return processorCountAttr.getInt();
+}
+
 // Reduces the number of workgroups in cases where we are dividing the work too
 // much. Over-provision the number of workgroups to twice the number of
 // threads.
 static void reduceDistributionWorkgroups(
     ArrayRef<int64_t> workload, SmallVectorImpl<int64_t> &distributedTileSizes,
+    int64_t numThreads,
     std::optional<ArrayRef<int64_t>> maxTileSizes = std::nullopt,
     std::optional<ArrayRef<int64_t>> vectorSizeHints = std::nullopt) {
   assert(workload.size() == distributedTileSizes.size());
@@ -457,7 +483,7 @@ static void reduceDistributionWorkgroups(
         llvm::divideCeil(value, distributedTileSizes[idx]);
   }
 
-  int64_t numWorkgroupsLimit = 2 * clNumberOfRuntimeThreads;
+  int64_t numWorkgroupsLimit = 2 * numThreads;
   int64_t numWorkgroups = llvm::product_of(numWorkgroupsPerDim);
   unsigned currDim = workload.size();
   while (numWorkgroups > numWorkgroupsLimit && currDim > 0) {
@@ -520,7 +546,8 @@ static SmallVector<int64_t>
 getDefaultDistributionTileSizes(ArrayRef<int64_t> lbs, ArrayRef<int64_t> ubs,
                                 ArrayRef<int64_t> minTileSizes,
                                 ArrayRef<int64_t> maxTileSizes,
-                                ArrayRef<int64_t> vectorSizeHints) {
+                                ArrayRef<int64_t> vectorSizeHints,
+                                int64_t numThreads) {
   assert(lbs.size() == ubs.size() && lbs.size() == minTileSizes.size() &&
          lbs.size() == maxTileSizes.size() &&
          "expected all vectors to be of equal size");
@@ -545,8 +572,7 @@ getDefaultDistributionTileSizes(ArrayRef<int64_t> lbs, ArrayRef<int64_t> ubs,
     assert(lbs[i] <= ubs[i]);
     workload[i] = ubs[i] - lbs[i];
     int64_t candidateTileSize = 1;
-    int64_t targetSize =
-        std::min(workload[i] / clNumberOfRuntimeThreads, maxTileSizes[i]);
+    int64_t targetSize = std::min(workload[i] / numThreads, maxTileSizes[i]);
     int64_t vectorSize = vectorSizeHints[i];
     if (vectorSize > 1) {
       // Pick the factor of dim which is closest to the target tile size and
@@ -569,8 +595,8 @@ getDefaultDistributionTileSizes(ArrayRef<int64_t> lbs, ArrayRef<int64_t> ubs,
     distributedTileSizes[i] = std::min(candidateTileSize, maxTileSizes[i]);
   }
 
-  reduceDistributionWorkgroups(workload, distributedTileSizes, maxTileSizes,
-                               vectorSizeHints);
+  reduceDistributionWorkgroups(workload, distributedTileSizes, numThreads,
+                               maxTileSizes, vectorSizeHints);
 
   return distributedTileSizes;
 }
@@ -916,7 +942,7 @@ getDefaultDistributedLevelTileSizes(Operation *op,
 
   SmallVector<int64_t> distributedTileSizes = getDefaultDistributionTileSizes(
       lbs, ubs, adjustedMinTileSizes, adjustedMaxTileSizes,
-      adjustedVectorSizeHints);
+      adjustedVectorSizeHints, getNumberOfRuntimeThreads(op));
 
   LDBG() << "Distributed tile sizes before fixups: " << distributedTileSizes;
 
@@ -3015,6 +3041,41 @@ static LogicalResult setRootConfig(mlir::FunctionOpInterface entryPointFn,
       DispatchLoweringPassPipeline::CPUDefault);
 }
 
+/// Sets the lowering configuration for linalg.softmax ops that are lowered to
+/// the softmax ukernel. All outer dimensions except the last one are
+/// distributed with tile size 1, and the normalized (innermost) dimension is
+/// not tiled, so the ukernel sees whole 2D tiles of rows. Other softmax ops
+/// use the default TilingInterface configuration.
+static LogicalResult setRootConfig(mlir::FunctionOpInterface entryPointFn,
+                                   linalg::SoftmaxOp op) {
+  if (!isSoftmaxUkernelCandidate(op)) {
+    return setRootConfig(entryPointFn, cast<TilingInterface>(*op));
+  }
+  assert(!getLoweringConfig(op) && "expected lowering_config is not set");
+  int64_t rank = op.getOutputOperandRank();
+  DistributionHeuristicConfig distConfig;
+  distConfig.allowIncompleteTile = true;
+  SmallVector<int64_t> distTileSizes =
+      getDefaultDistributedLevelTileSizes(op, distConfig);
+  for (int64_t dim = 0; dim < rank - 2; ++dim) {
+    distTileSizes[dim] = 1;
+  }
+  distTileSizes[rank - 1] = 0;
+
+  SmallVector<int64_t> vecTileSizes(rank, 1);
+  vecTileSizes[rank - 2] = distTileSizes[rank - 2];
+  vecTileSizes[rank - 1] = 0;
+  LoweringConfigGenerator generator(op);
+  generator.setDistributionTileSizes(distTileSizes);
+  generator.setVectorTileSizes(vecTileSizes);
+  IREE::CPU::LoweringConfigAttr loweringConfig =
+      generator.generateCPULoweringConfig();
+  LDBG() << "Set lowering_config for linalg.softmax op: " << loweringConfig;
+  return setOpConfigAndEntryPointFnTranslation(
+      entryPointFn, op, loweringConfig,
+      DispatchLoweringPassPipeline::CPUDataTiling);
+}
+
 /// Redirects to methods that set the configuration based on operation type.
 static LogicalResult
 setRootConfigImpl(mlir::FunctionOpInterface entryPointFn, Operation *op,
@@ -3028,7 +3089,7 @@ setRootConfigImpl(mlir::FunctionOpInterface entryPointFn, Operation *op,
           })
           .Case<IREE::LinalgExt::AttentionOp, IREE::LinalgExt::FftOp,
                 linalg::PackOp, tensor::PadOp, linalg::UnPackOp,
-                linalg::Mmt4DOp, linalg::BatchMmt4DOp>(
+                linalg::Mmt4DOp, linalg::BatchMmt4DOp, linalg::SoftmaxOp>(
               [&](auto op) { return setRootConfig(entryPointFn, op); })
           .Case<IREE::LinalgExt::WinogradFilterTransformOp,
                 IREE::LinalgExt::WinogradInputTransformOp,
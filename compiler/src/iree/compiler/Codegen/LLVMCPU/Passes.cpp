@@ -80,6 +80,14 @@ static llvm::cl::opt<bool> clSkipIntermediateRoundings(
         "is slow."),
     llvm::cl::init(true));
 
+static llvm::cl::opt<bool> clUkernelFastApproximations(
+    "iree-llvmcpu-ukernel-fast-approximations",
+    llvm::cl::desc(
+        "Allow ukernels to use faster, less accurate approximations of "
+        "transcendental functions. For example, the softmax ukernel then uses "
+        "a lower-degree polynomial for exp, with a relative error below 1e-4."),
+    llvm::cl::init(false));
+
 static llvm::cl::opt<bool> clInstrumentMemoryAccesses{
     "iree-llvmcpu-instrument-memory-accesses",
     llvm::cl::desc("Instruments memory accesses in dispatches when dispatch "
@@ -385,8 +393,8 @@ void addMmt4dTilingExpertPassPipeline(
   // The below two passes are nop if the "mmt4d" is explicitly excluded in the
   // ukernels attribute.
   funcPassManager.addPass(createCPUPrepareUkernelsPass());
-  funcPassManager.addPass(
-      createCPULowerToUKernelsPass(clSkipIntermediateRoundings));
+  funcPassManager.addPass(createCPULowerToUKernelsPass(
+      clSkipIntermediateRoundings, clUkernelFastApproximations));
   funcPassManager.addPass(createLLVMCPUTileRootAndFuseInputOperandsPass(
       IREE::CPU::TilingLevel::VectorReductionTiles));
   // `VectorInnerParallelTiles` level models the tiling and fusion for the
@@ -434,11 +442,11 @@ void addCPUDataTilingPipeline(OpPassManager &funcPassManager,
                               const LLVMCPUPipelineOptions &pipelineOpt) {
   addTileAndDistributePasses(funcPassManager, pipelineOpt);
 
-  // The below two passes are nop if pack/unpack is not specified in ukernels
-  // attribute. By default, they are disabled.
+  // The below two passes are nop if pack/unpack/softmax is not specified in
+  // ukernels attribute. By default, they are disabled.
   funcPassManager.addPass(createCPUPrepareUkernelsPass());
-  funcPassManager.addPass(
-      createCPULowerToUKernelsPass(clSkipIntermediateRoundings));
+  funcPassManager.addPass(createCPULowerToUKernelsPass(
+      clSkipIntermediateRoundings, clUkernelFastApproximations));
 
   funcPassManager.addPass(createLLVMCPUTilePass(
       IREE::CPU::TilingLevel::VectorCommonParallelTiles, /*skipRootOp=*/false));
@@ -658,7 +666,6 @@ void buildLLVMCPUCodegenConfigurationPassPipelineImpl(
     addCommonTargetExecutablePreprocessingPasses(funcPassManager,
                                                  clUseSoftmaxInterFusion);
   }
-  modulePassManager.addPass(createMaterializeUserConfigsPass());
   FunctionLikeNest(modulePassManager)
       .addPass(createMaterializeDeviceEncodingPass)
       .addPass(createCPUPropagateDataLayoutPass)
@@ -671,6 +678,12 @@ void buildLLVMCPUCodegenConfigurationPassPipelineImpl(
       // #hal.descriptor_type memory space through the stack.
       .addPass(createEraseHALDescriptorTypeFromMemRefPass);
 
+  // User configs and tuning specs are applied after the encodings have been
+  // materialized, so that they can match the resulting ops (e.g. the
+  // linalg.mmt4d ops produced by data-tiling, whose tile sizes are tuned by
+  // the ukernel mmt4d_autotune tool).
+  modulePassManager.addPass(createMaterializeTuningSpecsPass());
+  modulePassManager.addPass(createMaterializeUserConfigsPass());
   modulePassManager.addPass(createLLVMCPUSelectLoweringStrategyPass());
   LLVM_DEBUG({
     llvm::dbgs() << "LLVMCPU codegen configuration pass pipeline:\n";
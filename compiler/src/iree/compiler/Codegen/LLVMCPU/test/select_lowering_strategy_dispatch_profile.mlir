@@ -0,0 +1,129 @@
+// RUN: iree-opt --pass-pipeline='builtin.module(hal.executable(hal.executable.variant(builtin.module(iree-llvmcpu-select-lowering-strategy))))' --split-input-file %s | FileCheck %s --check-prefixes=CHECK,DEFAULT
+// RUN: iree-opt --pass-pipeline='builtin.module(hal.executable(hal.executable.variant(builtin.module(iree-llvmcpu-select-lowering-strategy))))' --iree-llvmcpu-number-of-threads=1 --split-input-file %s | FileCheck %s --check-prefixes=CHECK,ONE
+
+// Tests that distribution of exports marked hot by a dispatch profile uses the
+// processor count observed executing them instead of
+// --iree-llvmcpu-number-of-threads. All exports are otherwise identical.
+
+#executable_target_embedded_elf_x86_64_ = #hal.executable.target<"llvm-cpu", "embedded-elf-x86_64", {data_layout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128", native_vector_size = 16 : index, target_triple = "x86_64-unknown-linux-gnu"}>
+#pipeline_layout = #hal.pipeline.layout<bindings = [
+  #hal.pipeline.binding<storage_buffer>
+]>
+#map = affine_map<(d0, d1, d2, d3) -> (d0, d1, d2, d3)>
+hal.executable private @hot {
+  hal.executable.variant public @variant target(#executable_target_embedded_elf_x86_64_) {
+    hal.executable.export public @add_hot ordinal(0) layout(#pipeline_layout) attributes {
+      iree.profile = {hot, processor_count = 32 : i64}
+    }
+    builtin.module {
+      func.func @add_hot(%2: tensor<64x16x32x128xf32>) -> tensor<64x16x32x128xf32> {
+        %3 = tensor.empty() : tensor<64x16x32x128xf32>
+        %4 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel", "parallel", "parallel", "parallel"]} ins(%2 : tensor<64x16x32x128xf32>) outs(%3 : tensor<64x16x32x128xf32>) {
+        ^bb0(%in: f32, %out: f32):
+          %5 = arith.addf %in, %in : f32
+          linalg.yield %5 : f32
+        } -> tensor<64x16x32x128xf32>
+        return %4 : tensor<64x16x32x128xf32>
+      }
+    }
+  }
+}
+//  CHECK-DAG: #[[CONFIG:.+]] = #iree_cpu.lowering_config<distribution = [2, 16, 32, 64], vector_common_parallel = [1, 1, 1, 4]>
+//      CHECK: func.func @add_hot(
+//      CHECK: linalg.generic
+// CHECK-SAME:     lowering_config = #[[CONFIG]]
+
+// -----
+
+#executable_target_embedded_elf_x86_64_ = #hal.executable.target<"llvm-cpu", "embedded-elf-x86_64", {data_layout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128", native_vector_size = 16 : index, target_triple = "x86_64-unknown-linux-gnu"}>
+#pipeline_layout = #hal.pipeline.layout<bindings = [
+  #hal.pipeline.binding<storage_buffer>
+]>
+#map = affine_map<(d0, d1, d2, d3) -> (d0, d1, d2, d3)>
+hal.executable private @unprofiled {
+  hal.executable.variant public @variant target(#executable_target_embedded_elf_x86_64_) {
+    hal.executable.export public @add_unprofiled ordinal(0) layout(#pipeline_layout)
+    builtin.module {
+      func.func @add_unprofiled(%2: tensor<64x16x32x128xf32>) -> tensor<64x16x32x128xf32> {
+        %3 = tensor.empty() : tensor<64x16x32x128xf32>
+        %4 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel", "parallel", "parallel", "parallel"]} ins(%2 : tensor<64x16x32x128xf32>) outs(%3 : tensor<64x16x32x128xf32>) {
+        ^bb0(%in: f32, %out: f32):
+          %5 = arith.addf %in, %in : f32
+          linalg.yield %5 : f32
+        } -> tensor<64x16x32x128xf32>
+        return %4 : tensor<64x16x32x128xf32>
+      }
+    }
+  }
+}
+//  DEFAULT-DAG: #[[CONFIG:.+]] = #iree_cpu.lowering_config<distribution = [8, 16, 32, 64], vector_common_parallel = [1, 1, 1, 4]>
+//      ONE-DAG: #[[CONFIG:.+]] = #iree_cpu.lowering_config<distribution = [64, 16, 32, 64], vector_common_parallel = [1, 1, 1, 4]>
+//        CHECK: func.func @add_unprofiled(
+//        CHECK: linalg.generic
+//   CHECK-SAME:     lowering_config = #[[CONFIG]]
+
+// -----
+
+// Profiled exports that are not hot use the default thread count.
+
+#executable_target_embedded_elf_x86_64_ = #hal.executable.target<"llvm-cpu", "embedded-elf-x86_64", {data_layout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128", native_vector_size = 16 : index, target_triple = "x86_64-unknown-linux-gnu"}>
+#pipeline_layout = #hal.pipeline.layout<bindings = [
+  #hal.pipeline.binding<storage_buffer>
+]>
+#map = affine_map<(d0, d1, d2, d3) -> (d0, d1, d2, d3)>
+hal.executable private @cold {
+  hal.executable.variant public @variant target(#executable_target_embedded_elf_x86_64_) {
+    hal.executable.export public @add_cold ordinal(0) layout(#pipeline_layout) attributes {
+      iree.profile = {processor_count = 32 : i64}
+    }
+    builtin.module {
+      func.func @add_cold(%2: tensor<64x16x32x128xf32>) -> tensor<64x16x32x128xf32> {
+        %3 = tensor.empty() : tensor<64x16x32x128xf32>
+        %4 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel", "parallel", "parallel", "parallel"]} ins(%2 : tensor<64x16x32x128xf32>) outs(%3 : tensor<64x16x32x128xf32>) {
+        ^bb0(%in: f32, %out: f32):
+          %5 = arith.addf %in, %in : f32
+          linalg.yield %5 : f32
+        } -> tensor<64x16x32x128xf32>
+        return %4 : tensor<64x16x32x128xf32>
+      }
+    }
+  }
+}
+//  DEFAULT-DAG: #[[CONFIG:.+]] = #iree_cpu.lowering_config<distribution = [8, 16, 32, 64], vector_common_parallel = [1, 1, 1, 4]>
+//      ONE-DAG: #[[CONFIG:.+]] = #iree_cpu.lowering_config<distribution = [64, 16, 32, 64], vector_common_parallel = [1, 1, 1, 4]>
+//        CHECK: func.func @add_cold(
+//        CHECK: linalg.generic
+//   CHECK-SAME:     lowering_config = #[[CONFIG]]
+
+// -----
+
+// Hot exports without a valid processor count use the default thread count.
+
+#executable_target_embedded_elf_x86_64_ = #hal.executable.target<"llvm-cpu", "embedded-elf-x86_64", {data_layout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128", native_vector_size = 16 : index, target_triple = "x86_64-unknown-linux-gnu"}>
+#pipeline_layout = #hal.pipeline.layout<bindings = [
+  #hal.pipeline.binding<storage_buffer>
+]>
+#map = affine_map<(d0, d1, d2, d3) -> (d0, d1, d2, d3)>
+hal.executable private @no_processors {
+  hal.executable.variant public @variant target(#executable_target_embedded_elf_x86_64_) {
+    hal.executable.export public @add_no_processors ordinal(0) layout(#pipeline_layout) attributes {
+      iree.profile = {hot, processor_count = 0 : i64}
+    }
+    builtin.module {
+      func.func @add_no_processors(%2: tensor<64x16x32x128xf32>) -> tensor<64x16x32x128xf32> {
+        %3 = tensor.empty() : tensor<64x16x32x128xf32>
+        %4 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel", "parallel", "parallel", "parallel"]} ins(%2 : tensor<64x16x32x128xf32>) outs(%3 : tensor<64x16x32x128xf32>) {
+        ^bb0(%in: f32, %out: f32):
+          %5 = arith.addf %in, %in : f32
+          linalg.yield %5 : f32
+        } -> tensor<64x16x32x128xf32>
+        return %4 : tensor<64x16x32x128xf32>
+      }
+    }
+  }
+}
+//  DEFAULT-DAG: #[[CONFIG:.+]] = #iree_cpu.lowering_config<distribution = [8, 16, 32, 64], vector_common_parallel = [1, 1, 1, 4]>
+//      ONE-DAG: #[[CONFIG:.+]] = #iree_cpu.lowering_config<distribution = [64, 16, 32, 64], vector_common_parallel = [1, 1, 1, 4]>
+//        CHECK: func.func @add_no_processors(
+//        CHECK: linalg.generic
+//   CHECK-SAME:     lowering_config = #[[CONFIG]]
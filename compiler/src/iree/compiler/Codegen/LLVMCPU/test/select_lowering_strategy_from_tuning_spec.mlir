@@ -0,0 +1,34 @@
+// RUN: iree-opt --pass-pipeline='builtin.module(iree-codegen-materialize-tuning-specs,iree-codegen-materialize-user-configs,iree-llvmcpu-select-lowering-strategy)' \
+// RUN:   --iree-codegen-tuning-spec-path=%p/tuning_spec_mmt4d.mlir \
+// RUN:   --split-input-file %s | FileCheck %s
+
+// The tuned outer tile sizes of mmt4d ops, as produced by data-tiling, take
+// precedence over the default strategy.
+
+#executable_target_embedded_elf_x86_64_ = #hal.executable.target<"llvm-cpu", "embedded-elf-x86_64", {cpu = "cascadelake", cpu_features = "+avx512f", data_layout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128", native_vector_size = 64 : index, target_triple = "x86_64-unknown-unknown-eabi-elf"}>
+func.func @tuned_mmt4d(%lhs: tensor<7x128x16x1xf32>, %rhs: tensor<284x128x16x1xf32>, %acc: tensor<7x284x16x16xf32>) -> tensor<7x284x16x16xf32> attributes {hal.executable.target = #executable_target_embedded_elf_x86_64_} {
+  %0 = linalg.mmt4d ins(%lhs, %rhs : tensor<7x128x16x1xf32>, tensor<284x128x16x1xf32>) outs(%acc : tensor<7x284x16x16xf32>) -> tensor<7x284x16x16xf32>
+  return %0 : tensor<7x284x16x16xf32>
+}
+
+//  CHECK-DAG: #[[CONFIG:.+]] = #iree_cpu.lowering_config<distribution = [2, 1, 0, 0, 0, 0], vector_common_parallel = [1, 1, 0, 16, 16, 0], vector_reduction = [0, 0, 1, 0, 0, 1]>
+//  CHECK-DAG: #[[TRANSLATION:.+]] = #iree_codegen.translation_info<pipeline = Mmt4dTilingExpert>
+//      CHECK: func.func @tuned_mmt4d(
+// CHECK-SAME:     translation_info = #[[TRANSLATION]]
+//      CHECK:   linalg.mmt4d
+// CHECK-SAME:     lowering_config = #[[CONFIG]]
+
+// -----
+
+// Tile shapes that are not in the spec keep the default strategy.
+
+#executable_target_embedded_elf_x86_64_ = #hal.executable.target<"llvm-cpu", "embedded-elf-x86_64", {cpu = "cascadelake", cpu_features = "+avx512f", data_layout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128", native_vector_size = 64 : index, target_triple = "x86_64-unknown-unknown-eabi-elf"}>
+func.func @untuned_mmt4d(%lhs: tensor<7x128x8x1xf32>, %rhs: tensor<284x128x16x1xf32>, %acc: tensor<7x284x8x16xf32>) -> tensor<7x284x8x16xf32> attributes {hal.executable.target = #executable_target_embedded_elf_x86_64_} {
+  %0 = linalg.mmt4d ins(%lhs, %rhs : tensor<7x128x8x1xf32>, tensor<284x128x16x1xf32>) outs(%acc : tensor<7x284x8x16xf32>) -> tensor<7x284x8x16xf32>
+  return %0 : tensor<7x284x8x16xf32>
+}
+
+//  CHECK-NOT: distribution = [2, 1, 0, 0, 0, 0]
+//      CHECK: func.func @untuned_mmt4d(
+//      CHECK:   linalg.mmt4d
+// CHECK-SAME:     lowering_config =
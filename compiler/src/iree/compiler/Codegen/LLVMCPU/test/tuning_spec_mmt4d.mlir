@@ -0,0 +1,40 @@
+// Tuning spec in the format emitted by the mmt4d_autotune ukernel tool, trimmed
+// down to a single tile shape.
+
+module @iree_mmt4d_tuning_spec attributes { transform.with_named_sequence, iree_codegen.tuning_spec_with_default_entrypoint } {
+
+transform.named_sequence @apply_op_config(%op: !transform.any_op {transform.readonly},
+                                          %config: !transform.any_param {transform.readonly}) {
+  transform.annotate %op "compilation_info" = %config : !transform.any_op, !transform.any_param
+  transform.yield
+}
+
+transform.named_sequence
+@match_mmt4d_f32f32f32_16x16x1(%mmt4d: !transform.any_op {transform.readonly})
+  -> (!transform.any_op, !transform.any_param) {
+  transform.match.operation_name %mmt4d ["linalg.mmt4d"] : !transform.any_op
+  transform.iree.match.has_no_lowering_config %mmt4d : !transform.any_op
+  %lhs = transform.get_operand %mmt4d[0] : (!transform.any_op) -> !transform.any_value
+  %rhs = transform.get_operand %mmt4d[1] : (!transform.any_op) -> !transform.any_value
+  %acc = transform.get_operand %mmt4d[2] : (!transform.any_op) -> !transform.any_value
+  transform.iree.match.cast_compatible_type %lhs = tensor<?x?x16x1xf32> : !transform.any_value
+  transform.iree.match.cast_compatible_type %rhs = tensor<?x?x16x1xf32> : !transform.any_value
+  transform.iree.match.cast_compatible_type %acc = tensor<?x?x16x16xf32> : !transform.any_value
+  // 103.7 GFLOP/s with avx512_base.
+  %config = transform.param.constant #iree_codegen.compilation_info<
+    lowering_config = #iree_cpu.lowering_config<distribution = [2, 1, 0, 0, 0, 0], vector_common_parallel = [1, 1, 0, 16, 16, 0], vector_reduction = [0, 0, 1, 0, 0, 1]>,
+    translation_info = #iree_codegen.translation_info<pipeline = Mmt4dTilingExpert>
+  > -> !transform.any_param
+  transform.yield %mmt4d, %config : !transform.any_op, !transform.any_param
+}
+
+transform.named_sequence
+@__kernel_config(%variant_op: !transform.any_op {transform.consumed}) -> !transform.any_op
+  attributes { iree_codegen.tuning_spec_entrypoint } {
+  %res = transform.foreach_match in %variant_op
+    @match_mmt4d_f32f32f32_16x16x1 -> @apply_op_config
+    : (!transform.any_op) -> !transform.any_op
+  transform.yield %res : !transform.any_op
+}
+
+}
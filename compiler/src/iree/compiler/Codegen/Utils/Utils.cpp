@@ -222,6 +222,26 @@ bool hasUkernel(DictionaryAttr targetConfig, StringRef ukernelName) {
   return false;
 }
 
+bool isSoftmaxUkernelCandidate(linalg::SoftmaxOp softmaxOp) {
+  auto targetAttr = IREE::HAL::ExecutableTargetAttr::lookup(softmaxOp);
+  // The VMVX module and the GPU backends do not provide a softmax ukernel.
+  if (!targetAttr || !isLLVMCPUBackend(targetAttr) ||
+      !hasUkernel(targetAttr.getConfiguration(), "softmax")) {
+    return false;
+  }
+  ShapedType inputType = softmaxOp.getInputOperandType();
+  ShapedType outputType = softmaxOp.getOutputOperandType();
+  if (!isa<RankedTensorType>(inputType) || inputType.getRank() < 2 ||
+      softmaxOp.getDimension() != inputType.getRank() - 1) {
+    return false;
+  }
+  Type elemType = inputType.getElementType();
+  if (elemType != outputType.getElementType()) {
+    return false;
+  }
+  return elemType.isF32() || elemType.isF16() || elemType.isBF16();
+}
+
 // TODO(dcaballe): If we have to check for a significantly large number of
 // features in the future, we may want to consider a persistent state to carry
 // over processed HAL information or keeping the TTI instance alive and query
@@ -82,6 +82,13 @@ bool isWebGPUBackend(IREE::HAL::ExecutableTargetAttr targetAttr);
 // is enabled at all.
 bool hasUkernel(DictionaryAttr attr, StringRef ukernelName = "");
 
+/// Returns true if `softmaxOp` is to be lowered to the `softmax` ukernel on the
+/// target it is compiled for. Such ops must be kept as `linalg.softmax` rather
+/// than decomposed: the ukernel processes rows along the innermost dimension,
+/// so the op needs to be softmax over the innermost dim of a tensor of rank
+/// >= 2 with f32, f16 or bf16 elements.
+bool isSoftmaxUkernelCandidate(linalg::SoftmaxOp softmaxOp);
+
 /// Returns true if `attr` has `feature` in its CPU features.
 bool hasFeature(DictionaryAttr targetConfig, StringRef feature);
 
@@ -0,0 +1,196 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/compiler/Dialect/HAL/IR/HALDialect.h"
+#include "iree/compiler/Dialect/HAL/IR/HALOps.h"
+#include "iree/compiler/Dialect/HAL/Transforms/Passes.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/Pass/Pass.h"
+
+#define DEBUG_TYPE "iree-hal-apply-dispatch-profile"
+
+namespace mlir::iree_compiler::IREE::HAL {
+
+#define GEN_PASS_DEF_APPLYDISPATCHPROFILEPASS
+#include "iree/compiler/Dialect/HAL/Transforms/Passes.h.inc"
+
+namespace {
+
+// Aggregate runtime statistics for a single export.
+struct ExportProfile {
+  int64_t invocations = 0;
+  int64_t workgroups = 0;
+  int64_t bytes = 0;
+  int64_t timeNs = 0;
+  bool hot = false;
+};
+
+struct DispatchProfile {
+  // Profiles keyed by export name in the order they were first seen.
+  llvm::MapVector<StringRef, ExportProfile> exports;
+  // Number of processors observed executing dispatches or 0 if unknown.
+  int64_t processorCount = 0;
+};
+
+// Parses |json| into |profile|. Entries with the same name are merged as
+// profiles of multiple runs may be concatenated.
+static LogicalResult parseDispatchProfile(const llvm::json::Value &json,
+                                          DispatchProfile &profile,
+                                          std::string &error) {
+  const llvm::json::Object *rootObject = json.getAsObject();
+  if (!rootObject) {
+    error = "expected a top-level object";
+    return failure();
+  }
+  if (auto version = rootObject->getInteger("version"); version != 0) {
+    error = "unsupported profile version";
+    return failure();
+  }
+  profile.processorCount =
+      rootObject->getInteger("processor_count").value_or(0);
+  const llvm::json::Array *exportsArray = rootObject->getArray("exports");
+  if (!exportsArray) {
+    error = "expected an `exports` array";
+    return failure();
+  }
+  for (const llvm::json::Value &exportValue : *exportsArray) {
+    const llvm::json::Object *exportObject = exportValue.getAsObject();
+    std::optional<StringRef> name =
+        exportObject ? exportObject->getString("name") : std::nullopt;
+    if (!name) {
+      error = "expected each export to be an object with a `name`";
+      return failure();
+    }
+    ExportProfile &exportProfile = profile.exports[*name];
+    exportProfile.invocations +=
+        exportObject->getInteger("invocations").value_or(0);
+    exportProfile.workgroups +=
+        exportObject->getInteger("workgroups").value_or(0);
+    exportProfile.bytes += exportObject->getInteger("bytes").value_or(0);
+    exportProfile.timeNs += exportObject->getInteger("time_ns").value_or(0);
+  }
+  return success();
+}
+
+// Marks the exports with the largest weight as hot until they cover
+// |hotFraction| of the total weight. Time is used as the weight if any export
+// has timing information and otherwise the workgroup count is used as a proxy.
+static void markHotExports(DispatchProfile &profile, double hotFraction) {
+  bool hasTiming = llvm::any_of(profile.exports, [](const auto &it) {
+    return it.second.timeNs > 0;
+  });
+  auto getWeight = [&](const ExportProfile &exportProfile) {
+    return hasTiming ? exportProfile.timeNs : exportProfile.workgroups;
+  };
+
+  SmallVector<ExportProfile *> sortedProfiles;
+  int64_t totalWeight = 0;
+  for (auto &[name, exportProfile] : profile.exports) {
+    sortedProfiles.push_back(&exportProfile);
+    totalWeight += getWeight(exportProfile);
+  }
+  llvm::stable_sort(sortedProfiles,
+                    [&](ExportProfile *lhs, ExportProfile *rhs) {
+                      return getWeight(*lhs) > getWeight(*rhs);
+                    });
+
+  double hotWeight = hotFraction * totalWeight;
+  int64_t coveredWeight = 0;
+  for (ExportProfile *exportProfile : sortedProfiles) {
+    int64_t weight = getWeight(*exportProfile);
+    if (weight == 0 || coveredWeight >= hotWeight) {
+      break;
+    }
+    exportProfile->hot = true;
+    coveredWeight += weight;
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// --iree-hal-apply-dispatch-profile
+//===----------------------------------------------------------------------===//
+
+struct ApplyDispatchProfilePass
+    : public IREE::HAL::impl::ApplyDispatchProfilePassBase<
+          ApplyDispatchProfilePass> {
+  using IREE::HAL::impl::ApplyDispatchProfilePassBase<
+      ApplyDispatchProfilePass>::ApplyDispatchProfilePassBase;
+  void runOnOperation() override {
+    mlir::ModuleOp moduleOp = getOperation();
+    if (profilePath.empty()) {
+      return; // no-op
+    }
+
+    auto fileOrErr = llvm::MemoryBuffer::getFile(profilePath);
+    if (std::error_code ec = fileOrErr.getError()) {
+      moduleOp.emitError() << "failed to open dispatch profile `"
+                           << profilePath << "`: " << ec.message();
+      return signalPassFailure();
+    }
+    llvm::Expected<llvm::json::Value> json =
+        llvm::json::parse((*fileOrErr)->getBuffer());
+    if (!json) {
+      moduleOp.emitError() << "failed to parse dispatch profile `"
+                           << profilePath
+                           << "`: " << llvm::toString(json.takeError());
+      return signalPassFailure();
+    }
+    DispatchProfile profile;
+    std::string error;
+    if (failed(parseDispatchProfile(*json, profile, error))) {
+      moduleOp.emitError() << "invalid dispatch profile `" << profilePath
+                           << "`: " << error;
+      return signalPassFailure();
+    }
+    markHotExports(profile, hotFraction);
+
+    Builder builder(moduleOp.getContext());
+    for (auto executableOp : moduleOp.getOps<IREE::HAL::ExecutableOp>()) {
+      for (auto variantOp :
+           executableOp.getOps<IREE::HAL::ExecutableVariantOp>()) {
+        for (auto exportOp : variantOp.getExportOps()) {
+          auto it = profile.exports.find(exportOp.getSymName());
+          if (it == profile.exports.end()) {
+            continue;
+          }
+          const ExportProfile &exportProfile = it->second;
+          SmallVector<NamedAttribute> attrs = {
+              builder.getNamedAttr(
+                  "invocations",
+                  builder.getI64IntegerAttr(exportProfile.invocations)),
+              builder.getNamedAttr(
+                  "workgroups",
+                  builder.getI64IntegerAttr(exportProfile.workgroups)),
+              builder.getNamedAttr(
+                  "bytes", builder.getI64IntegerAttr(exportProfile.bytes)),
+              builder.getNamedAttr(
+                  "time_ns", builder.getI64IntegerAttr(exportProfile.timeNs)),
+          };
+          if (profile.processorCount > 0) {
+            attrs.push_back(builder.getNamedAttr(
+                "processor_count",
+                builder.getI64IntegerAttr(profile.processorCount)));
+          }
+          if (exportProfile.hot) {
+            attrs.push_back(builder.getNamedAttr("hot", builder.getUnitAttr()));
+          }
+          LLVM_DEBUG(llvm::dbgs() << "profile for " << exportOp.getSymName()
+                                  << (exportProfile.hot ? " (hot)" : "")
+                                  << "\n");
+          exportOp->setAttr("iree.profile", builder.getDictionaryAttr(attrs));
+        }
+      }
+    }
+  }
+};
+
+} // namespace
+
+} // namespace mlir::iree_compiler::IREE::HAL
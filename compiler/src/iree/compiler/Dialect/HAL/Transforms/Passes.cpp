@@ -127,6 +127,16 @@ static llvm::cl::opt<std::string> clSubstituteExecutableObjectsFrom{
     llvm::cl::init(""),
 };
 
+static llvm::cl::opt<std::string> clProfileUse{
+    "iree-hal-profile-use",
+    llvm::cl::desc(
+        "Path to a JSON dispatch profile (as produced by "
+        "`iree-dump-instruments --output=profile`) used to annotate "
+        "executable exports with runtime statistics. Target backends may use "
+        "the annotations to reconfigure the hottest dispatches."),
+    llvm::cl::init(""),
+};
+
 static llvm::cl::list<std::string> clPreprocessExecutablesWith{
     "iree-hal-preprocess-executables-with",
     llvm::cl::desc(
@@ -368,6 +378,13 @@ void buildHALTransformPassPipeline(OpPassManager &passManager,
   }
 
   if (compileFrom < PipelinePhase::ExecutableConfigurations) {
+    // Annotate exports with runtime statistics from a previous run so that
+    // configuration can specialize the hottest dispatches.
+    if (!clProfileUse.empty()) {
+      passManager.addPass(IREE::HAL::createApplyDispatchProfilePass(
+          {clProfileUse.getValue()}));
+    }
+
     // Select a translation strategy for each hal.executable.variant and
     // generate the IR to condition on support for the variant. In the future,
     // this or neighboring passes can expand/contract variants based on the
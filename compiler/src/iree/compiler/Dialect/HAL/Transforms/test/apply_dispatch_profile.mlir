@@ -0,0 +1,33 @@
+// RUN: iree-opt --split-input-file %s \
+// RUN:   --pass-pipeline='builtin.module(iree-hal-apply-dispatch-profile{profile-path=%S/apply_dispatch_profile.json})' | \
+// RUN: FileCheck %s --check-prefixes=CHECK,DEFAULT
+// RUN: iree-opt --split-input-file %s \
+// RUN:   --pass-pipeline='builtin.module(iree-hal-apply-dispatch-profile{profile-path=%S/apply_dispatch_profile.json hot-fraction=0.95})' | \
+// RUN: FileCheck %s --check-prefixes=CHECK,WIDE
+
+// Exports are matched by name and duplicate profile entries are merged. Only
+// the exports covering the requested fraction of all workgroups are hot.
+
+#pipeline_layout = #hal.pipeline.layout<bindings = [
+  #hal.pipeline.binding<storage_buffer>
+]>
+
+// CHECK-LABEL: hal.executable private @executable
+hal.executable private @executable {
+  hal.executable.variant public @variant target(<"llvm-cpu", "embedded-elf-x86_64">) {
+    // CHECK: hal.executable.export public @dispatch_hot
+    // CHECK-SAME: iree.profile = {bytes = 6144 : i64, hot, invocations = 3 : i64, processor_count = 6 : i64, time_ns = 0 : i64, workgroups = 900 : i64}
+    hal.executable.export public @dispatch_hot ordinal(0) layout(#pipeline_layout)
+    // DEFAULT: hal.executable.export public @dispatch_warm
+    // DEFAULT-SAME: iree.profile = {bytes = 256 : i64, invocations = 1 : i64, processor_count = 6 : i64, time_ns = 0 : i64, workgroups = 90 : i64}
+    // WIDE: hal.executable.export public @dispatch_warm
+    // WIDE-SAME: iree.profile = {bytes = 256 : i64, hot, invocations = 1 : i64, processor_count = 6 : i64, time_ns = 0 : i64, workgroups = 90 : i64}
+    hal.executable.export public @dispatch_warm ordinal(1) layout(#pipeline_layout)
+    // CHECK: hal.executable.export public @dispatch_cold
+    // CHECK-SAME: iree.profile = {bytes = 64 : i64, invocations = 1 : i64, processor_count = 6 : i64, time_ns = 0 : i64, workgroups = 10 : i64}
+    hal.executable.export public @dispatch_cold ordinal(2) layout(#pipeline_layout)
+    // CHECK: hal.executable.export public @dispatch_unprofiled
+    // CHECK-NOT: iree.profile
+    hal.executable.export public @dispatch_unprofiled ordinal(3) layout(#pipeline_layout)
+  }
+}
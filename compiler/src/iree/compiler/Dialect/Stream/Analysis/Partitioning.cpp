@@ -6,9 +6,11 @@
 
 #include "iree/compiler/Dialect/Stream/Analysis/Partitioning.h"
 
+#include "iree/compiler/Dialect/Stream/IR/StreamOps.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/Debug.h"
 #include "mlir/IR/AsmState.h"
+#include "mlir/IR/Matchers.h"
 #include "mlir/IR/PatternMatch.h"
 #include "mlir/Interfaces/ControlFlowInterfaces.h"
 
@@ -56,6 +58,95 @@ void collectConsumedValues(Operation *rootOp,
   }
 }
 
+//===----------------------------------------------------------------------===//
+// Cost models
+//===----------------------------------------------------------------------===//
+
+void OpCost::print(llvm::raw_ostream &os) const {
+  auto printComponent = [&](StringRef name, int64_t value,
+                            bool isDynamic = false) {
+    os << name << "=";
+    if (value && !isDynamic) {
+      os << value;
+    } else {
+      os << "?";
+    }
+  };
+  printComponent("workload", workload);
+  os << " ";
+  printComponent("bytes", bytesAccessed, hasDynamicBytes);
+  os << " ";
+  printComponent("flops", flops);
+}
+
+// Returns the product of all |values| or 0 if any are not constant.
+static int64_t multiplyConstantValues(ValueRange values) {
+  int64_t product = 1;
+  for (auto value : values) {
+    APInt constantValue;
+    if (!matchPattern(value, m_ConstantInt(&constantValue))) {
+      return 0;
+    }
+    product *= constantValue.getSExtValue();
+  }
+  return product;
+}
+
+OpCost StaticCostModel::estimateCost(Operation *op) {
+  OpCost cost;
+
+  // Dispatch workloads are usually proportional to the number of workgroups
+  // the dispatch will launch. We don't evaluate the export workgroup count
+  // functions here as they are opaque until the executable is translated.
+  if (auto dispatchOp = dyn_cast<IREE::Stream::AsyncDispatchOp>(op)) {
+    cost.workload = multiplyConstantValues(dispatchOp.getWorkload());
+  }
+
+  // Bytes accessed are only known if all ranges are statically sized.
+  if (auto accessOp = dyn_cast<IREE::Stream::AsyncAccessOpInterface>(op)) {
+    SmallVector<AsyncAccessRange> ranges;
+    accessOp.getAsyncAccessRanges(ranges);
+    for (auto &range : ranges) {
+      // Tied results alias their operands and are only counted once.
+      auto result = dyn_cast<OpResult>(range.resource);
+      auto tiedOp = dyn_cast<IREE::Util::TiedOpInterface>(op);
+      if (result && result.getOwner() == op && tiedOp &&
+          tiedOp.getTiedResultOperand(result)) {
+        continue;
+      }
+      APInt length;
+      if (!range.length ||
+          !matchPattern(range.length, m_ConstantInt(&length))) {
+        cost.hasDynamicBytes = true;
+        continue;
+      }
+      cost.bytesAccessed += length.getSExtValue();
+    }
+  }
+
+  return cost;
+}
+
+bool StaticCostModel::canJoinWave(const OpCost &waveCost, size_t waveOpCount,
+                                  const OpCost &opCost) {
+  if (options.maxConcurrency > 0 &&
+      waveOpCount >= static_cast<size_t>(options.maxConcurrency)) {
+    return false;
+  }
+  if (options.waveBytesBudget > 0) {
+    // Dynamically sized accesses cannot be bounded and could exceed the budget
+    // so ops with them are never grouped with others.
+    if (waveCost.hasDynamicBytes || opCost.hasDynamicBytes) {
+      return false;
+    }
+    if (waveCost.bytesAccessed + opCost.bytesAccessed >
+        options.waveBytesBudget) {
+      return false;
+    }
+  }
+  return true;
+}
+
 //===----------------------------------------------------------------------===//
 // Partition data structures
 //===----------------------------------------------------------------------===//
@@ -253,9 +344,9 @@ PartitionSet partitionStreamableOps(IREE::Stream::PartitioningConfigAttr config,
 
 PartitionSet
 partitionRegionConcurrency(IREE::Stream::PartitioningConfigAttr config,
-                           Block *block) {
+                           Block *block, PartitioningCostModel *costModel) {
   // Only one algorithm today.
-  return partitionRegionConcurrencyReference(config, block);
+  return partitionRegionConcurrencyReference(config, block, costModel);
 }
 
 } // namespace mlir::iree_compiler::IREE::Stream
@@ -8,6 +8,7 @@
 #define IREE_COMPILER_DIALECT_STREAM_ANALYSIS_PARTITIONING_H_
 
 #include "iree/compiler/Dialect/Stream/IR/StreamTypes.h"
+#include "llvm/Support/raw_ostream.h"
 #include "mlir/IR/Operation.h"
 #include "mlir/Support/LLVM.h"
 
@@ -59,6 +60,85 @@ struct PartitionSet {
   void topologicalSort();
 };
 
+//===----------------------------------------------------------------------===//
+// Cost models
+//===----------------------------------------------------------------------===//
+
+// Estimated cost of executing one or more operations.
+// Estimates are only comparable when produced by the same cost model and any
+// component may be 0 if unknown.
+struct OpCost {
+  // Total number of independent units of work (such as the product of the
+  // dispatch workload) used to approximate the available parallelism.
+  int64_t workload = 0;
+  // Total number of bytes read and written.
+  int64_t bytesAccessed = 0;
+  // True if any access is dynamically sized and bytesAccessed only covers the
+  // statically sized ones.
+  bool hasDynamicBytes = false;
+  // Total number of arithmetic operations performed.
+  int64_t flops = 0;
+
+  OpCost &operator+=(const OpCost &other) {
+    workload += other.workload;
+    bytesAccessed += other.bytesAccessed;
+    hasDynamicBytes |= other.hasDynamicBytes;
+    flops += other.flops;
+    return *this;
+  }
+
+  void print(llvm::raw_ostream &os) const;
+};
+
+// Pluggable cost model used by partitioning algorithms to decide which
+// operations may be grouped together and how wide concurrent waves may grow.
+// Partitioning without a cost model groups as much work as correctness allows.
+class PartitioningCostModel {
+public:
+  virtual ~PartitioningCostModel() = default;
+
+  // Returns the estimated cost of executing |op|.
+  virtual OpCost estimateCost(Operation *op) = 0;
+
+  // Returns true if an op with |opCost| may execute concurrently with a wave
+  // of |waveOpCount| ops with a combined cost of |waveCost|.
+  virtual bool canJoinWave(const OpCost &waveCost, size_t waveOpCount,
+                           const OpCost &opCost) = 0;
+};
+
+// Configuration for the StaticCostModel.
+struct StaticCostModelOptions {
+  // Maximum number of ops that may execute concurrently in a wave or 0 for no
+  // limit.
+  int64_t maxConcurrency = 0;
+  // Maximum combined bytes accessed by all ops in a wave or 0 for no limit.
+  // Ops exceeding the budget on their own or with dynamically sized accesses
+  // are always placed in their own wave so that large ops serialize instead of
+  // competing for caches.
+  int64_t waveBytesBudget = 0;
+};
+
+// Cost model using statically known dispatch workloads and resource access
+// ranges. Ops with dynamically sized accesses may be arbitrarily large and are
+// assumed to exceed any bytes budget.
+class StaticCostModel : public PartitioningCostModel {
+public:
+  explicit StaticCostModel(StaticCostModelOptions options)
+      : options(options) {}
+
+  // Returns true if the model will place any constraints on partitioning.
+  bool isEnabled() const {
+    return options.maxConcurrency > 0 || options.waveBytesBudget > 0;
+  }
+
+  OpCost estimateCost(Operation *op) override;
+  bool canJoinWave(const OpCost &waveCost, size_t waveOpCount,
+                   const OpCost &opCost) override;
+
+private:
+  StaticCostModelOptions options;
+};
+
 //===----------------------------------------------------------------------===//
 // Utilities
 //===----------------------------------------------------------------------===//
@@ -114,9 +194,13 @@ void collectConsumedValues(Operation *rootOp, SetVector<Value> &consumedValues);
 // ops in the block will be covered by a partition.
 PartitionSet partitionStreamableOps(IREE::Stream::PartitioningConfigAttr config,
                                     Block *block);
+// Partitions the streamable ops in |block| into waves of concurrently
+// executable work. If provided |costModel| is used to limit which ops may
+// execute concurrently.
 PartitionSet
 partitionRegionConcurrency(IREE::Stream::PartitioningConfigAttr config,
-                           Block *block);
+                           Block *block,
+                           PartitioningCostModel *costModel = nullptr);
 
 //===----------------------------------------------------------------------===//
 // Reference partitioning
@@ -130,9 +214,12 @@ partitionStreamableOpsReference(IREE::Stream::PartitioningConfigAttr config,
 
 // Similarly poor algorithm to partitionStreamableOpsReference but for use
 // within partitioned streams to produce waves of concurrently executable work.
+// When |costModel| is provided ops are only placed into waves the model
+// accepts and otherwise start a new wave.
 PartitionSet
 partitionRegionConcurrencyReference(IREE::Stream::PartitioningConfigAttr config,
-                                    Block *block);
+                                    Block *block,
+                                    PartitioningCostModel *costModel = nullptr);
 
 } // namespace mlir::iree_compiler::IREE::Stream
 
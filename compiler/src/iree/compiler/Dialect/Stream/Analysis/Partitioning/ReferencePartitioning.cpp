@@ -657,7 +657,8 @@ partitionStreamableOpsReference(IREE::Stream::PartitioningConfigAttr config,
 // dividing the block to identify both serial and concurrent regions.
 PartitionSet
 partitionRegionConcurrencyReference(IREE::Stream::PartitioningConfigAttr config,
-                                    Block *block) {
+                                    Block *block,
+                                    PartitioningCostModel *costModel) {
   PartitionSet waveSet;
 
   auto favor = config.getFavor().getValue();
@@ -670,6 +671,8 @@ partitionRegionConcurrencyReference(IREE::Stream::PartitioningConfigAttr config,
     unsigned ordinal;
     // Ops present in the wave; ops may be present in multiple waves.
     SetVector<Operation *> ops;
+    // Combined estimated cost of all ops in the wave if a cost model is used.
+    OpCost cost;
   };
   SmallVector<std::unique_ptr<PartitionBuilder>> builders;
 
@@ -808,6 +811,22 @@ partitionRegionConcurrencyReference(IREE::Stream::PartitioningConfigAttr config,
     opInfo.membership.reserve(builders.size() + 1);
     opInfo.membership.resize(builders.size(), /*t=*/false);
 
+    // Filter out candidate waves the cost model rejects (too wide, too much
+    // data, etc). Those that remain are safe and profitable to join.
+    OpCost opCost;
+    if (costModel) {
+      opCost = costModel->estimateCost(&op);
+      for (auto candidateOrdinal : candidates.set_bits()) {
+        auto &candidate = builders[candidateOrdinal];
+        if (!costModel->canJoinWave(candidate->cost, candidate->ops.size(),
+                                    opCost)) {
+          LLVM_DEBUG(llvm::dbgs() << "  $ cost model rejects wave "
+                                  << candidateOrdinal << "\n");
+          candidates.reset(candidateOrdinal);
+        }
+      }
+    }
+
     // No consumers - if there's any candidate then we'll go into that.
     int firstCandidateOrdinal = favor == IREE::Stream::Favor::MaxConcurrency
                                     ? candidates.find_first()
@@ -816,6 +835,7 @@ partitionRegionConcurrencyReference(IREE::Stream::PartitioningConfigAttr config,
       LLVM_DEBUG(llvm::dbgs() << "Moving to last candidate wave "
                               << firstCandidateOrdinal << " (continue)\n");
       builders[firstCandidateOrdinal]->ops.insert(&op);
+      builders[firstCandidateOrdinal]->cost += opCost;
       opInfo.membership.set(firstCandidateOrdinal);
       opInfo.hazards.set(0, firstCandidateOrdinal);
       opInfo.hazards.reset(firstCandidateOrdinal);
@@ -830,6 +850,7 @@ partitionRegionConcurrencyReference(IREE::Stream::PartitioningConfigAttr config,
     auto builder = std::make_unique<PartitionBuilder>();
     builder->ordinal = builders.size();
     builder->ops.insert(&op);
+    builder->cost = opCost;
     LLVM_DEBUG(llvm::dbgs() << "Created wave " << builder->ordinal << "\n");
     builders.push_back(std::move(builder));
   }
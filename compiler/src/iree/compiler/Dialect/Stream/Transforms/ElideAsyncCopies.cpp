@@ -4,6 +4,7 @@
 // See https://llvm.org/LICENSE.txt for license information.
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
+#include <chrono>
 #include <utility>
 
 #include "iree/compiler/Dialect/Stream/IR/StreamDialect.h"
@@ -16,6 +17,7 @@
 #include "iree/compiler/Dialect/Util/Analysis/Explorer.h"
 #include "iree/compiler/Dialect/Util/IR/UtilDialect.h"
 #include "iree/compiler/Dialect/Util/IR/UtilOps.h"
+#include "llvm/ADT/EquivalenceClasses.h"
 #include "llvm/ADT/TypeSwitch.h"
 #include "llvm/Support/Debug.h"
 #include "mlir/Analysis/Liveness.h"
@@ -24,6 +26,7 @@
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinTypes.h"
 #include "mlir/IR/Diagnostics.h"
+#include "mlir/IR/SymbolTable.h"
 #include "mlir/Interfaces/FunctionInterfaces.h"
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
@@ -496,9 +499,13 @@ const char ResourceMutationSemantics::ID = 0;
 // TODO(benvanik): change into something we can use for ref counting. We need
 // that to insert stream-ordered deallocs and know when timepoints have been
 // discard as they go out of scope. For now this strictly checks last use.
+//
+// Abstract elements are allocated from |allocator| which must outlive the
+// analysis. Callers running multiple analyses in sequence can reset and reuse
+// the same allocator to avoid reacquiring slabs each time.
 class ElisionAnalysis {
 public:
-  explicit ElisionAnalysis(Operation *rootOp)
+  explicit ElisionAnalysis(Operation *rootOp, llvm::BumpPtrAllocator &allocator)
       : explorer(rootOp, TraversalAction::RECURSE),
         solver(explorer, allocator) {
     // Default is RECURSE to support arbitrary other dialects that may use
@@ -508,21 +515,19 @@ public:
     // automatically.
     explorer.setOpAction<IREE::Stream::ExecutableOp>(TraversalAction::IGNORE);
     explorer.initialize();
-
-    assert(rootOp->getNumRegions() == 1 && "expected module-like root op");
-    topLevelOps = llvm::to_vector(
-        rootOp->getRegions().front().getOps<mlir::CallableOpInterface>());
   }
 
   AsmState &getAsmState() { return solver.getAsmState(); }
 
-  // Runs analysis and populates the state cache.
+  // Runs analysis seeded from the values within |callableOps| and populates
+  // the state cache. Values outside of |callableOps| are only analyzed as they
+  // are reached from the seeded values.
   // May fail if analysis cannot be completed due to unsupported or unknown IR.
-  LogicalResult run() {
+  LogicalResult run(ArrayRef<mlir::CallableOpInterface> callableOps) {
     // Seed all block arguments throughout the program (including nested
     // regions). This ensures SCF operations (scf.for, scf.if, scf.while) and
     // other region-bearing ops have their block arguments analyzed.
-    for (auto callableOp : getTopLevelOps()) {
+    for (auto callableOp : callableOps) {
       auto *region = callableOp.getCallableRegion();
       if (!region) {
         continue;
@@ -540,7 +545,7 @@ public:
     // Seed ResourceMutationSemantics for all Stream resource values.
     // This ensures they participate in the fixed-point iteration.
     int seedCount = 0;
-    for (auto callableOp : getTopLevelOps()) {
+    for (auto callableOp : callableOps) {
       auto *region = callableOp.getCallableRegion();
       if (!region) {
         continue;
@@ -562,10 +567,8 @@ public:
     return solver.run();
   }
 
-  // Returns a list of all top-level callable ops in the root op.
-  ArrayRef<mlir::CallableOpInterface> getTopLevelOps() const {
-    return topLevelOps;
-  }
+  // Returns the total number of abstract elements created by the solver.
+  size_t getElementCount() const { return solver.getElementCount(); }
 
   // Returns true if block argument |arg| is passed in by-value/move (it's the
   // last use from all callers/predecessor branches). When false the value
@@ -653,9 +656,7 @@ public:
 
 private:
   Explorer explorer;
-  llvm::BumpPtrAllocator allocator;
   DFX::Solver solver;
-  SmallVector<mlir::CallableOpInterface> topLevelOps;
 };
 
 //===----------------------------------------------------------------------===//
@@ -1182,6 +1183,39 @@ static ElisionResults tryElideAsyncCopiesInRegion(
   return results;
 }
 
+// Partitions the top-level |callableOps| of |moduleOp| into classes of
+// callables whose analysis results may depend on each other. Callables are
+// related if one references the other (such as via calls) or both reference
+// the same global as those are the only edges the explorer follows across
+// callables. Eliding copies within a callable can only change what is elidable
+// in callables of the same class.
+static llvm::EquivalenceClasses<Operation *>
+partitionCallables(mlir::ModuleOp moduleOp,
+                   ArrayRef<mlir::CallableOpInterface> callableOps) {
+  SymbolTable symbolTable(moduleOp);
+  llvm::EquivalenceClasses<Operation *> classes;
+  for (auto callableOp : callableOps) {
+    classes.insert(callableOp);
+    auto *region = callableOp.getCallableRegion();
+    if (!region) {
+      continue;
+    }
+    auto symbolUses = SymbolTable::getSymbolUses(region);
+    if (!symbolUses) {
+      continue;
+    }
+    for (auto &symbolUse : *symbolUses) {
+      auto *targetOp =
+          symbolTable.lookup(symbolUse.getSymbolRef().getRootReference());
+      if (isa_and_nonnull<mlir::CallableOpInterface,
+                          IREE::Util::GlobalOpInterface>(targetOp)) {
+        classes.unionSets(callableOp, targetOp);
+      }
+    }
+  }
+  return classes;
+}
+
 // Elides async copies that perform no meaningful work - such as clones of the
 // last use of a value. This is designed to be run after
 // --iree-stream-materialize-copy-on-write to clean up the copies it introduces
@@ -1196,7 +1230,9 @@ static ElisionResults tryElideAsyncCopiesInRegion(
 // in the program are checked to see if they can be safely removed and if so are
 // rerouted to the cloned source value. This process repeats until no more
 // copies are elided: we are guaranteed to reach a fixed point as we are only
-// removing copies in this pass and not introducing any new ops.
+// removing copies in this pass and not introducing any new ops. Iterations
+// after the first only reanalyze the callables related to those that had
+// copies elided in the prior iteration as nothing else can have changed.
 struct ElideAsyncCopiesPass
     : public IREE::Stream::impl::ElideAsyncCopiesPassBase<
           ElideAsyncCopiesPass> {
@@ -1215,36 +1251,79 @@ struct ElideAsyncCopiesPass
         moduleOp->getAttrOfType<IREE::Stream::AffinityTopologyAttrInterface>(
             "stream.topology");
 
+    // Eliding copies never adds references between callables so the classes
+    // computed up-front remain a conservative partitioning for all iterations.
+    auto callableOps = llvm::to_vector(
+        moduleOp.getBody()->getOps<mlir::CallableOpInterface>());
+    auto callableClasses = partitionCallables(moduleOp, callableOps);
+
+    // Solver state is allocated from an arena that is reset and reused across
+    // iterations.
+    llvm::BumpPtrAllocator allocator;
+
     // Track total elisions across all iterations.
     ElisionResults totalResults;
 
     // Try analyzing the program and eliding the unneeded copies until we reach
-    // a fixed point (no more copies can be elided).
+    // a fixed point (no more copies can be elided). The first iteration covers
+    // the whole program and subsequent ones only the callables that may have
+    // been affected by the elisions performed in the prior iteration.
+    SmallVector<mlir::CallableOpInterface> dirtyOps = callableOps;
     unsigned maxIterationCount = 30;
     unsigned iterationCount = 0;
     for (; iterationCount < maxIterationCount; ++iterationCount) {
-      // Perform whole-program analysis.
-      // TODO(benvanik): reuse allocator across iterations.
-      ElisionAnalysis analysis(moduleOp);
-      if (failed(analysis.run())) {
-        moduleOp.emitError() << "failed to solve for elision analysis";
-        return signalPassFailure();
-      }
-
-      // Apply analysis by eliding all copies that are safe to elide.
-      // If we can't elide any we'll consider the iteration complete and exit.
       ElisionResults iterationResults;
-      for (auto callableOp : analysis.getTopLevelOps()) {
-        if (auto *region = callableOp.getCallableRegion()) {
-          ElisionResults regionResults =
-              tryElideAsyncCopiesInRegion(*region, analysis, topologyAttr);
-          iterationResults.add(regionResults);
+      DenseSet<Operation *> changedClasses;
+      {
+        // Perform analysis seeded from the dirty callables.
+        ElisionAnalysis analysis(moduleOp, allocator);
+        auto solveStartTime = std::chrono::steady_clock::now();
+        if (failed(analysis.run(dirtyOps))) {
+          moduleOp.emitError() << "failed to solve for elision analysis";
+          return signalPassFailure();
+        }
+        uint64_t solveTimeUs =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - solveStartTime)
+                .count();
+        numCallablesAnalyzed += dirtyOps.size();
+        numSolverElements += analysis.getElementCount();
+        solverTimeUs += solveTimeUs;
+        LLVM_DEBUG(llvm::dbgs()
+                   << "iteration " << iterationCount << ": solved "
+                   << analysis.getElementCount() << " elements for "
+                   << dirtyOps.size() << "/" << callableOps.size()
+                   << " callables in " << solveTimeUs << "us\n");
+
+        // Apply analysis by eliding all copies that are safe to elide.
+        // If we can't elide any we'll consider the iteration complete and
+        // exit.
+        for (auto callableOp : dirtyOps) {
+          if (auto *region = callableOp.getCallableRegion()) {
+            ElisionResults regionResults =
+                tryElideAsyncCopiesInRegion(*region, analysis, topologyAttr);
+            if (regionResults.didChange()) {
+              changedClasses.insert(
+                  callableClasses.getLeaderValue(callableOp));
+            }
+            iterationResults.add(regionResults);
+          }
         }
       }
+      allocator.Reset();
       totalResults.add(iterationResults);
       if (!iterationResults.didChange()) {
         break; // quiesced
       }
+
+      // Only callables related to those that changed need reanalysis.
+      dirtyOps.clear();
+      for (auto callableOp : callableOps) {
+        if (changedClasses.contains(
+                callableClasses.getLeaderValue(callableOp))) {
+          dirtyOps.push_back(callableOp);
+        }
+      }
     }
 
     // Update pass statistics.
@@ -4,7 +4,7 @@
 // See https://llvm.org/LICENSE.txt for license information.
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
-#include <list>
+#include <optional>
 
 #include "iree/compiler/Dialect/Stream/IR/StreamDialect.h"
 #include "iree/compiler/Dialect/Stream/IR/StreamOps.h"
@@ -14,7 +14,12 @@
 #include "iree/compiler/Dialect/Util/IR/UtilOps.h"
 #include "iree/compiler/Dialect/Util/IR/UtilTypes.h"
 #include "iree/compiler/Utils/IntegerSet.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVectorExtras.h"
 #include "llvm/Support/Debug.h"
+#include "mlir/Analysis/DataFlow/DeadCodeAnalysis.h"
+#include "mlir/Analysis/DataFlow/IntegerRangeAnalysis.h"
+#include "mlir/Analysis/DataFlowFramework.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/IR/AsmState.h"
 #include "mlir/IR/Attributes.h"
@@ -34,47 +39,133 @@ namespace {
 
 using Slice = IREE::Stream::ResourcePackOp::Slice;
 
-// Packs a set of statically-sized slices by greedy strip packing.
-//
-// This is the same algorithm used in tflite here:
-// https://github.com/tensorflow/tensorflow/blob/master/tensorflow/lite/simple_memory_arena.cc
-// It's not fantastic and can end up with a significant amount of wastage.
-// They do the packing at runtime and as such care more about performance than
-// we do while doing the packing here offline. For this initial version I
-// wanted to ensure we matched apples/apples their implementation.
-//
-// We should use a set of heuristics and pick the smallest one. There are also
-// some really great papers that have approximations (as all of these are -
-// 2D strip packing is NP-hard) such as
-// https://www.sciencedirect.com/science/article/pii/S0925772113001016 that
-// someone with a brain able to parse mathy papers can try implementing.
-//
-// Slice packed offset SSA values will be updated and start at the given
-// |baseOffset|. Returns |baseOffset| + the total size of the allocation
-// aligned to the requirements of |resourceConfig|.
-static Value
-packStaticSlicesGreedily(IREE::Stream::ResourcePackOp packOp, Value baseOffset,
-                         MutableArrayRef<Slice> slices,
-                         IREE::Stream::ResourceConfigAttr resourceConfig,
-                         IndexSet &indexSet, OpBuilder &builder) {
-  int64_t offsetAlignment = resourceConfig.getMinBufferOffsetAlignment();
-  int64_t rangeAlignment = resourceConfig.getMinBufferRangeAlignment();
+//===----------------------------------------------------------------------===//
+// Size bounds
+//===----------------------------------------------------------------------===//
+
+// Unsigned bounds of a slice size as derived from integer range analysis
+// (including any util.assume.int ops on the sizes).
+struct SizeRange {
+  uint64_t umin = 0;
+  uint64_t umax = UINT64_MAX;
+  bool hasUpperBound() const { return umax != UINT64_MAX; }
+};
+
+// Answers size-relation queries on slice sizes using integer range analysis
+// and the structure of the IR computing the sizes.
+class SizeAnalysis {
+public:
+  explicit SizeAnalysis(Operation *rootOp) {
+    solver.load<mlir::dataflow::DeadCodeAnalysis>();
+    solver.load<mlir::dataflow::IntegerRangeAnalysis>();
+    if (failed(solver.initializeAndRun(rootOp))) {
+      LLVM_DEBUG(llvm::dbgs() << "integer range analysis failed; slice sizes "
+                                 "will be treated as unbounded\n");
+      analysisFailed = true;
+    }
+  }
+
+  // Returns the unsigned range of |value|.
+  SizeRange getRange(Value value) {
+    APInt constantValue;
+    if (matchPattern(value, m_ConstantInt(&constantValue))) {
+      uint64_t v = constantValue.getZExtValue();
+      return {v, v};
+    }
+    if (analysisFailed)
+      return {};
+    auto *rangeState =
+        solver.lookupState<dataflow::IntegerValueRangeLattice>(value);
+    if (!rangeState || rangeState->getValue().isUninitialized())
+      return {};
+    const ConstantIntRanges &range = rangeState->getValue().getValue();
+    if (range.umax().getActiveBits() > 64)
+      return {};
+    return {range.umin().getZExtValue(), range.umax().getZExtValue()};
+  }
+
+  // Returns true if |lhs| <= |rhs| is known to hold for all executions.
+  // Sizes are non-negative byte lengths and arithmetic on them is assumed not
+  // to overflow.
+  bool isLessThanOrEqual(Value lhs, Value rhs, int depth = 0) {
+    if (lhs == rhs)
+      return true;
+    SizeRange lhsRange = getRange(lhs);
+    SizeRange rhsRange = getRange(rhs);
+    if (lhsRange.umax <= rhsRange.umin)
+      return true;
+    if (depth >= kMaxDepth)
+      return false;
+    ++depth;
+
+    // Walk up |rhs| through ops that only grow their operands.
+    if (Operation *rhsOp = rhs.getDefiningOp()) {
+      if (auto alignOp = dyn_cast<IREE::Util::AlignOp>(rhsOp)) {
+        if (isLessThanOrEqual(lhs, alignOp.getValue(), depth))
+          return true;
+      } else if (isa<arith::AddIOp, arith::MaxUIOp, arith::MaxSIOp>(rhsOp)) {
+        for (Value operand : rhsOp->getOperands()) {
+          if (isLessThanOrEqual(lhs, operand, depth))
+            return true;
+        }
+      } else if (isa<arith::MulIOp>(rhsOp)) {
+        // x <= x * y when y >= 1.
+        Value a = rhsOp->getOperand(0);
+        Value b = rhsOp->getOperand(1);
+        if ((getRange(b).umin >= 1 && isLessThanOrEqual(lhs, a, depth)) ||
+            (getRange(a).umin >= 1 && isLessThanOrEqual(lhs, b, depth))) {
+          return true;
+        }
+      }
+    }
+
+    // Walk up |lhs| through ops that only shrink their operands.
+    if (Operation *lhsOp = lhs.getDefiningOp()) {
+      if (isa<arith::MinUIOp, arith::MinSIOp>(lhsOp)) {
+        for (Value operand : lhsOp->getOperands()) {
+          if (isLessThanOrEqual(operand, rhs, depth))
+            return true;
+        }
+      }
+    }
+    return false;
+  }
+
+private:
+  static constexpr int kMaxDepth = 4;
+  DataFlowSolver solver;
+  bool analysisFailed = false;
+};
+
+//===----------------------------------------------------------------------===//
+// Static layout
+//===----------------------------------------------------------------------===//
+
+// A 1D layout of slices at static offsets within a slab.
+class StaticLayout {
+public:
+  static constexpr int64_t UNASSIGNED = INT64_MAX;
 
   struct Reservation {
-    const Slice *slice = nullptr;
+    Slice *slice = nullptr;
     int64_t staticOffset = 0;
     int64_t staticSize = 0;
   };
-  static constexpr int64_t UNASSIGNED = INT64_MAX;
 
-  std::list<Reservation> reservations;
-  int64_t highwaterMark = 0;
-  for (auto &slice : slices) {
+  explicit StaticLayout(int64_t offsetAlignment)
+      : offsetAlignment(offsetAlignment) {}
+
+  ArrayRef<Reservation> getReservations() const { return reservations; }
+  int64_t getHighwaterMark() const { return highwaterMark; }
+
+  // Returns the offset of the smallest gap in which |slice| of |alignedSize|
+  // bytes fits between reservations with intersecting lifetimes, or the end of
+  // the layout if no gap fits. Returns UNASSIGNED if the slice would extend
+  // past |limit|.
+  int64_t findBestFit(const Slice &slice, int64_t alignedSize,
+                      int64_t limit = INT64_MAX) const {
     int64_t bestOffset = UNASSIGNED;
     int64_t bestOffsetFit = UNASSIGNED;
-    int64_t staticSize =
-        cast<arith::ConstantIndexOp>(slice.dynamicSize.getDefiningOp()).value();
-    int64_t alignedSize = IREE::Util::align(staticSize, rangeAlignment);
 
     // Iterate through reservations (sorted by ascending offset) and identify
     // gaps in which the slice will fit. To reduce wastage we want to find the
@@ -101,116 +192,272 @@ packStaticSlicesGreedily(IREE::Stream::ResourcePackOp packOp, Value baseOffset,
     if (bestOffset == UNASSIGNED) {
       bestOffset = IREE::Util::align(currentOffset, offsetAlignment);
     }
+    if (bestOffset + alignedSize > limit) {
+      return UNASSIGNED;
+    }
+    return bestOffset;
+  }
 
-    // Reserve the memory.
+  // Reserves |alignedSize| bytes at |offset| for |slice|.
+  void reserve(Slice &slice, int64_t offset, int64_t alignedSize) {
     Reservation reservation;
     reservation.slice = &slice;
-    reservation.staticOffset = bestOffset;
+    reservation.staticOffset = offset;
     reservation.staticSize = alignedSize;
-    auto insertionIt = reservations.begin();
-    while (insertionIt != reservations.end() &&
-           insertionIt->staticOffset < reservation.staticOffset) {
-      ++insertionIt;
-    }
+    auto insertionIt = llvm::find_if(reservations, [&](const Reservation &r) {
+      return r.staticOffset >= reservation.staticOffset;
+    });
     reservations.insert(insertionIt, reservation);
-    slice.packedOffset.replaceAllUsesWith(builder.createOrFold<arith::AddIOp>(
-        packOp.getLoc(), baseOffset, indexSet.get(bestOffset)));
 
     // Update highwater mark indicating how much memory needs to be allocated
     // for the entire slab.
-    highwaterMark = std::max(highwaterMark, bestOffset + alignedSize);
+    highwaterMark = std::max(highwaterMark, offset + alignedSize);
+  }
+
+private:
+  int64_t offsetAlignment = 0;
+  // Sorted by ascending offset.
+  SmallVector<Reservation> reservations;
+  int64_t highwaterMark = 0;
+};
+
+// Packs the statically-sized |slices| (with their aligned sizes in
+// |alignedSizes|) in the given order by greedy best-fit strip packing.
+//
+// This is the same algorithm used in tflite here:
+// https://github.com/tensorflow/tensorflow/blob/master/tensorflow/lite/simple_memory_arena.cc
+// It's not fantastic and can end up with a significant amount of wastage
+// depending on the order in which slices are placed.
+static StaticLayout layoutStaticSlices(ArrayRef<Slice *> slices,
+                                       ArrayRef<int64_t> alignedSizes,
+                                       int64_t offsetAlignment) {
+  StaticLayout layout(offsetAlignment);
+  for (auto [slice, alignedSize] : llvm::zip_equal(slices, alignedSizes)) {
+    layout.reserve(*slice, layout.findBestFit(*slice, alignedSize),
+                   alignedSize);
   }
+  return layout;
+}
 
-  highwaterMark = IREE::Util::align(highwaterMark, rangeAlignment);
+// Packs a set of statically-sized slices and any dynamically-sized slices with
+// known upper bounds that fit in the gaps of the static layout.
+//
+// 2D strip packing is NP-hard so we try a couple of orderings and pick the one
+// with the smallest footprint: placing in lifetime order (what tflite does at
+// runtime) and placing in descending size order (best-fit decreasing, which
+// tends to do better when sizes vary widely). There are some really great
+// papers with better approximations such as
+// https://www.sciencedirect.com/science/article/pii/S0925772113001016 that
+// someone with a brain able to parse mathy papers can try implementing.
+//
+// Dynamically-sized slices in |boundedSlices| are reserved at their upper bound
+// if doing so does not grow the static slab, removing them from the dynamic
+// packing entirely. Slices that were placed are added to |placedSlices|.
+//
+// Slice packed offset SSA values will be updated and start at the given
+// |baseOffset|. Returns |baseOffset| + the total size of the allocation
+// aligned to the requirements of |resourceConfig|.
+static Value
+packStaticSlices(IREE::Stream::ResourcePackOp packOp, Value baseOffset,
+                 MutableArrayRef<Slice> slices,
+                 SmallVector<std::pair<Slice *, SizeRange>> boundedSlices,
+                 DenseSet<const Slice *> &placedSlices,
+                 IREE::Stream::ResourceConfigAttr resourceConfig,
+                 IndexSet &indexSet, OpBuilder &builder) {
+  int64_t offsetAlignment = resourceConfig.getMinBufferOffsetAlignment();
+  int64_t rangeAlignment = resourceConfig.getMinBufferRangeAlignment();
+
+  SmallVector<Slice *> lifetimeOrder;
+  DenseMap<Slice *, int64_t> alignedSizeMap;
+  for (auto &slice : slices) {
+    int64_t staticSize =
+        cast<arith::ConstantIndexOp>(slice.dynamicSize.getDefiningOp()).value();
+    lifetimeOrder.push_back(&slice);
+    alignedSizeMap[&slice] = IREE::Util::align(staticSize, rangeAlignment);
+  }
+  auto getAlignedSizes = [&](ArrayRef<Slice *> order) {
+    return llvm::map_to_vector(
+        order, [&](Slice *slice) { return alignedSizeMap[slice]; });
+  };
+  SmallVector<Slice *> sizeOrder = lifetimeOrder;
+  llvm::stable_sort(sizeOrder, [&](Slice *lhs, Slice *rhs) {
+    return alignedSizeMap[lhs] > alignedSizeMap[rhs];
+  });
+
+  // Prefer lifetime order on ties so that layouts are stable.
+  StaticLayout layout =
+      layoutStaticSlices(lifetimeOrder, getAlignedSizes(lifetimeOrder),
+                         offsetAlignment);
+  StaticLayout sizeLayout = layoutStaticSlices(
+      sizeOrder, getAlignedSizes(sizeOrder), offsetAlignment);
+  if (sizeLayout.getHighwaterMark() < layout.getHighwaterMark()) {
+    LLVM_DEBUG(llvm::dbgs() << "static layout: size order ("
+                            << sizeLayout.getHighwaterMark()
+                            << "b) beats lifetime order ("
+                            << layout.getHighwaterMark() << "b)\n");
+    layout = std::move(sizeLayout);
+  }
+
+  // Fit bounded dynamic slices into the gaps, largest bound first. We only
+  // take gaps below the (aligned) total size as otherwise we'd be growing the
+  // static slab to the upper bound for all executions when the dynamic packing
+  // would only allocate what's actually needed.
+  int64_t staticLimit =
+      IREE::Util::align(layout.getHighwaterMark(), rangeAlignment);
+  llvm::stable_sort(boundedSlices, [](auto &lhs, auto &rhs) {
+    return lhs.second.umax > rhs.second.umax;
+  });
+  for (auto [slice, range] : boundedSlices) {
+    if (range.umax > static_cast<uint64_t>(staticLimit))
+      continue;
+    int64_t alignedBound =
+        IREE::Util::align(static_cast<int64_t>(range.umax), rangeAlignment);
+    int64_t offset = layout.findBestFit(*slice, alignedBound, staticLimit);
+    if (offset == StaticLayout::UNASSIGNED)
+      continue;
+    LLVM_DEBUG(llvm::dbgs() << "static layout: dynamic slice ["
+                            << slice->lifetimeStart << ", "
+                            << slice->lifetimeEnd << "] bounded to "
+                            << alignedBound << "b placed at " << offset
+                            << "\n");
+    layout.reserve(*slice, offset, alignedBound);
+    placedSlices.insert(slice);
+  }
+
+  for (auto &reservation : layout.getReservations()) {
+    reservation.slice->packedOffset.replaceAllUsesWith(
+        builder.createOrFold<arith::AddIOp>(
+            packOp.getLoc(), baseOffset,
+            indexSet.get(reservation.staticOffset)));
+  }
+
+  int64_t highwaterMark =
+      IREE::Util::align(layout.getHighwaterMark(), rangeAlignment);
   return builder.createOrFold<arith::AddIOp>(packOp.getLoc(), baseOffset,
                                              indexSet.get(highwaterMark));
 }
 
+//===----------------------------------------------------------------------===//
+// Dynamic layout
+//===----------------------------------------------------------------------===//
+
 // Packs a set of dynamically-sized slices based on the structural information
-// in the IR. Only slices that have the exact same size will be allowed to
-// alias.
+// in the IR and the known bounds of their sizes.
 //
-// We can improve this if we know which sizes are larger/smaller relative to
-// others as then we can do things like reuse an allocation bucket with
-// non-overlapping lifetimes if the thing we are trying to pack in it is
-// definitely <=. If we end up knowing that certain sizes are less than some
-// absolute value then we could also alias with static allocations like if %sz
-// is known less than 1000b it could reuse any static allocation >= 1000b.
+// Slices are assigned to bins with disjoint lifetimes such that each bin is
+// sized by the first slice placed in it (its primary size). A slice may join a
+// bin if its size is provably <= the primary size: the same SSA value (we rely
+// on shapes being lowered to computed byte sizes and CSE to dedupe them),
+// ranges from util.assume.int/integer range analysis that don't overlap, or
+// structural relations like %b = %a + %x.
 //
-// We could also emit code for efficient runtime bucketing by providing the
-// sorted, compacted, delta-coded lifetime intervals and runtime-computed
-// sizes if we wanted to produce the smallest buffers.
+// When |runtimeSizedBins| is set slices whose sizes are unrelated may also
+// join a bin with a disjoint lifetime and the bin size is computed at runtime
+// as the max of all member sizes. This is never worse than giving the slice its
+// own bin (max(a, b) <= a + b) at the cost of a few extra ops per pack.
 //
 // Slice packed offset SSA values will be updated and start at the given
 // |baseOffset|. Returns |baseOffset| + the total size of the allocation
 // aligned to the requirements of |resourceConfig|.
 static Value
-packDynamicSlicesConservatively(IREE::Stream::ResourcePackOp packOp,
-                                Value baseOffset, MutableArrayRef<Slice> slices,
-                                IREE::Stream::ResourceConfigAttr resourceConfig,
-                                IndexSet &indexSet, OpBuilder &builder) {
+packDynamicSlices(IREE::Stream::ResourcePackOp packOp, Value baseOffset,
+                  MutableArrayRef<Slice *> slices,
+                  IREE::Stream::ResourceConfigAttr resourceConfig,
+                  SizeAnalysis &sizeAnalysis, bool runtimeSizedBins,
+                  OpBuilder &builder) {
   auto loc = packOp.getLoc();
   int64_t offsetAlignment = resourceConfig.getMinBufferOffsetAlignment();
   int64_t rangeAlignment = resourceConfig.getMinBufferRangeAlignment();
 
-  // Bucket all slices by their size SSA value. We rely on shapes being
-  // lowered to computed byte sizes and CSE to then dedupe the values for us.
+  // Bucket all slices by their size SSA value and place larger buckets first
+  // so that smaller sizes can alias into them.
   llvm::MapVector<Value, SmallVector<Slice *>> slicesBySize;
-  for (auto &slice : slices) {
-    slicesBySize[slice.dynamicSize].push_back(&slice);
+  for (auto *slice : slices) {
+    slicesBySize[slice->dynamicSize].push_back(slice);
   }
-
-  // Allocate each bucket while observing the lifetime of the slices within.
-  // Two or more slices may overlap in lifetime and need their own unique
-  // reservation.
-  Value offset = baseOffset;
-  for (auto &sizeBucket : slicesBySize) {
-    auto sliceSize = builder.createOrFold<IREE::Util::AlignOp>(
-        loc, sizeBucket.first, rangeAlignment);
-    auto &slices = sizeBucket.second;
-    std::stable_sort(slices.begin(), slices.end());
-
-    // Bin the slices by those that do not overlap. All of the allocations in
-    // each bin can alias.
-    // NOTE: O(n^2) in the worst case but there's usually only a small number
-    // of bins (<10) as we have already bucketed by size class. We could do
-    // some sorting and make this O(nlogn) or O(logn) with some interval tree
-    // magic.
-    struct Bin {
-      Value offset;
-      SmallVector<const Slice *> slices;
-      bool intersects(const Slice &slice) const {
-        for (auto *binSlice : slices) {
-          if (binSlice->intersects(slice))
-            return true;
-        }
-        return false;
+  auto sizeBuckets = slicesBySize.takeVector();
+  llvm::stable_sort(sizeBuckets, [&](auto &lhs, auto &rhs) {
+    return sizeAnalysis.getRange(lhs.first).umax >
+           sizeAnalysis.getRange(rhs.first).umax;
+  });
+
+  // Bin the slices by those that do not overlap. All of the allocations in
+  // each bin can alias.
+  // NOTE: O(n^2) in the worst case but there's usually only a small number
+  // of bins (<10). We could do some sorting and make this O(nlogn) or O(logn)
+  // with some interval tree magic.
+  struct Bin {
+    Value primarySize;
+    // Sizes of slices not provably <= the primary size; runtime max'ed.
+    SmallVector<Value> extraSizes;
+    SmallVector<Slice *> slices;
+    bool intersects(const Slice &slice) const {
+      for (auto *binSlice : slices) {
+        if (binSlice->intersects(slice))
+          return true;
       }
-    };
-    SmallVector<Bin> bins;
-    for (auto *slice : slices) {
-      // Try to find a bin we can reuse (non-intersecting lifetime).
+      return false;
+    }
+  };
+  SmallVector<Bin> bins;
+  for (auto &[size, sizeSlices] : sizeBuckets) {
+    std::stable_sort(sizeSlices.begin(), sizeSlices.end());
+    for (auto *slice : sizeSlices) {
+      // Try to find a bin we can reuse (non-intersecting lifetime and large
+      // enough).
       Bin *targetBin = nullptr;
+      Bin *runtimeBin = nullptr;
       for (auto &bin : bins) {
-        if (!bin.intersects(*slice)) {
+        if (bin.intersects(*slice))
+          continue;
+        if (sizeAnalysis.isLessThanOrEqual(size, bin.primarySize)) {
           targetBin = &bin;
           break;
         }
+        if (runtimeSizedBins && !runtimeBin) {
+          runtimeBin = &bin;
+        }
+      }
+      if (!targetBin && runtimeBin) {
+        targetBin = runtimeBin;
+        if (!llvm::is_contained(targetBin->extraSizes, size)) {
+          targetBin->extraSizes.push_back(size);
+        }
       }
       if (!targetBin) {
         // Allocate a new bin for this slice.
-        bins.push_back({offset, {}});
+        bins.push_back({size, {}, {}});
         targetBin = &bins.back();
-        auto binSize =
-            builder.createOrFold<arith::AddIOp>(loc, offset, sliceSize);
-        offset = builder.createOrFold<IREE::Util::AlignOp>(loc, binSize,
-                                                           offsetAlignment);
       }
       targetBin->slices.push_back(slice);
-      slice->packedOffset.replaceAllUsesWith(targetBin->offset);
     }
   }
 
+  // Assign offsets to bins in the order they were allocated.
+  DenseMap<Value, Value> alignedSizes;
+  auto getAlignedSize = [&](Value size) {
+    auto &alignedSize = alignedSizes[size];
+    if (!alignedSize) {
+      alignedSize =
+          builder.createOrFold<IREE::Util::AlignOp>(loc, size, rangeAlignment);
+    }
+    return alignedSize;
+  };
+  Value offset = baseOffset;
+  for (auto &bin : bins) {
+    Value binSize = getAlignedSize(bin.primarySize);
+    for (Value extraSize : bin.extraSizes) {
+      binSize = builder.createOrFold<arith::MaxUIOp>(loc, binSize,
+                                                     getAlignedSize(extraSize));
+    }
+    for (auto *slice : bin.slices) {
+      slice->packedOffset.replaceAllUsesWith(offset);
+    }
+    auto binEnd = builder.createOrFold<arith::AddIOp>(loc, offset, binSize);
+    offset =
+        builder.createOrFold<IREE::Util::AlignOp>(loc, binEnd, offsetAlignment);
+  }
+
   return builder.createOrFold<IREE::Util::AlignOp>(loc, offset, rangeAlignment);
 }
 
@@ -220,6 +467,8 @@ packDynamicSlicesConservatively(IREE::Stream::ResourcePackOp packOp,
 
 struct LayoutSlicesPass
     : public IREE::Stream::impl::LayoutSlicesPassBase<LayoutSlicesPass> {
+  using IREE::Stream::impl::LayoutSlicesPassBase<
+      LayoutSlicesPass>::LayoutSlicesPassBase;
   void runOnOperation() override {
     mlir::CallableOpInterface parentOp = getOperation();
     if (!parentOp.getCallableRegion() ||
@@ -227,9 +476,10 @@ struct LayoutSlicesPass
       return;
     }
 
-    // NOTE: we could try several algorithms and compute which packs best. For
-    // now we just pack greedily as it's fast and what most existing ML
-    // frameworks do.
+    // Size analysis is only needed when there are dynamically-sized slices and
+    // is computed lazily on the first pack op that has them.
+    std::optional<SizeAnalysis> sizeAnalysis;
+
     parentOp.walk([&](IREE::Stream::ResourcePackOp packOp) {
       // Derive resource constraints based on pack affinity.
       auto resourceConfig = IREE::Stream::ResourceConfigAttr::lookup(packOp);
@@ -250,15 +500,32 @@ struct LayoutSlicesPass
         }
       }
 
+      // Dynamic slices with known upper bounds may be able to alias with
+      // static slices.
+      SmallVector<std::pair<Slice *, SizeRange>> boundedSlices;
+      if (!dynamicSlices.empty()) {
+        if (!sizeAnalysis) {
+          sizeAnalysis.emplace(parentOp);
+        }
+        for (auto &slice : dynamicSlices) {
+          SizeRange range = sizeAnalysis->getRange(slice.dynamicSize);
+          if (range.hasUpperBound()) {
+            boundedSlices.push_back({&slice, range});
+          }
+        }
+      }
+
       OpBuilder builder(packOp);
       IndexSet indexSet(packOp.getLoc(), builder);
 
       // First pack all static slices as these are entirely knowable here at
       // compile time.
       auto offset = packOp.getOffset() ? packOp.getOffset() : indexSet.get(0);
+      DenseSet<const Slice *> placedSlices;
       if (!staticSlices.empty()) {
-        offset = packStaticSlicesGreedily(packOp, offset, staticSlices,
-                                          resourceConfig, indexSet, builder);
+        offset = packStaticSlices(packOp, offset, staticSlices,
+                                  std::move(boundedSlices), placedSlices,
+                                  resourceConfig, indexSet, builder);
 
         // TODO(benvanik): make this an option; it can be useful for debugging
         // this code.
@@ -266,12 +533,17 @@ struct LayoutSlicesPass
         //                                   resourceConfig, indexSet, builder);
       }
 
-      // Next pack all dynamic slices. Depending on the analysis information
-      // available we could reuse static slices with non-overlapping lifetimes
-      // in some cases.
-      if (!dynamicSlices.empty()) {
-        offset = packDynamicSlicesConservatively(
-            packOp, offset, dynamicSlices, resourceConfig, indexSet, builder);
+      // Next pack all dynamic slices that were not placed in the static slab.
+      SmallVector<Slice *> remainingSlices;
+      for (auto &slice : dynamicSlices) {
+        if (!placedSlices.contains(&slice)) {
+          remainingSlices.push_back(&slice);
+        }
+      }
+      if (!remainingSlices.empty()) {
+        offset = packDynamicSlices(packOp, offset, remainingSlices,
+                                   resourceConfig, *sizeAnalysis,
+                                   runtimeSizedBins, builder);
       }
 
       // Total packed length is the current offset after all slices are
@@ -28,6 +28,31 @@ static llvm::cl::opt<bool> clUnifyEncodingForGlobals(
                    "reduce memory. It is an experimental flag for data-tiling"),
     llvm::cl::init(false));
 
+static llvm::cl::opt<bool> clLayoutRuntimeSizedBins(
+    "iree-stream-layout-runtime-sized-bins",
+    llvm::cl::desc("Allows transient slices with unrelated dynamic sizes and "
+                   "disjoint lifetimes to alias with the aliased range sized "
+                   "at runtime to the maximum of the slice sizes."),
+    llvm::cl::init(false));
+
+static llvm::cl::opt<int64_t> clScheduleMaxConcurrency(
+    "iree-stream-schedule-max-concurrency",
+    llvm::cl::desc("Maximum number of operations scheduled to execute "
+                   "concurrently in a wave or 0 for no limit."),
+    llvm::cl::init(0));
+
+static llvm::cl::opt<int64_t> clScheduleWaveBytesBudget(
+    "iree-stream-schedule-wave-bytes-budget",
+    llvm::cl::desc("Maximum combined bytes accessed by operations scheduled to "
+                   "execute concurrently in a wave or 0 for no limit."),
+    llvm::cl::init(0));
+
+static llvm::cl::opt<bool> clDumpConcurrencySchedule(
+    "iree-stream-dump-concurrency-schedule",
+    llvm::cl::desc("Prints the concurrency waves chosen for each execution "
+                   "region and their estimated costs to stderr."),
+    llvm::cl::init(false));
+
 namespace mlir::iree_compiler::IREE::Stream {
 
 using FunctionLikeNest =
@@ -251,7 +276,14 @@ void buildStreamAsyncPassPipeline(OpPassManager &passManager,
       // Combine async work into execution regions.
       .addPass(IREE::Stream::createScheduleExecutionPass)
       // Group concurrently executable work into waves.
-      .addPass(IREE::Stream::createScheduleConcurrencyPass);
+      .addPass([]() {
+        return IREE::Stream::createScheduleConcurrencyPass(
+            ScheduleConcurrencyPassOptions{
+                clScheduleMaxConcurrency,
+                clScheduleWaveBytesBudget,
+                clDumpConcurrencySchedule,
+            });
+      });
 
   // When synchronous initialization is requested we need to separate any work
   // behind a timepoint in the initializer from the consumers of that timepoint.
@@ -307,7 +339,10 @@ void buildStreamCmdPassPipeline(OpPassManager &passManager,
       // Layout packed slices to emit the arithmetic required for all resource
       // offsets. This enables us to propagate the subviews across the program
       // below.
-      .addPass(IREE::Stream::createLayoutSlicesPass)
+      .addPass([]() {
+        return IREE::Stream::createLayoutSlicesPass(
+            LayoutSlicesPassOptions{clLayoutRuntimeSizedBins});
+      })
 
       // Apply canonicalization patterns to clean up subview ops prior to
       // propagating subranges.
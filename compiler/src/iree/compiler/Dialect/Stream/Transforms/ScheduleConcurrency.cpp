@@ -14,6 +14,7 @@
 #include "iree/compiler/Dialect/Util/IR/UtilTypes.h"
 #include "llvm/ADT/BitVector.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/raw_ostream.h"
 #include "mlir/Analysis/TopologicalSortUtils.h"
 #include "mlir/IR/Attributes.h"
 #include "mlir/IR/Builders.h"
@@ -173,6 +174,50 @@ struct WavePartitionBuilder {
   IRMapping mapping;
 };
 
+//===----------------------------------------------------------------------===//
+// Schedule dumping
+//===----------------------------------------------------------------------===//
+
+// Prints a short description of |op| suitable for identifying it in a dump.
+static void printScheduledOp(Operation *op, llvm::raw_ostream &os) {
+  os << op->getName();
+  if (auto dispatchOp = dyn_cast<IREE::Stream::AsyncDispatchOp>(op)) {
+    os << " ";
+    llvm::interleaveComma(dispatchOp.getEntryPointRefs(), os);
+  }
+}
+
+// Prints the waves in |waveSet| formed from the execution region |executeOp|
+// along with the costs estimated by |costModel| to |os|.
+static void printSchedule(IREE::Stream::AsyncExecuteOp executeOp,
+                          PartitionSet &waveSet,
+                          PartitioningCostModel &costModel,
+                          llvm::raw_ostream &os) {
+  os << "execution region at " << executeOp.getLoc() << ": "
+     << waveSet.size() << " waves\n";
+  for (auto [ordinal, wave] : llvm::enumerate(waveSet.partitions)) {
+    SmallVector<std::pair<Operation *, OpCost>> opCosts;
+    OpCost waveCost;
+    for (auto *op : llvm::reverse(wave.ops)) {
+      if (!isa<IREE::Stream::StreamableOpInterface>(op))
+        continue;
+      auto opCost = costModel.estimateCost(op);
+      waveCost += opCost;
+      opCosts.push_back(std::make_pair(op, opCost));
+    }
+    os << "  wave " << ordinal << ": " << opCosts.size() << " ops (";
+    waveCost.print(os);
+    os << ")\n";
+    for (auto [op, opCost] : opCosts) {
+      os << "    ";
+      printScheduledOp(op, os);
+      os << " (";
+      opCost.print(os);
+      os << ")\n";
+    }
+  }
+}
+
 //===----------------------------------------------------------------------===//
 // --iree-stream-schedule-concurrency
 //===----------------------------------------------------------------------===//
@@ -180,20 +225,48 @@ struct WavePartitionBuilder {
 struct ScheduleConcurrencyPass
     : public IREE::Stream::impl::ScheduleConcurrencyPassBase<
           ScheduleConcurrencyPass> {
+  using IREE::Stream::impl::ScheduleConcurrencyPassBase<
+      ScheduleConcurrencyPass>::ScheduleConcurrencyPassBase;
+
   void runOnOperation() override {
     mlir::CallableOpInterface parentOp = getOperation();
     if (!parentOp.getCallableRegion() ||
         parentOp.getCallableRegion()->empty()) {
       return;
     }
+
+    // The cost model only constrains partitioning when limits are specified
+    // but is always available to estimate costs when dumping.
+    StaticCostModel costModel(StaticCostModelOptions{
+        /*maxConcurrency=*/maxConcurrency,
+        /*waveBytesBudget=*/waveBytesBudget,
+    });
+
+    // Dumps are buffered per callable so that they don't interleave when
+    // running multithreaded.
+    std::string dumpStr;
+    llvm::raw_string_ostream dumpStream(dumpStr);
     for (auto executeOp :
          parentOp.getCallableRegion()->getOps<IREE::Stream::AsyncExecuteOp>()) {
-      if (failed(runOnRegion(executeOp)))
+      if (failed(runOnRegion(executeOp, costModel,
+                             dumpSchedule ? &dumpStream : nullptr)))
         return signalPassFailure();
     }
+    if (!dumpStr.empty()) {
+      llvm::errs() << "schedule for ";
+      if (auto symbolOp =
+              dyn_cast<SymbolOpInterface>(parentOp.getOperation())) {
+        llvm::errs() << "@" << symbolOp.getName();
+      } else {
+        llvm::errs() << parentOp->getName();
+      }
+      llvm::errs() << ":\n" << dumpStr;
+    }
   }
 
-  LogicalResult runOnRegion(IREE::Stream::AsyncExecuteOp parentOp) {
+  LogicalResult runOnRegion(IREE::Stream::AsyncExecuteOp parentOp,
+                            StaticCostModel &costModel,
+                            llvm::raw_ostream *dumpStream) {
     if (parentOp.getBody().empty()) {
       return success();
     }
@@ -204,11 +277,15 @@ struct ScheduleConcurrencyPass
 
     // Compute a set of partitions covering all of the streamable ops in the
     // execution region.
-    auto waveSet = partitionRegionConcurrency(configAttr, block);
+    auto waveSet = partitionRegionConcurrency(
+        configAttr, block, costModel.isEnabled() ? &costModel : nullptr);
     if (waveSet.empty())
       return success();
     if (failed(waveSet.verify(parentOp.getLoc())))
       return failure();
+    if (dumpStream) {
+      printSchedule(parentOp, waveSet, costModel, *dumpStream);
+    }
 
     // Create partition builders for each partition.
     // We'll clone ops into each and insert them into the block at the
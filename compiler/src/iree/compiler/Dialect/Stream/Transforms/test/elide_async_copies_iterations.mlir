@@ -0,0 +1,93 @@
+// RUN: iree-opt --split-input-file --iree-stream-elide-async-copies %s | FileCheck %s
+// RUN: iree-opt --split-input-file --iree-stream-elide-async-copies --mlir-pass-statistics --mlir-pass-statistics-display=list %s -o /dev/null 2>&1 | FileCheck %s --check-prefix=STATS
+
+// Tests that an elision in one callable enables an elision in a related
+// callable in a later iteration. The dead clone in the caller is the last user
+// of %splat and prevents the call from moving it into the callee during the
+// first iteration. Once it is elided the second iteration reanalyzes both
+// callables and finds the callee argument is now passed by-value.
+//
+// Iteration 0 analyzes both callables and elides the caller clone, iteration 1
+// reanalyzes both and elides the callee clone, and iteration 2 reanalyzes both
+// and quiesces.
+
+// STATS-LABEL: Pass statistics report
+// STATS: ElideAsyncCopiesPass
+// STATS-DAG: (S) 6 num-callables-analyzed
+// STATS-DAG: (S) 2 num-clones-elided
+// STATS-DAG: (S) 2 num-iterations
+
+// CHECK-LABEL: util.func private @chainedCallee
+// CHECK-SAME: (%[[ARG:.+]]: !stream.resource<*>, %{{.+}}: index)
+util.func private @chainedCallee(%arg: !stream.resource<*>, %size: index) -> !stream.resource<*> {
+  %c0 = arith.constant 0 : index
+  %c128 = arith.constant 128 : index
+  %c123_i32 = arith.constant 123 : i32
+  // CHECK-NOT: stream.async.clone
+  %clone = stream.async.clone %arg : !stream.resource<*>{%size} -> !stream.resource<*>{%size}
+  // CHECK: %[[FILL:.+]] = stream.async.fill %c123_i32, %[[ARG]]
+  %fill = stream.async.fill %c123_i32, %clone[%c0 to %c128 for %c128] : i32 -> %0 as !stream.resource<*>{%size}
+  // CHECK: util.return %[[FILL]]
+  util.return %fill : !stream.resource<*>
+}
+// CHECK-LABEL: @chainedCaller
+util.func public @chainedCaller(%size: index) -> !stream.resource<*> {
+  %c123_i32 = arith.constant 123 : i32
+  // CHECK: %[[SPLAT:.+]] = stream.async.splat
+  %splat = stream.async.splat %c123_i32 : i32 -> !stream.resource<*>{%size}
+  // CHECK: %[[RESULT:.+]] = util.call @chainedCallee(%[[SPLAT]]
+  %result = util.call @chainedCallee(%splat, %size) : (!stream.resource<*>, index) -> !stream.resource<*>
+  // CHECK-NOT: stream.async.clone
+  %dead = stream.async.clone %splat : !stream.resource<*>{%size} -> !stream.resource<*>{%size}
+  // CHECK: util.return %[[RESULT]]
+  util.return %result : !stream.resource<*>
+}
+
+// -----
+
+// Tests that callables unrelated to those with elisions are only analyzed in
+// the first iteration and left untouched. The clone in @unrelatedFunc is of a
+// public function argument and must be preserved.
+//
+// Iteration 0 analyzes all three callables and elides the callee clone and
+// iteration 1 reanalyzes only the caller and callee and quiesces.
+
+// STATS-LABEL: Pass statistics report
+// STATS: ElideAsyncCopiesPass
+// STATS-DAG: (S) 5 num-callables-analyzed
+// STATS-DAG: (S) 1 num-clones-elided
+// STATS-DAG: (S) 1 num-iterations
+
+// CHECK-LABEL: util.func public @unrelatedFunc
+// CHECK-SAME: (%[[ARG:.+]]: !stream.resource<*>, %{{.+}}: index)
+util.func public @unrelatedFunc(%arg: !stream.resource<*>, %size: index) -> !stream.resource<*> {
+  %c0 = arith.constant 0 : index
+  %c128 = arith.constant 128 : index
+  %c123_i32 = arith.constant 123 : i32
+  // CHECK: %[[CLONE:.+]] = stream.async.clone %[[ARG]]
+  %clone = stream.async.clone %arg : !stream.resource<*>{%size} -> !stream.resource<*>{%size}
+  // CHECK: %[[FILL:.+]] = stream.async.fill %c123_i32, %[[CLONE]]
+  %fill = stream.async.fill %c123_i32, %clone[%c0 to %c128 for %c128] : i32 -> %0 as !stream.resource<*>{%size}
+  // CHECK: util.return %[[FILL]]
+  util.return %fill : !stream.resource<*>
+}
+// CHECK-LABEL: util.func private @movedCallee
+// CHECK-SAME: (%[[ARG:.+]]: !stream.resource<*>, %{{.+}}: index)
+util.func private @movedCallee(%arg: !stream.resource<*>, %size: index) -> !stream.resource<*> {
+  %c0 = arith.constant 0 : index
+  %c128 = arith.constant 128 : index
+  %c123_i32 = arith.constant 123 : i32
+  // CHECK-NOT: stream.async.clone
+  %clone = stream.async.clone %arg : !stream.resource<*>{%size} -> !stream.resource<*>{%size}
+  // CHECK: %[[FILL:.+]] = stream.async.fill %c123_i32, %[[ARG]]
+  %fill = stream.async.fill %c123_i32, %clone[%c0 to %c128 for %c128] : i32 -> %0 as !stream.resource<*>{%size}
+  // CHECK: util.return %[[FILL]]
+  util.return %fill : !stream.resource<*>
+}
+// CHECK-LABEL: @movedCaller
+util.func public @movedCaller(%size: index) -> !stream.resource<*> {
+  %c123_i32 = arith.constant 123 : i32
+  %splat = stream.async.splat %c123_i32 : i32 -> !stream.resource<*>{%size}
+  %result = util.call @movedCallee(%splat, %size) : (!stream.resource<*>, index) -> !stream.resource<*>
+  util.return %result : !stream.resource<*>
+}
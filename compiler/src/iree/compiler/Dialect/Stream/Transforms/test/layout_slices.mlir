@@ -1,4 +1,5 @@
-// RUN: iree-opt --split-input-file --pass-pipeline='builtin.module(util.func(iree-stream-layout-slices, cse))' %s | FileCheck %s
+// RUN: iree-opt --split-input-file --pass-pipeline='builtin.module(util.func(iree-stream-layout-slices, cse))' %s | FileCheck %s --check-prefixes=CHECK,DEFAULT
+// RUN: iree-opt --split-input-file --pass-pipeline='builtin.module(util.func(iree-stream-layout-slices{runtime-sized-bins=true}, cse))' %s | FileCheck %s --check-prefixes=CHECK,RUNTIME
 
 #layoutStaticConfig = #stream.resource_config<{
   max_allocation_size = 1073741824,
@@ -91,3 +92,132 @@ util.func public @layoutMixedStaticDynamic(%size_a: index, %size_b: index) -> (i
   // CHECK: util.return %3, %c0, %c208, %1, %c0
   util.return %t#0, %t#1, %t#2, %t#3, %t#4 : index, index, index, index, index
 }
+
+// -----
+
+#layoutStaticBestFitConfig = #stream.resource_config<{
+  max_allocation_size = 1073741824,
+  min_buffer_offset_alignment = 16,
+  max_buffer_range = 1073741824,
+  min_buffer_range_alignment = 16,
+  index_bits = 32
+}>
+
+// Placing slices in lifetime order needs 176 bytes while placing them largest
+// first (best-fit decreasing) only needs 128.
+
+// CHECK-LABEL: @layoutStaticBestFit
+util.func public @layoutStaticBestFit() -> (index, index, index, index, index)
+    attributes {stream.resources = #layoutStaticBestFitConfig} {
+  %c48 = arith.constant 48 : index
+  %c64 = arith.constant 64 : index
+  %t:5 = stream.resource.pack slices({
+    [1, 1] = %c48,  // +64 (after [1, 3])
+    [1, 3] = %c64,  // +0
+    [3, 5] = %c64,  // +64 (after [4, 5])
+    [4, 5] = %c64,  // +0 (reuse [1, 3])
+  }) : index
+  // CHECK: util.return %c128
+  // CHECK-SAME: %c64, %c0, %c64, %c0
+  util.return %t#0, %t#1, %t#2, %t#3, %t#4 : index, index, index, index, index
+}
+
+// -----
+
+#layoutBoundedDynamicConfig = #stream.resource_config<{
+  max_allocation_size = 1073741824,
+  min_buffer_offset_alignment = 16,
+  max_buffer_range = 1073741824,
+  min_buffer_range_alignment = 16,
+  index_bits = 32
+}>
+
+// Dynamically-sized slices with known upper bounds can be placed in gaps of the
+// static layout so long as they don't grow it.
+
+// CHECK-LABEL: @layoutBoundedDynamic
+// CHECK-SAME: (%[[SIZE_A:.+]]: index, %[[SIZE_B:.+]]: index)
+util.func public @layoutBoundedDynamic(%size_a: index, %size_b: index) -> (index, index, index, index, index)
+    attributes {stream.resources = #layoutBoundedDynamicConfig} {
+  %c64 = arith.constant 64 : index
+  %c200 = arith.constant 200 : index
+  %bounded_a = util.assume.int %size_a<umin=0, umax=100> : index
+  %t:5 = stream.resource.pack slices({
+    [0, 1] = %c200,       // +0
+    [2, 3] = %c64,        // +0 (reuse [0, 1])
+    [2, 3] = %bounded_a,  // +64 (reserves 112 of the 208 static bytes)
+    [2, 3] = %size_b,     // +208 (unbounded)
+  }) : index
+
+  // CHECK-DAG: %c0 = arith.constant 0 : index
+  // CHECK-DAG: %c64 = arith.constant 64 : index
+  // CHECK-DAG: %c208 = arith.constant 208 : index
+  // CHECK-DAG: %[[ALIGNED_B:.+]] = util.align %[[SIZE_B]], %c16 : index
+  // CHECK-DAG: %[[TOTAL:.+]] = arith.addi %[[ALIGNED_B]], %c208 : index
+
+  // CHECK: util.return %[[TOTAL]], %c0, %c0, %c64, %c208
+  util.return %t#0, %t#1, %t#2, %t#3, %t#4 : index, index, index, index, index
+}
+
+// -----
+
+#layoutRelatedDynamicConfig = #stream.resource_config<{
+  max_allocation_size = 1073741824,
+  min_buffer_offset_alignment = 16,
+  max_buffer_range = 1073741824,
+  min_buffer_range_alignment = 16,
+  index_bits = 32
+}>
+
+// Dynamically-sized slices can alias with non-overlapping slices that are
+// provably at least as large.
+
+// CHECK-LABEL: @layoutRelatedDynamic
+// CHECK-SAME: (%[[SIZE_A:.+]]: index)
+util.func public @layoutRelatedDynamic(%size_a: index) -> (index, index, index)
+    attributes {stream.resources = #layoutRelatedDynamicConfig} {
+  %c2 = arith.constant 2 : index
+  // CHECK: %[[SIZE_B:.+]] = arith.muli %[[SIZE_A]], %c2
+  %size_b = arith.muli %size_a, %c2 : index
+  %t:3 = stream.resource.pack slices({
+    [0, 1] = %size_b,
+    [2, 3] = %size_a,  // reuses [0, 1] as size_a <= size_a * 2
+  }) : index
+
+  // CHECK: %[[ALIGNED_B:.+]] = util.align %[[SIZE_B]], %c16 : index
+  // CHECK: util.return %[[ALIGNED_B]], %c0, %c0
+  util.return %t#0, %t#1, %t#2 : index, index, index
+}
+
+// -----
+
+#layoutRuntimeSizedBinsConfig = #stream.resource_config<{
+  max_allocation_size = 1073741824,
+  min_buffer_offset_alignment = 16,
+  max_buffer_range = 1073741824,
+  min_buffer_range_alignment = 16,
+  index_bits = 32
+}>
+
+// Unrelated dynamic sizes only alias when runtime-sized bins are enabled in
+// which case the shared range is the max of the sizes.
+
+// CHECK-LABEL: @layoutRuntimeSizedBins
+// CHECK-SAME: (%[[SIZE_A:.+]]: index, %[[SIZE_B:.+]]: index)
+util.func public @layoutRuntimeSizedBins(%size_a: index, %size_b: index) -> (index, index, index)
+    attributes {stream.resources = #layoutRuntimeSizedBinsConfig} {
+  %t:3 = stream.resource.pack slices({
+    [0, 1] = %size_a,
+    [2, 3] = %size_b,
+  }) : index
+
+  // CHECK-DAG: %[[ALIGNED_A:.+]] = util.align %[[SIZE_A]], %c16 : index
+  // CHECK-DAG: %[[ALIGNED_B:.+]] = util.align %[[SIZE_B]], %c16 : index
+
+  // DEFAULT: %[[TOTAL:.+]] = arith.addi %[[ALIGNED_A]], %[[ALIGNED_B]] : index
+  // DEFAULT: util.return %[[TOTAL]], %c0, %[[ALIGNED_A]]
+
+  // RUNTIME: %[[TOTAL:.+]] = arith.maxui %[[ALIGNED_A]], %[[ALIGNED_B]] : index
+  // RUNTIME: util.return %[[TOTAL]], %c0, %c0
+  util.return %t#0, %t#1, %t#2 : index, index, index
+}
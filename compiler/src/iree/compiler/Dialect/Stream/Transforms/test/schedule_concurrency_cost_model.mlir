@@ -0,0 +1,97 @@
+// RUN: iree-opt --split-input-file --pass-pipeline="builtin.module(util.func(iree-stream-schedule-concurrency))" %s | FileCheck %s --check-prefixes=CHECK,DEFAULT
+// RUN: iree-opt --split-input-file --pass-pipeline="builtin.module(util.func(iree-stream-schedule-concurrency{max-concurrency=2 wave-bytes-budget=1024}))" %s | FileCheck %s --check-prefixes=CHECK,LIMITED
+// RUN: iree-opt --split-input-file --pass-pipeline="builtin.module(util.func(iree-stream-schedule-concurrency{max-concurrency=2 wave-bytes-budget=1024 dump-schedule=true}))" %s -o /dev/null 2>&1 | FileCheck %s --check-prefix=DUMP
+
+// Tests that the cost model limits the width of waves and keeps large ops from
+// executing concurrently with others. Without limits all four independent
+// dispatches are placed into a single wave.
+
+// DUMP-LABEL: schedule for @costModelLimits:
+// DUMP-NEXT: execution region at {{.+}}: 3 waves
+// DUMP-NEXT:   wave 0: 1 ops (workload=4 bytes=128 flops=?)
+// DUMP-NEXT:     stream.async.dispatch @ex::@dispatch_a (workload=4 bytes=128 flops=?)
+// DUMP-NEXT:   wave 1: 2 ops (workload=8 bytes=256 flops=?)
+// DUMP-NEXT:     stream.async.dispatch @ex::@dispatch_b (workload=4 bytes=128 flops=?)
+// DUMP-NEXT:     stream.async.dispatch @ex::@dispatch_c (workload=4 bytes=128 flops=?)
+// DUMP-NEXT:   wave 2: 1 ops (workload=64 bytes=8192 flops=?)
+// DUMP-NEXT:     stream.async.dispatch @ex::@dispatch_large (workload=64 bytes=8192 flops=?)
+
+// CHECK-LABEL: @costModelLimits
+util.func public @costModelLimits(%arg0: !stream.resource<external>) -> (!stream.resource<transient>, !stream.resource<transient>, !stream.resource<transient>, !stream.resource<transient>)
+    attributes {stream.partitioning = #stream.partitioning_config<"max-concurrency">} {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  %c64 = arith.constant 64 : index
+  %c4096 = arith.constant 4096 : index
+  // CHECK: stream.async.execute
+  %results:4, %result_timepoint = stream.async.execute with(%arg0 as %capture: !stream.resource<external>{%c4096}) -> (!stream.resource<transient>{%c64}, !stream.resource<transient>{%c64}, !stream.resource<transient>{%c64}, !stream.resource<transient>{%c4096}) {
+    // DEFAULT: stream.async.concurrent
+    // DEFAULT-NEXT: stream.async.dispatch @ex::@dispatch_a
+    // DEFAULT-NEXT: stream.async.dispatch @ex::@dispatch_b
+    // DEFAULT-NEXT: stream.async.dispatch @ex::@dispatch_c
+    // DEFAULT-NEXT: stream.async.dispatch @ex::@dispatch_large
+    // DEFAULT-NEXT: stream.yield
+
+    // LIMITED: stream.async.concurrent
+    // LIMITED-NEXT: stream.async.dispatch @ex::@dispatch_b
+    // LIMITED-NEXT: stream.async.dispatch @ex::@dispatch_c
+    // LIMITED-NEXT: stream.yield
+    // LIMITED-NOT: stream.async.concurrent
+    // LIMITED: stream.async.dispatch @ex::@dispatch_a
+    // LIMITED-NOT: stream.async.concurrent
+    // LIMITED: stream.async.dispatch @ex::@dispatch_large
+    %0 = stream.async.dispatch @ex::@dispatch_a[%c4, %c1, %c1](%capture[%c0 to %c64 for %c64]) : (!stream.resource<external>{%c4096}) -> !stream.resource<transient>{%c64}
+    %1 = stream.async.dispatch @ex::@dispatch_b[%c4, %c1, %c1](%capture[%c0 to %c64 for %c64]) : (!stream.resource<external>{%c4096}) -> !stream.resource<transient>{%c64}
+    %2 = stream.async.dispatch @ex::@dispatch_c[%c4, %c1, %c1](%capture[%c0 to %c64 for %c64]) : (!stream.resource<external>{%c4096}) -> !stream.resource<transient>{%c64}
+    %3 = stream.async.dispatch @ex::@dispatch_large[%c64, %c1, %c1](%capture[%c0 to %c4096 for %c4096]) : (!stream.resource<external>{%c4096}) -> !stream.resource<transient>{%c4096}
+    stream.yield %0, %1, %2, %3 : !stream.resource<transient>{%c64}, !stream.resource<transient>{%c64}, !stream.resource<transient>{%c64}, !stream.resource<transient>{%c4096}
+  } => !stream.timepoint
+  %ready:4 = stream.timepoint.await %result_timepoint => %results#0, %results#1, %results#2, %results#3 : !stream.resource<transient>{%c64}, !stream.resource<transient>{%c64}, !stream.resource<transient>{%c64}, !stream.resource<transient>{%c4096}
+  util.return %ready#0, %ready#1, %ready#2, %ready#3 : !stream.resource<transient>, !stream.resource<transient>, !stream.resource<transient>, !stream.resource<transient>
+}
+
+// -----
+
+// Tests that ops with dynamically sized accesses are assumed to exceed the
+// bytes budget and are scheduled alone while statically sized ops still share
+// a wave.
+
+// DUMP-LABEL: schedule for @costModelDynamicBytes:
+// DUMP-NEXT: execution region at {{.+}}: 2 waves
+// DUMP-NEXT:   wave 0: 2 ops (workload=8 bytes=256 flops=?)
+// DUMP-NEXT:     stream.async.dispatch @ex::@dispatch_a (workload=4 bytes=128 flops=?)
+// DUMP-NEXT:     stream.async.dispatch @ex::@dispatch_b (workload=4 bytes=128 flops=?)
+// DUMP-NEXT:   wave 1: 1 ops (workload=4 bytes=? flops=?)
+// DUMP-NEXT:     stream.async.dispatch @ex::@dispatch_dynamic (workload=4 bytes=? flops=?)
+
+// CHECK-LABEL: @costModelDynamicBytes
+util.func public @costModelDynamicBytes(%arg0: !stream.resource<external>, %size: index) -> (!stream.resource<transient>, !stream.resource<transient>, !stream.resource<transient>)
+    attributes {stream.partitioning = #stream.partitioning_config<"max-concurrency">} {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  %c64 = arith.constant 64 : index
+  %c4096 = arith.constant 4096 : index
+  // CHECK: stream.async.execute
+  %results:3, %result_timepoint = stream.async.execute with(%arg0 as %capture: !stream.resource<external>{%c4096}) -> (!stream.resource<transient>{%c64}, !stream.resource<transient>{%c64}, !stream.resource<transient>{%size}) {
+    // DEFAULT: stream.async.concurrent
+    // DEFAULT-NEXT: stream.async.dispatch @ex::@dispatch_a
+    // DEFAULT-NEXT: stream.async.dispatch @ex::@dispatch_b
+    // DEFAULT-NEXT: stream.async.dispatch @ex::@dispatch_dynamic
+    // DEFAULT-NEXT: stream.yield
+
+    // LIMITED: stream.async.concurrent
+    // LIMITED-NEXT: stream.async.dispatch @ex::@dispatch_a
+    // LIMITED-NEXT: stream.async.dispatch @ex::@dispatch_b
+    // LIMITED-NEXT: stream.yield
+    // LIMITED-NOT: stream.async.concurrent
+    // LIMITED: stream.async.dispatch @ex::@dispatch_dynamic
+    %0 = stream.async.dispatch @ex::@dispatch_a[%c4, %c1, %c1](%capture[%c0 to %c64 for %c64]) : (!stream.resource<external>{%c4096}) -> !stream.resource<transient>{%c64}
+    %1 = stream.async.dispatch @ex::@dispatch_b[%c4, %c1, %c1](%capture[%c0 to %c64 for %c64]) : (!stream.resource<external>{%c4096}) -> !stream.resource<transient>{%c64}
+    %2 = stream.async.dispatch @ex::@dispatch_dynamic[%c4, %c1, %c1](%capture[%c0 to %size for %size]) : (!stream.resource<external>{%c4096}) -> !stream.resource<transient>{%size}
+    stream.yield %0, %1, %2 : !stream.resource<transient>{%c64}, !stream.resource<transient>{%c64}, !stream.resource<transient>{%size}
+  } => !stream.timepoint
+  %ready:3 = stream.timepoint.await %result_timepoint => %results#0, %results#1, %results#2 : !stream.resource<transient>{%c64}, !stream.resource<transient>{%c64}, !stream.resource<transient>{%size}
+  util.return %ready#0, %ready#1, %ready#2 : !stream.resource<transient>, !stream.resource<transient>, !stream.resource<transient>
+}
@@ -62,6 +62,9 @@ public:
   // An allocator whose lifetime is at least as long as the solver.
   llvm::BumpPtrAllocator &getAllocator() { return allocator; }
 
+  // Returns the total number of abstract elements registered with the solver.
+  size_t getElementCount() const { return elementMap.size(); }
+
   // Returns the element of |ElementT| for |pos| and adds a dependency from
   // |queryingElement| to the returned element with the given |resolution|.
   template <typename ElementT>
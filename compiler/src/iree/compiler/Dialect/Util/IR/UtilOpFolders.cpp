@@ -754,6 +754,12 @@ static bool isAlignedTo(Value value, Value alignment) {
         isAlignedTo(sourceMulOp.getRhs(), alignment)) {
       return true;
     }
+  } else if (auto sourceMaxOp = value.getDefiningOp<arith::MaxUIOp>()) {
+    // The max of two aligned values is one of the aligned values.
+    if (isAlignedTo(sourceMaxOp.getLhs(), alignment) &&
+        isAlignedTo(sourceMaxOp.getRhs(), alignment)) {
+      return true;
+    }
   }
 
   return false;
@@ -124,6 +124,24 @@ util.func public @foldMulAlignmentConstant(%lhs: index) -> index {
 
 // -----
 
+// CHECK-LABEL: @foldMaxAlignment
+// CHECK-SAME: (%[[LHS:.+]]: index, %[[RHS:.+]]: index)
+util.func public @foldMaxAlignment(%lhs: index, %rhs: index) -> index {
+  %c64 = arith.constant 64 : index
+  // CHECK: %[[LHS_ALIGNED:.+]] = util.align %[[LHS]], %c64
+  %lhs_aligned = util.align %lhs, %c64 : index
+  // CHECK: %[[RHS_ALIGNED:.+]] = util.align %[[RHS]], %c64
+  %rhs_aligned = util.align %rhs, %c64 : index
+  // CHECK: %[[RESULT:.+]] = arith.maxui %[[LHS_ALIGNED]], %[[RHS_ALIGNED]]
+  %max = arith.maxui %lhs_aligned, %rhs_aligned : index
+  // CHECK-NOT: util.align
+  %result = util.align %max, %c64 : index
+  // CHECK: util.return %[[RESULT]]
+  util.return %result : index
+}
+
+// -----
+
 // CHECK-LABEL: @foldConstantAlign
 util.func public @foldConstantAlign() -> (index, index, index) {
   %c0 = arith.constant 0 : index
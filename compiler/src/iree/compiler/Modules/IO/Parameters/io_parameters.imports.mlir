@@ -26,6 +26,12 @@ vm.import private @gather(
   %spans : !vm.buffer
 )
 
+// Returns the length of the parameter in bytes or -1 if it is not found.
+vm.import private @query(
+  %source_scope : !vm.buffer,
+  %key : !vm.buffer
+) -> i64
+
 vm.import private @scatter(
   %device : !vm.ref<!hal.device>,
   %queue_affinity : i64,
@@ -9,6 +9,12 @@
 
 #include "iree/base/api.h"
 
+#if defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_LINUX)
+#include <errno.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // IREE_PLATFORM_ANDROID || IREE_PLATFORM_LINUX
+
 //===----------------------------------------------------------------------===//
 // iree_allocator_t (std::allocator-like interface)
 //===----------------------------------------------------------------------===//
@@ -62,6 +68,91 @@ IREE_API_EXPORT void iree_allocator_free(iree_allocator_t allocator,
   }
 }
 
+IREE_API_EXPORT iree_status_t iree_allocator_bind(
+    iree_allocator_t allocator, void* ptr, iree_host_size_t byte_length,
+    iree_allocator_node_id_t node_id, iree_allocator_bind_flags_t flags) {
+  if (!ptr || !byte_length || node_id == IREE_ALLOCATOR_NODE_ID_ANY) {
+    return iree_ok_status();
+  }
+  if (IREE_UNLIKELY(!allocator.ctl)) {
+    return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                            "null allocator cannot bind memory");
+  }
+  iree_allocator_bind_params_t params = {
+      .byte_length = byte_length,
+      .node_id = node_id,
+      .flags = flags,
+  };
+  return allocator.ctl(allocator.self, IREE_ALLOCATOR_COMMAND_BIND, &params,
+                       &ptr);
+}
+
+//===----------------------------------------------------------------------===//
+// NUMA placement of host pages
+//===----------------------------------------------------------------------===//
+
+#if (defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_LINUX)) && \
+    defined(__NR_mbind)
+
+// From linux/mempolicy.h; defined here to avoid requiring kernel headers.
+#define IREE_MPOL_PREFERRED 1
+#define IREE_MPOL_BIND 2
+#define IREE_MPOL_MF_MOVE (1 << 1)
+
+// Maximum NUMA node ID (exclusive) we support binding to. The kernel default
+// CONFIG_NODES_SHIFT is at most 10 so this covers all configurations.
+#define IREE_MPOL_MAX_NODES 1024
+
+IREE_API_EXPORT iree_status_t iree_allocator_bind_host_pages(
+    const iree_allocator_bind_params_t* params, void* ptr) {
+  IREE_ASSERT_ARGUMENT(params);
+  if (params->node_id >= IREE_MPOL_MAX_NODES) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "NUMA node %u out of range", params->node_id);
+  }
+
+  // mbind requires a page-aligned start and operates on whole pages. We only
+  // bind pages fully covered by the range so that we don't change the policy
+  // of neighboring allocations that happen to share the boundary pages.
+  const uintptr_t page_size = (uintptr_t)sysconf(_SC_PAGESIZE);
+  const uintptr_t range_start =
+      ((uintptr_t)ptr + page_size - 1) & ~(page_size - 1);
+  const uintptr_t range_end =
+      ((uintptr_t)ptr + params->byte_length) & ~(page_size - 1);
+  if (range_end <= range_start) return iree_ok_status();
+
+  unsigned long node_mask[IREE_MPOL_MAX_NODES / (8 * sizeof(unsigned long))];
+  memset(node_mask, 0, sizeof(node_mask));
+  node_mask[params->node_id / (8 * sizeof(unsigned long))] =
+      1ul << (params->node_id % (8 * sizeof(unsigned long)));
+  const int mode = iree_all_bits_set(params->flags,
+                                     IREE_ALLOCATOR_BIND_FLAG_STRICT)
+                       ? IREE_MPOL_BIND
+                       : IREE_MPOL_PREFERRED;
+  const unsigned flags =
+      iree_all_bits_set(params->flags, IREE_ALLOCATOR_BIND_FLAG_MOVE)
+          ? IREE_MPOL_MF_MOVE
+          : 0;
+  // NOTE: maxnode is the number of bits in the mask plus one (the kernel
+  // historically drops the last bit).
+  if (syscall(__NR_mbind, (void*)range_start, range_end - range_start, mode,
+              node_mask, (unsigned long)IREE_MPOL_MAX_NODES + 1, flags) != 0) {
+    return iree_make_status(iree_status_code_from_errno(errno),
+                            "mbind to NUMA node %u failed", params->node_id);
+  }
+  return iree_ok_status();
+}
+
+#else
+
+IREE_API_EXPORT iree_status_t iree_allocator_bind_host_pages(
+    const iree_allocator_bind_params_t* params, void* ptr) {
+  return iree_make_status(IREE_STATUS_UNAVAILABLE,
+                          "NUMA memory binding not available on this platform");
+}
+
+#endif  // IREE_PLATFORM_ANDROID || IREE_PLATFORM_LINUX
+
 //===----------------------------------------------------------------------===//
 // Built-in iree_allocator_t implementations
 //===----------------------------------------------------------------------===//
@@ -172,11 +172,18 @@ typedef enum iree_allocator_command_e {
   //   inout_ptr: pointer to free
   IREE_ALLOCATOR_COMMAND_FREE = 3,
 
-  // TODO(benvanik): add optional IREE_ALLOCATOR_COMMAND_BIND like mbind:
+  // Binds the memory range starting at |inout_ptr| to a NUMA node like mbind:
   // https://man7.org/linux/man-pages/man2/mbind.2.html
-  // This would take a pointer/length and a NUMA node ID to bind the memory to.
-  // We may want flags for controlling whether this is a new allocation getting
-  // bound or an existing one that is migrating to use MPOL_MF_MOVE.
+  // Placement is advisory: allocators that cannot bind memory should return
+  // IREE_STATUS_UNIMPLEMENTED (or IREE_STATUS_UNAVAILABLE if the platform
+  // lacks support) and callers are expected to ignore such failures. Only
+  // whole pages within the range are bound as partial pages may be shared with
+  // other allocations.
+  //
+  // iree_allocator_ctl_fn_t:
+  //   params: iree_allocator_bind_params_t
+  //   inout_ptr: pointer to the start of the range to bind (unmodified)
+  IREE_ALLOCATOR_COMMAND_BIND = 4,
 } iree_allocator_command_t;
 
 // Parameters for various allocation commands.
@@ -186,6 +193,37 @@ typedef struct iree_allocator_alloc_params_t {
   iree_host_size_t byte_length;
 } iree_allocator_alloc_params_t;
 
+// A NUMA node ordinal as used by the platform (matching the IDs used in
+// /sys/devices/system/node/ on Linux).
+typedef uint32_t iree_allocator_node_id_t;
+
+// Indicates no particular NUMA node; memory is placed wherever first touched.
+#define IREE_ALLOCATOR_NODE_ID_ANY ((iree_allocator_node_id_t) - 1)
+
+// Controls how memory is bound with IREE_ALLOCATOR_COMMAND_BIND.
+typedef uint32_t iree_allocator_bind_flags_t;
+enum iree_allocator_bind_flag_bits_t {
+  IREE_ALLOCATOR_BIND_FLAG_NONE = 0u,
+  // Fail allocations of new pages when the node is out of memory instead of
+  // falling back to other nodes (MPOL_BIND instead of MPOL_PREFERRED).
+  IREE_ALLOCATOR_BIND_FLAG_STRICT = 1u << 0,
+  // Migrate pages that have already been touched to the node (MPOL_MF_MOVE).
+  // Without this only pages first touched after the bind are placed. Memory
+  // recycled by the allocator (or zeroed during allocation) will usually
+  // need this to end up on the requested node.
+  IREE_ALLOCATOR_BIND_FLAG_MOVE = 1u << 1,
+};
+
+// Parameters for IREE_ALLOCATOR_COMMAND_BIND.
+typedef struct iree_allocator_bind_params_t {
+  // Length, in bytes, of the range to bind.
+  iree_host_size_t byte_length;
+  // NUMA node the range is bound to.
+  iree_allocator_node_id_t node_id;
+  // Flags controlling the bind behavior.
+  iree_allocator_bind_flags_t flags;
+} iree_allocator_bind_params_t;
+
 // Function pointer for an iree_allocator_t control function.
 // |command| provides the operation to perform. Optionally some commands may use
 // |params| to pass additional operation-specific parameters. |inout_ptr| usage
@@ -234,6 +272,22 @@ iree_allocator_clone(iree_allocator_t allocator,
 // Frees a previously-allocated block of memory to the given allocator.
 IREE_API_EXPORT void iree_allocator_free(iree_allocator_t allocator, void* ptr);
 
+// Binds |byte_length| bytes starting at |ptr| (previously allocated from the
+// given allocator) to the NUMA |node_id|. No-op if |node_id| is
+// IREE_ALLOCATOR_NODE_ID_ANY. See IREE_ALLOCATOR_COMMAND_BIND for details;
+// returns IREE_STATUS_UNIMPLEMENTED/IREE_STATUS_UNAVAILABLE if the allocator
+// or platform does not support binding, which callers may ignore.
+IREE_API_EXPORT iree_status_t iree_allocator_bind(
+    iree_allocator_t allocator, void* ptr, iree_host_size_t byte_length,
+    iree_allocator_node_id_t node_id, iree_allocator_bind_flags_t flags);
+
+// Binds the whole pages within the host memory range described by |params|
+// and |ptr| using the platform memory policy APIs (mbind on Linux).
+// Intended for use by allocator implementations servicing
+// IREE_ALLOCATOR_COMMAND_BIND for memory from the process heap.
+IREE_API_EXPORT iree_status_t iree_allocator_bind_host_pages(
+    const iree_allocator_bind_params_t* params, void* ptr);
+
 //===----------------------------------------------------------------------===//
 // Built-in iree_allocator_t implementations
 //===----------------------------------------------------------------------===//
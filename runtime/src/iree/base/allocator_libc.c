@@ -91,6 +91,9 @@ iree_allocator_libc_ctl(void* self, iree_allocator_command_t command,
           command, (const iree_allocator_alloc_params_t*)params, inout_ptr);
     case IREE_ALLOCATOR_COMMAND_FREE:
       return iree_allocator_libc_free(inout_ptr);
+    case IREE_ALLOCATOR_COMMAND_BIND:
+      return iree_allocator_bind_host_pages(
+          (const iree_allocator_bind_params_t*)params, *inout_ptr);
     default:
       return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
                               "unsupported libc allocator command");
@@ -147,6 +147,9 @@ iree_allocator_mimalloc_ctl(void* self, iree_allocator_command_t command,
       }
     case IREE_ALLOCATOR_COMMAND_FREE:
       return iree_allocator_mimalloc_free(inout_ptr);
+    case IREE_ALLOCATOR_COMMAND_BIND:
+      return iree_allocator_bind_host_pages(
+          (const iree_allocator_bind_params_t*)params, *inout_ptr);
     default:
       return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
                               "unsupported mimalloc allocator command");
@@ -67,7 +67,9 @@ typedef struct iree_arena_block_pool_t {
 // Initializes a new block pool in |out_block_pool|.
 // |block_allocator| will be used to allocate and free blocks for the pool.
 // Each block allocated will be |total_block_size| but have a slightly smaller
-// usable size due to the tracking overhead. Prefer powers of two.
+// usable size due to the tracking overhead. Prefer powers of two. Pools with
+// multi-MB blocks may use an iree_memory_large_page_allocator_t as the
+// |block_allocator| to back blocks with large pages.
 void iree_arena_block_pool_initialize(iree_host_size_t total_block_size,
                                       iree_allocator_t block_allocator,
                                       iree_arena_block_pool_t* out_block_pool);
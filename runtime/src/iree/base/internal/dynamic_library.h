@@ -18,6 +18,10 @@ extern "C" {
 // Defines the behavior of the dynamic library loader.
 enum iree_dynamic_library_flag_bits_t {
   IREE_DYNAMIC_LIBRARY_FLAG_NONE = 0u,
+  // Libraries loaded from memory with identical contents share a single loaded
+  // instance within the process. Only use for libraries without mutable global
+  // state as all users will observe the same state. Ignored where unsupported.
+  IREE_DYNAMIC_LIBRARY_FLAG_DEDUPLICATE = 1u << 0,
 };
 typedef uint32_t iree_dynamic_library_flags_t;
 
@@ -47,6 +51,11 @@ iree_status_t iree_dynamic_library_load_from_files(
 // Opens a dynamic library from a range of bytes in memory.
 // |identifier| will be used as the module name in debugging/profiling tools.
 // |buffer| must remain live for the lifetime of the library.
+//
+// Where available (Linux/Android) the library is loaded from an anonymous
+// memfd without touching the filesystem. Otherwise, or if the memfd cannot be
+// loaded, the library is written to a temp file that is removed once loaded.
+// Setting IREE_PRESERVE_DYLIB_TEMP_FILES always uses (and keeps) temp files.
 iree_status_t iree_dynamic_library_load_from_memory(
     iree_string_view_t identifier, iree_const_byte_span_t buffer,
     iree_dynamic_library_flags_t flags, iree_allocator_t allocator,
@@ -16,6 +16,7 @@
 #include "iree/base/internal/call_once.h"
 #include "iree/base/internal/dynamic_library.h"
 #include "iree/base/internal/path.h"
+#include "iree/base/internal/synchronization.h"
 
 #if defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_APPLE) || \
     defined(IREE_PLATFORM_LINUX) || defined(IREE_PLATFORM_EMSCRIPTEN)
@@ -26,12 +27,34 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#if defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_LINUX)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_memfd_create)
+#define IREE_DYNAMIC_LIBRARY_HAVE_MEMFD 1
+#endif  // __NR_memfd_create
+#endif  // IREE_PLATFORM_ANDROID || IREE_PLATFORM_LINUX
+
 struct iree_dynamic_library_t {
   iree_atomic_ref_count_t ref_count;
   iree_allocator_t allocator;
 
   // dlopen shared object handle.
   void* handle;
+
+  // Anonymous memory file the library was loaded from or -1 if loaded from the
+  // filesystem. Kept open for the lifetime of the library as the loader (and
+  // any tool walking the link map) refers to it by its /proc/self/fd/ path.
+  int memory_fd;
+
+  // True if the library is registered in the deduplication cache.
+  // Immutable once the library has been published.
+  bool cached;
+  // Content hash and length of the library when |cached|.
+  uint64_t content_hash;
+  iree_host_size_t content_length;
+  // Next library in the deduplication cache list.
+  struct iree_dynamic_library_t* cache_next;
 };
 
 // Allocate a new string from |allocator| returned in |out_file_path| containing
@@ -130,6 +153,7 @@ static iree_status_t iree_dynamic_library_create(
   iree_atomic_ref_count_init(&library->ref_count);
   library->allocator = allocator;
   library->handle = handle;
+  library->memory_fd = -1;
 
   *out_library = library;
   return iree_ok_status();
@@ -225,21 +249,10 @@ static void iree_dynamic_library_init_temp_dir(void) {
       stat(path, &s) == 0 && (s.st_mode & S_IFMT) == S_IFDIR;
 }
 
-// TODO(#3845): use dlopen on an fd with either dlopen(/proc/self/fd/NN),
-// fdlopen, or android_dlopen_ext to avoid needing to write the file to disk.
-// Can fallback to memfd_create + dlopen where available, and fallback from
-// that to disk (maybe just windows/mac).
-iree_status_t iree_dynamic_library_load_from_memory(
-    iree_string_view_t identifier, iree_const_byte_span_t buffer,
-    iree_dynamic_library_flags_t flags, iree_allocator_t allocator,
-    iree_dynamic_library_t** out_library) {
-  IREE_TRACE_ZONE_BEGIN(z0);
-  IREE_ASSERT_ARGUMENT(out_library);
-  *out_library = NULL;
-
-  iree_call_once(&iree_dynamic_library_temp_dir_init_once_flag_,
-                 iree_dynamic_library_init_temp_dir);
-
+// Loads the library from |buffer| via a temp file written to the filesystem.
+static iree_status_t iree_dynamic_library_load_from_temp_file(
+    iree_const_byte_span_t buffer, iree_dynamic_library_flags_t flags,
+    iree_allocator_t allocator, iree_dynamic_library_t** out_library) {
   if (!iree_dynamic_library_temp_dir_valid_) {
     return iree_make_status(
         IREE_STATUS_INVALID_ARGUMENT,
@@ -249,10 +262,9 @@ iree_status_t iree_dynamic_library_load_from_memory(
 
   // Extract the library to a temp file.
   char* temp_path = NULL;
-  IREE_RETURN_AND_END_ZONE_IF_ERROR(
-      z0, iree_dynamic_library_write_temp_file(
-              buffer, "mem_", "so", allocator,
-              iree_dynamic_library_temp_dir_path_, &temp_path));
+  IREE_RETURN_IF_ERROR(iree_dynamic_library_write_temp_file(
+      buffer, "mem_", "so", allocator, iree_dynamic_library_temp_dir_path_,
+      &temp_path));
 
   // Load using the normal load from file routine.
   iree_status_t status = iree_dynamic_library_load_from_file(
@@ -266,6 +278,250 @@ iree_status_t iree_dynamic_library_load_from_memory(
     remove(temp_path);
   }
   iree_allocator_free(allocator, temp_path);
+  return status;
+}
+
+#if defined(IREE_DYNAMIC_LIBRARY_HAVE_MEMFD)
+
+// From linux/memfd.h; defined here to avoid requiring recent kernel headers.
+#define IREE_MFD_CLOEXEC 0x0001u
+#define IREE_MFD_EXEC 0x0010u
+
+// Creates an anonymous memory file containing |buffer| and returns its fd.
+static iree_status_t iree_dynamic_library_write_memfd(
+    iree_string_view_t identifier, iree_const_byte_span_t buffer,
+    int* out_fd) {
+  *out_fd = -1;
+
+  // The name is only used for debugging (it shows up in /proc/self/maps).
+  char name[64];
+  snprintf(name, sizeof(name), "iree_dylib_%.*s",
+           (int)iree_min(identifier.size, 32), identifier.data);
+
+  // Kernels with vm.memfd_noexec=1 require MFD_EXEC for the memfd to be
+  // mappable as executable while older kernels reject the unknown flag.
+  int fd =
+      (int)syscall(__NR_memfd_create, name, IREE_MFD_CLOEXEC | IREE_MFD_EXEC);
+  if (fd < 0 && errno == EINVAL) {
+    fd = (int)syscall(__NR_memfd_create, name, IREE_MFD_CLOEXEC);
+  }
+  if (fd < 0) {
+    return iree_make_status(iree_status_code_from_errno(errno),
+                            "memfd_create failed");
+  }
+
+  // Write all bytes; writes to memfds only fail when out of memory.
+  const uint8_t* data = buffer.data;
+  iree_host_size_t remaining = buffer.data_length;
+  while (remaining > 0) {
+    ssize_t written = write(fd, data, remaining);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      iree_status_t status = iree_make_status(
+          iree_status_code_from_errno(errno),
+          "unable to write %" PRIhsz " bytes to memfd", buffer.data_length);
+      close(fd);
+      return status;
+    }
+    data += written;
+    remaining -= (iree_host_size_t)written;
+  }
+
+  *out_fd = fd;
+  return iree_ok_status();
+}
+
+// Loads the library from |buffer| via an anonymous memory file.
+// Fails if memfds are unavailable (old kernels/seccomp) or /proc is not
+// mounted; callers can fall back to iree_dynamic_library_load_from_temp_file.
+static iree_status_t iree_dynamic_library_load_from_memfd(
+    iree_string_view_t identifier, iree_const_byte_span_t buffer,
+    iree_dynamic_library_flags_t flags, iree_allocator_t allocator,
+    iree_dynamic_library_t** out_library) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  int fd = -1;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_dynamic_library_write_memfd(identifier, buffer, &fd));
+
+  char fd_path[32];
+  snprintf(fd_path, sizeof(fd_path), "/proc/self/fd/%d", fd);
+  iree_status_t status = iree_dynamic_library_load_from_file(
+      fd_path, flags, allocator, out_library);
+  if (iree_status_is_ok(status)) {
+    (*out_library)->memory_fd = fd;
+  } else {
+    close(fd);
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+//===----------------------------------------------------------------------===//
+// Content deduplication cache
+//===----------------------------------------------------------------------===//
+
+// Process-wide list of memfd-backed libraries loaded with
+// IREE_DYNAMIC_LIBRARY_FLAG_DEDUPLICATE. Lookups and the final release of
+// cached libraries both happen under the mutex so a library cannot be revived
+// by a lookup once its last reference has been dropped. The list is expected
+// to be short (one entry per unique executable) so it's walked linearly.
+static iree_once_flag iree_dynamic_library_cache_init_once_flag_ =
+    IREE_ONCE_FLAG_INIT;
+static iree_slim_mutex_t iree_dynamic_library_cache_mutex_;
+static iree_dynamic_library_t* iree_dynamic_library_cache_head_ = NULL;
+
+static void iree_dynamic_library_cache_initialize(void) {
+  iree_slim_mutex_initialize(&iree_dynamic_library_cache_mutex_);
+}
+
+// 64-bit FNV-1a over the library contents. Collisions are resolved by
+// comparing contents so this only needs to be cheap and well-distributed.
+static uint64_t iree_dynamic_library_hash_contents(
+    iree_const_byte_span_t buffer) {
+  uint64_t hash = 0xCBF29CE484222325ull;
+  for (iree_host_size_t i = 0; i < buffer.data_length; ++i) {
+    hash ^= buffer.data[i];
+    hash *= 0x100000001B3ull;
+  }
+  return hash;
+}
+
+// Returns true if the memfd contents of |library| match |buffer|.
+static bool iree_dynamic_library_contents_equal(
+    iree_dynamic_library_t* library, iree_const_byte_span_t buffer) {
+  void* contents = mmap(NULL, library->content_length, PROT_READ, MAP_SHARED,
+                        library->memory_fd, 0);
+  if (contents == MAP_FAILED) return false;
+  const bool equal =
+      memcmp(contents, buffer.data, library->content_length) == 0;
+  munmap(contents, library->content_length);
+  return equal;
+}
+
+// Returns a retained library with contents matching |buffer| or NULL.
+static iree_dynamic_library_t* iree_dynamic_library_cache_lookup(
+    uint64_t content_hash, iree_const_byte_span_t buffer) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_dynamic_library_t* found = NULL;
+  iree_slim_mutex_lock(&iree_dynamic_library_cache_mutex_);
+  for (iree_dynamic_library_t* library = iree_dynamic_library_cache_head_;
+       library != NULL; library = library->cache_next) {
+    if (library->content_hash == content_hash &&
+        library->content_length == buffer.data_length &&
+        iree_dynamic_library_contents_equal(library, buffer)) {
+      iree_atomic_ref_count_inc(&library->ref_count);
+      found = library;
+      break;
+    }
+  }
+  iree_slim_mutex_unlock(&iree_dynamic_library_cache_mutex_);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, found ? 1 : 0);
+  IREE_TRACE_ZONE_END(z0);
+  return found;
+}
+
+// Registers a newly loaded |library| with the cache.
+static void iree_dynamic_library_cache_insert(iree_dynamic_library_t* library,
+                                              uint64_t content_hash,
+                                              iree_host_size_t content_length) {
+  library->cached = true;
+  library->content_hash = content_hash;
+  library->content_length = content_length;
+  iree_slim_mutex_lock(&iree_dynamic_library_cache_mutex_);
+  library->cache_next = iree_dynamic_library_cache_head_;
+  iree_dynamic_library_cache_head_ = library;
+  iree_slim_mutex_unlock(&iree_dynamic_library_cache_mutex_);
+}
+
+// Drops a reference to a cached |library| and returns true if it was the last
+// reference. The library is removed from the cache before returning true.
+static bool iree_dynamic_library_cache_release(
+    iree_dynamic_library_t* library) {
+  iree_slim_mutex_lock(&iree_dynamic_library_cache_mutex_);
+  const bool is_last = iree_atomic_ref_count_dec(&library->ref_count) == 1;
+  if (is_last) {
+    iree_dynamic_library_t** link = &iree_dynamic_library_cache_head_;
+    while (*link != library) link = &(*link)->cache_next;
+    *link = library->cache_next;
+  }
+  iree_slim_mutex_unlock(&iree_dynamic_library_cache_mutex_);
+  return is_last;
+}
+
+#else
+
+static iree_status_t iree_dynamic_library_load_from_memfd(
+    iree_string_view_t identifier, iree_const_byte_span_t buffer,
+    iree_dynamic_library_flags_t flags, iree_allocator_t allocator,
+    iree_dynamic_library_t** out_library) {
+  return iree_make_status(IREE_STATUS_UNAVAILABLE,
+                          "memfd not available on this platform");
+}
+
+static bool iree_dynamic_library_cache_release(
+    iree_dynamic_library_t* library) {
+  return iree_atomic_ref_count_dec(&library->ref_count) == 1;
+}
+
+#endif  // IREE_DYNAMIC_LIBRARY_HAVE_MEMFD
+
+iree_status_t iree_dynamic_library_load_from_memory(
+    iree_string_view_t identifier, iree_const_byte_span_t buffer,
+    iree_dynamic_library_flags_t flags, iree_allocator_t allocator,
+    iree_dynamic_library_t** out_library) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_ASSERT_ARGUMENT(out_library);
+  *out_library = NULL;
+
+  iree_call_once(&iree_dynamic_library_temp_dir_init_once_flag_,
+                 iree_dynamic_library_init_temp_dir);
+
+  // Users asking to preserve temp files want to inspect them so we skip the
+  // memfd path (and with it deduplication) entirely.
+  if (iree_dynamic_library_temp_dir_preserve_) {
+    iree_status_t status = iree_dynamic_library_load_from_temp_file(
+        buffer, flags, allocator, out_library);
+    IREE_TRACE_ZONE_END(z0);
+    return status;
+  }
+
+#if defined(IREE_DYNAMIC_LIBRARY_HAVE_MEMFD)
+  // Reuse an already-loaded library with the same contents, if allowed.
+  const bool deduplicate =
+      iree_all_bits_set(flags, IREE_DYNAMIC_LIBRARY_FLAG_DEDUPLICATE);
+  uint64_t content_hash = 0;
+  if (deduplicate) {
+    iree_call_once(&iree_dynamic_library_cache_init_once_flag_,
+                   iree_dynamic_library_cache_initialize);
+    content_hash = iree_dynamic_library_hash_contents(buffer);
+    *out_library = iree_dynamic_library_cache_lookup(content_hash, buffer);
+    if (*out_library) {
+      IREE_TRACE_ZONE_END(z0);
+      return iree_ok_status();
+    }
+  }
+#endif  // IREE_DYNAMIC_LIBRARY_HAVE_MEMFD
+
+  // Prefer loading from memory and fall back to temp files if that fails.
+  iree_status_t status = iree_dynamic_library_load_from_memfd(
+      identifier, buffer, flags, allocator, out_library);
+  if (!iree_status_is_ok(status) && iree_dynamic_library_temp_dir_valid_) {
+    iree_status_ignore(status);
+    status = iree_dynamic_library_load_from_temp_file(buffer, flags, allocator,
+                                                      out_library);
+  }
+
+#if defined(IREE_DYNAMIC_LIBRARY_HAVE_MEMFD)
+  // Only memfd-backed libraries can be deduplicated as we need the contents
+  // to resolve hash collisions. Concurrent loads of the same contents may
+  // both be inserted; lookups will return whichever is found first.
+  if (iree_status_is_ok(status) && deduplicate &&
+      (*out_library)->memory_fd >= 0) {
+    iree_dynamic_library_cache_insert(*out_library, content_hash,
+                                      buffer.data_length);
+  }
+#endif  // IREE_DYNAMIC_LIBRARY_HAVE_MEMFD
 
   IREE_TRACE_ZONE_END(z0);
   return status;
@@ -287,6 +543,9 @@ static void iree_dynamic_library_delete(iree_dynamic_library_t* library) {
   if (library->handle != NULL) {
     dlclose(library->handle);
   }
+  if (library->memory_fd >= 0) {
+    close(library->memory_fd);
+  }
 #endif  // IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION
 
   iree_allocator_free(allocator, library);
@@ -301,7 +560,12 @@ void iree_dynamic_library_retain(iree_dynamic_library_t* library) {
 }
 
 void iree_dynamic_library_release(iree_dynamic_library_t* library) {
-  if (library && iree_atomic_ref_count_dec(&library->ref_count) == 1) {
+  if (!library) return;
+  const bool is_last =
+      library->cached
+          ? iree_dynamic_library_cache_release(library)
+          : iree_atomic_ref_count_dec(&library->ref_count) == 1;
+  if (is_last) {
     iree_dynamic_library_delete(library);
   }
 }
@@ -6,6 +6,8 @@
 
 #include "iree/base/internal/memory.h"
 
+#include <string.h>
+
 //===----------------------------------------------------------------------===//
 // Memory subsystem information and control
 //===----------------------------------------------------------------------===//
@@ -26,21 +28,65 @@ iree_memory_info_t iree_memory_query_info(void) {
 
 #elif defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_LINUX)
 
+#include <stdio.h>
 #include <unistd.h>
 
+#include "iree/base/internal/call_once.h"
+
+// Size of the transparent huge pages the kernel uses or 0 if transparent huge
+// pages are unavailable or disabled. Queried once as iree_memory_query_info is
+// called on hot-ish paths (such as each executable load) and reading sysfs is
+// not cheap.
+static iree_host_size_t iree_memory_transparent_page_size = 0;
+
+static void iree_memory_query_transparent_page_size_once(void) {
+  FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+  if (!file) return;
+  char mode[64] = {0};
+  const bool enabled = fgets(mode, sizeof(mode), file) != NULL &&
+                       strstr(mode, "[never]") == NULL;
+  fclose(file);
+  if (!enabled) return;
+  unsigned long long page_size = 0;
+  file = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+  if (!file) return;
+  if (fscanf(file, "%llu", &page_size) != 1) page_size = 0;
+  fclose(file);
+  iree_memory_transparent_page_size = (iree_host_size_t)page_size;
+}
+
+// Returns the size of the transparent huge pages the kernel uses or 0 if
+// transparent huge pages are unavailable or disabled.
+static iree_host_size_t iree_memory_query_transparent_page_size(void) {
+  static iree_once_flag query_flag = IREE_ONCE_FLAG_INIT;
+  iree_call_once(&query_flag, iree_memory_query_transparent_page_size_once);
+  return iree_memory_transparent_page_size;
+}
+
+// Returns the size of the pages in the default explicit (hugetlbfs) huge page
+// pool or 0 if no pool is configured.
+static iree_host_size_t iree_memory_query_explicit_page_size(void) {
+  FILE* file = fopen("/proc/meminfo", "r");
+  if (!file) return 0;
+  unsigned long long total_pages = 0;
+  unsigned long long page_size_kb = 0;
+  char line[128];
+  while (fgets(line, sizeof(line), file)) {
+    sscanf(line, "HugePages_Total: %llu", &total_pages);
+    sscanf(line, "Hugepagesize: %llu kB", &page_size_kb);
+  }
+  fclose(file);
+  return total_pages ? (iree_host_size_t)(page_size_kb * 1024) : 0;
+}
+
 iree_memory_info_t iree_memory_query_info(void) {
   const int page_size = sysconf(_SC_PAGESIZE);
+  iree_host_size_t large_page_size = iree_memory_query_transparent_page_size();
+  if (!large_page_size) large_page_size = page_size;
   return (iree_memory_info_t){
       .normal_page_size = page_size,
       .normal_page_granularity = page_size,
-      // Large pages arent't currently used so we aren't introducing the build
-      // goo to detect and use them yet.
-      // https://linux.die.net/man/3/gethugepagesizes
-      // http://manpages.ubuntu.com/manpages/bionic/man3/gethugepagesize.3.html
-      // Would be:
-      //   #include <hugetlbfs.h>
-      //   out_info->large_page_granularity = gethugepagesize();
-      .large_page_granularity = page_size,
+      .large_page_granularity = large_page_size,
       .supported_features = IREE_MEMORY_FEATURE_ALLOCATABLE_EXECUTABLE_PAGES,
   };
 }
@@ -159,3 +205,580 @@ void iree_memory_flush_icache(void* base_address, iree_host_size_t length) {
 }
 
 #endif  // IREE_PLATFORM_*
+
+//===----------------------------------------------------------------------===//
+// Bulk memory operations
+//===----------------------------------------------------------------------===//
+
+#if defined(IREE_ARCH_X86_64)
+#include <emmintrin.h>
+#endif  // IREE_ARCH_X86_64
+
+// Size of the block of repeated pattern bytes written per fill iteration.
+// A multiple of every supported pattern length so that each block starts at
+// the same pattern phase.
+#define IREE_MEMORY_FILL_BLOCK_SIZE 64
+
+// Returns the length of the shortest power-of-two prefix of |pattern| that
+// repeats to form the whole pattern.
+static iree_host_size_t iree_memory_reduce_pattern(
+    const uint8_t* pattern, iree_host_size_t pattern_length) {
+  while (pattern_length > 1 &&
+         memcmp(pattern, pattern + pattern_length / 2, pattern_length / 2) ==
+             0) {
+    pattern_length /= 2;
+  }
+  return pattern_length;
+}
+
+void iree_memory_fill(void* target, iree_host_size_t length,
+                      const void* pattern, iree_host_size_t pattern_length) {
+  IREE_ASSERT(pattern_length > 0 &&
+              pattern_length <= IREE_MEMORY_FILL_MAX_PATTERN_LENGTH &&
+              iree_is_power_of_two_uint64(pattern_length));
+  IREE_ASSERT(length % pattern_length == 0);
+  pattern_length =
+      iree_memory_reduce_pattern((const uint8_t*)pattern, pattern_length);
+  if (pattern_length == 1) {
+    memset(target, *(const uint8_t*)pattern, length);
+    return;
+  }
+
+  // Splat the pattern into a block and write the block out with fixed-size
+  // copies; compilers lower those to unaligned vector stores.
+  iree_alignas(iree_max_align_t) uint8_t block[IREE_MEMORY_FILL_BLOCK_SIZE];
+  for (iree_host_size_t i = 0; i < sizeof(block); i += pattern_length) {
+    memcpy(&block[i], pattern, pattern_length);
+  }
+  uint8_t* p = (uint8_t*)target;
+  uint8_t* p_end = p + length;
+  while (p_end - p >= IREE_MEMORY_FILL_BLOCK_SIZE) {
+    memcpy(p, block, IREE_MEMORY_FILL_BLOCK_SIZE);
+    p += IREE_MEMORY_FILL_BLOCK_SIZE;
+  }
+  // The tail is a multiple of the pattern length and begins at the start of
+  // the pattern as the block size is a multiple of the pattern length.
+  memcpy(p, block, (iree_host_size_t)(p_end - p));
+}
+
+#if defined(IREE_ARCH_X86_64)
+
+static void iree_memory_copy_non_temporal(void* target, const void* source,
+                                          iree_host_size_t length) {
+  uint8_t* p = (uint8_t*)target;
+  const uint8_t* s = (const uint8_t*)source;
+
+  // Streaming stores must be aligned so copy the unaligned head normally.
+  iree_host_size_t head_length =
+      iree_host_align((uintptr_t)p, sizeof(__m128i)) - (uintptr_t)p;
+  memcpy(p, s, head_length);
+  p += head_length;
+  s += head_length;
+  length -= head_length;
+
+  for (; length >= 4 * sizeof(__m128i); length -= 4 * sizeof(__m128i)) {
+    __m128i v0 = _mm_loadu_si128((const __m128i*)s + 0);
+    __m128i v1 = _mm_loadu_si128((const __m128i*)s + 1);
+    __m128i v2 = _mm_loadu_si128((const __m128i*)s + 2);
+    __m128i v3 = _mm_loadu_si128((const __m128i*)s + 3);
+    _mm_stream_si128((__m128i*)p + 0, v0);
+    _mm_stream_si128((__m128i*)p + 1, v1);
+    _mm_stream_si128((__m128i*)p + 2, v2);
+    _mm_stream_si128((__m128i*)p + 3, v3);
+    p += 4 * sizeof(__m128i);
+    s += 4 * sizeof(__m128i);
+  }
+  memcpy(p, s, length);
+
+  // Streaming stores are weakly ordered; fence so that they are visible before
+  // whatever signals completion of the copy to other threads.
+  _mm_sfence();
+}
+
+#else
+
+static void iree_memory_copy_non_temporal(void* target, const void* source,
+                                          iree_host_size_t length) {
+  memcpy(target, source, length);
+}
+
+#endif  // IREE_ARCH_X86_64
+
+void iree_memory_copy(void* target, const void* source, iree_host_size_t length,
+                      iree_memory_copy_flags_t flags) {
+  if (iree_any_bit_set(flags, IREE_MEMORY_COPY_FLAG_TARGET_NOT_READ_SOON) &&
+      length >= IREE_MEMORY_COPY_NON_TEMPORAL_THRESHOLD) {
+    iree_memory_copy_non_temporal(target, source, length);
+  } else {
+    memcpy(target, source, length);
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// iree_memory_large_page_allocator_t
+//===----------------------------------------------------------------------===//
+
+#if defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_LINUX)
+#include <errno.h>
+#include <sys/mman.h>
+#define IREE_MEMORY_HAVE_LARGE_PAGES 1
+#endif  // IREE_PLATFORM_ANDROID || IREE_PLATFORM_LINUX
+
+iree_status_t iree_memory_large_page_mode_parse(
+    iree_string_view_t value, iree_memory_large_page_mode_t* out_mode) {
+  if (iree_string_view_equal(value, IREE_SV("none"))) {
+    *out_mode = IREE_MEMORY_LARGE_PAGE_MODE_NONE;
+  } else if (iree_string_view_equal(value, IREE_SV("transparent"))) {
+    *out_mode = IREE_MEMORY_LARGE_PAGE_MODE_TRANSPARENT;
+  } else if (iree_string_view_equal(value, IREE_SV("explicit"))) {
+    *out_mode = IREE_MEMORY_LARGE_PAGE_MODE_EXPLICIT;
+  } else {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "unrecognized large page mode '%.*s'; expected "
+                            "'none', 'transparent', or 'explicit'",
+                            (int)value.size, value.data);
+  }
+  return iree_ok_status();
+}
+
+// Storage backing an individual allocation.
+typedef enum iree_memory_large_page_backing_e {
+  // Mapped from the explicit huge page pool.
+  IREE_MEMORY_LARGE_PAGE_BACKING_EXPLICIT = 0,
+  // Mapped and advised for transparent huge pages.
+  IREE_MEMORY_LARGE_PAGE_BACKING_TRANSPARENT,
+  // Mapped with normal pages after large pages were unavailable.
+  IREE_MEMORY_LARGE_PAGE_BACKING_FALLBACK,
+} iree_memory_large_page_backing_t;
+
+// Record of a mapped allocation stored in the allocator mapping table.
+// Records are kept out of line as storing them in the mapping would spill
+// allocations of a whole number of large pages into another large page.
+typedef struct iree_memory_large_page_mapping_t {
+  // Base address of the mapping as returned to the user or NULL if the table
+  // slot is unused.
+  void* ptr;
+  // Total length of the mapping including page padding, in bytes.
+  iree_host_size_t mapping_length;
+  // Storage backing the mapping.
+  iree_memory_large_page_backing_t backing;
+} iree_memory_large_page_mapping_t;
+
+// Header prefixed to allocations made from the base allocator.
+typedef struct iree_memory_large_page_header_t {
+  // Size of the allocation requested by the user, in bytes.
+  iree_host_size_t byte_length;
+} iree_memory_large_page_header_t;
+
+// Size of the header padded to keep user allocations naturally aligned.
+#define IREE_MEMORY_LARGE_PAGE_HEADER_SIZE \
+  iree_host_align(sizeof(iree_memory_large_page_header_t), iree_max_align_t)
+
+static iree_memory_large_page_header_t* iree_memory_large_page_header(
+    void* ptr) {
+  return (iree_memory_large_page_header_t*)((uint8_t*)ptr -
+                                            IREE_MEMORY_LARGE_PAGE_HEADER_SIZE);
+}
+
+static iree_atomic_int64_t* iree_memory_large_page_counter(
+    iree_memory_large_page_allocator_t* allocator,
+    iree_memory_large_page_backing_t backing) {
+  switch (backing) {
+    case IREE_MEMORY_LARGE_PAGE_BACKING_EXPLICIT:
+      return &allocator->explicit_bytes;
+    case IREE_MEMORY_LARGE_PAGE_BACKING_TRANSPARENT:
+      return &allocator->transparent_bytes;
+    default:
+      return &allocator->fallback_bytes;
+  }
+}
+
+#if defined(IREE_MEMORY_HAVE_LARGE_PAGES)
+
+// Maps |length| bytes preferring large pages as configured on |allocator|.
+// The returned mapping is zero-filled.
+static iree_status_t iree_memory_large_page_map(
+    iree_memory_large_page_allocator_t* allocator, iree_host_size_t length,
+    iree_memory_large_page_mapping_t* out_mapping) {
+  memset(out_mapping, 0, sizeof(*out_mapping));
+  uint8_t* ptr = MAP_FAILED;
+  iree_host_size_t mapping_length = 0;
+  iree_memory_large_page_backing_t backing =
+      IREE_MEMORY_LARGE_PAGE_BACKING_FALLBACK;
+
+#if defined(MAP_HUGETLB)
+  // Explicit huge pages are reserved by the administrator; if the pool is
+  // exhausted the mmap fails and we fall back to transparent huge pages.
+  if (allocator->mode == IREE_MEMORY_LARGE_PAGE_MODE_EXPLICIT &&
+      allocator->explicit_page_size) {
+    mapping_length = iree_host_align(length, allocator->explicit_page_size);
+    ptr = mmap(NULL, mapping_length, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    backing = IREE_MEMORY_LARGE_PAGE_BACKING_EXPLICIT;
+  }
+#endif  // MAP_HUGETLB
+
+  if (ptr == MAP_FAILED) {
+    // Transparent huge pages only back large page aligned ranges so we
+    // over-reserve and trim the mapping to start on a large page boundary.
+    mapping_length = iree_host_align(length, allocator->normal_page_size);
+    const iree_host_size_t alignment =
+        iree_max(allocator->large_page_size, allocator->normal_page_size);
+    const iree_host_size_t reserve_length =
+        mapping_length + alignment - allocator->normal_page_size;
+    uint8_t* reserved = mmap(NULL, reserve_length, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED) {
+      return iree_make_status(iree_status_code_from_errno(errno),
+                              "failed to map %" PRIhsz " bytes", length);
+    }
+    ptr = (uint8_t*)iree_host_align((uintptr_t)reserved, alignment);
+    if (ptr > reserved) munmap(reserved, ptr - reserved);
+    uint8_t* reserved_end = reserved + reserve_length;
+    if (reserved_end > ptr + mapping_length) {
+      munmap(ptr + mapping_length, reserved_end - (ptr + mapping_length));
+    }
+
+    // Advice fails if the kernel was built without transparent huge page
+    // support in which case the mapping remains on normal pages.
+    backing = IREE_MEMORY_LARGE_PAGE_BACKING_FALLBACK;
+#if defined(MADV_HUGEPAGE)
+    if (allocator->large_page_size &&
+        mapping_length >= allocator->large_page_size &&
+        madvise(ptr, mapping_length, MADV_HUGEPAGE) == 0) {
+      backing = IREE_MEMORY_LARGE_PAGE_BACKING_TRANSPARENT;
+    }
+#endif  // MADV_HUGEPAGE
+  }
+
+  iree_atomic_fetch_add(iree_memory_large_page_counter(allocator, backing),
+                        (int64_t)mapping_length, iree_memory_order_relaxed);
+  IREE_TRACE_ALLOC_NAMED("iree_memory_large_page", ptr, mapping_length);
+
+  out_mapping->ptr = ptr;
+  out_mapping->mapping_length = mapping_length;
+  out_mapping->backing = backing;
+  return iree_ok_status();
+}
+
+static void iree_memory_large_page_unmap(
+    iree_memory_large_page_allocator_t* allocator,
+    const iree_memory_large_page_mapping_t* mapping) {
+  iree_atomic_fetch_add(
+      iree_memory_large_page_counter(allocator, mapping->backing),
+      -(int64_t)mapping->mapping_length, iree_memory_order_relaxed);
+  IREE_TRACE_FREE_NAMED("iree_memory_large_page", mapping->ptr);
+  munmap(mapping->ptr, mapping->mapping_length);
+}
+
+#else
+
+static iree_status_t iree_memory_large_page_map(
+    iree_memory_large_page_allocator_t* allocator, iree_host_size_t length,
+    iree_memory_large_page_mapping_t* out_mapping) {
+  memset(out_mapping, 0, sizeof(*out_mapping));
+  return iree_make_status(IREE_STATUS_UNAVAILABLE,
+                          "large pages not available on this platform");
+}
+
+static void iree_memory_large_page_unmap(
+    iree_memory_large_page_allocator_t* allocator,
+    const iree_memory_large_page_mapping_t* mapping) {}
+
+#endif  // IREE_MEMORY_HAVE_LARGE_PAGES
+
+// The mapping table is an open-addressed (linear probing) table of live
+// mappings keyed by address. Table functions must be called with the allocator
+// mutex held.
+
+static iree_host_size_t iree_memory_large_page_mapping_hash(void* ptr) {
+  // Mappings are page aligned so the low bits carry no information.
+  uint64_t key = (uint64_t)(uintptr_t)ptr >> 12;
+  key ^= key >> 33;
+  key *= 0xFF51AFD7ED558CCDull;
+  key ^= key >> 33;
+  return (iree_host_size_t)key;
+}
+
+// Returns the table slot of the mapping at |ptr| or NULL if none exists.
+static iree_memory_large_page_mapping_t* iree_memory_large_page_find_slot(
+    iree_memory_large_page_allocator_t* allocator, void* ptr) {
+  if (!allocator->mapping_capacity) return NULL;
+  const iree_host_size_t mask = allocator->mapping_capacity - 1;
+  for (iree_host_size_t i = iree_memory_large_page_mapping_hash(ptr);; ++i) {
+    iree_memory_large_page_mapping_t* slot = &allocator->mappings[i & mask];
+    if (!slot->ptr) return NULL;
+    if (slot->ptr == ptr) return slot;
+  }
+}
+
+// Stores |mapping| in the first unused slot of its probe sequence.
+static void iree_memory_large_page_place_mapping(
+    iree_memory_large_page_mapping_t* mappings, iree_host_size_t capacity,
+    const iree_memory_large_page_mapping_t* mapping) {
+  const iree_host_size_t mask = capacity - 1;
+  iree_host_size_t i = iree_memory_large_page_mapping_hash(mapping->ptr);
+  while (mappings[i & mask].ptr) ++i;
+  mappings[i & mask] = *mapping;
+}
+
+// Inserts |mapping| into the table, growing it to stay at most half full.
+static iree_status_t iree_memory_large_page_insert_mapping(
+    iree_memory_large_page_allocator_t* allocator,
+    const iree_memory_large_page_mapping_t* mapping) {
+  if ((allocator->mapping_count + 1) * 2 > allocator->mapping_capacity) {
+    const iree_host_size_t new_capacity =
+        allocator->mapping_capacity ? allocator->mapping_capacity * 2 : 16;
+    iree_memory_large_page_mapping_t* new_mappings = NULL;
+    IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+        allocator->base_allocator, new_capacity * sizeof(*new_mappings),
+        (void**)&new_mappings));
+    memset(new_mappings, 0, new_capacity * sizeof(*new_mappings));
+    for (iree_host_size_t i = 0; i < allocator->mapping_capacity; ++i) {
+      if (!allocator->mappings[i].ptr) continue;
+      iree_memory_large_page_place_mapping(new_mappings, new_capacity,
+                                           &allocator->mappings[i]);
+    }
+    iree_allocator_free(allocator->base_allocator, allocator->mappings);
+    allocator->mappings = new_mappings;
+    allocator->mapping_capacity = new_capacity;
+  }
+  iree_memory_large_page_place_mapping(
+      allocator->mappings, allocator->mapping_capacity, mapping);
+  ++allocator->mapping_count;
+  return iree_ok_status();
+}
+
+// Removes the mapping in |slot|, moving back any mappings later in the probe
+// sequence that can fill the gap so that lookups need no tombstones.
+static void iree_memory_large_page_remove_slot(
+    iree_memory_large_page_allocator_t* allocator,
+    iree_memory_large_page_mapping_t* slot) {
+  const iree_host_size_t mask = allocator->mapping_capacity - 1;
+  iree_host_size_t i = (iree_host_size_t)(slot - allocator->mappings);
+  for (iree_host_size_t j = i + 1;; ++j) {
+    iree_memory_large_page_mapping_t* next = &allocator->mappings[j & mask];
+    if (!next->ptr) break;
+    // The mapping may move to the gap if its home slot is not after the gap.
+    const iree_host_size_t home =
+        iree_memory_large_page_mapping_hash(next->ptr);
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      allocator->mappings[i & mask] = *next;
+      i = j;
+    }
+  }
+  allocator->mappings[i & mask].ptr = NULL;
+  --allocator->mapping_count;
+}
+
+// Returns true and the record of the mapping at |ptr| if it was mapped by
+// |allocator| and false if it was allocated from the base allocator. When
+// |remove| is set the record is removed from the table.
+static bool iree_memory_large_page_lookup_mapping(
+    iree_memory_large_page_allocator_t* allocator, void* ptr, bool remove,
+    iree_memory_large_page_mapping_t* out_mapping) {
+  // Mappings are page aligned and base allocations are offset by their header
+  // so nearly all base allocations skip the lock.
+  if (!iree_host_size_has_alignment((uintptr_t)ptr,
+                                    allocator->normal_page_size)) {
+    return false;
+  }
+  iree_slim_mutex_lock(&allocator->mutex);
+  iree_memory_large_page_mapping_t* slot =
+      iree_memory_large_page_find_slot(allocator, ptr);
+  if (slot) {
+    *out_mapping = *slot;
+    if (remove) iree_memory_large_page_remove_slot(allocator, slot);
+  }
+  iree_slim_mutex_unlock(&allocator->mutex);
+  return slot != NULL;
+}
+
+void iree_memory_large_page_allocator_initialize(
+    iree_memory_large_page_mode_t mode, iree_host_size_t min_allocation_size,
+    iree_allocator_t base_allocator,
+    iree_memory_large_page_allocator_t* out_allocator) {
+  IREE_ASSERT_ARGUMENT(out_allocator);
+  memset(out_allocator, 0, sizeof(*out_allocator));
+  const iree_memory_info_t info = iree_memory_query_info();
+  out_allocator->normal_page_size = info.normal_page_size;
+#if defined(IREE_MEMORY_HAVE_LARGE_PAGES)
+  out_allocator->mode = mode;
+  out_allocator->large_page_size = iree_memory_query_transparent_page_size();
+  out_allocator->explicit_page_size = iree_memory_query_explicit_page_size();
+#else
+  out_allocator->mode = IREE_MEMORY_LARGE_PAGE_MODE_NONE;
+#endif  // IREE_MEMORY_HAVE_LARGE_PAGES
+  out_allocator->min_allocation_size =
+      min_allocation_size ? min_allocation_size : info.large_page_granularity;
+  out_allocator->base_allocator = base_allocator;
+  iree_slim_mutex_initialize(&out_allocator->mutex);
+  iree_atomic_store(&out_allocator->explicit_bytes, 0,
+                    iree_memory_order_relaxed);
+  iree_atomic_store(&out_allocator->transparent_bytes, 0,
+                    iree_memory_order_relaxed);
+  iree_atomic_store(&out_allocator->fallback_bytes, 0,
+                    iree_memory_order_relaxed);
+}
+
+void iree_memory_large_page_allocator_deinitialize(
+    iree_memory_large_page_allocator_t* allocator) {
+  IREE_ASSERT_ARGUMENT(allocator);
+  IREE_ASSERT_EQ(allocator->mapping_count, 0,
+                 "all allocations must be freed before deinitializing");
+  iree_allocator_free(allocator->base_allocator, allocator->mappings);
+  allocator->mappings = NULL;
+  allocator->mapping_capacity = 0;
+  iree_slim_mutex_deinitialize(&allocator->mutex);
+}
+
+void iree_memory_large_page_allocator_query_statistics(
+    iree_memory_large_page_allocator_t* allocator,
+    iree_memory_large_page_statistics_t* out_statistics) {
+  IREE_ASSERT_ARGUMENT(allocator);
+  IREE_ASSERT_ARGUMENT(out_statistics);
+  out_statistics->explicit_bytes = (iree_host_size_t)iree_atomic_load(
+      &allocator->explicit_bytes, iree_memory_order_relaxed);
+  out_statistics->transparent_bytes = (iree_host_size_t)iree_atomic_load(
+      &allocator->transparent_bytes, iree_memory_order_relaxed);
+  out_statistics->fallback_bytes = (iree_host_size_t)iree_atomic_load(
+      &allocator->fallback_bytes, iree_memory_order_relaxed);
+}
+
+// Frees the allocation at |ptr| to its backing storage.
+static void iree_memory_large_page_release(
+    iree_memory_large_page_allocator_t* allocator, void* ptr) {
+  iree_memory_large_page_mapping_t mapping;
+  if (iree_memory_large_page_lookup_mapping(allocator, ptr, /*remove=*/true,
+                                            &mapping)) {
+    iree_memory_large_page_unmap(allocator, &mapping);
+  } else {
+    void* base_ptr = iree_memory_large_page_header(ptr);
+    iree_status_ignore(allocator->base_allocator.ctl(
+        allocator->base_allocator.self, IREE_ALLOCATOR_COMMAND_FREE, NULL,
+        &base_ptr));
+  }
+}
+
+static iree_status_t iree_memory_large_page_allocator_alloc(
+    iree_memory_large_page_allocator_t* allocator,
+    iree_allocator_command_t command,
+    const iree_allocator_alloc_params_t* params, void** inout_ptr) {
+  IREE_ASSERT_ARGUMENT(params);
+  IREE_ASSERT_ARGUMENT(inout_ptr);
+  const iree_host_size_t byte_length = params->byte_length;
+  if (IREE_UNLIKELY(byte_length == 0)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "allocations must be >0 bytes");
+  }
+  const iree_host_size_t header_size = IREE_MEMORY_LARGE_PAGE_HEADER_SIZE;
+  if (IREE_UNLIKELY(byte_length > IREE_HOST_SIZE_MAX - header_size)) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "allocation of %" PRIhsz " bytes too large",
+                            byte_length);
+  }
+  const iree_allocator_alloc_params_t base_params = {
+      .byte_length = header_size + byte_length,
+  };
+  const bool use_large_pages =
+      allocator->mode != IREE_MEMORY_LARGE_PAGE_MODE_NONE &&
+      byte_length >= allocator->min_allocation_size;
+
+  void* existing_ptr =
+      command == IREE_ALLOCATOR_COMMAND_REALLOC ? *inout_ptr : NULL;
+  iree_memory_large_page_mapping_t existing_mapping;
+  const bool existing_is_mapped =
+      existing_ptr && iree_memory_large_page_lookup_mapping(
+                          allocator, existing_ptr,
+                          /*remove=*/false, &existing_mapping);
+
+  // Reallocations that stay within the same kind of storage may be resized in
+  // place: base allocations via the base allocator and mappings if the page
+  // padding at the end of the mapping has enough room.
+  if (existing_ptr) {
+    if (!existing_is_mapped && !use_large_pages) {
+      void* ptr = iree_memory_large_page_header(existing_ptr);
+      IREE_RETURN_IF_ERROR(allocator->base_allocator.ctl(
+          allocator->base_allocator.self, IREE_ALLOCATOR_COMMAND_REALLOC,
+          &base_params, &ptr));
+      iree_memory_large_page_header_t* header =
+          (iree_memory_large_page_header_t*)ptr;
+      header->byte_length = byte_length;
+      *inout_ptr = (uint8_t*)header + header_size;
+      return iree_ok_status();
+    } else if (existing_is_mapped && use_large_pages &&
+               byte_length <= existing_mapping.mapping_length) {
+      return iree_ok_status();
+    }
+  }
+
+  // Allocate new storage. Mappings are always zero-filled so calloc is free.
+  void* new_ptr = NULL;
+  if (use_large_pages) {
+    iree_memory_large_page_mapping_t mapping;
+    IREE_RETURN_IF_ERROR(
+        iree_memory_large_page_map(allocator, byte_length, &mapping));
+    iree_slim_mutex_lock(&allocator->mutex);
+    iree_status_t status =
+        iree_memory_large_page_insert_mapping(allocator, &mapping);
+    iree_slim_mutex_unlock(&allocator->mutex);
+    if (!iree_status_is_ok(status)) {
+      iree_memory_large_page_unmap(allocator, &mapping);
+      return status;
+    }
+    new_ptr = mapping.ptr;
+  } else {
+    void* ptr = NULL;
+    IREE_RETURN_IF_ERROR(allocator->base_allocator.ctl(
+        allocator->base_allocator.self,
+        command == IREE_ALLOCATOR_COMMAND_CALLOC
+            ? IREE_ALLOCATOR_COMMAND_CALLOC
+            : IREE_ALLOCATOR_COMMAND_MALLOC,
+        &base_params, &ptr));
+    iree_memory_large_page_header_t* header =
+        (iree_memory_large_page_header_t*)ptr;
+    header->byte_length = byte_length;
+    new_ptr = (uint8_t*)header + header_size;
+  }
+
+  // Move the contents of a reallocation that changed storage. Mappings do not
+  // track the requested length but their whole length is readable.
+  if (existing_ptr) {
+    const iree_host_size_t existing_length =
+        existing_is_mapped
+            ? existing_mapping.mapping_length
+            : iree_memory_large_page_header(existing_ptr)->byte_length;
+    memcpy(new_ptr, existing_ptr, iree_min(existing_length, byte_length));
+    iree_memory_large_page_release(allocator, existing_ptr);
+  }
+
+  *inout_ptr = new_ptr;
+  return iree_ok_status();
+}
+
+iree_status_t iree_memory_large_page_allocator_ctl(
+    void* self, iree_allocator_command_t command, const void* params,
+    void** inout_ptr) {
+  iree_memory_large_page_allocator_t* allocator =
+      (iree_memory_large_page_allocator_t*)self;
+  switch (command) {
+    case IREE_ALLOCATOR_COMMAND_MALLOC:
+    case IREE_ALLOCATOR_COMMAND_CALLOC:
+    case IREE_ALLOCATOR_COMMAND_REALLOC:
+      return iree_memory_large_page_allocator_alloc(
+          allocator, command, (const iree_allocator_alloc_params_t*)params,
+          inout_ptr);
+    case IREE_ALLOCATOR_COMMAND_FREE:
+      if (*inout_ptr) {
+        iree_memory_large_page_release(allocator, *inout_ptr);
+        *inout_ptr = NULL;
+      }
+      return iree_ok_status();
+    case IREE_ALLOCATOR_COMMAND_BIND:
+      return iree_allocator_bind_host_pages(
+          (const iree_allocator_bind_params_t*)params, *inout_ptr);
+    default:
+      return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                              "unsupported large page allocator command");
+  }
+}
@@ -8,6 +8,8 @@
 #define IREE_BASE_INTERNAL_MEMORY_H_
 
 #include "iree/base/api.h"
+#include "iree/base/internal/atomics.h"
+#include "iree/base/internal/synchronization.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -68,6 +70,157 @@ void iree_memory_jit_context_end(void);
 // executing code from any pages that have been written during load.
 void iree_memory_flush_icache(void* base_address, iree_host_size_t length);
 
+//===----------------------------------------------------------------------===//
+// Bulk memory operations
+//===----------------------------------------------------------------------===//
+
+// Maximum length of a pattern accepted by iree_memory_fill.
+#define IREE_MEMORY_FILL_MAX_PATTERN_LENGTH 16
+
+// Copies of at least this many bytes that are marked with
+// IREE_MEMORY_COPY_FLAG_TARGET_NOT_READ_SOON use non-temporal stores where
+// supported. Smaller copies gain nothing from bypassing the caches.
+// Users can override this with a compiler define.
+#if !defined(IREE_MEMORY_COPY_NON_TEMPORAL_THRESHOLD)
+#define IREE_MEMORY_COPY_NON_TEMPORAL_THRESHOLD (4 * 1024 * 1024)
+#endif  // !IREE_MEMORY_COPY_NON_TEMPORAL_THRESHOLD
+
+// Fills |length| bytes at |target| by repeating the |pattern_length| bytes of
+// |pattern|. |pattern_length| must be one of 1, 2, 4, 8, or 16 and |length|
+// must be a multiple of it. Patterns are reduced to the shortest repeating
+// unit (such as all-zero patterns to a single byte) before filling.
+//
+// Unlike scalar loops over the pattern width this writes full vector-width
+// blocks and is roughly memset speed regardless of the pattern length.
+void iree_memory_fill(void* target, iree_host_size_t length,
+                      const void* pattern, iree_host_size_t pattern_length);
+
+// Hints describing how the target of an iree_memory_copy will be used.
+enum iree_memory_copy_flag_bits_t {
+  IREE_MEMORY_COPY_FLAG_NONE = 0u,
+  // The target will not be read by the host soon after the copy, such as when
+  // staging data for a device or writing into uncached memory. Large copies
+  // stream around the caches instead of evicting the working set with data
+  // that would be evicted again before it is read.
+  IREE_MEMORY_COPY_FLAG_TARGET_NOT_READ_SOON = 1u << 0,
+};
+typedef uint32_t iree_memory_copy_flags_t;
+
+// Copies |length| bytes from |source| to |target| as with memcpy.
+// The ranges must not overlap. Copies of at least
+// IREE_MEMORY_COPY_NON_TEMPORAL_THRESHOLD bytes with
+// IREE_MEMORY_COPY_FLAG_TARGET_NOT_READ_SOON bypass the caches with
+// non-temporal stores on architectures that support them. All other copies go
+// through the caches so that the target is hot when it is read.
+void iree_memory_copy(void* target, const void* source, iree_host_size_t length,
+                      iree_memory_copy_flags_t flags);
+
+//===----------------------------------------------------------------------===//
+// iree_memory_large_page_allocator_t
+//===----------------------------------------------------------------------===//
+
+// Controls whether and how allocations are backed by large (huge) pages.
+typedef enum iree_memory_large_page_mode_e {
+  // Allocations use normal pages from the base allocator.
+  IREE_MEMORY_LARGE_PAGE_MODE_NONE = 0,
+  // Allocations are mapped aligned to the large page size and advised for
+  // transparent huge pages (MADV_HUGEPAGE). The kernel backs them with large
+  // pages on first touch when available or later via khugepaged.
+  IREE_MEMORY_LARGE_PAGE_MODE_TRANSPARENT = 1,
+  // Allocations are mapped from the reserved huge page pool (MAP_HUGETLB).
+  // Falls back to IREE_MEMORY_LARGE_PAGE_MODE_TRANSPARENT when the pool is not
+  // configured or has been exhausted.
+  IREE_MEMORY_LARGE_PAGE_MODE_EXPLICIT = 2,
+} iree_memory_large_page_mode_t;
+
+// Parses a large page mode from one of `none`, `transparent`, or `explicit`.
+iree_status_t iree_memory_large_page_mode_parse(
+    iree_string_view_t value, iree_memory_large_page_mode_t* out_mode);
+
+// Bytes currently mapped by a large page allocator, by backing.
+// Counts are of whole mappings (including page padding) and not the requested
+// allocation sizes.
+typedef struct iree_memory_large_page_statistics_t {
+  // Bytes mapped from the explicit huge page pool.
+  iree_host_size_t explicit_bytes;
+  // Bytes mapped with transparent huge page advice. The kernel may not have
+  // backed all of them with large pages yet (or ever if memory is fragmented).
+  iree_host_size_t transparent_bytes;
+  // Bytes of allocations that qualified for large pages but are backed by
+  // normal pages as large pages were unavailable.
+  iree_host_size_t fallback_bytes;
+} iree_memory_large_page_statistics_t;
+
+// An allocator that maps large allocations directly with large pages.
+// Allocations below |min_allocation_size| (and all allocations on platforms
+// without large page support) are routed to the base allocator. This keeps
+// small metadata allocations from padding out to a full large page while
+// multi-MB buffers (activations, caches, arena blocks) avoid TLB pressure.
+//
+// Mapped allocations hold only user data (plus padding to whole pages) and are
+// tracked in a table owned by the allocator so that an allocation of a whole
+// number of large pages does not spill into another.
+// They start on a page boundary so users requiring at most page alignment
+// should allocate them with iree_allocator_malloc instead of
+// iree_allocator_malloc_aligned, which would pad them into another page.
+//
+// Thread-safe if the base allocator is thread-safe. The allocator must remain
+// valid until all allocations made from it have been freed.
+typedef struct iree_memory_large_page_allocator_t {
+  // Large page backing used for allocations of at least min_allocation_size.
+  iree_memory_large_page_mode_t mode;
+  // Minimum size of an allocation to map with large pages.
+  iree_host_size_t min_allocation_size;
+  // System normal page size, in bytes.
+  iree_host_size_t normal_page_size;
+  // Transparent huge page size, in bytes, or 0 if they are disabled.
+  iree_host_size_t large_page_size;
+  // Size of pages in the explicit huge page pool or 0 if there is no pool.
+  iree_host_size_t explicit_page_size;
+  // Allocator used for allocations not mapped with large pages and the
+  // mapping table.
+  iree_allocator_t base_allocator;
+  // Guards the mapping table.
+  iree_slim_mutex_t mutex;
+  // Open-addressed table of live mappings keyed by address.
+  iree_host_size_t mapping_count;
+  iree_host_size_t mapping_capacity;  // power of two
+  struct iree_memory_large_page_mapping_t* mappings;
+  // Counters backing iree_memory_large_page_statistics_t.
+  iree_atomic_int64_t explicit_bytes;
+  iree_atomic_int64_t transparent_bytes;
+  iree_atomic_int64_t fallback_bytes;
+} iree_memory_large_page_allocator_t;
+
+// Initializes |out_allocator| to map allocations of at least
+// |min_allocation_size| bytes as specified by |mode|. A |min_allocation_size|
+// of 0 uses the system large page size. If the platform does not support large
+// pages the mode is reset to IREE_MEMORY_LARGE_PAGE_MODE_NONE.
+void iree_memory_large_page_allocator_initialize(
+    iree_memory_large_page_mode_t mode, iree_host_size_t min_allocation_size,
+    iree_allocator_t base_allocator,
+    iree_memory_large_page_allocator_t* out_allocator);
+
+// Deinitializes |allocator|. All allocations made from it must have been freed.
+void iree_memory_large_page_allocator_deinitialize(
+    iree_memory_large_page_allocator_t* allocator);
+
+// Queries the current mapping counters of |allocator|.
+void iree_memory_large_page_allocator_query_statistics(
+    iree_memory_large_page_allocator_t* allocator,
+    iree_memory_large_page_statistics_t* out_statistics);
+
+iree_status_t iree_memory_large_page_allocator_ctl(
+    void* self, iree_allocator_command_t command, const void* params,
+    void** inout_ptr);
+
+// Returns an iree_allocator_t that allocates from |allocator|.
+static inline iree_allocator_t iree_memory_large_page_allocator(
+    iree_memory_large_page_allocator_t* allocator) {
+  iree_allocator_t v = {allocator, iree_memory_large_page_allocator_ctl};
+  return v;
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -0,0 +1,242 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/base/internal/memory.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace {
+
+static constexpr iree_host_size_t kMinAllocationSize = 1024 * 1024;
+
+// Returns the total bytes mapped by |allocator| across all backings.
+static iree_host_size_t QueryMappedBytes(
+    iree_memory_large_page_allocator_t* allocator) {
+  iree_memory_large_page_statistics_t statistics;
+  iree_memory_large_page_allocator_query_statistics(allocator, &statistics);
+  return statistics.explicit_bytes + statistics.transparent_bytes +
+         statistics.fallback_bytes;
+}
+
+TEST(LargePageAllocatorTest, ParseMode) {
+  iree_memory_large_page_mode_t mode = IREE_MEMORY_LARGE_PAGE_MODE_NONE;
+  IREE_EXPECT_OK(
+      iree_memory_large_page_mode_parse(IREE_SV("transparent"), &mode));
+  EXPECT_EQ(mode, IREE_MEMORY_LARGE_PAGE_MODE_TRANSPARENT);
+  IREE_EXPECT_OK(iree_memory_large_page_mode_parse(IREE_SV("explicit"), &mode));
+  EXPECT_EQ(mode, IREE_MEMORY_LARGE_PAGE_MODE_EXPLICIT);
+  IREE_EXPECT_OK(iree_memory_large_page_mode_parse(IREE_SV("none"), &mode));
+  EXPECT_EQ(mode, IREE_MEMORY_LARGE_PAGE_MODE_NONE);
+  iree_status_t status =
+      iree_memory_large_page_mode_parse(IREE_SV("huge"), &mode);
+  IREE_EXPECT_STATUS_IS(IREE_STATUS_INVALID_ARGUMENT, status);
+  iree_status_ignore(status);
+}
+
+TEST(LargePageAllocatorTest, SmallAllocationsUseBaseAllocator) {
+  iree_memory_large_page_allocator_t large_page_allocator;
+  iree_memory_large_page_allocator_initialize(
+      IREE_MEMORY_LARGE_PAGE_MODE_TRANSPARENT, kMinAllocationSize,
+      iree_allocator_system(), &large_page_allocator);
+  iree_allocator_t allocator =
+      iree_memory_large_page_allocator(&large_page_allocator);
+
+  void* ptr = NULL;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator, 64, &ptr));
+  EXPECT_TRUE(iree_host_size_has_alignment((uintptr_t)ptr, iree_max_align_t));
+  memset(ptr, 0xCD, 64);
+  EXPECT_EQ(QueryMappedBytes(&large_page_allocator), 0);
+  iree_allocator_free(allocator, ptr);
+  iree_memory_large_page_allocator_deinitialize(&large_page_allocator);
+}
+
+TEST(LargePageAllocatorTest, LargeAllocations) {
+  iree_memory_large_page_allocator_t large_page_allocator;
+  iree_memory_large_page_allocator_initialize(
+      IREE_MEMORY_LARGE_PAGE_MODE_EXPLICIT, kMinAllocationSize,
+      iree_allocator_system(), &large_page_allocator);
+  iree_allocator_t allocator =
+      iree_memory_large_page_allocator(&large_page_allocator);
+
+  // Mapped allocations must be zeroed for calloc.
+  const iree_host_size_t byte_length = 4 * kMinAllocationSize;
+  uint8_t* ptr = NULL;
+  IREE_ASSERT_OK(
+      iree_allocator_malloc(allocator, byte_length, (void**)&ptr));
+  EXPECT_EQ(ptr[0], 0);
+  EXPECT_EQ(ptr[byte_length - 1], 0);
+  memset(ptr, 0xCD, byte_length);
+
+  if (large_page_allocator.mode != IREE_MEMORY_LARGE_PAGE_MODE_NONE) {
+    // Each mapping is counted under exactly one backing.
+    EXPECT_GE(QueryMappedBytes(&large_page_allocator), byte_length);
+  } else {
+    // Platforms without large pages route everything to the base allocator.
+    EXPECT_EQ(QueryMappedBytes(&large_page_allocator), 0);
+  }
+
+  iree_allocator_free(allocator, ptr);
+  EXPECT_EQ(QueryMappedBytes(&large_page_allocator), 0);
+  iree_memory_large_page_allocator_deinitialize(&large_page_allocator);
+}
+
+TEST(LargePageAllocatorTest, MappingsHoldOnlyUserData) {
+  iree_memory_large_page_allocator_t large_page_allocator;
+  iree_memory_large_page_allocator_initialize(
+      IREE_MEMORY_LARGE_PAGE_MODE_TRANSPARENT, kMinAllocationSize,
+      iree_allocator_system(), &large_page_allocator);
+  iree_allocator_t allocator =
+      iree_memory_large_page_allocator(&large_page_allocator);
+
+  // Allocations of whole pages map exactly their size with no header.
+  const iree_host_size_t byte_length = 4 * kMinAllocationSize;
+  std::vector<void*> ptrs(64, nullptr);
+  for (void*& ptr : ptrs) {
+    IREE_ASSERT_OK(iree_allocator_malloc(allocator, byte_length, &ptr));
+    if (large_page_allocator.large_page_size) {
+      EXPECT_TRUE(iree_host_size_has_alignment(
+          (uintptr_t)ptr, large_page_allocator.large_page_size));
+    }
+  }
+  if (large_page_allocator.mode != IREE_MEMORY_LARGE_PAGE_MODE_NONE) {
+    EXPECT_EQ(QueryMappedBytes(&large_page_allocator),
+              ptrs.size() * byte_length);
+  }
+
+  // Free in an order different from allocation to exercise table removal.
+  for (size_t i = 0; i < ptrs.size(); i += 2) {
+    iree_allocator_free(allocator, ptrs[i]);
+  }
+  for (size_t i = 1; i < ptrs.size(); i += 2) {
+    iree_allocator_free(allocator, ptrs[i]);
+  }
+  EXPECT_EQ(QueryMappedBytes(&large_page_allocator), 0);
+  iree_memory_large_page_allocator_deinitialize(&large_page_allocator);
+}
+
+TEST(LargePageAllocatorTest, ReallocAcrossBackings) {
+  iree_memory_large_page_allocator_t large_page_allocator;
+  iree_memory_large_page_allocator_initialize(
+      IREE_MEMORY_LARGE_PAGE_MODE_TRANSPARENT, kMinAllocationSize,
+      iree_allocator_system(), &large_page_allocator);
+  iree_allocator_t allocator =
+      iree_memory_large_page_allocator(&large_page_allocator);
+
+  // Grow from the base allocator into a mapping.
+  uint8_t* ptr = NULL;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator, 128, (void**)&ptr));
+  for (int i = 0; i < 128; ++i) ptr[i] = (uint8_t)i;
+  IREE_ASSERT_OK(
+      iree_allocator_realloc(allocator, 2 * kMinAllocationSize, (void**)&ptr));
+  for (int i = 0; i < 128; ++i) ASSERT_EQ(ptr[i], (uint8_t)i);
+
+  // Shrinking within the mapping keeps the allocation in place.
+  uint8_t* mapped_ptr = ptr;
+  IREE_ASSERT_OK(
+      iree_allocator_realloc(allocator, kMinAllocationSize, (void**)&ptr));
+  if (large_page_allocator.mode != IREE_MEMORY_LARGE_PAGE_MODE_NONE) {
+    EXPECT_EQ(ptr, mapped_ptr);
+  }
+
+  // Shrink back below the threshold into the base allocator.
+  IREE_ASSERT_OK(iree_allocator_realloc(allocator, 64, (void**)&ptr));
+  for (int i = 0; i < 64; ++i) ASSERT_EQ(ptr[i], (uint8_t)i);
+  EXPECT_EQ(QueryMappedBytes(&large_page_allocator), 0);
+
+  iree_allocator_free(allocator, ptr);
+  iree_memory_large_page_allocator_deinitialize(&large_page_allocator);
+}
+
+// Tests fills with each pattern length across lengths that exercise the vector
+// block loop and tail along with unaligned target pointers.
+TEST(MemoryFillTest, Patterns) {
+  const uint8_t pattern[IREE_MEMORY_FILL_MAX_PATTERN_LENGTH] = {
+      0x10, 0x21, 0x32, 0x43, 0x54, 0x65, 0x76, 0x87,
+      0x98, 0xA9, 0xBA, 0xCB, 0xDC, 0xED, 0xFE, 0x0F};
+  static constexpr uint8_t kGuard = 0xCD;
+  std::vector<uint8_t> buffer(2048);
+  for (iree_host_size_t pattern_length = 1;
+       pattern_length <= IREE_MEMORY_FILL_MAX_PATTERN_LENGTH;
+       pattern_length *= 2) {
+    for (iree_host_size_t offset : {0, 1, 3}) {
+      for (iree_host_size_t count : {0, 1, 3, 4, 5, 17, 64}) {
+        iree_host_size_t length = count * pattern_length;
+        std::fill(buffer.begin(), buffer.end(), kGuard);
+        iree_memory_fill(buffer.data() + offset, length, pattern,
+                         pattern_length);
+        for (iree_host_size_t i = 0; i < offset; ++i) {
+          ASSERT_EQ(buffer[i], kGuard);
+        }
+        for (iree_host_size_t i = 0; i < length; ++i) {
+          ASSERT_EQ(buffer[offset + i], pattern[i % pattern_length])
+              << "pattern_length=" << pattern_length << " length=" << length
+              << " i=" << i;
+        }
+        ASSERT_EQ(buffer[offset + length], kGuard);
+      }
+    }
+  }
+}
+
+// Tests that repeating patterns produce the same contents as their reduced
+// forms.
+TEST(MemoryFillTest, RepeatingPatterns) {
+  const uint8_t pattern[16] = {0xAB, 0xCD, 0xAB, 0xCD, 0xAB, 0xCD, 0xAB, 0xCD,
+                               0xAB, 0xCD, 0xAB, 0xCD, 0xAB, 0xCD, 0xAB, 0xCD};
+  std::vector<uint8_t> buffer(96);
+  iree_memory_fill(buffer.data(), buffer.size(), pattern, sizeof(pattern));
+  for (iree_host_size_t i = 0; i < buffer.size(); ++i) {
+    ASSERT_EQ(buffer[i], pattern[i % 2]);
+  }
+
+  const uint8_t zeros[8] = {0};
+  iree_memory_fill(buffer.data(), buffer.size(), zeros, sizeof(zeros));
+  for (uint8_t value : buffer) ASSERT_EQ(value, 0);
+}
+
+// Tests copies on both sides of the non-temporal threshold with unaligned
+// source and target pointers with and without the streaming hint.
+TEST(MemoryCopyTest, Copy) {
+  static constexpr iree_host_size_t kMaxLength =
+      IREE_MEMORY_COPY_NON_TEMPORAL_THRESHOLD + 1024;
+  std::vector<uint8_t> source(kMaxLength + 8);
+  for (iree_host_size_t i = 0; i < source.size(); ++i) {
+    source[i] = (uint8_t)(i * 7 + (i >> 8));
+  }
+  std::vector<uint8_t> target(kMaxLength + 8);
+  const iree_host_size_t lengths[] = {
+      0,
+      13,
+      4096,
+      IREE_MEMORY_COPY_NON_TEMPORAL_THRESHOLD,
+      IREE_MEMORY_COPY_NON_TEMPORAL_THRESHOLD + 77,
+  };
+  const iree_memory_copy_flags_t flag_sets[] = {
+      IREE_MEMORY_COPY_FLAG_NONE,
+      IREE_MEMORY_COPY_FLAG_TARGET_NOT_READ_SOON,
+  };
+  for (iree_memory_copy_flags_t flags : flag_sets) {
+    for (iree_host_size_t length : lengths) {
+      for (iree_host_size_t offset : {0, 3}) {
+        std::fill(target.begin(), target.end(), 0);
+        iree_memory_copy(target.data() + offset, source.data() + 1, length,
+                         flags);
+        ASSERT_EQ(
+            std::memcmp(target.data() + offset, source.data() + 1, length), 0)
+            << "flags=" << flags << " length=" << length
+            << " offset=" << offset;
+        ASSERT_EQ(target[offset + length], 0);
+      }
+    }
+  }
+}
+
+}  // namespace
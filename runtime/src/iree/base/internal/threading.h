@@ -75,9 +75,10 @@ typedef enum iree_thread_priority_class_e {
 //   management infra to see if we can tell when we need to do this.
 //
 //   Mapping:
-//    group: NUMA node passed to set_mempolicy.
-//       id: CPU_SET bit indicating which CPU to run on.
-//      smt: whether to CPU_SET both the base ID and the subsequent ID.
+//        group: NUMA node whose CPUs are used when group_any is set.
+//           id: CPU_SET bit indicating which CPU to run on.
+//          smt: whether to CPU_SET both the base ID and the subsequent ID.
+//    numa_node: NUMA node passed to set_mempolicy when assigned.
 //
 // Windows:
 //   Stuff just works. Love it.
@@ -91,13 +92,18 @@ typedef struct iree_thread_affinity_t {
   // processor associated with the specified group (NUMA node ID).
   uint32_t group_any : 1;
   // Processor group the thread should be assigned to, aka NUMA node, cluster,
-  // etc depending on platform. On platforms where the processor ID is unique
-  // for the purposes of scheduling (e.g. Linux) this is used for related APIs
-  // like mbind/set_mempolicy. If group_any is set and id_assigned is not then
+  // etc depending on platform. If group_any is set and id_assigned is not then
   // any processor associated with the group will be used.
   uint32_t group : 8;
 
-  uint32_t reserved : 23;
+  // When 1 |numa_node| is the NUMA node memory allocated by the thread should
+  // be placed on. This is separate from |group| as groups may be clusters or
+  // other platform-specific processor sets that are not NUMA nodes.
+  uint32_t numa_node_assigned : 1;
+  // NUMA node ID used for APIs like set_mempolicy when numa_node_assigned.
+  uint32_t numa_node : 10;
+
+  uint32_t reserved : 12;
 
   // When 0 the affinity is undefined and the system may place the thread
   // anywhere and migrate it as much as it likes. In practice it may do that
@@ -364,6 +364,60 @@ static void iree_thread_make_cpu_set_from_node_id(uint32_t node_id,
   fclose(file);
 }
 
+// Total number of online NUMA nodes or 0 if unknown.
+static uint32_t iree_thread_numa_node_count = 0;
+static void iree_thread_query_numa_node_count(void) {
+  // e.g. '0-1' or '0,2-3'
+  FILE* file = fopen("/sys/devices/system/node/online", "r");
+  if (!file) return;  // Not a NUMA-enabled kernel.
+  char line_buffer[256];
+  const size_t read_length = fread(line_buffer, 1, sizeof(line_buffer), file);
+  fclose(file);
+  iree_string_view_t line =
+      iree_string_view_trim(iree_make_string_view(line_buffer, read_length));
+  uint32_t node_count = 0;
+  while (!iree_string_view_is_empty(line)) {
+    iree_string_view_t range_str;
+    iree_string_view_split(line, ',', &range_str, &line);
+    iree_string_view_t first_str, last_str;
+    iree_string_view_split(range_str, '-', &first_str, &last_str);
+    uint32_t first = 0;
+    if (!iree_string_view_atoi_uint32(first_str, &first)) return;
+    uint32_t last = first;
+    if (!iree_string_view_is_empty(last_str) &&
+        !iree_string_view_atoi_uint32(last_str, &last)) {
+      return;
+    }
+    node_count += last - first + 1;
+  }
+  iree_thread_numa_node_count = node_count;
+}
+
+// From linux/mempolicy.h; defined here to avoid requiring kernel headers.
+#define IREE_MPOL_PREFERRED 1
+
+// Sets the NUMA memory policy of the calling thread to prefer allocating new
+// pages from the given |node_id|. Memory first touched by the thread will then
+// be local to the processors the thread is pinned to instead of wherever the
+// page happened to be faulted in. This is a no-op on single-node systems.
+static void iree_thread_set_mempolicy_from_node_id(uint32_t node_id) {
+#if defined(__NR_set_mempolicy)
+  static iree_once_flag node_count_query_flag = IREE_ONCE_FLAG_INIT;
+  iree_call_once(&node_count_query_flag, iree_thread_query_numa_node_count);
+  if (iree_thread_numa_node_count <= 1) return;
+  // Sized to hold any iree_thread_affinity_t::numa_node.
+  unsigned long node_mask[1024 / (8 * sizeof(unsigned long))];
+  memset(node_mask, 0, sizeof(node_mask));
+  node_mask[node_id / (8 * sizeof(unsigned long))] =
+      1ul << (node_id % (8 * sizeof(unsigned long)));
+  // NOTE: maxnode is the number of bits in the mask plus one (the kernel
+  // historically drops the last bit). Failures (such as the node being
+  // offline) are ignored as placement is only a performance hint.
+  syscall(__NR_set_mempolicy, IREE_MPOL_PREFERRED, node_mask,
+          (unsigned long)(sizeof(node_mask) * 8 + 1));
+#endif  // __NR_set_mempolicy
+}
+
 #else
 
 // No implementation available. BSD may have some equivalent to the Linux
@@ -373,6 +427,8 @@ static void iree_thread_make_cpu_set_from_node_id(uint32_t node_id,
   iree_thread_make_cpu_set_all(out_set);
 }
 
+static void iree_thread_set_mempolicy_from_node_id(uint32_t node_id) {}
+
 #endif  // IREE_PLATFORM_EMSCRIPTEN
 
 static void iree_thread_make_cpu_set_from_affinity(
@@ -431,10 +487,15 @@ void iree_thread_request_affinity(iree_thread_t* thread,
   pthread_setaffinity_np(thread->handle, sizeof(cpu_set), &cpu_set);
 #endif  // IREE_PLATFORM_*
 
-  // TODO(benvanik): make a set_mempolicy syscall where available to set the
-  // NUMA allocation pinning for the calling thread. We'll likely want an
-  // iree_allocator_t control operation for this to allow users to plug in
-  // their own implementations and also let the HAL pin allocated buffers.
+  // Memory policies can only be set for the calling thread. Threads request
+  // their own affinity when they start running (and whenever it may have
+  // changed) so this is hit for any thread that cares about placement.
+  // Allocations made explicitly on behalf of other nodes (such as HAL buffers)
+  // should use iree_allocator_bind instead.
+  if (affinity.numa_node_assigned &&
+      pthread_equal(thread->handle, pthread_self())) {
+    iree_thread_set_mempolicy_from_node_id(affinity.numa_node);
+  }
 
   IREE_TRACE_ZONE_END(z0);
 }
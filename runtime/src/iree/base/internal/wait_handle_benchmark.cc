@@ -0,0 +1,138 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <cstddef>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "iree/base/internal/wait_handle.h"
+
+#if defined(IREE_PLATFORM_LINUX)
+#include <poll.h>
+#endif  // IREE_PLATFORM_LINUX
+
+namespace {
+
+//==============================================================================
+// Utilities
+//==============================================================================
+
+// A set of |count| events of which only the last is signaled, as is typical of
+// a poller with many outstanding waits where one has just completed.
+class EventList {
+ public:
+  explicit EventList(size_t count) : events_(count) {
+    for (size_t i = 0; i < count; ++i) {
+      IREE_CHECK_OK(
+          iree_event_initialize(/*initial_state=*/i + 1 == count, &events_[i]));
+    }
+  }
+  ~EventList() {
+    for (auto& event : events_) iree_event_deinitialize(&event);
+  }
+  std::vector<iree_event_t>& events() { return events_; }
+
+ private:
+  std::vector<iree_event_t> events_;
+};
+
+//==============================================================================
+// poll baseline
+//==============================================================================
+
+#if defined(IREE_PLATFORM_LINUX)
+
+// Waits on the handles with poll() over a persistent pollfd list and scans the
+// results for the signaled handle. This is the work done by the poll/ppoll
+// iree_wait_set_t implementation and the baseline for the epoll one: the kernel
+// must register and scan every fd on each wait.
+void BM_PollWaitAny(benchmark::State& state) {
+  EventList list(static_cast<size_t>(state.range(0)));
+  std::vector<struct pollfd> poll_fds;
+  for (auto& event : list.events()) {
+    struct pollfd poll_fd;
+    poll_fd.fd = event.value.event.fd;
+    poll_fd.events = POLLIN | POLLPRI;
+    poll_fd.revents = 0;
+    poll_fds.push_back(poll_fd);
+  }
+  for (auto _ : state) {
+    int rv = poll(poll_fds.data(), poll_fds.size(), 0);
+    benchmark::DoNotOptimize(rv);
+    for (auto& poll_fd : poll_fds) {
+      if (poll_fd.revents & POLLIN) {
+        benchmark::DoNotOptimize(poll_fd);
+        break;
+      }
+    }
+  }
+}
+BENCHMARK(BM_PollWaitAny)->Arg(8)->Arg(64)->Arg(512);
+
+#endif  // IREE_PLATFORM_LINUX
+
+//==============================================================================
+// iree_wait_set_t
+//==============================================================================
+
+// Waits on a persistent wait set using the platform implementation (epoll on
+// Linux/Android).
+void BM_WaitSetWaitAny(benchmark::State& state) {
+  EventList list(static_cast<size_t>(state.range(0)));
+  iree_wait_set_t* wait_set = NULL;
+  IREE_CHECK_OK(iree_wait_set_allocate(list.events().size(),
+                                       iree_allocator_system(), &wait_set));
+  for (auto& event : list.events()) {
+    IREE_CHECK_OK(iree_wait_set_insert(wait_set, event));
+  }
+  for (auto _ : state) {
+    iree_wait_handle_t wake_handle;
+    IREE_CHECK_OK(
+        iree_wait_any(wait_set, IREE_TIME_INFINITE_PAST, &wake_handle));
+    benchmark::DoNotOptimize(wake_handle);
+  }
+  iree_wait_set_free(wait_set);
+}
+BENCHMARK(BM_WaitSetWaitAny)->Arg(8)->Arg(64)->Arg(512);
+
+// Waits for all handles in a persistent wait set while they are all signaled.
+void BM_WaitSetWaitAll(benchmark::State& state) {
+  EventList list(static_cast<size_t>(state.range(0)));
+  iree_wait_set_t* wait_set = NULL;
+  IREE_CHECK_OK(iree_wait_set_allocate(list.events().size(),
+                                       iree_allocator_system(), &wait_set));
+  for (auto& event : list.events()) {
+    iree_event_set(&event);
+    IREE_CHECK_OK(iree_wait_set_insert(wait_set, event));
+  }
+  for (auto _ : state) {
+    IREE_CHECK_OK(iree_wait_all(wait_set, IREE_TIME_INFINITE_PAST));
+  }
+  iree_wait_set_free(wait_set);
+}
+BENCHMARK(BM_WaitSetWaitAll)->Arg(8)->Arg(64)->Arg(512);
+
+// Erases and reinserts one handle of a wait set as when a poller retires one
+// wait and begins another.
+void BM_WaitSetEraseInsert(benchmark::State& state) {
+  EventList list(static_cast<size_t>(state.range(0)));
+  iree_wait_set_t* wait_set = NULL;
+  IREE_CHECK_OK(iree_wait_set_allocate(list.events().size(),
+                                       iree_allocator_system(), &wait_set));
+  for (auto& event : list.events()) {
+    IREE_CHECK_OK(iree_wait_set_insert(wait_set, event));
+  }
+  iree_wait_handle_t wake_handle;
+  IREE_CHECK_OK(iree_wait_any(wait_set, IREE_TIME_INFINITE_PAST, &wake_handle));
+  for (auto _ : state) {
+    iree_wait_set_erase(wait_set, wake_handle);
+    IREE_CHECK_OK(iree_wait_set_insert(wait_set, wake_handle));
+  }
+  iree_wait_set_free(wait_set);
+}
+BENCHMARK(BM_WaitSetEraseInsert)->Arg(8)->Arg(64)->Arg(512);
+
+}  // namespace
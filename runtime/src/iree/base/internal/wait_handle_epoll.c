@@ -9,57 +9,446 @@
 
 #if IREE_WAIT_API == IREE_WAIT_API_EPOLL
 
+#include <errno.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <time.h>
+#include <unistd.h>
+
 #include "iree/base/internal/wait_handle_posix.h"
 
+//===----------------------------------------------------------------------===//
+// Platform utilities
+//===----------------------------------------------------------------------===//
+
+// Events each handle is registered for. Handles are level-triggered: an
+// iree_event_t remains signaled until it is reset and waits on an already
+// signaled handle must return immediately every time, which edge-triggered
+// registrations would not report. EPOLLERR/EPOLLHUP are always implied.
+#define IREE_WAIT_SET_EPOLL_EVENTS (EPOLLIN | EPOLLPRI)
+
+// epoll_wait may spuriously wake with an EINTR. As with poll we need to retry
+// with an updated timeout based on the deadline. epoll_wait only supports
+// millisecond timeouts and iree_absolute_deadline_to_timeout_ms rounds up so
+// that we never return before the deadline has been reached.
+//
+// Documentation: https://man7.org/linux/man-pages/man2/epoll_wait.2.html
+static iree_status_t iree_syscall_epoll_wait(int epoll_fd,
+                                             struct epoll_event* events,
+                                             int max_events,
+                                             iree_time_t deadline_ns,
+                                             int* out_event_count) {
+  *out_event_count = 0;
+  int rv = -1;
+  do {
+    uint32_t timeout_ms = iree_absolute_deadline_to_timeout_ms(deadline_ns);
+    rv = epoll_wait(epoll_fd, events, max_events,
+                    timeout_ms == UINT32_MAX ? -1 : (int)timeout_ms);
+  } while (rv < 0 && errno == EINTR);
+  if (rv > 0) {
+    // One or more events set.
+    *out_event_count = rv;
+    return iree_ok_status();
+  } else if (IREE_UNLIKELY(rv < 0)) {
+    return iree_make_status(iree_status_code_from_errno(errno),
+                            "epoll_wait failure %d", errno);
+  }
+  // rv == 0
+  // Timeout; no events set.
+  return iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
+}
+
+// Single handle waits don't benefit from a persistent kernel set and use ppoll
+// for its nanosecond timeout. Wait-all also uses ppoll: epoll_wait rechecks and
+// requeues every ready level-triggered handle on each call and is several
+// times slower than ppoll when most of the set is signaled.
+//
+// Documentation: https://man7.org/linux/man-pages/man2/poll.2.html
+static iree_status_t iree_syscall_ppoll(struct pollfd* fds, nfds_t nfds,
+                                        iree_time_t deadline_ns,
+                                        int* out_signaled_count) {
+  *out_signaled_count = 0;
+  int rv = -1;
+  do {
+    // Recompute the timeout each iteration as a previous ppoll may have taken
+    // some of the time.
+    struct timespec timeout_ts;
+    struct timespec* tmo_p = &timeout_ts;
+    if (deadline_ns == IREE_TIME_INFINITE_PAST) {
+      // Block never.
+      memset(&timeout_ts, 0, sizeof(timeout_ts));
+    } else if (deadline_ns == IREE_TIME_INFINITE_FUTURE) {
+      // Block forever (NULL timeout to ppoll).
+      tmo_p = NULL;
+    } else {
+      // Wait only for as much time as we have before the deadline is exceeded.
+      iree_duration_t timeout_ns = deadline_ns - iree_time_now();
+      if (timeout_ns < 0) {
+        memset(&timeout_ts, 0, sizeof(timeout_ts));
+      } else {
+        timeout_ts.tv_sec = (time_t)(timeout_ns / 1000000000ull);
+        timeout_ts.tv_nsec = (long)(timeout_ns % 1000000000ull);
+      }
+    }
+    rv = ppoll(fds, nfds, tmo_p, NULL);
+  } while (rv < 0 && errno == EINTR);
+  if (rv > 0) {
+    *out_signaled_count = rv;
+    return iree_ok_status();
+  } else if (rv < 0) {
+    return iree_make_status(iree_status_code_from_errno(errno),
+                            "ppoll failure %d", errno);
+  }
+  return iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
+}
+
 //===----------------------------------------------------------------------===//
 // iree_wait_set_t
 //===----------------------------------------------------------------------===//
 
-// TODO(benvanik): iree_wait_set_s using an epoll fd.
-// epoll lets us route the wait set operations right to kernel and not need our
-// own duplicate data structure. epoll is great, just not available on mac/ios
-// so we still need poll for that. linux/android/bsd all have epoll, though.
+// A registered handle. Slots never move while in use so that the slot index
+// can be stored in the epoll registration and returned directly from a wait
+// without needing to update the kernel when other handles are erased.
+typedef struct iree_wait_set_slot_t {
+  // User-provided handle. Valid only when ref_count > 0.
+  iree_wait_handle_t handle;
+  // Number of times the handle has been inserted; 0 if the slot is free.
+  uint32_t ref_count;
+  // Read fd registered with epoll or -1 if the handle has no fd. Handles
+  // without an fd are tracked so that they can be erased but never signal.
+  int fd;
+  // Next free slot index when ref_count == 0.
+  uint16_t next_free;
+} iree_wait_set_slot_t;
+
 struct iree_wait_set_t {
-  // NOTE: we could in theory use the epoll handle directly (iree_wait_set_s
-  // then is just a pointer). Then allocate/free just go straight to the system.
-  int reserved;
+  iree_allocator_t allocator;
+
+  // epoll instance with all handles in the set registered.
+  // The kernel keeps the registrations across waits so that inserting or
+  // erasing a handle is O(1) and waits do not pass or scan the whole set.
+  int epoll_fd;
+
+  // Total capacity of the slot and poll fd lists.
+  iree_host_size_t handle_capacity;
+
+  // Total number of unique handles in the set.
+  iree_host_size_t handle_count;
+
+  // Total number of handles registered with epoll (those with an fd).
+  iree_host_size_t registered_count;
+
+  // Head of the free slot list or handle_capacity if the set is full.
+  iree_host_size_t free_head;
+
+  // Handle slots indexed by the epoll_event::data::u64 of their registration.
+  iree_wait_set_slot_t* slots;
+
+  // Scratch list of the registered fds for iree_wait_all.
+  struct pollfd* poll_fds;
 };
 
 iree_status_t iree_wait_set_allocate(iree_host_size_t capacity,
                                      iree_allocator_t allocator,
                                      iree_wait_set_t** out_set) {
-  // TODO(benvanik): epoll_create()
+  IREE_ASSERT_ARGUMENT(out_set);
+
+  // Be reasonable; 64K objects is too high and slot indices are 16-bit to fit
+  // in iree_wait_handle_t::set_internal.
+  if (capacity >= UINT16_MAX) {
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "wait set capacity of %" PRIhsz " is unreasonably large", capacity);
+  }
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_host_size_t slot_list_size =
+      capacity * iree_sizeof_struct(iree_wait_set_slot_t);
+  iree_host_size_t poll_fd_list_size = capacity * sizeof(struct pollfd);
+  iree_host_size_t total_size =
+      iree_sizeof_struct(iree_wait_set_t) + slot_list_size + poll_fd_list_size;
+
+  iree_wait_set_t* set = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(allocator, total_size, (void**)&set));
+  set->allocator = allocator;
+  set->handle_capacity = capacity;
+  set->slots =
+      (iree_wait_set_slot_t*)((uint8_t*)set +
+                              iree_sizeof_struct(iree_wait_set_t));
+  set->poll_fds = (struct pollfd*)((uint8_t*)set->slots + slot_list_size);
+
+  // https://man7.org/linux/man-pages/man2/epoll_create.2.html
+  set->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (IREE_UNLIKELY(set->epoll_fd < 0)) {
+    int err = errno;
+    iree_allocator_free(allocator, set);
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(iree_status_code_from_errno(err),
+                            "failed to create epoll instance (%d)", err);
+  }
+
+  set->handle_count = 0;
+  set->registered_count = 0;
+  set->free_head = 0;
+  for (iree_host_size_t i = 0; i < capacity; ++i) {
+    set->slots[i].ref_count = 0;
+    set->slots[i].next_free = (uint16_t)(i + 1);
+  }
+
+  *out_set = set;
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
 }
 
 void iree_wait_set_free(iree_wait_set_t* set) {
-  // TODO(benvanik): close()
+  if (!set) return;
+  IREE_TRACE_ZONE_BEGIN(z0);
+  // Closing the epoll fd drops all registrations.
+  close(set->epoll_fd);
+  iree_allocator_free(set->allocator, set);
+  IREE_TRACE_ZONE_END(z0);
+}
+
+bool iree_wait_set_is_empty(const iree_wait_set_t* set) {
+  return set->handle_count != 0;
+}
+
+// Returns the index of the slot holding |handle| or handle_capacity if it is
+// not in the set. |handle| may carry the slot index from a prior
+// iree_wait_any wake in which case no scan is required.
+static iree_host_size_t iree_wait_set_find_slot(
+    const iree_wait_set_t* set, const iree_wait_handle_t* handle) {
+  iree_host_size_t index = handle->set_internal.index;
+  if (IREE_LIKELY(index < set->handle_capacity) &&
+      set->slots[index].ref_count > 0 &&
+      iree_wait_primitive_compare_identical(&set->slots[index].handle,
+                                            handle)) {
+    return index;
+  }
+  // Fallback to a linear scan.
+  for (iree_host_size_t i = 0; i < set->handle_capacity; ++i) {
+    if (set->slots[i].ref_count > 0 &&
+        iree_wait_primitive_compare_identical(&set->slots[i].handle, handle)) {
+      return i;
+    }
+  }
+  return set->handle_capacity;
+}
+
+// Updates the epoll registration of |slot_index| to wait for |events|.
+static int iree_wait_set_epoll_ctl(iree_wait_set_t* set, int op,
+                                   iree_host_size_t slot_index,
+                                   uint32_t events) {
+  struct epoll_event event;
+  memset(&event, 0, sizeof(event));
+  event.events = events;
+  event.data.u64 = slot_index;
+  return epoll_ctl(set->epoll_fd, op, set->slots[slot_index].fd, &event);
 }
 
 iree_status_t iree_wait_set_insert(iree_wait_set_t* set,
                                    iree_wait_handle_t handle) {
-  // TODO(benvanik): epoll_ctl(EPOLL_CTL_ADD)
+  int fd = iree_wait_primitive_get_read_fd(&handle);
+
+  // Fast path: try to register the fd directly. The kernel tells us if it is
+  // already present and only then do we need to find the existing slot.
+  iree_host_size_t index = set->free_head;
+  if (fd >= 0 && index < set->handle_capacity) {
+    set->slots[index].fd = fd;
+    int rv = iree_wait_set_epoll_ctl(set, EPOLL_CTL_ADD, index,
+                                     IREE_WAIT_SET_EPOLL_EVENTS);
+    if (rv == 0) {
+      ++set->registered_count;
+    } else if (errno != EEXIST) {
+      return iree_make_status(iree_status_code_from_errno(errno),
+                              "failed to add fd %d to epoll set (%d)", fd,
+                              errno);
+    } else {
+      index = set->handle_capacity;  // dupe; fall through to the scan
+    }
+  } else {
+    index = set->handle_capacity;
+  }
+
+  if (index == set->handle_capacity) {
+    // Already registered (or no room/fd to try); reference the existing slot.
+    iree_host_size_t existing_index = iree_wait_set_find_slot(set, &handle);
+    if (existing_index < set->handle_capacity) {
+      ++set->slots[existing_index].ref_count;
+      return iree_ok_status();
+    } else if (set->free_head >= set->handle_capacity) {
+      return iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
+                              "wait set capacity reached");
+    } else if (fd >= 0) {
+      // The fd is registered under a different handle representation.
+      return iree_make_status(IREE_STATUS_ALREADY_EXISTS,
+                              "fd %d is already in the wait set as part of "
+                              "another handle",
+                              fd);
+    }
+    // Handles without an fd are tracked but never registered.
+    index = set->free_head;
+    set->slots[index].fd = -1;
+  }
+
+  iree_wait_set_slot_t* slot = &set->slots[index];
+  set->free_head = slot->next_free;
+  iree_wait_handle_wrap_primitive(handle.type, handle.value, &slot->handle);
+  slot->ref_count = 1;
+  ++set->handle_count;
+  return iree_ok_status();
+}
+
+// Unregisters and frees the slot at |index| regardless of its ref count.
+static void iree_wait_set_release_slot(iree_wait_set_t* set,
+                                       iree_host_size_t index) {
+  iree_wait_set_slot_t* slot = &set->slots[index];
+  if (slot->fd >= 0) {
+    // NOTE: this may fail if the user already closed the fd (which removes it
+    // from the set as a side-effect) and that's fine.
+    epoll_ctl(set->epoll_fd, EPOLL_CTL_DEL, slot->fd, NULL);
+    --set->registered_count;
+  }
+  slot->ref_count = 0;
+  slot->next_free = (uint16_t)set->free_head;
+  set->free_head = index;
+  --set->handle_count;
 }
 
 void iree_wait_set_erase(iree_wait_set_t* set, iree_wait_handle_t handle) {
-  // TODO(benvanik): epoll_ctl(EPOLL_CTL_DEL)
+  iree_host_size_t index = iree_wait_set_find_slot(set, &handle);
+  if (IREE_UNLIKELY(index >= set->handle_capacity)) return;
+  if (--set->slots[index].ref_count > 0) return;
+  iree_wait_set_release_slot(set, index);
 }
 
 void iree_wait_set_clear(iree_wait_set_t* set) {
-  // TODO(benvanik): close and reopen?
+  for (iree_host_size_t i = 0;
+       i < set->handle_capacity && set->handle_count > 0; ++i) {
+    if (set->slots[i].ref_count > 0) iree_wait_set_release_slot(set, i);
+  }
+}
+
+// Maps an epoll event bitfield result to a status (on failure) and an
+// indicator of whether the event was signaled.
+static iree_status_t iree_wait_set_resolve_epoll_events(uint32_t events,
+                                                        bool* out_signaled) {
+  if (events & EPOLLERR) {
+    return iree_make_status(IREE_STATUS_INTERNAL, "EPOLLERR on fd");
+  } else if (events & EPOLLHUP) {
+    return iree_make_status(IREE_STATUS_CANCELLED, "EPOLLHUP on fd");
+  }
+  *out_signaled = (events & (EPOLLIN | EPOLLPRI)) != 0;
+  return iree_ok_status();
 }
 
 iree_status_t iree_wait_all(iree_wait_set_t* set, iree_time_t deadline_ns) {
-  // TODO(benvanik): epoll_wait
+  // Make the syscall only when we have at least one valid fd.
+  // Don't use this as a sleep.
+  if (set->registered_count == 0) {
+    return iree_ok_status();
+  }
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Gather the registered fds. Handles already observed signaled are dropped
+  // from the list so that the kernel does not keep waking on them while we
+  // wait for the rest.
+  nfds_t poll_fd_count = 0;
+  for (iree_host_size_t i = 0; i < set->handle_capacity; ++i) {
+    const iree_wait_set_slot_t* slot = &set->slots[i];
+    if (slot->ref_count == 0 || slot->fd < 0) continue;
+    struct pollfd* poll_fd = &set->poll_fds[poll_fd_count++];
+    poll_fd->fd = slot->fd;
+    poll_fd->events = POLLIN | POLLPRI;
+    poll_fd->revents = 0;
+  }
+
+  iree_status_t status = iree_ok_status();
+  do {
+    int signaled_count = 0;
+    status = iree_syscall_ppoll(set->poll_fds, poll_fd_count, deadline_ns,
+                                &signaled_count);
+    if (!iree_status_is_ok(status)) break;
+    for (nfds_t i = 0; i < poll_fd_count;) {
+      short revents = set->poll_fds[i].revents;
+      if (revents & POLLERR) {
+        status = iree_make_status(IREE_STATUS_INTERNAL, "POLLERR on fd");
+      } else if (revents & POLLHUP) {
+        status = iree_make_status(IREE_STATUS_CANCELLED, "POLLHUP on fd");
+      } else if (revents & POLLNVAL) {
+        status =
+            iree_make_status(IREE_STATUS_INVALID_ARGUMENT, "POLLNVAL on fd");
+      }
+      if (!iree_status_is_ok(status)) break;
+      if (revents & (POLLIN | POLLPRI)) {
+        set->poll_fds[i] = set->poll_fds[--poll_fd_count];
+      } else {
+        set->poll_fds[i++].revents = 0;
+      }
+    }
+  } while (iree_status_is_ok(status) && poll_fd_count > 0);
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
 }
 
 iree_status_t iree_wait_any(iree_wait_set_t* set, iree_time_t deadline_ns,
                             iree_wait_handle_t* out_wake_handle) {
-  // TODO(benvanik): epoll_wait
+  if (out_wake_handle) {
+    memset(out_wake_handle, 0, sizeof(*out_wake_handle));
+  }
+
+  // Make the syscall only when we have at least one valid fd.
+  // Don't use this as a sleep.
+  if (set->registered_count == 0) {
+    return set->handle_count == 0
+               ? iree_ok_status()
+               : iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
+  }
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Only one event is needed to wake. The kernel round-robins level-triggered
+  // ready handles so repeated waits will not starve any of them.
+  struct epoll_event event;
+  int event_count = 0;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_syscall_epoll_wait(set->epoll_fd, &event, 1, deadline_ns,
+                                  &event_count));
+
+  iree_host_size_t index = (iree_host_size_t)event.data.u64;
+  bool signaled = false;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_wait_set_resolve_epoll_events(event.events, &signaled));
+  if (out_wake_handle && signaled) {
+    memcpy(out_wake_handle, &set->slots[index].handle,
+           sizeof(*out_wake_handle));
+    out_wake_handle->set_internal.index = index;
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
 }
 
 iree_status_t iree_wait_one(iree_wait_handle_t* handle,
                             iree_time_t deadline_ns) {
-  // TODO(benvanik): just use poll?
+  struct pollfd poll_fd;
+  poll_fd.fd = iree_wait_primitive_get_read_fd(handle);
+  if (poll_fd.fd == -1) {
+    return iree_ok_status();  // no-op wait
+  }
+  poll_fd.events = POLLIN;
+  poll_fd.revents = 0;
+
+  IREE_TRACE_ZONE_BEGIN(z0);
+  int signaled_count = 0;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_syscall_ppoll(&poll_fd, 1, deadline_ns, &signaled_count));
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
 }
 
 #endif  // IREE_WAIT_API == IREE_WAIT_API_EPOLL
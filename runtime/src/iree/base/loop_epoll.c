@@ -0,0 +1,1344 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/base/loop_epoll.h"
+
+#if defined(IREE_PLATFORM_LINUX)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "iree/base/internal/atomics.h"
+#include "iree/base/internal/synchronization.h"
+#include "iree/base/internal/threading.h"
+#include "iree/base/internal/wait_handle.h"
+
+//===----------------------------------------------------------------------===//
+// iree_loop_epoll_t utilities
+//===----------------------------------------------------------------------===//
+
+// Maximum number of epoll events retrieved per reactor wake.
+#define IREE_LOOP_EPOLL_MAX_EVENTS 64
+
+// Number of wait source registrations stored inline in each operation.
+// Waits on more sources than this allocate their registrations.
+#define IREE_LOOP_EPOLL_INLINE_REGISTRATION_COUNT 2
+
+// NOTE: all callbacks should be at offset 0. This allows for easily zipping
+// through the params lists and issuing callbacks.
+static_assert(offsetof(iree_loop_call_params_t, callback) == 0,
+              "callback must be at offset 0");
+static_assert(offsetof(iree_loop_dispatch_params_t, callback) == 0,
+              "callback must be at offset 0");
+static_assert(offsetof(iree_loop_wait_until_params_t, callback) == 0,
+              "callback must be at offset 0");
+static_assert(offsetof(iree_loop_wait_one_params_t, callback) == 0,
+              "callback must be at offset 0");
+static_assert(offsetof(iree_loop_wait_multi_params_t, callback) == 0,
+              "callback must be at offset 0");
+
+struct iree_loop_epoll_scope_t {
+  // Target loop for execution.
+  iree_loop_epoll_t* loop_epoll;
+
+  // Total number of pending operations in the scope.
+  // When 0 the scope is considered idle.
+  iree_atomic_int32_t pending_count;
+
+  // Set once an operation in the scope has failed or the scope is being freed.
+  // All operations of an aborted scope are retired with IREE_STATUS_ABORTED.
+  iree_atomic_int32_t aborted;
+
+  // Serializes calls to |error_fn| from concurrently failing operations.
+  iree_slim_mutex_t error_mutex;
+
+  // Optional function used to report errors that occur during execution.
+  iree_loop_epoll_error_fn_t error_fn;
+  void* error_user_data;
+};
+
+static bool iree_loop_epoll_scope_is_aborted(iree_loop_epoll_scope_t* scope) {
+  return iree_atomic_load(&scope->aborted, iree_memory_order_acquire) != 0;
+}
+
+//===----------------------------------------------------------------------===//
+// iree_loop_epoll_op_t
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_loop_epoll_op_t iree_loop_epoll_op_t;
+
+// A wait source registered with the reactor epoll instance.
+// The epoll event data points at the registration so that a wake routes
+// directly to the operation without any scanning.
+typedef struct iree_loop_epoll_registration_t {
+  iree_loop_epoll_op_t* op;
+  // Duplicate of the wait handle read fd owned by the registration or -1 once
+  // unregistered. epoll only allows one registration per fd and multiple
+  // operations may wait on the same handle so each gets its own descriptor.
+  int fd;
+} iree_loop_epoll_registration_t;
+
+// An enqueued loop operation.
+// Operations are pooled by the loop and live from enqueue until their callback
+// has returned. Waits are converted in-place into callbacks when resolved.
+struct iree_loop_epoll_op_t {
+  union {
+    iree_loop_callback_t callback;  // asserted at offset 0 above
+    union {
+      iree_loop_call_params_t call;
+      iree_loop_dispatch_params_t dispatch;
+      iree_loop_wait_until_params_t wait_until;
+      iree_loop_wait_one_params_t wait_one;
+      iree_loop_wait_multi_params_t wait_multi;
+    } params;
+  };
+  iree_loop_command_t command;
+  iree_loop_epoll_scope_t* scope;
+
+  // Intrusive link in whichever loop list (incoming/run/free) holds the op.
+  iree_loop_epoll_op_t* next;
+
+  // Status passed to the callback of resolved waits. Owned by the op.
+  iree_status_t status;
+
+  union {
+    // Reactor-owned state of IREE_LOOP_COMMAND_WAIT_* operations.
+    struct {
+      // Links in the reactor list of registered waits.
+      iree_loop_epoll_op_t* list_prev;
+      iree_loop_epoll_op_t* list_next;
+      // Index of the op in the reactor timer heap or IREE_HOST_SIZE_MAX.
+      iree_host_size_t timer_index;
+      // Number of wait sources that must still signal to resolve the wait.
+      iree_host_size_t unresolved_count;
+      // Registrations of the wait sources with the reactor.
+      iree_host_size_t registration_count;
+      iree_loop_epoll_registration_t* registrations;
+      iree_loop_epoll_registration_t
+          inline_registrations[IREE_LOOP_EPOLL_INLINE_REGISTRATION_COUNT];
+      // Set when the wait has been resolved and is pending its callback.
+      bool resolved;
+    } wait;
+    // State of IREE_LOOP_COMMAND_DISPATCH operations shared by workers.
+    struct {
+      // Flattened index of the next workgroup to be claimed.
+      iree_atomic_int64_t next_workgroup;
+      // Number of workers currently running workgroups; guarded by the mutex.
+      int32_t worker_count;
+      // True while the op is at the head of the run list; guarded by the mutex.
+      bool queued;
+      // First failure of any workgroup as an iree_status_t.
+      iree_atomic_intptr_t status;
+    } dispatch;
+  } state;
+};
+
+// A FIFO list of operations linked through iree_loop_epoll_op_t::next.
+typedef struct iree_loop_epoll_op_list_t {
+  iree_loop_epoll_op_t* head;
+  iree_loop_epoll_op_t* tail;
+  iree_host_size_t count;
+} iree_loop_epoll_op_list_t;
+
+static void iree_loop_epoll_op_list_push_back(iree_loop_epoll_op_list_t* list,
+                                              iree_loop_epoll_op_t* op) {
+  op->next = NULL;
+  if (list->tail) {
+    list->tail->next = op;
+  } else {
+    list->head = op;
+  }
+  list->tail = op;
+  ++list->count;
+}
+
+static iree_loop_epoll_op_t* iree_loop_epoll_op_list_pop_front(
+    iree_loop_epoll_op_list_t* list) {
+  iree_loop_epoll_op_t* op = list->head;
+  if (!op) return NULL;
+  list->head = op->next;
+  if (!list->head) list->tail = NULL;
+  op->next = NULL;
+  --list->count;
+  return op;
+}
+
+// Moves all operations of |source| to the end of |target|.
+static void iree_loop_epoll_op_list_append(iree_loop_epoll_op_list_t* target,
+                                           iree_loop_epoll_op_list_t* source) {
+  if (!source->head) return;
+  if (target->tail) {
+    target->tail->next = source->head;
+  } else {
+    target->head = source->head;
+  }
+  target->tail = source->tail;
+  target->count += source->count;
+  memset(source, 0, sizeof(*source));
+}
+
+// Returns the absolute deadline of a wait operation.
+static iree_time_t iree_loop_epoll_op_deadline_ns(
+    const iree_loop_epoll_op_t* op) {
+  switch (op->command) {
+    case IREE_LOOP_COMMAND_WAIT_UNTIL:
+      return op->params.wait_until.deadline_ns;
+    case IREE_LOOP_COMMAND_WAIT_ONE:
+      return op->params.wait_one.deadline_ns;
+    case IREE_LOOP_COMMAND_WAIT_ANY:
+    case IREE_LOOP_COMMAND_WAIT_ALL:
+      return op->params.wait_multi.deadline_ns;
+    default:
+      return IREE_TIME_INFINITE_FUTURE;
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// iree_loop_epoll_t
+//===----------------------------------------------------------------------===//
+
+struct iree_loop_epoll_t {
+  iree_allocator_t allocator;
+  iree_duration_t timer_slack_ns;
+
+  // epoll instance with all pending wait registrations and |wake_fd|.
+  int epoll_fd;
+  // eventfd written to wake the reactor when new work arrives. It is
+  // registered edge-triggered so the reactor never has to drain it.
+  int wake_fd;
+  // Set when |wake_fd| has been written and the reactor has not yet looked at
+  // the incoming work. Coalesces wakes from bursts of submissions into one
+  // write syscall.
+  iree_atomic_int32_t wake_pending;
+  // Set when a scope has been aborted and the reactor must sweep its waits.
+  iree_atomic_int32_t abort_pending;
+
+  // Set when the loop is being freed and all threads must exit.
+  iree_atomic_int32_t exiting;
+
+  // Guards the incoming, run, and free lists below.
+  iree_slim_mutex_t mutex;
+  // Waits enqueued and not yet registered by the reactor.
+  iree_loop_epoll_op_list_t incoming_list;
+  // Callbacks and dispatches ready to run.
+  iree_loop_epoll_op_list_t run_list;
+  // Mirror of |run_list| count readable without the mutex.
+  iree_atomic_int32_t run_count;
+  // Pool of retired operations available for reuse.
+  iree_loop_epoll_op_t* free_list;
+
+  // Posted when work is added to |run_list| or the loop is exiting.
+  iree_notification_t work_notification;
+
+  // Total number of pending operations across all scopes.
+  iree_atomic_int32_t pending_count;
+  // Posted when a scope or the loop becomes idle.
+  iree_notification_t idle_notification;
+
+  // State owned by the reactor thread.
+  struct {
+    // Doubly-linked list of registered waits.
+    iree_loop_epoll_op_t* wait_head;
+    iree_host_size_t wait_count;
+    // Binary min-heap of waits with finite deadlines ordered by deadline.
+    iree_loop_epoll_op_t** timers;
+    iree_host_size_t timer_count;
+    iree_host_size_t timer_capacity;
+  } reactor;
+
+  iree_thread_t* reactor_thread;
+  iree_host_size_t worker_count;
+  iree_thread_t* worker_threads[];
+};
+
+static iree_loop_t iree_loop_epoll_loop_for_op(iree_loop_epoll_op_t* op) {
+  return iree_loop_epoll_scope(op->scope);
+}
+
+// Wakes the reactor if it has not already been woken since it last checked
+// for incoming work.
+static void iree_loop_epoll_wake_reactor(iree_loop_epoll_t* loop_epoll) {
+  if (iree_atomic_exchange(&loop_epoll->wake_pending, 1,
+                           iree_memory_order_acq_rel) != 0) {
+    return;
+  }
+  uint64_t value = 1;
+  ssize_t rv = 0;
+  do {
+    rv = write(loop_epoll->wake_fd, &value, sizeof(value));
+  } while (rv < 0 && errno == EINTR);
+}
+
+static iree_status_t iree_loop_epoll_op_acquire(iree_loop_epoll_t* loop_epoll,
+                                                iree_loop_epoll_op_t** out_op) {
+  iree_slim_mutex_lock(&loop_epoll->mutex);
+  iree_loop_epoll_op_t* op = loop_epoll->free_list;
+  if (op) loop_epoll->free_list = op->next;
+  iree_slim_mutex_unlock(&loop_epoll->mutex);
+  if (!op) {
+    IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+        loop_epoll->allocator, sizeof(*op), (void**)&op));
+  }
+  memset(op, 0, sizeof(*op));
+  *out_op = op;
+  return iree_ok_status();
+}
+
+static void iree_loop_epoll_op_release(iree_loop_epoll_t* loop_epoll,
+                                       iree_loop_epoll_op_t* op) {
+  if (op->command >= IREE_LOOP_COMMAND_WAIT_UNTIL &&
+      op->command <= IREE_LOOP_COMMAND_WAIT_ALL &&
+      op->state.wait.registrations &&
+      op->state.wait.registrations != op->state.wait.inline_registrations) {
+    iree_allocator_free(loop_epoll->allocator, op->state.wait.registrations);
+  }
+  iree_slim_mutex_lock(&loop_epoll->mutex);
+  op->next = loop_epoll->free_list;
+  loop_epoll->free_list = op;
+  iree_slim_mutex_unlock(&loop_epoll->mutex);
+}
+
+// Releases |op| after its callback has returned and updates idle tracking.
+static void iree_loop_epoll_op_complete(iree_loop_epoll_t* loop_epoll,
+                                        iree_loop_epoll_op_t* op) {
+  iree_loop_epoll_scope_t* scope = op->scope;
+  iree_loop_epoll_op_release(loop_epoll, op);
+  // NOTE: |scope| may be freed as soon as its count reaches zero.
+  bool any_idle = false;
+  if (iree_atomic_fetch_sub(&scope->pending_count, 1,
+                            iree_memory_order_acq_rel) == 1) {
+    any_idle = true;
+  }
+  if (iree_atomic_fetch_sub(&loop_epoll->pending_count, 1,
+                            iree_memory_order_acq_rel) == 1) {
+    any_idle = true;
+  }
+  if (any_idle) {
+    iree_notification_post(&loop_epoll->idle_notification, IREE_ALL_WAITERS);
+  }
+}
+
+// Marks |scope| as aborted and has the reactor retire its pending waits.
+static void iree_loop_epoll_abort_scope(iree_loop_epoll_t* loop_epoll,
+                                        iree_loop_epoll_scope_t* scope) {
+  if (iree_atomic_exchange(&scope->aborted, 1, iree_memory_order_acq_rel)) {
+    return;  // already aborted
+  }
+  iree_atomic_store(&loop_epoll->abort_pending, 1, iree_memory_order_release);
+  iree_loop_epoll_wake_reactor(loop_epoll);
+}
+
+// Emits |status| to the given |scope| and aborts associated operations.
+static void iree_loop_epoll_emit_error(iree_loop_epoll_t* loop_epoll,
+                                       iree_loop_epoll_scope_t* scope,
+                                       iree_status_t status) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_TEXT(
+      z0, iree_status_code_string(iree_status_code(status)));
+
+  if (scope->error_fn) {
+    iree_slim_mutex_lock(&scope->error_mutex);
+    scope->error_fn(scope->error_user_data, status);
+    iree_slim_mutex_unlock(&scope->error_mutex);
+  } else {
+    iree_status_ignore(status);
+  }
+
+  iree_loop_epoll_abort_scope(loop_epoll, scope);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+// Issues the abort callback of |op| and completes it.
+// To prevent enqueuing more work while aborting we pass in a NULL loop.
+static void iree_loop_epoll_abort_op(iree_loop_epoll_t* loop_epoll,
+                                     iree_loop_epoll_op_t* op) {
+  iree_status_ignore(op->status);
+  op->status = iree_ok_status();
+  iree_status_ignore(op->callback.fn(op->callback.user_data, iree_loop_null(),
+                                     iree_make_status(IREE_STATUS_ABORTED)));
+  iree_loop_epoll_op_complete(loop_epoll, op);
+}
+
+//===----------------------------------------------------------------------===//
+// Callback execution
+//===----------------------------------------------------------------------===//
+
+// Runs workgroups of a dispatch |op| until all have been claimed or one fails.
+// Safe to call concurrently from multiple workers on the same op.
+static void iree_loop_epoll_run_workgroups(iree_loop_epoll_op_t* op) {
+  if (iree_loop_epoll_scope_is_aborted(op->scope)) return;
+  const iree_loop_dispatch_params_t* params = &op->params.dispatch;
+  iree_loop_t loop = iree_loop_epoll_loop_for_op(op);
+  const int64_t workgroup_count_x = params->workgroup_count_xyz[0];
+  const int64_t workgroup_count_xy =
+      workgroup_count_x * params->workgroup_count_xyz[1];
+  const int64_t workgroup_count =
+      workgroup_count_xy * params->workgroup_count_xyz[2];
+  for (;;) {
+    // Bail early if another workgroup failed.
+    if (IREE_UNLIKELY(iree_atomic_load(&op->state.dispatch.status,
+                                       iree_memory_order_relaxed))) {
+      break;
+    }
+    int64_t i = iree_atomic_fetch_add(&op->state.dispatch.next_workgroup, 1,
+                                      iree_memory_order_relaxed);
+    if (i >= workgroup_count) break;
+    iree_status_t status = params->workgroup_fn(
+        params->callback.user_data, loop, (uint32_t)(i % workgroup_count_x),
+        (uint32_t)((i % workgroup_count_xy) / workgroup_count_x),
+        (uint32_t)(i / workgroup_count_xy));
+    if (!iree_status_is_ok(status)) {
+      intptr_t expected = 0;
+      if (!iree_atomic_compare_exchange_strong(
+              &op->state.dispatch.status, &expected, (intptr_t)status,
+              iree_memory_order_acq_rel, iree_memory_order_relaxed)) {
+        iree_status_ignore(status);
+      }
+      break;
+    }
+  }
+}
+
+// Issues the completion callback of a dispatch |op| once all workers have
+// finished running its workgroups.
+static void iree_loop_epoll_finish_dispatch(iree_loop_epoll_t* loop_epoll,
+                                            iree_loop_epoll_op_t* op) {
+  iree_status_t workgroup_status = (iree_status_t)iree_atomic_exchange(
+      &op->state.dispatch.status, 0, iree_memory_order_acquire);
+  if (iree_loop_epoll_scope_is_aborted(op->scope)) {
+    op->status = workgroup_status;
+    iree_loop_epoll_abort_op(loop_epoll, op);
+    return;
+  }
+  // Fire the completion callback with either success or the first error hit by
+  // a workgroup.
+  iree_status_t status =
+      op->callback.fn(op->callback.user_data,
+                      iree_loop_epoll_loop_for_op(op), workgroup_status);
+  if (!iree_status_is_ok(status)) {
+    iree_loop_epoll_emit_error(loop_epoll, op->scope, status);
+  }
+  iree_loop_epoll_op_complete(loop_epoll, op);
+}
+
+// Runs a callback |op| (or an entire dispatch) on the calling thread.
+static void iree_loop_epoll_run_op(iree_loop_epoll_t* loop_epoll,
+                                   iree_loop_epoll_op_t* op) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  if (op->command == IREE_LOOP_COMMAND_DISPATCH) {
+    iree_loop_epoll_run_workgroups(op);
+    iree_loop_epoll_finish_dispatch(loop_epoll, op);
+  } else if (iree_loop_epoll_scope_is_aborted(op->scope)) {
+    iree_loop_epoll_abort_op(loop_epoll, op);
+  } else {
+    iree_status_t op_status = op->status;
+    op->status = iree_ok_status();
+    iree_status_t status = op->callback.fn(
+        op->callback.user_data, iree_loop_epoll_loop_for_op(op), op_status);
+    if (!iree_status_is_ok(status)) {
+      iree_loop_epoll_emit_error(loop_epoll, op->scope, status);
+    }
+    iree_loop_epoll_op_complete(loop_epoll, op);
+  }
+  IREE_TRACE_ZONE_END(z0);
+}
+
+// Appends |ready| ops to the run list and wakes workers to run them.
+static void iree_loop_epoll_publish_ready(iree_loop_epoll_t* loop_epoll,
+                                          iree_loop_epoll_op_list_t* ready) {
+  if (!ready->head) return;
+  const int32_t ready_count = (int32_t)ready->count;
+  iree_slim_mutex_lock(&loop_epoll->mutex);
+  iree_loop_epoll_op_list_append(&loop_epoll->run_list, ready);
+  iree_atomic_fetch_add(&loop_epoll->run_count, ready_count,
+                        iree_memory_order_release);
+  iree_slim_mutex_unlock(&loop_epoll->mutex);
+  if (loop_epoll->worker_count) {
+    iree_notification_post(&loop_epoll->work_notification, ready_count);
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Worker threads
+//===----------------------------------------------------------------------===//
+
+static bool iree_loop_epoll_worker_should_wake(void* arg) {
+  iree_loop_epoll_t* loop_epoll = (iree_loop_epoll_t*)arg;
+  return iree_atomic_load(&loop_epoll->run_count, iree_memory_order_acquire) >
+             0 ||
+         iree_atomic_load(&loop_epoll->exiting, iree_memory_order_acquire);
+}
+
+// Joins the dispatch at the head of the run list and runs workgroups until all
+// have been claimed. The last worker to leave issues the completion callback.
+// Must be called with the mutex held and returns with it released.
+static void iree_loop_epoll_worker_join_dispatch(iree_loop_epoll_t* loop_epoll,
+                                                 iree_loop_epoll_op_t* op) {
+  ++op->state.dispatch.worker_count;
+  iree_slim_mutex_unlock(&loop_epoll->mutex);
+
+  iree_loop_epoll_run_workgroups(op);
+
+  // All workgroups are claimed: pull the dispatch from the run list so that no
+  // other workers join and let the last one out finish it.
+  iree_slim_mutex_lock(&loop_epoll->mutex);
+  if (op->state.dispatch.queued) {
+    IREE_ASSERT_EQ(loop_epoll->run_list.head, op);
+    iree_loop_epoll_op_list_pop_front(&loop_epoll->run_list);
+    iree_atomic_fetch_sub(&loop_epoll->run_count, 1, iree_memory_order_relaxed);
+    op->state.dispatch.queued = false;
+  }
+  bool is_last = --op->state.dispatch.worker_count == 0;
+  iree_slim_mutex_unlock(&loop_epoll->mutex);
+
+  if (is_last) iree_loop_epoll_finish_dispatch(loop_epoll, op);
+}
+
+static int iree_loop_epoll_worker_main(void* arg) {
+  iree_loop_epoll_t* loop_epoll = (iree_loop_epoll_t*)arg;
+  for (;;) {
+    iree_notification_await(&loop_epoll->work_notification,
+                            iree_loop_epoll_worker_should_wake, loop_epoll,
+                            iree_infinite_timeout());
+    iree_slim_mutex_lock(&loop_epoll->mutex);
+    if (iree_atomic_load(&loop_epoll->exiting, iree_memory_order_acquire)) {
+      iree_slim_mutex_unlock(&loop_epoll->mutex);
+      break;
+    }
+    iree_loop_epoll_op_t* op = loop_epoll->run_list.head;
+    if (!op) {
+      iree_slim_mutex_unlock(&loop_epoll->mutex);
+      continue;
+    }
+    if (op->command == IREE_LOOP_COMMAND_DISPATCH) {
+      // Dispatches stay at the head of the list while workgroups remain so
+      // that every worker that wakes helps run them.
+      iree_loop_epoll_worker_join_dispatch(loop_epoll, op);
+      continue;
+    }
+    iree_loop_epoll_op_list_pop_front(&loop_epoll->run_list);
+    iree_atomic_fetch_sub(&loop_epoll->run_count, 1, iree_memory_order_relaxed);
+    iree_slim_mutex_unlock(&loop_epoll->mutex);
+    iree_loop_epoll_run_op(loop_epoll, op);
+  }
+  return 0;
+}
+
+//===----------------------------------------------------------------------===//
+// Reactor timers
+//===----------------------------------------------------------------------===//
+
+static bool iree_loop_epoll_timer_less(const iree_loop_epoll_op_t* lhs,
+                                       const iree_loop_epoll_op_t* rhs) {
+  return iree_loop_epoll_op_deadline_ns(lhs) <
+         iree_loop_epoll_op_deadline_ns(rhs);
+}
+
+static void iree_loop_epoll_timer_set(iree_loop_epoll_t* loop_epoll,
+                                      iree_host_size_t index,
+                                      iree_loop_epoll_op_t* op) {
+  loop_epoll->reactor.timers[index] = op;
+  op->state.wait.timer_index = index;
+}
+
+static void iree_loop_epoll_timer_sift_up(iree_loop_epoll_t* loop_epoll,
+                                          iree_host_size_t index) {
+  iree_loop_epoll_op_t** timers = loop_epoll->reactor.timers;
+  iree_loop_epoll_op_t* op = timers[index];
+  while (index > 0) {
+    iree_host_size_t parent = (index - 1) / 2;
+    if (!iree_loop_epoll_timer_less(op, timers[parent])) break;
+    iree_loop_epoll_timer_set(loop_epoll, index, timers[parent]);
+    index = parent;
+  }
+  iree_loop_epoll_timer_set(loop_epoll, index, op);
+}
+
+static void iree_loop_epoll_timer_sift_down(iree_loop_epoll_t* loop_epoll,
+                                            iree_host_size_t index) {
+  iree_loop_epoll_op_t** timers = loop_epoll->reactor.timers;
+  const iree_host_size_t count = loop_epoll->reactor.timer_count;
+  iree_loop_epoll_op_t* op = timers[index];
+  for (;;) {
+    iree_host_size_t child = index * 2 + 1;
+    if (child >= count) break;
+    if (child + 1 < count &&
+        iree_loop_epoll_timer_less(timers[child + 1], timers[child])) {
+      ++child;
+    }
+    if (!iree_loop_epoll_timer_less(timers[child], op)) break;
+    iree_loop_epoll_timer_set(loop_epoll, index, timers[child]);
+    index = child;
+  }
+  iree_loop_epoll_timer_set(loop_epoll, index, op);
+}
+
+static iree_status_t iree_loop_epoll_timer_insert(iree_loop_epoll_t* loop_epoll,
+                                                  iree_loop_epoll_op_t* op) {
+  if (loop_epoll->reactor.timer_count == loop_epoll->reactor.timer_capacity) {
+    iree_host_size_t new_capacity =
+        iree_max(16, loop_epoll->reactor.timer_capacity * 2);
+    IREE_RETURN_IF_ERROR(iree_allocator_realloc(
+        loop_epoll->allocator,
+        new_capacity * sizeof(loop_epoll->reactor.timers[0]),
+        (void**)&loop_epoll->reactor.timers));
+    loop_epoll->reactor.timer_capacity = new_capacity;
+  }
+  iree_host_size_t index = loop_epoll->reactor.timer_count++;
+  iree_loop_epoll_timer_set(loop_epoll, index, op);
+  iree_loop_epoll_timer_sift_up(loop_epoll, index);
+  return iree_ok_status();
+}
+
+static void iree_loop_epoll_timer_remove(iree_loop_epoll_t* loop_epoll,
+                                         iree_loop_epoll_op_t* op) {
+  iree_host_size_t index = op->state.wait.timer_index;
+  if (index == IREE_HOST_SIZE_MAX) return;
+  op->state.wait.timer_index = IREE_HOST_SIZE_MAX;
+  iree_host_size_t last_index = --loop_epoll->reactor.timer_count;
+  if (index == last_index) return;
+  // Move the last timer into the hole and restore the heap around it.
+  iree_loop_epoll_op_t* moved_op = loop_epoll->reactor.timers[last_index];
+  iree_loop_epoll_timer_set(loop_epoll, index, moved_op);
+  iree_loop_epoll_timer_sift_down(loop_epoll, index);
+  iree_loop_epoll_timer_sift_up(loop_epoll, moved_op->state.wait.timer_index);
+}
+
+// Returns the epoll timeout in milliseconds until the earliest timer or -1 to
+// wait indefinitely. Rounds up so the reactor never wakes before a deadline
+// and spins.
+static int iree_loop_epoll_timer_timeout_ms(iree_loop_epoll_t* loop_epoll) {
+  if (!loop_epoll->reactor.timer_count) return -1;
+  iree_time_t deadline_ns =
+      iree_loop_epoll_op_deadline_ns(loop_epoll->reactor.timers[0]);
+  iree_time_t now_ns = iree_time_now();
+  if (deadline_ns <= now_ns) return 0;
+  int64_t timeout_ms = (deadline_ns - now_ns + 999999) / 1000000;
+  return timeout_ms > INT_MAX ? INT_MAX : (int)timeout_ms;
+}
+
+//===----------------------------------------------------------------------===//
+// Reactor wait registration
+//===----------------------------------------------------------------------===//
+
+// Returns the fd that signals when |wait_handle| is resolved or -1.
+static int iree_loop_epoll_wait_handle_fd(const iree_wait_handle_t* handle) {
+  switch (handle->type) {
+#if defined(IREE_HAVE_WAIT_TYPE_EVENTFD)
+    case IREE_WAIT_PRIMITIVE_TYPE_EVENT_FD:
+      return handle->value.event.fd;
+#endif  // IREE_HAVE_WAIT_TYPE_EVENTFD
+#if defined(IREE_HAVE_WAIT_TYPE_SYNC_FILE)
+    case IREE_WAIT_PRIMITIVE_TYPE_SYNC_FILE:
+      return handle->value.sync_file.fd;
+#endif  // IREE_HAVE_WAIT_TYPE_SYNC_FILE
+#if defined(IREE_HAVE_WAIT_TYPE_PIPE)
+    case IREE_WAIT_PRIMITIVE_TYPE_PIPE:
+      return handle->value.pipe.read_fd;
+#endif  // IREE_HAVE_WAIT_TYPE_PIPE
+    default:
+      return -1;
+  }
+}
+
+static iree_status_t iree_loop_epoll_register_wait_source(
+    iree_loop_epoll_t* loop_epoll, iree_loop_epoll_op_t* op,
+    iree_wait_source_t* wait_source,
+    iree_loop_epoll_registration_t* out_registration) {
+  if (iree_wait_source_is_delay(*wait_source)) {
+    // Delays have no fd to register; the deadline of the wait op is the only
+    // timer source.
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "delays must come from wait-until ops");
+  }
+
+  // Acquire a wait handle, exporting one from the wait source if needed.
+  // We swap out the wait source with the handle so that we don't export it
+  // again.
+  iree_wait_handle_t wait_handle = iree_wait_handle_immediate();
+  iree_wait_handle_t* wait_handle_ptr =
+      iree_wait_handle_from_source(wait_source);
+  if (wait_handle_ptr) {
+    wait_handle = *wait_handle_ptr;
+  } else {
+    iree_wait_primitive_t wait_primitive = iree_wait_primitive_immediate();
+    IREE_RETURN_IF_ERROR(iree_wait_source_export(
+        *wait_source, IREE_WAIT_PRIMITIVE_TYPE_ANY, iree_immediate_timeout(),
+        &wait_primitive));
+    iree_wait_handle_wrap_primitive(wait_primitive.type, wait_primitive.value,
+                                    &wait_handle);
+    IREE_RETURN_IF_ERROR(iree_wait_source_import(wait_primitive, wait_source));
+  }
+
+  int fd = iree_loop_epoll_wait_handle_fd(&wait_handle);
+  if (fd < 0) {
+    return iree_make_status(IREE_STATUS_UNAVAILABLE,
+                            "wait primitive type %d cannot be polled",
+                            (int)wait_handle.type);
+  }
+  int registration_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (registration_fd < 0) {
+    return iree_make_status(iree_status_code_from_errno(errno),
+                            "failed to duplicate wait fd %d", fd);
+  }
+
+  // Level-triggered one-shot: if the handle is already signaled the event is
+  // reported immediately and once reported the registration stays disarmed.
+  struct epoll_event event;
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN | EPOLLPRI | EPOLLONESHOT;
+  event.data.ptr = out_registration;
+  if (epoll_ctl(loop_epoll->epoll_fd, EPOLL_CTL_ADD, registration_fd, &event) <
+      0) {
+    int error_number = errno;
+    close(registration_fd);
+    return iree_make_status(iree_status_code_from_errno(error_number),
+                            "failed to add fd %d to the loop epoll set", fd);
+  }
+
+  out_registration->op = op;
+  out_registration->fd = registration_fd;
+  return iree_ok_status();
+}
+
+static void iree_loop_epoll_unregister(
+    iree_loop_epoll_t* loop_epoll,
+    iree_loop_epoll_registration_t* registration) {
+  if (registration->fd < 0) return;
+  // NOTE: closing the duplicate alone would leave the registration live as the
+  // original fd still references the same file description.
+  epoll_ctl(loop_epoll->epoll_fd, EPOLL_CTL_DEL, registration->fd, NULL);
+  close(registration->fd);
+  registration->fd = -1;
+}
+
+static void iree_loop_epoll_unregister_all(iree_loop_epoll_t* loop_epoll,
+                                           iree_loop_epoll_op_t* op) {
+  for (iree_host_size_t i = 0; i < op->state.wait.registration_count; ++i) {
+    iree_loop_epoll_unregister(loop_epoll, &op->state.wait.registrations[i]);
+  }
+}
+
+// Queries the wait sources of |op| and registers those not yet resolved.
+// Returns DEFERRED if the wait was registered, OK if it has already resolved,
+// and an error otherwise.
+static iree_status_t iree_loop_epoll_register_wait(
+    iree_loop_epoll_t* loop_epoll, iree_loop_epoll_op_t* op,
+    iree_host_size_t count, iree_wait_source_t* wait_sources, bool wait_all,
+    iree_time_t now_ns) {
+  // Query first: waits that are already resolved (common for fences signaled
+  // before the waiter arrives) complete without any epoll syscalls.
+  iree_host_size_t unresolved_count = 0;
+  for (iree_host_size_t i = 0; i < count; ++i) {
+    if (iree_wait_source_is_immediate(wait_sources[i])) continue;
+    iree_status_code_t wait_status_code = IREE_STATUS_OK;
+    IREE_RETURN_IF_ERROR(
+        iree_wait_source_query(wait_sources[i], &wait_status_code));
+    if (wait_status_code == IREE_STATUS_OK) {
+      if (!wait_all) return iree_ok_status();  // wait-any satisfied
+      // Neuter the resolved source so it is not registered.
+      wait_sources[i] = iree_wait_source_immediate();
+    } else if (wait_status_code == IREE_STATUS_DEFERRED) {
+      ++unresolved_count;
+    } else {
+      return iree_status_from_code(wait_status_code);
+    }
+  }
+  if (!unresolved_count) return iree_ok_status();
+  if (iree_loop_epoll_op_deadline_ns(op) <= now_ns) {
+    return iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
+  }
+
+  if (unresolved_count <= IREE_LOOP_EPOLL_INLINE_REGISTRATION_COUNT) {
+    op->state.wait.registrations = op->state.wait.inline_registrations;
+  } else {
+    IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+        loop_epoll->allocator,
+        unresolved_count * sizeof(op->state.wait.registrations[0]),
+        (void**)&op->state.wait.registrations));
+  }
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < count && iree_status_is_ok(status); ++i) {
+    if (iree_wait_source_is_immediate(wait_sources[i])) continue;
+    status = iree_loop_epoll_register_wait_source(
+        loop_epoll, op, &wait_sources[i],
+        &op->state.wait.registrations[op->state.wait.registration_count]);
+    if (iree_status_is_ok(status)) ++op->state.wait.registration_count;
+  }
+  if (!iree_status_is_ok(status)) {
+    iree_loop_epoll_unregister_all(loop_epoll, op);
+    return status;
+  }
+  op->state.wait.unresolved_count = wait_all ? unresolved_count : 1;
+  return iree_status_from_code(IREE_STATUS_DEFERRED);
+}
+
+//===----------------------------------------------------------------------===//
+// Reactor thread
+//===----------------------------------------------------------------------===//
+
+// Resolves a registered wait |op| with |status| and moves it to |ready|.
+static void iree_loop_epoll_reactor_resolve(iree_loop_epoll_t* loop_epoll,
+                                            iree_loop_epoll_op_t* op,
+                                            iree_status_t status,
+                                            iree_loop_epoll_op_list_t* ready) {
+  op->state.wait.resolved = true;
+  iree_loop_epoll_unregister_all(loop_epoll, op);
+  iree_loop_epoll_timer_remove(loop_epoll, op);
+  if (op->state.wait.list_prev) {
+    op->state.wait.list_prev->state.wait.list_next = op->state.wait.list_next;
+  } else {
+    loop_epoll->reactor.wait_head = op->state.wait.list_next;
+  }
+  if (op->state.wait.list_next) {
+    op->state.wait.list_next->state.wait.list_prev = op->state.wait.list_prev;
+  }
+  --loop_epoll->reactor.wait_count;
+  op->status = status;
+  iree_loop_epoll_op_list_push_back(ready, op);
+}
+
+// Begins a newly enqueued wait |op|, resolving it immediately if possible.
+static void iree_loop_epoll_reactor_begin_wait(
+    iree_loop_epoll_t* loop_epoll, iree_loop_epoll_op_t* op,
+    iree_time_t now_ns, iree_loop_epoll_op_list_t* ready) {
+  op->state.wait.timer_index = IREE_HOST_SIZE_MAX;
+  if (iree_loop_epoll_scope_is_aborted(op->scope)) {
+    // The run path aborts the op.
+    iree_loop_epoll_op_list_push_back(ready, op);
+    return;
+  }
+
+  iree_status_t status = iree_ok_status();
+  switch (op->command) {
+    case IREE_LOOP_COMMAND_WAIT_UNTIL:
+      if (op->params.wait_until.deadline_ns >
+          now_ns + loop_epoll->timer_slack_ns) {
+        status = iree_status_from_code(IREE_STATUS_DEFERRED);
+      }
+      break;
+    case IREE_LOOP_COMMAND_WAIT_ONE:
+      status = iree_loop_epoll_register_wait(loop_epoll, op, 1,
+                                             &op->params.wait_one.wait_source,
+                                             /*wait_all=*/false, now_ns);
+      break;
+    case IREE_LOOP_COMMAND_WAIT_ANY:
+    case IREE_LOOP_COMMAND_WAIT_ALL:
+      status = iree_loop_epoll_register_wait(
+          loop_epoll, op, op->params.wait_multi.count,
+          op->params.wait_multi.wait_sources,
+          op->command == IREE_LOOP_COMMAND_WAIT_ALL, now_ns);
+      break;
+    default:
+      IREE_ASSERT_UNREACHABLE("unhandled wait command");
+      break;
+  }
+  if (!iree_status_is_deferred(status)) {
+    op->status = status;
+    iree_loop_epoll_op_list_push_back(ready, op);
+    return;
+  }
+
+  // Link into the wait list so aborts can find the op.
+  op->state.wait.list_prev = NULL;
+  op->state.wait.list_next = loop_epoll->reactor.wait_head;
+  if (loop_epoll->reactor.wait_head) {
+    loop_epoll->reactor.wait_head->state.wait.list_prev = op;
+  }
+  loop_epoll->reactor.wait_head = op;
+  ++loop_epoll->reactor.wait_count;
+
+  if (iree_loop_epoll_op_deadline_ns(op) != IREE_TIME_INFINITE_FUTURE) {
+    status = iree_loop_epoll_timer_insert(loop_epoll, op);
+    if (!iree_status_is_ok(status)) {
+      iree_loop_epoll_reactor_resolve(loop_epoll, op, status, ready);
+    }
+  }
+}
+
+// Handles an epoll |event| reported for a wait registration.
+static void iree_loop_epoll_reactor_handle_event(
+    iree_loop_epoll_t* loop_epoll, const struct epoll_event* event,
+    iree_loop_epoll_op_list_t* ready) {
+  iree_loop_epoll_registration_t* registration =
+      (iree_loop_epoll_registration_t*)event->data.ptr;
+  if (!registration) return;  // wake_fd; edge-triggered so nothing to drain
+  iree_loop_epoll_op_t* op = registration->op;
+  // Another event in the same batch may have already resolved the op.
+  if (op->state.wait.resolved || registration->fd < 0) return;
+
+  if (!(event->events & (EPOLLIN | EPOLLPRI))) {
+    iree_status_t status =
+        (event->events & EPOLLERR)
+            ? iree_make_status(IREE_STATUS_INTERNAL, "EPOLLERR on wait fd")
+            : iree_make_status(IREE_STATUS_CANCELLED, "EPOLLHUP on wait fd");
+    iree_loop_epoll_reactor_resolve(loop_epoll, op, status, ready);
+    return;
+  }
+
+  // Wait-all ops resolve once every source has signaled. Sources are treated
+  // as resolved once signaled and must not be reset while being waited on.
+  iree_loop_epoll_unregister(loop_epoll, registration);
+  if (--op->state.wait.unresolved_count > 0) return;
+  iree_loop_epoll_reactor_resolve(loop_epoll, op, iree_ok_status(), ready);
+}
+
+// Resolves all timers with deadlines within the slack window of now.
+// Coalescing nearby timers into one wake avoids a reactor wake per timer when
+// many deadlines are clustered (as with per-request timeouts).
+static void iree_loop_epoll_reactor_expire_timers(
+    iree_loop_epoll_t* loop_epoll, iree_loop_epoll_op_list_t* ready) {
+  if (!loop_epoll->reactor.timer_count) return;
+  const iree_time_t expire_ns = iree_time_now() + loop_epoll->timer_slack_ns;
+  while (loop_epoll->reactor.timer_count) {
+    iree_loop_epoll_op_t* op = loop_epoll->reactor.timers[0];
+    if (iree_loop_epoll_op_deadline_ns(op) > expire_ns) break;
+    iree_loop_epoll_reactor_resolve(
+        loop_epoll, op,
+        op->command == IREE_LOOP_COMMAND_WAIT_UNTIL
+            ? iree_ok_status()
+            : iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED),
+        ready);
+  }
+}
+
+// Resolves all registered waits of aborted scopes.
+static void iree_loop_epoll_reactor_abort_waits(
+    iree_loop_epoll_t* loop_epoll, iree_loop_epoll_op_list_t* ready) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_loop_epoll_op_t* op = loop_epoll->reactor.wait_head;
+  while (op) {
+    iree_loop_epoll_op_t* next_op = op->state.wait.list_next;
+    if (iree_loop_epoll_scope_is_aborted(op->scope)) {
+      iree_loop_epoll_reactor_resolve(loop_epoll, op, iree_ok_status(), ready);
+    }
+    op = next_op;
+  }
+  IREE_TRACE_ZONE_END(z0);
+}
+
+static int iree_loop_epoll_reactor_main(void* arg) {
+  iree_loop_epoll_t* loop_epoll = (iree_loop_epoll_t*)arg;
+  struct epoll_event events[IREE_LOOP_EPOLL_MAX_EVENTS];
+  iree_loop_epoll_op_list_t ready;
+  memset(&ready, 0, sizeof(ready));
+  for (;;) {
+    // Clear the wake flag before looking at the lists so that any work
+    // enqueued after this point wakes us again.
+    iree_atomic_store(&loop_epoll->wake_pending, 0, iree_memory_order_seq_cst);
+
+    iree_loop_epoll_op_list_t incoming_list;
+    iree_slim_mutex_lock(&loop_epoll->mutex);
+    if (iree_atomic_load(&loop_epoll->exiting, iree_memory_order_acquire)) {
+      iree_slim_mutex_unlock(&loop_epoll->mutex);
+      break;
+    }
+    incoming_list = loop_epoll->incoming_list;
+    memset(&loop_epoll->incoming_list, 0, sizeof(loop_epoll->incoming_list));
+    iree_slim_mutex_unlock(&loop_epoll->mutex);
+
+    // Register new waits; those already resolved go straight to |ready|.
+    if (incoming_list.head) {
+      IREE_TRACE_ZONE_BEGIN_NAMED(z0, "iree_loop_epoll_reactor_begin_waits");
+      IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, (int64_t)incoming_list.count);
+      const iree_time_t now_ns = iree_time_now();
+      iree_loop_epoll_op_t* op = NULL;
+      while ((op = iree_loop_epoll_op_list_pop_front(&incoming_list))) {
+        iree_loop_epoll_reactor_begin_wait(loop_epoll, op, now_ns, &ready);
+      }
+      IREE_TRACE_ZONE_END(z0);
+    }
+    if (iree_atomic_exchange(&loop_epoll->abort_pending, 0,
+                             iree_memory_order_acq_rel)) {
+      iree_loop_epoll_reactor_abort_waits(loop_epoll, &ready);
+    }
+    iree_loop_epoll_publish_ready(loop_epoll, &ready);
+
+    // Without workers the reactor runs all callbacks ready at this point.
+    // Callbacks that enqueue more work wake the reactor so the wait below
+    // returns immediately.
+    if (!loop_epoll->worker_count) {
+      iree_slim_mutex_lock(&loop_epoll->mutex);
+      iree_loop_epoll_op_list_t run_list = loop_epoll->run_list;
+      memset(&loop_epoll->run_list, 0, sizeof(loop_epoll->run_list));
+      iree_atomic_store(&loop_epoll->run_count, 0, iree_memory_order_relaxed);
+      iree_slim_mutex_unlock(&loop_epoll->mutex);
+      iree_loop_epoll_op_t* op = NULL;
+      while ((op = iree_loop_epoll_op_list_pop_front(&run_list))) {
+        iree_loop_epoll_run_op(loop_epoll, op);
+      }
+    }
+
+    IREE_TRACE_PLOT_VALUE_I64("iree_loop_wait_depth",
+                              loop_epoll->reactor.wait_count);
+
+    int event_count = 0;
+    IREE_TRACE_ZONE_BEGIN_NAMED(z_wait, "iree_loop_epoll_reactor_wait");
+    do {
+      event_count =
+          epoll_wait(loop_epoll->epoll_fd, events, IREE_ARRAYSIZE(events),
+                     iree_loop_epoll_timer_timeout_ms(loop_epoll));
+    } while (event_count < 0 && errno == EINTR);
+    IREE_TRACE_ZONE_APPEND_VALUE_I64(z_wait, event_count);
+    IREE_TRACE_ZONE_END(z_wait);
+
+    for (int i = 0; i < event_count; ++i) {
+      iree_loop_epoll_reactor_handle_event(loop_epoll, &events[i], &ready);
+    }
+    iree_loop_epoll_reactor_expire_timers(loop_epoll, &ready);
+    iree_loop_epoll_publish_ready(loop_epoll, &ready);
+  }
+  return 0;
+}
+
+//===----------------------------------------------------------------------===//
+// iree_loop_epoll_t
+//===----------------------------------------------------------------------===//
+
+IREE_API_EXPORT iree_status_t iree_loop_epoll_allocate(
+    iree_loop_epoll_options_t options, iree_allocator_t allocator,
+    iree_loop_epoll_t** out_loop_epoll) {
+  IREE_ASSERT_ARGUMENT(out_loop_epoll);
+  *out_loop_epoll = NULL;
+  if (options.timer_slack_ns < 0) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "timer slack must be non-negative");
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, options.worker_count);
+
+  iree_loop_epoll_t* loop_epoll = NULL;
+  iree_host_size_t total_size =
+      sizeof(*loop_epoll) +
+      options.worker_count * sizeof(loop_epoll->worker_threads[0]);
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(allocator, total_size, (void**)&loop_epoll));
+  memset(loop_epoll, 0, total_size);
+  loop_epoll->allocator = allocator;
+  loop_epoll->timer_slack_ns = options.timer_slack_ns;
+  loop_epoll->epoll_fd = -1;
+  loop_epoll->wake_fd = -1;
+  iree_slim_mutex_initialize(&loop_epoll->mutex);
+  iree_notification_initialize(&loop_epoll->work_notification);
+  iree_notification_initialize(&loop_epoll->idle_notification);
+
+  iree_status_t status = iree_ok_status();
+  loop_epoll->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (loop_epoll->epoll_fd < 0) {
+    status = iree_make_status(iree_status_code_from_errno(errno),
+                              "epoll_create1 failed");
+  }
+  if (iree_status_is_ok(status)) {
+    loop_epoll->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (loop_epoll->wake_fd < 0) {
+      status = iree_make_status(iree_status_code_from_errno(errno),
+                                "eventfd failed");
+    }
+  }
+  if (iree_status_is_ok(status)) {
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLET;
+    event.data.ptr = NULL;
+    if (epoll_ctl(loop_epoll->epoll_fd, EPOLL_CTL_ADD, loop_epoll->wake_fd,
+                  &event) < 0) {
+      status = iree_make_status(iree_status_code_from_errno(errno),
+                                "failed to register the loop wake fd");
+    }
+  }
+
+  // Workers are started first: the reactor reads |worker_count| to decide
+  // whether it runs callbacks itself.
+  for (iree_host_size_t i = 0;
+       i < options.worker_count && iree_status_is_ok(status); ++i) {
+    char name[32];
+    snprintf(name, sizeof(name), "iree-loop-worker-%u", (uint32_t)i);
+    iree_thread_create_params_t thread_params;
+    memset(&thread_params, 0, sizeof(thread_params));
+    thread_params.name = iree_make_cstring_view(name);
+    status = iree_thread_create(iree_loop_epoll_worker_main, loop_epoll,
+                                thread_params, allocator,
+                                &loop_epoll->worker_threads[i]);
+    if (iree_status_is_ok(status)) ++loop_epoll->worker_count;
+  }
+  if (iree_status_is_ok(status)) {
+    iree_thread_create_params_t thread_params;
+    memset(&thread_params, 0, sizeof(thread_params));
+    thread_params.name = iree_make_cstring_view("iree-loop-reactor");
+    status = iree_thread_create(iree_loop_epoll_reactor_main, loop_epoll,
+                                thread_params, allocator,
+                                &loop_epoll->reactor_thread);
+  }
+
+  if (iree_status_is_ok(status)) {
+    *out_loop_epoll = loop_epoll;
+  } else {
+    iree_loop_epoll_free(loop_epoll);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+IREE_API_EXPORT void iree_loop_epoll_free(iree_loop_epoll_t* loop_epoll) {
+  if (!loop_epoll) return;
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_allocator_t allocator = loop_epoll->allocator;
+
+  // Stop all threads. New work enqueued from here on is rejected.
+  iree_slim_mutex_lock(&loop_epoll->mutex);
+  iree_atomic_store(&loop_epoll->exiting, 1, iree_memory_order_release);
+  iree_slim_mutex_unlock(&loop_epoll->mutex);
+  if (loop_epoll->wake_fd >= 0) iree_loop_epoll_wake_reactor(loop_epoll);
+  iree_notification_post(&loop_epoll->work_notification, IREE_ALL_WAITERS);
+  if (loop_epoll->reactor_thread) {
+    iree_thread_join(loop_epoll->reactor_thread);
+    iree_thread_release(loop_epoll->reactor_thread);
+  }
+  for (iree_host_size_t i = 0; i < loop_epoll->worker_count; ++i) {
+    iree_thread_join(loop_epoll->worker_threads[i]);
+    iree_thread_release(loop_epoll->worker_threads[i]);
+  }
+
+  // Abort all pending operations. This will issue callbacks for each operation
+  // with IREE_STATUS_ABORTED.
+  while (loop_epoll->reactor.wait_head) {
+    iree_loop_epoll_op_t* op = loop_epoll->reactor.wait_head;
+    iree_loop_epoll_op_list_t aborted_list;
+    memset(&aborted_list, 0, sizeof(aborted_list));
+    iree_loop_epoll_reactor_resolve(loop_epoll, op, iree_ok_status(),
+                                    &aborted_list);
+    iree_loop_epoll_abort_op(loop_epoll, op);
+  }
+  iree_loop_epoll_op_t* op = NULL;
+  while ((op = iree_loop_epoll_op_list_pop_front(&loop_epoll->incoming_list))) {
+    iree_loop_epoll_abort_op(loop_epoll, op);
+  }
+  while ((op = iree_loop_epoll_op_list_pop_front(&loop_epoll->run_list))) {
+    if (op->command == IREE_LOOP_COMMAND_DISPATCH) {
+      op->status = (iree_status_t)iree_atomic_exchange(
+          &op->state.dispatch.status, 0, iree_memory_order_acquire);
+    }
+    iree_loop_epoll_abort_op(loop_epoll, op);
+  }
+
+  // After all operations are cleared we can release the data structures.
+  while (loop_epoll->free_list) {
+    op = loop_epoll->free_list;
+    loop_epoll->free_list = op->next;
+    iree_allocator_free(allocator, op);
+  }
+  iree_allocator_free(allocator, loop_epoll->reactor.timers);
+  if (loop_epoll->wake_fd >= 0) close(loop_epoll->wake_fd);
+  if (loop_epoll->epoll_fd >= 0) close(loop_epoll->epoll_fd);
+  iree_notification_deinitialize(&loop_epoll->idle_notification);
+  iree_notification_deinitialize(&loop_epoll->work_notification);
+  iree_slim_mutex_deinitialize(&loop_epoll->mutex);
+  iree_allocator_free(allocator, loop_epoll);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+static bool iree_loop_epoll_is_idle(void* arg) {
+  iree_loop_epoll_t* loop_epoll = (iree_loop_epoll_t*)arg;
+  return iree_atomic_load(&loop_epoll->pending_count,
+                          iree_memory_order_acquire) == 0;
+}
+
+static bool iree_loop_epoll_scope_is_idle(void* arg) {
+  iree_loop_epoll_scope_t* scope = (iree_loop_epoll_scope_t*)arg;
+  return iree_atomic_load(&scope->pending_count, iree_memory_order_acquire) ==
+         0;
+}
+
+IREE_API_EXPORT iree_status_t iree_loop_epoll_wait_idle(
+    iree_loop_epoll_t* loop_epoll, iree_timeout_t timeout) {
+  IREE_ASSERT_ARGUMENT(loop_epoll);
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_status_t status = iree_ok_status();
+  if (!iree_notification_await(&loop_epoll->idle_notification,
+                               iree_loop_epoll_is_idle, loop_epoll, timeout)) {
+    status = iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+//===----------------------------------------------------------------------===//
+// iree_loop_epoll_scope_t
+//===----------------------------------------------------------------------===//
+
+IREE_API_EXPORT iree_status_t iree_loop_epoll_scope_allocate(
+    iree_loop_epoll_t* loop_epoll, iree_loop_epoll_error_fn_t error_fn,
+    void* error_user_data, iree_loop_epoll_scope_t** out_scope) {
+  IREE_ASSERT_ARGUMENT(loop_epoll);
+  IREE_ASSERT_ARGUMENT(out_scope);
+  *out_scope = NULL;
+  iree_loop_epoll_scope_t* scope = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      loop_epoll->allocator, sizeof(*scope), (void**)&scope));
+  memset(scope, 0, sizeof(*scope));
+  scope->loop_epoll = loop_epoll;
+  iree_slim_mutex_initialize(&scope->error_mutex);
+  scope->error_fn = error_fn;
+  scope->error_user_data = error_user_data;
+  *out_scope = scope;
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT void iree_loop_epoll_scope_free(
+    iree_loop_epoll_scope_t* scope) {
+  if (!scope) return;
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_loop_epoll_t* loop_epoll = scope->loop_epoll;
+
+  iree_loop_epoll_abort_scope(loop_epoll, scope);
+  iree_notification_await(&loop_epoll->idle_notification,
+                          iree_loop_epoll_scope_is_idle, scope,
+                          iree_infinite_timeout());
+
+  iree_slim_mutex_deinitialize(&scope->error_mutex);
+  iree_allocator_free(loop_epoll->allocator, scope);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+// Enqueues an operation with |command| and a copy of its |params|.
+static iree_status_t iree_loop_epoll_enqueue(iree_loop_epoll_scope_t* scope,
+                                             iree_loop_command_t command,
+                                             const void* params,
+                                             iree_host_size_t params_size) {
+  iree_loop_epoll_t* loop_epoll = scope->loop_epoll;
+  iree_loop_epoll_op_t* op = NULL;
+  IREE_RETURN_IF_ERROR(iree_loop_epoll_op_acquire(loop_epoll, &op));
+  // Copy the operation in; the params are on the stack and won't be valid after
+  // the caller returns.
+  memcpy(&op->params, params, params_size);
+  op->command = command;
+  op->scope = scope;
+  const bool is_runnable = command == IREE_LOOP_COMMAND_CALL ||
+                           command == IREE_LOOP_COMMAND_DISPATCH;
+  if (command == IREE_LOOP_COMMAND_DISPATCH) op->state.dispatch.queued = true;
+
+  iree_slim_mutex_lock(&loop_epoll->mutex);
+  if (IREE_UNLIKELY(
+          iree_atomic_load(&loop_epoll->exiting, iree_memory_order_acquire))) {
+    iree_slim_mutex_unlock(&loop_epoll->mutex);
+    iree_loop_epoll_op_release(loop_epoll, op);
+    return iree_make_status(
+        IREE_STATUS_FAILED_PRECONDITION,
+        "new work cannot be enqueued while the loop is shutting down");
+  }
+  iree_atomic_fetch_add(&scope->pending_count, 1, iree_memory_order_relaxed);
+  iree_atomic_fetch_add(&loop_epoll->pending_count, 1,
+                        iree_memory_order_relaxed);
+  if (is_runnable) {
+    iree_loop_epoll_op_list_push_back(&loop_epoll->run_list, op);
+    iree_atomic_fetch_add(&loop_epoll->run_count, 1, iree_memory_order_release);
+  } else {
+    iree_loop_epoll_op_list_push_back(&loop_epoll->incoming_list, op);
+  }
+  iree_slim_mutex_unlock(&loop_epoll->mutex);
+
+  if (is_runnable && loop_epoll->worker_count) {
+    // Dispatches want every worker; calls only need one.
+    iree_notification_post(&loop_epoll->work_notification,
+                           command == IREE_LOOP_COMMAND_DISPATCH
+                               ? IREE_ALL_WAITERS
+                               : 1);
+  } else {
+    iree_loop_epoll_wake_reactor(loop_epoll);
+  }
+  return iree_ok_status();
+}
+
+// Control function for the epoll loop.
+// |self| must be an iree_loop_epoll_scope_t.
+IREE_API_EXPORT iree_status_t iree_loop_epoll_ctl(void* self,
+                                                  iree_loop_command_t command,
+                                                  const void* params,
+                                                  void** inout_ptr) {
+  IREE_ASSERT_ARGUMENT(self);
+  iree_loop_epoll_scope_t* scope = (iree_loop_epoll_scope_t*)self;
+  switch (command) {
+    case IREE_LOOP_COMMAND_CALL:
+      return iree_loop_epoll_enqueue(scope, command, params,
+                                     sizeof(iree_loop_call_params_t));
+    case IREE_LOOP_COMMAND_DISPATCH:
+      return iree_loop_epoll_enqueue(scope, command, params,
+                                     sizeof(iree_loop_dispatch_params_t));
+    case IREE_LOOP_COMMAND_WAIT_UNTIL:
+      return iree_loop_epoll_enqueue(scope, command, params,
+                                     sizeof(iree_loop_wait_until_params_t));
+    case IREE_LOOP_COMMAND_WAIT_ONE:
+      return iree_loop_epoll_enqueue(scope, command, params,
+                                     sizeof(iree_loop_wait_one_params_t));
+    case IREE_LOOP_COMMAND_WAIT_ALL:
+    case IREE_LOOP_COMMAND_WAIT_ANY:
+      return iree_loop_epoll_enqueue(scope, command, params,
+                                     sizeof(iree_loop_wait_multi_params_t));
+    case IREE_LOOP_COMMAND_DRAIN: {
+      iree_time_t deadline_ns =
+          ((const iree_loop_drain_params_t*)params)->deadline_ns;
+      if (!iree_notification_await(&scope->loop_epoll->idle_notification,
+                                   iree_loop_epoll_scope_is_idle, scope,
+                                   iree_make_deadline(deadline_ns))) {
+        return iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
+      }
+      return iree_ok_status();
+    }
+    default:
+      return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                              "unimplemented loop command");
+  }
+}
+
+#else
+
+IREE_API_EXPORT iree_status_t iree_loop_epoll_allocate(
+    iree_loop_epoll_options_t options, iree_allocator_t allocator,
+    iree_loop_epoll_t** out_loop_epoll) {
+  IREE_ASSERT_ARGUMENT(out_loop_epoll);
+  *out_loop_epoll = NULL;
+  return iree_make_status(IREE_STATUS_UNAVAILABLE,
+                          "epoll loops are only available on Linux/Android");
+}
+
+IREE_API_EXPORT void iree_loop_epoll_free(iree_loop_epoll_t* loop_epoll) {}
+
+IREE_API_EXPORT iree_status_t iree_loop_epoll_wait_idle(
+    iree_loop_epoll_t* loop_epoll, iree_timeout_t timeout) {
+  return iree_make_status(IREE_STATUS_UNAVAILABLE,
+                          "epoll loops are only available on Linux/Android");
+}
+
+IREE_API_EXPORT iree_status_t iree_loop_epoll_scope_allocate(
+    iree_loop_epoll_t* loop_epoll, iree_loop_epoll_error_fn_t error_fn,
+    void* error_user_data, iree_loop_epoll_scope_t** out_scope) {
+  IREE_ASSERT_ARGUMENT(out_scope);
+  *out_scope = NULL;
+  return iree_make_status(IREE_STATUS_UNAVAILABLE,
+                          "epoll loops are only available on Linux/Android");
+}
+
+IREE_API_EXPORT void iree_loop_epoll_scope_free(
+    iree_loop_epoll_scope_t* scope) {}
+
+IREE_API_EXPORT iree_status_t iree_loop_epoll_ctl(void* self,
+                                                  iree_loop_command_t command,
+                                                  const void* params,
+                                                  void** inout_ptr) {
+  return iree_make_status(IREE_STATUS_UNAVAILABLE,
+                          "epoll loops are only available on Linux/Android");
+}
+
+#endif  // IREE_PLATFORM_LINUX
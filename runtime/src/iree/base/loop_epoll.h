@@ -0,0 +1,112 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BASE_LOOP_EPOLL_H_
+#define IREE_BASE_LOOP_EPOLL_H_
+
+#include "iree/base/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+//===----------------------------------------------------------------------===//
+// iree_loop_epoll_t
+//===----------------------------------------------------------------------===//
+
+// Configuration options for the epoll loop implementation.
+typedef struct iree_loop_epoll_options_t {
+  // Number of worker threads used to run callbacks and dispatch workgroups.
+  // When 0 all callbacks are run on the reactor thread between waits; this
+  // keeps callbacks serialized but means a slow callback delays wakes.
+  iree_host_size_t worker_count;
+
+  // Window after a timer deadline within which other timers are retired in the
+  // same wake. Larger values coalesce more timers into a single reactor wake at
+  // the cost of waking them up to |timer_slack_ns| early. 0 disables
+  // coalescing.
+  iree_duration_t timer_slack_ns;
+} iree_loop_epoll_options_t;
+
+// A threaded loop driven by an epoll reactor.
+//
+// A dedicated reactor thread owns an epoll instance with every pending wait
+// registered against it, so waiting on many handles costs O(ready) per wake
+// instead of the O(n) scans of iree_loop_sync. Timers (wait-until deadlines and
+// wait timeouts) are kept in a heap and serviced with the epoll timeout.
+// Callbacks run on a pool of worker threads (or the reactor itself when
+// configured without workers) and dispatch workgroups are spread across all
+// workers.
+//
+// Only available on Linux/Android; iree_loop_epoll_allocate returns
+// IREE_STATUS_UNAVAILABLE elsewhere.
+//
+// Thread-safe: operations may be enqueued from any thread including loop
+// callbacks running concurrently on workers.
+typedef struct iree_loop_epoll_t iree_loop_epoll_t;
+
+// Allocates an epoll loop using |allocator| stored into |out_loop_epoll|.
+// The reactor and worker threads are started before returning.
+IREE_API_EXPORT iree_status_t iree_loop_epoll_allocate(
+    iree_loop_epoll_options_t options, iree_allocator_t allocator,
+    iree_loop_epoll_t** out_loop_epoll);
+
+// Frees an epoll |loop_epoll|, joining its threads and aborting all pending
+// operations. Callbacks currently executing are allowed to complete.
+IREE_API_EXPORT void iree_loop_epoll_free(iree_loop_epoll_t* loop_epoll);
+
+// Waits until the loop is idle (all operations in all scopes have retired).
+// Returns IREE_STATUS_DEADLINE_EXCEEDED if |timeout| is reached before the
+// loop is idle. Must not be called from loop callbacks.
+IREE_API_EXPORT iree_status_t iree_loop_epoll_wait_idle(
+    iree_loop_epoll_t* loop_epoll, iree_timeout_t timeout);
+
+// Handles scope errors returned from loop callback operations.
+// Ownership of |status| is passed to the handler and must be freed.
+// All operations of the same scope will be aborted.
+//
+// May be called from any loop thread. Calls for the same scope are serialized.
+typedef void(IREE_API_PTR* iree_loop_epoll_error_fn_t)(void* user_data,
+                                                       iree_status_t status);
+
+// A scope of execution within a loop.
+// Each scope has a dedicated error handler that is notified when an error
+// propagates from a loop operation scheduled against the scope. When an error
+// arises all other operations in the same scope, including those enqueued
+// afterward, are aborted. Serving code should use one scope per request so
+// that a failure only tears down the request that produced it.
+typedef struct iree_loop_epoll_scope_t iree_loop_epoll_scope_t;
+
+// Allocates a loop scope that runs operations against |loop_epoll|.
+IREE_API_EXPORT iree_status_t iree_loop_epoll_scope_allocate(
+    iree_loop_epoll_t* loop_epoll, iree_loop_epoll_error_fn_t error_fn,
+    void* error_user_data, iree_loop_epoll_scope_t** out_scope);
+
+// Aborts any pending operations of |scope|, waits for them to retire, and frees
+// the scope. Must not be called from loop callbacks.
+IREE_API_EXPORT void iree_loop_epoll_scope_free(iree_loop_epoll_scope_t* scope);
+
+IREE_API_EXPORT iree_status_t iree_loop_epoll_ctl(void* self,
+                                                  iree_loop_command_t command,
+                                                  const void* params,
+                                                  void** inout_ptr);
+
+// Returns a loop that schedules operations against |scope|.
+// IREE_LOOP_COMMAND_DRAIN waits for only the operations of |scope|.
+static inline iree_loop_t iree_loop_epoll_scope(
+    iree_loop_epoll_scope_t* scope) {
+  iree_loop_t loop = {
+      scope,
+      iree_loop_epoll_ctl,
+  };
+  return loop;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_BASE_LOOP_EPOLL_H_
@@ -0,0 +1,282 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/base/loop_epoll.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+#if defined(IREE_PLATFORM_LINUX)
+
+// Contains the test definitions applied to all loop implementations:
+#include "iree/base/loop_test.h"
+
+static void RecordFirstError(void* user_data, iree_status_t status) {
+  iree_status_t* status_ptr = (iree_status_t*)user_data;
+  if (iree_status_is_ok(*status_ptr)) {
+    *status_ptr = status;
+  } else {
+    iree_status_ignore(status);
+  }
+}
+
+// The loop owning the scope handed to the shared tests.
+static iree_loop_epoll_t* g_loop_epoll = NULL;
+
+void AllocateLoop(iree_status_t* out_status, iree_allocator_t allocator,
+                  iree_loop_t* out_loop) {
+  iree_loop_epoll_options_t options = {0};
+  options.worker_count = 2;
+
+  IREE_CHECK_OK(iree_loop_epoll_allocate(options, allocator, &g_loop_epoll));
+
+  iree_loop_epoll_scope_t* scope = NULL;
+  IREE_CHECK_OK(iree_loop_epoll_scope_allocate(g_loop_epoll, RecordFirstError,
+                                               out_status, &scope));
+  *out_loop = iree_loop_epoll_scope(scope);
+}
+
+void FreeLoop(iree_allocator_t allocator, iree_loop_t loop) {
+  iree_loop_epoll_scope_free((iree_loop_epoll_scope_t*)loop.self);
+  iree_loop_epoll_free(g_loop_epoll);
+  g_loop_epoll = NULL;
+}
+
+namespace iree {
+namespace {
+
+// Tests for behavior specific to the epoll loop.
+class LoopEpollTest : public ::testing::TestWithParam<iree_host_size_t> {
+ protected:
+  void SetUp() override {
+    iree_loop_epoll_options_t options = {0};
+    options.worker_count = GetParam();
+    options.timer_slack_ns = 1000000;
+    IREE_ASSERT_OK(iree_loop_epoll_allocate(options, iree_allocator_system(),
+                                            &loop_epoll_));
+  }
+  void TearDown() override { iree_loop_epoll_free(loop_epoll_); }
+
+  iree_loop_epoll_scope_t* AllocateScope(iree_status_t* out_status) {
+    iree_loop_epoll_scope_t* scope = NULL;
+    IREE_CHECK_OK(iree_loop_epoll_scope_allocate(loop_epoll_, RecordFirstError,
+                                                 out_status, &scope));
+    return scope;
+  }
+
+  iree_loop_epoll_t* loop_epoll_ = NULL;
+};
+
+// Tests that a wait-any over many handles wakes on the single one signaled and
+// that wait-alls spanning the same handles resolve independently.
+TEST_P(LoopEpollTest, ManyHandles) {
+  iree_status_t scope_status = iree_ok_status();
+  iree_loop_epoll_scope_t* scope = AllocateScope(&scope_status);
+  iree_loop_t loop = iree_loop_epoll_scope(scope);
+
+  static constexpr int kEventCount = 256;
+  std::vector<iree_event_t> events(kEventCount);
+  std::vector<iree_wait_source_t> any_sources(kEventCount);
+  std::vector<iree_wait_source_t> all_sources(kEventCount);
+  for (int i = 0; i < kEventCount; ++i) {
+    IREE_ASSERT_OK(iree_event_initialize(/*initial_state=*/false, &events[i]));
+    any_sources[i] = iree_event_await(&events[i]);
+    all_sources[i] = iree_event_await(&events[i]);
+  }
+
+  std::atomic<int> any_count{0};
+  std::atomic<int> all_count{0};
+  IREE_ASSERT_OK(iree_loop_wait_any(
+      loop, any_sources.size(), any_sources.data(), iree_make_timeout_ms(5000),
+      +[](void* user_data, iree_loop_t loop, iree_status_t status) {
+        IREE_EXPECT_OK(status);
+        ++*reinterpret_cast<std::atomic<int>*>(user_data);
+        return iree_ok_status();
+      },
+      &any_count));
+  IREE_ASSERT_OK(iree_loop_wait_all(
+      loop, all_sources.size(), all_sources.data(), iree_make_timeout_ms(5000),
+      +[](void* user_data, iree_loop_t loop, iree_status_t status) {
+        IREE_EXPECT_OK(status);
+        ++*reinterpret_cast<std::atomic<int>*>(user_data);
+        return iree_ok_status();
+      },
+      &all_count));
+
+  // Only the wait-any can resolve with a single signaled handle.
+  iree_event_set(&events[kEventCount / 2]);
+  while (any_count.load() == 0) std::this_thread::yield();
+  EXPECT_EQ(all_count.load(), 0);
+
+  for (auto& event : events) iree_event_set(&event);
+  IREE_ASSERT_OK(iree_loop_drain(loop, iree_infinite_timeout()));
+  EXPECT_EQ(any_count.load(), 1);
+  EXPECT_EQ(all_count.load(), 1);
+  IREE_EXPECT_OK(scope_status);
+
+  iree_loop_epoll_scope_free(scope);
+  for (auto& event : events) iree_event_deinitialize(&event);
+}
+
+// Tests that timers fire in deadline order and those within the slack window
+// of each other are retired together.
+TEST_P(LoopEpollTest, Timers) {
+  iree_status_t scope_status = iree_ok_status();
+  iree_loop_epoll_scope_t* scope = AllocateScope(&scope_status);
+  iree_loop_t loop = iree_loop_epoll_scope(scope);
+
+  struct Timer {
+    iree_time_t deadline_ns;
+    iree_time_t fired_ns;
+  };
+  static constexpr int kTimerCount = 32;
+  std::vector<Timer> timers(kTimerCount);
+  const iree_time_t start_ns = iree_time_now();
+  for (int i = 0; i < kTimerCount; ++i) {
+    // Shuffle the enqueue order to exercise the heap.
+    int delay_ms = 5 + ((i * 7) % kTimerCount);
+    timers[i].deadline_ns = start_ns + delay_ms * 1000000ll;
+    timers[i].fired_ns = 0;
+    IREE_ASSERT_OK(iree_loop_wait_until(
+        loop, iree_make_deadline(timers[i].deadline_ns),
+        +[](void* user_data, iree_loop_t loop, iree_status_t status) {
+          IREE_EXPECT_OK(status);
+          reinterpret_cast<Timer*>(user_data)->fired_ns = iree_time_now();
+          return iree_ok_status();
+        },
+        &timers[i]));
+  }
+  IREE_ASSERT_OK(iree_loop_drain(loop, iree_infinite_timeout()));
+
+  for (const auto& timer : timers) {
+    // No timer may fire before its deadline minus the slack window.
+    EXPECT_GE(timer.fired_ns, timer.deadline_ns - 1000000);
+  }
+  IREE_EXPECT_OK(scope_status);
+  iree_loop_epoll_scope_free(scope);
+}
+
+// Tests that operations submitted concurrently from many threads all run.
+TEST_P(LoopEpollTest, CrossThreadSubmission) {
+  iree_status_t scope_status = iree_ok_status();
+  iree_loop_epoll_scope_t* scope = AllocateScope(&scope_status);
+  iree_loop_t loop = iree_loop_epoll_scope(scope);
+
+  static constexpr int kThreadCount = 4;
+  static constexpr int kCallsPerThread = 500;
+  std::atomic<int> call_count{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreadCount; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < kCallsPerThread; ++i) {
+        IREE_EXPECT_OK(iree_loop_call(
+            loop, IREE_LOOP_PRIORITY_DEFAULT,
+            +[](void* user_data, iree_loop_t loop, iree_status_t status) {
+              IREE_EXPECT_OK(status);
+              ++*reinterpret_cast<std::atomic<int>*>(user_data);
+              return iree_ok_status();
+            },
+            &call_count));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  IREE_ASSERT_OK(iree_loop_drain(loop, iree_infinite_timeout()));
+  EXPECT_EQ(call_count.load(), kThreadCount * kCallsPerThread);
+  IREE_EXPECT_OK(scope_status);
+  iree_loop_epoll_scope_free(scope);
+}
+
+// Tests that a failure in one scope aborts only that scope's operations.
+TEST_P(LoopEpollTest, ScopeIsolation) {
+  iree_status_t failing_status = iree_ok_status();
+  iree_loop_epoll_scope_t* failing_scope = AllocateScope(&failing_status);
+  iree_status_t healthy_status = iree_ok_status();
+  iree_loop_epoll_scope_t* healthy_scope = AllocateScope(&healthy_status);
+
+  struct UserData {
+    std::atomic<bool> did_abort{false};
+    std::atomic<bool> did_wait{false};
+  } user_data;
+  auto wait_callback = +[](void* user_data_ptr, iree_loop_t loop,
+                           iree_status_t status) {
+    auto* user_data = reinterpret_cast<UserData*>(user_data_ptr);
+    if (iree_status_is_aborted(status)) {
+      user_data->did_abort = true;
+    } else {
+      IREE_EXPECT_OK(status);
+      user_data->did_wait = true;
+    }
+    iree_status_ignore(status);
+    return iree_ok_status();
+  };
+  IREE_ASSERT_OK(iree_loop_wait_until(iree_loop_epoll_scope(failing_scope),
+                                      iree_make_timeout_ms(60 * 1000),
+                                      wait_callback, &user_data));
+  IREE_ASSERT_OK(iree_loop_wait_until(iree_loop_epoll_scope(healthy_scope),
+                                      iree_make_timeout_ms(20), wait_callback,
+                                      &user_data));
+  IREE_ASSERT_OK(iree_loop_call(
+      iree_loop_epoll_scope(failing_scope), IREE_LOOP_PRIORITY_DEFAULT,
+      +[](void* user_data, iree_loop_t loop, iree_status_t status) {
+        return iree_make_status(IREE_STATUS_DATA_LOSS);
+      },
+      NULL));
+
+  IREE_ASSERT_OK(iree_loop_epoll_wait_idle(loop_epoll_,
+                                           iree_make_timeout_ms(10 * 1000)));
+  EXPECT_TRUE(user_data.did_abort);
+  EXPECT_TRUE(user_data.did_wait);
+  IREE_EXPECT_STATUS_IS(IREE_STATUS_DATA_LOSS, failing_status);
+  IREE_EXPECT_OK(healthy_status);
+
+  // Work enqueued into a failed scope is aborted.
+  user_data.did_abort = false;
+  IREE_ASSERT_OK(iree_loop_wait_until(iree_loop_epoll_scope(failing_scope),
+                                      iree_make_timeout_ms(60 * 1000),
+                                      wait_callback, &user_data));
+  IREE_ASSERT_OK(iree_loop_drain(iree_loop_epoll_scope(failing_scope),
+                                 iree_infinite_timeout()));
+  EXPECT_TRUE(user_data.did_abort);
+
+  iree_loop_epoll_scope_free(failing_scope);
+  iree_loop_epoll_scope_free(healthy_scope);
+  iree_status_ignore(failing_status);
+}
+
+// Tests that freeing a scope aborts its pending waits.
+TEST_P(LoopEpollTest, ScopeFreeAbortsPending) {
+  iree_status_t scope_status = iree_ok_status();
+  iree_loop_epoll_scope_t* scope = AllocateScope(&scope_status);
+  iree_event_t event;
+  IREE_ASSERT_OK(iree_event_initialize(/*initial_state=*/false, &event));
+  bool did_abort = false;
+  IREE_ASSERT_OK(iree_loop_wait_one(
+      iree_loop_epoll_scope(scope), iree_event_await(&event),
+      iree_infinite_timeout(),
+      +[](void* user_data, iree_loop_t loop, iree_status_t status) {
+        IREE_EXPECT_STATUS_IS(IREE_STATUS_ABORTED, status);
+        iree_status_ignore(status);
+        *reinterpret_cast<bool*>(user_data) = true;
+        return iree_ok_status();
+      },
+      &did_abort));
+  iree_loop_epoll_scope_free(scope);
+  EXPECT_TRUE(did_abort);
+  iree_event_deinitialize(&event);
+}
+
+INSTANTIATE_TEST_SUITE_P(Workers, LoopEpollTest, ::testing::Values(0, 1, 4));
+
+}  // namespace
+}  // namespace iree
+
+#endif  // IREE_PLATFORM_LINUX
@@ -136,5 +136,73 @@ TEST_F(DynamicLibraryTest, GetSymbolFailure) {
   iree_dynamic_library_release(library);
 }
 
+static iree_const_byte_span_t GetEmbeddedLibraryContents() {
+  const struct iree_file_toc_t* file_toc =
+      dynamic_library_test_library_create();
+  return iree_make_const_byte_span(file_toc->data, file_toc->size);
+}
+
+TEST_F(DynamicLibraryTest, LoadFromMemory) {
+  iree_dynamic_library_t* library = NULL;
+  IREE_ASSERT_OK(iree_dynamic_library_load_from_memory(
+      iree_make_cstring_view("test"), GetEmbeddedLibraryContents(),
+      IREE_DYNAMIC_LIBRARY_FLAG_NONE, iree_allocator_system(), &library));
+
+  int (*fn_ptr)(int);
+  IREE_ASSERT_OK(iree_dynamic_library_lookup_symbol(library, "times_two",
+                                                    (void**)&fn_ptr));
+  ASSERT_NE(nullptr, fn_ptr);
+  EXPECT_EQ(246, fn_ptr(123));
+
+  iree_dynamic_library_release(library);
+}
+
+TEST_F(DynamicLibraryTest, LoadFromMemoryDeduplicated) {
+  iree_dynamic_library_t* library1 = NULL;
+  iree_dynamic_library_t* library2 = NULL;
+  IREE_ASSERT_OK(iree_dynamic_library_load_from_memory(
+      iree_make_cstring_view("test"), GetEmbeddedLibraryContents(),
+      IREE_DYNAMIC_LIBRARY_FLAG_DEDUPLICATE, iree_allocator_system(),
+      &library1));
+  IREE_ASSERT_OK(iree_dynamic_library_load_from_memory(
+      iree_make_cstring_view("test"), GetEmbeddedLibraryContents(),
+      IREE_DYNAMIC_LIBRARY_FLAG_DEDUPLICATE, iree_allocator_system(),
+      &library2));
+#if defined(IREE_PLATFORM_LINUX)
+  // Deduplication is best-effort but always available on Linux.
+  EXPECT_EQ(library1, library2);
+#endif  // IREE_PLATFORM_LINUX
+
+  // The shared library must remain usable until the last reference is gone.
+  iree_dynamic_library_release(library1);
+  int (*fn_ptr)(int);
+  IREE_ASSERT_OK(iree_dynamic_library_lookup_symbol(library2, "times_two",
+                                                    (void**)&fn_ptr));
+  EXPECT_EQ(246, fn_ptr(123));
+  iree_dynamic_library_release(library2);
+
+  // Loading again after all references were released creates a new instance.
+  iree_dynamic_library_t* library3 = NULL;
+  IREE_ASSERT_OK(iree_dynamic_library_load_from_memory(
+      iree_make_cstring_view("test"), GetEmbeddedLibraryContents(),
+      IREE_DYNAMIC_LIBRARY_FLAG_DEDUPLICATE, iree_allocator_system(),
+      &library3));
+  iree_dynamic_library_release(library3);
+}
+
+TEST_F(DynamicLibraryTest, LoadFromMemoryNotDeduplicated) {
+  iree_dynamic_library_t* library1 = NULL;
+  iree_dynamic_library_t* library2 = NULL;
+  IREE_ASSERT_OK(iree_dynamic_library_load_from_memory(
+      iree_make_cstring_view("test"), GetEmbeddedLibraryContents(),
+      IREE_DYNAMIC_LIBRARY_FLAG_NONE, iree_allocator_system(), &library1));
+  IREE_ASSERT_OK(iree_dynamic_library_load_from_memory(
+      iree_make_cstring_view("test"), GetEmbeddedLibraryContents(),
+      IREE_DYNAMIC_LIBRARY_FLAG_NONE, iree_allocator_system(), &library2));
+  EXPECT_NE(library1, library2);
+  iree_dynamic_library_release(library1);
+  iree_dynamic_library_release(library2);
+}
+
 }  // namespace
 }  // namespace iree
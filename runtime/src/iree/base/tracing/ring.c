@@ -0,0 +1,756 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <stdio.h>
+#include <string.h>
+
+#include "iree/base/alignment.h"
+#include "iree/base/internal/atomics.h"
+#include "iree/base/internal/time.h"
+#include "iree/base/tracing.h"
+
+#if defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_APPLE) || \
+    defined(IREE_PLATFORM_LINUX)
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#define IREE_TRACING_RING_POSIX 1
+#else
+#define IREE_TRACING_RING_POSIX 0
+#endif  // IREE_PLATFORM_*
+
+// NOTE: threading support is optional.
+#if IREE_SYNCHRONIZATION_DISABLE_UNSAFE
+
+#define iree_thread_local static
+#define iree_thread_id() 0
+
+#else
+
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201102L) && \
+    !__STDC_NO_THREADS__
+#define iree_thread_local _Thread_local
+#elif defined(IREE_COMPILER_MSVC)
+#define iree_thread_local __declspec(thread)
+#else
+#define iree_thread_local
+#endif  // __STDC_NO_THREADS__
+
+#if defined(IREE_PLATFORM_ANDROID)
+#define iree_thread_id() ((uint64_t)gettid())
+#elif defined(IREE_PLATFORM_APPLE)
+#include <pthread.h>
+#define iree_thread_id() ((uint64_t)pthread_mach_thread_np(pthread_self()))
+#elif defined(IREE_PLATFORM_LINUX)
+#include <sys/syscall.h>
+#define iree_thread_id() ((uint64_t)syscall(__NR_gettid))
+#elif defined(IREE_PLATFORM_WINDOWS)
+#define iree_thread_id() ((uint64_t)GetCurrentThreadId())
+#else
+#define iree_thread_id() 0
+#endif  // IREE_PLATFORM_*
+
+#endif  // IREE_SYNCHRONIZATION_DISABLE_UNSAFE
+
+// Thread exit is observed with a pthread key destructor so that the ring of an
+// exited thread can be reused. Elsewhere rings are retained for the process
+// lifetime.
+#if IREE_TRACING_RING_POSIX && !IREE_SYNCHRONIZATION_DISABLE_UNSAFE
+#include <pthread.h>
+#define IREE_TRACING_RING_THREAD_EXIT 1
+#else
+#define IREE_TRACING_RING_THREAD_EXIT 0
+#endif  // IREE_TRACING_RING_POSIX && !IREE_SYNCHRONIZATION_DISABLE_UNSAFE
+
+#if IREE_TRACING_FEATURES
+
+static_assert((IREE_TRACING_RING_CAPACITY & (IREE_TRACING_RING_CAPACITY - 1)) ==
+                  0,
+              "ring capacity must be a power of two");
+static_assert(sizeof(iree_tracing_ring_event_t) == 24, "packed event");
+
+//===----------------------------------------------------------------------===//
+// Global state
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_tracing_ring_thread_t {
+  // Next thread in the global list. Rings are never removed so that flushes
+  // (including those in signal handlers) can walk the list without locking.
+  // Rings of exited threads are instead reused by new threads and their events
+  // can be flushed until then.
+  struct iree_tracing_ring_thread_t* next;
+  // 1 while owned by a live thread.
+  iree_atomic_int32_t in_use;
+  uint64_t thread_id;
+  char name[32];
+  // Index of the first event recorded by the current owner. Events before it
+  // were recorded by a prior owner and are not flushed.
+  iree_atomic_int64_t base_index;
+  // Total number of events ever recorded into the ring. Only the owning thread
+  // writes this and the event slots; flushes read them.
+  iree_atomic_int64_t write_index;
+  iree_tracing_ring_event_t events[IREE_TRACING_RING_CAPACITY];
+} iree_tracing_ring_thread_t;
+
+// Open addressing table size for the string lookup; must be a power of two
+// larger than IREE_TRACING_RING_MAX_STRINGS.
+#define IREE_TRACING_RING_STRING_SLOTS (IREE_TRACING_RING_MAX_STRINGS * 2)
+static_assert((IREE_TRACING_RING_STRING_SLOTS &
+               (IREE_TRACING_RING_STRING_SLOTS - 1)) == 0,
+              "string slot count must be a power of two");
+
+typedef struct iree_tracing_ring_t {
+  // iree_tracing_ring_thread_t* list head.
+  iree_atomic_intptr_t threads;
+
+  // Interned strings. Lookups are lock-free and inserts are serialized by
+  // |string_lock|. String ID N (1-based) is stored at index N - 1.
+  iree_atomic_int32_t string_lock;
+  iree_atomic_int32_t string_count;
+  iree_atomic_int32_t string_slots[IREE_TRACING_RING_STRING_SLOTS];
+  uint32_t string_hashes[IREE_TRACING_RING_MAX_STRINGS];
+  uint32_t string_offsets[IREE_TRACING_RING_MAX_STRINGS];
+  uint32_t string_lengths[IREE_TRACING_RING_MAX_STRINGS];
+  uint32_t string_storage_used;
+  char string_storage[IREE_TRACING_RING_STRING_STORAGE];
+  // Strings that could not be interned as the table was full.
+  iree_atomic_int32_t string_overflow_count;
+  // Dynamic texts truncated to IREE_TRACING_RING_MAX_INLINE_TEXT.
+  iree_atomic_int32_t text_truncation_count;
+
+#if IREE_TRACING_RING_THREAD_EXIT
+  // Key whose destructor releases the ring of an exiting thread.
+  pthread_key_t thread_key;
+  bool thread_key_created;
+#endif  // IREE_TRACING_RING_THREAD_EXIT
+
+  // Set while a flush is in progress; flushes don't nest or overlap.
+  iree_atomic_int32_t flushing;
+  // Events copied out of a thread ring during a flush. Static so that flushes
+  // don't allocate and can run in signal handlers.
+  iree_tracing_ring_event_t flush_events[IREE_TRACING_RING_CAPACITY];
+
+  // File flushed to by the signal handler and on exit.
+  char flush_path[256];
+  // True if IREE_TRACING_RING_FILE was set and a flush should happen on exit.
+  bool flush_on_exit;
+#if IREE_TRACING_RING_POSIX && IREE_TRACING_RING_SIGNAL
+  bool signal_installed;
+  struct sigaction previous_action;
+#endif  // IREE_TRACING_RING_POSIX && IREE_TRACING_RING_SIGNAL
+} iree_tracing_ring_t;
+
+// Global shared ring tracing context. Like the other tracing providers there is
+// a single instance per process so that recording needs no context.
+static iree_tracing_ring_t _ring = {0};
+
+// Ring of the calling thread or NULL if not yet allocated.
+static iree_thread_local iree_tracing_ring_thread_t* _thread = NULL;
+
+#if IREE_TRACING_RING_THREAD_EXIT
+static pthread_once_t _ring_thread_key_once = PTHREAD_ONCE_INIT;
+#endif  // IREE_TRACING_RING_THREAD_EXIT
+
+//===----------------------------------------------------------------------===//
+// String interning
+//===----------------------------------------------------------------------===//
+
+static uint32_t iree_tracing_ring_hash(const char* value, size_t length) {
+  // FNV-1a; never returns 0 so that it can't be confused with an empty slot.
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= (uint8_t)value[i];
+    hash *= 16777619u;
+  }
+  return hash | 1;
+}
+
+// Returns the ID of the string or 0 if not found. |out_slot| receives the
+// first empty slot in the probe sequence.
+static uint32_t iree_tracing_ring_lookup_string(const char* value,
+                                                size_t length, uint32_t hash,
+                                                uint32_t* out_slot) {
+  uint32_t slot = hash & (IREE_TRACING_RING_STRING_SLOTS - 1);
+  for (;;) {
+    int32_t id = iree_atomic_load(&_ring.string_slots[slot],
+                                  iree_memory_order_acquire);
+    if (!id) break;
+    uint32_t index = (uint32_t)id - 1;
+    if (_ring.string_hashes[index] == hash &&
+        _ring.string_lengths[index] == length &&
+        memcmp(_ring.string_storage + _ring.string_offsets[index], value,
+               length) == 0) {
+      return (uint32_t)id;
+    }
+    slot = (slot + 1) & (IREE_TRACING_RING_STRING_SLOTS - 1);
+  }
+  *out_slot = slot;
+  return 0;
+}
+
+// Interns |value| and returns its ID. Returns 0 (the empty string) if |value|
+// is empty or the string table is full. Only static strings are interned so
+// that the table is bounded by the number of call sites; dynamic text is
+// recorded inline with iree_tracing_ring_record_text instead.
+static uint32_t iree_tracing_ring_intern(const char* value, size_t length) {
+  if (!value || !length) return 0;
+  uint32_t hash = iree_tracing_ring_hash(value, length);
+  uint32_t slot = 0;
+  uint32_t id = iree_tracing_ring_lookup_string(value, length, hash, &slot);
+  if (IREE_LIKELY(id)) return id;
+
+  // Not found: insert under the lock. Inserts are rare (once per unique
+  // string) so a spin lock is sufficient.
+  int32_t expected = 0;
+  while (!iree_atomic_compare_exchange_weak(
+      &_ring.string_lock, &expected, 1, iree_memory_order_acquire,
+      iree_memory_order_relaxed)) {
+    expected = 0;
+  }
+  id = iree_tracing_ring_lookup_string(value, length, hash, &slot);
+  int32_t count =
+      iree_atomic_load(&_ring.string_count, iree_memory_order_relaxed);
+  if (!id && count < IREE_TRACING_RING_MAX_STRINGS &&
+      length <= IREE_TRACING_RING_STRING_STORAGE - _ring.string_storage_used) {
+    _ring.string_hashes[count] = hash;
+    _ring.string_offsets[count] = _ring.string_storage_used;
+    _ring.string_lengths[count] = (uint32_t)length;
+    memcpy(_ring.string_storage + _ring.string_storage_used, value, length);
+    _ring.string_storage_used += (uint32_t)length;
+    id = (uint32_t)count + 1;
+    iree_atomic_store(&_ring.string_count, count + 1,
+                      iree_memory_order_release);
+    iree_atomic_store(&_ring.string_slots[slot], (int32_t)id,
+                      iree_memory_order_release);
+  } else if (!id) {
+    iree_atomic_fetch_add(&_ring.string_overflow_count, 1,
+                          iree_memory_order_relaxed);
+  }
+  iree_atomic_store(&_ring.string_lock, 0, iree_memory_order_release);
+  return id;
+}
+
+//===----------------------------------------------------------------------===//
+// Recording
+//===----------------------------------------------------------------------===//
+
+#if IREE_TRACING_RING_THREAD_EXIT
+// Releases the ring of an exiting thread so that a new thread can reuse it.
+static void iree_tracing_ring_thread_exit(void* value) {
+  iree_tracing_ring_thread_t* thread = (iree_tracing_ring_thread_t*)value;
+  // Events recorded by destructors that run after this one acquire a new ring
+  // and re-register the key.
+  _thread = NULL;
+  iree_atomic_store(&thread->in_use, 0, iree_memory_order_release);
+}
+
+static void iree_tracing_ring_create_thread_key(void) {
+  _ring.thread_key_created = pthread_key_create(
+                                 &_ring.thread_key,
+                                 iree_tracing_ring_thread_exit) == 0;
+}
+#endif  // IREE_TRACING_RING_THREAD_EXIT
+
+// Acquires a ring for the calling thread, reusing the ring of an exited thread
+// if possible.
+static iree_tracing_ring_thread_t* iree_tracing_ring_thread_acquire(void) {
+  iree_tracing_ring_thread_t* thread = NULL;
+  for (iree_tracing_ring_thread_t* it = (iree_tracing_ring_thread_t*)
+           iree_atomic_load(&_ring.threads, iree_memory_order_acquire);
+       it; it = it->next) {
+    int32_t expected = 0;
+    if (iree_atomic_compare_exchange_strong(&it->in_use, &expected, 1,
+                                            iree_memory_order_acquire,
+                                            iree_memory_order_relaxed)) {
+      thread = it;
+      break;
+    }
+  }
+  if (thread) {
+    // Hide the events of the prior owner before relabeling the ring.
+    iree_atomic_store(
+        &thread->base_index,
+        iree_atomic_load(&thread->write_index, iree_memory_order_relaxed),
+        iree_memory_order_release);
+    thread->thread_id = iree_thread_id();
+    memset(thread->name, 0, sizeof(thread->name));
+  } else {
+    thread = (iree_tracing_ring_thread_t*)malloc(sizeof(*thread));
+    if (!thread) return NULL;
+    // Event storage is left uninitialized; only written slots are ever read.
+    iree_atomic_store(&thread->in_use, 1, iree_memory_order_relaxed);
+    thread->thread_id = iree_thread_id();
+    memset(thread->name, 0, sizeof(thread->name));
+    iree_atomic_store(&thread->base_index, 0, iree_memory_order_relaxed);
+    iree_atomic_store(&thread->write_index, 0, iree_memory_order_relaxed);
+    intptr_t head = iree_atomic_load(&_ring.threads, iree_memory_order_relaxed);
+    do {
+      thread->next = (iree_tracing_ring_thread_t*)head;
+    } while (!iree_atomic_compare_exchange_weak(
+        &_ring.threads, &head, (intptr_t)thread, iree_memory_order_release,
+        iree_memory_order_relaxed));
+  }
+
+#if IREE_TRACING_RING_THREAD_EXIT
+  pthread_once(&_ring_thread_key_once, iree_tracing_ring_create_thread_key);
+  if (_ring.thread_key_created) {
+    pthread_setspecific(_ring.thread_key, thread);
+  }
+#endif  // IREE_TRACING_RING_THREAD_EXIT
+  return thread;
+}
+
+static inline iree_tracing_ring_thread_t* iree_tracing_ring_thread(void) {
+  iree_tracing_ring_thread_t* thread = _thread;
+  if (IREE_UNLIKELY(!thread)) {
+    thread = _thread = iree_tracing_ring_thread_acquire();
+  }
+  return thread;
+}
+
+static inline void iree_tracing_ring_store_event(
+    iree_tracing_ring_thread_t* thread, int64_t index, uint64_t timestamp_ns,
+    iree_tracing_ring_event_type_t type, uint32_t string_id, uint64_t value) {
+  iree_tracing_ring_event_t* event =
+      &thread->events[index & (IREE_TRACING_RING_CAPACITY - 1)];
+  event->timestamp_ns = timestamp_ns;
+  event->value = value;
+  event->string_id = string_id;
+  event->type = type;
+}
+
+static void iree_tracing_ring_record(iree_tracing_ring_event_type_t type,
+                                     uint32_t string_id, uint64_t value) {
+  iree_tracing_ring_thread_t* thread = iree_tracing_ring_thread();
+  if (IREE_UNLIKELY(!thread)) return;
+  int64_t index =
+      iree_atomic_load(&thread->write_index, iree_memory_order_relaxed);
+  iree_tracing_ring_store_event(thread, index,
+                                (uint64_t)iree_platform_time_now(), type,
+                                string_id, value);
+  iree_atomic_store(&thread->write_index, index + 1,
+                    iree_memory_order_release);
+}
+
+// Appends |length| bytes of |value| to |buffer| of |*buffer_length| bytes
+// filled so far, truncating to IREE_TRACING_RING_MAX_INLINE_TEXT bytes.
+// Returns false if truncated.
+static bool iree_tracing_ring_append_text(char* buffer, size_t* buffer_length,
+                                          const char* value, size_t length) {
+  size_t available = IREE_TRACING_RING_MAX_INLINE_TEXT - *buffer_length;
+  size_t copy_length = iree_min(length, available);
+  if (copy_length) memcpy(buffer + *buffer_length, value, copy_length);
+  *buffer_length += copy_length;
+  return copy_length == length;
+}
+
+// Records an event followed by IREE_TRACING_RING_EVENT_TEXT events holding
+// |text|. The events are published together so flushes never observe the
+// event without its text.
+static void iree_tracing_ring_record_text(iree_tracing_ring_event_type_t type,
+                                          uint64_t value, const char* text,
+                                          size_t text_length) {
+  iree_tracing_ring_thread_t* thread = iree_tracing_ring_thread();
+  if (IREE_UNLIKELY(!thread)) return;
+  int64_t index =
+      iree_atomic_load(&thread->write_index, iree_memory_order_relaxed);
+  uint64_t timestamp_ns = (uint64_t)iree_platform_time_now();
+  iree_tracing_ring_store_event(thread, index++, timestamp_ns, type, 0, value);
+  for (size_t offset = 0; offset < text_length; offset += 12) {
+    char chunk[12] = {0};
+    memcpy(chunk, text + offset, iree_min(sizeof(chunk), text_length - offset));
+    uint64_t chunk_value = 0;
+    uint32_t chunk_string_id = 0;
+    memcpy(&chunk_value, chunk, sizeof(chunk_value));
+    memcpy(&chunk_string_id, chunk + sizeof(chunk_value),
+           sizeof(chunk_string_id));
+    iree_tracing_ring_store_event(thread, index++, timestamp_ns,
+                                  IREE_TRACING_RING_EVENT_TEXT,
+                                  chunk_string_id, chunk_value);
+  }
+  iree_atomic_store(&thread->write_index, index, iree_memory_order_release);
+}
+
+// Records an event with the dynamic text |value|.
+static void iree_tracing_ring_record_dynamic(
+    iree_tracing_ring_event_type_t type, uint64_t event_value,
+    const char* value, size_t length) {
+  char text[IREE_TRACING_RING_MAX_INLINE_TEXT];
+  size_t text_length = 0;
+  if (!iree_tracing_ring_append_text(text, &text_length, value, length)) {
+    iree_atomic_fetch_add(&_ring.text_truncation_count, 1,
+                          iree_memory_order_relaxed);
+  }
+  iree_tracing_ring_record_text(type, event_value, text, text_length);
+}
+
+void iree_tracing_set_thread_name(const char* name) {
+  iree_tracing_ring_thread_t* thread = iree_tracing_ring_thread();
+  if (!thread) return;
+  size_t length = iree_min(strlen(name), sizeof(thread->name) - 1);
+  memcpy(thread->name, name, length);
+  thread->name[length] = 0;
+}
+
+// Interns the strings of |src_loc| and caches their IDs in the location. Races
+// between threads are benign as they all store the same IDs.
+static uint32_t iree_tracing_ring_location_name_id(
+    iree_tracing_location_t* src_loc) {
+  uint32_t name_id = src_loc->name_id;
+  if (IREE_UNLIKELY(!name_id)) {
+    name_id = src_loc->name
+                  ? iree_tracing_ring_intern(src_loc->name,
+                                             src_loc->name_length)
+                  : iree_tracing_ring_intern(src_loc->function_name,
+                                             src_loc->function_name_length);
+    src_loc->name_id = name_id;
+  }
+  return name_id;
+}
+static uint32_t iree_tracing_ring_location_file_id(
+    iree_tracing_location_t* src_loc) {
+  uint32_t file_id = src_loc->file_id;
+  if (IREE_UNLIKELY(!file_id)) {
+    file_id =
+        iree_tracing_ring_intern(src_loc->file_name, src_loc->file_name_length);
+    src_loc->file_id = file_id;
+  }
+  return file_id;
+}
+
+IREE_MUST_USE_RESULT iree_zone_id_t
+iree_tracing_zone_begin_impl(iree_tracing_location_t* src_loc,
+                             const char* name, size_t name_length) {
+  uint32_t file_id = iree_tracing_ring_location_file_id(src_loc);
+  uint64_t value = ((uint64_t)file_id << 32) | src_loc->line;
+  if (name) {
+    iree_tracing_ring_record_dynamic(IREE_TRACING_RING_EVENT_ZONE_BEGIN, value,
+                                     name, name_length);
+  } else {
+    iree_tracing_ring_record(IREE_TRACING_RING_EVENT_ZONE_BEGIN,
+                             iree_tracing_ring_location_name_id(src_loc),
+                             value);
+  }
+  return 1;
+}
+
+IREE_MUST_USE_RESULT iree_zone_id_t iree_tracing_zone_begin_external_impl(
+    const char* file_name, size_t file_name_length, uint32_t line,
+    const char* function_name, size_t function_name_length, const char* name,
+    size_t name_length) {
+  // External locations come from loaded programs and are recorded inline as
+  // the zone name, a NUL, and the file name.
+  char text[IREE_TRACING_RING_MAX_INLINE_TEXT];
+  size_t text_length = 0;
+  bool complete = name ? iree_tracing_ring_append_text(text, &text_length,
+                                                       name, name_length)
+                       : iree_tracing_ring_append_text(
+                             text, &text_length, function_name,
+                             function_name_length);
+  if (complete && file_name_length) {
+    complete = iree_tracing_ring_append_text(text, &text_length, "", 1) &&
+               iree_tracing_ring_append_text(text, &text_length, file_name,
+                                             file_name_length);
+  }
+  if (!complete) {
+    iree_atomic_fetch_add(&_ring.text_truncation_count, 1,
+                          iree_memory_order_relaxed);
+  }
+  iree_tracing_ring_record_text(IREE_TRACING_RING_EVENT_ZONE_BEGIN, line, text,
+                                text_length);
+  return 1;
+}
+
+void iree_tracing_zone_end(iree_zone_id_t zone_id) {
+  if (!zone_id) return;
+  iree_tracing_ring_record(IREE_TRACING_RING_EVENT_ZONE_END, 0, 0);
+}
+
+void iree_tracing_zone_append_value_i64(iree_zone_id_t zone_id,
+                                        int64_t value) {
+  if (!zone_id) return;
+  iree_tracing_ring_record(IREE_TRACING_RING_EVENT_ZONE_VALUE, 0,
+                           (uint64_t)value);
+}
+
+void iree_tracing_zone_append_text_string_view(iree_zone_id_t zone_id,
+                                               const char* value,
+                                               size_t value_length) {
+  if (!zone_id) return;
+  iree_tracing_ring_record_dynamic(IREE_TRACING_RING_EVENT_ZONE_TEXT, 0, value,
+                                   value_length);
+}
+
+void iree_tracing_zone_append_text_cstring(iree_zone_id_t zone_id,
+                                           const char* value) {
+  iree_tracing_zone_append_text_string_view(zone_id, value, strlen(value));
+}
+
+void iree_tracing_plot_value_i64(const char* name, int64_t value) {
+  iree_tracing_ring_record(IREE_TRACING_RING_EVENT_PLOT_I64,
+                           iree_tracing_ring_intern(name, strlen(name)),
+                           (uint64_t)value);
+}
+
+void iree_tracing_plot_value_f64(const char* name, double value) {
+  uint64_t bits = 0;
+  memcpy(&bits, &value, sizeof(bits));
+  iree_tracing_ring_record(IREE_TRACING_RING_EVENT_PLOT_F64,
+                           iree_tracing_ring_intern(name, strlen(name)), bits);
+}
+
+void iree_tracing_frame_mark(uint32_t type, const char* name) {
+  iree_tracing_ring_record(
+      (iree_tracing_ring_event_type_t)type,
+      name ? iree_tracing_ring_intern(name, strlen(name)) : 0, 0);
+}
+
+// Only used with literals by IREE_TRACE_MESSAGE and IREE_TRACE_MESSAGE_COLORED.
+void iree_tracing_message_cstring(const char* value, uint32_t color) {
+  iree_tracing_ring_record(IREE_TRACING_RING_EVENT_MESSAGE,
+                           iree_tracing_ring_intern(value, strlen(value)),
+                           color);
+}
+
+void iree_tracing_message_string_view(const char* value, size_t value_length,
+                                      uint32_t color) {
+  iree_tracing_ring_record_dynamic(IREE_TRACING_RING_EVENT_MESSAGE, color,
+                                   value, value_length);
+}
+
+//===----------------------------------------------------------------------===//
+// Flushing
+//===----------------------------------------------------------------------===//
+
+// Minimal file writer. On POSIX this only uses async-signal-safe calls.
+typedef struct iree_tracing_ring_writer_t {
+#if IREE_TRACING_RING_POSIX
+  int fd;
+#else
+  FILE* file;
+#endif  // IREE_TRACING_RING_POSIX
+  bool ok;
+} iree_tracing_ring_writer_t;
+
+static bool iree_tracing_ring_writer_open(const char* path,
+                                          iree_tracing_ring_writer_t* writer) {
+#if IREE_TRACING_RING_POSIX
+  writer->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  writer->ok = writer->fd >= 0;
+#else
+  writer->file = fopen(path, "wb");
+  writer->ok = writer->file != NULL;
+#endif  // IREE_TRACING_RING_POSIX
+  return writer->ok;
+}
+
+static void iree_tracing_ring_writer_write(iree_tracing_ring_writer_t* writer,
+                                           const void* data, size_t length) {
+  if (!writer->ok) return;
+#if IREE_TRACING_RING_POSIX
+  const uint8_t* bytes = (const uint8_t*)data;
+  while (length > 0) {
+    ssize_t written = write(writer->fd, bytes, length);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      writer->ok = false;
+      return;
+    }
+    bytes += written;
+    length -= (size_t)written;
+  }
+#else
+  writer->ok = fwrite(data, 1, length, writer->file) == length;
+#endif  // IREE_TRACING_RING_POSIX
+}
+
+static bool iree_tracing_ring_writer_close(iree_tracing_ring_writer_t* writer) {
+#if IREE_TRACING_RING_POSIX
+  if (writer->fd >= 0 && close(writer->fd) != 0) writer->ok = false;
+#else
+  if (writer->file && fclose(writer->file) != 0) writer->ok = false;
+#endif  // IREE_TRACING_RING_POSIX
+  return writer->ok;
+}
+
+// Copies the events of |thread| recorded at or after |start_timestamp_ns| into
+// the flush scratch storage and returns the count.
+static uint32_t iree_tracing_ring_snapshot_thread(
+    iree_tracing_ring_thread_t* thread, uint64_t start_timestamp_ns) {
+  int64_t end =
+      iree_atomic_load(&thread->write_index, iree_memory_order_acquire);
+  int64_t base =
+      iree_atomic_load(&thread->base_index, iree_memory_order_acquire);
+  int64_t begin = iree_max(base, end - IREE_TRACING_RING_CAPACITY);
+  for (int64_t i = begin; i < end; ++i) {
+    _ring.flush_events[i - begin] =
+        thread->events[i & (IREE_TRACING_RING_CAPACITY - 1)];
+  }
+
+  // Drop any events the owning thread may have overwritten while we were
+  // copying: with the write index now at |current| the slot for |current| may
+  // be in the process of being written and all slots before it since |end|
+  // have been.
+  iree_atomic_thread_fence(iree_memory_order_acquire);
+  int64_t current =
+      iree_atomic_load(&thread->write_index, iree_memory_order_relaxed);
+  int64_t valid_begin = current + 1 - IREE_TRACING_RING_CAPACITY;
+  int64_t skip = iree_max(0, valid_begin - begin);
+  if (skip >= end - begin) return 0;
+
+  // Events are recorded in time order per thread so the window is a suffix.
+  int64_t first = skip;
+  while (first < end - begin &&
+         _ring.flush_events[first].timestamp_ns < start_timestamp_ns) {
+    ++first;
+  }
+  uint32_t count = (uint32_t)(end - begin - first);
+  if (first > 0) {
+    memmove(_ring.flush_events, _ring.flush_events + first,
+            count * sizeof(iree_tracing_ring_event_t));
+  }
+  return count;
+}
+
+bool iree_tracing_ring_flush(const char* path, uint64_t window_ns) {
+  int32_t expected = 0;
+  if (!iree_atomic_compare_exchange_strong(&_ring.flushing, &expected, 1,
+                                           iree_memory_order_acquire,
+                                           iree_memory_order_relaxed)) {
+    return false;
+  }
+
+  uint64_t now_ns = (uint64_t)iree_platform_time_now();
+  uint64_t start_timestamp_ns = window_ns < now_ns ? now_ns - window_ns : 0;
+
+  iree_tracing_ring_writer_t writer;
+  if (!iree_tracing_ring_writer_open(path, &writer)) {
+    iree_atomic_store(&_ring.flushing, 0, iree_memory_order_release);
+    return false;
+  }
+
+  // Snapshot the list heads; threads added during the flush are ignored.
+  iree_tracing_ring_thread_t* threads = (iree_tracing_ring_thread_t*)
+      iree_atomic_load(&_ring.threads, iree_memory_order_acquire);
+  uint32_t thread_count = 0;
+  for (iree_tracing_ring_thread_t* thread = threads; thread;
+       thread = thread->next) {
+    ++thread_count;
+  }
+  int32_t string_count =
+      iree_atomic_load(&_ring.string_count, iree_memory_order_acquire);
+
+  iree_tracing_ring_file_header_t header = {
+      .magic = IREE_TRACING_RING_FILE_MAGIC,
+      .version = IREE_TRACING_RING_FILE_VERSION_0,
+      .flush_timestamp_ns = now_ns,
+      .string_count = (uint32_t)string_count + 1,
+      .thread_count = thread_count,
+      .string_overflow_count = (uint32_t)iree_atomic_load(
+          &_ring.string_overflow_count, iree_memory_order_relaxed),
+      .text_truncation_count = (uint32_t)iree_atomic_load(
+          &_ring.text_truncation_count, iree_memory_order_relaxed),
+  };
+  iree_tracing_ring_writer_write(&writer, &header, sizeof(header));
+
+  // String table, starting with the empty string ID 0.
+  static const uint8_t padding[4] = {0};
+  uint32_t empty_length = 0;
+  iree_tracing_ring_writer_write(&writer, &empty_length, sizeof(empty_length));
+  for (int32_t i = 0; i < string_count; ++i) {
+    uint32_t length = _ring.string_lengths[i];
+    iree_tracing_ring_writer_write(&writer, &length, sizeof(length));
+    iree_tracing_ring_writer_write(
+        &writer, _ring.string_storage + _ring.string_offsets[i], length);
+    iree_tracing_ring_writer_write(&writer, padding,
+                                   iree_host_align(length, 4) - length);
+  }
+
+  for (iree_tracing_ring_thread_t* thread = threads; thread;
+       thread = thread->next) {
+    iree_tracing_ring_file_thread_t thread_header;
+    memset(&thread_header, 0, sizeof(thread_header));
+    thread_header.thread_id = thread->thread_id;
+    memcpy(thread_header.name, thread->name, sizeof(thread_header.name) - 1);
+    thread_header.event_count =
+        iree_tracing_ring_snapshot_thread(thread, start_timestamp_ns);
+    iree_tracing_ring_writer_write(&writer, &thread_header,
+                                   sizeof(thread_header));
+    iree_tracing_ring_writer_write(
+        &writer, _ring.flush_events,
+        thread_header.event_count * sizeof(iree_tracing_ring_event_t));
+  }
+
+  bool ok = iree_tracing_ring_writer_close(&writer);
+  iree_atomic_store(&_ring.flushing, 0, iree_memory_order_release);
+  return ok;
+}
+
+//===----------------------------------------------------------------------===//
+// Initialization
+//===----------------------------------------------------------------------===//
+
+#if IREE_TRACING_RING_POSIX && IREE_TRACING_RING_SIGNAL
+static void iree_tracing_ring_signal_handler(int signal_number) {
+  int saved_errno = errno;
+  iree_tracing_ring_flush(_ring.flush_path, IREE_TRACING_RING_WINDOW_NS);
+  errno = saved_errno;
+}
+#endif  // IREE_TRACING_RING_POSIX && IREE_TRACING_RING_SIGNAL
+
+void iree_tracing_ring_initialize() {
+  const char* path = getenv("IREE_TRACING_RING_FILE");
+  _ring.flush_on_exit = path && path[0];
+  if (!_ring.flush_on_exit) path = "iree-trace.bin";
+  size_t path_length = iree_min(strlen(path), sizeof(_ring.flush_path) - 1);
+  memcpy(_ring.flush_path, path, path_length);
+  _ring.flush_path[path_length] = 0;
+
+#if IREE_TRACING_RING_POSIX && IREE_TRACING_RING_SIGNAL
+  if (!_ring.signal_installed) {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = iree_tracing_ring_signal_handler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    _ring.signal_installed = sigaction(IREE_TRACING_RING_SIGNAL, &action,
+                                       &_ring.previous_action) == 0;
+  }
+#endif  // IREE_TRACING_RING_POSIX && IREE_TRACING_RING_SIGNAL
+}
+
+void iree_tracing_ring_deinitialize() {
+#if IREE_TRACING_RING_POSIX && IREE_TRACING_RING_SIGNAL
+  if (_ring.signal_installed) {
+    sigaction(IREE_TRACING_RING_SIGNAL, &_ring.previous_action, NULL);
+    _ring.signal_installed = false;
+  }
+#endif  // IREE_TRACING_RING_POSIX && IREE_TRACING_RING_SIGNAL
+
+  if (_ring.flush_on_exit) {
+    if (!iree_tracing_ring_flush(_ring.flush_path,
+                                 IREE_TRACING_RING_WINDOW_NS)) {
+      fprintf(stderr, "failed to flush trace ring to '%s'\n",
+              _ring.flush_path);
+    }
+  }
+
+  int32_t string_overflow_count = iree_atomic_load(
+      &_ring.string_overflow_count, iree_memory_order_relaxed);
+  if (string_overflow_count > 0) {
+    fprintf(stderr,
+            "trace ring string table overflowed; %d strings were recorded as "
+            "empty (increase IREE_TRACING_RING_MAX_STRINGS or "
+            "IREE_TRACING_RING_STRING_STORAGE)\n",
+            string_overflow_count);
+  }
+
+  // Thread rings are intentionally not freed: other threads may still be
+  // recording or flushing and the memory is reclaimed on process exit.
+}
+
+#endif  // IREE_TRACING_FEATURES
@@ -0,0 +1,425 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Always-on binary ring buffer tracing.
+//
+// Each thread records fixed-size binary events (zones, plots, messages, and
+// frame marks) into its own ring buffer holding the most recent
+// IREE_TRACING_RING_CAPACITY events. Nothing is formatted or written while
+// recording: static strings (source locations, plot and frame names, and
+// literal messages) are interned into a global table once and events only
+// reference them by ID, so the per-event cost is a timestamp and a 24-byte
+// store. Dynamic text (dynamically named zones, appended zone text, and dynamic
+// messages) is copied inline into the ring following the event it belongs to.
+// Rings of exited threads are kept until a new thread reuses them so memory is
+// bounded by the peak number of live threads that recorded events.
+// Rings are only read when flushed to a file with
+// iree_tracing_ring_flush, by sending the process IREE_TRACING_RING_SIGNAL, or
+// on IREE_TRACE_APP_EXIT if the IREE_TRACING_RING_FILE environment variable is
+// set. The file contains the events of the last window of time and can be
+// converted to Chrome trace/Perfetto JSON with
+// tools/scripts/iree_trace_ring_to_json.py.
+//
+// The file format is:
+//   iree_tracing_ring_file_header_t
+//   string_count x (uint32_t length, length bytes, 0-3 bytes of padding)
+//   thread_count x (iree_tracing_ring_file_thread_t,
+//                   event_count x iree_tracing_ring_event_t)
+// All values are in host byte order and string IDs index the string table with
+// ID 0 being the empty string.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "iree/base/attributes.h"
+#include "iree/base/config.h"
+
+#ifndef IREE_BASE_TRACING_RING_H_
+#define IREE_BASE_TRACING_RING_H_
+
+//===----------------------------------------------------------------------===//
+// Ring tracing configuration
+//===----------------------------------------------------------------------===//
+
+// Filter to only supported features.
+#if !defined(IREE_TRACING_FEATURES)
+#define IREE_TRACING_FEATURES          \
+  ((IREE_TRACING_FEATURES_REQUESTED) & \
+   (IREE_TRACING_FEATURE_INSTRUMENTATION | IREE_TRACING_FEATURE_LOG_MESSAGES))
+#endif  // !IREE_TRACING_FEATURES
+
+// Number of events retained per thread. Must be a power of two.
+// Each event is 24 bytes and rings are allocated on the first event recorded
+// by each thread.
+#if !defined(IREE_TRACING_RING_CAPACITY)
+#define IREE_TRACING_RING_CAPACITY (16 * 1024)
+#endif  // !IREE_TRACING_RING_CAPACITY
+
+// Maximum number of unique interned static strings and their total storage
+// size. Strings beyond the limits are recorded as the empty string and counted
+// in the file header.
+#if !defined(IREE_TRACING_RING_MAX_STRINGS)
+#define IREE_TRACING_RING_MAX_STRINGS 4096
+#endif  // !IREE_TRACING_RING_MAX_STRINGS
+#if !defined(IREE_TRACING_RING_STRING_STORAGE)
+#define IREE_TRACING_RING_STRING_STORAGE (256 * 1024)
+#endif  // !IREE_TRACING_RING_STRING_STORAGE
+
+// Maximum number of bytes of dynamic text recorded inline with an event.
+// Longer text is truncated and counted in the file header.
+#if !defined(IREE_TRACING_RING_MAX_INLINE_TEXT)
+#define IREE_TRACING_RING_MAX_INLINE_TEXT 128
+#endif  // !IREE_TRACING_RING_MAX_INLINE_TEXT
+
+// Time window in nanoseconds flushed when triggered by signal or on exit.
+#if !defined(IREE_TRACING_RING_WINDOW_NS)
+#define IREE_TRACING_RING_WINDOW_NS (10ull * 1000000000ull)
+#endif  // !IREE_TRACING_RING_WINDOW_NS
+
+// Signal number that flushes the rings to the file named by the
+// IREE_TRACING_RING_FILE environment variable (or iree-trace.bin) when
+// received. 0 disables the handler. Only supported on POSIX platforms.
+#if !defined(IREE_TRACING_RING_SIGNAL)
+#if defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_APPLE) || \
+    defined(IREE_PLATFORM_LINUX)
+#include <signal.h>
+#define IREE_TRACING_RING_SIGNAL SIGUSR2
+#else
+#define IREE_TRACING_RING_SIGNAL 0
+#endif  // IREE_PLATFORM_*
+#endif  // !IREE_TRACING_RING_SIGNAL
+
+//===----------------------------------------------------------------------===//
+// File format
+//===----------------------------------------------------------------------===//
+
+#define IREE_TRACING_RING_FILE_MAGIC 0x52545249u  // 'IRTR'
+#define IREE_TRACING_RING_FILE_VERSION_0 0u
+
+typedef struct iree_tracing_ring_file_header_t {
+  uint32_t magic;
+  uint32_t version;
+  // Timestamp of the flush; all event timestamps are at most this value.
+  uint64_t flush_timestamp_ns;
+  uint32_t string_count;
+  uint32_t thread_count;
+  // Number of static strings that did not fit in the string table and were
+  // recorded as the empty string.
+  uint32_t string_overflow_count;
+  // Number of dynamic texts truncated to IREE_TRACING_RING_MAX_INLINE_TEXT.
+  uint32_t text_truncation_count;
+} iree_tracing_ring_file_header_t;
+
+typedef struct iree_tracing_ring_file_thread_t {
+  uint64_t thread_id;
+  // NUL-padded thread name as set with IREE_TRACE_SET_THREAD_NAME.
+  char name[32];
+  uint32_t event_count;
+  uint32_t reserved;
+} iree_tracing_ring_file_thread_t;
+
+// Events with dynamic text have a |string_id| of 0 and are followed by
+// IREE_TRACING_RING_EVENT_TEXT events holding the text.
+typedef enum iree_tracing_ring_event_type_e {
+  // |string_id| is the zone name and |value| is (file string ID << 32) | line.
+  // Dynamic text is the zone name optionally followed by a NUL and the file
+  // name, in which case the file string ID is 0.
+  IREE_TRACING_RING_EVENT_ZONE_BEGIN = 1,
+  // Ends the most recently begun zone.
+  IREE_TRACING_RING_EVENT_ZONE_END = 2,
+  // |value| is an int64_t appended to the current zone.
+  IREE_TRACING_RING_EVENT_ZONE_VALUE = 3,
+  // |string_id| is text appended to the current zone.
+  IREE_TRACING_RING_EVENT_ZONE_TEXT = 4,
+  // |string_id| is the plot name and |value| is the int64_t value.
+  IREE_TRACING_RING_EVENT_PLOT_I64 = 5,
+  // |string_id| is the plot name and |value| is the bits of a double value.
+  IREE_TRACING_RING_EVENT_PLOT_F64 = 6,
+  // |string_id| is the message text and |value| is its 0xRRGGBB color.
+  IREE_TRACING_RING_EVENT_MESSAGE = 7,
+  // |string_id| is the frame group name or 0 for the default group.
+  IREE_TRACING_RING_EVENT_FRAME_MARK = 8,
+  IREE_TRACING_RING_EVENT_FRAME_BEGIN = 9,
+  IREE_TRACING_RING_EVENT_FRAME_END = 10,
+  // Continues the text of the preceding event with the 12 bytes stored in
+  // |value| and |string_id|, in that order. The final chunk is NUL-padded.
+  // Has the same timestamp as the event it continues.
+  IREE_TRACING_RING_EVENT_TEXT = 11,
+} iree_tracing_ring_event_type_t;
+
+typedef struct iree_tracing_ring_event_t {
+  uint64_t timestamp_ns;
+  uint64_t value;
+  uint32_t string_id;
+  uint32_t type;  // iree_tracing_ring_event_type_t
+} iree_tracing_ring_event_t;
+
+//===----------------------------------------------------------------------===//
+// C API used for tracing control
+//===----------------------------------------------------------------------===//
+// These functions are implementation details and should not be called directly
+// with the exception of iree_tracing_ring_flush. Always use the macros (or C++
+// RAII types).
+
+// Local zone ID used for the C IREE_TRACE_ZONE_* macros.
+typedef uint32_t iree_zone_id_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+#if IREE_TRACING_FEATURES
+
+#define IREE_TRACE_IMPL_CONCAT(x, y) IREE_TRACE_IMPL_CONCAT2(x, y)
+#define IREE_TRACE_IMPL_CONCAT2(x, y) x##y
+
+#define IREE_TRACE_STRLEN(literal) (sizeof(literal) - 1)
+
+// Zone source location. Declared per call site and updated with the interned
+// string IDs on first use.
+typedef struct iree_tracing_location_t {
+  const char* name;
+  size_t name_length;
+  const char* function_name;
+  size_t function_name_length;
+  const char* file_name;
+  size_t file_name_length;
+  uint32_t line;
+  uint32_t color;
+  uint32_t name_id;
+  uint32_t file_id;
+} iree_tracing_location_t;
+
+#define iree_tracing_make_zone_ctx(zone_id) (zone_id)
+
+void iree_tracing_ring_initialize();
+void iree_tracing_ring_deinitialize();
+
+// Writes the events recorded by all threads in the last |window_ns|
+// nanoseconds (or all retained events if UINT64_MAX) to the file at |path|,
+// replacing it. Threads may continue recording while the flush is in progress
+// and events overwritten during the flush are dropped.
+// Only performs async-signal-safe operations on POSIX platforms and may be
+// called from signal handlers. Returns false if the file could not be written
+// or another flush is in progress.
+bool iree_tracing_ring_flush(const char* path, uint64_t window_ns);
+
+void iree_tracing_set_thread_name(const char* name);
+
+IREE_MUST_USE_RESULT iree_zone_id_t
+iree_tracing_zone_begin_impl(iree_tracing_location_t* src_loc,
+                             const char* name, size_t name_length);
+IREE_MUST_USE_RESULT iree_zone_id_t iree_tracing_zone_begin_external_impl(
+    const char* file_name, size_t file_name_length, uint32_t line,
+    const char* function_name, size_t function_name_length, const char* name,
+    size_t name_length);
+void iree_tracing_zone_end(iree_zone_id_t zone_id);
+void iree_tracing_zone_append_value_i64(iree_zone_id_t zone_id, int64_t value);
+void iree_tracing_zone_append_text_string_view(iree_zone_id_t zone_id,
+                                               const char* value,
+                                               size_t value_length);
+void iree_tracing_zone_append_text_cstring(iree_zone_id_t zone_id,
+                                           const char* value);
+
+void iree_tracing_plot_value_i64(const char* name, int64_t value);
+void iree_tracing_plot_value_f64(const char* name, double value);
+
+void iree_tracing_frame_mark(uint32_t type, const char* name);
+
+void iree_tracing_message_cstring(const char* value, uint32_t color);
+void iree_tracing_message_string_view(const char* value, size_t value_length,
+                                      uint32_t color);
+
+#endif  // IREE_TRACING_FEATURES
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+//===----------------------------------------------------------------------===//
+// Instrumentation macros (C)
+//===----------------------------------------------------------------------===//
+
+#if IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION
+
+#define IREE_TRACE(expr) expr
+
+#define IREE_TRACE_APP_ENTER() iree_tracing_ring_initialize()
+#define IREE_TRACE_APP_EXIT(exit_code) iree_tracing_ring_deinitialize()
+#define IREE_TRACE_SET_APP_INFO(value, value_length)
+#define IREE_TRACE_SET_THREAD_NAME(name) iree_tracing_set_thread_name(name)
+
+#define IREE_TRACE_PUBLISH_SOURCE_FILE(filename, filename_length, content, \
+                                       content_length)                     \
+  (void)filename;                                                          \
+  (void)filename_length;                                                   \
+  (void)content;                                                           \
+  (void)content_length;
+
+#define IREE_TRACE_FIBER_ENTER(fiber)
+#define IREE_TRACE_FIBER_LEAVE()
+
+#define IREE_TRACE_ZONE_BEGIN(zone_id) \
+  IREE_TRACE_ZONE_BEGIN_NAMED(zone_id, NULL)
+
+#define IREE_TRACE_ZONE_BEGIN_NAMED(zone_id, name_literal)                     \
+  static iree_tracing_location_t IREE_TRACE_IMPL_CONCAT(                       \
+      __iree_tracing_source_location, __LINE__) = {                            \
+      name_literal,       IREE_TRACE_STRLEN(name_literal),                     \
+      __FUNCTION__,       IREE_TRACE_STRLEN(__FUNCTION__),                     \
+      __FILE__,           IREE_TRACE_STRLEN(__FILE__),                         \
+      (uint32_t)__LINE__, 0,                                                   \
+      0,                  0};                                                  \
+  iree_zone_id_t zone_id = iree_tracing_zone_begin_impl(                       \
+      &IREE_TRACE_IMPL_CONCAT(__iree_tracing_source_location, __LINE__), NULL, \
+      0)
+
+#define IREE_TRACE_ZONE_BEGIN_NAMED_DYNAMIC(zone_id, name, name_length)  \
+  static iree_tracing_location_t IREE_TRACE_IMPL_CONCAT(                 \
+      __iree_tracing_source_location, __LINE__) = {                      \
+      NULL,                                                              \
+      0,                                                                 \
+      __FUNCTION__,                                                      \
+      IREE_TRACE_STRLEN(__FUNCTION__),                                   \
+      __FILE__,                                                          \
+      IREE_TRACE_STRLEN(__FILE__),                                       \
+      (uint32_t)__LINE__,                                                \
+      0,                                                                 \
+      0,                                                                 \
+      0};                                                                \
+  iree_zone_id_t zone_id = iree_tracing_zone_begin_impl(                 \
+      &IREE_TRACE_IMPL_CONCAT(__iree_tracing_source_location, __LINE__), \
+      (name), (name_length))
+
+#define IREE_TRACE_ZONE_BEGIN_EXTERNAL(                                       \
+    zone_id, file_name, file_name_length, line, function_name,                \
+    function_name_length, name, name_length)                                  \
+  iree_zone_id_t zone_id = iree_tracing_zone_begin_external_impl(             \
+      file_name, file_name_length, line, function_name, function_name_length, \
+      name, name_length)
+
+#define IREE_TRACE_ZONE_END(zone_id) iree_tracing_zone_end(zone_id)
+
+#define IREE_RETURN_AND_END_ZONE_IF_ERROR(zone_id, ...) \
+  IREE_RETURN_AND_EVAL_IF_ERROR(IREE_TRACE_ZONE_END(zone_id), __VA_ARGS__)
+
+// Zone colors are not recorded.
+#define IREE_TRACE_ZONE_SET_COLOR(zone_id, color_xbgr)
+
+#define IREE_TRACE_ZONE_APPEND_VALUE_I64(zone_id, value) \
+  iree_tracing_zone_append_value_i64(zone_id, (int64_t)(value))
+#define IREE_TRACE_ZONE_APPEND_TEXT(...)                                  \
+  IREE_TRACE_IMPL_GET_VARIADIC_((__VA_ARGS__,                             \
+                                 IREE_TRACE_ZONE_APPEND_TEXT_STRING_VIEW, \
+                                 IREE_TRACE_ZONE_APPEND_TEXT_CSTRING))    \
+  (__VA_ARGS__)
+#define IREE_TRACE_ZONE_APPEND_TEXT_CSTRING(zone_id, value) \
+  iree_tracing_zone_append_text_cstring(zone_id, value)
+#define IREE_TRACE_ZONE_APPEND_TEXT_STRING_VIEW(zone_id, value, value_length) \
+  iree_tracing_zone_append_text_string_view(zone_id, value, value_length)
+
+// Plot types are display-only and not recorded.
+#define IREE_TRACE_SET_PLOT_TYPE(name_literal, plot_type, step, fill, color) \
+  (void)(name_literal), (void)(plot_type), (void)(step), (void)(fill),       \
+      (void)(color)
+#define IREE_TRACE_PLOT_VALUE_I64(name_literal, value) \
+  iree_tracing_plot_value_i64(name_literal, value)
+#define IREE_TRACE_PLOT_VALUE_F32(name_literal, value) \
+  iree_tracing_plot_value_f64(name_literal, (double)(value))
+#define IREE_TRACE_PLOT_VALUE_F64(name_literal, value) \
+  iree_tracing_plot_value_f64(name_literal, value)
+
+#define IREE_TRACE_FRAME_MARK() \
+  iree_tracing_frame_mark(IREE_TRACING_RING_EVENT_FRAME_MARK, NULL)
+#define IREE_TRACE_FRAME_MARK_NAMED(name_literal) \
+  iree_tracing_frame_mark(IREE_TRACING_RING_EVENT_FRAME_MARK, name_literal)
+#define IREE_TRACE_FRAME_MARK_BEGIN_NAMED(name_literal) \
+  iree_tracing_frame_mark(IREE_TRACING_RING_EVENT_FRAME_BEGIN, name_literal)
+#define IREE_TRACE_FRAME_MARK_END_NAMED(name_literal) \
+  iree_tracing_frame_mark(IREE_TRACING_RING_EVENT_FRAME_END, name_literal)
+
+#define IREE_TRACE_MESSAGE(level, value_literal) \
+  iree_tracing_message_cstring(value_literal,    \
+                               IREE_TRACING_MESSAGE_LEVEL_##level)
+#define IREE_TRACE_MESSAGE_COLORED(color, value_literal) \
+  iree_tracing_message_cstring(value_literal, color)
+#define IREE_TRACE_MESSAGE_DYNAMIC(level, value, value_length) \
+  iree_tracing_message_string_view(value, value_length,        \
+                                   IREE_TRACING_MESSAGE_LEVEL_##level)
+#define IREE_TRACE_MESSAGE_DYNAMIC_COLORED(color, value, value_length) \
+  iree_tracing_message_string_view(value, value_length, color)
+
+// Utilities:
+#define IREE_TRACE_IMPL_GET_VARIADIC_HELPER_(_1, _2, _3, NAME, ...) NAME
+#define IREE_TRACE_IMPL_GET_VARIADIC_(args) \
+  IREE_TRACE_IMPL_GET_VARIADIC_HELPER_ args
+
+#endif  // IREE_TRACING_FEATURE_INSTRUMENTATION
+
+//===----------------------------------------------------------------------===//
+// Instrumentation C++ RAII types, wrappers, and macros
+//===----------------------------------------------------------------------===//
+
+#ifdef __cplusplus
+
+#if IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION
+
+namespace iree {
+
+class ScopedZone {
+ public:
+  ScopedZone(const ScopedZone&) = delete;
+  ScopedZone(ScopedZone&&) = delete;
+  ScopedZone& operator=(const ScopedZone&) = delete;
+  ScopedZone& operator=(ScopedZone&&) = delete;
+
+  IREE_ATTRIBUTE_ALWAYS_INLINE ScopedZone(iree_tracing_location_t* src_loc) {
+    zone_id_ = iree_tracing_zone_begin_impl(src_loc, NULL, 0);
+  }
+  IREE_ATTRIBUTE_ALWAYS_INLINE ~ScopedZone() { IREE_TRACE_ZONE_END(zone_id_); }
+
+  operator iree_zone_id_t() const noexcept { return zone_id_; }
+
+ private:
+  iree_zone_id_t zone_id_;
+};
+
+}  // namespace iree
+
+#define IREE_TRACE_SCOPE()                                \
+  static iree_tracing_location_t IREE_TRACE_IMPL_CONCAT(  \
+      __iree_tracing_source_location, __LINE__){          \
+      nullptr,                                            \
+      0,                                                  \
+      __FUNCTION__,                                       \
+      IREE_TRACE_STRLEN(__FUNCTION__),                    \
+      __FILE__,                                           \
+      IREE_TRACE_STRLEN(__FILE__),                        \
+      (uint32_t)__LINE__,                                 \
+      0,                                                  \
+      0,                                                  \
+      0};                                                 \
+  ::iree::ScopedZone ___iree_tracing_scoped_zone(         \
+      &IREE_TRACE_IMPL_CONCAT(__iree_tracing_source_location, __LINE__))
+#define IREE_TRACE_SCOPE_NAMED(name_literal)                      \
+  static iree_tracing_location_t IREE_TRACE_IMPL_CONCAT(          \
+      __iree_tracing_source_location, __LINE__){                  \
+      name_literal,       IREE_TRACE_STRLEN(name_literal),        \
+      __FUNCTION__,       IREE_TRACE_STRLEN(__FUNCTION__),        \
+      __FILE__,           IREE_TRACE_STRLEN(__FILE__),            \
+      (uint32_t)__LINE__, 0,                                      \
+      0,                  0};                                     \
+  ::iree::ScopedZone ___iree_tracing_scoped_zone(                 \
+      &IREE_TRACE_IMPL_CONCAT(__iree_tracing_source_location, __LINE__))
+#define IREE_TRACE_SCOPE_ID ___iree_tracing_scoped_zone
+
+#endif  // IREE_TRACING_FEATURE_INSTRUMENTATION
+
+#endif  // __cplusplus
+
+#endif  // IREE_BASE_TRACING_RING_H_
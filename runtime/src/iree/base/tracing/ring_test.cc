@@ -0,0 +1,256 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Tests the ring tracing provider. Only built when it is the active provider as
+// ring.h must be included through iree/base/tracing.h.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "iree/base/tracing.h"
+#include "iree/testing/gtest.h"
+
+#if IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION
+
+namespace {
+
+// An event with any inline text merged from the TEXT events following it.
+struct Event {
+  iree_tracing_ring_event_t event;
+  bool has_text = false;
+  std::string text;
+};
+
+struct Thread {
+  uint64_t thread_id;
+  std::vector<Event> events;
+};
+
+struct Trace {
+  iree_tracing_ring_file_header_t header;
+  std::vector<std::string> strings;
+  std::vector<Thread> threads;
+
+  // Returns the text of |event|, either inline or from the string table.
+  std::string TextOf(const Event& event) const {
+    return event.has_text ? event.text : strings[event.event.string_id];
+  }
+
+  // Returns the events of the calling thread.
+  const std::vector<Event>& CurrentThreadEvents() const {
+    static const std::vector<Event> empty;
+    const Thread* last = nullptr;
+    for (const Thread& thread : threads) {
+      for (const Event& event : thread.events) {
+        if (event.event.type == IREE_TRACING_RING_EVENT_MESSAGE &&
+            TextOf(event) == "ring_test_marker") {
+          last = &thread;
+        }
+      }
+    }
+    return last ? last->events : empty;
+  }
+};
+
+static std::string GetTracePath(const char* name) {
+  const char* tmpdir = getenv("TEST_TMPDIR");
+  if (!tmpdir) tmpdir = getenv("TMPDIR");
+  if (!tmpdir) tmpdir = "/tmp";
+  return std::string(tmpdir) + "/iree_ring_test_" + name + ".bin";
+}
+
+// Flushes all retained events to a file and parses it back.
+static Trace FlushTrace(const char* name) {
+  std::string path = GetTracePath(name);
+  EXPECT_TRUE(iree_tracing_ring_flush(path.c_str(), UINT64_MAX));
+
+  std::vector<uint8_t> data;
+  FILE* file = fopen(path.c_str(), "rb");
+  EXPECT_NE(file, nullptr);
+  if (file) {
+    uint8_t buffer[4096];
+    size_t length = 0;
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+      data.insert(data.end(), buffer, buffer + length);
+    }
+    fclose(file);
+  }
+  remove(path.c_str());
+
+  Trace trace;
+  size_t offset = 0;
+  auto read = [&](void* value, size_t length) {
+    if (offset + length > data.size()) {
+      ADD_FAILURE() << "truncated trace file";
+      memset(value, 0, length);
+      return;
+    }
+    memcpy(value, data.data() + offset, length);
+    offset += length;
+  };
+  read(&trace.header, sizeof(trace.header));
+  EXPECT_EQ(trace.header.magic, IREE_TRACING_RING_FILE_MAGIC);
+  for (uint32_t i = 0; i < trace.header.string_count; ++i) {
+    uint32_t length = 0;
+    read(&length, sizeof(length));
+    std::string value(length, '\0');
+    read(&value[0], length);
+    offset += ((length + 3) & ~3u) - length;
+    trace.strings.push_back(value);
+  }
+  for (uint32_t i = 0; i < trace.header.thread_count; ++i) {
+    iree_tracing_ring_file_thread_t thread_header;
+    read(&thread_header, sizeof(thread_header));
+    Thread thread;
+    thread.thread_id = thread_header.thread_id;
+    for (uint32_t j = 0; j < thread_header.event_count; ++j) {
+      iree_tracing_ring_event_t event;
+      read(&event, sizeof(event));
+      if (event.type != IREE_TRACING_RING_EVENT_TEXT) {
+        thread.events.push_back({event});
+        continue;
+      }
+      if (thread.events.empty()) continue;
+      Event& head = thread.events.back();
+      EXPECT_EQ(event.timestamp_ns, head.event.timestamp_ns);
+      char chunk[12];
+      memcpy(chunk, &event.value, sizeof(event.value));
+      memcpy(chunk + sizeof(event.value), &event.string_id,
+             sizeof(event.string_id));
+      head.has_text = true;
+      head.text.append(chunk, sizeof(chunk));
+    }
+    for (Event& event : thread.events) {
+      while (!event.text.empty() && event.text.back() == '\0') {
+        event.text.pop_back();
+      }
+    }
+    trace.threads.push_back(std::move(thread));
+  }
+  EXPECT_EQ(offset, data.size());
+  return trace;
+}
+
+TEST(RingTest, RoundTrip) {
+  std::string dynamic_name = "dynamic_zone_";
+  dynamic_name += std::to_string(42);
+  std::string zone_text = "text appended to a zone";
+  std::string message = "a dynamic message longer than twelve bytes";
+  {
+    IREE_TRACE_ZONE_BEGIN_NAMED(z0, "static_zone");
+    IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, -7);
+    IREE_TRACE_ZONE_APPEND_TEXT(z0, zone_text.data(), zone_text.size());
+    IREE_TRACE_ZONE_BEGIN_NAMED_DYNAMIC(z1, dynamic_name.data(),
+                                        dynamic_name.size());
+    IREE_TRACE_ZONE_END(z1);
+    IREE_TRACE_ZONE_END(z0);
+  }
+  IREE_TRACE_PLOT_VALUE_I64("ring_test_plot", 123);
+  IREE_TRACE_MESSAGE_DYNAMIC(INFO, message.data(), message.size());
+  IREE_TRACE_MESSAGE(INFO, "ring_test_marker");
+
+  Trace trace = FlushTrace("round_trip");
+  const std::vector<Event>& events = trace.CurrentThreadEvents();
+  ASSERT_GE(events.size(), 9u);
+  const Event* tail = &events[events.size() - 9];
+
+  EXPECT_EQ(tail[0].event.type, IREE_TRACING_RING_EVENT_ZONE_BEGIN);
+  EXPECT_FALSE(tail[0].has_text);
+  EXPECT_EQ(trace.TextOf(tail[0]), "static_zone");
+  uint32_t file_id = (uint32_t)(tail[0].event.value >> 32);
+  EXPECT_NE(trace.strings[file_id].find("ring_test.cc"), std::string::npos);
+
+  EXPECT_EQ(tail[1].event.type, IREE_TRACING_RING_EVENT_ZONE_VALUE);
+  EXPECT_EQ((int64_t)tail[1].event.value, -7);
+
+  EXPECT_EQ(tail[2].event.type, IREE_TRACING_RING_EVENT_ZONE_TEXT);
+  EXPECT_TRUE(tail[2].has_text);
+  EXPECT_EQ(tail[2].text, zone_text);
+
+  EXPECT_EQ(tail[3].event.type, IREE_TRACING_RING_EVENT_ZONE_BEGIN);
+  EXPECT_TRUE(tail[3].has_text);
+  EXPECT_EQ(tail[3].text, dynamic_name);
+  EXPECT_EQ(trace.strings[tail[3].event.value >> 32],
+            trace.strings[file_id]);
+
+  EXPECT_EQ(tail[4].event.type, IREE_TRACING_RING_EVENT_ZONE_END);
+  EXPECT_EQ(tail[5].event.type, IREE_TRACING_RING_EVENT_ZONE_END);
+
+  EXPECT_EQ(tail[6].event.type, IREE_TRACING_RING_EVENT_PLOT_I64);
+  EXPECT_EQ(trace.TextOf(tail[6]), "ring_test_plot");
+  EXPECT_EQ(tail[6].event.value, 123u);
+
+  EXPECT_EQ(tail[7].event.type, IREE_TRACING_RING_EVENT_MESSAGE);
+  EXPECT_EQ(tail[7].text, message);
+  EXPECT_EQ(trace.TextOf(tail[8]), "ring_test_marker");
+
+  // Dynamic text must not be interned.
+  for (const std::string& value : trace.strings) {
+    EXPECT_NE(value, dynamic_name);
+    EXPECT_NE(value, zone_text);
+    EXPECT_NE(value, message);
+  }
+}
+
+TEST(RingTest, ExternalZone) {
+  static const char kFile[] = "program.mlir";
+  static const char kFunction[] = "main";
+  {
+    IREE_TRACE_ZONE_BEGIN_EXTERNAL(z0, kFile, strlen(kFile), 17, kFunction,
+                                   strlen(kFunction), NULL, 0);
+    IREE_TRACE_ZONE_END(z0);
+  }
+  IREE_TRACE_MESSAGE(INFO, "ring_test_marker");
+
+  Trace trace = FlushTrace("external_zone");
+  const std::vector<Event>& events = trace.CurrentThreadEvents();
+  ASSERT_GE(events.size(), 3u);
+  const Event& begin = events[events.size() - 3];
+  EXPECT_EQ(begin.event.type, IREE_TRACING_RING_EVENT_ZONE_BEGIN);
+  EXPECT_EQ(begin.event.value, 17u);
+  EXPECT_EQ(begin.text, std::string("main\0program.mlir", 17));
+}
+
+TEST(RingTest, TruncatesLongText) {
+  std::string message(IREE_TRACING_RING_MAX_INLINE_TEXT * 2, 'x');
+  uint32_t truncation_count =
+      FlushTrace("truncation_before").header.text_truncation_count;
+  IREE_TRACE_MESSAGE_DYNAMIC(INFO, message.data(), message.size());
+  IREE_TRACE_MESSAGE(INFO, "ring_test_marker");
+
+  Trace trace = FlushTrace("truncation");
+  EXPECT_EQ(trace.header.text_truncation_count, truncation_count + 1);
+  const std::vector<Event>& events = trace.CurrentThreadEvents();
+  ASSERT_GE(events.size(), 2u);
+  EXPECT_EQ(events[events.size() - 2].text,
+            message.substr(0, IREE_TRACING_RING_MAX_INLINE_TEXT));
+}
+
+#if !IREE_SYNCHRONIZATION_DISABLE_UNSAFE && \
+    (defined(IREE_PLATFORM_ANDROID) || defined(IREE_PLATFORM_APPLE) || \
+     defined(IREE_PLATFORM_LINUX))
+TEST(RingTest, ReusesRingsOfExitedThreads) {
+  auto record = [] {
+    IREE_TRACE_ZONE_BEGIN_NAMED(z0, "worker");
+    IREE_TRACE_ZONE_END(z0);
+  };
+  std::thread(record).join();
+  uint32_t thread_count = FlushTrace("reuse_before").header.thread_count;
+  for (int i = 0; i < 4; ++i) {
+    std::thread(record).join();
+  }
+  EXPECT_EQ(FlushTrace("reuse").header.thread_count, thread_count);
+}
+#endif  // !IREE_SYNCHRONIZATION_DISABLE_UNSAFE && POSIX
+
+}  // namespace
+
+#endif  // IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION
@@ -8,6 +8,8 @@
 #define IREE_BUILTINS_UKERNEL_API_H_
 
 #include "iree/builtins/ukernel/mmt4d.h"
+#include "iree/builtins/ukernel/mmt4d_sparse.h"
+#include "iree/builtins/ukernel/normalize.h"
 #include "iree/builtins/ukernel/pack.h"
 #include "iree/builtins/ukernel/query_tile_sizes.h"
 #include "iree/builtins/ukernel/unpack.h"
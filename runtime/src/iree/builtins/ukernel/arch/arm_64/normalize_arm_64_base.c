@@ -0,0 +1,353 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/arch/arm_64/common_arm_64.h"
+#include "iree/builtins/ukernel/arch/arm_64/normalize_arm_64_internal.h"
+
+// The row kernels below are written once against an element `type` that is a
+// compile-time constant after inlining into the per-type entry points, so that
+// the type switches in the load/store helpers fold away. The f16 <-> f32
+// conversions used here (FCVTL/FCVTN) are baseline Armv8-A and do not require
+// the +fullfp16 extension.
+
+static inline float32x4_t iree_uk_neon_load_4xf32(
+    const void* src, iree_uk_normalize_type_t type) {
+  if (type == iree_uk_normalize_type_f16f16) {
+    return vcvt_f32_f16(vld1_f16((const float16_t*)src));
+  }
+  if (type == iree_uk_normalize_type_bf16bf16) {
+    return vreinterpretq_f32_u32(
+        vshll_n_u16(vld1_u16((const iree_uk_uint16_t*)src), 16));
+  }
+  return vld1q_f32((const float*)src);
+}
+
+// Rounds to nearest-even, preserving NaNs as quiet NaNs.
+static inline uint16x4_t iree_uk_neon_cvt_4xf32_to_4xbf16(float32x4_t v) {
+  uint32x4_t u = vreinterpretq_u32_f32(v);
+  uint32x4_t lsb = vandq_u32(vshrq_n_u32(u, 16), vdupq_n_u32(1));
+  uint32x4_t rounded = vaddq_u32(u, vaddq_u32(lsb, vdupq_n_u32(0x7FFF)));
+  uint32x4_t quiet_nan = vorrq_u32(u, vdupq_n_u32(0x400000));
+  uint32x4_t is_not_nan = vceqq_f32(v, v);
+  return vshrn_n_u32(vbslq_u32(is_not_nan, rounded, quiet_nan), 16);
+}
+
+static inline void iree_uk_neon_store_4xf32(void* dst, float32x4_t v,
+                                            iree_uk_normalize_type_t type) {
+  if (type == iree_uk_normalize_type_f16f16) {
+    vst1_f16((float16_t*)dst, vcvt_f16_f32(v));
+  } else if (type == iree_uk_normalize_type_bf16bf16) {
+    vst1_u16((iree_uk_uint16_t*)dst, iree_uk_neon_cvt_4xf32_to_4xbf16(v));
+  } else {
+    vst1q_f32((float*)dst, v);
+  }
+}
+
+// Loads the `n` < 4 trailing elements of a row, zero-filling other lanes.
+static inline float32x4_t iree_uk_neon_load_partial_4xf32(
+    const void* src, int n, iree_uk_normalize_type_t type) {
+  IREE_UK_ATTRIBUTE_ALIGNED(16) char buf[16] = {0};
+  int esize = iree_uk_type_size(iree_uk_normalize_in_type(type));
+  iree_uk_memcpy(buf, src, n * esize);
+  return iree_uk_neon_load_4xf32(buf, type);
+}
+
+// Stores the first `n` < 4 lanes of `v`.
+static inline void iree_uk_neon_store_partial_4xf32(
+    void* dst, float32x4_t v, int n, iree_uk_normalize_type_t type) {
+  IREE_UK_ATTRIBUTE_ALIGNED(16) char buf[16];
+  int esize = iree_uk_type_size(iree_uk_normalize_out_type(type));
+  iree_uk_neon_store_4xf32(buf, v, type);
+  iree_uk_memcpy(dst, buf, n * esize);
+}
+
+// Returns a mask with lanes [0, n) set.
+static inline uint32x4_t iree_uk_neon_mask_4xf32(int n) {
+  static const iree_uk_uint32_t iota[4] = {0, 1, 2, 3};
+  return vcltq_u32(vld1q_u32(iota), vdupq_n_u32(n));
+}
+
+// Vector version of iree_uk_normalize_exp_f32, applied to `x - max`.
+static inline float32x4_t iree_uk_neon_exp_sub_4xf32(float32x4_t x,
+                                                     float32x4_t max,
+                                                     bool fast) {
+  x = vsubq_f32(x, max);
+  x = vmaxq_f32(x, vdupq_n_f32(IREE_UK_EXP_F32_LO));
+  x = vminq_f32(x, vdupq_n_f32(IREE_UK_EXP_F32_HI));
+  int32x4_t n = vcvtnq_s32_f32(vmulq_n_f32(x, IREE_UK_EXP_F32_LOG2E));
+  float32x4_t nf = vcvtq_f32_s32(n);
+  float32x4_t r = vfmsq_n_f32(x, nf, IREE_UK_EXP_F32_LN2_HI);
+  r = vfmsq_n_f32(r, nf, IREE_UK_EXP_F32_LN2_LO);
+  float32x4_t p;
+  if (fast) {
+    p = vdupq_n_f32(IREE_UK_EXP_F32_FAST_Q0);
+    p = vfmaq_f32(vdupq_n_f32(IREE_UK_EXP_F32_FAST_Q1), p, r);
+    p = vfmaq_f32(vdupq_n_f32(IREE_UK_EXP_F32_FAST_Q2), p, r);
+  } else {
+    p = vdupq_n_f32(IREE_UK_EXP_F32_P0);
+    p = vfmaq_f32(vdupq_n_f32(IREE_UK_EXP_F32_P1), p, r);
+    p = vfmaq_f32(vdupq_n_f32(IREE_UK_EXP_F32_P2), p, r);
+    p = vfmaq_f32(vdupq_n_f32(IREE_UK_EXP_F32_P3), p, r);
+    p = vfmaq_f32(vdupq_n_f32(IREE_UK_EXP_F32_P4), p, r);
+    p = vfmaq_f32(vdupq_n_f32(IREE_UK_EXP_F32_P5), p, r);
+  }
+  float32x4_t y =
+      vfmaq_f32(vaddq_f32(r, vdupq_n_f32(1.f)), vmulq_f32(p, r), r);
+  int32x4_t scale = vshlq_n_s32(vaddq_s32(n, vdupq_n_s32(127)), 23);
+  return vmulq_f32(y, vreinterpretq_f32_s32(scale));
+}
+
+IREE_UK_ATTRIBUTE_ALWAYS_INLINE static inline void
+iree_uk_softmax_row_arm_64_impl(void* out_row, const void* in_row,
+                                iree_uk_index_t size1, bool fast,
+                                iree_uk_normalize_type_t type) {
+  const iree_uk_index_t esize =
+      iree_uk_type_size(iree_uk_normalize_in_type(type));
+  const char* in = in_row;
+  char* out = out_row;
+  const int tail = size1 & 3;
+  const iree_uk_index_t size1_4 = size1 - tail;
+  // Pass 1: row max. Two accumulators to hide the latency of FMAX.
+  float32x4_t max0 = vreinterpretq_f32_u32(vdupq_n_u32(0xFF800000));  // -inf
+  float32x4_t max1 = max0;
+  iree_uk_index_t j = 0;
+  for (; j + 8 <= size1; j += 8) {
+    max0 = vmaxq_f32(max0, iree_uk_neon_load_4xf32(in + j * esize, type));
+    max1 =
+        vmaxq_f32(max1, iree_uk_neon_load_4xf32(in + (j + 4) * esize, type));
+  }
+  for (; j < size1_4; j += 4) {
+    max0 = vmaxq_f32(max0, iree_uk_neon_load_4xf32(in + j * esize, type));
+  }
+  if (tail) {
+    float32x4_t x = iree_uk_neon_load_partial_4xf32(in + j * esize, tail, type);
+    x = vbslq_f32(iree_uk_neon_mask_4xf32(tail), x, max1);
+    max1 = vmaxq_f32(max1, x);
+  }
+  float32x4_t max = vdupq_n_f32(vmaxvq_f32(vmaxq_f32(max0, max1)));
+  // Pass 2: sum of exp(x - max). For f32, the exponentials are stored to the
+  // output and rescaled in pass 3. For 16-bit types, they are recomputed in
+  // pass 3 instead, to avoid rounding them to the output type twice.
+  const bool store_exp = type == iree_uk_normalize_type_f32f32;
+  float32x4_t sum0 = vdupq_n_f32(0.f);
+  float32x4_t sum1 = vdupq_n_f32(0.f);
+  for (j = 0; j + 8 <= size1; j += 8) {
+    float32x4_t x0 = iree_uk_neon_load_4xf32(in + j * esize, type);
+    float32x4_t x1 = iree_uk_neon_load_4xf32(in + (j + 4) * esize, type);
+    float32x4_t e0 = iree_uk_neon_exp_sub_4xf32(x0, max, fast);
+    float32x4_t e1 = iree_uk_neon_exp_sub_4xf32(x1, max, fast);
+    sum0 = vaddq_f32(sum0, e0);
+    sum1 = vaddq_f32(sum1, e1);
+    if (store_exp) {
+      vst1q_f32((float*)(out + j * esize), e0);
+      vst1q_f32((float*)(out + (j + 4) * esize), e1);
+    }
+  }
+  for (; j < size1_4; j += 4) {
+    float32x4_t x = iree_uk_neon_load_4xf32(in + j * esize, type);
+    float32x4_t e = iree_uk_neon_exp_sub_4xf32(x, max, fast);
+    sum0 = vaddq_f32(sum0, e);
+    if (store_exp) vst1q_f32((float*)(out + j * esize), e);
+  }
+  if (tail) {
+    float32x4_t x = iree_uk_neon_load_partial_4xf32(in + j * esize, tail, type);
+    float32x4_t e = iree_uk_neon_exp_sub_4xf32(x, max, fast);
+    e = vreinterpretq_f32_u32(
+        vandq_u32(vreinterpretq_u32_f32(e), iree_uk_neon_mask_4xf32(tail)));
+    sum1 = vaddq_f32(sum1, e);
+    if (store_exp) {
+      iree_uk_neon_store_partial_4xf32(out + j * esize, e, tail, type);
+    }
+  }
+  float sum = vaddvq_f32(vaddq_f32(sum0, sum1));
+  float inv_sum = 1.f / sum;
+  // Pass 3: scale.
+  for (j = 0; j < size1_4; j += 4) {
+    float32x4_t e;
+    if (store_exp) {
+      e = vld1q_f32((const float*)(out + j * esize));
+    } else {
+      float32x4_t x = iree_uk_neon_load_4xf32(in + j * esize, type);
+      e = iree_uk_neon_exp_sub_4xf32(x, max, fast);
+    }
+    iree_uk_neon_store_4xf32(out + j * esize, vmulq_n_f32(e, inv_sum), type);
+  }
+  if (tail) {
+    float32x4_t e;
+    if (store_exp) {
+      e = iree_uk_neon_load_partial_4xf32(out + j * esize, tail, type);
+    } else {
+      float32x4_t x =
+          iree_uk_neon_load_partial_4xf32(in + j * esize, tail, type);
+      e = iree_uk_neon_exp_sub_4xf32(x, max, fast);
+    }
+    iree_uk_neon_store_partial_4xf32(out + j * esize, vmulq_n_f32(e, inv_sum),
+                                     tail, type);
+  }
+}
+
+// Shared by layernorm and rmsnorm. The latter has no mean subtraction and no
+// `beta` term.
+IREE_UK_ATTRIBUTE_ALWAYS_INLINE static inline void
+iree_uk_norm_row_arm_64_impl(void* out_row, const void* in_row,
+                             const void* gamma_row, const void* beta_row,
+                             iree_uk_index_t size1, float epsilon, bool fast,
+                             bool layernorm, iree_uk_normalize_type_t type) {
+  const iree_uk_index_t esize =
+      iree_uk_type_size(iree_uk_normalize_in_type(type));
+  const char* in = in_row;
+  const char* gamma = gamma_row;
+  const char* beta = beta_row;
+  char* out = out_row;
+  const int tail = size1 & 3;
+  const iree_uk_index_t size1_4 = size1 - tail;
+  iree_uk_index_t j = 0;
+  float32x4_t mean = vdupq_n_f32(0.f);
+  if (layernorm) {
+    float32x4_t sum0 = vdupq_n_f32(0.f);
+    float32x4_t sum1 = vdupq_n_f32(0.f);
+    for (j = 0; j + 8 <= size1; j += 8) {
+      sum0 = vaddq_f32(sum0, iree_uk_neon_load_4xf32(in + j * esize, type));
+      sum1 = vaddq_f32(sum1,
+                       iree_uk_neon_load_4xf32(in + (j + 4) * esize, type));
+    }
+    for (; j < size1_4; j += 4) {
+      sum0 = vaddq_f32(sum0, iree_uk_neon_load_4xf32(in + j * esize, type));
+    }
+    if (tail) {
+      sum1 = vaddq_f32(
+          sum1, iree_uk_neon_load_partial_4xf32(in + j * esize, tail, type));
+    }
+    float sum = vaddvq_f32(vaddq_f32(sum0, sum1));
+    mean = vdupq_n_f32(sum / (float)size1);
+  }
+  // Sum of squared deviations from `mean`, which is zero for rmsnorm.
+  float32x4_t sq0 = vdupq_n_f32(0.f);
+  float32x4_t sq1 = vdupq_n_f32(0.f);
+  for (j = 0; j + 8 <= size1; j += 8) {
+    float32x4_t x0 = iree_uk_neon_load_4xf32(in + j * esize, type);
+    float32x4_t x1 = iree_uk_neon_load_4xf32(in + (j + 4) * esize, type);
+    float32x4_t d0 = vsubq_f32(x0, mean);
+    float32x4_t d1 = vsubq_f32(x1, mean);
+    sq0 = vfmaq_f32(sq0, d0, d0);
+    sq1 = vfmaq_f32(sq1, d1, d1);
+  }
+  for (; j < size1_4; j += 4) {
+    float32x4_t x = iree_uk_neon_load_4xf32(in + j * esize, type);
+    float32x4_t d = vsubq_f32(x, mean);
+    sq0 = vfmaq_f32(sq0, d, d);
+  }
+  if (tail) {
+    float32x4_t x = iree_uk_neon_load_partial_4xf32(in + j * esize, tail, type);
+    float32x4_t d = vreinterpretq_f32_u32(
+        vandq_u32(vreinterpretq_u32_f32(vsubq_f32(x, mean)),
+                  iree_uk_neon_mask_4xf32(tail)));
+    sq1 = vfmaq_f32(sq1, d, d);
+  }
+  float sum_sq = vaddvq_f32(vaddq_f32(sq0, sq1));
+  float var = sum_sq / (float)size1;
+  float rstd = iree_uk_normalize_rsqrt_f32(var + epsilon, fast);
+  // out = (x - mean) * rstd * gamma (+ beta).
+  for (j = 0; j < size1_4; j += 4) {
+    float32x4_t x = iree_uk_neon_load_4xf32(in + j * esize, type);
+    float32x4_t g = iree_uk_neon_load_4xf32(gamma + j * esize, type);
+    float32x4_t d = vsubq_f32(x, mean);
+    float32x4_t s = vmulq_n_f32(g, rstd);
+    float32x4_t y;
+    if (layernorm) {
+      float32x4_t b = iree_uk_neon_load_4xf32(beta + j * esize, type);
+      y = vfmaq_f32(b, d, s);
+    } else {
+      y = vmulq_f32(d, s);
+    }
+    iree_uk_neon_store_4xf32(out + j * esize, y, type);
+  }
+  if (tail) {
+    float32x4_t x = iree_uk_neon_load_partial_4xf32(in + j * esize, tail, type);
+    float32x4_t g =
+        iree_uk_neon_load_partial_4xf32(gamma + j * esize, tail, type);
+    float32x4_t d = vsubq_f32(x, mean);
+    float32x4_t s = vmulq_n_f32(g, rstd);
+    float32x4_t y;
+    if (layernorm) {
+      float32x4_t b =
+          iree_uk_neon_load_partial_4xf32(beta + j * esize, tail, type);
+      y = vfmaq_f32(b, d, s);
+    } else {
+      y = vmulq_f32(d, s);
+    }
+    iree_uk_neon_store_partial_4xf32(out + j * esize, y, tail, type);
+  }
+}
+
+void iree_uk_softmax_row_arm_64(void* out_row, const void* in_row,
+                                const void* gamma, const void* beta,
+                                iree_uk_index_t size1, float epsilon,
+                                iree_uk_uint32_t flags) {
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  switch (iree_uk_normalize_type(flags)) {
+    case iree_uk_normalize_type_f16f16:
+      iree_uk_softmax_row_arm_64_impl(out_row, in_row, size1, fast,
+                                      iree_uk_normalize_type_f16f16);
+      return;
+    case iree_uk_normalize_type_bf16bf16:
+      iree_uk_softmax_row_arm_64_impl(out_row, in_row, size1, fast,
+                                      iree_uk_normalize_type_bf16bf16);
+      return;
+    default:
+      iree_uk_softmax_row_arm_64_impl(out_row, in_row, size1, fast,
+                                      iree_uk_normalize_type_f32f32);
+      return;
+  }
+}
+
+void iree_uk_layernorm_row_arm_64(void* out_row, const void* in_row,
+                                  const void* gamma, const void* beta,
+                                  iree_uk_index_t size1, float epsilon,
+                                  iree_uk_uint32_t flags) {
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  switch (iree_uk_normalize_type(flags)) {
+    case iree_uk_normalize_type_f16f16:
+      iree_uk_norm_row_arm_64_impl(out_row, in_row, gamma, beta, size1,
+                                   epsilon, fast, /*layernorm=*/true,
+                                   iree_uk_normalize_type_f16f16);
+      return;
+    case iree_uk_normalize_type_bf16bf16:
+      iree_uk_norm_row_arm_64_impl(out_row, in_row, gamma, beta, size1,
+                                   epsilon, fast, /*layernorm=*/true,
+                                   iree_uk_normalize_type_bf16bf16);
+      return;
+    default:
+      iree_uk_norm_row_arm_64_impl(out_row, in_row, gamma, beta, size1,
+                                   epsilon, fast, /*layernorm=*/true,
+                                   iree_uk_normalize_type_f32f32);
+      return;
+  }
+}
+
+void iree_uk_rmsnorm_row_arm_64(void* out_row, const void* in_row,
+                                const void* gamma, const void* beta,
+                                iree_uk_index_t size1, float epsilon,
+                                iree_uk_uint32_t flags) {
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  switch (iree_uk_normalize_type(flags)) {
+    case iree_uk_normalize_type_f16f16:
+      iree_uk_norm_row_arm_64_impl(out_row, in_row, gamma, beta, size1,
+                                   epsilon, fast, /*layernorm=*/false,
+                                   iree_uk_normalize_type_f16f16);
+      return;
+    case iree_uk_normalize_type_bf16bf16:
+      iree_uk_norm_row_arm_64_impl(out_row, in_row, gamma, beta, size1,
+                                   epsilon, fast, /*layernorm=*/false,
+                                   iree_uk_normalize_type_bf16bf16);
+      return;
+    default:
+      iree_uk_norm_row_arm_64_impl(out_row, in_row, gamma, beta, size1,
+                                   epsilon, fast, /*layernorm=*/false,
+                                   iree_uk_normalize_type_f32f32);
+      return;
+  }
+}
@@ -0,0 +1,22 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/arch/arm_64/common_arm_64.h"
+#include "iree/builtins/ukernel/arch/arm_64/normalize_arm_64_internal.h"
+
+iree_uk_normalize_row_func_t iree_uk_normalize_select_row_func_arch(
+    const iree_uk_normalize_params_t* params) {
+  // The baseline NEON row kernels handle any row length and all element types.
+  switch (params->op) {
+    case iree_uk_normalize_op_softmax:
+      return iree_uk_softmax_row_arm_64;
+    case iree_uk_normalize_op_layernorm:
+      return iree_uk_layernorm_row_arm_64;
+    case iree_uk_normalize_op_rmsnorm:
+      return iree_uk_rmsnorm_row_arm_64;
+  }
+  return 0;
+}
@@ -0,0 +1,16 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BUILTINS_UKERNEL_ARCH_ARM_64_NORMALIZE_ARM_64_INTERNAL_H_
+#define IREE_BUILTINS_UKERNEL_ARCH_ARM_64_NORMALIZE_ARM_64_INTERNAL_H_
+
+#include "iree/builtins/ukernel/normalize_internal.h"
+
+IREE_UK_NORMALIZE_ROW_FUNC_DECL(iree_uk_softmax_row_arm_64)
+IREE_UK_NORMALIZE_ROW_FUNC_DECL(iree_uk_layernorm_row_arm_64)
+IREE_UK_NORMALIZE_ROW_FUNC_DECL(iree_uk_rmsnorm_row_arm_64)
+
+#endif  // IREE_BUILTINS_UKERNEL_ARCH_ARM_64_NORMALIZE_ARM_64_INTERNAL_H_
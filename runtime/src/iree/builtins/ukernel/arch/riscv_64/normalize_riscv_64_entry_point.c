@@ -0,0 +1,30 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/arch/riscv_64/common_riscv_64.h"
+#include "iree/builtins/ukernel/arch/riscv_64/normalize_riscv_64_internal.h"
+
+iree_uk_normalize_row_func_t iree_uk_normalize_select_row_func_arch(
+    const iree_uk_normalize_params_t* params) {
+  // Only f32 rows are vectorized for now. f16/bf16 fall back to the generic
+  // implementation.
+  if (iree_uk_normalize_type(params->flags) != iree_uk_normalize_type_f32f32) {
+    return 0;
+  }
+#if defined(IREE_UK_BUILD_RISCV_64_V)
+  if (iree_uk_cpu_riscv_64_v(params->cpu_data)) {
+    switch (params->op) {
+      case iree_uk_normalize_op_softmax:
+        return iree_uk_softmax_row_f32_riscv_64_v;
+      case iree_uk_normalize_op_layernorm:
+        return iree_uk_layernorm_row_f32_riscv_64_v;
+      case iree_uk_normalize_op_rmsnorm:
+        return iree_uk_rmsnorm_row_f32_riscv_64_v;
+    }
+  }
+#endif
+  return 0;
+}
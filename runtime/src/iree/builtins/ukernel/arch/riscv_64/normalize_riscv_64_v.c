@@ -0,0 +1,175 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <riscv_vector.h>
+
+#include "iree/builtins/ukernel/arch/riscv_64/common_riscv_64.h"
+#include "iree/builtins/ukernel/arch/riscv_64/normalize_riscv_64_internal.h"
+
+// Rows are strip-mined with vsetvl, so there is no separate tail loop.
+// Accumulators are updated with tail-undisturbed (_tu) operations so that
+// lanes beyond the last `vl` keep their partial sums and can be reduced over
+// VLMAX at the end.
+
+// Vector version of iree_uk_normalize_exp_f32, applied to `x - max`.
+static inline vfloat32m4_t iree_uk_exp_sub_f32m4_riscv_64_v(vfloat32m4_t x,
+                                                            float max,
+                                                            bool fast,
+                                                            size_t vl) {
+  x = __riscv_vfsub_vf_f32m4(x, max, vl);
+  x = __riscv_vfmax_vf_f32m4(x, IREE_UK_EXP_F32_LO, vl);
+  x = __riscv_vfmin_vf_f32m4(x, IREE_UK_EXP_F32_HI, vl);
+  // vfcvt.x.f.v rounds to nearest-even under the default frm.
+  vint32m4_t n = __riscv_vfcvt_x_f_v_i32m4(
+      __riscv_vfmul_vf_f32m4(x, IREE_UK_EXP_F32_LOG2E, vl), vl);
+  vfloat32m4_t nf = __riscv_vfcvt_f_x_v_f32m4(n, vl);
+  vfloat32m4_t r = __riscv_vfnmsac_vf_f32m4(x, IREE_UK_EXP_F32_LN2_HI, nf, vl);
+  r = __riscv_vfnmsac_vf_f32m4(r, IREE_UK_EXP_F32_LN2_LO, nf, vl);
+  vfloat32m4_t p;
+  if (fast) {
+    p = __riscv_vfmv_v_f_f32m4(IREE_UK_EXP_F32_FAST_Q0, vl);
+    p = __riscv_vfmadd_vv_f32m4(
+        p, r, __riscv_vfmv_v_f_f32m4(IREE_UK_EXP_F32_FAST_Q1, vl), vl);
+    p = __riscv_vfmadd_vv_f32m4(
+        p, r, __riscv_vfmv_v_f_f32m4(IREE_UK_EXP_F32_FAST_Q2, vl), vl);
+  } else {
+    p = __riscv_vfmv_v_f_f32m4(IREE_UK_EXP_F32_P0, vl);
+    p = __riscv_vfmadd_vv_f32m4(
+        p, r, __riscv_vfmv_v_f_f32m4(IREE_UK_EXP_F32_P1, vl), vl);
+    p = __riscv_vfmadd_vv_f32m4(
+        p, r, __riscv_vfmv_v_f_f32m4(IREE_UK_EXP_F32_P2, vl), vl);
+    p = __riscv_vfmadd_vv_f32m4(
+        p, r, __riscv_vfmv_v_f_f32m4(IREE_UK_EXP_F32_P3, vl), vl);
+    p = __riscv_vfmadd_vv_f32m4(
+        p, r, __riscv_vfmv_v_f_f32m4(IREE_UK_EXP_F32_P4, vl), vl);
+    p = __riscv_vfmadd_vv_f32m4(
+        p, r, __riscv_vfmv_v_f_f32m4(IREE_UK_EXP_F32_P5, vl), vl);
+  }
+  vfloat32m4_t y =
+      __riscv_vfmadd_vv_f32m4(__riscv_vfmul_vv_f32m4(p, r, vl), r,
+                              __riscv_vfadd_vf_f32m4(r, 1.f, vl), vl);
+  vint32m4_t scale =
+      __riscv_vsll_vx_i32m4(__riscv_vadd_vx_i32m4(n, 127, vl), 23, vl);
+  return __riscv_vfmul_vv_f32m4(
+      y, __riscv_vreinterpret_v_i32m4_f32m4(scale), vl);
+}
+
+static inline float iree_uk_reduce_add_f32m4_riscv_64_v(vfloat32m4_t v) {
+  size_t vlmax = __riscv_vsetvlmax_e32m4();
+  vfloat32m1_t zero = __riscv_vfmv_v_f_f32m1(0.f, 1);
+  return __riscv_vfmv_f_s_f32m1_f32(
+      __riscv_vfredusum_vs_f32m4_f32m1(v, zero, vlmax));
+}
+
+void iree_uk_softmax_row_f32_riscv_64_v(void* out_row, const void* in_row,
+                                        const void* gamma, const void* beta,
+                                        iree_uk_index_t size1, float epsilon,
+                                        iree_uk_uint32_t flags) {
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  const float* in = in_row;
+  float* out = out_row;
+  size_t vlmax = __riscv_vsetvlmax_e32m4();
+  // Pass 1: row max.
+  vfloat32m4_t max_acc = __riscv_vfmv_v_f_f32m4(in[0], vlmax);
+  for (iree_uk_index_t j = 0; j < size1;) {
+    size_t vl = __riscv_vsetvl_e32m4(size1 - j);
+    vfloat32m4_t x = __riscv_vle32_v_f32m4(in + j, vl);
+    max_acc = __riscv_vfmax_vv_f32m4_tu(max_acc, max_acc, x, vl);
+    j += vl;
+  }
+  float max = __riscv_vfmv_f_s_f32m1_f32(__riscv_vfredmax_vs_f32m4_f32m1(
+      max_acc, __riscv_vfmv_v_f_f32m1(in[0], 1), vlmax));
+  // Pass 2: sum of exp(x - max), storing the exponentials to the output.
+  vfloat32m4_t sum_acc = __riscv_vfmv_v_f_f32m4(0.f, vlmax);
+  for (iree_uk_index_t j = 0; j < size1;) {
+    size_t vl = __riscv_vsetvl_e32m4(size1 - j);
+    vfloat32m4_t x = __riscv_vle32_v_f32m4(in + j, vl);
+    vfloat32m4_t e = iree_uk_exp_sub_f32m4_riscv_64_v(x, max, fast, vl);
+    sum_acc = __riscv_vfadd_vv_f32m4_tu(sum_acc, sum_acc, e, vl);
+    __riscv_vse32_v_f32m4(out + j, e, vl);
+    j += vl;
+  }
+  float inv_sum = 1.f / iree_uk_reduce_add_f32m4_riscv_64_v(sum_acc);
+  // Pass 3: scale.
+  for (iree_uk_index_t j = 0; j < size1;) {
+    size_t vl = __riscv_vsetvl_e32m4(size1 - j);
+    vfloat32m4_t e = __riscv_vle32_v_f32m4(out + j, vl);
+    __riscv_vse32_v_f32m4(out + j, __riscv_vfmul_vf_f32m4(e, inv_sum, vl), vl);
+    j += vl;
+  }
+}
+
+// Shared by layernorm and rmsnorm. The latter has no mean subtraction and no
+// `beta` term.
+IREE_UK_ATTRIBUTE_ALWAYS_INLINE static inline void
+iree_uk_norm_row_f32_riscv_64_v_impl(void* out_row, const void* in_row,
+                                     const void* gamma_row,
+                                     const void* beta_row,
+                                     iree_uk_index_t size1, float epsilon,
+                                     bool fast, bool layernorm) {
+  const float* in = in_row;
+  const float* gamma = gamma_row;
+  const float* beta = beta_row;
+  float* out = out_row;
+  size_t vlmax = __riscv_vsetvlmax_e32m4();
+  float mean = 0.f;
+  if (layernorm) {
+    vfloat32m4_t sum_acc = __riscv_vfmv_v_f_f32m4(0.f, vlmax);
+    for (iree_uk_index_t j = 0; j < size1;) {
+      size_t vl = __riscv_vsetvl_e32m4(size1 - j);
+      vfloat32m4_t x = __riscv_vle32_v_f32m4(in + j, vl);
+      sum_acc = __riscv_vfadd_vv_f32m4_tu(sum_acc, sum_acc, x, vl);
+      j += vl;
+    }
+    mean = iree_uk_reduce_add_f32m4_riscv_64_v(sum_acc) / (float)size1;
+  }
+  // Sum of squared deviations from `mean`, which is zero for rmsnorm.
+  vfloat32m4_t sq_acc = __riscv_vfmv_v_f_f32m4(0.f, vlmax);
+  for (iree_uk_index_t j = 0; j < size1;) {
+    size_t vl = __riscv_vsetvl_e32m4(size1 - j);
+    vfloat32m4_t d =
+        __riscv_vfsub_vf_f32m4(__riscv_vle32_v_f32m4(in + j, vl), mean, vl);
+    sq_acc = __riscv_vfmacc_vv_f32m4_tu(sq_acc, d, d, vl);
+    j += vl;
+  }
+  float var = iree_uk_reduce_add_f32m4_riscv_64_v(sq_acc) / (float)size1;
+  float rstd = iree_uk_normalize_rsqrt_f32(var + epsilon, fast);
+  // out = (x - mean) * rstd * gamma (+ beta).
+  for (iree_uk_index_t j = 0; j < size1;) {
+    size_t vl = __riscv_vsetvl_e32m4(size1 - j);
+    vfloat32m4_t d =
+        __riscv_vfsub_vf_f32m4(__riscv_vle32_v_f32m4(in + j, vl), mean, vl);
+    vfloat32m4_t s =
+        __riscv_vfmul_vf_f32m4(__riscv_vle32_v_f32m4(gamma + j, vl), rstd, vl);
+    vfloat32m4_t y;
+    if (layernorm) {
+      y = __riscv_vfmacc_vv_f32m4(__riscv_vle32_v_f32m4(beta + j, vl), d, s,
+                                  vl);
+    } else {
+      y = __riscv_vfmul_vv_f32m4(d, s, vl);
+    }
+    __riscv_vse32_v_f32m4(out + j, y, vl);
+    j += vl;
+  }
+}
+
+void iree_uk_layernorm_row_f32_riscv_64_v(void* out_row, const void* in_row,
+                                          const void* gamma, const void* beta,
+                                          iree_uk_index_t size1, float epsilon,
+                                          iree_uk_uint32_t flags) {
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  iree_uk_norm_row_f32_riscv_64_v_impl(out_row, in_row, gamma, beta, size1,
+                                       epsilon, fast, /*layernorm=*/true);
+}
+
+void iree_uk_rmsnorm_row_f32_riscv_64_v(void* out_row, const void* in_row,
+                                        const void* gamma, const void* beta,
+                                        iree_uk_index_t size1, float epsilon,
+                                        iree_uk_uint32_t flags) {
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  iree_uk_norm_row_f32_riscv_64_v_impl(out_row, in_row, gamma, beta, size1,
+                                       epsilon, fast, /*layernorm=*/false);
+}
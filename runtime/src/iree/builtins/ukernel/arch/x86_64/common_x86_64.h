@@ -69,6 +69,15 @@ static inline void iree_uk_avx_storeu_2x128(void* dst0, void* dst1,
   _mm_storeu_si128((__m128i*)dst1, v128_1);
 }
 
+static inline void iree_uk_copy_8x16xi8_strided_to_strided(
+    iree_uk_int8_t* IREE_UK_RESTRICT out_ptr,
+    const iree_uk_int8_t* IREE_UK_RESTRICT in_ptr, iree_uk_index_t out_stride,
+    iree_uk_index_t in_stride) {
+  for (int i = 0; i < 8; ++i) {
+    iree_uk_memcpy(out_ptr + i * out_stride, in_ptr + i * in_stride, 16);
+  }
+}
+
 static inline void iree_uk_copy_8x32xi8_strided_to_strided(
     iree_uk_int8_t* IREE_UK_RESTRICT out_ptr,
     const iree_uk_int8_t* IREE_UK_RESTRICT in_ptr, iree_uk_index_t out_stride,
@@ -78,6 +87,15 @@ static inline void iree_uk_copy_8x32xi8_strided_to_strided(
   }
 }
 
+static inline void iree_uk_copy_16x32xi8_strided_to_strided(
+    iree_uk_int8_t* IREE_UK_RESTRICT out_ptr,
+    const iree_uk_int8_t* IREE_UK_RESTRICT in_ptr, iree_uk_index_t out_stride,
+    iree_uk_index_t in_stride) {
+  for (int i = 0; i < 16; ++i) {
+    iree_uk_memcpy(out_ptr + i * out_stride, in_ptr + i * in_stride, 32);
+  }
+}
+
 static inline void iree_uk_copy_16x64xi8_strided_to_strided(
     iree_uk_int8_t* IREE_UK_RESTRICT out_ptr,
     const iree_uk_int8_t* IREE_UK_RESTRICT in_ptr, iree_uk_index_t out_stride,
@@ -265,6 +283,74 @@ iree_uk_avx2_copy_8x16xi8_tiled_1x2_transpose_strided_to_strided(
                            r0123456701234567_3);
 }
 
+// In-register transpose of the 8x8 matrix of 32-bit elements held in `rows`.
+static inline void iree_uk_avx2_transpose_8x8xi32(__m256i rows[8]) {
+  __m256i t[8], u[8];
+  for (int i = 0; i < 8; i += 2) {
+    t[i + 0] = _mm256_unpacklo_epi32(rows[i], rows[i + 1]);
+    t[i + 1] = _mm256_unpackhi_epi32(rows[i], rows[i + 1]);
+  }
+  for (int i = 0; i < 8; i += 4) {
+    u[i + 0] = _mm256_unpacklo_epi64(t[i + 0], t[i + 2]);
+    u[i + 1] = _mm256_unpackhi_epi64(t[i + 0], t[i + 2]);
+    u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+    u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+  }
+  for (int i = 0; i < 4; ++i) {
+    rows[i + 0] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+    rows[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+  }
+}
+
+// In-register transpose of the 8x8 matrix of 16-bit elements held in `rows`.
+static inline void iree_uk_avx2_transpose_8x8xi16(__m128i rows[8]) {
+  __m128i t[8], u[8];
+  for (int i = 0; i < 8; i += 2) {
+    t[i + 0] = _mm_unpacklo_epi16(rows[i], rows[i + 1]);
+    t[i + 1] = _mm_unpackhi_epi16(rows[i], rows[i + 1]);
+  }
+  for (int i = 0; i < 8; i += 4) {
+    u[i + 0] = _mm_unpacklo_epi32(t[i + 0], t[i + 2]);
+    u[i + 1] = _mm_unpackhi_epi32(t[i + 0], t[i + 2]);
+    u[i + 2] = _mm_unpacklo_epi32(t[i + 1], t[i + 3]);
+    u[i + 3] = _mm_unpackhi_epi32(t[i + 1], t[i + 3]);
+  }
+  for (int i = 0; i < 4; ++i) {
+    rows[2 * i + 0] = _mm_unpacklo_epi64(u[i], u[i + 4]);
+    rows[2 * i + 1] = _mm_unpackhi_epi64(u[i], u[i + 4]);
+  }
+}
+
+// Copies a 8x8 tile of 16-bit elements, transposing it. Strides are in bytes.
+static inline void iree_uk_avx2_copy_8x8xi16_transpose_strided_to_strided(
+    iree_uk_int8_t* IREE_UK_RESTRICT out_ptr,
+    const iree_uk_int8_t* IREE_UK_RESTRICT in_ptr, iree_uk_index_t out_stride,
+    iree_uk_index_t in_stride) {
+  __m128i rows[8];
+  for (int i = 0; i < 8; ++i) {
+    rows[i] = _mm_loadu_si128((const __m128i*)(in_ptr + i * in_stride));
+  }
+  iree_uk_avx2_transpose_8x8xi16(rows);
+  for (int i = 0; i < 8; ++i) {
+    _mm_storeu_si128((__m128i*)(out_ptr + i * out_stride), rows[i]);
+  }
+}
+
+// Copies a 16x16 tile of 16-bit elements, transposing it, as 4 8x8 blocks.
+// Strides are in bytes.
+static inline void iree_uk_avx2_copy_16x16xi16_transpose_strided_to_strided(
+    iree_uk_int8_t* IREE_UK_RESTRICT out_ptr,
+    const iree_uk_int8_t* IREE_UK_RESTRICT in_ptr, iree_uk_index_t out_stride,
+    iree_uk_index_t in_stride) {
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      iree_uk_avx2_copy_8x8xi16_transpose_strided_to_strided(
+          out_ptr + 8 * i * out_stride + 16 * j,
+          in_ptr + 8 * j * in_stride + 16 * i, out_stride, in_stride);
+    }
+  }
+}
+
 #if defined(__AVX512F__)
 
 static inline __m512i iree_uk_avx512_loadu_4x128(const void* src0,
@@ -446,6 +532,33 @@ iree_uk_avx512_copy_16x16xi8_tiled_1x2_transpose_strided_to_strided(
       r0123456701234567_3);
 }
 
+// In-register transpose of the 16x16 matrix of 32-bit elements held in `rows`.
+static inline void iree_uk_avx512_transpose_16x16xi32(__m512i rows[16]) {
+  __m512i t[16], u[16];
+  for (int i = 0; i < 16; i += 2) {
+    t[i + 0] = _mm512_unpacklo_epi32(rows[i], rows[i + 1]);
+    t[i + 1] = _mm512_unpackhi_epi32(rows[i], rows[i + 1]);
+  }
+  // Now, 128-bit lane `l` of u[4 * i + j] holds elements [4 * i + (0..3)]
+  // [4 * l + j].
+  for (int i = 0; i < 16; i += 4) {
+    u[i + 0] = _mm512_unpacklo_epi64(t[i + 0], t[i + 2]);
+    u[i + 1] = _mm512_unpackhi_epi64(t[i + 0], t[i + 2]);
+    u[i + 2] = _mm512_unpacklo_epi64(t[i + 1], t[i + 3]);
+    u[i + 3] = _mm512_unpackhi_epi64(t[i + 1], t[i + 3]);
+  }
+  for (int j = 0; j < 4; ++j) {
+    __m512i x0 = _mm512_shuffle_i32x4(u[j], u[j + 4], 0x44);
+    __m512i x1 = _mm512_shuffle_i32x4(u[j], u[j + 4], 0xEE);
+    __m512i y0 = _mm512_shuffle_i32x4(u[j + 8], u[j + 12], 0x44);
+    __m512i y1 = _mm512_shuffle_i32x4(u[j + 8], u[j + 12], 0xEE);
+    rows[j + 0] = _mm512_shuffle_i32x4(x0, y0, 0x88);
+    rows[j + 4] = _mm512_shuffle_i32x4(x0, y0, 0xDD);
+    rows[j + 8] = _mm512_shuffle_i32x4(x1, y1, 0x88);
+    rows[j + 12] = _mm512_shuffle_i32x4(x1, y1, 0xDD);
+  }
+}
+
 #endif  // defined (__AVX512F__)
 
 #endif  // defined(__AVX2__)
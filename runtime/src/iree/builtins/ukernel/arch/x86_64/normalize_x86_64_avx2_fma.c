@@ -0,0 +1,376 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/arch/x86_64/common_x86_64.h"
+#include "iree/builtins/ukernel/arch/x86_64/normalize_x86_64_internal.h"
+
+// The row kernels below are written once against an element `type` that is a
+// compile-time constant after inlining into the per-type entry points, so that
+// the type switches in the load/store helpers fold away.
+
+static inline __m256 iree_uk_load_8xf32_avx2(const void* src,
+                                             iree_uk_normalize_type_t type) {
+  if (type == iree_uk_normalize_type_f16f16) {
+    return _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)src));
+  }
+  if (type == iree_uk_normalize_type_bf16bf16) {
+    return _mm256_castsi256_ps(_mm256_slli_epi32(
+        _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)src)), 16));
+  }
+  return _mm256_loadu_ps((const float*)src);
+}
+
+// Rounds to nearest-even, preserving NaNs as quiet NaNs.
+static inline __m128i iree_uk_cvt_8xf32_to_8xbf16_avx2(__m256 v) {
+  __m256i u = _mm256_castps_si256(v);
+  __m256i lsb =
+      _mm256_and_si256(_mm256_srli_epi32(u, 16), _mm256_set1_epi32(1));
+  __m256i rounded =
+      _mm256_add_epi32(u, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7FFF)));
+  __m256i quiet_nan = _mm256_or_si256(u, _mm256_set1_epi32(0x400000));
+  __m256 is_nan = _mm256_cmp_ps(v, v, _CMP_UNORD_Q);
+  rounded =
+      _mm256_blendv_epi8(rounded, quiet_nan, _mm256_castps_si256(is_nan));
+  __m256i shifted = _mm256_srli_epi32(rounded, 16);
+  // packus works within 128-bit lanes: gather 64-bit elements 0 and 2.
+  __m256i packed = _mm256_packus_epi32(shifted, shifted);
+  return _mm256_castsi256_si128(_mm256_permute4x64_epi64(packed, 0x08));
+}
+
+static inline void iree_uk_store_8xf32_avx2(void* dst, __m256 v,
+                                            iree_uk_normalize_type_t type) {
+  if (type == iree_uk_normalize_type_f16f16) {
+    _mm_storeu_si128((__m128i*)dst,
+                     _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+  } else if (type == iree_uk_normalize_type_bf16bf16) {
+    _mm_storeu_si128((__m128i*)dst, iree_uk_cvt_8xf32_to_8xbf16_avx2(v));
+  } else {
+    _mm256_storeu_ps((float*)dst, v);
+  }
+}
+
+// Loads the `n` < 8 trailing elements of a row, zero-filling other lanes.
+static inline __m256 iree_uk_load_partial_8xf32_avx2(
+    const void* src, int n, iree_uk_normalize_type_t type) {
+  IREE_UK_ATTRIBUTE_ALIGNED(32) char buf[32] = {0};
+  int esize = iree_uk_type_size(iree_uk_normalize_in_type(type));
+  iree_uk_memcpy(buf, src, n * esize);
+  return iree_uk_load_8xf32_avx2(buf, type);
+}
+
+// Stores the first `n` < 8 lanes of `v`.
+static inline void iree_uk_store_partial_8xf32_avx2(
+    void* dst, __m256 v, int n, iree_uk_normalize_type_t type) {
+  IREE_UK_ATTRIBUTE_ALIGNED(32) char buf[32];
+  int esize = iree_uk_type_size(iree_uk_normalize_out_type(type));
+  iree_uk_store_8xf32_avx2(buf, v, type);
+  iree_uk_memcpy(dst, buf, n * esize);
+}
+
+// Returns a mask with lanes [0, n) set.
+static inline __m256 iree_uk_mask_8xf32_avx2(int n) {
+  return _mm256_castsi256_ps(_mm256_cmpgt_epi32(
+      _mm256_set1_epi32(n), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+}
+
+static inline float iree_uk_reduce_add_8xf32_avx2(__m256 v) {
+  __m128 s =
+      _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+  s = _mm_add_ss(s, _mm_movehdup_ps(s));
+  return _mm_cvtss_f32(s);
+}
+
+static inline float iree_uk_reduce_max_8xf32_avx2(__m256 v) {
+  __m128 s =
+      _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  s = _mm_max_ps(s, _mm_movehl_ps(s, s));
+  s = _mm_max_ss(s, _mm_movehdup_ps(s));
+  return _mm_cvtss_f32(s);
+}
+
+// Vector version of iree_uk_normalize_exp_f32, applied to `x - max`.
+static inline __m256 iree_uk_exp_sub_8xf32_avx2(__m256 x, __m256 max,
+                                                bool fast) {
+  x = _mm256_sub_ps(x, max);
+  x = _mm256_max_ps(x, _mm256_set1_ps(IREE_UK_EXP_F32_LO));
+  x = _mm256_min_ps(x, _mm256_set1_ps(IREE_UK_EXP_F32_HI));
+  // cvtps rounds to nearest-even under the default MXCSR rounding mode.
+  __m256 t = _mm256_mul_ps(x, _mm256_set1_ps(IREE_UK_EXP_F32_LOG2E));
+  __m256i n = _mm256_cvtps_epi32(t);
+  __m256 nf = _mm256_cvtepi32_ps(n);
+  __m256 r = _mm256_fnmadd_ps(nf, _mm256_set1_ps(IREE_UK_EXP_F32_LN2_HI), x);
+  r = _mm256_fnmadd_ps(nf, _mm256_set1_ps(IREE_UK_EXP_F32_LN2_LO), r);
+  __m256 p;
+  if (fast) {
+    p = _mm256_set1_ps(IREE_UK_EXP_F32_FAST_Q0);
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(IREE_UK_EXP_F32_FAST_Q1));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(IREE_UK_EXP_F32_FAST_Q2));
+  } else {
+    p = _mm256_set1_ps(IREE_UK_EXP_F32_P0);
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(IREE_UK_EXP_F32_P1));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(IREE_UK_EXP_F32_P2));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(IREE_UK_EXP_F32_P3));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(IREE_UK_EXP_F32_P4));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(IREE_UK_EXP_F32_P5));
+  }
+  __m256 y = _mm256_fmadd_ps(_mm256_mul_ps(p, r), r,
+                             _mm256_add_ps(r, _mm256_set1_ps(1.f)));
+  __m256i scale =
+      _mm256_slli_epi32(_mm256_add_epi32(n, _mm256_set1_epi32(127)), 23);
+  return _mm256_mul_ps(y, _mm256_castsi256_ps(scale));
+}
+
+IREE_UK_ATTRIBUTE_ALWAYS_INLINE static inline void
+iree_uk_softmax_row_x86_64_avx2_fma_impl(void* out_row, const void* in_row,
+                                         iree_uk_index_t size1, bool fast,
+                                         iree_uk_normalize_type_t type) {
+  const iree_uk_index_t esize =
+      iree_uk_type_size(iree_uk_normalize_in_type(type));
+  const char* in = in_row;
+  char* out = out_row;
+  const int tail = size1 & 7;
+  const iree_uk_index_t size1_8 = size1 - tail;
+  // Pass 1: row max. Two accumulators to hide the latency of vmaxps.
+  __m256 max0 = _mm256_castsi256_ps(_mm256_set1_epi32(0xFF800000));  // -inf
+  __m256 max1 = max0;
+  iree_uk_index_t j = 0;
+  for (; j + 16 <= size1; j += 16) {
+    max0 = _mm256_max_ps(max0, iree_uk_load_8xf32_avx2(in + j * esize, type));
+    max1 = _mm256_max_ps(max1,
+                         iree_uk_load_8xf32_avx2(in + (j + 8) * esize, type));
+  }
+  for (; j < size1_8; j += 8) {
+    max0 = _mm256_max_ps(max0, iree_uk_load_8xf32_avx2(in + j * esize, type));
+  }
+  if (tail) {
+    __m256 x = iree_uk_load_partial_8xf32_avx2(in + j * esize, tail, type);
+    x = _mm256_blendv_ps(max1, x, iree_uk_mask_8xf32_avx2(tail));
+    max1 = _mm256_max_ps(max1, x);
+  }
+  __m256 max =
+      _mm256_set1_ps(iree_uk_reduce_max_8xf32_avx2(_mm256_max_ps(max0, max1)));
+  // Pass 2: sum of exp(x - max). For f32, the exponentials are stored to the
+  // output and rescaled in pass 3. For 16-bit types, they are recomputed in
+  // pass 3 instead, to avoid rounding them to the output type twice.
+  const bool store_exp = type == iree_uk_normalize_type_f32f32;
+  __m256 sum0 = _mm256_setzero_ps();
+  __m256 sum1 = _mm256_setzero_ps();
+  for (j = 0; j + 16 <= size1; j += 16) {
+    __m256 x0 = iree_uk_load_8xf32_avx2(in + j * esize, type);
+    __m256 x1 = iree_uk_load_8xf32_avx2(in + (j + 8) * esize, type);
+    __m256 e0 = iree_uk_exp_sub_8xf32_avx2(x0, max, fast);
+    __m256 e1 = iree_uk_exp_sub_8xf32_avx2(x1, max, fast);
+    sum0 = _mm256_add_ps(sum0, e0);
+    sum1 = _mm256_add_ps(sum1, e1);
+    if (store_exp) {
+      _mm256_storeu_ps((float*)(out + j * esize), e0);
+      _mm256_storeu_ps((float*)(out + (j + 8) * esize), e1);
+    }
+  }
+  for (; j < size1_8; j += 8) {
+    __m256 x = iree_uk_load_8xf32_avx2(in + j * esize, type);
+    __m256 e = iree_uk_exp_sub_8xf32_avx2(x, max, fast);
+    sum0 = _mm256_add_ps(sum0, e);
+    if (store_exp) _mm256_storeu_ps((float*)(out + j * esize), e);
+  }
+  if (tail) {
+    __m256 x = iree_uk_load_partial_8xf32_avx2(in + j * esize, tail, type);
+    __m256 e = iree_uk_exp_sub_8xf32_avx2(x, max, fast);
+    e = _mm256_and_ps(e, iree_uk_mask_8xf32_avx2(tail));
+    sum1 = _mm256_add_ps(sum1, e);
+    if (store_exp) {
+      iree_uk_store_partial_8xf32_avx2(out + j * esize, e, tail, type);
+    }
+  }
+  float sum = iree_uk_reduce_add_8xf32_avx2(_mm256_add_ps(sum0, sum1));
+  __m256 inv_sum = _mm256_set1_ps(1.f / sum);
+  // Pass 3: scale.
+  for (j = 0; j < size1_8; j += 8) {
+    __m256 e;
+    if (store_exp) {
+      e = _mm256_loadu_ps((const float*)(out + j * esize));
+    } else {
+      __m256 x = iree_uk_load_8xf32_avx2(in + j * esize, type);
+      e = iree_uk_exp_sub_8xf32_avx2(x, max, fast);
+    }
+    iree_uk_store_8xf32_avx2(out + j * esize, _mm256_mul_ps(e, inv_sum), type);
+  }
+  if (tail) {
+    __m256 e;
+    if (store_exp) {
+      e = iree_uk_load_partial_8xf32_avx2(out + j * esize, tail, type);
+    } else {
+      __m256 x = iree_uk_load_partial_8xf32_avx2(in + j * esize, tail, type);
+      e = iree_uk_exp_sub_8xf32_avx2(x, max, fast);
+    }
+    iree_uk_store_partial_8xf32_avx2(out + j * esize,
+                                     _mm256_mul_ps(e, inv_sum), tail, type);
+  }
+}
+
+// Shared by layernorm and rmsnorm. The latter has no mean subtraction and no
+// `beta` term.
+IREE_UK_ATTRIBUTE_ALWAYS_INLINE static inline void
+iree_uk_norm_row_x86_64_avx2_fma_impl(void* out_row, const void* in_row,
+                                      const void* gamma_row,
+                                      const void* beta_row,
+                                      iree_uk_index_t size1, float epsilon,
+                                      bool fast, bool layernorm,
+                                      iree_uk_normalize_type_t type) {
+  const iree_uk_index_t esize =
+      iree_uk_type_size(iree_uk_normalize_in_type(type));
+  const char* in = in_row;
+  const char* gamma = gamma_row;
+  const char* beta = beta_row;
+  char* out = out_row;
+  const int tail = size1 & 7;
+  const iree_uk_index_t size1_8 = size1 - tail;
+  iree_uk_index_t j = 0;
+  __m256 mean = _mm256_setzero_ps();
+  if (layernorm) {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    for (j = 0; j + 16 <= size1; j += 16) {
+      sum0 = _mm256_add_ps(sum0, iree_uk_load_8xf32_avx2(in + j * esize, type));
+      sum1 = _mm256_add_ps(
+          sum1, iree_uk_load_8xf32_avx2(in + (j + 8) * esize, type));
+    }
+    for (; j < size1_8; j += 8) {
+      sum0 = _mm256_add_ps(sum0, iree_uk_load_8xf32_avx2(in + j * esize, type));
+    }
+    if (tail) {
+      sum1 = _mm256_add_ps(
+          sum1, iree_uk_load_partial_8xf32_avx2(in + j * esize, tail, type));
+    }
+    float sum = iree_uk_reduce_add_8xf32_avx2(_mm256_add_ps(sum0, sum1));
+    mean = _mm256_set1_ps(sum / (float)size1);
+  }
+  // Sum of squared deviations from `mean`, which is zero for rmsnorm.
+  __m256 sq0 = _mm256_setzero_ps();
+  __m256 sq1 = _mm256_setzero_ps();
+  for (j = 0; j + 16 <= size1; j += 16) {
+    __m256 x0 = iree_uk_load_8xf32_avx2(in + j * esize, type);
+    __m256 x1 = iree_uk_load_8xf32_avx2(in + (j + 8) * esize, type);
+    __m256 d0 = _mm256_sub_ps(x0, mean);
+    __m256 d1 = _mm256_sub_ps(x1, mean);
+    sq0 = _mm256_fmadd_ps(d0, d0, sq0);
+    sq1 = _mm256_fmadd_ps(d1, d1, sq1);
+  }
+  for (; j < size1_8; j += 8) {
+    __m256 x = iree_uk_load_8xf32_avx2(in + j * esize, type);
+    __m256 d = _mm256_sub_ps(x, mean);
+    sq0 = _mm256_fmadd_ps(d, d, sq0);
+  }
+  if (tail) {
+    __m256 x = iree_uk_load_partial_8xf32_avx2(in + j * esize, tail, type);
+    __m256 d =
+        _mm256_and_ps(_mm256_sub_ps(x, mean), iree_uk_mask_8xf32_avx2(tail));
+    sq1 = _mm256_fmadd_ps(d, d, sq1);
+  }
+  float sum_sq = iree_uk_reduce_add_8xf32_avx2(_mm256_add_ps(sq0, sq1));
+  float var = sum_sq / (float)size1;
+  __m256 rstd =
+      _mm256_set1_ps(iree_uk_normalize_rsqrt_f32(var + epsilon, fast));
+  // out = (x - mean) * rstd * gamma (+ beta).
+  for (j = 0; j < size1_8; j += 8) {
+    __m256 x = iree_uk_load_8xf32_avx2(in + j * esize, type);
+    __m256 g = iree_uk_load_8xf32_avx2(gamma + j * esize, type);
+    __m256 d = _mm256_sub_ps(x, mean);
+    __m256 s = _mm256_mul_ps(rstd, g);
+    __m256 y;
+    if (layernorm) {
+      __m256 b = iree_uk_load_8xf32_avx2(beta + j * esize, type);
+      y = _mm256_fmadd_ps(d, s, b);
+    } else {
+      y = _mm256_mul_ps(d, s);
+    }
+    iree_uk_store_8xf32_avx2(out + j * esize, y, type);
+  }
+  if (tail) {
+    __m256 x = iree_uk_load_partial_8xf32_avx2(in + j * esize, tail, type);
+    __m256 g = iree_uk_load_partial_8xf32_avx2(gamma + j * esize, tail, type);
+    __m256 d = _mm256_sub_ps(x, mean);
+    __m256 s = _mm256_mul_ps(rstd, g);
+    __m256 y;
+    if (layernorm) {
+      __m256 b = iree_uk_load_partial_8xf32_avx2(beta + j * esize, tail, type);
+      y = _mm256_fmadd_ps(d, s, b);
+    } else {
+      y = _mm256_mul_ps(d, s);
+    }
+    iree_uk_store_partial_8xf32_avx2(out + j * esize, y, tail, type);
+  }
+}
+
+void iree_uk_softmax_row_x86_64_avx2_fma(void* out_row, const void* in_row,
+                                         const void* gamma, const void* beta,
+                                         iree_uk_index_t size1, float epsilon,
+                                         iree_uk_uint32_t flags) {
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  switch (iree_uk_normalize_type(flags)) {
+    case iree_uk_normalize_type_f16f16:
+      iree_uk_softmax_row_x86_64_avx2_fma_impl(out_row, in_row, size1, fast,
+                                               iree_uk_normalize_type_f16f16);
+      return;
+    case iree_uk_normalize_type_bf16bf16:
+      iree_uk_softmax_row_x86_64_avx2_fma_impl(
+          out_row, in_row, size1, fast, iree_uk_normalize_type_bf16bf16);
+      return;
+    default:
+      iree_uk_softmax_row_x86_64_avx2_fma_impl(out_row, in_row, size1, fast,
+                                               iree_uk_normalize_type_f32f32);
+      return;
+  }
+}
+
+void iree_uk_layernorm_row_x86_64_avx2_fma(void* out_row, const void* in_row,
+                                           const void* gamma, const void* beta,
+                                           iree_uk_index_t size1, float epsilon,
+                                           iree_uk_uint32_t flags) {
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  switch (iree_uk_normalize_type(flags)) {
+    case iree_uk_normalize_type_f16f16:
+      iree_uk_norm_row_x86_64_avx2_fma_impl(
+          out_row, in_row, gamma, beta, size1, epsilon, fast,
+          /*layernorm=*/true, iree_uk_normalize_type_f16f16);
+      return;
+    case iree_uk_normalize_type_bf16bf16:
+      iree_uk_norm_row_x86_64_avx2_fma_impl(
+          out_row, in_row, gamma, beta, size1, epsilon, fast,
+          /*layernorm=*/true, iree_uk_normalize_type_bf16bf16);
+      return;
+    default:
+      iree_uk_norm_row_x86_64_avx2_fma_impl(
+          out_row, in_row, gamma, beta, size1, epsilon, fast,
+          /*layernorm=*/true, iree_uk_normalize_type_f32f32);
+      return;
+  }
+}
+
+void iree_uk_rmsnorm_row_x86_64_avx2_fma(void* out_row, const void* in_row,
+                                         const void* gamma, const void* beta,
+                                         iree_uk_index_t size1, float epsilon,
+                                         iree_uk_uint32_t flags) {
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  switch (iree_uk_normalize_type(flags)) {
+    case iree_uk_normalize_type_f16f16:
+      iree_uk_norm_row_x86_64_avx2_fma_impl(
+          out_row, in_row, gamma, beta, size1, epsilon, fast,
+          /*layernorm=*/false, iree_uk_normalize_type_f16f16);
+      return;
+    case iree_uk_normalize_type_bf16bf16:
+      iree_uk_norm_row_x86_64_avx2_fma_impl(
+          out_row, in_row, gamma, beta, size1, epsilon, fast,
+          /*layernorm=*/false, iree_uk_normalize_type_bf16bf16);
+      return;
+    default:
+      iree_uk_norm_row_x86_64_avx2_fma_impl(
+          out_row, in_row, gamma, beta, size1, epsilon, fast,
+          /*layernorm=*/false, iree_uk_normalize_type_f32f32);
+      return;
+  }
+}
@@ -0,0 +1,307 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/arch/x86_64/common_x86_64.h"
+#include "iree/builtins/ukernel/arch/x86_64/normalize_x86_64_internal.h"
+
+// Same structure as the AVX2 kernels, with row tails handled by masked loads
+// and stores instead of going through a temporary buffer.
+
+static inline __m512 iree_uk_load_16xf32_avx512(const void* src, __mmask16 m,
+                                                iree_uk_normalize_type_t type) {
+  if (type == iree_uk_normalize_type_f16f16) {
+    return _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(m, src));
+  }
+  if (type == iree_uk_normalize_type_bf16bf16) {
+    return _mm512_castsi512_ps(_mm512_slli_epi32(
+        _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(m, src)), 16));
+  }
+  return _mm512_maskz_loadu_ps(m, src);
+}
+
+// Rounds to nearest-even, preserving NaNs as quiet NaNs.
+static inline __m256i iree_uk_cvt_16xf32_to_16xbf16_avx512(__m512 v) {
+  __m512i u = _mm512_castps_si512(v);
+  __m512i lsb =
+      _mm512_and_si512(_mm512_srli_epi32(u, 16), _mm512_set1_epi32(1));
+  __m512i rounded =
+      _mm512_add_epi32(u, _mm512_add_epi32(lsb, _mm512_set1_epi32(0x7FFF)));
+  __mmask16 is_nan = _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q);
+  rounded = _mm512_mask_or_epi32(rounded, is_nan, u,
+                                 _mm512_set1_epi32(0x400000));
+  return _mm512_cvtepi32_epi16(_mm512_srli_epi32(rounded, 16));
+}
+
+static inline void iree_uk_store_16xf32_avx512(void* dst, __mmask16 m,
+                                               __m512 v,
+                                               iree_uk_normalize_type_t type) {
+  if (type == iree_uk_normalize_type_f16f16) {
+    _mm256_mask_storeu_epi16(dst, m,
+                             _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+  } else if (type == iree_uk_normalize_type_bf16bf16) {
+    _mm256_mask_storeu_epi16(dst, m, iree_uk_cvt_16xf32_to_16xbf16_avx512(v));
+  } else {
+    _mm512_mask_storeu_ps(dst, m, v);
+  }
+}
+
+// Vector version of iree_uk_normalize_exp_f32, applied to `x - max`.
+static inline __m512 iree_uk_exp_sub_16xf32_avx512(__m512 x, __m512 max,
+                                                   bool fast) {
+  x = _mm512_sub_ps(x, max);
+  x = _mm512_max_ps(x, _mm512_set1_ps(IREE_UK_EXP_F32_LO));
+  x = _mm512_min_ps(x, _mm512_set1_ps(IREE_UK_EXP_F32_HI));
+  __m512 nf = _mm512_roundscale_ps(
+      _mm512_mul_ps(x, _mm512_set1_ps(IREE_UK_EXP_F32_LOG2E)),
+      _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  __m512 r = _mm512_fnmadd_ps(nf, _mm512_set1_ps(IREE_UK_EXP_F32_LN2_HI), x);
+  r = _mm512_fnmadd_ps(nf, _mm512_set1_ps(IREE_UK_EXP_F32_LN2_LO), r);
+  __m512 p;
+  if (fast) {
+    p = _mm512_set1_ps(IREE_UK_EXP_F32_FAST_Q0);
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(IREE_UK_EXP_F32_FAST_Q1));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(IREE_UK_EXP_F32_FAST_Q2));
+  } else {
+    p = _mm512_set1_ps(IREE_UK_EXP_F32_P0);
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(IREE_UK_EXP_F32_P1));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(IREE_UK_EXP_F32_P2));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(IREE_UK_EXP_F32_P3));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(IREE_UK_EXP_F32_P4));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(IREE_UK_EXP_F32_P5));
+  }
+  __m512 y = _mm512_fmadd_ps(_mm512_mul_ps(p, r), r,
+                             _mm512_add_ps(r, _mm512_set1_ps(1.f)));
+  // vscalefps computes y * 2^nf without integer exponent manipulation.
+  return _mm512_scalef_ps(y, nf);
+}
+
+IREE_UK_ATTRIBUTE_ALWAYS_INLINE static inline void
+iree_uk_softmax_row_x86_64_avx512_base_impl(void* out_row, const void* in_row,
+                                            iree_uk_index_t size1, bool fast,
+                                            iree_uk_normalize_type_t type) {
+  const iree_uk_index_t esize =
+      iree_uk_type_size(iree_uk_normalize_in_type(type));
+  const char* in = in_row;
+  char* out = out_row;
+  const int tail = size1 & 15;
+  const iree_uk_index_t size1_16 = size1 - tail;
+  const __mmask16 all = 0xFFFF;
+  const __mmask16 tail_mask = (1u << tail) - 1;
+  // Pass 1: row max. Two accumulators to hide the latency of vmaxps.
+  __m512 max0 = _mm512_castsi512_ps(_mm512_set1_epi32(0xFF800000));  // -inf
+  __m512 max1 = max0;
+  iree_uk_index_t j = 0;
+  for (; j + 32 <= size1; j += 32) {
+    __m512 x0 = iree_uk_load_16xf32_avx512(in + j * esize, all, type);
+    __m512 x1 = iree_uk_load_16xf32_avx512(in + (j + 16) * esize, all, type);
+    max0 = _mm512_max_ps(max0, x0);
+    max1 = _mm512_max_ps(max1, x1);
+  }
+  for (; j < size1_16; j += 16) {
+    __m512 x = iree_uk_load_16xf32_avx512(in + j * esize, all, type);
+    max0 = _mm512_max_ps(max0, x);
+  }
+  if (tail) {
+    __m512 x = iree_uk_load_16xf32_avx512(in + j * esize, tail_mask, type);
+    max1 = _mm512_mask_max_ps(max1, tail_mask, max1, x);
+  }
+  __m512 max = _mm512_set1_ps(_mm512_reduce_max_ps(_mm512_max_ps(max0, max1)));
+  // Pass 2: sum of exp(x - max). For f32, the exponentials are stored to the
+  // output and rescaled in pass 3. For 16-bit types, they are recomputed in
+  // pass 3 instead, to avoid rounding them to the output type twice.
+  const bool store_exp = type == iree_uk_normalize_type_f32f32;
+  __m512 sum0 = _mm512_setzero_ps();
+  __m512 sum1 = _mm512_setzero_ps();
+  for (j = 0; j + 32 <= size1; j += 32) {
+    __m512 x0 = iree_uk_load_16xf32_avx512(in + j * esize, all, type);
+    __m512 x1 = iree_uk_load_16xf32_avx512(in + (j + 16) * esize, all, type);
+    __m512 e0 = iree_uk_exp_sub_16xf32_avx512(x0, max, fast);
+    __m512 e1 = iree_uk_exp_sub_16xf32_avx512(x1, max, fast);
+    sum0 = _mm512_add_ps(sum0, e0);
+    sum1 = _mm512_add_ps(sum1, e1);
+    if (store_exp) {
+      _mm512_storeu_ps(out + j * esize, e0);
+      _mm512_storeu_ps(out + (j + 16) * esize, e1);
+    }
+  }
+  for (; j < size1_16; j += 16) {
+    __m512 x = iree_uk_load_16xf32_avx512(in + j * esize, all, type);
+    __m512 e = iree_uk_exp_sub_16xf32_avx512(x, max, fast);
+    sum0 = _mm512_add_ps(sum0, e);
+    if (store_exp) _mm512_storeu_ps(out + j * esize, e);
+  }
+  if (tail) {
+    __m512 x = iree_uk_load_16xf32_avx512(in + j * esize, tail_mask, type);
+    __m512 e = iree_uk_exp_sub_16xf32_avx512(x, max, fast);
+    sum1 = _mm512_mask_add_ps(sum1, tail_mask, sum1, e);
+    if (store_exp) _mm512_mask_storeu_ps(out + j * esize, tail_mask, e);
+  }
+  float sum = _mm512_reduce_add_ps(_mm512_add_ps(sum0, sum1));
+  __m512 inv_sum = _mm512_set1_ps(1.f / sum);
+  // Pass 3: scale.
+  for (j = 0; j < size1; j += 16) {
+    __mmask16 m = j < size1_16 ? all : tail_mask;
+    __m512 e;
+    if (store_exp) {
+      e = _mm512_maskz_loadu_ps(m, out + j * esize);
+    } else {
+      __m512 x = iree_uk_load_16xf32_avx512(in + j * esize, m, type);
+      e = iree_uk_exp_sub_16xf32_avx512(x, max, fast);
+    }
+    iree_uk_store_16xf32_avx512(out + j * esize, m, _mm512_mul_ps(e, inv_sum),
+                                type);
+  }
+}
+
+// Shared by layernorm and rmsnorm. The latter has no mean subtraction and no
+// `beta` term.
+IREE_UK_ATTRIBUTE_ALWAYS_INLINE static inline void
+iree_uk_norm_row_x86_64_avx512_base_impl(void* out_row, const void* in_row,
+                                         const void* gamma_row,
+                                         const void* beta_row,
+                                         iree_uk_index_t size1, float epsilon,
+                                         bool fast, bool layernorm,
+                                         iree_uk_normalize_type_t type) {
+  const iree_uk_index_t esize =
+      iree_uk_type_size(iree_uk_normalize_in_type(type));
+  const char* in = in_row;
+  const char* gamma = gamma_row;
+  const char* beta = beta_row;
+  char* out = out_row;
+  const int tail = size1 & 15;
+  const iree_uk_index_t size1_16 = size1 - tail;
+  const __mmask16 all = 0xFFFF;
+  const __mmask16 tail_mask = (1u << tail) - 1;
+  iree_uk_index_t j = 0;
+  __m512 mean = _mm512_setzero_ps();
+  if (layernorm) {
+    __m512 sum0 = _mm512_setzero_ps();
+    __m512 sum1 = _mm512_setzero_ps();
+    for (j = 0; j + 32 <= size1; j += 32) {
+      __m512 x0 = iree_uk_load_16xf32_avx512(in + j * esize, all, type);
+      __m512 x1 = iree_uk_load_16xf32_avx512(in + (j + 16) * esize, all, type);
+      sum0 = _mm512_add_ps(sum0, x0);
+      sum1 = _mm512_add_ps(sum1, x1);
+    }
+    for (; j < size1_16; j += 16) {
+      __m512 x = iree_uk_load_16xf32_avx512(in + j * esize, all, type);
+      sum0 = _mm512_add_ps(sum0, x);
+    }
+    if (tail) {
+      __m512 x = iree_uk_load_16xf32_avx512(in + j * esize, tail_mask, type);
+      sum1 = _mm512_add_ps(sum1, x);
+    }
+    float sum = _mm512_reduce_add_ps(_mm512_add_ps(sum0, sum1));
+    mean = _mm512_set1_ps(sum / (float)size1);
+  }
+  // Sum of squared deviations from `mean`, which is zero for rmsnorm.
+  __m512 sq0 = _mm512_setzero_ps();
+  __m512 sq1 = _mm512_setzero_ps();
+  for (j = 0; j + 32 <= size1; j += 32) {
+    __m512 x0 = iree_uk_load_16xf32_avx512(in + j * esize, all, type);
+    __m512 x1 = iree_uk_load_16xf32_avx512(in + (j + 16) * esize, all, type);
+    __m512 d0 = _mm512_sub_ps(x0, mean);
+    __m512 d1 = _mm512_sub_ps(x1, mean);
+    sq0 = _mm512_fmadd_ps(d0, d0, sq0);
+    sq1 = _mm512_fmadd_ps(d1, d1, sq1);
+  }
+  for (; j < size1_16; j += 16) {
+    __m512 x = iree_uk_load_16xf32_avx512(in + j * esize, all, type);
+    __m512 d = _mm512_sub_ps(x, mean);
+    sq0 = _mm512_fmadd_ps(d, d, sq0);
+  }
+  if (tail) {
+    __m512 x = iree_uk_load_16xf32_avx512(in + j * esize, tail_mask, type);
+    __m512 d = _mm512_sub_ps(x, mean);
+    sq1 = _mm512_mask3_fmadd_ps(d, d, sq1, tail_mask);
+  }
+  float sum_sq = _mm512_reduce_add_ps(_mm512_add_ps(sq0, sq1));
+  float var = sum_sq / (float)size1;
+  __m512 rstd =
+      _mm512_set1_ps(iree_uk_normalize_rsqrt_f32(var + epsilon, fast));
+  // out = (x - mean) * rstd * gamma (+ beta).
+  for (j = 0; j < size1; j += 16) {
+    __mmask16 m = j < size1_16 ? all : tail_mask;
+    __m512 x = iree_uk_load_16xf32_avx512(in + j * esize, m, type);
+    __m512 g = iree_uk_load_16xf32_avx512(gamma + j * esize, m, type);
+    __m512 d = _mm512_sub_ps(x, mean);
+    __m512 s = _mm512_mul_ps(rstd, g);
+    __m512 y;
+    if (layernorm) {
+      __m512 b = iree_uk_load_16xf32_avx512(beta + j * esize, m, type);
+      y = _mm512_fmadd_ps(d, s, b);
+    } else {
+      y = _mm512_mul_ps(d, s);
+    }
+    iree_uk_store_16xf32_avx512(out + j * esize, m, y, type);
+  }
+}
+
+void iree_uk_softmax_row_x86_64_avx512_base(
+    void* out_row, const void* in_row, const void* gamma, const void* beta,
+    iree_uk_index_t size1, float epsilon, iree_uk_uint32_t flags) {
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  switch (iree_uk_normalize_type(flags)) {
+    case iree_uk_normalize_type_f16f16:
+      iree_uk_softmax_row_x86_64_avx512_base_impl(
+          out_row, in_row, size1, fast, iree_uk_normalize_type_f16f16);
+      return;
+    case iree_uk_normalize_type_bf16bf16:
+      iree_uk_softmax_row_x86_64_avx512_base_impl(
+          out_row, in_row, size1, fast, iree_uk_normalize_type_bf16bf16);
+      return;
+    default:
+      iree_uk_softmax_row_x86_64_avx512_base_impl(
+          out_row, in_row, size1, fast, iree_uk_normalize_type_f32f32);
+      return;
+  }
+}
+
+void iree_uk_layernorm_row_x86_64_avx512_base(
+    void* out_row, const void* in_row, const void* gamma, const void* beta,
+    iree_uk_index_t size1, float epsilon, iree_uk_uint32_t flags) {
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  switch (iree_uk_normalize_type(flags)) {
+    case iree_uk_normalize_type_f16f16:
+      iree_uk_norm_row_x86_64_avx512_base_impl(
+          out_row, in_row, gamma, beta, size1, epsilon, fast,
+          /*layernorm=*/true, iree_uk_normalize_type_f16f16);
+      return;
+    case iree_uk_normalize_type_bf16bf16:
+      iree_uk_norm_row_x86_64_avx512_base_impl(
+          out_row, in_row, gamma, beta, size1, epsilon, fast,
+          /*layernorm=*/true, iree_uk_normalize_type_bf16bf16);
+      return;
+    default:
+      iree_uk_norm_row_x86_64_avx512_base_impl(
+          out_row, in_row, gamma, beta, size1, epsilon, fast,
+          /*layernorm=*/true, iree_uk_normalize_type_f32f32);
+      return;
+  }
+}
+
+void iree_uk_rmsnorm_row_x86_64_avx512_base(
+    void* out_row, const void* in_row, const void* gamma, const void* beta,
+    iree_uk_index_t size1, float epsilon, iree_uk_uint32_t flags) {
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  switch (iree_uk_normalize_type(flags)) {
+    case iree_uk_normalize_type_f16f16:
+      iree_uk_norm_row_x86_64_avx512_base_impl(
+          out_row, in_row, gamma, beta, size1, epsilon, fast,
+          /*layernorm=*/false, iree_uk_normalize_type_f16f16);
+      return;
+    case iree_uk_normalize_type_bf16bf16:
+      iree_uk_norm_row_x86_64_avx512_base_impl(
+          out_row, in_row, gamma, beta, size1, epsilon, fast,
+          /*layernorm=*/false, iree_uk_normalize_type_bf16bf16);
+      return;
+    default:
+      iree_uk_norm_row_x86_64_avx512_base_impl(
+          out_row, in_row, gamma, beta, size1, epsilon, fast,
+          /*layernorm=*/false, iree_uk_normalize_type_f32f32);
+      return;
+  }
+}
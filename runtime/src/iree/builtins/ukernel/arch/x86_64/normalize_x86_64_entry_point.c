@@ -0,0 +1,39 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/arch/x86_64/common_x86_64.h"
+#include "iree/builtins/ukernel/arch/x86_64/normalize_x86_64_internal.h"
+
+iree_uk_normalize_row_func_t iree_uk_normalize_select_row_func_arch(
+    const iree_uk_normalize_params_t* params) {
+  // The row kernels handle any row length and all element types, so the only
+  // selection criteria are the op and the CPU features.
+#if defined(IREE_UK_BUILD_X86_64_AVX512_BASE)
+  if (iree_uk_cpu_x86_64_avx512_base(params->cpu_data)) {
+    switch (params->op) {
+      case iree_uk_normalize_op_softmax:
+        return iree_uk_softmax_row_x86_64_avx512_base;
+      case iree_uk_normalize_op_layernorm:
+        return iree_uk_layernorm_row_x86_64_avx512_base;
+      case iree_uk_normalize_op_rmsnorm:
+        return iree_uk_rmsnorm_row_x86_64_avx512_base;
+    }
+  }
+#endif
+#if defined(IREE_UK_BUILD_X86_64_AVX2_FMA)
+  if (iree_uk_cpu_x86_64_avx2_fma(params->cpu_data)) {
+    switch (params->op) {
+      case iree_uk_normalize_op_softmax:
+        return iree_uk_softmax_row_x86_64_avx2_fma;
+      case iree_uk_normalize_op_layernorm:
+        return iree_uk_layernorm_row_x86_64_avx2_fma;
+      case iree_uk_normalize_op_rmsnorm:
+        return iree_uk_rmsnorm_row_x86_64_avx2_fma;
+    }
+  }
+#endif
+  return 0;
+}
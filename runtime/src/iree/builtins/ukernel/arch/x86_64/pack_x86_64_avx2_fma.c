@@ -7,6 +7,35 @@
 #include "iree/builtins/ukernel/arch/x86_64/common_x86_64.h"
 #include "iree/builtins/ukernel/arch/x86_64/pack_x86_64_internal.h"
 
+IREE_UK_ATTRIBUTE_ALWAYS_INLINE static inline void
+iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma(
+    void* IREE_UK_RESTRICT out_tile_ptr,
+    const void* IREE_UK_RESTRICT in_tile_ptr, iree_uk_index_t outer_size1,
+    iree_uk_index_t out_stride1, iree_uk_index_t in_stride0, bool transpose,
+    bool nontemporal) {
+  const iree_uk_int8_t* IREE_UK_RESTRICT in_ptr = in_tile_ptr;
+  iree_uk_int8_t* IREE_UK_RESTRICT out_ptr = out_tile_ptr;
+  for (; outer_size1 > 0; --outer_size1) {
+    __m256i rows[8];
+    for (int i = 0; i < 8; ++i) {
+      rows[i] =
+          _mm256_loadu_si256((const __m256i*)(in_ptr + i * 4 * in_stride0));
+    }
+    if (transpose) iree_uk_avx2_transpose_8x8xi32(rows);
+    for (int i = 0; i < 8; ++i) {
+      if (nontemporal) {
+        _mm256_stream_si256((__m256i*)(out_ptr + i * 32), rows[i]);
+      } else {
+        _mm256_storeu_si256((__m256i*)(out_ptr + i * 32), rows[i]);
+      }
+    }
+    out_ptr += 4 * out_stride1;
+    in_ptr += 32;
+  }
+  // Order the non-temporal stores before whatever the caller does next.
+  if (nontemporal) _mm_sfence();
+}
+
 void iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma_direct(
     void* IREE_UK_RESTRICT out_tile_ptr,
     const void* IREE_UK_RESTRICT in_tile_ptr, iree_uk_index_t outer_size1,
@@ -16,16 +45,99 @@ void iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma_direct(
   IREE_UK_ASSERT(elem_size == 4);
   IREE_UK_ASSERT(tile_size0 == 8);
   IREE_UK_ASSERT(tile_size1 == 8);
+  iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma(out_tile_ptr, in_tile_ptr,
+                                            outer_size1, out_stride1,
+                                            in_stride0, false, false);
+}
+
+void iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma_transpose(
+    void* IREE_UK_RESTRICT out_tile_ptr,
+    const void* IREE_UK_RESTRICT in_tile_ptr, iree_uk_index_t outer_size1,
+    iree_uk_index_t out_stride1, iree_uk_index_t in_stride0,
+    iree_uk_index_t elem_size, iree_uk_index_t tile_size0,
+    iree_uk_index_t tile_size1) {
+  IREE_UK_ASSERT(elem_size == 4);
+  IREE_UK_ASSERT(tile_size0 == 8);
+  IREE_UK_ASSERT(tile_size1 == 8);
+  iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma(out_tile_ptr, in_tile_ptr,
+                                            outer_size1, out_stride1,
+                                            in_stride0, true, false);
+}
+
+void iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma_direct_nt(
+    void* IREE_UK_RESTRICT out_tile_ptr,
+    const void* IREE_UK_RESTRICT in_tile_ptr, iree_uk_index_t outer_size1,
+    iree_uk_index_t out_stride1, iree_uk_index_t in_stride0,
+    iree_uk_index_t elem_size, iree_uk_index_t tile_size0,
+    iree_uk_index_t tile_size1) {
+  IREE_UK_ASSERT(elem_size == 4);
+  IREE_UK_ASSERT(tile_size0 == 8);
+  IREE_UK_ASSERT(tile_size1 == 8);
+  iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma(out_tile_ptr, in_tile_ptr,
+                                            outer_size1, out_stride1,
+                                            in_stride0, false, true);
+}
+
+void iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma_transpose_nt(
+    void* IREE_UK_RESTRICT out_tile_ptr,
+    const void* IREE_UK_RESTRICT in_tile_ptr, iree_uk_index_t outer_size1,
+    iree_uk_index_t out_stride1, iree_uk_index_t in_stride0,
+    iree_uk_index_t elem_size, iree_uk_index_t tile_size0,
+    iree_uk_index_t tile_size1) {
+  IREE_UK_ASSERT(elem_size == 4);
+  IREE_UK_ASSERT(tile_size0 == 8);
+  IREE_UK_ASSERT(tile_size1 == 8);
+  iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma(out_tile_ptr, in_tile_ptr,
+                                            outer_size1, out_stride1,
+                                            in_stride0, true, true);
+}
+
+IREE_UK_ATTRIBUTE_ALWAYS_INLINE static inline void
+iree_uk_pack_tile_8x8_x16_x86_64_avx2_fma(
+    void* IREE_UK_RESTRICT out_tile_ptr,
+    const void* IREE_UK_RESTRICT in_tile_ptr, iree_uk_index_t outer_size1,
+    iree_uk_index_t out_stride1, iree_uk_index_t in_stride0, bool transpose) {
   const iree_uk_int8_t* IREE_UK_RESTRICT in_ptr = in_tile_ptr;
   iree_uk_int8_t* IREE_UK_RESTRICT out_ptr = out_tile_ptr;
   for (; outer_size1 > 0; --outer_size1) {
-    iree_uk_copy_8x32xi8_strided_to_strided(out_ptr, in_ptr, 32,
-                                            4 * in_stride0);
-    out_ptr += 4 * out_stride1;
-    in_ptr += 32;
+    if (transpose) {
+      iree_uk_avx2_copy_8x8xi16_transpose_strided_to_strided(
+          out_ptr, in_ptr, 16, 2 * in_stride0);
+    } else {
+      iree_uk_copy_8x16xi8_strided_to_strided(out_ptr, in_ptr, 16,
+                                              2 * in_stride0);
+    }
+    out_ptr += 2 * out_stride1;
+    in_ptr += 16;
   }
 }
 
+void iree_uk_pack_tile_8x8_x16_x86_64_avx2_fma_direct(
+    void* IREE_UK_RESTRICT out_tile_ptr,
+    const void* IREE_UK_RESTRICT in_tile_ptr, iree_uk_index_t outer_size1,
+    iree_uk_index_t out_stride1, iree_uk_index_t in_stride0,
+    iree_uk_index_t elem_size, iree_uk_index_t tile_size0,
+    iree_uk_index_t tile_size1) {
+  IREE_UK_ASSERT(elem_size == 2);
+  IREE_UK_ASSERT(tile_size0 == 8);
+  IREE_UK_ASSERT(tile_size1 == 8);
+  iree_uk_pack_tile_8x8_x16_x86_64_avx2_fma(
+      out_tile_ptr, in_tile_ptr, outer_size1, out_stride1, in_stride0, false);
+}
+
+void iree_uk_pack_tile_8x8_x16_x86_64_avx2_fma_transpose(
+    void* IREE_UK_RESTRICT out_tile_ptr,
+    const void* IREE_UK_RESTRICT in_tile_ptr, iree_uk_index_t outer_size1,
+    iree_uk_index_t out_stride1, iree_uk_index_t in_stride0,
+    iree_uk_index_t elem_size, iree_uk_index_t tile_size0,
+    iree_uk_index_t tile_size1) {
+  IREE_UK_ASSERT(elem_size == 2);
+  IREE_UK_ASSERT(tile_size0 == 8);
+  IREE_UK_ASSERT(tile_size1 == 8);
+  iree_uk_pack_tile_8x8_x16_x86_64_avx2_fma(
+      out_tile_ptr, in_tile_ptr, outer_size1, out_stride1, in_stride0, true);
+}
+
 static void iree_uk_pack_tile_8x4_x8_x86_64_avx2_fma_direct(
     void* IREE_UK_RESTRICT out_tile_ptr,
     const void* IREE_UK_RESTRICT in_tile_ptr, iree_uk_index_t outer_size1,
@@ -82,6 +194,38 @@ void iree_uk_pack_tile_8x1_x32_x86_64_avx2_fma_transpose(
   }
 }
 
+void iree_uk_pack_tile_8x1_x16_x86_64_avx2_fma_direct(
+    void* IREE_UK_RESTRICT out_tile_ptr,
+    const void* IREE_UK_RESTRICT in_tile_ptr, iree_uk_index_t outer_size1,
+    iree_uk_index_t out_stride1, iree_uk_index_t in_stride0,
+    iree_uk_index_t elem_size, iree_uk_index_t tile_size0,
+    iree_uk_index_t tile_size1) {
+  IREE_UK_ASSERT(elem_size == 2);
+  IREE_UK_ASSERT(tile_size0 == 8);
+  IREE_UK_ASSERT(tile_size1 == 1);
+  iree_uk_pack_tile_8x2_x8_x86_64_avx2_fma_direct(out_tile_ptr, in_tile_ptr,
+                                                  outer_size1, out_stride1 * 2,
+                                                  in_stride0 * 2, 1, 8, 2);
+}
+
+void iree_uk_pack_tile_8x1_x16_x86_64_avx2_fma_transpose(
+    void* IREE_UK_RESTRICT out_tile_ptr,
+    const void* IREE_UK_RESTRICT in_tile_ptr, iree_uk_index_t outer_size1,
+    iree_uk_index_t out_stride1, iree_uk_index_t in_stride0,
+    iree_uk_index_t elem_size, iree_uk_index_t tile_size0,
+    iree_uk_index_t tile_size1) {
+  IREE_UK_ASSERT(elem_size == 2);
+  IREE_UK_ASSERT(tile_size0 == 1);
+  IREE_UK_ASSERT(tile_size1 == 8);
+  const iree_uk_int16_t* IREE_UK_RESTRICT in_tile_ptr_i16 = in_tile_ptr;
+  iree_uk_int16_t* IREE_UK_RESTRICT out_tile_i16_ptr = out_tile_ptr;
+  for (; outer_size1 > 0; --outer_size1) {
+    iree_uk_memcpy(out_tile_i16_ptr, in_tile_ptr_i16, 16);
+    out_tile_i16_ptr += out_stride1;
+    in_tile_ptr_i16 += 8;
+  }
+}
+
 void iree_uk_pack_tile_8x2_x8_x86_64_avx2_fma_direct(
     void* IREE_UK_RESTRICT out_tile_ptr,
     const void* IREE_UK_RESTRICT in_tile_ptr, iree_uk_index_t outer_size1,
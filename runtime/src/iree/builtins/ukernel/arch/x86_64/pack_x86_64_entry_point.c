@@ -7,12 +7,39 @@
 #include "iree/builtins/ukernel/arch/x86_64/common_x86_64.h"
 #include "iree/builtins/ukernel/arch/x86_64/pack_x86_64_internal.h"
 
+// Minimum destination size for which the pack tile functions that support it
+// use non-temporal stores. These bypass the caches, which pays off when the
+// destination is too large to stay in cache anyway, like when packing weights
+// at load time, but would cost a reload from memory if the consumer of the
+// packed data ran right after on a destination that fits in cache.
+#define IREE_UK_PACK_X86_64_NONTEMPORAL_MIN_BYTES (1 << 20)
+
+// Returns true if non-temporal stores should be used for a pack whose output
+// tiles are stored as vectors of `alignment` bytes. Non-temporal stores
+// require aligned addresses.
+static bool iree_uk_pack_x86_64_use_nontemporal_stores(
+    const iree_uk_pack_params_t* params, iree_uk_index_t alignment) {
+  iree_uk_pack_type_t pack_type = iree_uk_pack_type(params->flags);
+  iree_uk_index_t esize = iree_uk_type_size(iree_uk_pack_out_type(pack_type));
+  iree_uk_index_t out_bytes = params->out_size0 * params->out_stride0 * esize;
+  iree_uk_index_t out_address =
+      (iree_uk_index_t)params->out_buffer + params->out_offset * esize;
+  return out_bytes >= IREE_UK_PACK_X86_64_NONTEMPORAL_MIN_BYTES &&
+         !(out_address % alignment) &&
+         !((params->out_stride0 * esize) % alignment);
+}
+
 static iree_uk_pack_tile_func_t iree_uk_pack_select_tile_func_x86_64_8x8_x32(
     const iree_uk_pack_params_t* params) {
 #if defined(IREE_UK_BUILD_X86_64_AVX2_FMA)
   if (iree_uk_cpu_x86_64_avx2_fma(params->cpu_data)) {
     bool transpose = params->flags & IREE_UK_FLAG_PACK_TRANSPOSE_INNER;
-    return transpose ? 0 : iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma_direct;
+    if (iree_uk_pack_x86_64_use_nontemporal_stores(params, 32)) {
+      return transpose ? iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma_transpose_nt
+                       : iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma_direct_nt;
+    }
+    return transpose ? iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma_transpose
+                     : iree_uk_pack_tile_8x8_x32_x86_64_avx2_fma_direct;
   }
 #endif
   return 0;
@@ -23,13 +50,42 @@ static iree_uk_pack_tile_func_t iree_uk_pack_select_tile_func_x86_64_16x16_x32(
 #if defined(IREE_UK_BUILD_X86_64_AVX512_BASE)
   if (iree_uk_cpu_x86_64_avx512_base(params->cpu_data)) {
     bool transpose = params->flags & IREE_UK_FLAG_PACK_TRANSPOSE_INNER;
-    return transpose ? 0
+    if (iree_uk_pack_x86_64_use_nontemporal_stores(params, 64)) {
+      return transpose
+                 ? iree_uk_pack_tile_16x16_x32_x86_64_avx512_base_transpose_nt
+                 : iree_uk_pack_tile_16x16_x32_x86_64_avx512_base_direct_nt;
+    }
+    return transpose ? iree_uk_pack_tile_16x16_x32_x86_64_avx512_base_transpose
                      : iree_uk_pack_tile_16x16_x32_x86_64_avx512_base_direct;
   }
 #endif
   return 0;
 }
 
+static iree_uk_pack_tile_func_t iree_uk_pack_select_tile_func_x86_64_8x8_x16(
+    const iree_uk_pack_params_t* params) {
+#if defined(IREE_UK_BUILD_X86_64_AVX2_FMA)
+  if (iree_uk_cpu_x86_64_avx2_fma(params->cpu_data)) {
+    bool transpose = params->flags & IREE_UK_FLAG_PACK_TRANSPOSE_INNER;
+    return transpose ? iree_uk_pack_tile_8x8_x16_x86_64_avx2_fma_transpose
+                     : iree_uk_pack_tile_8x8_x16_x86_64_avx2_fma_direct;
+  }
+#endif
+  return 0;
+}
+
+static iree_uk_pack_tile_func_t iree_uk_pack_select_tile_func_x86_64_16x16_x16(
+    const iree_uk_pack_params_t* params) {
+#if defined(IREE_UK_BUILD_X86_64_AVX512_BASE)
+  if (iree_uk_cpu_x86_64_avx512_base(params->cpu_data)) {
+    bool transpose = params->flags & IREE_UK_FLAG_PACK_TRANSPOSE_INNER;
+    return transpose ? iree_uk_pack_tile_16x16_x16_x86_64_avx512_base_transpose
+                     : iree_uk_pack_tile_16x16_x16_x86_64_avx512_base_direct;
+  }
+#endif
+  return 0;
+}
+
 static iree_uk_pack_tile_func_t iree_uk_pack_select_tile_func_x86_64_8x1_x32(
     const iree_uk_pack_params_t* params) {
 #if defined(IREE_UK_BUILD_X86_64_AVX2_FMA)
@@ -54,6 +110,30 @@ static iree_uk_pack_tile_func_t iree_uk_pack_select_tile_func_x86_64_16x1_x32(
   return 0;
 }
 
+static iree_uk_pack_tile_func_t iree_uk_pack_select_tile_func_x86_64_8x1_x16(
+    const iree_uk_pack_params_t* params) {
+#if defined(IREE_UK_BUILD_X86_64_AVX2_FMA)
+  if (iree_uk_cpu_x86_64_avx2_fma(params->cpu_data)) {
+    bool transpose = params->flags & IREE_UK_FLAG_PACK_TRANSPOSE_INNER;
+    return transpose ? iree_uk_pack_tile_8x1_x16_x86_64_avx2_fma_transpose
+                     : iree_uk_pack_tile_8x1_x16_x86_64_avx2_fma_direct;
+  }
+#endif
+  return 0;
+}
+
+static iree_uk_pack_tile_func_t iree_uk_pack_select_tile_func_x86_64_16x1_x16(
+    const iree_uk_pack_params_t* params) {
+#if defined(IREE_UK_BUILD_X86_64_AVX512_BASE)
+  if (iree_uk_cpu_x86_64_avx512_base(params->cpu_data)) {
+    bool transpose = params->flags & IREE_UK_FLAG_PACK_TRANSPOSE_INNER;
+    return transpose ? iree_uk_pack_tile_16x1_x16_x86_64_avx512_base_transpose
+                     : iree_uk_pack_tile_16x1_x16_x86_64_avx512_base_direct;
+  }
+#endif
+  return 0;
+}
+
 static iree_uk_pack_tile_func_t iree_uk_pack_select_tile_func_x86_64_16x2_x16(
     const iree_uk_pack_params_t* params) {
 #if defined(IREE_UK_BUILD_X86_64_AVX512_BASE)
@@ -105,6 +185,15 @@ iree_uk_pack_tile_func_t iree_uk_pack_select_tile_func_arch(
     return iree_uk_pack_select_tile_func_x86_64_8x1_x32(params);
   } else if (esize == 4 && params->out_size2 == 16 && params->out_size3 == 1) {
     return iree_uk_pack_select_tile_func_x86_64_16x1_x32(params);
+  } else if (esize == 2 && params->out_size2 == 8 && params->out_size3 == 8) {
+    return iree_uk_pack_select_tile_func_x86_64_8x8_x16(params);
+  } else if (esize == 2 && params->out_size2 == 16 &&
+             params->out_size3 == 16) {
+    return iree_uk_pack_select_tile_func_x86_64_16x16_x16(params);
+  } else if (esize == 2 && params->out_size2 == 8 && params->out_size3 == 1) {
+    return iree_uk_pack_select_tile_func_x86_64_8x1_x16(params);
+  } else if (esize == 2 && params->out_size2 == 16 && params->out_size3 == 1) {
+    return iree_uk_pack_select_tile_func_x86_64_16x1_x16(params);
   } else if (esize == 2 && params->out_size2 == 16 && params->out_size3 == 2) {
     return iree_uk_pack_select_tile_func_x86_64_16x2_x16(params);
   } else if (esize == 1 && params->out_size2 == 8 && params->out_size3 == 2) {
@@ -48,6 +48,17 @@
 // output bit flags for iree_uk_mmt4d_info
 #define IREE_UK_FLAG_MMT4D_INFO_HAVE_ARCHITECTURE_SPECIFIC_TILE_FUNCTION 0x1
 
+//===----------------------------------------------------------------------===//
+// mmt4d_sparse
+//===----------------------------------------------------------------------===//
+
+// mmt4d_sparse takes the mmt4d type enum and bit flags above, plus exactly one
+// of the following sparse RHS formats. See mmt4d_sparse.h.
+#define IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_MASK 0x3000
+#define IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_NONE 0x0000
+#define IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_BLOCK 0x1000
+#define IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_2_4 0x2000
+
 //===----------------------------------------------------------------------===//
 // pack
 //===----------------------------------------------------------------------===//
@@ -82,6 +93,22 @@
 #define IREE_UK_FLAG_UNPACK_TRANSPOSE_INNER 0x100
 #define IREE_UK_FLAG_UNPACK_TRANSPOSE_OUTER 0x200
 
+//===----------------------------------------------------------------------===//
+// normalize (row-wise softmax, layernorm, rmsnorm)
+//===----------------------------------------------------------------------===//
+
+// type enum. Input, output, gamma and beta all share the same element type.
+#define IREE_UK_FLAG_NORMALIZE_TYPE_MASK 0xFF
+#define IREE_UK_FLAG_NORMALIZE_TYPE_NONE 0x00
+#define IREE_UK_FLAG_NORMALIZE_TYPE_F32F32 0x01
+#define IREE_UK_FLAG_NORMALIZE_TYPE_F16F16 0x02
+#define IREE_UK_FLAG_NORMALIZE_TYPE_BF16BF16 0x03
+
+// bit flags
+// Allow cheaper exp/rsqrt approximations with a relative error up to ~1e-4
+// instead of approximations accurate to within a few f32 ulps.
+#define IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS 0x100
+
 //===----------------------------------------------------------------------===//
 // query_tile_sizes
 //===----------------------------------------------------------------------===//
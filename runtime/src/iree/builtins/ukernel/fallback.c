@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
 #include "iree/builtins/ukernel/mmt4d_internal.h"
+#include "iree/builtins/ukernel/normalize_internal.h"
 #include "iree/builtins/ukernel/pack_internal.h"
 #include "iree/builtins/ukernel/query_tile_sizes_internal.h"
 #include "iree/builtins/ukernel/unpack_internal.h"
@@ -24,6 +25,11 @@ iree_uk_unpack_tile_func_t iree_uk_unpack_select_tile_func_arch(
   return 0;
 }
 
+iree_uk_normalize_row_func_t iree_uk_normalize_select_row_func_arch(
+    const iree_uk_normalize_params_t* params) {
+  return 0;
+}
+
 bool iree_uk_query_matmul_tile_sizes_arch(
     const iree_uk_query_tile_sizes_2d_params_t* params,
     iree_uk_matmul_tile_sizes_t* out_matmul_tile_sizes) {
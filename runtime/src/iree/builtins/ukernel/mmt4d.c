@@ -123,6 +123,13 @@ void iree_uk_mmt4d_p(const iree_uk_mmt4d_params_t* params) {
 
   // Select a target-specific tile_func (inner loop on K, computing one M0xN0
   // tile) and use that with generic outer loops.
+  iree_uk_mmt4d_tile_func_t tile_func = iree_uk_mmt4d_select_tile_func(params);
+
+  iree_uk_mmt4d_using_tile_func(params, tile_func);
+}
+
+iree_uk_mmt4d_tile_func_t iree_uk_mmt4d_select_tile_func(
+    const iree_uk_mmt4d_params_t* params) {
   iree_uk_mmt4d_tile_func_t tile_func =
       iree_uk_mmt4d_select_tile_func_arch(params);
 
@@ -137,8 +144,7 @@ void iree_uk_mmt4d_p(const iree_uk_mmt4d_params_t* params) {
           0 && "no target-specific tile function, and fallback not enabled.");
     }
   }
-
-  iree_uk_mmt4d_using_tile_func(params, tile_func);
+  return tile_func;
 }
 
 iree_uk_uint32_t iree_uk_mmt4d_info_p(const iree_uk_mmt4d_params_t* params) {
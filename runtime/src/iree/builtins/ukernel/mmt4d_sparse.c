@@ -0,0 +1,433 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/mmt4d_sparse.h"
+
+#include "iree/builtins/ukernel/exported_bits.h"
+#include "iree/builtins/ukernel/mmt4d_sparse_internal.h"
+
+static iree_uk_uint32_t iree_uk_mmt4d_sparse_format(iree_uk_uint32_t flags) {
+  return flags & IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_MASK;
+}
+
+// Byte size of one M0xK0 LHS tile, N0xK0 RHS tile or M0xN0 output tile.
+static iree_uk_index_t iree_uk_mmt4d_sparse_tile_size(iree_uk_type_t type,
+                                                      iree_uk_index_t size0,
+                                                      iree_uk_index_t size1) {
+  return iree_uk_bits_to_bytes_exact((size0 * size1)
+                                     << iree_uk_type_bit_count_log2(type));
+}
+
+static void iree_uk_mmt4d_sparse_validate(
+    const iree_uk_mmt4d_sparse_params_t* params) {
+#ifdef IREE_UK_ENABLE_ASSERTS
+  const iree_uk_mmt4d_params_t* mmt4d = &params->mmt4d;
+  const iree_uk_uint32_t allflags =
+      IREE_UK_FLAG_MMT4D_TYPE_MASK | IREE_UK_FLAG_MMT4D_ACCUMULATE |
+      IREE_UK_FLAG_MMT4D_SKIP_INTERMEDIATE_ROUNDINGS |
+      IREE_UK_FLAG_MMT4D_ALLOW_GENERIC_FALLBACK_TILE_FUNCTION |
+      IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_MASK;
+  IREE_UK_ASSERT(!(mmt4d->flags & ~allflags));
+  iree_uk_uint32_t flags_type = mmt4d->flags & IREE_UK_FLAG_MMT4D_TYPE_MASK;
+  IREE_UK_ASSERT(flags_type < IREE_UK_FLAG_MMT4D_TYPE_END);
+  IREE_UK_ASSERT(IREE_UK_VALUE_IN_UNSIGNED_INT_RANGE(mmt4d->M, 31));
+  IREE_UK_ASSERT(IREE_UK_VALUE_IN_UNSIGNED_INT_RANGE(mmt4d->N, 31));
+  IREE_UK_ASSERT(IREE_UK_VALUE_IN_UNSIGNED_INT_RANGE(mmt4d->K, 31));
+  IREE_UK_ASSERT(IREE_UK_VALUE_IN_UNSIGNED_INT_RANGE(mmt4d->M0, 15));
+  IREE_UK_ASSERT(IREE_UK_VALUE_IN_UNSIGNED_INT_RANGE(mmt4d->N0, 15));
+  IREE_UK_ASSERT(IREE_UK_VALUE_IN_UNSIGNED_INT_RANGE(mmt4d->K0, 15));
+  iree_uk_mmt4d_type_t mmt4d_type = iree_uk_mmt4d_type(mmt4d->flags);
+  iree_uk_type_t rhs_type = iree_uk_mmt4d_rhs_type(mmt4d_type);
+  IREE_UK_ASSERT(iree_uk_type_bit_count(iree_uk_mmt4d_out_type(mmt4d_type)) >=
+                 8);
+  int lhs_bits = iree_uk_type_bit_count(iree_uk_mmt4d_lhs_type(mmt4d_type));
+  int rhs_bits = iree_uk_type_bit_count(rhs_type);
+  IREE_UK_ASSERT(!((mmt4d->K0 * lhs_bits) % 8));
+  IREE_UK_ASSERT(!((mmt4d->K0 * rhs_bits) % 8));
+  IREE_UK_ASSERT(!((mmt4d->lhs_stride0 * lhs_bits) % 8));
+  switch (iree_uk_mmt4d_sparse_format(mmt4d->flags)) {
+    case IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_BLOCK:
+      IREE_UK_ASSERT(params->rhs_row_offsets);
+      IREE_UK_ASSERT(iree_uk_mmt4d_sparse_tile_size(
+                         iree_uk_mmt4d_lhs_type(mmt4d_type), mmt4d->M0,
+                         mmt4d->K0) <= IREE_UK_MMT4D_SPARSE_BUFFER_SIZE);
+      break;
+    case IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_2_4:
+      IREE_UK_ASSERT(rhs_bits >= 8);
+      IREE_UK_ASSERT(!((mmt4d->K * mmt4d->K0) % 4));
+      IREE_UK_ASSERT(
+          4 * iree_uk_mmt4d_sparse_tile_size(rhs_type, mmt4d->N0, mmt4d->K0) <=
+          IREE_UK_MMT4D_SPARSE_BUFFER_SIZE);
+      break;
+    default:
+      IREE_UK_ASSERT(0 && "unknown sparse RHS format");
+  }
+#endif  // IREE_UK_ENABLE_ASSERTS
+}
+
+// Block-sparse RHS: the LHS tiles matching the nonzero RHS tiles of each row
+// are gathered into a contiguous panel, so that the dense tile function runs
+// once per chunk of nonzero tiles, keeping the accumulator in registers, and
+// zero tiles are never visited.
+static void iree_uk_mmt4d_sparse_block_using_tile_func(
+    const iree_uk_mmt4d_sparse_params_t* params,
+    iree_uk_mmt4d_tile_func_t tile_func) {
+  const iree_uk_mmt4d_params_t* mmt4d = &params->mmt4d;
+  iree_uk_mmt4d_type_t mmt4d_type = iree_uk_mmt4d_type(mmt4d->flags);
+  const iree_uk_type_t lhs_type = iree_uk_mmt4d_lhs_type(mmt4d_type);
+  const iree_uk_type_t out_type = iree_uk_mmt4d_out_type(mmt4d_type);
+  const iree_uk_index_t lhs_tile_size =
+      iree_uk_mmt4d_sparse_tile_size(lhs_type, mmt4d->M0, mmt4d->K0);
+  const iree_uk_index_t rhs_tile_size = iree_uk_mmt4d_sparse_tile_size(
+      iree_uk_mmt4d_rhs_type(mmt4d_type), mmt4d->N0, mmt4d->K0);
+  const iree_uk_index_t out_tile_size =
+      iree_uk_mmt4d_sparse_tile_size(out_type, mmt4d->M0, mmt4d->N0);
+  const iree_uk_int16_t lhs_elem_bits_log2 =
+      iree_uk_type_bit_count_log2(lhs_type);
+  const iree_uk_int16_t out_elem_size_log2 = iree_uk_type_size_log2(out_type);
+  const char* lhs_panel =
+      (const char*)mmt4d->lhs_buffer +
+      iree_uk_bits_to_bytes_exact(mmt4d->lhs_offset << lhs_elem_bits_log2);
+  char* out_tile_row =
+      (char*)mmt4d->out_buffer + (mmt4d->out_offset << out_elem_size_log2);
+  iree_uk_index_t lhs_panel_stride =
+      iree_uk_bits_to_bytes_exact(mmt4d->lhs_stride0 << lhs_elem_bits_log2);
+  iree_uk_index_t out_stride = mmt4d->out_stride0 << out_elem_size_log2;
+  const char* rhs_values = mmt4d->rhs_buffer;
+  const iree_uk_int32_t* row_offsets = params->rhs_row_offsets;
+  const iree_uk_int32_t* col_indices = params->rhs_indices;
+  const iree_uk_int32_t chunk_size =
+      IREE_UK_MMT4D_SPARSE_BUFFER_SIZE / lhs_tile_size;
+  IREE_UK_ATTRIBUTE_ALIGNED(64)
+  char lhs_gathered[IREE_UK_MMT4D_SPARSE_BUFFER_SIZE];
+  iree_uk_mmt4d_params_t chunk_params = *mmt4d;
+  for (iree_uk_int32_t i = 0; i < mmt4d->M; ++i) {
+    char* out_tile = out_tile_row;
+    for (iree_uk_int32_t j = 0; j < mmt4d->N; ++j) {
+      iree_uk_int32_t begin = row_offsets[j];
+      iree_uk_int32_t end = row_offsets[j + 1];
+      bool accumulate = mmt4d->flags & IREE_UK_FLAG_MMT4D_ACCUMULATE;
+      if (begin == end && !accumulate) {
+        iree_uk_memset(out_tile, 0, out_tile_size);
+      }
+      for (iree_uk_int32_t t = begin; t < end; t += chunk_size) {
+        iree_uk_int32_t count = end - t < chunk_size ? end - t : chunk_size;
+        for (iree_uk_int32_t c = 0; c < count; ++c) {
+          iree_uk_memcpy(lhs_gathered + c * lhs_tile_size,
+                         lhs_panel + col_indices[t + c] * lhs_tile_size,
+                         lhs_tile_size);
+        }
+        chunk_params.K = count;
+        chunk_params.flags =
+            accumulate ? mmt4d->flags | IREE_UK_FLAG_MMT4D_ACCUMULATE
+                       : mmt4d->flags & ~IREE_UK_FLAG_MMT4D_ACCUMULATE;
+        tile_func(out_tile, lhs_gathered, rhs_values + t * rhs_tile_size,
+                  &chunk_params);
+        accumulate = true;
+      }
+      out_tile += out_tile_size;
+    }
+    out_tile_row += out_stride;
+    lhs_panel += lhs_panel_stride;
+  }
+}
+
+IREE_UK_ATTRIBUTE_ALWAYS_INLINE static inline void
+iree_uk_mmt4d_sparse_2_4_expand_impl(char* IREE_UK_RESTRICT dst,
+                                     const char* IREE_UK_RESTRICT values,
+                                     const iree_uk_uint8_t* indices,
+                                     iree_uk_index_t group_begin,
+                                     iree_uk_index_t group_end,
+                                     iree_uk_index_t k_begin,
+                                     iree_uk_int32_t N0, iree_uk_int32_t K0,
+                                     int elem_size_log2) {
+  const iree_uk_index_t elem_size = 1 << elem_size_log2;
+  const iree_uk_index_t n0_stride = K0 << elem_size_log2;
+  for (iree_uk_index_t g = group_begin; g < group_end; ++g) {
+    // Destination offsets, at n0 == 0, of the 4 elements of the group.
+    iree_uk_index_t offsets[4];
+    for (int p = 0; p < 4; ++p) {
+      iree_uk_index_t k = 4 * g + p;
+      offsets[p] = (((k / K0) - k_begin) * N0 * K0 + k % K0) << elem_size_log2;
+    }
+    char* dst_n0 = dst;
+    for (iree_uk_int32_t n0 = 0; n0 < N0; ++n0) {
+      iree_uk_uint8_t positions = *indices++;
+      iree_uk_memcpy(dst_n0 + offsets[positions & 3], values, elem_size);
+      iree_uk_memcpy(dst_n0 + offsets[(positions >> 2) & 3],
+                     values + elem_size, elem_size);
+      values += 2 * elem_size;
+      dst_n0 += n0_stride;
+    }
+  }
+}
+
+// Expands K1 tiles [k_begin, k_begin + k_count) of RHS row `n` from the 2:4
+// format into dense tiles in `dst`.
+static void iree_uk_mmt4d_sparse_2_4_expand(
+    char* IREE_UK_RESTRICT dst, const iree_uk_mmt4d_sparse_params_t* params,
+    iree_uk_index_t n, iree_uk_index_t k_begin, iree_uk_index_t k_count) {
+  const iree_uk_mmt4d_params_t* mmt4d = &params->mmt4d;
+  const iree_uk_int32_t N0 = mmt4d->N0;
+  const iree_uk_int32_t K0 = mmt4d->K0;
+  const iree_uk_type_t rhs_type =
+      iree_uk_mmt4d_rhs_type(iree_uk_mmt4d_type(mmt4d->flags));
+  const int elem_size_log2 = iree_uk_type_size_log2(rhs_type);
+  iree_uk_memset(dst, 0, (k_count * N0 * K0) << elem_size_log2);
+  const iree_uk_index_t groups_per_row = mmt4d->K * K0 / 4;
+  const iree_uk_index_t group_begin = k_begin * K0 / 4;
+  const iree_uk_index_t group_end = (k_begin + k_count) * K0 / 4;
+  const char* values = (const char*)mmt4d->rhs_buffer +
+                       (((n * groups_per_row + group_begin) * N0 * 2)
+                        << elem_size_log2);
+  const iree_uk_uint8_t* indices = (const iree_uk_uint8_t*)params->rhs_indices +
+                                   (n * groups_per_row + group_begin) * N0;
+  // Specialize on the element size so that element copies are single moves.
+  switch (elem_size_log2) {
+    case 0:
+      iree_uk_mmt4d_sparse_2_4_expand_impl(dst, values, indices, group_begin,
+                                           group_end, k_begin, N0, K0, 0);
+      break;
+    case 1:
+      iree_uk_mmt4d_sparse_2_4_expand_impl(dst, values, indices, group_begin,
+                                           group_end, k_begin, N0, K0, 1);
+      break;
+    default:
+      iree_uk_mmt4d_sparse_2_4_expand_impl(dst, values, indices, group_begin,
+                                           group_end, k_begin, N0, K0, 2);
+      break;
+  }
+}
+
+// 2:4 sparse RHS: chunks of each RHS row are expanded to dense tiles once and
+// reused for all the rows of the LHS. The RHS memory traffic is halved while
+// the arithmetic stays in the dense tile function.
+static void iree_uk_mmt4d_sparse_2_4_using_tile_func(
+    const iree_uk_mmt4d_sparse_params_t* params,
+    iree_uk_mmt4d_tile_func_t tile_func) {
+  const iree_uk_mmt4d_params_t* mmt4d = &params->mmt4d;
+  iree_uk_mmt4d_type_t mmt4d_type = iree_uk_mmt4d_type(mmt4d->flags);
+  const iree_uk_type_t lhs_type = iree_uk_mmt4d_lhs_type(mmt4d_type);
+  const iree_uk_type_t out_type = iree_uk_mmt4d_out_type(mmt4d_type);
+  const iree_uk_index_t lhs_tile_size =
+      iree_uk_mmt4d_sparse_tile_size(lhs_type, mmt4d->M0, mmt4d->K0);
+  const iree_uk_index_t rhs_tile_size = iree_uk_mmt4d_sparse_tile_size(
+      iree_uk_mmt4d_rhs_type(mmt4d_type), mmt4d->N0, mmt4d->K0);
+  const iree_uk_index_t out_tile_size =
+      iree_uk_mmt4d_sparse_tile_size(out_type, mmt4d->M0, mmt4d->N0);
+  const iree_uk_int16_t lhs_elem_bits_log2 =
+      iree_uk_type_bit_count_log2(lhs_type);
+  const iree_uk_int16_t out_elem_size_log2 = iree_uk_type_size_log2(out_type);
+  const char* lhs_start =
+      (const char*)mmt4d->lhs_buffer +
+      iree_uk_bits_to_bytes_exact(mmt4d->lhs_offset << lhs_elem_bits_log2);
+  char* out_start =
+      (char*)mmt4d->out_buffer + (mmt4d->out_offset << out_elem_size_log2);
+  iree_uk_index_t lhs_panel_stride =
+      iree_uk_bits_to_bytes_exact(mmt4d->lhs_stride0 << lhs_elem_bits_log2);
+  iree_uk_index_t out_stride = mmt4d->out_stride0 << out_elem_size_log2;
+  // A multiple of 4 tiles, so that chunks never split a group of 4 elements.
+  const iree_uk_index_t chunk_size =
+      (IREE_UK_MMT4D_SPARSE_BUFFER_SIZE / rhs_tile_size) & ~3;
+  IREE_UK_ATTRIBUTE_ALIGNED(64)
+  char rhs_expanded[IREE_UK_MMT4D_SPARSE_BUFFER_SIZE];
+  iree_uk_mmt4d_params_t run_params = *mmt4d;
+  for (iree_uk_int32_t j = 0; j < mmt4d->N; ++j) {
+    for (iree_uk_index_t k = 0; k < mmt4d->K; k += chunk_size) {
+      iree_uk_index_t k_count = iree_uk_index_min(chunk_size, mmt4d->K - k);
+      iree_uk_mmt4d_sparse_2_4_expand(rhs_expanded, params, j, k, k_count);
+      run_params.K = k_count;
+      run_params.flags = k || (mmt4d->flags & IREE_UK_FLAG_MMT4D_ACCUMULATE)
+                             ? mmt4d->flags | IREE_UK_FLAG_MMT4D_ACCUMULATE
+                             : mmt4d->flags & ~IREE_UK_FLAG_MMT4D_ACCUMULATE;
+      char* out_tile = out_start + j * out_tile_size;
+      const char* lhs_panel = lhs_start + k * lhs_tile_size;
+      for (iree_uk_int32_t i = 0; i < mmt4d->M; ++i) {
+        tile_func(out_tile, lhs_panel, rhs_expanded, &run_params);
+        out_tile += out_stride;
+        lhs_panel += lhs_panel_stride;
+      }
+    }
+  }
+}
+
+// Early-return code paths. Returns true if already done.
+static bool iree_uk_mmt4d_sparse_early(
+    const iree_uk_mmt4d_sparse_params_t* params) {
+  const iree_uk_mmt4d_params_t* mmt4d = &params->mmt4d;
+  if (mmt4d->M == 0 || mmt4d->N == 0) return true;
+  if (mmt4d->K == 0) {
+    if (!(mmt4d->flags & IREE_UK_FLAG_MMT4D_ACCUMULATE)) {
+      // The generic loops never call the tile function with K == 0, so zero
+      // the output here.
+      const iree_uk_type_t out_type =
+          iree_uk_mmt4d_out_type(iree_uk_mmt4d_type(mmt4d->flags));
+      const iree_uk_int16_t out_elem_size_log2 =
+          iree_uk_type_size_log2(out_type);
+      char* out_row =
+          (char*)mmt4d->out_buffer + (mmt4d->out_offset << out_elem_size_log2);
+      for (iree_uk_int32_t i = 0; i < mmt4d->M; ++i) {
+        iree_uk_memset(out_row, 0,
+                       (mmt4d->N * mmt4d->M0 * mmt4d->N0)
+                           << out_elem_size_log2);
+        out_row += mmt4d->out_stride0 << out_elem_size_log2;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+void iree_uk_mmt4d_sparse_p(const iree_uk_mmt4d_sparse_params_t* params) {
+  iree_uk_mmt4d_sparse_validate(params);
+
+  if (iree_uk_mmt4d_sparse_early(params)) return;
+
+  // The dense tile functions do the actual arithmetic. The tile function
+  // selection does not look at the sparse format bits.
+  iree_uk_mmt4d_tile_func_t tile_func =
+      iree_uk_mmt4d_select_tile_func(&params->mmt4d);
+
+  if (iree_uk_mmt4d_sparse_format(params->mmt4d.flags) ==
+      IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_BLOCK) {
+    iree_uk_mmt4d_sparse_block_using_tile_func(params, tile_func);
+  } else {
+    iree_uk_mmt4d_sparse_2_4_using_tile_func(params, tile_func);
+  }
+}
+
+static bool iree_uk_mmt4d_sparse_is_zero(const char* data,
+                                         iree_uk_index_t size) {
+  for (iree_uk_index_t i = 0; i < size; ++i) {
+    if (data[i]) return false;
+  }
+  return true;
+}
+
+static iree_uk_index_t iree_uk_mmt4d_sparse_compress_rhs_block(
+    const char* rhs, iree_uk_index_t rhs_stride, char* values,
+    iree_uk_int32_t* row_offsets, iree_uk_int32_t* col_indices,
+    iree_uk_index_t N, iree_uk_index_t K, iree_uk_index_t tile_size) {
+  iree_uk_index_t tile_count = 0;
+  if (row_offsets) row_offsets[0] = 0;
+  for (iree_uk_index_t n = 0; n < N; ++n) {
+    const char* tile = rhs + n * rhs_stride;
+    for (iree_uk_index_t k = 0; k < K; ++k, tile += tile_size) {
+      if (iree_uk_mmt4d_sparse_is_zero(tile, tile_size)) continue;
+      if (values) {
+        iree_uk_memcpy(values + tile_count * tile_size, tile, tile_size);
+      }
+      if (col_indices) col_indices[tile_count] = k;
+      ++tile_count;
+    }
+    if (row_offsets) row_offsets[n + 1] = tile_count;
+  }
+  return tile_count;
+}
+
+static iree_uk_index_t iree_uk_mmt4d_sparse_compress_rhs_2_4(
+    const char* rhs, iree_uk_index_t rhs_stride, char* values,
+    iree_uk_uint8_t* indices, iree_uk_index_t N, iree_uk_index_t K,
+    iree_uk_int32_t N0, iree_uk_int32_t K0, iree_uk_int16_t elem_size_log2) {
+  const iree_uk_index_t elem_size = 1 << elem_size_log2;
+  const iree_uk_index_t groups_per_row = K * K0 / 4;
+  for (iree_uk_index_t n = 0; n < N; ++n) {
+    for (iree_uk_index_t g = 0; g < groups_per_row; ++g) {
+      for (iree_uk_int32_t n0 = 0; n0 < N0; ++n0) {
+        const char* elems[4];
+        int kept[2] = {-1, -1};
+        int kept_count = 0;
+        for (int p = 0; p < 4; ++p) {
+          iree_uk_index_t k = 4 * g + p;
+          elems[p] = rhs + n * rhs_stride +
+                     (((k / K0) * N0 * K0 + n0 * K0 + k % K0)
+                      << elem_size_log2);
+          if (iree_uk_mmt4d_sparse_is_zero(elems[p], elem_size)) continue;
+          if (kept_count == 2) return -1;
+          kept[kept_count++] = p;
+        }
+        // Pad with the first zero positions not already kept.
+        for (int p = 0; kept_count < 2; ++p) {
+          if (p != kept[0]) kept[kept_count++] = p;
+        }
+        if (kept[0] > kept[1]) {
+          int tmp = kept[0];
+          kept[0] = kept[1];
+          kept[1] = tmp;
+        }
+        if (values) {
+          iree_uk_memcpy(values, elems[kept[0]], elem_size);
+          iree_uk_memcpy(values + elem_size, elems[kept[1]], elem_size);
+          values += 2 * elem_size;
+        }
+        if (indices) *indices++ = kept[0] | (kept[1] << 2);
+      }
+    }
+  }
+  return N * K * N0 * K0 / 2;
+}
+
+IREE_UK_EXPORT void iree_uk_mmt4d_sparse(
+    const void* lhs_buffer, iree_uk_index_t lhs_offset,
+    iree_uk_index_t lhs_stride0, const void* rhs_values,
+    const iree_uk_int32_t* rhs_row_offsets, const void* rhs_indices,
+    void* out_buffer, iree_uk_index_t out_offset, iree_uk_index_t out_stride0,
+    iree_uk_index_t M, iree_uk_index_t N, iree_uk_index_t K, iree_uk_int32_t M0,
+    iree_uk_int32_t N0, iree_uk_int32_t K0, iree_uk_uint32_t flags,
+    const iree_uk_uint64_t* cpu_data) {
+  iree_uk_mmt4d_sparse_params_t params = {
+      .mmt4d = {.lhs_buffer = lhs_buffer,
+                .lhs_offset = lhs_offset,
+                .lhs_stride0 = lhs_stride0,
+                .rhs_buffer = rhs_values,
+                .out_buffer = out_buffer,
+                .out_offset = out_offset,
+                .out_stride0 = out_stride0,
+                .M = M,
+                .N = N,
+                .K = K,
+                .M0 = M0,
+                .N0 = N0,
+                .K0 = K0,
+                .flags = flags,
+                .cpu_data = cpu_data},
+      .rhs_row_offsets = rhs_row_offsets,
+      .rhs_indices = rhs_indices};
+  iree_uk_mmt4d_sparse_p(&params);
+}
+
+IREE_UK_EXPORT iree_uk_index_t iree_uk_mmt4d_sparse_compress_rhs(
+    const void* rhs_buffer, iree_uk_index_t rhs_offset,
+    iree_uk_index_t rhs_stride0, void* rhs_values,
+    iree_uk_int32_t* rhs_row_offsets, void* rhs_indices, iree_uk_index_t N,
+    iree_uk_index_t K, iree_uk_int32_t N0, iree_uk_int32_t K0,
+    iree_uk_uint32_t flags) {
+  const iree_uk_type_t rhs_type =
+      iree_uk_mmt4d_rhs_type(iree_uk_mmt4d_type(flags));
+  const iree_uk_int16_t rhs_elem_bits_log2 =
+      iree_uk_type_bit_count_log2(rhs_type);
+  const char* rhs =
+      (const char*)rhs_buffer +
+      iree_uk_bits_to_bytes_exact(rhs_offset << rhs_elem_bits_log2);
+  iree_uk_index_t rhs_stride =
+      iree_uk_bits_to_bytes_exact(rhs_stride0 << rhs_elem_bits_log2);
+  switch (iree_uk_mmt4d_sparse_format(flags)) {
+    case IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_BLOCK:
+      return iree_uk_mmt4d_sparse_compress_rhs_block(
+                 rhs, rhs_stride, rhs_values, rhs_row_offsets, rhs_indices, N,
+                 K, iree_uk_mmt4d_sparse_tile_size(rhs_type, N0, K0)) *
+             N0 * K0;
+    case IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_2_4:
+      IREE_UK_ASSERT(rhs_elem_bits_log2 >= 3);
+      IREE_UK_ASSERT(!((K * K0) % 4));
+      return iree_uk_mmt4d_sparse_compress_rhs_2_4(
+          rhs, rhs_stride, rhs_values, rhs_indices, N, K, N0, K0,
+          iree_uk_type_size_log2(rhs_type));
+    default:
+      IREE_UK_ASSERT(0 && "unknown sparse RHS format");
+      return -1;
+  }
+}
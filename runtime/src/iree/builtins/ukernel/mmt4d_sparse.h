@@ -0,0 +1,69 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BUILTINS_UKERNEL_MMT4D_SPARSE_H_
+#define IREE_BUILTINS_UKERNEL_MMT4D_SPARSE_H_
+
+#include "iree/builtins/ukernel/common.h"
+
+// `mmt4d_sparse` microkernel: same as `mmt4d`, but with a sparse RHS stored in
+// one of the following compressed formats, derived from the dense packed RHS
+// of shape [N, K, N0, K0] by iree_uk_mmt4d_sparse_compress_rhs.
+//
+// IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_BLOCK: block sparsity at the granularity of
+// N0xK0 RHS tiles. Zero tiles are dropped and the remaining ones are stored in
+// CSR fashion:
+//   rhs_values:      the nonzero tiles, row after row, each laid out as in the
+//                    dense RHS.
+//   rhs_row_offsets: int32[N + 1], tiles of row `n` are the range
+//                    [rhs_row_offsets[n], rhs_row_offsets[n + 1]).
+//   rhs_indices:     int32[number of tiles], the K index of each tile, in
+//                    increasing order within each row.
+// Zero tiles are skipped entirely: the LHS tiles matching the nonzero tiles of
+// each RHS row are gathered into a contiguous panel and handed to the dense
+// mmt4d tile functions in one call.
+//
+// IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_2_4: 2:4 structured sparsity along the
+// reduction dimension: within each group of 4 consecutive elements of a RHS
+// row along the unpacked K dimension (of size K * K0), at most 2 are nonzero.
+// Requires K * K0 to be a multiple of 4 and the RHS element type to be at least
+// 8 bits wide. For each row `n`, group `g` and `n0`:
+//   rhs_values:      the 2 kept elements, at [n][g][n0][0..1].
+//   rhs_indices:     uint8, at [n][g][n0]: the positions within the group of
+//                    the 2 kept elements, in bits [0..1] and [2..3].
+//   rhs_row_offsets: unused.
+// This halves the RHS storage and memory traffic, but not the arithmetic: the
+// RHS is expanded back to dense tiles in a small on-stack buffer, reused across
+// all the rows of the LHS, and fed to the dense mmt4d tile functions.
+//
+// The RHS pointers point to the data of the first row of tiles: there are no
+// separate offset parameters for them.
+IREE_UK_EXPORT void iree_uk_mmt4d_sparse(
+    const void* lhs_buffer, iree_uk_index_t lhs_offset,
+    iree_uk_index_t lhs_stride0, const void* rhs_values,
+    const iree_uk_int32_t* rhs_row_offsets, const void* rhs_indices,
+    void* out_buffer, iree_uk_index_t out_offset, iree_uk_index_t out_stride0,
+    iree_uk_index_t M, iree_uk_index_t N, iree_uk_index_t K, iree_uk_int32_t M0,
+    iree_uk_int32_t N0, iree_uk_int32_t K0, iree_uk_uint32_t flags,
+    const iree_uk_uint64_t* cpu_data);
+
+// Compresses the dense packed RHS of shape [N, K, N0, K0] into the sparse
+// format selected by `flags`, as described above. Elements are considered zero
+// when all their bits are zero.
+//
+// Returns the number of RHS elements stored in `rhs_values`, or -1 if the RHS
+// does not fit the format, i.e. for FORMAT_2_4, when some group of 4 elements
+// has more than 2 nonzeros. The output buffers may be null, in which case only
+// the size is computed: callers typically call this once with null buffers to
+// size them, then again to fill them.
+IREE_UK_EXPORT iree_uk_index_t iree_uk_mmt4d_sparse_compress_rhs(
+    const void* rhs_buffer, iree_uk_index_t rhs_offset,
+    iree_uk_index_t rhs_stride0, void* rhs_values,
+    iree_uk_int32_t* rhs_row_offsets, void* rhs_indices, iree_uk_index_t N,
+    iree_uk_index_t K, iree_uk_int32_t N0, iree_uk_int32_t K0,
+    iree_uk_uint32_t flags);
+
+#endif  // IREE_BUILTINS_UKERNEL_MMT4D_SPARSE_H_
@@ -0,0 +1,30 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BUILTINS_UKERNEL_MMT4D_SPARSE_INTERNAL_H_
+#define IREE_BUILTINS_UKERNEL_MMT4D_SPARSE_INTERNAL_H_
+
+#include "iree/builtins/ukernel/mmt4d_internal.h"
+#include "iree/builtins/ukernel/mmt4d_sparse.h"
+
+typedef struct iree_uk_mmt4d_sparse_params_t {
+  // Parameters of the equivalent dense mmt4d. `rhs_buffer` points to the
+  // sparse RHS values. `rhs_offset` and `rhs_stride0` are unused.
+  iree_uk_mmt4d_params_t mmt4d;
+  // See mmt4d_sparse.h for the meaning of these in each format.
+  const iree_uk_int32_t* rhs_row_offsets;
+  const void* rhs_indices;
+} iree_uk_mmt4d_sparse_params_t;
+
+// Same as the iree_uk_mmt4d_sparse public entry point, but taking the struct.
+void iree_uk_mmt4d_sparse_p(const iree_uk_mmt4d_sparse_params_t* params);
+
+// Size of the on-stack buffer that LHS tiles get gathered into (block format)
+// or that RHS tiles get expanded into (2:4 format). Must hold at least one LHS
+// tile and 4 RHS tiles respectively.
+#define IREE_UK_MMT4D_SPARSE_BUFFER_SIZE 8192
+
+#endif  // IREE_BUILTINS_UKERNEL_MMT4D_SPARSE_INTERNAL_H_
@@ -0,0 +1,141 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/normalize_internal.h"
+
+static void iree_uk_normalize_validate(
+    const iree_uk_normalize_params_t* params) {
+#ifdef IREE_UK_ENABLE_ASSERTS
+  const iree_uk_uint32_t allflags = IREE_UK_FLAG_NORMALIZE_TYPE_MASK |
+                                    IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  IREE_UK_ASSERT(!(params->flags & ~allflags));
+  iree_uk_uint32_t flags_type =
+      params->flags & IREE_UK_FLAG_NORMALIZE_TYPE_MASK;
+  IREE_UK_ASSERT(flags_type == IREE_UK_FLAG_NORMALIZE_TYPE_F32F32 ||
+                 flags_type == IREE_UK_FLAG_NORMALIZE_TYPE_F16F16 ||
+                 flags_type == IREE_UK_FLAG_NORMALIZE_TYPE_BF16BF16);
+  IREE_UK_ASSERT(params->op == iree_uk_normalize_op_softmax ||
+                 params->op == iree_uk_normalize_op_layernorm ||
+                 params->op == iree_uk_normalize_op_rmsnorm);
+  IREE_UK_ASSERT(params->size0 >= 0);
+  IREE_UK_ASSERT(params->size1 >= 0);
+  // Rows must not overlap. A single row may have any stride.
+  IREE_UK_ASSERT(params->size0 <= 1 || params->in_stride0 >= params->size1);
+  IREE_UK_ASSERT(params->size0 <= 1 || params->out_stride0 >= params->size1);
+  if (params->op != iree_uk_normalize_op_softmax) {
+    IREE_UK_ASSERT(params->gamma_buffer);
+    IREE_UK_ASSERT(params->epsilon >= 0.f);
+  }
+  if (params->op == iree_uk_normalize_op_layernorm) {
+    IREE_UK_ASSERT(params->beta_buffer);
+  }
+#endif  // IREE_UK_ENABLE_ASSERTS
+}
+
+// Early-return implementation for this ukernel. Returns true if already done.
+static bool iree_uk_normalize_early(const iree_uk_normalize_params_t* params) {
+  return (params->size0 == 0 || params->size1 == 0);
+}
+
+void iree_uk_normalize_p(const iree_uk_normalize_params_t* params) {
+  iree_uk_normalize_validate(params);
+
+  if (iree_uk_normalize_early(params)) return;
+
+  // Select a target-specific row_func and use it with a generic outer loop.
+  iree_uk_normalize_row_func_t row_func =
+      iree_uk_normalize_select_row_func(params);
+
+  iree_uk_normalize_type_t normalize_type =
+      iree_uk_normalize_type(params->flags);
+  iree_uk_index_t elem_size =
+      iree_uk_type_size(iree_uk_normalize_in_type(normalize_type));
+  const char* in_row =
+      (const char*)params->in_buffer + params->in_offset * elem_size;
+  char* out_row = (char*)params->out_buffer + params->out_offset * elem_size;
+  const char* gamma =
+      params->gamma_buffer
+          ? (const char*)params->gamma_buffer + params->gamma_offset * elem_size
+          : 0;
+  const char* beta =
+      params->beta_buffer
+          ? (const char*)params->beta_buffer + params->beta_offset * elem_size
+          : 0;
+  for (iree_uk_index_t i = 0; i < params->size0; ++i) {
+    row_func(out_row, in_row, gamma, beta, params->size1, params->epsilon,
+             params->flags);
+    in_row += params->in_stride0 * elem_size;
+    out_row += params->out_stride0 * elem_size;
+  }
+}
+
+IREE_UK_EXPORT void iree_uk_softmax(
+    const void* in_buffer, iree_uk_index_t in_offset,
+    iree_uk_index_t in_stride0, void* out_buffer, iree_uk_index_t out_offset,
+    iree_uk_index_t out_stride0, iree_uk_index_t size0, iree_uk_index_t size1,
+    iree_uk_uint32_t flags, const iree_uk_uint64_t* cpu_data) {
+  iree_uk_normalize_params_t params = {.op = iree_uk_normalize_op_softmax,
+                                       .in_buffer = in_buffer,
+                                       .in_offset = in_offset,
+                                       .in_stride0 = in_stride0,
+                                       .out_buffer = out_buffer,
+                                       .out_offset = out_offset,
+                                       .out_stride0 = out_stride0,
+                                       .size0 = size0,
+                                       .size1 = size1,
+                                       .flags = flags,
+                                       .cpu_data = cpu_data};
+  iree_uk_normalize_p(&params);
+}
+
+IREE_UK_EXPORT void iree_uk_layernorm(
+    const void* in_buffer, iree_uk_index_t in_offset,
+    iree_uk_index_t in_stride0, const void* gamma_buffer,
+    iree_uk_index_t gamma_offset, const void* beta_buffer,
+    iree_uk_index_t beta_offset, void* out_buffer, iree_uk_index_t out_offset,
+    iree_uk_index_t out_stride0, iree_uk_index_t size0, iree_uk_index_t size1,
+    float epsilon, iree_uk_uint32_t flags, const iree_uk_uint64_t* cpu_data) {
+  iree_uk_normalize_params_t params = {.op = iree_uk_normalize_op_layernorm,
+                                       .in_buffer = in_buffer,
+                                       .in_offset = in_offset,
+                                       .in_stride0 = in_stride0,
+                                       .gamma_buffer = gamma_buffer,
+                                       .gamma_offset = gamma_offset,
+                                       .beta_buffer = beta_buffer,
+                                       .beta_offset = beta_offset,
+                                       .out_buffer = out_buffer,
+                                       .out_offset = out_offset,
+                                       .out_stride0 = out_stride0,
+                                       .size0 = size0,
+                                       .size1 = size1,
+                                       .epsilon = epsilon,
+                                       .flags = flags,
+                                       .cpu_data = cpu_data};
+  iree_uk_normalize_p(&params);
+}
+
+IREE_UK_EXPORT void iree_uk_rmsnorm(
+    const void* in_buffer, iree_uk_index_t in_offset,
+    iree_uk_index_t in_stride0, const void* gamma_buffer,
+    iree_uk_index_t gamma_offset, void* out_buffer, iree_uk_index_t out_offset,
+    iree_uk_index_t out_stride0, iree_uk_index_t size0, iree_uk_index_t size1,
+    float epsilon, iree_uk_uint32_t flags, const iree_uk_uint64_t* cpu_data) {
+  iree_uk_normalize_params_t params = {.op = iree_uk_normalize_op_rmsnorm,
+                                       .in_buffer = in_buffer,
+                                       .in_offset = in_offset,
+                                       .in_stride0 = in_stride0,
+                                       .gamma_buffer = gamma_buffer,
+                                       .gamma_offset = gamma_offset,
+                                       .out_buffer = out_buffer,
+                                       .out_offset = out_offset,
+                                       .out_stride0 = out_stride0,
+                                       .size0 = size0,
+                                       .size1 = size1,
+                                       .epsilon = epsilon,
+                                       .flags = flags,
+                                       .cpu_data = cpu_data};
+  iree_uk_normalize_p(&params);
+}
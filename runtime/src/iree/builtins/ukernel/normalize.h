@@ -0,0 +1,45 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BUILTINS_UKERNEL_NORMALIZE_H_
+#define IREE_BUILTINS_UKERNEL_NORMALIZE_H_
+
+#include "iree/builtins/ukernel/common.h"
+
+// Row-wise normalization microkernels. All of them operate on a 2D row-major
+// buffer of shape [size0, size1] and normalize each row of `size1` contiguous
+// elements independently. The outer dimension is strided. The output may alias
+// the input exactly (in-place), but not partially.
+//
+// Arithmetic is internally performed in f32 regardless of the element type.
+// The IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS flag allows trading some
+// accuracy of the exp/rsqrt approximations for speed.
+
+// out[i, j] = exp(in[i, j] - max_j in[i, :]) / sum_j exp(in[i, j] - max)
+IREE_UK_EXPORT void iree_uk_softmax(
+    const void* in_buffer, iree_uk_index_t in_offset,
+    iree_uk_index_t in_stride0, void* out_buffer, iree_uk_index_t out_offset,
+    iree_uk_index_t out_stride0, iree_uk_index_t size0, iree_uk_index_t size1,
+    iree_uk_uint32_t flags, const iree_uk_uint64_t* cpu_data);
+
+// out[i, j] = (in[i, j] - mean_i) * rsqrt(var_i + epsilon) * gamma[j] + beta[j]
+IREE_UK_EXPORT void iree_uk_layernorm(
+    const void* in_buffer, iree_uk_index_t in_offset,
+    iree_uk_index_t in_stride0, const void* gamma_buffer,
+    iree_uk_index_t gamma_offset, const void* beta_buffer,
+    iree_uk_index_t beta_offset, void* out_buffer, iree_uk_index_t out_offset,
+    iree_uk_index_t out_stride0, iree_uk_index_t size0, iree_uk_index_t size1,
+    float epsilon, iree_uk_uint32_t flags, const iree_uk_uint64_t* cpu_data);
+
+// out[i, j] = in[i, j] * rsqrt(mean_j(in[i, :]^2) + epsilon) * gamma[j]
+IREE_UK_EXPORT void iree_uk_rmsnorm(
+    const void* in_buffer, iree_uk_index_t in_offset,
+    iree_uk_index_t in_stride0, const void* gamma_buffer,
+    iree_uk_index_t gamma_offset, void* out_buffer, iree_uk_index_t out_offset,
+    iree_uk_index_t out_stride0, iree_uk_index_t size0, iree_uk_index_t size1,
+    float epsilon, iree_uk_uint32_t flags, const iree_uk_uint64_t* cpu_data);
+
+#endif  // IREE_BUILTINS_UKERNEL_NORMALIZE_H_
@@ -0,0 +1,174 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BUILTINS_UKERNEL_NORMALIZE_INTERNAL_H_
+#define IREE_BUILTINS_UKERNEL_NORMALIZE_INTERNAL_H_
+
+#include "iree/builtins/ukernel/normalize.h"
+
+typedef enum iree_uk_normalize_op_t {
+  iree_uk_normalize_op_softmax,
+  iree_uk_normalize_op_layernorm,
+  iree_uk_normalize_op_rmsnorm,
+} iree_uk_normalize_op_t;
+
+typedef struct iree_uk_normalize_params_t {
+  iree_uk_normalize_op_t op;
+  const void* in_buffer;
+  iree_uk_index_t in_offset;
+  iree_uk_index_t in_stride0;
+  // Only used by layernorm and rmsnorm. Shape [size1], contiguous.
+  const void* gamma_buffer;
+  iree_uk_index_t gamma_offset;
+  // Only used by layernorm. Shape [size1], contiguous.
+  const void* beta_buffer;
+  iree_uk_index_t beta_offset;
+  void* out_buffer;
+  iree_uk_index_t out_offset;
+  iree_uk_index_t out_stride0;
+  iree_uk_index_t size0;
+  iree_uk_index_t size1;
+  float epsilon;
+  iree_uk_uint32_t flags;
+  const iree_uk_uint64_t* cpu_data;
+} iree_uk_normalize_params_t;
+
+void iree_uk_normalize_p(const iree_uk_normalize_params_t* params);
+
+typedef enum iree_uk_normalize_type_t {
+  iree_uk_normalize_type_f32f32 =
+      IREE_UK_TIE_2_TYPES_LITERAL(FLOAT_32, FLOAT_32),
+  iree_uk_normalize_type_f16f16 =
+      IREE_UK_TIE_2_TYPES_LITERAL(FLOAT_16, FLOAT_16),
+  iree_uk_normalize_type_bf16bf16 =
+      IREE_UK_TIE_2_TYPES_LITERAL(BFLOAT_16, BFLOAT_16),
+} iree_uk_normalize_type_t;
+
+static inline iree_uk_normalize_type_t iree_uk_normalize_type(
+    iree_uk_uint32_t flags) {
+  switch (flags & IREE_UK_FLAG_NORMALIZE_TYPE_MASK) {
+    case IREE_UK_FLAG_NORMALIZE_TYPE_F32F32:
+      return iree_uk_normalize_type_f32f32;
+    case IREE_UK_FLAG_NORMALIZE_TYPE_F16F16:
+      return iree_uk_normalize_type_f16f16;
+    case IREE_UK_FLAG_NORMALIZE_TYPE_BF16BF16:
+      return iree_uk_normalize_type_bf16bf16;
+    default:
+      // Shouldn't happen, validated earlier.
+      return (iree_uk_normalize_type_t)0;
+  }
+}
+
+static inline iree_uk_type_t iree_uk_normalize_in_type(
+    iree_uk_normalize_type_t type) {
+  return iree_uk_untie_type(0, type);
+}
+
+static inline iree_uk_type_t iree_uk_normalize_out_type(
+    iree_uk_normalize_type_t type) {
+  return iree_uk_untie_type(1, type);
+}
+
+// Normalizes one row of `size1` elements. `out_row` may be equal to `in_row`,
+// so implementations must not assume that they do not alias. `beta` is only
+// read by layernorm, `gamma` by layernorm and rmsnorm.
+typedef void (*iree_uk_normalize_row_func_t)(
+    void* out_row, const void* in_row, const void* gamma, const void* beta,
+    iree_uk_index_t size1, float epsilon, iree_uk_uint32_t flags);
+
+// Row kernel declarations. Prototype matches iree_uk_normalize_row_func_t.
+#define IREE_UK_NORMALIZE_ROW_FUNC_DECL(NAME)                              \
+  void NAME(void* out_row, const void* in_row, const void* gamma,          \
+            const void* beta, iree_uk_index_t size1, float epsilon,        \
+            iree_uk_uint32_t flags);
+
+// Returns the row function to use for the normalize op with the given params.
+iree_uk_normalize_row_func_t iree_uk_normalize_select_row_func(
+    const iree_uk_normalize_params_t* params);
+
+// Architecture-specific implementation.
+iree_uk_normalize_row_func_t iree_uk_normalize_select_row_func_arch(
+    const iree_uk_normalize_params_t* params);
+
+//===----------------------------------------------------------------------===//
+// exp and rsqrt approximations.
+//
+// Microkernels can't call into libm, so we carry our own approximations. The
+// constants are shared with the architecture-specific vector code so that all
+// code paths produce bitwise-comparable results up to FMA contraction.
+//===----------------------------------------------------------------------===//
+
+// exp(x) = 2^n * exp(r) with n = round(x * log2(e)) and r = x - n * ln(2),
+// where ln(2) is split into a high part exactly representable with few
+// mantissa bits and a low correction, so that |r| <= ln(2)/2 stays accurate.
+// Arguments are clamped to a range where 2^n is a normal f32. The upper bound
+// is chosen so that n never exceeds 127.
+#define IREE_UK_EXP_F32_LO -87.3365478515625f
+#define IREE_UK_EXP_F32_HI 88.0f
+#define IREE_UK_EXP_F32_LOG2E 1.44269504088896341f
+#define IREE_UK_EXP_F32_LN2_HI 0.693359375f
+#define IREE_UK_EXP_F32_LN2_LO -2.12194440e-4f
+
+// Degree-7 polynomial for exp(r) on [-ln(2)/2, ln(2)/2] (Cephes expf), written
+// as 1 + r + r^2 * P(r). Accurate to about 1 ulp.
+#define IREE_UK_EXP_F32_P0 1.9875691500e-4f
+#define IREE_UK_EXP_F32_P1 1.3981999507e-3f
+#define IREE_UK_EXP_F32_P2 8.3334519073e-3f
+#define IREE_UK_EXP_F32_P3 4.1665795894e-2f
+#define IREE_UK_EXP_F32_P4 1.6666665459e-1f
+#define IREE_UK_EXP_F32_P5 5.0000001201e-1f
+
+// Degree-4 Taylor polynomial used with the FAST_APPROXIMATIONS flag, written
+// as 1 + r + r^2 * Q(r). Relative error below 7e-5.
+#define IREE_UK_EXP_F32_FAST_Q0 4.1666668e-2f
+#define IREE_UK_EXP_F32_FAST_Q1 1.6666667e-1f
+#define IREE_UK_EXP_F32_FAST_Q2 5.0e-1f
+
+static inline float iree_uk_normalize_exp_f32(float x, bool fast) {
+  x = x < IREE_UK_EXP_F32_LO ? IREE_UK_EXP_F32_LO : x;
+  x = x > IREE_UK_EXP_F32_HI ? IREE_UK_EXP_F32_HI : x;
+  float t = x * IREE_UK_EXP_F32_LOG2E;
+  iree_uk_int32_t n = (iree_uk_int32_t)(t + (t >= 0.f ? 0.5f : -0.5f));
+  float r = x - (float)n * IREE_UK_EXP_F32_LN2_HI;
+  r = r - (float)n * IREE_UK_EXP_F32_LN2_LO;
+  float p;
+  if (fast) {
+    p = IREE_UK_EXP_F32_FAST_Q0;
+    p = p * r + IREE_UK_EXP_F32_FAST_Q1;
+    p = p * r + IREE_UK_EXP_F32_FAST_Q2;
+  } else {
+    p = IREE_UK_EXP_F32_P0;
+    p = p * r + IREE_UK_EXP_F32_P1;
+    p = p * r + IREE_UK_EXP_F32_P2;
+    p = p * r + IREE_UK_EXP_F32_P3;
+    p = p * r + IREE_UK_EXP_F32_P4;
+    p = p * r + IREE_UK_EXP_F32_P5;
+  }
+  float y = p * r * r + r + 1.f;
+  iree_uk_uint32_t scale_bits = (iree_uk_uint32_t)(n + 127) << 23;
+  float scale;
+  iree_uk_memcpy(&scale, &scale_bits, sizeof scale);
+  return y * scale;
+}
+
+// Reciprocal square root from the classic bit-level estimate refined by
+// Newton-Raphson iterations. Each iteration roughly doubles the number of
+// correct bits: 2 iterations give ~1e-5 relative error, 3 give full f32
+// precision. This is only ever evaluated once per row, so it is kept scalar.
+static inline float iree_uk_normalize_rsqrt_f32(float x, bool fast) {
+  iree_uk_uint32_t bits;
+  iree_uk_memcpy(&bits, &x, sizeof bits);
+  bits = 0x5f375a86u - (bits >> 1);
+  float y;
+  iree_uk_memcpy(&y, &bits, sizeof y);
+  int iterations = fast ? 2 : 3;
+  for (int i = 0; i < iterations; ++i) {
+    y = y * (1.5f - 0.5f * x * y * y);
+  }
+  return y;
+}
+
+#endif  // IREE_BUILTINS_UKERNEL_NORMALIZE_INTERNAL_H_
@@ -0,0 +1,132 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/normalize_internal.h"
+
+static inline float iree_uk_normalize_load_generic(
+    const void* buf, iree_uk_index_t i, iree_uk_normalize_type_t type) {
+  switch (type) {
+    case iree_uk_normalize_type_f16f16:
+      return iree_uk_f16_to_f32(((const iree_uk_uint16_t*)buf)[i]);
+    case iree_uk_normalize_type_bf16bf16:
+      return iree_uk_bf16_to_f32(((const iree_uk_uint16_t*)buf)[i]);
+    default:
+      return ((const float*)buf)[i];
+  }
+}
+
+static inline void iree_uk_normalize_store_generic(
+    void* buf, iree_uk_index_t i, float value, iree_uk_normalize_type_t type) {
+  switch (type) {
+    case iree_uk_normalize_type_f16f16:
+      ((iree_uk_uint16_t*)buf)[i] = iree_uk_f32_to_f16(value);
+      return;
+    case iree_uk_normalize_type_bf16bf16:
+      ((iree_uk_uint16_t*)buf)[i] = iree_uk_f32_to_bf16(value);
+      return;
+    default:
+      ((float*)buf)[i] = value;
+      return;
+  }
+}
+
+static void iree_uk_softmax_row_generic(void* out_row, const void* in_row,
+                                        const void* gamma, const void* beta,
+                                        iree_uk_index_t size1, float epsilon,
+                                        iree_uk_uint32_t flags) {
+  iree_uk_normalize_type_t type = iree_uk_normalize_type(flags);
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  float max = iree_uk_normalize_load_generic(in_row, 0, type);
+  for (iree_uk_index_t j = 1; j < size1; ++j) {
+    float x = iree_uk_normalize_load_generic(in_row, j, type);
+    max = x > max ? x : max;
+  }
+  float sum = 0.f;
+  for (iree_uk_index_t j = 0; j < size1; ++j) {
+    float x = iree_uk_normalize_load_generic(in_row, j, type);
+    sum += iree_uk_normalize_exp_f32(x - max, fast);
+  }
+  float inv_sum = 1.f / sum;
+  // Recompute the exponentials rather than storing them in `out_row`: that
+  // would round them to the output type before the final scaling and, when
+  // operating in place, would clobber the input.
+  for (iree_uk_index_t j = 0; j < size1; ++j) {
+    float x = iree_uk_normalize_load_generic(in_row, j, type);
+    iree_uk_normalize_store_generic(
+        out_row, j, iree_uk_normalize_exp_f32(x - max, fast) * inv_sum, type);
+  }
+}
+
+static void iree_uk_layernorm_row_generic(void* out_row, const void* in_row,
+                                          const void* gamma, const void* beta,
+                                          iree_uk_index_t size1, float epsilon,
+                                          iree_uk_uint32_t flags) {
+  iree_uk_normalize_type_t type = iree_uk_normalize_type(flags);
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  // Two-pass mean/variance: more robust than E[x^2] - E[x]^2 for rows with a
+  // large mean, and the row is typically still in L1 for the second pass.
+  float sum = 0.f;
+  for (iree_uk_index_t j = 0; j < size1; ++j) {
+    sum += iree_uk_normalize_load_generic(in_row, j, type);
+  }
+  float mean = sum / (float)size1;
+  float sum_sq = 0.f;
+  for (iree_uk_index_t j = 0; j < size1; ++j) {
+    float d = iree_uk_normalize_load_generic(in_row, j, type) - mean;
+    sum_sq += d * d;
+  }
+  float rstd = iree_uk_normalize_rsqrt_f32(sum_sq / (float)size1 + epsilon,
+                                           fast);
+  for (iree_uk_index_t j = 0; j < size1; ++j) {
+    float x = iree_uk_normalize_load_generic(in_row, j, type);
+    float g = iree_uk_normalize_load_generic(gamma, j, type);
+    float b = iree_uk_normalize_load_generic(beta, j, type);
+    iree_uk_normalize_store_generic(out_row, j, (x - mean) * rstd * g + b,
+                                    type);
+  }
+}
+
+static void iree_uk_rmsnorm_row_generic(void* out_row, const void* in_row,
+                                        const void* gamma, const void* beta,
+                                        iree_uk_index_t size1, float epsilon,
+                                        iree_uk_uint32_t flags) {
+  iree_uk_normalize_type_t type = iree_uk_normalize_type(flags);
+  bool fast = flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS;
+  float sum_sq = 0.f;
+  for (iree_uk_index_t j = 0; j < size1; ++j) {
+    float x = iree_uk_normalize_load_generic(in_row, j, type);
+    sum_sq += x * x;
+  }
+  float rstd = iree_uk_normalize_rsqrt_f32(sum_sq / (float)size1 + epsilon,
+                                           fast);
+  for (iree_uk_index_t j = 0; j < size1; ++j) {
+    float x = iree_uk_normalize_load_generic(in_row, j, type);
+    float g = iree_uk_normalize_load_generic(gamma, j, type);
+    iree_uk_normalize_store_generic(out_row, j, x * rstd * g, type);
+  }
+}
+
+static iree_uk_normalize_row_func_t iree_uk_normalize_select_row_func_generic(
+    const iree_uk_normalize_params_t* params) {
+  switch (params->op) {
+    case iree_uk_normalize_op_layernorm:
+      return iree_uk_layernorm_row_generic;
+    case iree_uk_normalize_op_rmsnorm:
+      return iree_uk_rmsnorm_row_generic;
+    default:
+      return iree_uk_softmax_row_generic;
+  }
+}
+
+iree_uk_normalize_row_func_t iree_uk_normalize_select_row_func(
+    const iree_uk_normalize_params_t* params) {
+  iree_uk_normalize_row_func_t arch_row_func =
+      iree_uk_normalize_select_row_func_arch(params);
+  if (arch_row_func) {
+    return arch_row_func;
+  }
+  return iree_uk_normalize_select_row_func_generic(params);
+}
@@ -0,0 +1,398 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Sweeps the mmt4d tile functions available on the host CPU, and for each of
+// them the number of M0xN0 tiles handled by each mmt4d call, and emits the
+// results as a tuning spec: a transform dialect library that the compiler
+// loads with --iree-codegen-tuning-spec-path and that sets the lowering
+// configuration of the matching linalg.mmt4d ops.
+//
+// Example:
+//
+//   mmt4d_autotune --types=f32f32f32,s8s8s32 --output=/tmp/spec.mlir
+//   iree-compile --iree-llvmcpu-target-cpu=host
+//     --iree-codegen-tuning-spec-path=/tmp/spec.mlir ...
+//
+// The M0xN0xK0 tile sizes themselves are chosen when encodings are resolved,
+// before tuning specs get applied, so the spec can only refine the tiling of
+// the resulting mmt4d ops. The fastest tile per element type is reported in
+// the spec header for reference.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/flags.h"
+#include "iree/builtins/ukernel/api.h"
+#include "iree/builtins/ukernel/exported_bits.h"
+#include "iree/builtins/ukernel/mmt4d.h"
+#include "iree/builtins/ukernel/mmt4d_internal.h"
+#include "iree/builtins/ukernel/tools/mmt4d_tiles.h"
+#include "iree/builtins/ukernel/tools/util.h"
+#include "iree/schemas/cpu_data.h"
+
+IREE_FLAG(
+    int32_t, k_size, 256,
+    "K-dimension of the measured mmt4d ops. The overall accumulation depth is "
+    "that times the K0 tile size.");
+IREE_FLAG(int32_t, min_time_ms, 50,
+          "Minimum duration of each measurement, in milliseconds.");
+IREE_FLAG(int32_t, max_outer_tile_size, 16,
+          "Largest number of M0xN0 tiles along each of the M and N dimensions "
+          "handled by a single mmt4d call. Powers of two up to that are "
+          "swept.");
+IREE_FLAG(string, types, "",
+          "Comma-separated list of mmt4d type triples to tune, e.g. "
+          "`f32f32f32,s8s8s32`. Empty means all types.");
+IREE_FLAG(string, output, "",
+          "Path of the tuning spec file to write, or `-` for stdout. Empty "
+          "means only printing the results table.");
+
+#define IREE_UK_MMT4D_AUTOTUNE_MAX_RESULTS 64
+
+// The best measurement for one type and tile shape.
+typedef struct iree_uk_mmt4d_autotune_result_t {
+  iree_uk_uint32_t flags;
+  int M0;
+  int N0;
+  int K0;
+  const char* cpu_features;
+  // Number of M0xN0 tiles along M and N in the fastest mmt4d call.
+  int M;
+  int N;
+  double gflops;
+} iree_uk_mmt4d_autotune_result_t;
+
+static bool iree_uk_mmt4d_autotune_type_selected(iree_uk_uint32_t flags) {
+  if (!strlen(FLAG_types)) return true;
+  char type_str[32];
+  iree_uk_type_triple_str(type_str, sizeof type_str,
+                          iree_uk_mmt4d_type(flags));
+  iree_string_view_t remaining = iree_make_cstring_view(FLAG_types);
+  while (!iree_string_view_is_empty(remaining)) {
+    iree_string_view_t type;
+    iree_string_view_split(remaining, ',', &type, &remaining);
+    if (iree_string_view_equal(iree_string_view_trim(type),
+                               iree_make_cstring_view(type_str))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Runs the mmt4d op described by `params` repeatedly for at least
+// FLAG_min_time_ms and returns the achieved GFLOP/s.
+static double iree_uk_mmt4d_autotune_measure(
+    iree_uk_mmt4d_params_t* params, iree_uk_random_engine_t* engine) {
+  params->lhs_stride0 = params->K * params->M0 * params->K0;
+  params->rhs_stride0 = params->K * params->N0 * params->K0;
+  params->out_stride0 = params->N * params->M0 * params->N0;
+  iree_uk_mmt4d_type_t mmt4d_type = iree_uk_mmt4d_type(params->flags);
+  iree_uk_type_t lhs_type = iree_uk_mmt4d_lhs_type(mmt4d_type);
+  iree_uk_type_t rhs_type = iree_uk_mmt4d_rhs_type(mmt4d_type);
+  iree_uk_type_t out_type = iree_uk_mmt4d_out_type(mmt4d_type);
+  iree_uk_index_t lhs_buffer_size =
+      iree_uk_2d_buffer_length(lhs_type, params->M, params->lhs_stride0);
+  iree_uk_index_t rhs_buffer_size =
+      iree_uk_2d_buffer_length(rhs_type, params->N, params->rhs_stride0);
+  iree_uk_index_t out_buffer_size =
+      iree_uk_2d_buffer_length(out_type, params->M, params->out_stride0);
+  void* lhs_buffer = malloc(lhs_buffer_size);
+  void* rhs_buffer = malloc(rhs_buffer_size);
+  void* out_buffer = malloc(out_buffer_size);
+  iree_uk_write_random_buffer(lhs_buffer, lhs_buffer_size, lhs_type, engine);
+  iree_uk_write_random_buffer(rhs_buffer, rhs_buffer_size, rhs_type, engine);
+  iree_uk_write_random_buffer(out_buffer, out_buffer_size, out_type, engine);
+  params->lhs_buffer = lhs_buffer;
+  params->rhs_buffer = rhs_buffer;
+  params->out_buffer = out_buffer;
+
+  // Warm up caches and any lazily initialized state.
+  iree_uk_mmt4d_p(params);
+  iree_time_t min_duration_ns = (iree_time_t)FLAG_min_time_ms * 1000000;
+  int64_t total_iterations = 0;
+  int64_t batch_count = 1;
+  iree_time_t start_ns = iree_time_now();
+  iree_time_t elapsed_ns = 0;
+  do {
+    for (int64_t i = 0; i < batch_count; ++i) {
+      iree_uk_mmt4d_p(params);
+    }
+    total_iterations += batch_count;
+    batch_count *= 2;
+    elapsed_ns = iree_time_now() - start_ns;
+  } while (elapsed_ns < min_duration_ns);
+
+  free(lhs_buffer);
+  free(rhs_buffer);
+  free(out_buffer);
+  double flops_per_iteration = 2.0 * params->M * params->N * params->K *
+                               params->M0 * params->N0 * params->K0;
+  return flops_per_iteration * total_iterations / (double)elapsed_ns;
+}
+
+// Sweeps the outer tile sizes for one tile shape and records the fastest.
+static void iree_uk_mmt4d_autotune_tile(
+    const iree_uk_mmt4d_tile_candidate_t* candidate, int M0,
+    const iree_uk_uint64_t* cpu_data, iree_uk_random_engine_t* engine,
+    iree_uk_mmt4d_autotune_result_t* results, int* result_count) {
+  iree_uk_mmt4d_params_t params = {
+      .flags =
+          candidate->flags | IREE_UK_FLAG_MMT4D_SKIP_INTERMEDIATE_ROUNDINGS,
+      .M0 = M0,
+      .N0 = candidate->N0,
+      .K0 = candidate->K0,
+      .cpu_data = cpu_data};
+  // Only tune tile functions that exist for this CPU: the generic fallback is
+  // never the one that the compiler is aiming for.
+  if (!(iree_uk_mmt4d_info_p(&params) &
+        IREE_UK_FLAG_MMT4D_INFO_HAVE_ARCHITECTURE_SPECIFIC_TILE_FUNCTION) &&
+      !(candidate->flags &
+        IREE_UK_FLAG_MMT4D_ALLOW_GENERIC_FALLBACK_TILE_FUNCTION)) {
+    return;
+  }
+
+  iree_uk_mmt4d_autotune_result_t best = {
+      .flags = candidate->flags,
+      .M0 = M0,
+      .N0 = candidate->N0,
+      .K0 = candidate->K0,
+      .cpu_features = candidate->cpu_features,
+  };
+  // Narrow M0 tiles are only selected for narrow matmuls, which have a single
+  // tile along M.
+  int max_M = M0 < candidate->M0 ? 1 : FLAG_max_outer_tile_size;
+  for (int M = 1; M <= max_M; M *= 2) {
+    for (int N = 1; N <= FLAG_max_outer_tile_size; N *= 2) {
+      params.M = M;
+      params.N = N;
+      params.K = FLAG_k_size;
+      double gflops = iree_uk_mmt4d_autotune_measure(&params, engine);
+      if (gflops > best.gflops) {
+        best.M = M;
+        best.N = N;
+        best.gflops = gflops;
+      }
+    }
+  }
+
+  // The same type and tile shape may be listed for several sets of CPU
+  // features, e.g. avx512_base and avx512_vnni. Keep the fastest.
+  for (int i = 0; i < *result_count; ++i) {
+    iree_uk_mmt4d_autotune_result_t* result = &results[i];
+    if (iree_uk_mmt4d_type(result->flags) ==
+            iree_uk_mmt4d_type(best.flags) &&
+        result->M0 == best.M0 && result->N0 == best.N0 &&
+        result->K0 == best.K0) {
+      if (best.gflops > result->gflops) *result = best;
+      return;
+    }
+  }
+  IREE_UK_ASSERT(*result_count < IREE_UK_MMT4D_AUTOTUNE_MAX_RESULTS);
+  results[(*result_count)++] = best;
+}
+
+// Writes the MLIR spelling of `type`, e.g. `f32` or `i8`. Signedness is not
+// part of MLIR integer types.
+static void iree_uk_mmt4d_autotune_print_mlir_type(FILE* file,
+                                                   iree_uk_type_t type) {
+  int bit_count = iree_uk_type_bit_count(type);
+  switch (iree_uk_type_category(type)) {
+    case IREE_UK_TYPE_CATEGORY_FLOAT_IEEE:
+      fprintf(file, "f%d", bit_count);
+      break;
+    case IREE_UK_TYPE_CATEGORY_FLOAT_BRAIN:
+      fprintf(file, "bf%d", bit_count);
+      break;
+    default:
+      fprintf(file, "i%d", bit_count);
+      break;
+  }
+}
+
+static void iree_uk_mmt4d_autotune_print_operand_type(FILE* file, int size0,
+                                                      int size1,
+                                                      iree_uk_type_t type) {
+  fprintf(file, "tensor<?x?x%dx%dx", size0, size1);
+  iree_uk_mmt4d_autotune_print_mlir_type(file, type);
+  fprintf(file, ">");
+}
+
+static void iree_uk_mmt4d_autotune_print_matcher_name(
+    FILE* file, const iree_uk_mmt4d_autotune_result_t* result) {
+  char type_str[32];
+  iree_uk_type_triple_str(type_str, sizeof type_str,
+                          iree_uk_mmt4d_type(result->flags));
+  fprintf(file, "@match_mmt4d_%s_%dx%dx%d", type_str, result->M0, result->N0,
+          result->K0);
+}
+
+static void iree_uk_mmt4d_autotune_write_matcher(
+    FILE* file, const iree_uk_mmt4d_autotune_result_t* result) {
+  iree_uk_mmt4d_type_t mmt4d_type = iree_uk_mmt4d_type(result->flags);
+  fprintf(file, "transform.named_sequence\n");
+  iree_uk_mmt4d_autotune_print_matcher_name(file, result);
+  fprintf(file,
+          "(%%mmt4d: !transform.any_op {transform.readonly})\n"
+          "  -> (!transform.any_op, !transform.any_param) {\n"
+          "  transform.match.operation_name %%mmt4d [\"linalg.mmt4d\"] : "
+          "!transform.any_op\n"
+          "  transform.iree.match.has_no_lowering_config %%mmt4d : "
+          "!transform.any_op\n");
+  const char* operand_names[3] = {"lhs", "rhs", "acc"};
+  for (int i = 0; i < 3; ++i) {
+    fprintf(file,
+            "  %%%s = transform.get_operand %%mmt4d[%d] : (!transform.any_op) "
+            "-> !transform.any_value\n",
+            operand_names[i], i);
+  }
+  fprintf(file, "  transform.iree.match.cast_compatible_type %%lhs = ");
+  iree_uk_mmt4d_autotune_print_operand_type(
+      file, result->M0, result->K0, iree_uk_mmt4d_lhs_type(mmt4d_type));
+  fprintf(file, " : !transform.any_value\n");
+  fprintf(file, "  transform.iree.match.cast_compatible_type %%rhs = ");
+  iree_uk_mmt4d_autotune_print_operand_type(
+      file, result->N0, result->K0, iree_uk_mmt4d_rhs_type(mmt4d_type));
+  fprintf(file, " : !transform.any_value\n");
+  fprintf(file, "  transform.iree.match.cast_compatible_type %%acc = ");
+  iree_uk_mmt4d_autotune_print_operand_type(
+      file, result->M0, result->N0, iree_uk_mmt4d_out_type(mmt4d_type));
+  fprintf(file, " : !transform.any_value\n");
+  fprintf(file,
+          "  // %.1f GFLOP/s with %s.\n"
+          "  %%config = transform.param.constant "
+          "#iree_codegen.compilation_info<\n"
+          "    lowering_config = #iree_cpu.lowering_config<"
+          "distribution = [%d, %d, 0, 0, 0, 0], "
+          "vector_common_parallel = [1, 1, 0, %d, %d, 0], "
+          "vector_reduction = [0, 0, 1, 0, 0, %d]>,\n"
+          "    translation_info = #iree_codegen.translation_info<"
+          "pipeline = Mmt4dTilingExpert>\n"
+          "  > -> !transform.any_param\n"
+          "  transform.yield %%mmt4d, %%config : !transform.any_op, "
+          "!transform.any_param\n"
+          "}\n\n",
+          result->gflops,
+          strlen(result->cpu_features) ? result->cpu_features : "no features",
+          result->M, result->N, result->M0, result->N0, result->K0);
+}
+
+static void iree_uk_mmt4d_autotune_write_spec(
+    FILE* file, const iree_uk_mmt4d_autotune_result_t* results,
+    int result_count) {
+  fprintf(file,
+          "// Generated by mmt4d_autotune with --k_size=%d "
+          "--min_time_ms=%d --max_outer_tile_size=%d.\n",
+          FLAG_k_size, FLAG_min_time_ms, FLAG_max_outer_tile_size);
+  fprintf(file, "//\n// Fastest tile per type on this CPU:\n");
+  for (int i = 0; i < result_count; ++i) {
+    bool is_fastest = true;
+    for (int j = 0; j < result_count; ++j) {
+      if (iree_uk_mmt4d_type(results[j].flags) ==
+              iree_uk_mmt4d_type(results[i].flags) &&
+          results[j].gflops > results[i].gflops) {
+        is_fastest = false;
+      }
+    }
+    if (!is_fastest) continue;
+    char type_str[32];
+    iree_uk_type_triple_str(type_str, sizeof type_str,
+                            iree_uk_mmt4d_type(results[i].flags));
+    fprintf(file, "//   %s: %dx%dx%d (%.1f GFLOP/s)\n", type_str,
+            results[i].M0, results[i].N0, results[i].K0, results[i].gflops);
+  }
+  fprintf(file,
+          "\nmodule @iree_mmt4d_tuning_spec attributes { "
+          "transform.with_named_sequence, "
+          "iree_codegen.tuning_spec_with_default_entrypoint } {\n\n"
+          "transform.named_sequence @apply_op_config("
+          "%%op: !transform.any_op {transform.readonly},\n"
+          "                                          "
+          "%%config: !transform.any_param {transform.readonly}) {\n"
+          "  transform.annotate %%op \"compilation_info\" = %%config : "
+          "!transform.any_op, !transform.any_param\n"
+          "  transform.yield\n"
+          "}\n\n");
+  for (int i = 0; i < result_count; ++i) {
+    iree_uk_mmt4d_autotune_write_matcher(file, &results[i]);
+  }
+  fprintf(file,
+          "transform.named_sequence\n"
+          "@__kernel_config(%%variant_op: !transform.any_op "
+          "{transform.consumed}) -> !transform.any_op\n"
+          "  attributes { iree_codegen.tuning_spec_entrypoint } {\n"
+          "  %%res = transform.foreach_match in %%variant_op");
+  for (int i = 0; i < result_count; ++i) {
+    fprintf(file, "%s\n    ", i ? "," : "");
+    iree_uk_mmt4d_autotune_print_matcher_name(file, &results[i]);
+    fprintf(file, " -> @apply_op_config");
+  }
+  fprintf(file,
+          "\n    : (!transform.any_op) -> !transform.any_op\n"
+          "  transform.yield %%res : !transform.any_op\n"
+          "}\n\n"
+          "}\n");
+}
+
+int main(int argc, char** argv) {
+  iree_flags_set_usage(
+      "mmt4d_autotune",
+      "Measures the mmt4d tile functions available on this CPU and writes a\n"
+      "tuning spec for --iree-codegen-tuning-spec-path.\n");
+  iree_flags_parse_checked(IREE_FLAGS_PARSE_MODE_DEFAULT, &argc, &argv);
+  iree_uk_initialize_cpu_once();
+
+  iree_uk_mmt4d_autotune_result_t results[IREE_UK_MMT4D_AUTOTUNE_MAX_RESULTS];
+  int result_count = 0;
+  iree_uk_random_engine_t engine = iree_uk_random_engine_init();
+  int candidate_count = 0;
+  const iree_uk_mmt4d_tile_candidate_t* candidates =
+      iree_uk_mmt4d_tile_candidates(&candidate_count);
+  for (int i = 0; i < candidate_count; ++i) {
+    const iree_uk_mmt4d_tile_candidate_t* candidate = &candidates[i];
+    if (!iree_uk_mmt4d_autotune_type_selected(candidate->flags)) continue;
+    iree_uk_uint64_t cpu_data[IREE_CPU_DATA_FIELD_COUNT] = {0};
+    iree_uk_make_cpu_data_for_features(candidate->cpu_features, cpu_data);
+    if (!iree_uk_cpu_supports(cpu_data)) continue;
+    for (int M0 = 1; M0 < candidate->M0; M0 *= 2) {
+      iree_uk_mmt4d_autotune_tile(candidate, M0, cpu_data, &engine, results,
+                                  &result_count);
+    }
+    iree_uk_mmt4d_autotune_tile(candidate, candidate->M0, cpu_data, &engine,
+                                results, &result_count);
+  }
+
+  fprintf(stderr, "%-14s %-12s %-14s %-8s %s\n", "type", "M0xN0xK0",
+          "cpu_features", "MxN", "GFLOP/s");
+  for (int i = 0; i < result_count; ++i) {
+    char type_str[32];
+    char tile_str[32];
+    char outer_str[32];
+    iree_uk_type_triple_str(type_str, sizeof type_str,
+                            iree_uk_mmt4d_type(results[i].flags));
+    snprintf(tile_str, sizeof tile_str, "%dx%dx%d", results[i].M0,
+             results[i].N0, results[i].K0);
+    snprintf(outer_str, sizeof outer_str, "%dx%d", results[i].M,
+             results[i].N);
+    fprintf(stderr, "%-14s %-12s %-14s %-8s %.1f\n", type_str, tile_str,
+            results[i].cpu_features, outer_str, results[i].gflops);
+  }
+  if (!result_count) {
+    fprintf(stderr, "No mmt4d tile function to tune on this CPU.\n");
+    return EXIT_FAILURE;
+  }
+
+  if (!strlen(FLAG_output)) return EXIT_SUCCESS;
+  bool to_stdout = !strcmp(FLAG_output, "-");
+  FILE* file = to_stdout ? stdout : fopen(FLAG_output, "w");
+  if (!file) {
+    fprintf(stderr, "Failed to open %s for writing.\n", FLAG_output);
+    return EXIT_FAILURE;
+  }
+  iree_uk_mmt4d_autotune_write_spec(file, results, result_count);
+  if (!to_stdout) fclose(file);
+  return EXIT_SUCCESS;
+}
@@ -13,6 +13,7 @@
 #include "iree/builtins/ukernel/mmt4d.h"
 #include "iree/builtins/ukernel/mmt4d_internal.h"
 #include "iree/builtins/ukernel/tools/benchmark.h"
+#include "iree/builtins/ukernel/tools/mmt4d_tiles.h"
 #include "iree/builtins/ukernel/tools/util.h"
 
 IREE_FLAG(int32_t, m_size, 1,
@@ -124,91 +125,14 @@ int main(int argc, char** argv) {
   iree_flags_parse_checked(IREE_FLAGS_PARSE_MODE_UNDEFINED_OK, &argc, &argv);
   iree_uk_benchmark_initialize(&argc, argv);
 
-#if defined(IREE_ARCH_ARM_64)
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F32F32F32, 8, 8, 1,
-                                   "");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F16F16F32, 8, 8, 1,
-                                   "");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F16F16F32, 8, 8, 1,
-                                   "fp16fml");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F16F16F16, 8, 8, 1,
-                                   "");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F16F16F16, 8, 8, 1,
-                                   "fullfp16");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_BF16BF16F32, 8, 8, 4,
-                                   "bf16");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_BF16BF16BF16, 8, 8,
-                                   4, "bf16");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 8, 8, 1,
-                                   "");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 8, 8, 4,
-                                   "dotprod");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 8, 8, 8,
-                                   "i8mm");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_S8S4S32, 4, 16, 2,
-                                   "");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_S8S4S32, 8, 8, 8,
-                                   "dotprod");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_S8S4S32, 4, 8, 16,
-                                   "i8mm");
-#elif defined(IREE_ARCH_X86_64)
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F32F32F32, 8, 8, 1,
-                                   "avx2_fma");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F32F32F32, 16, 16, 1,
-                                   "avx512_base");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F16F16F32, 8, 8, 1,
-                                   "avx2_fma");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F16F16F32, 16, 16, 1,
-                                   "avx512_base");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F16F16F16, 8, 8, 1,
-                                   "avx2_fma");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F16F16F16, 16, 16, 1,
-                                   "avx512_base");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_BF16BF16F32, 16, 16,
-                                   2, "avx512_bf16");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_BF16BF16BF16, 16, 16,
-                                   2, "avx512_bf16");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 8, 8, 2,
-                                   "avx2_fma");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 16, 16, 2,
-                                   "avx512_base");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 16, 16, 2,
-                                   "avx512_vnni");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_S16S16S32, 8, 8, 2,
-                                   "avx2_fma");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_S16S16S32, 16, 16, 2,
-                                   "avx512_base");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_S16S16S32, 16, 16, 2,
-                                   "avx512_vnni");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_S16U4S32, 1, 32, 8,
-                                   "avx512_vnni");
-#elif defined(IREE_ARCH_RISCV_64)
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F32F32F32, 7, 16, 1,
-                                   "v");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F16F16F32, 6, 16, 1,
-                                   "zvfhmin");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F16F16F16, 6, 16, 1,
-                                   "zvfhmin");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F16F16F32, 7, 16, 1,
-                                   "zvfh");
-  iree_uk_benchmark_register_mmt4d(IREE_UK_FLAG_MMT4D_TYPE_F16F16F16, 7, 16, 1,
-                                   "zvfh");
-  iree_uk_benchmark_register_mmt4d(
-      IREE_UK_FLAG_MMT4D_SKIP_INTERMEDIATE_ROUNDINGS |
-          IREE_UK_FLAG_MMT4D_TYPE_F16F16F16,
-      7, 16, 1, "zvfh");
-#else   // defined(IREE_ARCH_ARM_64)
-  // Architectures on which we do not have any optimized ukernel code.
-  // Benchmark some arbitrary tile shape.
-  iree_uk_benchmark_register_mmt4d(
-      IREE_UK_FLAG_MMT4D_ALLOW_GENERIC_FALLBACK_TILE_FUNCTION |
-          IREE_UK_FLAG_MMT4D_TYPE_F32F32F32,
-      8, 8, 1, "");
-  iree_uk_benchmark_register_mmt4d(
-      IREE_UK_FLAG_MMT4D_ALLOW_GENERIC_FALLBACK_TILE_FUNCTION |
-          IREE_UK_FLAG_MMT4D_TYPE_S8S8S32,
-      8, 8, 1, "");
-#endif  // defined(IREE_ARCH_ARM_64)
+  int candidate_count = 0;
+  const iree_uk_mmt4d_tile_candidate_t* candidates =
+      iree_uk_mmt4d_tile_candidates(&candidate_count);
+  for (int i = 0; i < candidate_count; ++i) {
+    iree_uk_benchmark_register_mmt4d(candidates[i].flags, candidates[i].M0,
+                                     candidates[i].N0, candidates[i].K0,
+                                     candidates[i].cpu_features);
+  }
 
   iree_uk_benchmark_run_and_cleanup();
 }
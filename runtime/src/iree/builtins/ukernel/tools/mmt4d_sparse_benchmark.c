@@ -0,0 +1,215 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <stdio.h>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/flags.h"
+#include "iree/builtins/ukernel/api.h"
+#include "iree/builtins/ukernel/exported_bits.h"
+#include "iree/builtins/ukernel/mmt4d_sparse_internal.h"
+#include "iree/builtins/ukernel/tools/benchmark.h"
+#include "iree/builtins/ukernel/tools/mmt4d_tiles.h"
+#include "iree/builtins/ukernel/tools/util.h"
+
+// Each tile shape is benchmarked with a dense RHS and with each sparse RHS
+// format. Items processed are the FLOPs of the equivalent dense mmt4d, so that
+// the reported rates compare directly with the dense case.
+
+IREE_FLAG(int32_t, m_size, 1,
+          "M-dimension of mmt4d ops. The overall number of rows of the "
+          "accumulator is that times the M0 tile size.");
+IREE_FLAG(int32_t, n_size, 16,
+          "N-dimension of mmt4d ops. The overall number of columns of the "
+          "accumulator is that times the N0 tile size.");
+IREE_FLAG(
+    int32_t, k_size, 256,
+    "K-dimension of mmt4d ops. The overall accumulation depth is that times "
+    "the K0 tile size. Must be a multiple of 4 for the 2:4 format.");
+IREE_FLAG(int32_t, block_density_percent, 50,
+          "Percentage of nonzero RHS tiles in the block-sparse format.");
+
+// Zeroes RHS tiles (FORMAT_BLOCK) or 2 out of each group of 4 elements along
+// K (FORMAT_2_4). Leaves a dense RHS (FORMAT_NONE) untouched.
+static void iree_uk_benchmark_mmt4d_sparse_sparsify_rhs(
+    const iree_uk_mmt4d_params_t* params, char* rhs,
+    iree_uk_random_engine_t* engine) {
+  iree_uk_type_t rhs_type =
+      iree_uk_mmt4d_rhs_type(iree_uk_mmt4d_type(params->flags));
+  iree_uk_index_t tile_size = iree_uk_bits_to_bytes_exact(
+      (params->N0 * params->K0) << iree_uk_type_bit_count_log2(rhs_type));
+  switch (params->flags & IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_MASK) {
+    case IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_BLOCK:
+      for (iree_uk_index_t t = 0; t < params->N * params->K; ++t) {
+        if (iree_uk_random_engine_get_0_65535(engine) % 100 >=
+            FLAG_block_density_percent) {
+          memset(rhs + t * tile_size, 0, tile_size);
+        }
+      }
+      break;
+    case IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_2_4: {
+      // Keep the elements at positions 0 and 2 of each group: performance does
+      // not depend on which ones are kept.
+      iree_uk_index_t elem_size = iree_uk_type_size(rhs_type);
+      iree_uk_index_t elem_count = params->N * params->K * params->N0 *
+                                   params->K0;
+      iree_uk_index_t row_size = params->K * params->N0 * params->K0;
+      for (iree_uk_index_t i = 0; i < elem_count; ++i) {
+        iree_uk_index_t k_in_row = i % row_size;
+        iree_uk_index_t k = (k_in_row / (params->N0 * params->K0)) *
+                                params->K0 +
+                            k_in_row % params->K0;
+        if (k % 2) memset(rhs + i * elem_size, 0, elem_size);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+static iree_status_t iree_uk_benchmark_mmt4d_sparse(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  const iree_uk_benchmark_user_data_t* user_data = benchmark_def->user_data;
+  const iree_uk_mmt4d_params_t* src_params =
+      iree_uk_benchmark_params(user_data);
+  iree_uk_mmt4d_params_t params;
+  memcpy(&params, src_params, sizeof params);
+  params.cpu_data = iree_uk_benchmark_cpu_data(user_data);
+  params.M = FLAG_m_size;
+  params.N = FLAG_n_size;
+  params.K = FLAG_k_size;
+  params.lhs_stride0 = params.K * params.M0 * params.K0;
+  params.rhs_stride0 = params.K * params.N0 * params.K0;
+  params.out_stride0 = params.N * params.M0 * params.N0;
+  iree_uk_mmt4d_type_t mmt4d_type = iree_uk_mmt4d_type(params.flags);
+  iree_uk_type_t lhs_type = iree_uk_mmt4d_lhs_type(mmt4d_type);
+  iree_uk_type_t rhs_type = iree_uk_mmt4d_rhs_type(mmt4d_type);
+  iree_uk_type_t out_type = iree_uk_mmt4d_out_type(mmt4d_type);
+  iree_uk_index_t lhs_buffer_size =
+      iree_uk_2d_buffer_length(lhs_type, params.M, params.lhs_stride0);
+  iree_uk_index_t rhs_buffer_size =
+      iree_uk_2d_buffer_length(rhs_type, params.N, params.rhs_stride0);
+  iree_uk_index_t out_buffer_size =
+      iree_uk_2d_buffer_length(out_type, params.M, params.out_stride0);
+  void* lhs_buffer = malloc(lhs_buffer_size);
+  void* rhs_buffer = malloc(rhs_buffer_size);
+  void* out_buffer = malloc(out_buffer_size);
+  iree_uk_random_engine_t* engine = iree_uk_benchmark_random_engine(user_data);
+  iree_uk_write_random_buffer(lhs_buffer, lhs_buffer_size, lhs_type, engine);
+  iree_uk_write_random_buffer(rhs_buffer, rhs_buffer_size, rhs_type, engine);
+  iree_uk_write_random_buffer(out_buffer, out_buffer_size, out_type, engine);
+  iree_uk_benchmark_mmt4d_sparse_sparsify_rhs(&params, rhs_buffer, engine);
+  params.lhs_buffer = lhs_buffer;
+  params.rhs_buffer = rhs_buffer;
+  params.out_buffer = out_buffer;
+
+  bool is_sparse = params.flags & IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_MASK;
+  bool is_block = (params.flags & IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_MASK) ==
+                  IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_BLOCK;
+  iree_uk_mmt4d_sparse_params_t sparse_params = {.mmt4d = params};
+  void* rhs_values = NULL;
+  iree_uk_int32_t* rhs_row_offsets = NULL;
+  void* rhs_indices = NULL;
+  if (is_sparse) {
+    iree_uk_index_t value_count = iree_uk_mmt4d_sparse_compress_rhs(
+        rhs_buffer, 0, params.rhs_stride0, NULL, NULL, NULL, params.N,
+        params.K, params.N0, params.K0, params.flags);
+    iree_uk_index_t tile_count = value_count / (params.N0 * params.K0);
+    rhs_values = malloc(1 + iree_uk_bits_to_bytes_exact(
+                                value_count
+                                << iree_uk_type_bit_count_log2(rhs_type)));
+    rhs_row_offsets = malloc((params.N + 1) * sizeof(iree_uk_int32_t));
+    rhs_indices =
+        malloc(1 + (is_block ? tile_count * sizeof(iree_uk_int32_t)
+                             : params.N * params.K * params.N0 * params.K0 /
+                                   4));
+    iree_uk_mmt4d_sparse_compress_rhs(
+        rhs_buffer, 0, params.rhs_stride0, rhs_values, rhs_row_offsets,
+        rhs_indices, params.N, params.K, params.N0, params.K0, params.flags);
+    sparse_params.mmt4d.rhs_buffer = rhs_values;
+    sparse_params.rhs_row_offsets = rhs_row_offsets;
+    sparse_params.rhs_indices = rhs_indices;
+  }
+
+  int64_t total_iterations = 0;
+  int64_t batch_count = 1;
+  while (iree_benchmark_keep_running(benchmark_state, batch_count)) {
+    for (int i = 0; i < batch_count; ++i) {
+      if (is_sparse) {
+        iree_uk_mmt4d_sparse_p(&sparse_params);
+      } else {
+        iree_uk_mmt4d_p(&params);
+      }
+    }
+    total_iterations += batch_count;
+    batch_count *= 2;
+  }
+  iree_benchmark_set_items_processed(
+      benchmark_state, total_iterations * 2 * params.M * params.N * params.K *
+                           params.M0 * params.N0 * params.K0);
+  free(rhs_values);
+  free(rhs_row_offsets);
+  free(rhs_indices);
+  free(lhs_buffer);
+  free(rhs_buffer);
+  free(out_buffer);
+  return iree_ok_status();
+}
+
+static void iree_uk_benchmark_register_mmt4d_sparse_impl(
+    iree_uk_uint32_t flags, int M0, int N0, int K0, const char* cpu_features,
+    const char* format_str) {
+  char type_str[32];
+  iree_uk_type_triple_str(type_str, sizeof type_str,
+                          iree_uk_mmt4d_type(flags));
+  char name[128];
+  snprintf(name, sizeof name, "mmt4d_%s_tile_%dx%dx%d_%s", type_str, M0, N0,
+           K0, format_str);
+  iree_uk_mmt4d_params_t params = {
+      .flags = flags | IREE_UK_FLAG_MMT4D_SKIP_INTERMEDIATE_ROUNDINGS |
+               IREE_UK_FLAG_MMT4D_ALLOW_GENERIC_FALLBACK_TILE_FUNCTION,
+      .M0 = M0,
+      .N0 = N0,
+      .K0 = K0};
+  iree_uk_benchmark_register(name, iree_uk_benchmark_mmt4d_sparse, &params,
+                             sizeof params, cpu_features);
+}
+
+static void iree_uk_benchmark_register_mmt4d_sparse(iree_uk_uint32_t flags,
+                                                    int M0, int N0, int K0,
+                                                    const char* cpu_features) {
+  iree_uk_benchmark_register_mmt4d_sparse_impl(flags, M0, N0, K0, cpu_features,
+                                               "dense");
+  iree_uk_benchmark_register_mmt4d_sparse_impl(
+      flags | IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_BLOCK, M0, N0, K0, cpu_features,
+      "block");
+  iree_uk_type_t rhs_type = iree_uk_mmt4d_rhs_type(iree_uk_mmt4d_type(flags));
+  if (iree_uk_type_bit_count(rhs_type) >= 8) {
+    iree_uk_benchmark_register_mmt4d_sparse_impl(
+        flags | IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_2_4, M0, N0, K0, cpu_features,
+        "2_4");
+  }
+}
+
+int main(int argc, char** argv) {
+  iree_flags_set_usage("mmt4d_sparse_benchmark", "");
+
+  iree_flags_parse_checked(IREE_FLAGS_PARSE_MODE_UNDEFINED_OK, &argc, &argv);
+  iree_uk_benchmark_initialize(&argc, argv);
+
+  int candidate_count = 0;
+  const iree_uk_mmt4d_tile_candidate_t* candidates =
+      iree_uk_mmt4d_tile_candidates(&candidate_count);
+  for (int i = 0; i < candidate_count; ++i) {
+    iree_uk_benchmark_register_mmt4d_sparse(
+        candidates[i].flags, candidates[i].M0, candidates[i].N0,
+        candidates[i].K0, candidates[i].cpu_features);
+  }
+
+  iree_uk_benchmark_run_and_cleanup();
+}
@@ -0,0 +1,243 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/base/api.h"
+#include "iree/builtins/ukernel/api.h"
+#include "iree/builtins/ukernel/exported_bits.h"
+#include "iree/builtins/ukernel/mmt4d_sparse_internal.h"
+#include "iree/builtins/ukernel/tools/test.h"
+#include "iree/builtins/ukernel/tools/util.h"
+
+// The reference is the dense mmt4d (tested in mmt4d_test) on the same RHS,
+// with its zeros stored explicitly.
+
+// Zeroes random parts of the dense packed RHS so that it fits the sparse format
+// in `flags`: about half of the N0xK0 tiles for FORMAT_BLOCK, and 2 out of each
+// group of 4 consecutive elements along K for FORMAT_2_4.
+static void iree_uk_test_mmt4d_sparse_sparsify_rhs(
+    const iree_uk_mmt4d_params_t* params, char* rhs,
+    iree_uk_random_engine_t* engine) {
+  iree_uk_type_t rhs_type =
+      iree_uk_mmt4d_rhs_type(iree_uk_mmt4d_type(params->flags));
+  iree_uk_index_t row_size = iree_uk_bits_to_bytes_exact(
+      params->rhs_stride0 << iree_uk_type_bit_count_log2(rhs_type));
+  iree_uk_index_t tile_size = iree_uk_bits_to_bytes_exact(
+      (params->N0 * params->K0) << iree_uk_type_bit_count_log2(rhs_type));
+  if ((params->flags & IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_MASK) ==
+      IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_BLOCK) {
+    for (iree_uk_index_t n = 0; n < params->N; ++n) {
+      for (iree_uk_index_t k = 0; k < params->K; ++k) {
+        if (iree_uk_random_engine_get_0_1(engine)) {
+          memset(rhs + n * row_size + k * tile_size, 0, tile_size);
+        }
+      }
+    }
+    return;
+  }
+  iree_uk_index_t elem_size = iree_uk_type_size(rhs_type);
+  for (iree_uk_index_t n = 0; n < params->N; ++n) {
+    for (iree_uk_index_t g = 0; g < params->K * params->K0 / 4; ++g) {
+      for (int n0 = 0; n0 < params->N0; ++n0) {
+        int kept0 = iree_uk_random_engine_get_0_65535(engine) % 4;
+        int kept1 =
+            (kept0 + 1 + iree_uk_random_engine_get_0_65535(engine) % 3) % 4;
+        for (int p = 0; p < 4; ++p) {
+          if (p == kept0 || p == kept1) continue;
+          iree_uk_index_t k = 4 * g + p;
+          iree_uk_index_t offset = (k / params->K0) * params->N0 * params->K0 +
+                                   n0 * params->K0 + k % params->K0;
+          memset(rhs + n * row_size + offset * elem_size, 0, elem_size);
+        }
+      }
+    }
+  }
+}
+
+static void iree_uk_test_mmt4d_sparse_for_shape_params(
+    iree_uk_test_t* test, const iree_uk_mmt4d_params_t* src_params) {
+  iree_uk_mmt4d_params_t params;
+  memcpy(&params, src_params, sizeof params);
+  iree_uk_mmt4d_type_t mmt4d_type = iree_uk_mmt4d_type(params.flags);
+  iree_uk_type_t lhs_type = iree_uk_mmt4d_lhs_type(mmt4d_type);
+  iree_uk_type_t rhs_type = iree_uk_mmt4d_rhs_type(mmt4d_type);
+  iree_uk_type_t out_type = iree_uk_mmt4d_out_type(mmt4d_type);
+  iree_uk_random_engine_t* engine = iree_uk_test_random_engine(test);
+  params.lhs_stride0 = params.K * params.M0 * params.K0;
+  params.rhs_stride0 = params.K * params.N0 * params.K0;
+  params.out_stride0 = params.N * params.M0 * params.N0;
+  iree_uk_index_t lhs_buffer_size =
+      iree_uk_2d_buffer_length(lhs_type, params.M, params.lhs_stride0);
+  iree_uk_index_t rhs_buffer_size =
+      iree_uk_2d_buffer_length(rhs_type, params.N, params.rhs_stride0);
+  iree_uk_index_t out_buffer_size =
+      iree_uk_2d_buffer_length(out_type, params.M, params.out_stride0);
+  void* lhs_buffer = malloc(lhs_buffer_size);
+  void* rhs_buffer = malloc(rhs_buffer_size);
+  iree_uk_write_random_buffer(lhs_buffer, lhs_buffer_size, lhs_type, engine);
+  iree_uk_write_random_buffer(rhs_buffer, rhs_buffer_size, rhs_type, engine);
+  iree_uk_test_mmt4d_sparse_sparsify_rhs(&params, rhs_buffer, engine);
+  params.lhs_buffer = lhs_buffer;
+  params.rhs_buffer = rhs_buffer;
+
+  // Compress the RHS: first query the sizes, then fill the buffers.
+  iree_uk_index_t value_count = iree_uk_mmt4d_sparse_compress_rhs(
+      rhs_buffer, 0, params.rhs_stride0, NULL, NULL, NULL, params.N, params.K,
+      params.N0, params.K0, params.flags);
+  if (value_count < 0) {
+    IREE_UK_TEST_FAIL(test);
+    free(lhs_buffer);
+    free(rhs_buffer);
+    return;
+  }
+  bool is_block = (params.flags & IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_MASK) ==
+                  IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_BLOCK;
+  iree_uk_index_t tile_count = value_count / (params.N0 * params.K0);
+  // Allocate at least 1 byte, as malloc(0) may return NULL.
+  void* rhs_values =
+      malloc(1 + iree_uk_bits_to_bytes_exact(
+                     value_count << iree_uk_type_bit_count_log2(rhs_type)));
+  iree_uk_int32_t* rhs_row_offsets =
+      is_block ? malloc((params.N + 1) * sizeof(iree_uk_int32_t)) : NULL;
+  void* rhs_indices =
+      malloc(1 + (is_block ? tile_count * sizeof(iree_uk_int32_t)
+                           : params.N * params.K * params.N0 * params.K0 / 4));
+  if (iree_uk_mmt4d_sparse_compress_rhs(
+          rhs_buffer, 0, params.rhs_stride0, rhs_values, rhs_row_offsets,
+          rhs_indices, params.N, params.K, params.N0, params.K0,
+          params.flags) != value_count) {
+    IREE_UK_TEST_FAIL(test);
+  }
+
+  void* init_out_buffer = malloc(out_buffer_size);
+  iree_uk_write_random_buffer(init_out_buffer, out_buffer_size, out_type,
+                              engine);
+  void* reference_out_buffer = malloc(out_buffer_size);
+  memcpy(reference_out_buffer, init_out_buffer, out_buffer_size);
+  void* actual_out_buffer = malloc(out_buffer_size);
+  memcpy(actual_out_buffer, init_out_buffer, out_buffer_size);
+
+  iree_uk_mmt4d_params_t reference_params;
+  memcpy(&reference_params, &params, sizeof params);
+  reference_params.flags &= ~IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_MASK;
+  reference_params.out_buffer = reference_out_buffer;
+  iree_uk_mmt4d_p(&reference_params);
+
+  iree_uk_mmt4d_sparse_params_t actual_params = {
+      .mmt4d = params,
+      .rhs_row_offsets = rhs_row_offsets,
+      .rhs_indices = rhs_indices,
+  };
+  actual_params.mmt4d.rhs_buffer = rhs_values;
+  actual_params.mmt4d.rhs_stride0 = 0;
+  actual_params.mmt4d.out_buffer = actual_out_buffer;
+  iree_uk_mmt4d_sparse_p(&actual_params);
+
+  // Exact comparison, as in mmt4d_test: test matrix elements are small
+  // integers, and skipping zero products does not change any sum.
+  if (memcmp(actual_out_buffer, reference_out_buffer, out_buffer_size)) {
+    IREE_UK_TEST_FAIL(test);
+  }
+
+  free(init_out_buffer);
+  free(reference_out_buffer);
+  free(actual_out_buffer);
+  free(rhs_values);
+  free(rhs_row_offsets);
+  free(rhs_indices);
+  free(lhs_buffer);
+  free(rhs_buffer);
+}
+
+static void iree_uk_test_mmt4d_sparse_for_tile_params(iree_uk_test_t* test,
+                                                      const void* src_params) {
+  typedef struct shape_mnk_t {
+    int m, n, k;
+  } shape_mnk_t;
+  // K values are multiples of 4 so that any K0 suits the 2:4 format. The
+  // largest one spans several chunks of expanded 2:4 tiles.
+  const shape_mnk_t shapes[] = {
+      {0, 1, 4}, {1, 0, 4},  {1, 1, 0},  {5, 7, 0},   {1, 1, 4},
+      {2, 1, 8}, {1, 2, 12}, {5, 7, 16}, {3, 2, 100}, {1, 1, 1000},
+  };
+  for (int i = 0; i < IREE_ARRAYSIZE(shapes); ++i) {
+    iree_uk_mmt4d_params_t params;
+    memcpy(&params, src_params, sizeof params);
+    params.cpu_data = iree_uk_test_cpu_data(test);
+    params.M = shapes[i].m;
+    params.N = shapes[i].n;
+    params.K = shapes[i].k;
+    for (int accumulate = 0; accumulate <= 1; ++accumulate) {
+      if (accumulate) params.flags |= IREE_UK_FLAG_MMT4D_ACCUMULATE;
+      iree_uk_test_mmt4d_sparse_for_shape_params(test, &params);
+    }
+  }
+}
+
+static void iree_uk_test_mmt4d_sparse(iree_uk_uint32_t flags, int M0, int N0,
+                                      int K0, const char* cpu_features) {
+  flags |= IREE_UK_FLAG_MMT4D_ALLOW_GENERIC_FALLBACK_TILE_FUNCTION;
+  char types_str[32];
+  iree_uk_type_triple_str(types_str, sizeof types_str,
+                          iree_uk_mmt4d_type(flags));
+  iree_uk_mmt4d_params_t params = {
+      .flags = flags, .M0 = M0, .N0 = N0, .K0 = K0};
+  char test_label_str[256];
+  snprintf(test_label_str, sizeof test_label_str,
+           "types:%s tile:%dx%dx%d format:%s", types_str, M0, N0, K0,
+           (flags & IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_MASK) ==
+                   IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_BLOCK
+               ? "block"
+               : "2:4");
+  iree_uk_test(test_label_str, iree_uk_test_mmt4d_sparse_for_tile_params,
+               &params, cpu_features);
+}
+
+// Tests both sparse formats, except 2:4 on sub-byte RHS types.
+static void iree_uk_test_mmt4d_sparse_formats(iree_uk_uint32_t flags, int M0,
+                                              int N0, int K0,
+                                              const char* cpu_features) {
+  iree_uk_test_mmt4d_sparse(flags | IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_BLOCK, M0,
+                            N0, K0, cpu_features);
+  if (iree_uk_type_bit_count(iree_uk_mmt4d_rhs_type(iree_uk_mmt4d_type(
+          flags))) >= 8) {
+    iree_uk_test_mmt4d_sparse(flags | IREE_UK_FLAG_MMT4D_SPARSE_FORMAT_2_4, M0,
+                              N0, K0, cpu_features);
+  }
+}
+
+int main(int argc, char** argv) {
+  // Generic tests, with odd tile sizes.
+  iree_uk_test_mmt4d_sparse_formats(IREE_UK_FLAG_MMT4D_TYPE_F32F32F32, 3, 5, 7,
+                                    "");
+  iree_uk_test_mmt4d_sparse_formats(IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 9, 6, 3,
+                                    "");
+  iree_uk_test_mmt4d_sparse_formats(IREE_UK_FLAG_MMT4D_TYPE_S8S4S32, 9, 12, 2,
+                                    "");
+  iree_uk_test_mmt4d_sparse_formats(IREE_UK_FLAG_MMT4D_TYPE_F16F16F32, 4, 6, 5,
+                                    "");
+
+  // Architecture-specific tile functions.
+#if defined(IREE_ARCH_ARM_64)
+  iree_uk_test_mmt4d_sparse_formats(IREE_UK_FLAG_MMT4D_TYPE_F32F32F32, 8, 8, 1,
+                                    "");
+  iree_uk_test_mmt4d_sparse_formats(IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 8, 8, 4,
+                                    "dotprod");
+#elif defined(IREE_ARCH_X86_64)
+  iree_uk_test_mmt4d_sparse_formats(IREE_UK_FLAG_MMT4D_TYPE_F32F32F32, 8, 8, 1,
+                                    "avx2_fma");
+  iree_uk_test_mmt4d_sparse_formats(IREE_UK_FLAG_MMT4D_TYPE_F32F32F32, 16, 16,
+                                    1, "avx512_base");
+  iree_uk_test_mmt4d_sparse_formats(IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 16, 16, 2,
+                                    "avx512_vnni");
+  iree_uk_test_mmt4d_sparse_formats(IREE_UK_FLAG_MMT4D_TYPE_BF16BF16F32, 16, 16,
+                                    2, "avx512_bf16");
+#elif defined(IREE_ARCH_RISCV_64)
+  iree_uk_test_mmt4d_sparse_formats(IREE_UK_FLAG_MMT4D_TYPE_F32F32F32, 7, 16, 1,
+                                    "v");
+#endif  // defined(IREE_ARCH_ARM_64)
+
+  return iree_uk_test_exit_status();
+}
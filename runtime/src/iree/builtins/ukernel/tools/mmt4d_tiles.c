@@ -0,0 +1,69 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/builtins/ukernel/tools/mmt4d_tiles.h"
+
+#include "iree/base/api.h"
+#include "iree/builtins/ukernel/exported_bits.h"
+
+static const iree_uk_mmt4d_tile_candidate_t
+    iree_uk_mmt4d_tile_candidates_table[] = {
+#if defined(IREE_ARCH_ARM_64)
+    {IREE_UK_FLAG_MMT4D_TYPE_F32F32F32, 8, 8, 1, ""},
+    {IREE_UK_FLAG_MMT4D_TYPE_F16F16F32, 8, 8, 1, ""},
+    {IREE_UK_FLAG_MMT4D_TYPE_F16F16F32, 8, 8, 1, "fp16fml"},
+    {IREE_UK_FLAG_MMT4D_TYPE_F16F16F16, 8, 8, 1, ""},
+    {IREE_UK_FLAG_MMT4D_TYPE_F16F16F16, 8, 8, 1, "fullfp16"},
+    {IREE_UK_FLAG_MMT4D_TYPE_BF16BF16F32, 8, 8, 4, "bf16"},
+    {IREE_UK_FLAG_MMT4D_TYPE_BF16BF16BF16, 8, 8, 4, "bf16"},
+    {IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 8, 8, 1, ""},
+    {IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 8, 8, 4, "dotprod"},
+    {IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 8, 8, 8, "i8mm"},
+    {IREE_UK_FLAG_MMT4D_TYPE_S8S4S32, 4, 16, 2, ""},
+    {IREE_UK_FLAG_MMT4D_TYPE_S8S4S32, 8, 8, 8, "dotprod"},
+    {IREE_UK_FLAG_MMT4D_TYPE_S8S4S32, 4, 8, 16, "i8mm"},
+#elif defined(IREE_ARCH_X86_64)
+    {IREE_UK_FLAG_MMT4D_TYPE_F32F32F32, 8, 8, 1, "avx2_fma"},
+    {IREE_UK_FLAG_MMT4D_TYPE_F32F32F32, 16, 16, 1, "avx512_base"},
+    {IREE_UK_FLAG_MMT4D_TYPE_F16F16F32, 8, 8, 1, "avx2_fma"},
+    {IREE_UK_FLAG_MMT4D_TYPE_F16F16F32, 16, 16, 1, "avx512_base"},
+    {IREE_UK_FLAG_MMT4D_TYPE_F16F16F16, 8, 8, 1, "avx2_fma"},
+    {IREE_UK_FLAG_MMT4D_TYPE_F16F16F16, 16, 16, 1, "avx512_base"},
+    {IREE_UK_FLAG_MMT4D_TYPE_BF16BF16F32, 16, 16, 2, "avx512_bf16"},
+    {IREE_UK_FLAG_MMT4D_TYPE_BF16BF16BF16, 16, 16, 2, "avx512_bf16"},
+    {IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 8, 8, 2, "avx2_fma"},
+    {IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 16, 16, 2, "avx512_base"},
+    {IREE_UK_FLAG_MMT4D_TYPE_S8S8S32, 16, 16, 2, "avx512_vnni"},
+    {IREE_UK_FLAG_MMT4D_TYPE_S16S16S32, 8, 8, 2, "avx2_fma"},
+    {IREE_UK_FLAG_MMT4D_TYPE_S16S16S32, 16, 16, 2, "avx512_base"},
+    {IREE_UK_FLAG_MMT4D_TYPE_S16S16S32, 16, 16, 2, "avx512_vnni"},
+    {IREE_UK_FLAG_MMT4D_TYPE_S16U4S32, 1, 32, 8, "avx512_vnni"},
+#elif defined(IREE_ARCH_RISCV_64)
+    {IREE_UK_FLAG_MMT4D_TYPE_F32F32F32, 7, 16, 1, "v"},
+    {IREE_UK_FLAG_MMT4D_TYPE_F16F16F32, 6, 16, 1, "zvfhmin"},
+    {IREE_UK_FLAG_MMT4D_TYPE_F16F16F16, 6, 16, 1, "zvfhmin"},
+    {IREE_UK_FLAG_MMT4D_TYPE_F16F16F32, 7, 16, 1, "zvfh"},
+    {IREE_UK_FLAG_MMT4D_TYPE_F16F16F16, 7, 16, 1, "zvfh"},
+    {IREE_UK_FLAG_MMT4D_SKIP_INTERMEDIATE_ROUNDINGS |
+         IREE_UK_FLAG_MMT4D_TYPE_F16F16F16,
+     7, 16, 1, "zvfh"},
+#else   // defined(IREE_ARCH_ARM_64)
+    // Architectures on which we do not have any optimized ukernel code.
+    // Use some arbitrary tile shape.
+    {IREE_UK_FLAG_MMT4D_ALLOW_GENERIC_FALLBACK_TILE_FUNCTION |
+         IREE_UK_FLAG_MMT4D_TYPE_F32F32F32,
+     8, 8, 1, ""},
+    {IREE_UK_FLAG_MMT4D_ALLOW_GENERIC_FALLBACK_TILE_FUNCTION |
+         IREE_UK_FLAG_MMT4D_TYPE_S8S8S32,
+     8, 8, 1, ""},
+#endif  // defined(IREE_ARCH_ARM_64)
+};
+
+const iree_uk_mmt4d_tile_candidate_t* iree_uk_mmt4d_tile_candidates(
+    int* count) {
+  *count = IREE_ARRAYSIZE(iree_uk_mmt4d_tile_candidates_table);
+  return iree_uk_mmt4d_tile_candidates_table;
+}
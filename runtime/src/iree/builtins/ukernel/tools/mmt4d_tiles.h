@@ -0,0 +1,31 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_BUILTINS_UKERNEL_TOOLS_MMT4D_TILES_H_
+#define IREE_BUILTINS_UKERNEL_TOOLS_MMT4D_TILES_H_
+
+#include "iree/builtins/ukernel/common.h"
+
+// A mmt4d tile shape for which the current architecture has a tile function,
+// together with the CPU features that this tile function requires. Narrower
+// power-of-two M0 values are implied: mmt4d tile functions tend to have narrow
+// variants for handling those cases.
+typedef struct iree_uk_mmt4d_tile_candidate_t {
+  iree_uk_uint32_t flags;
+  int M0;
+  int N0;
+  int K0;
+  const char* cpu_features;
+} iree_uk_mmt4d_tile_candidate_t;
+
+// Returns the table of mmt4d tile candidates for the current architecture and
+// stores its length in `*count`. On architectures without optimized mmt4d
+// code, the table lists arbitrary tile shapes with the
+// IREE_UK_FLAG_MMT4D_ALLOW_GENERIC_FALLBACK_TILE_FUNCTION flag.
+const iree_uk_mmt4d_tile_candidate_t* iree_uk_mmt4d_tile_candidates(
+    int* count);
+
+#endif  // IREE_BUILTINS_UKERNEL_TOOLS_MMT4D_TILES_H_
@@ -0,0 +1,152 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <stdio.h>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/flags.h"
+#include "iree/builtins/ukernel/api.h"
+#include "iree/builtins/ukernel/normalize_internal.h"
+#include "iree/builtins/ukernel/tools/benchmark.h"
+#include "iree/builtins/ukernel/tools/memcpy_benchmark.h"
+#include "iree/builtins/ukernel/tools/util.h"
+
+IREE_FLAG(
+    int64_t, working_set_size, 100000,
+    "Number of bytes to be traversed by the benchmark workload (input and "
+    "output buffers together). The number of rows is computed accordingly.");
+IREE_FLAG(int32_t, row_size, 1024,
+          "Number of elements in each normalized row (size1).");
+
+static iree_status_t iree_uk_benchmark_normalize(
+    const iree_benchmark_def_t* benchmark_def,
+    iree_benchmark_state_t* benchmark_state) {
+  const iree_uk_benchmark_user_data_t* user_data = benchmark_def->user_data;
+  const iree_uk_normalize_params_t* src_params =
+      iree_uk_benchmark_params(user_data);
+  iree_uk_normalize_params_t params;
+  memcpy(&params, src_params, sizeof params);
+  params.cpu_data = iree_uk_benchmark_cpu_data(user_data);
+  iree_uk_type_t type =
+      iree_uk_normalize_in_type(iree_uk_normalize_type(params.flags));
+  iree_uk_index_t type_size = iree_uk_type_size(type);
+
+  params.size1 = FLAG_row_size;
+  params.size0 =
+      iree_max(1, FLAG_working_set_size / (2 * type_size * params.size1));
+  params.in_stride0 = params.size1;
+  params.out_stride0 = params.size1;
+  params.epsilon = 1e-5f;
+  iree_uk_index_t buffer_size =
+      iree_uk_2d_buffer_length(type, params.size0, params.in_stride0);
+  iree_uk_index_t vec_buffer_size = params.size1 * type_size;
+  void* in_buffer = malloc(buffer_size);
+  void* out_buffer = malloc(buffer_size);
+  void* gamma_buffer = malloc(vec_buffer_size);
+  void* beta_buffer = malloc(vec_buffer_size);
+  iree_uk_random_engine_t* engine = iree_uk_benchmark_random_engine(user_data);
+  iree_uk_write_random_buffer(in_buffer, buffer_size, type, engine);
+  iree_uk_write_random_buffer(out_buffer, buffer_size, type, engine);
+  iree_uk_write_random_buffer(gamma_buffer, vec_buffer_size, type, engine);
+  iree_uk_write_random_buffer(beta_buffer, vec_buffer_size, type, engine);
+  params.in_buffer = in_buffer;
+  params.out_buffer = out_buffer;
+  if (params.op != iree_uk_normalize_op_softmax) {
+    params.gamma_buffer = gamma_buffer;
+  }
+  if (params.op == iree_uk_normalize_op_layernorm) {
+    params.beta_buffer = beta_buffer;
+  }
+  int64_t total_iterations = 0;
+  int64_t batch_count = 1;
+  while (iree_benchmark_keep_running(benchmark_state, batch_count)) {
+    for (int i = 0; i < batch_count; ++i) {
+      iree_uk_normalize_p(&params);
+    }
+    total_iterations += batch_count;
+    batch_count *= 2;
+  }
+  // Report bytes per second, so that can be easily compared to known memory
+  // system performance metrics (e.g. RAM bandwidth, to tell whether this is
+  // memory-bound).
+  iree_benchmark_set_bytes_processed(benchmark_state,
+                                     total_iterations * 2 * buffer_size);
+  free(beta_buffer);
+  free(gamma_buffer);
+  free(out_buffer);
+  free(in_buffer);
+  return iree_ok_status();
+}
+
+static void iree_uk_benchmark_register_normalize(iree_uk_uint32_t flags,
+                                                 const char* cpu_features) {
+  char type_str[32];
+  iree_uk_type_pair_str(type_str, sizeof type_str,
+                        iree_uk_normalize_type(flags));
+  typedef struct normalize_variant_t {
+    const char* label;
+    iree_uk_normalize_op_t op;
+  } normalize_variant_t;
+  const normalize_variant_t variants[] = {
+      {"softmax", iree_uk_normalize_op_softmax},
+      {"layernorm", iree_uk_normalize_op_layernorm},
+      {"rmsnorm", iree_uk_normalize_op_rmsnorm},
+  };
+  for (int i = 0; i < IREE_ARRAYSIZE(variants); ++i) {
+    for (int fast = 0; fast <= 1; ++fast) {
+      normalize_variant_t variant = variants[i];
+      char name[128];
+      snprintf(name, sizeof name, "%s_%s%s_row_%d_wss_%" PRIi64,
+               variant.label, type_str, fast ? "_fast" : "", FLAG_row_size,
+               FLAG_working_set_size);
+      iree_uk_normalize_params_t params = {
+          .op = variant.op,
+          .flags = flags | (fast ? IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS
+                                 : 0)};
+      iree_uk_benchmark_register(name, iree_uk_benchmark_normalize, &params,
+                                 sizeof params, cpu_features);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  iree_flags_set_usage("normalize_benchmark", "");
+
+  iree_flags_parse_checked(IREE_FLAGS_PARSE_MODE_UNDEFINED_OK, &argc, &argv);
+  iree_uk_benchmark_initialize(&argc, argv);
+
+  // The memcpy benchmark provides a useful comparison point: with the fast
+  // approximations, these ops should get reasonably close to memory-bound.
+  iree_uk_benchmark_register_memcpy(FLAG_working_set_size);
+
+#if defined(IREE_ARCH_ARM_64)
+  iree_uk_benchmark_register_normalize(IREE_UK_FLAG_NORMALIZE_TYPE_F32F32, "");
+  iree_uk_benchmark_register_normalize(IREE_UK_FLAG_NORMALIZE_TYPE_F16F16, "");
+  iree_uk_benchmark_register_normalize(IREE_UK_FLAG_NORMALIZE_TYPE_BF16BF16,
+                                       "");
+#elif defined(IREE_ARCH_X86_64)
+  iree_uk_benchmark_register_normalize(IREE_UK_FLAG_NORMALIZE_TYPE_F32F32,
+                                       "avx2_fma");
+  iree_uk_benchmark_register_normalize(IREE_UK_FLAG_NORMALIZE_TYPE_F16F16,
+                                       "avx2_fma");
+  iree_uk_benchmark_register_normalize(IREE_UK_FLAG_NORMALIZE_TYPE_BF16BF16,
+                                       "avx2_fma");
+  iree_uk_benchmark_register_normalize(IREE_UK_FLAG_NORMALIZE_TYPE_F32F32,
+                                       "avx512_base");
+  iree_uk_benchmark_register_normalize(IREE_UK_FLAG_NORMALIZE_TYPE_F16F16,
+                                       "avx512_base");
+  iree_uk_benchmark_register_normalize(IREE_UK_FLAG_NORMALIZE_TYPE_BF16BF16,
+                                       "avx512_base");
+#elif defined(IREE_ARCH_RISCV_64)
+  iree_uk_benchmark_register_normalize(IREE_UK_FLAG_NORMALIZE_TYPE_F32F32,
+                                       "v");
+#else   // defined(IREE_ARCH_ARM_64)
+  // Architectures on which we do not have any optimized ukernel code.
+  iree_uk_benchmark_register_normalize(IREE_UK_FLAG_NORMALIZE_TYPE_F32F32, "");
+#endif  // defined(IREE_ARCH_ARM_64)
+
+  iree_uk_benchmark_run_and_cleanup();
+}
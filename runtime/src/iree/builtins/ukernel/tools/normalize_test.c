@@ -0,0 +1,285 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <math.h>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/math.h"
+#include "iree/builtins/ukernel/api.h"
+#include "iree/builtins/ukernel/normalize_internal.h"
+#include "iree/builtins/ukernel/tools/test.h"
+#include "iree/builtins/ukernel/tools/util.h"
+
+static float iree_normalize_load(const void* buf, iree_uk_index_t i,
+                                 iree_uk_type_t type) {
+  switch (type) {
+    case IREE_UK_TYPE_FLOAT_16:
+      return iree_math_f16_to_f32(((const uint16_t*)buf)[i]);
+    case IREE_UK_TYPE_BFLOAT_16:
+      return iree_math_bf16_to_f32(((const uint16_t*)buf)[i]);
+    default:
+      return ((const float*)buf)[i];
+  }
+}
+
+static void iree_normalize_store(void* buf, iree_uk_index_t i, float value,
+                                 iree_uk_type_t type) {
+  switch (type) {
+    case IREE_UK_TYPE_FLOAT_16:
+      ((uint16_t*)buf)[i] = iree_math_f32_to_f16(value);
+      break;
+    case IREE_UK_TYPE_BFLOAT_16:
+      ((uint16_t*)buf)[i] = iree_math_f32_to_bf16(value);
+      break;
+    default:
+      ((float*)buf)[i] = value;
+      break;
+  }
+}
+
+// Reference implementation, accumulating in double and using libm so that it
+// is independent of the approximations used by the ukernel. Results are
+// returned as f32 in `out` (shape [size0, size1], contiguous) so that the
+// comparison can apply a tolerance before rounding to the output type.
+static void iree_normalize_reference(const iree_uk_normalize_params_t* params,
+                                     const void* in, const void* gamma,
+                                     const void* beta, float* out) {
+  iree_uk_type_t type =
+      iree_uk_normalize_in_type(iree_uk_normalize_type(params->flags));
+  iree_uk_index_t size1 = params->size1;
+  for (iree_uk_index_t i = 0; i < params->size0; ++i) {
+    const char* in_row = (const char*)in + i * params->in_stride0 *
+                                               iree_uk_type_size(type);
+    float* out_row = out + i * size1;
+    if (params->op == iree_uk_normalize_op_softmax) {
+      double max = -INFINITY;
+      for (iree_uk_index_t j = 0; j < size1; ++j) {
+        max = fmax(max, iree_normalize_load(in_row, j, type));
+      }
+      double sum = 0;
+      for (iree_uk_index_t j = 0; j < size1; ++j) {
+        sum += exp(iree_normalize_load(in_row, j, type) - max);
+      }
+      for (iree_uk_index_t j = 0; j < size1; ++j) {
+        out_row[j] = exp(iree_normalize_load(in_row, j, type) - max) / sum;
+      }
+      continue;
+    }
+    double mean = 0;
+    if (params->op == iree_uk_normalize_op_layernorm) {
+      for (iree_uk_index_t j = 0; j < size1; ++j) {
+        mean += iree_normalize_load(in_row, j, type);
+      }
+      mean /= size1;
+    }
+    double var = 0;
+    for (iree_uk_index_t j = 0; j < size1; ++j) {
+      double d = iree_normalize_load(in_row, j, type) - mean;
+      var += d * d;
+    }
+    var /= size1;
+    double rstd = 1. / sqrt(var + params->epsilon);
+    for (iree_uk_index_t j = 0; j < size1; ++j) {
+      double y = (iree_normalize_load(in_row, j, type) - mean) * rstd *
+                 iree_normalize_load(gamma, j, type);
+      if (params->op == iree_uk_normalize_op_layernorm) {
+        y += iree_normalize_load(beta, j, type);
+      }
+      out_row[j] = y;
+    }
+  }
+}
+
+// Returns the tolerance, relative to max(1, |expected|), to use when comparing
+// results. This accounts for rounding of the output to 16-bit types and for
+// the lower accuracy of the fast approximations.
+static float iree_normalize_tolerance(iree_uk_uint32_t flags) {
+  float tolerance = (flags & IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS)
+                        ? 5e-4f
+                        : 2e-5f;
+  switch (iree_uk_normalize_in_type(iree_uk_normalize_type(flags))) {
+    case IREE_UK_TYPE_FLOAT_16:
+      return tolerance + 2e-3f;
+    case IREE_UK_TYPE_BFLOAT_16:
+      return tolerance + 1.6e-2f;
+    default:
+      return tolerance;
+  }
+}
+
+static void iree_uk_test_normalize_for_shape_params(
+    iree_uk_test_t* test, const iree_uk_normalize_params_t* src_params,
+    bool in_place) {
+  iree_uk_normalize_params_t params;
+  memcpy(&params, src_params, sizeof params);
+  iree_uk_random_engine_t* engine = iree_uk_test_random_engine(test);
+  iree_uk_type_t type =
+      iree_uk_normalize_in_type(iree_uk_normalize_type(params.flags));
+  iree_uk_index_t elem_size = iree_uk_type_size(type);
+  // Randomly make strides either tight or not to exercise all cases.
+  params.in_stride0 = params.size1 + iree_uk_random_engine_get_0_1(engine);
+  params.out_stride0 =
+      in_place ? params.in_stride0
+               : params.size1 + iree_uk_random_engine_get_0_1(engine);
+
+  iree_uk_index_t in_buffer_size =
+      iree_uk_2d_buffer_length(type, params.size0, params.in_stride0);
+  iree_uk_index_t out_buffer_size =
+      iree_uk_2d_buffer_length(type, params.size0, params.out_stride0);
+  iree_uk_index_t vec_buffer_size = params.size1 * elem_size;
+  void* in_buffer = malloc(in_buffer_size);
+  void* out_buffer = in_place ? in_buffer : malloc(out_buffer_size);
+  void* gamma_buffer = malloc(vec_buffer_size);
+  void* beta_buffer = malloc(vec_buffer_size);
+  float* reference_out = malloc(params.size0 * params.size1 * sizeof(float));
+
+  // Use a wider value range than iree_uk_write_random_buffer: softmax inputs
+  // should span many binades of exp(), and a non-zero mean exercises the
+  // mean subtraction of layernorm.
+  float bias = (iree_uk_random_engine_get_0_65535(engine) % 17) - 8.f;
+  for (iree_uk_index_t i = 0; i < in_buffer_size / elem_size; ++i) {
+    float x = iree_uk_random_engine_get_0_65535(engine) / 4096.f - 8.f + bias;
+    iree_normalize_store(in_buffer, i, x, type);
+  }
+  for (iree_uk_index_t i = 0; i < params.size1; ++i) {
+    float g = iree_uk_random_engine_get_0_65535(engine) / 32768.f;
+    float b = iree_uk_random_engine_get_0_65535(engine) / 32768.f - 1.f;
+    iree_normalize_store(gamma_buffer, i, g, type);
+    iree_normalize_store(beta_buffer, i, b, type);
+  }
+  if (!in_place) {
+    iree_uk_write_random_buffer(out_buffer, out_buffer_size, type, engine);
+  }
+
+  iree_normalize_reference(&params, in_buffer, gamma_buffer, beta_buffer,
+                           reference_out);
+
+  params.in_offset = iree_uk_random_engine_get_0_65535(engine);
+  params.out_offset = in_place ? params.in_offset
+                               : iree_uk_random_engine_get_0_65535(engine);
+  params.gamma_offset = iree_uk_random_engine_get_0_65535(engine);
+  params.beta_offset = iree_uk_random_engine_get_0_65535(engine);
+  params.in_buffer = (const char*)in_buffer - params.in_offset * elem_size;
+  params.out_buffer = (char*)out_buffer - params.out_offset * elem_size;
+  params.gamma_buffer =
+      (const char*)gamma_buffer - params.gamma_offset * elem_size;
+  params.beta_buffer =
+      params.op == iree_uk_normalize_op_layernorm
+          ? (const char*)beta_buffer - params.beta_offset * elem_size
+          : NULL;
+  if (params.op == iree_uk_normalize_op_softmax) {
+    params.gamma_buffer = NULL;
+  }
+  iree_uk_normalize_p(&params);
+
+  float tolerance = iree_normalize_tolerance(params.flags);
+  for (iree_uk_index_t i = 0; i < params.size0; ++i) {
+    const char* out_row =
+        (const char*)out_buffer + i * params.out_stride0 * elem_size;
+    for (iree_uk_index_t j = 0; j < params.size1; ++j) {
+      float expected = reference_out[i * params.size1 + j];
+      float actual = iree_normalize_load(out_row, j, type);
+      if (!(fabsf(actual - expected) <=
+            tolerance * fmaxf(1.f, fabsf(expected)))) {
+        fprintf(stderr, "row %d col %d: expected %g, actual %g\n", (int)i,
+                (int)j, expected, actual);
+        IREE_UK_TEST_FAIL(test);
+        goto done;
+      }
+    }
+  }
+
+done:
+  free(reference_out);
+  free(beta_buffer);
+  free(gamma_buffer);
+  if (!in_place) free(out_buffer);
+  free(in_buffer);
+}
+
+static void iree_uk_test_normalize_for_op_params(iree_uk_test_t* test,
+                                                 const void* src_params) {
+  typedef struct shape_t {
+    int size0, size1;
+  } shape_t;
+  const shape_t shapes[] = {
+      // Degenerate cases. Vacuous.
+      {0, 1},
+      {1, 0},
+      // Non-degenerate cases, covering rows shorter than one vector, partial
+      // vectors and rows spanning several unrolled iterations.
+      {1, 1},
+      {3, 7},
+      {2, 16},
+      {5, 33},
+      {4, 100},
+      {2, 1025},
+  };
+  for (int i = 0; i < IREE_ARRAYSIZE(shapes); ++i) {
+    for (int in_place = 0; in_place <= 1; ++in_place) {
+      iree_uk_normalize_params_t params;
+      memcpy(&params, src_params, sizeof params);
+      params.cpu_data = iree_uk_test_cpu_data(test);
+      params.size0 = shapes[i].size0;
+      params.size1 = shapes[i].size1;
+      iree_uk_test_normalize_for_shape_params(test, &params, in_place);
+    }
+  }
+}
+
+static void iree_uk_test_normalize(iree_uk_normalize_op_t op,
+                                   iree_uk_uint32_t flags,
+                                   const char* cpu_features) {
+  static const char* op_names[] = {"softmax", "layernorm", "rmsnorm"};
+  for (int fast = 0; fast <= 1; ++fast) {
+    iree_uk_normalize_params_t params = {
+        .op = op,
+        .epsilon = 1e-5f,
+        .flags = flags | (fast ? IREE_UK_FLAG_NORMALIZE_FAST_APPROXIMATIONS
+                               : 0)};
+    char types_str[32];
+    iree_uk_type_pair_str(types_str, sizeof types_str,
+                          iree_uk_normalize_type(flags));
+    char test_label_str[256];
+    snprintf(test_label_str, sizeof test_label_str, "op:%s types:%s%s",
+             op_names[op], types_str, fast ? " fast" : "");
+    iree_uk_test(test_label_str, iree_uk_test_normalize_for_op_params, &params,
+                 cpu_features);
+  }
+}
+
+static void iree_uk_test_normalize_all_ops(iree_uk_uint32_t flags,
+                                           const char* cpu_features) {
+  iree_uk_test_normalize(iree_uk_normalize_op_softmax, flags, cpu_features);
+  iree_uk_test_normalize(iree_uk_normalize_op_layernorm, flags, cpu_features);
+  iree_uk_test_normalize(iree_uk_normalize_op_rmsnorm, flags, cpu_features);
+}
+
+int main(int argc, char** argv) {
+  // Generic tests, not matching any particular CPU feature.
+  iree_uk_test_normalize_all_ops(IREE_UK_FLAG_NORMALIZE_TYPE_F32F32, "");
+  iree_uk_test_normalize_all_ops(IREE_UK_FLAG_NORMALIZE_TYPE_F16F16, "");
+  iree_uk_test_normalize_all_ops(IREE_UK_FLAG_NORMALIZE_TYPE_BF16BF16, "");
+
+#if defined(IREE_ARCH_X86_64)
+  iree_uk_test_normalize_all_ops(IREE_UK_FLAG_NORMALIZE_TYPE_F32F32,
+                                 "avx2_fma");
+  iree_uk_test_normalize_all_ops(IREE_UK_FLAG_NORMALIZE_TYPE_F16F16,
+                                 "avx2_fma");
+  iree_uk_test_normalize_all_ops(IREE_UK_FLAG_NORMALIZE_TYPE_BF16BF16,
+                                 "avx2_fma");
+  iree_uk_test_normalize_all_ops(IREE_UK_FLAG_NORMALIZE_TYPE_F32F32,
+                                 "avx512_base");
+  iree_uk_test_normalize_all_ops(IREE_UK_FLAG_NORMALIZE_TYPE_F16F16,
+                                 "avx512_base");
+  iree_uk_test_normalize_all_ops(IREE_UK_FLAG_NORMALIZE_TYPE_BF16BF16,
+                                 "avx512_base");
+#elif defined(IREE_ARCH_RISCV_64)
+  iree_uk_test_normalize_all_ops(IREE_UK_FLAG_NORMALIZE_TYPE_F32F32, "v");
+#endif  // defined(IREE_ARCH_X86_64)
+
+  return iree_uk_test_exit_status();
+}
@@ -73,7 +73,11 @@ static iree_status_t iree_uk_benchmark_pack(
   iree_uk_index_t out_buffer_size =
       iree_uk_2d_buffer_length(out_type, params.out_size0, params.out_stride0);
   void* in_buffer = malloc(in_buffer_size);
-  void* out_buffer = malloc(out_buffer_size);
+  // Cache-line-align the destination like real allocations would, as tile
+  // functions using non-temporal stores are only selected on aligned outputs.
+  void* out_buffer = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc_aligned(
+      iree_allocator_system(), out_buffer_size, 64, 0, &out_buffer));
   iree_uk_random_engine_t* engine = iree_uk_benchmark_random_engine(user_data);
   // It's just about plausible that on some platform, for some number type,
   // performance might be different on zero buffers vs random buffers. But it
@@ -100,7 +104,7 @@ static iree_status_t iree_uk_benchmark_pack(
   iree_benchmark_set_bytes_processed(benchmark_state,
                                      total_iterations * out_buffer_size);
   free(in_buffer);
-  free(out_buffer);
+  iree_allocator_free_aligned(iree_allocator_system(), out_buffer);
   return iree_ok_status();
 }
 
@@ -170,6 +174,14 @@ int main(int argc, char** argv) {
                                   "avx2_fma");
   iree_uk_benchmark_register_pack(IREE_UK_FLAG_PACK_TYPE_I32I32, 16, 16,
                                   "avx512_base");
+  iree_uk_benchmark_register_pack(IREE_UK_FLAG_PACK_TYPE_F16F16, 8, 1,
+                                  "avx2_fma");
+  iree_uk_benchmark_register_pack(IREE_UK_FLAG_PACK_TYPE_F16F16, 8, 8,
+                                  "avx2_fma");
+  iree_uk_benchmark_register_pack(IREE_UK_FLAG_PACK_TYPE_F16F16, 16, 1,
+                                  "avx512_base");
+  iree_uk_benchmark_register_pack(IREE_UK_FLAG_PACK_TYPE_F16F16, 16, 16,
+                                  "avx512_base");
 #else   // defined(IREE_ARCH_ARM_64)
   // Architectures on which we do not have any optimized ukernel code.
   // Benchmark some arbitrary tile shape.
@@ -108,7 +108,12 @@ static void iree_uk_test_pack_for_shape_params(
 
   iree_uk_pack_params_t actual_params;
   memcpy(&actual_params, &params, sizeof actual_params);
-  void* actual_out_buffer = malloc(out_buffer_size);
+  // Randomly make the output buffer cache-line-aligned or not, as some tile
+  // functions, e.g. using non-temporal stores, are only selected if aligned.
+  char* actual_out_alloc = malloc(out_buffer_size + 128);
+  char* actual_out_buffer =
+      actual_out_alloc + 64 - ((uintptr_t)actual_out_alloc % 64) +
+      iree_uk_random_engine_get_0_1(engine) * iree_uk_type_size(out_type);
   iree_uk_write_random_buffer(actual_out_buffer, out_buffer_size, out_type,
                               engine);
   actual_params.out_buffer = (char*)actual_out_buffer -
@@ -125,7 +130,7 @@ static void iree_uk_test_pack_for_shape_params(
   }
 
   free(reference_out_buffer);
-  free(actual_out_buffer);
+  free(actual_out_alloc);
   free(in_buffer);
 }
 
@@ -142,6 +147,9 @@ static void iree_uk_test_pack_for_tile_params(iree_uk_test_t* test,
       {1, 1},
       {3, 2},
       {9, 33},
+      // Large enough for the destination to exceed the threshold for
+      // non-temporal stores, with common tile sizes.
+      {48, 48},
   };
   typedef enum {
     pad_none,
@@ -239,6 +247,12 @@ int main(int argc, char** argv) {
   iree_uk_test_pack(IREE_UK_FLAG_PACK_TYPE_I8I8, 16, 2, "avx512_base");
   iree_uk_test_pack(IREE_UK_FLAG_PACK_TYPE_F32F32, 16, 16, "avx512_base");
   iree_uk_test_pack(IREE_UK_FLAG_PACK_TYPE_I32I32, 16, 16, "avx512_base");
+  // 16-bit element types, e.g. f16 matmul operands and accumulators.
+  iree_uk_test_pack(IREE_UK_FLAG_PACK_TYPE_F16F16, 8, 1, "avx2_fma");
+  iree_uk_test_pack(IREE_UK_FLAG_PACK_TYPE_F16F16, 8, 8, "avx2_fma");
+  iree_uk_test_pack(IREE_UK_FLAG_PACK_TYPE_F16F16, 16, 1, "avx512_base");
+  iree_uk_test_pack(IREE_UK_FLAG_PACK_TYPE_F16F16, 16, 16, "avx512_base");
+  iree_uk_test_pack(IREE_UK_FLAG_PACK_TYPE_BF16BF16, 16, 16, "avx512_base");
   // avx512_vnni uses the same tile size and same pack code as avx512_base.
 #endif  // defined(IREE_ARCH_ARM_64)
 
@@ -156,6 +156,10 @@ int main(int argc, char** argv) {
                                     "avx512_base");
   iree_uk_benchmark_register_unpack(IREE_UK_FLAG_UNPACK_TYPE_I32I32, 16, 16,
                                     "avx512_base");
+  iree_uk_benchmark_register_unpack(IREE_UK_FLAG_UNPACK_TYPE_F16F16, 8, 8,
+                                    "avx2_fma");
+  iree_uk_benchmark_register_unpack(IREE_UK_FLAG_UNPACK_TYPE_F16F16, 16, 16,
+                                    "avx512_base");
 #else   // defined(IREE_ARCH_ARM_64)
   // Architectures on which we do not have any optimized ukernel code.
   // Benchmark some arbitrary tile shape.
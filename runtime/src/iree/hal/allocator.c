@@ -67,6 +67,18 @@ IREE_API_EXPORT iree_status_t iree_hal_allocator_statistics_format(
       statistics->device_bytes_freed,
       (statistics->device_bytes_allocated - statistics->device_bytes_freed)));
 
+  if (statistics->host_bytes_large_page_explicit ||
+      statistics->host_bytes_large_page_transparent ||
+      statistics->host_bytes_large_page_fallback) {
+    IREE_RETURN_IF_ERROR(iree_string_builder_append_format(
+        builder,
+        "  LARGE_PAGE: %12" PRIdsz "B explicit / %12" PRIdsz
+        "B transparent / %12" PRIdsz "B fallback\n",
+        statistics->host_bytes_large_page_explicit,
+        statistics->host_bytes_large_page_transparent,
+        statistics->host_bytes_large_page_fallback));
+  }
+
 #else
   // No-op when disabled.
 #endif  // IREE_STATISTICS_ENABLE
@@ -11,6 +11,7 @@
 #include <stdint.h>
 
 #include "iree/base/api.h"
+#include "iree/base/internal/memory.h"
 #include "iree/hal/buffer.h"
 #include "iree/hal/queue.h"
 #include "iree/hal/resource.h"
@@ -319,6 +320,12 @@ typedef struct iree_hal_allocator_statistics_t {
   iree_device_size_t device_bytes_peak;
   iree_device_size_t device_bytes_allocated;
   iree_device_size_t device_bytes_freed;
+  // Bytes of live host allocations mapped with explicit huge pages, advised
+  // for transparent huge pages, or that requested large pages but fell back to
+  // normal pages. See iree_memory_large_page_statistics_t.
+  iree_device_size_t host_bytes_large_page_explicit;
+  iree_device_size_t host_bytes_large_page_transparent;
+  iree_device_size_t host_bytes_large_page_fallback;
   // TODO(benvanik): mapping information (discarded, mapping ranges,
   //                 flushed/invalidated, etc).
 #else
@@ -652,6 +659,52 @@ IREE_API_EXPORT iree_status_t iree_hal_allocator_create_heap(
     iree_string_view_t identifier, iree_allocator_t data_allocator,
     iree_allocator_t host_allocator, iree_hal_allocator_t** out_allocator);
 
+// Options controlling iree_hal_heap_allocator_t behavior.
+typedef struct iree_hal_heap_allocator_options_t {
+  // Number of valid entries in |queue_node_ids|.
+  iree_host_size_t queue_node_count;
+  // NUMA node that each queue ordinal (bit in iree_hal_queue_affinity_t)
+  // executes on or IREE_ALLOCATOR_NODE_ID_ANY if unknown. Buffers whose queue
+  // affinity maps to a single node are bound to that node via
+  // iree_allocator_bind so that dispatches on the queue access local memory.
+  // Buffers usable from queues on multiple nodes are left to first-touch.
+  iree_allocator_node_id_t queue_node_ids[IREE_HAL_MAX_QUEUES];
+  // Large page backing of buffer storage. Large multi-MB buffers such as
+  // activations and caches may otherwise spend a significant amount of time
+  // in TLB misses. Ignored on platforms without large page support.
+  iree_memory_large_page_mode_t large_page_mode;
+  // Minimum size of buffers backed with large pages or 0 to use the system
+  // large page size. Smaller buffers are allocated from the data allocator.
+  iree_host_size_t large_page_min_size;
+} iree_hal_heap_allocator_options_t;
+
+// Initializes |out_options| to the defaults (no NUMA placement or large pages).
+IREE_API_EXPORT void iree_hal_heap_allocator_options_initialize(
+    iree_hal_heap_allocator_options_t* out_options);
+
+// Creates a host-local heap allocator as with iree_hal_allocator_create_heap
+// using the provided |options|.
+IREE_API_EXPORT iree_status_t iree_hal_allocator_create_heap_with_options(
+    iree_string_view_t identifier,
+    const iree_hal_heap_allocator_options_t* options,
+    iree_allocator_t data_allocator, iree_allocator_t host_allocator,
+    iree_hal_allocator_t** out_allocator);
+
+// Creates a heap allocator with the configuration of |heap_allocator| and
+// options overridden by |config_pairs|. |heap_allocator| must be a heap
+// allocator and no buffers may have been allocated from it yet.
+//
+// Supported config pairs:
+//   large_pages=none|transparent|explicit
+//   large_page_min_size=<size>  (such as `2mib`)
+//
+// Examples:
+//   large_pages=transparent
+//   large_pages=explicit,large_page_min_size=4mib
+IREE_API_EXPORT iree_status_t iree_hal_heap_allocator_create_from_spec(
+    iree_string_view_t config_pairs, iree_hal_allocator_t* heap_allocator,
+    iree_allocator_t host_allocator, iree_hal_allocator_t** out_allocator);
+
 //===----------------------------------------------------------------------===//
 // iree_hal_allocator_t implementation details
 //===----------------------------------------------------------------------===//
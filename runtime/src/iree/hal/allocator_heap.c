@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
 #include <stddef.h>
+#include <string.h>
 
 #include "iree/base/api.h"
 #include "iree/hal/allocator.h"
@@ -17,6 +18,10 @@ typedef struct iree_hal_heap_allocator_t {
   iree_allocator_t host_allocator;
   iree_allocator_t data_allocator;
   iree_string_view_t identifier;
+  iree_hal_heap_allocator_options_t options;
+  // Allocator used for buffer storage when large pages are enabled. Wraps
+  // |data_allocator| which is still used for smaller buffers.
+  iree_memory_large_page_allocator_t large_page_allocator;
   IREE_STATISTICS(iree_hal_heap_allocator_statistics_t statistics;)
 } iree_hal_heap_allocator_t;
 
@@ -27,9 +32,27 @@ iree_hal_heap_allocator_t* iree_hal_heap_allocator_cast(
   return (iree_hal_heap_allocator_t*)base_value;
 }
 
+IREE_API_EXPORT void iree_hal_heap_allocator_options_initialize(
+    iree_hal_heap_allocator_options_t* out_options) {
+  IREE_ASSERT_ARGUMENT(out_options);
+  memset(out_options, 0, sizeof(*out_options));
+}
+
 IREE_API_EXPORT iree_status_t iree_hal_allocator_create_heap(
     iree_string_view_t identifier, iree_allocator_t data_allocator,
     iree_allocator_t host_allocator, iree_hal_allocator_t** out_allocator) {
+  iree_hal_heap_allocator_options_t options;
+  iree_hal_heap_allocator_options_initialize(&options);
+  return iree_hal_allocator_create_heap_with_options(
+      identifier, &options, data_allocator, host_allocator, out_allocator);
+}
+
+IREE_API_EXPORT iree_status_t iree_hal_allocator_create_heap_with_options(
+    iree_string_view_t identifier,
+    const iree_hal_heap_allocator_options_t* options,
+    iree_allocator_t data_allocator, iree_allocator_t host_allocator,
+    iree_hal_allocator_t** out_allocator) {
+  IREE_ASSERT_ARGUMENT(options);
   IREE_ASSERT_ARGUMENT(out_allocator);
   *out_allocator = NULL;
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -44,6 +67,12 @@ IREE_API_EXPORT iree_status_t iree_hal_allocator_create_heap(
                                  &allocator->resource);
     allocator->host_allocator = host_allocator;
     allocator->data_allocator = data_allocator;
+    memcpy(&allocator->options, options, sizeof(allocator->options));
+    allocator->options.queue_node_count =
+        iree_min(options->queue_node_count, IREE_HAL_MAX_QUEUES);
+    iree_memory_large_page_allocator_initialize(
+        options->large_page_mode, options->large_page_min_size, data_allocator,
+        &allocator->large_page_allocator);
     iree_string_view_append_to_buffer(
         identifier, &allocator->identifier,
         (char*)allocator + iree_sizeof_struct(*allocator));
@@ -60,6 +89,52 @@ IREE_API_EXPORT iree_status_t iree_hal_allocator_create_heap(
   return status;
 }
 
+IREE_API_EXPORT iree_status_t iree_hal_heap_allocator_create_from_spec(
+    iree_string_view_t config_pairs, iree_hal_allocator_t* heap_allocator,
+    iree_allocator_t host_allocator, iree_hal_allocator_t** out_allocator) {
+  IREE_ASSERT_ARGUMENT(heap_allocator);
+  IREE_ASSERT_ARGUMENT(out_allocator);
+  *out_allocator = NULL;
+  if (!iree_hal_resource_is(heap_allocator, &iree_hal_heap_allocator_vtable)) {
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "heap allocator options can only be applied to heap allocators");
+  }
+  iree_hal_heap_allocator_t* base_allocator =
+      iree_hal_heap_allocator_cast(heap_allocator);
+
+  // Start with the existing configuration (such as NUMA placement) and
+  // override only what the user specified.
+  iree_hal_heap_allocator_options_t options = base_allocator->options;
+  while (!iree_string_view_is_empty(config_pairs)) {
+    iree_string_view_t config_pair = iree_string_view_empty();
+    iree_string_view_split(config_pairs, ',', &config_pair, &config_pairs);
+    iree_string_view_t key = iree_string_view_empty();
+    iree_string_view_t value = iree_string_view_empty();
+    iree_string_view_split(config_pair, '=', &key, &value);
+    key = iree_string_view_trim(key);
+    value = iree_string_view_trim(value);
+    if (iree_string_view_equal(key, IREE_SV("large_pages"))) {
+      IREE_RETURN_IF_ERROR(
+          iree_memory_large_page_mode_parse(value, &options.large_page_mode));
+    } else if (iree_string_view_equal(key, IREE_SV("large_page_min_size"))) {
+      iree_device_size_t large_page_min_size = 0;
+      IREE_RETURN_IF_ERROR(
+          iree_string_view_parse_device_size(value, &large_page_min_size),
+          "parsing large_page_min_size");
+      options.large_page_min_size = (iree_host_size_t)large_page_min_size;
+    } else {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "unrecognized heap allocator option '%.*s'",
+                              (int)key.size, key.data);
+    }
+  }
+
+  return iree_hal_allocator_create_heap_with_options(
+      base_allocator->identifier, &options, base_allocator->data_allocator,
+      host_allocator, out_allocator);
+}
+
 static void iree_hal_heap_allocator_destroy(
     iree_hal_allocator_t* IREE_RESTRICT base_allocator) {
   iree_hal_heap_allocator_t* allocator =
@@ -68,6 +143,8 @@ static void iree_hal_heap_allocator_destroy(
   IREE_TRACE_ZONE_BEGIN(z0);
 
   IREE_STATISTICS(iree_slim_mutex_deinitialize(&allocator->statistics.mutex));
+  iree_memory_large_page_allocator_deinitialize(
+      &allocator->large_page_allocator);
 
   iree_allocator_free(host_allocator, allocator);
 
@@ -96,6 +173,15 @@ static void iree_hal_heap_allocator_query_statistics(
     memcpy(out_statistics, &allocator->statistics.base,
            sizeof(*out_statistics));
     iree_slim_mutex_unlock(&allocator->statistics.mutex);
+    iree_memory_large_page_statistics_t large_page_statistics;
+    iree_memory_large_page_allocator_query_statistics(
+        &allocator->large_page_allocator, &large_page_statistics);
+    out_statistics->host_bytes_large_page_explicit =
+        large_page_statistics.explicit_bytes;
+    out_statistics->host_bytes_large_page_transparent =
+        large_page_statistics.transparent_bytes;
+    out_statistics->host_bytes_large_page_fallback =
+        large_page_statistics.fallback_bytes;
   });
 }
 
@@ -175,6 +261,27 @@ iree_hal_heap_allocator_query_buffer_compatibility(
   return compatibility;
 }
 
+// Returns the NUMA node buffers used on |queue_affinity| should be placed on or
+// IREE_ALLOCATOR_NODE_ID_ANY if the queues span nodes or have no known node.
+static iree_allocator_node_id_t iree_hal_heap_allocator_select_node(
+    const iree_hal_heap_allocator_t* allocator,
+    iree_hal_queue_affinity_t queue_affinity) {
+  iree_allocator_node_id_t node_id = IREE_ALLOCATOR_NODE_ID_ANY;
+  bool any_queue = false;
+  for (iree_host_size_t i = 0; i < allocator->options.queue_node_count; ++i) {
+    if (!(queue_affinity & (1ull << i))) continue;
+    const iree_allocator_node_id_t queue_node_id =
+        allocator->options.queue_node_ids[i];
+    if (!any_queue) {
+      node_id = queue_node_id;
+      any_queue = true;
+    } else if (queue_node_id != node_id) {
+      return IREE_ALLOCATOR_NODE_ID_ANY;
+    }
+  }
+  return node_id;
+}
+
 static iree_status_t iree_hal_heap_allocator_allocate_buffer(
     iree_hal_allocator_t* IREE_RESTRICT base_allocator,
     const iree_hal_buffer_params_t* IREE_RESTRICT params,
@@ -197,9 +304,24 @@ static iree_status_t iree_hal_heap_allocator_allocate_buffer(
   iree_hal_heap_allocator_statistics_t* statistics = NULL;
   IREE_STATISTICS(statistics = &allocator->statistics);
   iree_hal_buffer_t* buffer = NULL;
+  const iree_allocator_node_id_t node_id = iree_hal_heap_allocator_select_node(
+      allocator, compat_params.queue_affinity ? compat_params.queue_affinity
+                                              : IREE_HAL_QUEUE_AFFINITY_ANY);
+  // Buffers large enough to benefit are mapped with large pages, if enabled.
+  // Mappings are page aligned and padding them for alignment would spill the
+  // buffer into another (large) page.
+  iree_allocator_t data_allocator = allocator->data_allocator;
+  iree_host_size_t data_alignment = 0;
+  if (allocator->large_page_allocator.mode !=
+          IREE_MEMORY_LARGE_PAGE_MODE_NONE &&
+      allocation_size >= allocator->large_page_allocator.min_allocation_size) {
+    data_allocator =
+        iree_memory_large_page_allocator(&allocator->large_page_allocator);
+    data_alignment = allocator->large_page_allocator.normal_page_size;
+  }
   IREE_RETURN_IF_ERROR(iree_hal_heap_buffer_create(
-      statistics, &compat_params, allocation_size, allocator->data_allocator,
-      allocator->host_allocator, &buffer));
+      statistics, &compat_params, allocation_size, node_id, data_allocator,
+      data_alignment, allocator->host_allocator, &buffer));
 
   *out_buffer = buffer;
   return iree_ok_status();
@@ -0,0 +1,83 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <cstring>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/memory.h"
+#include "iree/hal/api.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace {
+
+// Returns the total bytes mapped for large page buffers of |allocator|.
+static iree_device_size_t QueryLargePageBytes(iree_hal_allocator_t* allocator) {
+  iree_hal_allocator_statistics_t statistics;
+  memset(&statistics, 0, sizeof(statistics));
+  iree_hal_allocator_query_statistics(allocator, &statistics);
+#if IREE_STATISTICS_ENABLE
+  return statistics.host_bytes_large_page_explicit +
+         statistics.host_bytes_large_page_transparent +
+         statistics.host_bytes_large_page_fallback;
+#else
+  return 0;
+#endif  // IREE_STATISTICS_ENABLE
+}
+
+// Tests that large page buffers map exactly their size rounded up to the large
+// page size and that their storage starts on a large page boundary.
+TEST(HeapAllocatorTest, LargePageBuffersAreNotPadded) {
+  const iree_host_size_t large_page_size =
+      iree_memory_query_info().large_page_granularity;
+  iree_hal_heap_allocator_options_t options;
+  iree_hal_heap_allocator_options_initialize(&options);
+  options.large_page_mode = IREE_MEMORY_LARGE_PAGE_MODE_TRANSPARENT;
+  options.large_page_min_size = large_page_size;
+  iree_hal_allocator_t* allocator = NULL;
+  IREE_ASSERT_OK(iree_hal_allocator_create_heap_with_options(
+      IREE_SV("heap"), &options, iree_allocator_system(),
+      iree_allocator_system(), &allocator));
+
+  iree_hal_buffer_params_t params = {0};
+  params.type =
+      IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL | IREE_HAL_MEMORY_TYPE_HOST_VISIBLE;
+  params.usage =
+      IREE_HAL_BUFFER_USAGE_DEFAULT | IREE_HAL_BUFFER_USAGE_MAPPING_SCOPED;
+  const iree_device_size_t allocation_sizes[] = {
+      4 * large_page_size,
+      4 * large_page_size - 100,
+  };
+  for (iree_device_size_t allocation_size : allocation_sizes) {
+    iree_hal_buffer_t* buffer = NULL;
+    IREE_ASSERT_OK(iree_hal_allocator_allocate_buffer(
+        allocator, params, allocation_size, &buffer));
+
+    iree_hal_buffer_mapping_t mapping;
+    IREE_ASSERT_OK(iree_hal_buffer_map_range(
+        buffer, IREE_HAL_MAPPING_MODE_SCOPED,
+        IREE_HAL_MEMORY_ACCESS_DISCARD_WRITE, 0, IREE_HAL_WHOLE_BUFFER,
+        &mapping));
+    memset(mapping.contents.data, 0xCD, mapping.contents.data_length);
+
+    const iree_device_size_t large_page_bytes =
+        QueryLargePageBytes(allocator);
+    if (large_page_bytes) {
+      EXPECT_EQ(large_page_bytes, 4 * large_page_size)
+          << "allocation_size=" << allocation_size;
+      EXPECT_TRUE(iree_host_size_has_alignment(
+          (uintptr_t)mapping.contents.data, large_page_size));
+    }
+
+    IREE_ASSERT_OK(iree_hal_buffer_unmap_range(&mapping));
+    iree_hal_buffer_release(buffer);
+    EXPECT_EQ(QueryLargePageBytes(allocator), 0);
+  }
+
+  iree_hal_allocator_release(allocator);
+}
+
+}  // namespace
@@ -10,6 +10,7 @@
 #include <stddef.h>
 #include <string.h>
 
+#include "iree/base/internal/memory.h"
 #include "iree/hal/allocator.h"
 #include "iree/hal/detail.h"
 
@@ -613,11 +614,12 @@ IREE_API_EXPORT iree_status_t iree_hal_buffer_map_fill(
   IREE_ASSERT_ARGUMENT(buffer);
   IREE_ASSERT_ARGUMENT(pattern);
 
-  if (IREE_UNLIKELY(pattern_length != 1 && pattern_length != 2 &&
-                    pattern_length != 4)) {
+  if (IREE_UNLIKELY(pattern_length == 0 ||
+                    pattern_length > IREE_MEMORY_FILL_MAX_PATTERN_LENGTH ||
+                    !iree_is_power_of_two_uint64(pattern_length))) {
     return iree_make_status(
         IREE_STATUS_INVALID_ARGUMENT,
-        "fill patterns must be 1, 2, or 4 bytes (got %" PRIhsz ")",
+        "fill patterns must be 1, 2, 4, 8, or 16 bytes (got %" PRIhsz ")",
         pattern_length);
   }
 
@@ -647,47 +649,13 @@ IREE_API_EXPORT iree_status_t iree_hal_buffer_map_fill(
                             pattern_length, byte_offset, byte_length);
   }
 
-  const uint32_t zero_32 = 0;
-  if (memcmp(pattern, &zero_32, pattern_length) == 0) {
-    // We can turn all-zero values into single-byte fills as that can be much
-    // faster on devices (doing a fill8 vs fill32).
-    pattern_length = 1;
-  }
+  // Patterns are reduced to their shortest repeating unit during the fill so
+  // all-zero values become single-byte memsets.
+  iree_memory_fill(target_mapping.contents.data, (iree_host_size_t)byte_length,
+                   pattern, pattern_length);
 
   iree_status_t status = iree_ok_status();
-  void* data_ptr = target_mapping.contents.data;
-  switch (pattern_length) {
-    case 1: {
-      uint8_t* data = (uint8_t*)data_ptr;
-      uint8_t value_bits = *(const uint8_t*)(pattern);
-      memset(data, value_bits, byte_length);
-      break;
-    }
-    case 2: {
-      uint16_t* data = (uint16_t*)data_ptr;
-      uint16_t value_bits = *(const uint16_t*)(pattern);
-      for (iree_device_size_t i = 0; i < byte_length / sizeof(uint16_t); ++i) {
-        data[i] = value_bits;
-      }
-      break;
-    }
-    case 4: {
-      uint32_t* data = (uint32_t*)data_ptr;
-      uint32_t value_bits = *(const uint32_t*)(pattern);
-      for (iree_device_size_t i = 0; i < byte_length / sizeof(uint32_t); ++i) {
-        data[i] = value_bits;
-      }
-      break;
-    }
-    default:
-      status = iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
-                                "unsupported fill pattern length: %" PRIhsz,
-                                pattern_length);
-      break;
-  }
-
-  if (iree_status_is_ok(status) &&
-      !iree_all_bits_set(iree_hal_buffer_memory_type(buffer),
+  if (!iree_all_bits_set(iree_hal_buffer_memory_type(buffer),
                          IREE_HAL_MEMORY_TYPE_HOST_COHERENT)) {
     status = iree_hal_buffer_mapping_flush_range(&target_mapping, 0,
                                                  IREE_HAL_WHOLE_BUFFER);
@@ -716,7 +684,8 @@ IREE_API_EXPORT iree_status_t iree_hal_buffer_map_read(
                                     IREE_HAL_MEMORY_ACCESS_READ, source_offset,
                                     data_length, &source_mapping));
 
-  memcpy(target_buffer, source_mapping.contents.data, data_length);
+  iree_memory_copy(target_buffer, source_mapping.contents.data, data_length,
+                   IREE_MEMORY_COPY_FLAG_NONE);
 
   iree_hal_buffer_unmap_range(&source_mapping);
   IREE_TRACE_ZONE_END(z0);
@@ -741,7 +710,8 @@ IREE_API_EXPORT iree_status_t iree_hal_buffer_map_write(
                                 IREE_HAL_MEMORY_ACCESS_DISCARD_WRITE,
                                 target_offset, data_length, &target_mapping));
 
-  memcpy(target_mapping.contents.data, source_buffer, data_length);
+  iree_memory_copy(target_mapping.contents.data, source_buffer, data_length,
+                   IREE_MEMORY_COPY_FLAG_NONE);
 
   iree_status_t status = iree_ok_status();
   if (!iree_all_bits_set(iree_hal_buffer_memory_type(target_buffer),
@@ -818,8 +788,8 @@ IREE_API_EXPORT iree_status_t iree_hal_buffer_map_copy(
     return iree_ok_status();
   }
 
-  memcpy(target_mapping.contents.data, source_mapping.contents.data,
-         adjusted_data_length);
+  iree_memory_copy(target_mapping.contents.data, source_mapping.contents.data,
+                   adjusted_data_length, IREE_MEMORY_COPY_FLAG_NONE);
 
   if (!iree_all_bits_set(iree_hal_buffer_memory_type(target_buffer),
                          IREE_HAL_MEMORY_TYPE_HOST_COHERENT)) {
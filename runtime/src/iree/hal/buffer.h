@@ -924,7 +924,9 @@ IREE_API_EXPORT iree_status_t iree_hal_buffer_map_zero(
     iree_device_size_t byte_length);
 
 // Sets a range of the buffer to the given value.
-// Only |pattern_length| values with 1, 2, or 4 bytes are supported.
+// Only |pattern_length| values with 1, 2, 4, 8, or 16 bytes are supported and
+// the offset and length must be aligned to the pattern length. Note that
+// command buffer fills are limited to 1, 2, or 4 byte patterns.
 //
 // Requires that the buffer has the IREE_HAL_BUFFER_USAGE_MAPPING bit set.
 // The byte range in |buffer| will be flushed if needed.
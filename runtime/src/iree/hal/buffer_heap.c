@@ -28,6 +28,11 @@ typedef enum iree_hal_heap_buffer_storage_mode_e {
   // A user-provided buffer release callback is notified that the buffer is no
   // longer referencing the data.
   IREE_HAL_HEAP_BUFFER_STORAGE_MODE_EXTERNAL = 2u,
+  // Allocated as split [metadata] and [data] from a data allocator that
+  // returns storage already aligned to IREE_HAL_HEAP_BUFFER_ALIGNMENT.
+  // The base metadata pointer must be freed with iree_allocator_free.
+  // The data storage must be freed with iree_allocator_free.
+  IREE_HAL_HEAP_BUFFER_STORAGE_MODE_SPLIT_UNPADDED = 3u,
 } iree_hal_heap_buffer_storage_mode_t;
 
 typedef struct iree_hal_heap_buffer_t {
@@ -43,7 +48,8 @@ typedef struct iree_hal_heap_buffer_t {
   iree_byte_span_t data;
 
   union {
-    // Used for IREE_HAL_HEAP_BUFFER_STORAGE_MODE_SPLIT.
+    // Used for IREE_HAL_HEAP_BUFFER_STORAGE_MODE_SPLIT and
+    // IREE_HAL_HEAP_BUFFER_STORAGE_MODE_SPLIT_UNPADDED.
     iree_allocator_t data_allocator;
     // Used for IREE_HAL_HEAP_BUFFER_STORAGE_MODE_EXTERNAL.
     iree_hal_buffer_release_callback_t release_callback;
@@ -57,18 +63,24 @@ static const iree_hal_buffer_vtable_t iree_hal_heap_buffer_vtable;
 
 // Allocates a buffer with the metadata and storage split.
 // This results in an additional host allocation but allows for user-overridden
-// data storage allocations.
+// data storage allocations. If |padded| is false the data allocator already
+// returns aligned storage and it is allocated without alignment padding.
 static iree_status_t iree_hal_heap_buffer_allocate_split(
     iree_device_size_t allocation_size, iree_allocator_t data_allocator,
-    iree_allocator_t host_allocator, iree_hal_heap_buffer_t** out_buffer,
-    iree_byte_span_t* out_data) {
+    bool padded, iree_allocator_t host_allocator,
+    iree_hal_heap_buffer_t** out_buffer, iree_byte_span_t* out_data) {
   // Try allocating the storage first as it's the most likely to fail if OOM.
   // It must be aligned to the minimum buffer alignment.
   out_data->data_length = allocation_size;
   uint8_t* data_ptr = 0;
-  IREE_RETURN_IF_ERROR(iree_allocator_malloc_aligned(
-      data_allocator, allocation_size, IREE_HAL_HEAP_BUFFER_ALIGNMENT,
-      /*offset=*/0, (void**)&data_ptr));
+  if (padded) {
+    IREE_RETURN_IF_ERROR(iree_allocator_malloc_aligned(
+        data_allocator, allocation_size, IREE_HAL_HEAP_BUFFER_ALIGNMENT,
+        /*offset=*/0, (void**)&data_ptr));
+  } else {
+    IREE_RETURN_IF_ERROR(iree_allocator_malloc(data_allocator, allocation_size,
+                                               (void**)&data_ptr));
+  }
   IREE_ASSERT_TRUE(iree_host_size_has_alignment(
       (iree_host_size_t)data_ptr, IREE_HAL_HEAP_BUFFER_ALIGNMENT));
   out_data->data = data_ptr;
@@ -78,7 +90,11 @@ static iree_status_t iree_hal_heap_buffer_allocate_split(
       host_allocator, sizeof(**out_buffer), (void**)out_buffer);
   if (!iree_status_is_ok(status)) {
     // Need to free the storage we just allocated.
-    iree_allocator_free_aligned(data_allocator, out_data->data);
+    if (padded) {
+      iree_allocator_free_aligned(data_allocator, out_data->data);
+    } else {
+      iree_allocator_free(data_allocator, out_data->data);
+    }
   }
   return status;
 }
@@ -117,7 +133,8 @@ static iree_status_t iree_hal_heap_buffer_allocate_slab(
 iree_status_t iree_hal_heap_buffer_create(
     iree_hal_heap_allocator_statistics_t* statistics,
     const iree_hal_buffer_params_t* params, iree_device_size_t allocation_size,
-    iree_allocator_t data_allocator, iree_allocator_t host_allocator,
+    iree_allocator_node_id_t node_id, iree_allocator_t data_allocator,
+    iree_host_size_t data_alignment, iree_allocator_t host_allocator,
     iree_hal_buffer_t** out_buffer) {
   IREE_ASSERT_ARGUMENT(params);
   IREE_ASSERT_ARGUMENT(out_buffer);
@@ -128,6 +145,7 @@ iree_status_t iree_hal_heap_buffer_create(
   // metadata and the storage independently.
   const bool same_allocator =
       memcmp(&data_allocator, &host_allocator, sizeof(data_allocator)) == 0;
+  const bool padded = data_alignment < IREE_HAL_HEAP_BUFFER_ALIGNMENT;
 
   iree_hal_heap_buffer_t* buffer = NULL;
   iree_byte_span_t data = iree_make_byte_span(NULL, 0);
@@ -136,7 +154,8 @@ iree_status_t iree_hal_heap_buffer_create(
           ? iree_hal_heap_buffer_allocate_slab(allocation_size, host_allocator,
                                                &buffer, &data)
           : iree_hal_heap_buffer_allocate_split(allocation_size, data_allocator,
-                                                host_allocator, &buffer, &data);
+                                                padded, host_allocator, &buffer,
+                                                &data);
 
   if (iree_status_is_ok(status)) {
     iree_hal_buffer_initialize(
@@ -150,10 +169,23 @@ iree_status_t iree_hal_heap_buffer_create(
       buffer->base.flags = IREE_HAL_HEAP_BUFFER_STORAGE_MODE_SLAB;
       buffer->data_allocator = iree_allocator_null();
     } else {
-      buffer->base.flags = IREE_HAL_HEAP_BUFFER_STORAGE_MODE_SPLIT;
+      buffer->base.flags =
+          padded ? IREE_HAL_HEAP_BUFFER_STORAGE_MODE_SPLIT
+                 : IREE_HAL_HEAP_BUFFER_STORAGE_MODE_SPLIT_UNPADDED;
       buffer->data_allocator = data_allocator;
     }
 
+    // Place the storage on the requested NUMA node. The allocator may have
+    // recycled (or zeroed) the pages so we request they be migrated if needed.
+    // Placement is advisory and failures (unsupported allocators/platforms or
+    // offline nodes) leave the storage wherever it was first touched.
+    if (node_id != IREE_ALLOCATOR_NODE_ID_ANY) {
+      IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, node_id);
+      iree_status_ignore(iree_allocator_bind(
+          same_allocator ? host_allocator : data_allocator, data.data,
+          data.data_length, node_id, IREE_ALLOCATOR_BIND_FLAG_MOVE));
+    }
+
     IREE_STATISTICS({
       if (statistics != NULL) {
         buffer->statistics = statistics;
@@ -233,6 +265,11 @@ static void iree_hal_heap_buffer_destroy(iree_hal_buffer_t* base_buffer) {
       break;
     }
     case IREE_HAL_HEAP_BUFFER_STORAGE_MODE_SPLIT: {
+      iree_allocator_free_aligned(buffer->data_allocator, buffer->data.data);
+      iree_allocator_free(host_allocator, buffer);
+      break;
+    }
+    case IREE_HAL_HEAP_BUFFER_STORAGE_MODE_SPLIT_UNPADDED: {
       iree_allocator_free(buffer->data_allocator, buffer->data.data);
       iree_allocator_free(host_allocator, buffer);
       break;
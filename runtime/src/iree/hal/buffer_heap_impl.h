@@ -29,11 +29,19 @@ typedef struct iree_hal_heap_allocator_statistics_t {
 // Allocates a new heap buffer from the specified |data_allocator|.
 // |host_allocator| is used for the iree_hal_buffer_t metadata. If both
 // |data_allocator| and |host_allocator| are the same the buffer will be created
-// as a flat slab. |out_buffer| must be released by the caller.
+// as a flat slab. If |node_id| is not IREE_ALLOCATOR_NODE_ID_ANY the buffer
+// storage is bound to the NUMA node if the allocator supports it.
+// |data_alignment| is the alignment |data_allocator| guarantees for an
+// allocation of |allocation_size| bytes (such as the page size of allocators
+// that map pages) or 0 if unknown. When it is at least
+// IREE_HAL_HEAP_BUFFER_ALIGNMENT the storage is allocated without the padding
+// otherwise needed to align it.
+// |out_buffer| must be released by the caller.
 iree_status_t iree_hal_heap_buffer_create(
     iree_hal_heap_allocator_statistics_t* statistics,
     const iree_hal_buffer_params_t* params, iree_device_size_t allocation_size,
-    iree_allocator_t data_allocator, iree_allocator_t host_allocator,
+    iree_allocator_node_id_t node_id, iree_allocator_t data_allocator,
+    iree_host_size_t data_alignment, iree_allocator_t host_allocator,
     iree_hal_buffer_t** out_buffer);
 
 #ifdef __cplusplus
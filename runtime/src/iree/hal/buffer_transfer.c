@@ -6,6 +6,8 @@
 
 #include "iree/hal/buffer_transfer.h"
 
+#include "iree/base/internal/memory.h"
+
 //===----------------------------------------------------------------------===//
 // Transfer utilities
 //===----------------------------------------------------------------------===//
@@ -154,10 +156,13 @@ static iree_status_t iree_hal_device_transfer_mappable_range(
       adjusted_data_length = target_mapping.contents.data_length;
     }
 
-    // Perform the copy, assuming there's anything to do.
+    // Perform the copy, assuming there's anything to do. Mapped device buffers
+    // may be host memory consumed by CPU executables right after the transfer
+    // so the copy goes through the caches.
     if (adjusted_data_length != 0) {
-      memcpy(target_mapping.contents.data, source_mapping.contents.data,
-             adjusted_data_length);
+      iree_memory_copy(target_mapping.contents.data,
+                       source_mapping.contents.data, adjusted_data_length,
+                       IREE_MEMORY_COPY_FLAG_NONE);
     }
   }
 
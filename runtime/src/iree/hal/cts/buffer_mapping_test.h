@@ -288,6 +288,41 @@ TEST_F(BufferMappingTest, FillSubspan) {
   iree_hal_buffer_release(buffer);
 }
 
+TEST_F(BufferMappingTest, FillWidePatterns) {
+  iree_device_size_t buffer_size = 256;
+  iree_hal_buffer_t* buffer = NULL;
+  AllocateUninitializedBuffer(buffer_size, &buffer);
+
+  const uint8_t pattern[16] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                               0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+  for (iree_host_size_t pattern_length : {8, 16}) {
+    // Zero the entire buffer then fill a segment that isn't a multiple of the
+    // internal fill block size.
+    IREE_ASSERT_OK(iree_hal_buffer_map_zero(buffer, 0, IREE_HAL_WHOLE_BUFFER));
+    iree_device_size_t fill_offset = 16;
+    iree_device_size_t fill_length = 208;
+    IREE_ASSERT_OK(iree_hal_buffer_map_fill(buffer, fill_offset, fill_length,
+                                            pattern, pattern_length));
+
+    std::vector<uint8_t> actual_data(buffer_size);
+    IREE_ASSERT_OK(iree_hal_buffer_map_read(
+        buffer, /*source_offset=*/0, actual_data.data(), actual_data.size()));
+    std::vector<uint8_t> reference_buffer(buffer_size, 0x00);
+    for (iree_device_size_t i = 0; i < fill_length; ++i) {
+      reference_buffer[fill_offset + i] = pattern[i % pattern_length];
+    }
+    EXPECT_THAT(actual_data, ContainerEq(reference_buffer));
+  }
+
+  // Offsets must be aligned to the pattern length.
+  iree_status_t status = iree_hal_buffer_map_fill(
+      buffer, /*byte_offset=*/8, /*byte_length=*/16, pattern, sizeof(pattern));
+  IREE_EXPECT_STATUS_IS(IREE_STATUS_INVALID_ARGUMENT, status);
+  iree_status_ignore(status);
+
+  iree_hal_buffer_release(buffer);
+}
+
 TEST_F(BufferMappingTest, ReadData) {
   iree_device_size_t buffer_size = 16;
   iree_hal_buffer_t* buffer = NULL;
@@ -392,6 +392,120 @@ TEST_F(SemaphoreTest, WaitForFiniteTime) {
   });
 }
 
+// Waits on any of several semaphores for a finite amount of time.
+TEST_F(SemaphoreTest, MultiWaitAnyForFiniteTime) {
+  iree_hal_semaphore_t* semaphore_a = this->CreateSemaphore();
+  iree_hal_semaphore_t* semaphore_b = this->CreateSemaphore();
+  iree_hal_semaphore_t* semaphore_array[] = {semaphore_a, semaphore_b};
+  uint64_t payload_array[] = {1, 1};
+  iree_hal_semaphore_list_t semaphore_list = {
+      IREE_ARRAYSIZE(semaphore_array),
+      semaphore_array,
+      payload_array,
+  };
+
+  // Neither semaphore is signaled before the deadline.
+  iree_status_t status = iree_hal_device_wait_semaphores(
+      device_, IREE_HAL_WAIT_MODE_ANY, semaphore_list,
+      iree_make_timeout_ms(10), IREE_HAL_WAIT_FLAG_DEFAULT);
+  IREE_EXPECT_STATUS_IS(IREE_STATUS_DEADLINE_EXCEEDED, status);
+  status = iree_status_ignore(status);
+  CheckSemaphoreValue(semaphore_a, 0);
+  CheckSemaphoreValue(semaphore_b, 0);
+
+  // Signaling one of them wakes the waiter.
+  std::thread thread([&]() {
+    std::this_thread::sleep_for(10ms);
+    IREE_ASSERT_OK(iree_hal_semaphore_signal(semaphore_b, 1));
+  });
+  IREE_ASSERT_OK(iree_hal_device_wait_semaphores(
+      device_, IREE_HAL_WAIT_MODE_ANY, semaphore_list,
+      iree_make_deadline(IREE_TIME_INFINITE_FUTURE),
+      IREE_HAL_WAIT_FLAG_DEFAULT));
+  thread.join();
+  CheckSemaphoreValue(semaphore_a, 0);
+  CheckSemaphoreValue(semaphore_b, 1);
+
+  iree_hal_semaphore_release(semaphore_a);
+  iree_hal_semaphore_release(semaphore_b);
+}
+
+// Waits on all of several semaphores for a finite amount of time.
+TEST_F(SemaphoreTest, MultiWaitAllForFiniteTime) {
+  iree_hal_semaphore_t* semaphore_a = this->CreateSemaphore();
+  iree_hal_semaphore_t* semaphore_b = this->CreateSemaphore();
+  iree_hal_semaphore_t* semaphore_array[] = {semaphore_a, semaphore_b};
+  uint64_t payload_array[] = {1, 1};
+  iree_hal_semaphore_list_t semaphore_list = {
+      IREE_ARRAYSIZE(semaphore_array),
+      semaphore_array,
+      payload_array,
+  };
+
+  // Only one semaphore is signaled before the deadline.
+  IREE_ASSERT_OK(iree_hal_semaphore_signal(semaphore_a, 1));
+  iree_status_t status = iree_hal_device_wait_semaphores(
+      device_, IREE_HAL_WAIT_MODE_ALL, semaphore_list,
+      iree_make_timeout_ms(10), IREE_HAL_WAIT_FLAG_DEFAULT);
+  IREE_EXPECT_STATUS_IS(IREE_STATUS_DEADLINE_EXCEEDED, status);
+  status = iree_status_ignore(status);
+  CheckSemaphoreValue(semaphore_b, 0);
+
+  // Signaling the other wakes the waiter.
+  std::thread thread([&]() {
+    std::this_thread::sleep_for(10ms);
+    IREE_ASSERT_OK(iree_hal_semaphore_signal(semaphore_b, 1));
+  });
+  IREE_ASSERT_OK(iree_hal_device_wait_semaphores(
+      device_, IREE_HAL_WAIT_MODE_ALL, semaphore_list,
+      iree_make_deadline(IREE_TIME_INFINITE_FUTURE),
+      IREE_HAL_WAIT_FLAG_DEFAULT));
+  thread.join();
+  CheckSemaphoreValue(semaphore_b, 1);
+
+  iree_hal_semaphore_release(semaphore_a);
+  iree_hal_semaphore_release(semaphore_b);
+}
+
+// Waits on more semaphores than implementations are likely to track inline.
+TEST_F(SemaphoreTest, MultiWaitManySemaphores) {
+  iree_hal_semaphore_t* semaphore_array[64];
+  uint64_t payload_array[IREE_ARRAYSIZE(semaphore_array)];
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(semaphore_array); ++i) {
+    semaphore_array[i] = this->CreateSemaphore();
+    payload_array[i] = 1;
+  }
+  iree_hal_semaphore_list_t semaphore_list = {
+      IREE_ARRAYSIZE(semaphore_array),
+      semaphore_array,
+      payload_array,
+  };
+
+  for (iree_hal_wait_mode_t wait_mode :
+       {IREE_HAL_WAIT_MODE_ALL, IREE_HAL_WAIT_MODE_ANY}) {
+    iree_status_t status = iree_hal_device_wait_semaphores(
+        device_, wait_mode, semaphore_list, iree_make_timeout_ms(10),
+        IREE_HAL_WAIT_FLAG_DEFAULT);
+    IREE_EXPECT_STATUS_IS(IREE_STATUS_DEADLINE_EXCEEDED, status);
+    status = iree_status_ignore(status);
+  }
+
+  std::thread thread([&]() {
+    std::this_thread::sleep_for(10ms);
+    IREE_ASSERT_OK(iree_hal_semaphore_list_signal(semaphore_list));
+  });
+  IREE_ASSERT_OK(iree_hal_device_wait_semaphores(
+      device_, IREE_HAL_WAIT_MODE_ALL, semaphore_list,
+      iree_make_deadline(IREE_TIME_INFINITE_FUTURE),
+      IREE_HAL_WAIT_FLAG_DEFAULT));
+  thread.join();
+
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(semaphore_array); ++i) {
+    CheckSemaphoreValue(semaphore_array[i], 1);
+    iree_hal_semaphore_release(semaphore_array[i]);
+  }
+}
+
 // Wait on all semaphores on multiple places simultaneously.
 TEST_F(SemaphoreTest, SimultaneousMultiWaitAll) {
   iree_hal_semaphore_t* semaphore1 = this->CreateSemaphore();
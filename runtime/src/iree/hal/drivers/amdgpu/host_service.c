@@ -462,6 +462,8 @@ iree_status_t iree_hal_amdgpu_host_service_initialize(
   // the devices this worker is servicing.
   iree_thread_affinity_t thread_affinity = {0};
   iree_thread_affinity_set_group_any(host_agent_node, &thread_affinity);
+  thread_affinity.numa_node_assigned = 1;
+  thread_affinity.numa_node = host_agent_node;
 
   // Create a semaphore for tracking outstanding asynchronous operations. It's
   // marked as only being "consumed" by the host agent (waited on). Other agents
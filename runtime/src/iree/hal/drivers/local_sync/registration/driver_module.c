@@ -10,10 +10,24 @@
 #include <stddef.h>
 
 #include "iree/base/api.h"
+#include "iree/base/internal/flags.h"
 #include "iree/hal/drivers/local_sync/sync_driver.h"
 #include "iree/hal/local/loaders/registration/init.h"
 #include "iree/hal/local/plugins/registration/init.h"
 
+IREE_FLAG(
+    int32_t, sync_worker_count, 0,
+    "Number of worker threads the local-sync driver splits the workgroups of\n"
+    "each dispatch across in addition to the submitting thread. Execution\n"
+    "remains synchronous with submission. 0 runs everything on the\n"
+    "submitting thread.");
+
+IREE_FLAG(
+    int32_t, sync_worker_spin_us, 50,
+    "Maximum duration in microseconds the submitting thread and local-sync\n"
+    "workers spin waiting on each other before parking. Only used when\n"
+    "--sync_worker_count= is non-zero.");
+
 static iree_status_t iree_hal_local_sync_driver_factory_enumerate(
     void* self, iree_host_size_t* out_driver_info_count,
     const iree_hal_driver_info_t** out_driver_infos) {
@@ -38,6 +52,14 @@ static iree_status_t iree_hal_local_sync_driver_factory_try_create(
 
   iree_hal_sync_device_params_t default_params;
   iree_hal_sync_device_params_initialize(&default_params);
+  if (FLAG_sync_worker_count < 0 || FLAG_sync_worker_spin_us < 0) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "--sync_worker_count= and --sync_worker_spin_us= "
+                            "must be non-negative");
+  }
+  default_params.worker_count = (iree_host_size_t)FLAG_sync_worker_count;
+  default_params.worker_spin_ns =
+      (iree_duration_t)FLAG_sync_worker_spin_us * 1000;
 
   iree_hal_executable_plugin_manager_t* plugin_manager = NULL;
   iree_status_t status = iree_hal_executable_plugin_manager_create_from_flags(
@@ -15,11 +15,14 @@
 #include "iree/hal/drivers/local_sync/sync_event.h"
 #include "iree/hal/drivers/local_sync/sync_semaphore.h"
 #include "iree/hal/local/executable_environment.h"
+#include "iree/hal/local/fork_join_pool.h"
 #include "iree/hal/local/inline_command_buffer.h"
 #include "iree/hal/local/local_executable_cache.h"
+#include "iree/hal/local/profiling.h"
 #include "iree/hal/utils/deferred_command_buffer.h"
 #include "iree/hal/utils/file_registry.h"
 #include "iree/hal/utils/file_transfer.h"
+#include "iree/hal/utils/object_pool.h"
 #include "iree/hal/utils/queue_emulation.h"
 
 typedef struct iree_hal_sync_device_t {
@@ -32,14 +35,20 @@ typedef struct iree_hal_sync_device_t {
   // Optional provider used for creating/configuring collective channels.
   iree_hal_channel_provider_t* channel_provider;
 
+  // Hardware counter profiler active between profiling_begin/end, if any.
+  iree_hal_local_profiler_t* profiler;
+
+  // Optional pool splitting dispatch workgroups across threads.
+  iree_hal_local_fork_join_pool_t* fork_join_pool;
+
   // Block pool used for command buffers with a larger block size (as command
   // buffers can contain inlined data uploads).
   iree_arena_block_pool_t large_block_pool;
 
-  // Shared semaphore state used to emulate OS-level primitives. This backend
-  // is intended to run on bare-metal systems where we need to perform all
-  // synchronization ourselves.
-  iree_hal_sync_semaphore_state_t semaphore_state;
+  // Pools recycling the storage of semaphores and command buffers as most
+  // invocations create and destroy a few of each.
+  iree_hal_object_pool_t* semaphore_pool;
+  iree_hal_object_pool_t* command_buffer_pool;
 
   iree_host_size_t loader_count;
   iree_hal_executable_loader_t* loaders[];
@@ -57,6 +66,10 @@ void iree_hal_sync_device_params_initialize(
     iree_hal_sync_device_params_t* out_params) {
   memset(out_params, 0, sizeof(*out_params));
   out_params->arena_block_size = 32 * 1024;
+  out_params->worker_count = 0;
+  out_params->worker_spin_ns = 50 * 1000;
+  out_params->semaphore_pool_capacity = 64;
+  out_params->command_buffer_pool_capacity = 16;
 }
 
 static iree_status_t iree_hal_sync_device_check_params(
@@ -107,8 +120,28 @@ iree_status_t iree_hal_sync_device_create(
       device->loaders[i] = loaders[i];
       iree_hal_executable_loader_retain(device->loaders[i]);
     }
+  }
+
+  if (iree_status_is_ok(status) && params->worker_count > 0) {
+    iree_hal_local_fork_join_pool_params_t pool_params;
+    iree_hal_local_fork_join_pool_params_initialize(&pool_params);
+    pool_params.worker_count = params->worker_count;
+    pool_params.spin_ns = params->worker_spin_ns;
+    status = iree_hal_local_fork_join_pool_create(
+        &pool_params, host_allocator, &device->fork_join_pool);
+  }
 
-    iree_hal_sync_semaphore_state_initialize(&device->semaphore_state);
+  if (iree_status_is_ok(status)) {
+    status = iree_hal_object_pool_allocate(
+        params->semaphore_pool_capacity,
+        IREE_HAL_OBJECT_POOL_DEFAULT_MAX_OBJECT_SIZE, host_allocator,
+        &device->semaphore_pool);
+  }
+  if (iree_status_is_ok(status)) {
+    status = iree_hal_object_pool_allocate(
+        params->command_buffer_pool_capacity,
+        IREE_HAL_OBJECT_POOL_DEFAULT_MAX_OBJECT_SIZE, host_allocator,
+        &device->command_buffer_pool);
   }
 
   if (iree_status_is_ok(status)) {
@@ -125,15 +158,23 @@ static void iree_hal_sync_device_destroy(iree_hal_device_t* base_device) {
   iree_allocator_t host_allocator = iree_hal_device_host_allocator(base_device);
   IREE_TRACE_ZONE_BEGIN(z0);
 
-  iree_hal_sync_semaphore_state_deinitialize(&device->semaphore_state);
+  iree_hal_local_fork_join_pool_free(device->fork_join_pool);
 
   for (iree_host_size_t i = 0; i < device->loader_count; ++i) {
     iree_hal_executable_loader_release(device->loaders[i]);
   }
 
+  // Profiling should have been ended by the user but if not we end it here
+  // and drop the (unreportable) flush errors.
+  iree_status_ignore(iree_hal_local_profiler_end(device->profiler));
+
   iree_hal_allocator_release(device->device_allocator);
   iree_hal_channel_provider_release(device->channel_provider);
 
+  // Objects still live keep their pools alive until they are destroyed.
+  iree_hal_object_pool_release(device->command_buffer_pool);
+  iree_hal_object_pool_release(device->semaphore_pool);
+
   iree_arena_block_pool_deinitialize(&device->large_block_pool);
 
   iree_allocator_free_aligned(host_allocator, device);
@@ -177,6 +218,8 @@ static void iree_hal_sync_replace_channel_provider(
 
 static iree_status_t iree_hal_sync_device_trim(iree_hal_device_t* base_device) {
   iree_hal_sync_device_t* device = iree_hal_sync_device_cast(base_device);
+  iree_hal_object_pool_trim(device->semaphore_pool);
+  iree_hal_object_pool_trim(device->command_buffer_pool);
   return iree_hal_allocator_trim(device->device_allocator);
 }
 
@@ -213,6 +256,14 @@ static iree_status_t iree_hal_sync_device_query_i64(
     }
   } else if (iree_string_view_equal(category, IREE_SV("hal.cpu"))) {
     return iree_cpu_lookup_data_by_key(key, out_value);
+  } else if (iree_string_view_equal(category,
+                                    IREE_SV("hal.device.semaphore_pool"))) {
+    return iree_hal_object_pool_query_i64(device->semaphore_pool, key,
+                                          out_value);
+  } else if (iree_string_view_equal(
+                 category, IREE_SV("hal.device.command_buffer_pool"))) {
+    return iree_hal_object_pool_query_i64(device->command_buffer_pool, key,
+                                          out_value);
   }
 
   return iree_make_status(
@@ -233,18 +284,20 @@ static iree_status_t iree_hal_sync_device_create_command_buffer(
     iree_hal_command_category_t command_categories,
     iree_hal_queue_affinity_t queue_affinity, iree_host_size_t binding_capacity,
     iree_hal_command_buffer_t** out_command_buffer) {
+  iree_hal_sync_device_t* device = iree_hal_sync_device_cast(base_device);
   if (iree_all_bits_set(mode,
                         IREE_HAL_COMMAND_BUFFER_MODE_ALLOW_INLINE_EXECUTION)) {
     return iree_hal_inline_command_buffer_create(
         iree_hal_device_allocator(base_device), mode, command_categories,
-        queue_affinity, binding_capacity,
-        iree_hal_device_host_allocator(base_device), out_command_buffer);
+        queue_affinity, binding_capacity, device->fork_join_pool,
+        iree_hal_object_pool_allocator(device->command_buffer_pool),
+        out_command_buffer);
   } else {
-    iree_hal_sync_device_t* device = iree_hal_sync_device_cast(base_device);
     return iree_hal_deferred_command_buffer_create(
         iree_hal_device_allocator(base_device), mode, command_categories,
         queue_affinity, binding_capacity, &device->large_block_pool,
-        device->host_allocator, out_command_buffer);
+        iree_hal_object_pool_allocator(device->command_buffer_pool),
+        out_command_buffer);
   }
 }
 
@@ -260,8 +313,10 @@ static iree_status_t iree_hal_sync_device_create_executable_cache(
     iree_hal_device_t* base_device, iree_string_view_t identifier,
     iree_loop_t loop, iree_hal_executable_cache_t** out_executable_cache) {
   iree_hal_sync_device_t* device = iree_hal_sync_device_cast(base_device);
+  iree_host_size_t worker_capacity =
+      iree_hal_local_fork_join_pool_concurrency(device->fork_join_pool);
   return iree_hal_local_executable_cache_create(
-      identifier, /*worker_capacity=*/1, device->loader_count, device->loaders,
+      identifier, worker_capacity, device->loader_count, device->loaders,
       iree_hal_device_host_allocator(base_device), out_executable_cache);
 }
 
@@ -279,8 +334,9 @@ static iree_status_t iree_hal_sync_device_create_semaphore(
     uint64_t initial_value, iree_hal_semaphore_flags_t flags,
     iree_hal_semaphore_t** out_semaphore) {
   iree_hal_sync_device_t* device = iree_hal_sync_device_cast(base_device);
-  return iree_hal_sync_semaphore_create(&device->semaphore_state, initial_value,
-                                        device->host_allocator, out_semaphore);
+  return iree_hal_sync_semaphore_create(
+      initial_value, iree_hal_object_pool_allocator(device->semaphore_pool),
+      out_semaphore);
 }
 
 static iree_hal_semaphore_compatibility_t
@@ -453,8 +509,8 @@ static iree_status_t iree_hal_sync_device_apply_deferred_command_buffer(
                : 0),
       iree_hal_command_buffer_allowed_categories(command_buffer),
       IREE_HAL_QUEUE_AFFINITY_ANY,
-      /*binding_capacity=*/0, device->host_allocator, storage,
-      &inline_command_buffer));
+      /*binding_capacity=*/0, device->fork_join_pool, device->host_allocator,
+      storage, &inline_command_buffer));
 
   iree_status_t status = iree_hal_deferred_command_buffer_apply(
       command_buffer, inline_command_buffer, binding_table);
@@ -479,8 +535,8 @@ static iree_status_t iree_hal_sync_device_queue_execute(
 
   // Wait for semaphores to be signaled before performing any work.
   IREE_RETURN_IF_ERROR(iree_hal_sync_semaphore_multi_wait(
-      &device->semaphore_state, IREE_HAL_WAIT_MODE_ALL, wait_semaphore_list,
-      iree_infinite_timeout(), IREE_HAL_WAIT_FLAG_DEFAULT));
+      IREE_HAL_WAIT_MODE_ALL, wait_semaphore_list, iree_infinite_timeout(),
+      IREE_HAL_WAIT_FLAG_DEFAULT));
 
   // Run all deferred command buffers - any we could have run inline we already
   // did during recording.
@@ -488,8 +544,8 @@ static iree_status_t iree_hal_sync_device_queue_execute(
       device, command_buffer, binding_table));
 
   // Signal all semaphores now that batch work has completed.
-  IREE_RETURN_IF_ERROR(iree_hal_sync_semaphore_multi_signal(
-      &device->semaphore_state, signal_semaphore_list));
+  IREE_RETURN_IF_ERROR(
+      iree_hal_sync_semaphore_multi_signal(signal_semaphore_list));
 
   return iree_ok_status();
 }
@@ -504,35 +560,37 @@ static iree_status_t iree_hal_sync_device_wait_semaphores(
     iree_hal_device_t* base_device, iree_hal_wait_mode_t wait_mode,
     const iree_hal_semaphore_list_t semaphore_list, iree_timeout_t timeout,
     iree_hal_wait_flags_t flags) {
-  iree_hal_sync_device_t* device = iree_hal_sync_device_cast(base_device);
-  return iree_hal_sync_semaphore_multi_wait(&device->semaphore_state, wait_mode,
-                                            semaphore_list, timeout, flags);
+  return iree_hal_sync_semaphore_multi_wait(wait_mode, semaphore_list, timeout,
+                                            flags);
 }
 
 static iree_status_t iree_hal_sync_device_profiling_begin(
     iree_hal_device_t* base_device,
     const iree_hal_device_profiling_options_t* options) {
-  // Unimplemented (and that's ok).
-  // We could hook in to vendor APIs (Intel/ARM/etc) or generic perf infra:
-  // https://man7.org/linux/man-pages/man2/perf_event_open.2.html
-  // Capturing things like:
-  //   PERF_COUNT_HW_CPU_CYCLES / PERF_COUNT_HW_INSTRUCTIONS
-  //   PERF_COUNT_HW_CACHE_REFERENCES / PERF_COUNT_HW_CACHE_MISSES
-  //   etc
-  // TODO(benvanik): shared iree/hal/local/profiling implementation of this.
-  return iree_ok_status();
+  iree_hal_sync_device_t* device = iree_hal_sync_device_cast(base_device);
+  if (device->profiler) {
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "profiling already active on the device");
+  }
+  // Only the hardware counter modes are implemented; the others are a no-op
+  // (and that's ok) as tracing already covers queue and dispatch timing.
+  return iree_hal_local_profiler_begin(options, device->host_allocator,
+                                       &device->profiler);
 }
 
 static iree_status_t iree_hal_sync_device_profiling_flush(
     iree_hal_device_t* base_device) {
-  // Unimplemented (and that's ok).
-  return iree_ok_status();
+  iree_hal_sync_device_t* device = iree_hal_sync_device_cast(base_device);
+  if (!device->profiler) return iree_ok_status();
+  return iree_hal_local_profiler_flush(device->profiler);
 }
 
 static iree_status_t iree_hal_sync_device_profiling_end(
     iree_hal_device_t* base_device) {
-  // Unimplemented (and that's ok).
-  return iree_ok_status();
+  iree_hal_sync_device_t* device = iree_hal_sync_device_cast(base_device);
+  iree_hal_local_profiler_t* profiler = device->profiler;
+  device->profiler = NULL;
+  return iree_hal_local_profiler_end(profiler);
 }
 
 static const iree_hal_device_vtable_t iree_hal_sync_device_vtable = {
@@ -22,6 +22,23 @@ typedef struct iree_hal_sync_device_params_t {
   // Larger sizes will lower overhead and ensure the heap isn't hit for
   // transient allocations while also increasing memory consumption.
   iree_host_size_t arena_block_size;
+
+  // Number of worker threads that execute the workgroups of each dispatch in
+  // parallel with the submitting thread. 0 executes all workgroups on the
+  // submitting thread. Submissions remain synchronous either way.
+  iree_host_size_t worker_count;
+  // Duration the submitting thread and workers spin waiting on each other
+  // before parking. Ignored if |worker_count| is 0.
+  iree_duration_t worker_spin_ns;
+
+  // Maximum number of destroyed semaphores whose storage is retained by the
+  // device and reused by new semaphores. 0 allocates every semaphore from the
+  // host allocator.
+  iree_host_size_t semaphore_pool_capacity;
+  // Maximum number of destroyed command buffers whose storage is retained by
+  // the device and reused by new command buffers. 0 allocates every command
+  // buffer from the host allocator.
+  iree_host_size_t command_buffer_pool_capacity;
 } iree_hal_sync_device_params_t;
 
 // Initializes |out_params| to default values.
@@ -13,22 +13,6 @@
 
 #include "iree/hal/utils/semaphore_base.h"
 
-//===----------------------------------------------------------------------===//
-// iree_hal_sync_semaphore_state_t
-//===----------------------------------------------------------------------===//
-
-void iree_hal_sync_semaphore_state_initialize(
-    iree_hal_sync_semaphore_state_t* out_shared_state) {
-  memset(out_shared_state, 0, sizeof(*out_shared_state));
-  iree_notification_initialize(&out_shared_state->notification);
-}
-
-void iree_hal_sync_semaphore_state_deinitialize(
-    iree_hal_sync_semaphore_state_t* shared_state) {
-  iree_notification_deinitialize(&shared_state->notification);
-  memset(shared_state, 0, sizeof(*shared_state));
-}
-
 //===----------------------------------------------------------------------===//
 // iree_hal_sync_semaphore_t
 //===----------------------------------------------------------------------===//
@@ -37,9 +21,6 @@ typedef struct iree_hal_sync_semaphore_t {
   iree_hal_semaphore_t base;
   iree_allocator_t host_allocator;
 
-  // Shared across all semaphores.
-  iree_hal_sync_semaphore_state_t* shared_state;
-
   // Guards all mutable fields. We expect low contention on semaphores and since
   // iree_slim_mutex_t is (effectively) just a CAS this keeps things simpler
   // than trying to make the entire structure lock-free.
@@ -63,9 +44,8 @@ static iree_hal_sync_semaphore_t* iree_hal_sync_semaphore_cast(
 }
 
 iree_status_t iree_hal_sync_semaphore_create(
-    iree_hal_sync_semaphore_state_t* shared_state, uint64_t initial_value,
-    iree_allocator_t host_allocator, iree_hal_semaphore_t** out_semaphore) {
-  IREE_ASSERT_ARGUMENT(shared_state);
+    uint64_t initial_value, iree_allocator_t host_allocator,
+    iree_hal_semaphore_t** out_semaphore) {
   IREE_ASSERT_ARGUMENT(out_semaphore);
   *out_semaphore = NULL;
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -77,7 +57,6 @@ iree_status_t iree_hal_sync_semaphore_create(
     iree_hal_semaphore_initialize(&iree_hal_sync_semaphore_vtable,
                                   &semaphore->base);
     semaphore->host_allocator = host_allocator;
-    semaphore->shared_state = shared_state;
 
     iree_slim_mutex_initialize(&semaphore->mutex);
     semaphore->current_value = initial_value;
@@ -160,15 +139,10 @@ static iree_status_t iree_hal_sync_semaphore_signal(
 
   iree_slim_mutex_unlock(&semaphore->mutex);
 
-  // Notify timepoints of the new value.
+  // Notify timepoints of the new value. Only waiters whose target value has
+  // been reached are woken.
   iree_hal_semaphore_notify(&semaphore->base, new_value, IREE_STATUS_OK);
 
-  // Post a global notification so that any waiter will wake.
-  // TODO(#4680): make notifications per-semaphore; would make multi-wait
-  // impossible with iree_notification_t and we'd have to use wait handles.
-  iree_notification_post(&semaphore->shared_state->notification,
-                         IREE_ALL_WAITERS);
-
   return iree_ok_status();
 }
 
@@ -198,15 +172,10 @@ static void iree_hal_sync_semaphore_fail(iree_hal_semaphore_t* base_semaphore,
   // Notify timepoints of the failure.
   iree_hal_semaphore_notify(&semaphore->base, IREE_HAL_SEMAPHORE_FAILURE_VALUE,
                             status_code);
-
-  iree_notification_post(&semaphore->shared_state->notification,
-                         IREE_ALL_WAITERS);
 }
 
 iree_status_t iree_hal_sync_semaphore_multi_signal(
-    iree_hal_sync_semaphore_state_t* shared_state,
     const iree_hal_semaphore_list_t semaphore_list) {
-  IREE_ASSERT_ARGUMENT(shared_state);
   if (semaphore_list.count == 0) {
     return iree_ok_status();
   } else if (semaphore_list.count == 1) {
@@ -236,79 +205,6 @@ iree_status_t iree_hal_sync_semaphore_multi_signal(
                               semaphore_list.payload_values[i], IREE_STATUS_OK);
   }
 
-  // Notify all waiters that we've updated semaphores. They'll wake and check
-  // to see if they are satisfied.
-  // NOTE: we do this even if there was a failure as we may have signaled some
-  // of the list.
-  iree_notification_post(&shared_state->notification, IREE_ALL_WAITERS);
-
-  return status;
-}
-
-typedef struct iree_hal_sync_semaphore_notify_state_t {
-  iree_hal_sync_semaphore_t* semaphore;
-  uint64_t value;
-} iree_hal_sync_semaphore_notify_state_t;
-
-static bool iree_hal_sync_semaphore_is_signaled(
-    iree_hal_sync_semaphore_notify_state_t* state) {
-  iree_hal_sync_semaphore_t* semaphore = state->semaphore;
-  iree_slim_mutex_lock(&semaphore->mutex);
-  bool is_signaled = semaphore->current_value >= state->value ||
-                     !iree_status_is_ok(semaphore->failure_status);
-  iree_slim_mutex_unlock(&semaphore->mutex);
-  return is_signaled;
-}
-
-static iree_status_t iree_hal_sync_semaphore_wait(
-    iree_hal_semaphore_t* base_semaphore, uint64_t value,
-    iree_timeout_t timeout, iree_hal_wait_flags_t flags) {
-  iree_hal_sync_semaphore_t* semaphore =
-      iree_hal_sync_semaphore_cast(base_semaphore);
-
-  // Try to see if we can return immediately.
-  iree_slim_mutex_lock(&semaphore->mutex);
-  if (!iree_status_is_ok(semaphore->failure_status)) {
-    // Fastest path: failed; return an error to tell callers to query for it.
-    iree_slim_mutex_unlock(&semaphore->mutex);
-    return iree_status_from_code(IREE_STATUS_ABORTED);
-  } else if (semaphore->current_value >= value) {
-    // Fast path: already satisfied.
-    iree_slim_mutex_unlock(&semaphore->mutex);
-    return iree_ok_status();
-  } else if (iree_timeout_is_immediate(timeout)) {
-    // Not satisfied but a poll, so can avoid the expensive wait handle work.
-    iree_slim_mutex_unlock(&semaphore->mutex);
-    return iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
-  }
-  iree_slim_mutex_unlock(&semaphore->mutex);
-
-  // TODO(#4680): we should be checking for DEADLINE_EXCEEDED here. This is
-  // easy when it's iree_timeout_is_infinite (we can just use the notification
-  // as below) but if it's an actual deadline we'll need to probably switch to
-  // iree_wait_handle_t.
-
-  // Perform wait on the global notification. Will wait forever.
-  iree_hal_sync_semaphore_state_t* shared_state = semaphore->shared_state;
-  iree_hal_sync_semaphore_notify_state_t notify_state = {
-      .semaphore = semaphore,
-      .value = value,
-  };
-  iree_notification_await(
-      &shared_state->notification,
-      (iree_condition_fn_t)iree_hal_sync_semaphore_is_signaled,
-      (void*)&notify_state, timeout);
-
-  iree_status_t status = iree_ok_status();
-  iree_slim_mutex_lock(&semaphore->mutex);
-  if (!iree_status_is_ok(semaphore->failure_status)) {
-    // Semaphore has failed.
-    status = iree_status_from_code(IREE_STATUS_ABORTED);
-  } else if (semaphore->current_value < value) {
-    // Deadline expired before the semaphore was signaled.
-    status = iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
-  }
-  iree_slim_mutex_unlock(&semaphore->mutex);
   return status;
 }
 
@@ -333,17 +229,20 @@ static bool iree_hal_sync_semaphore_any_signaled(
 // Used with with iree_condition_fn_t and must match that signature.
 static bool iree_hal_sync_semaphore_all_signaled(
     const iree_hal_semaphore_list_t* semaphore_list) {
+  bool all_signaled = true;
   for (iree_host_size_t i = 0; i < semaphore_list->count; ++i) {
     iree_hal_sync_semaphore_t* semaphore =
         iree_hal_sync_semaphore_cast(semaphore_list->semaphores[i]);
     iree_slim_mutex_lock(&semaphore->mutex);
+    bool is_failed = !iree_status_is_ok(semaphore->failure_status);
     bool is_signaled =
-        semaphore->current_value >= semaphore_list->payload_values[i] ||
-        !iree_status_is_ok(semaphore->failure_status);
+        semaphore->current_value >= semaphore_list->payload_values[i];
     iree_slim_mutex_unlock(&semaphore->mutex);
-    if (!is_signaled) return false;
+    // Any failure completes the wait even if earlier semaphores are pending.
+    if (is_failed) return true;
+    all_signaled = all_signaled && is_signaled;
   }
-  return true;
+  return all_signaled;
 }
 
 // Returns a status derived from the |semaphore_list| at the current time:
@@ -392,8 +291,124 @@ static iree_status_t iree_hal_sync_semaphore_result_from_state(
   }
 }
 
+// Maximum number of semaphores a wait list may have for its timepoints to be
+// stored on the stack. Larger lists allocate them from the host allocator so
+// that the stack use of a wait is bounded regardless of the list size.
+#define IREE_HAL_SYNC_SEMAPHORE_MAX_INLINE_TIMEPOINTS 8
+
+// A timepoint acquired by a waiter on one semaphore of its wait list.
+typedef struct iree_hal_sync_semaphore_timepoint_t {
+  iree_hal_semaphore_timepoint_t base;
+  // Semaphore the timepoint was acquired on. Unlike base.semaphore this is not
+  // cleared when the timepoint is issued so that the waiter can always cancel
+  // and synchronize with an in-flight callback.
+  iree_hal_semaphore_t* semaphore;
+} iree_hal_sync_semaphore_timepoint_t;
+
+// Wakes the waiter owning the notification in |user_data| when one of its
+// timepoints is reached or its semaphore fails. The waiter re-checks the actual
+// semaphore state and goes back to sleep if it is not yet satisfied.
+static iree_status_t iree_hal_sync_semaphore_timepoint_callback(
+    void* user_data, iree_hal_semaphore_t* semaphore, uint64_t value,
+    iree_status_code_t status_code) {
+  iree_notification_post((iree_notification_t*)user_data, IREE_ALL_WAITERS);
+  return iree_ok_status();
+}
+
+// Waits on |semaphore_list| until satisfied based on |wait_mode|, any
+// semaphore fails, or |deadline_ns| elapses.
+//
+// Each waiter has its own notification and registers a timepoint keyed by its
+// target value on every unsatisfied semaphore. Signals only resolve the
+// timepoints of the signaled semaphore whose target value has been reached and
+// so only wake the waiters that may now be satisfied instead of every waiter
+// on every semaphore of the device.
+static iree_status_t iree_hal_sync_semaphore_wait_list(
+    iree_hal_wait_mode_t wait_mode,
+    const iree_hal_semaphore_list_t semaphore_list, iree_time_t deadline_ns) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Timepoints of small lists (the common case) live on the stack.
+  iree_hal_sync_semaphore_timepoint_t
+      inline_timepoints[IREE_HAL_SYNC_SEMAPHORE_MAX_INLINE_TIMEPOINTS];
+  iree_hal_sync_semaphore_timepoint_t* timepoints = inline_timepoints;
+  iree_allocator_t host_allocator =
+      iree_hal_sync_semaphore_cast(semaphore_list.semaphores[0])
+          ->host_allocator;
+  if (semaphore_list.count > IREE_ARRAYSIZE(inline_timepoints)) {
+    IREE_RETURN_AND_END_ZONE_IF_ERROR(
+        z0, iree_allocator_malloc(host_allocator,
+                                  semaphore_list.count * sizeof(*timepoints),
+                                  (void**)&timepoints));
+  }
+
+  iree_notification_t notification;
+  iree_notification_initialize(&notification);
+
+  // Acquire timepoints for all unsatisfied semaphores. This happens under each
+  // semaphore lock so that a signal racing with the check is guaranteed to see
+  // the timepoint when it notifies after releasing the lock.
+  iree_host_size_t timepoint_count = 0;
+  bool needs_wait = true;
+  for (iree_host_size_t i = 0; i < semaphore_list.count && needs_wait; ++i) {
+    iree_hal_sync_semaphore_t* semaphore =
+        iree_hal_sync_semaphore_cast(semaphore_list.semaphores[i]);
+    iree_slim_mutex_lock(&semaphore->mutex);
+    if (!iree_status_is_ok(semaphore->failure_status)) {
+      // Failed; the wait will return ABORTED without blocking.
+      needs_wait = false;
+    } else if (semaphore->current_value >= semaphore_list.payload_values[i]) {
+      // Already satisfied; sufficient for ANY and nothing to wait on for ALL.
+      if (wait_mode == IREE_HAL_WAIT_MODE_ANY) needs_wait = false;
+    } else {
+      iree_hal_sync_semaphore_timepoint_t* timepoint =
+          &timepoints[timepoint_count++];
+      timepoint->semaphore = &semaphore->base;
+      iree_hal_semaphore_acquire_timepoint(
+          &semaphore->base, semaphore_list.payload_values[i],
+          iree_infinite_timeout(),
+          (iree_hal_semaphore_callback_t){
+              .fn = iree_hal_sync_semaphore_timepoint_callback,
+              .user_data = &notification,
+          },
+          &timepoint->base);
+    }
+    iree_slim_mutex_unlock(&semaphore->mutex);
+  }
+
+  // Sleep until woken by a timepoint and the list is satisfied. The condition
+  // checks the real semaphore state so that a semaphore signaled between our
+  // check and acquiring the timepoint on another semaphore is not missed.
+  if (needs_wait && timepoint_count > 0) {
+    iree_notification_await(
+        &notification,
+        wait_mode == IREE_HAL_WAIT_MODE_ALL
+            ? (iree_condition_fn_t)iree_hal_sync_semaphore_all_signaled
+            : (iree_condition_fn_t)iree_hal_sync_semaphore_any_signaled,
+        (void*)&semaphore_list, iree_make_deadline(deadline_ns));
+  }
+
+  // Cancel all timepoints, including those already issued, as cancellation
+  // takes the timepoint lock and ensures no callback is still using the
+  // notification when we deinitialize it.
+  for (iree_host_size_t i = 0; i < timepoint_count; ++i) {
+    iree_hal_semaphore_cancel_timepoint(timepoints[i].semaphore,
+                                        &timepoints[i].base);
+  }
+  iree_notification_deinitialize(&notification);
+  if (timepoints != inline_timepoints) {
+    iree_allocator_free(host_allocator, timepoints);
+  }
+
+  // We may have been successful - or may have a partial failure.
+  iree_status_t status =
+      iree_hal_sync_semaphore_result_from_state(wait_mode, semaphore_list);
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
 iree_status_t iree_hal_sync_semaphore_multi_wait(
-    iree_hal_sync_semaphore_state_t* shared_state,
     iree_hal_wait_mode_t wait_mode,
     const iree_hal_semaphore_list_t semaphore_list, iree_timeout_t timeout,
     iree_hal_wait_flags_t flags) {
@@ -406,30 +421,49 @@ iree_status_t iree_hal_sync_semaphore_multi_wait(
                                    flags);
   }
 
-  IREE_TRACE_ZONE_BEGIN(z0);
-
   // Fast-path for polling; we'll never wait and can just do a quick query.
   if (iree_timeout_is_immediate(timeout)) {
-    iree_status_t status =
-        iree_hal_sync_semaphore_result_from_state(wait_mode, semaphore_list);
-    IREE_TRACE_ZONE_END(z0);
-    return status;
+    return iree_hal_sync_semaphore_result_from_state(wait_mode,
+                                                     semaphore_list);
   }
 
-  // Perform wait on the global notification.
-  iree_notification_await(
-      &shared_state->notification,
-      wait_mode == IREE_HAL_WAIT_MODE_ALL
-          ? (iree_condition_fn_t)iree_hal_sync_semaphore_all_signaled
-          : (iree_condition_fn_t)iree_hal_sync_semaphore_any_signaled,
-      (void*)&semaphore_list, iree_infinite_timeout());
+  return iree_hal_sync_semaphore_wait_list(
+      wait_mode, semaphore_list, iree_timeout_as_deadline_ns(timeout));
+}
 
-  // We may have been successful - or may have a partial failure.
-  iree_status_t status =
-      iree_hal_sync_semaphore_result_from_state(wait_mode, semaphore_list);
+static iree_status_t iree_hal_sync_semaphore_wait(
+    iree_hal_semaphore_t* base_semaphore, uint64_t value,
+    iree_timeout_t timeout, iree_hal_wait_flags_t flags) {
+  iree_hal_sync_semaphore_t* semaphore =
+      iree_hal_sync_semaphore_cast(base_semaphore);
 
-  IREE_TRACE_ZONE_END(z0);
-  return status;
+  // Try to see if we can return immediately.
+  iree_slim_mutex_lock(&semaphore->mutex);
+  if (!iree_status_is_ok(semaphore->failure_status)) {
+    // Fastest path: failed; return an error to tell callers to query for it.
+    iree_slim_mutex_unlock(&semaphore->mutex);
+    return iree_status_from_code(IREE_STATUS_ABORTED);
+  } else if (semaphore->current_value >= value) {
+    // Fast path: already satisfied.
+    iree_slim_mutex_unlock(&semaphore->mutex);
+    return iree_ok_status();
+  } else if (iree_timeout_is_immediate(timeout)) {
+    // Not satisfied but a poll, so can avoid the expensive timepoint work.
+    iree_slim_mutex_unlock(&semaphore->mutex);
+    return iree_status_from_code(IREE_STATUS_DEADLINE_EXCEEDED);
+  }
+  iree_slim_mutex_unlock(&semaphore->mutex);
+
+  // Slow path: wait on a timepoint until signaled, failed, or the deadline is
+  // exceeded.
+  iree_hal_semaphore_list_t semaphore_list = {
+      .count = 1,
+      .semaphores = &base_semaphore,
+      .payload_values = &value,
+  };
+  return iree_hal_sync_semaphore_wait_list(
+      IREE_HAL_WAIT_MODE_ALL, semaphore_list,
+      iree_timeout_as_deadline_ns(timeout));
 }
 
 static iree_status_t iree_hal_sync_semaphore_import_timepoint(
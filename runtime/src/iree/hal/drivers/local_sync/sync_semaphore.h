@@ -17,53 +17,31 @@
 extern "C" {
 #endif  // __cplusplus
 
-//===----------------------------------------------------------------------===//
-// iree_hal_sync_semaphore_state_t
-//===----------------------------------------------------------------------===//
-
-// State shared between all sync semaphores.
-// Owned by the device and guaranteed to remain valid for the lifetime of any
-// semaphore created from it.
-typedef struct iree_hal_sync_semaphore_state_t {
-  // In-process notification signaled when any semaphore value changes.
-  iree_notification_t notification;
-} iree_hal_sync_semaphore_state_t;
-
-// Initializes state used to perform semaphore synchronization.
-void iree_hal_sync_semaphore_state_initialize(
-    iree_hal_sync_semaphore_state_t* out_shared_state);
-
-// Deinitializes state used to perform semaphore synchronization; no semaphores
-// must be live with references.
-void iree_hal_sync_semaphore_state_deinitialize(
-    iree_hal_sync_semaphore_state_t* shared_state);
-
 //===----------------------------------------------------------------------===//
 // iree_hal_sync_semaphore_t
 //===----------------------------------------------------------------------===//
 
 // Creates a semaphore that allows for ordering of operations on the local host.
-// Backed by a shared iree_notification_t in |shared_state|. Not efficient under
-// high contention or many simultaneous users but that's not what the
-// synchronous backend is intended for - if you want something efficient in the
-// face of hundreds or thousands of active asynchronous operations then use the
-// task system.
+// Waiters register timepoints on the semaphores they wait on and sleep on
+// their own iree_notification_t so that a signal only wakes the waiters whose
+// target values have been reached. This requires no OS wait handles and is
+// suitable for bare-metal systems. If you want something efficient in the face
+// of hundreds or thousands of active asynchronous operations then use the task
+// system.
 iree_status_t iree_hal_sync_semaphore_create(
-    iree_hal_sync_semaphore_state_t* shared_state, uint64_t initial_value,
-    iree_allocator_t host_allocator, iree_hal_semaphore_t** out_semaphore);
+    uint64_t initial_value, iree_allocator_t host_allocator,
+    iree_hal_semaphore_t** out_semaphore);
 
 // Performs a signal of a list of semaphores.
 // The semaphores will transition to their new values (nearly) atomically and
 // batching up signals will reduce synchronization overhead.
 iree_status_t iree_hal_sync_semaphore_multi_signal(
-    iree_hal_sync_semaphore_state_t* shared_state,
     const iree_hal_semaphore_list_t semaphore_list);
 
 // Performs a multi-wait on one or more semaphores.
 // Returns IREE_STATUS_DEADLINE_EXCEEDED if the wait does not complete before
 // |timeout| elapses.
 iree_status_t iree_hal_sync_semaphore_multi_wait(
-    iree_hal_sync_semaphore_state_t* shared_state,
     iree_hal_wait_mode_t wait_mode,
     const iree_hal_semaphore_list_t semaphore_list, iree_timeout_t timeout,
     iree_hal_wait_flags_t flags);
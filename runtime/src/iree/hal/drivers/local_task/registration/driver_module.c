@@ -73,12 +73,22 @@ static iree_status_t iree_hal_local_task_driver_factory_try_create(
         host_allocator);
   }
 
+  // Each executor services one queue; place buffers used by a queue on the
+  // NUMA node its workers run on (if known).
+  iree_hal_heap_allocator_options_t allocator_options;
+  iree_hal_heap_allocator_options_initialize(&allocator_options);
+  allocator_options.queue_node_count = executor_count;
+  for (iree_host_size_t i = 0; i < executor_count; ++i) {
+    allocator_options.queue_node_ids[i] =
+        iree_task_executor_node_id(executors[i]);
+  }
+
   // TODO(benvanik): allow this to be injected to share across drivers.
   iree_hal_allocator_t* device_allocator = NULL;
   if (iree_status_is_ok(status)) {
-    status = iree_hal_allocator_create_heap(iree_make_cstring_view("local"),
-                                            host_allocator, host_allocator,
-                                            &device_allocator);
+    status = iree_hal_allocator_create_heap_with_options(
+        iree_make_cstring_view("local"), &allocator_options, host_allocator,
+        host_allocator, &device_allocator);
   }
 
   // Create a task driver that will use the given executors for scheduling work
@@ -470,16 +470,41 @@ static iree_status_t iree_hal_task_command_buffer_advise_buffer(
 }
 
 //===----------------------------------------------------------------------===//
-// iree_hal_command_buffer_fill_buffer
+// Transfer tiling
 //===----------------------------------------------------------------------===//
-// NOTE: for large copies we dispatch this as tiles for parallelism.
-// We'd want to do some measurement for when it's worth it; filling a 200KB
-// buffer: maybe not, filling a 200MB buffer: yeah. For now we just do
-// arbitrarily sized chunks.
-
-// TODO(benvanik): make this a configurable setting. Must be aligned to pattern
-// length so pick a power of two.
+// NOTE: for large transfers we dispatch tiles for parallelism. Transfers up to
+// IREE_HAL_TASK_CMD_TRANSFER_PARALLEL_THRESHOLD bytes are run as a single tile
+// as fanning out a few hundred KB costs more in scheduling than the workers
+// win back. Users can override these with compiler defines.
+
+// Transfers of at most this many bytes are performed by a single tile.
+#if !defined(IREE_HAL_TASK_CMD_TRANSFER_PARALLEL_THRESHOLD)
+#define IREE_HAL_TASK_CMD_TRANSFER_PARALLEL_THRESHOLD (1 * 1024 * 1024)
+#endif  // !IREE_HAL_TASK_CMD_TRANSFER_PARALLEL_THRESHOLD
+
+// Length of each tile of large fills. Must be aligned to pattern length so
+// pick a power of two.
+#if !defined(IREE_HAL_TASK_CMD_FILL_SLICE_LENGTH)
 #define IREE_HAL_TASK_CMD_FILL_SLICE_LENGTH (128 * 1024)
+#endif  // !IREE_HAL_TASK_CMD_FILL_SLICE_LENGTH
+
+// Length of each tile of large copies.
+#if !defined(IREE_HAL_TASK_CMD_COPY_SLICE_LENGTH)
+#define IREE_HAL_TASK_CMD_COPY_SLICE_LENGTH (128 * 1024)
+#endif  // !IREE_HAL_TASK_CMD_COPY_SLICE_LENGTH
+
+// Returns the length of each tile used to transfer |length| bytes.
+static uint32_t iree_hal_task_cmd_transfer_slice_length(
+    iree_device_size_t length, uint32_t slice_length) {
+  if (length > IREE_HAL_TASK_CMD_TRANSFER_PARALLEL_THRESHOLD) {
+    return slice_length;
+  }
+  return (uint32_t)iree_max(length, 1);
+}
+
+//===----------------------------------------------------------------------===//
+// iree_hal_command_buffer_fill_buffer
+//===----------------------------------------------------------------------===//
 
 typedef struct iree_hal_task_cmd_fill_buffer_t {
   iree_task_dispatch_t task;
@@ -526,7 +551,8 @@ static iree_status_t iree_hal_task_command_buffer_fill_buffer(
       iree_arena_allocate(&command_buffer->arena, sizeof(*cmd), (void**)&cmd));
 
   const uint32_t workgroup_size[3] = {
-      /*x=*/IREE_HAL_TASK_CMD_FILL_SLICE_LENGTH,
+      /*x=*/iree_hal_task_cmd_transfer_slice_length(
+          target_ref.length, IREE_HAL_TASK_CMD_FILL_SLICE_LENGTH),
       /*y=*/1,
       /*z=*/1,
   };
@@ -602,14 +628,6 @@ static iree_status_t iree_hal_task_command_buffer_update_buffer(
 //===----------------------------------------------------------------------===//
 // iree_hal_command_buffer_copy_buffer
 //===----------------------------------------------------------------------===//
-// NOTE: for large copies we dispatch this as tiles for parallelism.
-// We'd want to do some measurement for when it's worth it; copying a 200KB
-// buffer: maybe not, copying a 200MB buffer: yeah. For now we just do
-// arbitrarily sized chunks.
-
-// TODO(benvanik): make this a configurable setting. Must be aligned to pattern
-// length so pick a power of two.
-#define IREE_HAL_TASK_CMD_COPY_SLICE_LENGTH (128 * 1024)
 
 typedef struct iree_hal_task_cmd_copy_buffer_t {
   iree_task_dispatch_t task;
@@ -660,7 +678,8 @@ static iree_status_t iree_hal_task_command_buffer_copy_buffer(
       iree_arena_allocate(&command_buffer->arena, sizeof(*cmd), (void**)&cmd));
 
   const uint32_t workgroup_size[3] = {
-      /*x=*/IREE_HAL_TASK_CMD_COPY_SLICE_LENGTH,
+      /*x=*/iree_hal_task_cmd_transfer_slice_length(
+          target_ref.length, IREE_HAL_TASK_CMD_COPY_SLICE_LENGTH),
       /*y=*/1,
       /*z=*/1,
   };
@@ -18,9 +18,11 @@
 #include "iree/hal/drivers/local_task/task_semaphore.h"
 #include "iree/hal/local/executable_environment.h"
 #include "iree/hal/local/local_executable_cache.h"
+#include "iree/hal/local/profiling.h"
 #include "iree/hal/utils/deferred_command_buffer.h"
 #include "iree/hal/utils/file_registry.h"
 #include "iree/hal/utils/file_transfer.h"
+#include "iree/hal/utils/object_pool.h"
 #include "iree/hal/utils/queue_emulation.h"
 
 typedef struct iree_hal_task_device_t {
@@ -34,6 +36,11 @@ typedef struct iree_hal_task_device_t {
   // buffers can contain inlined data uploads).
   iree_arena_block_pool_t large_block_pool;
 
+  // Pools recycling the storage of semaphores and command buffers as most
+  // invocations create and destroy a few of each.
+  iree_hal_object_pool_t* semaphore_pool;
+  iree_hal_object_pool_t* command_buffer_pool;
+
   iree_host_size_t loader_count;
   iree_hal_executable_loader_t** loaders;
 
@@ -43,6 +50,9 @@ typedef struct iree_hal_task_device_t {
   // Optional provider used for creating/configuring collective channels.
   iree_hal_channel_provider_t* channel_provider;
 
+  // Hardware counter profiler active between profiling_begin/end, if any.
+  iree_hal_local_profiler_t* profiler;
+
   iree_host_size_t queue_count;
   iree_hal_task_queue_t queues[];
 } iree_hal_task_device_t;
@@ -59,6 +69,8 @@ void iree_hal_task_device_params_initialize(
     iree_hal_task_device_params_t* out_params) {
   out_params->arena_block_size = 32 * 1024;
   out_params->queue_scope_flags = IREE_TASK_SCOPE_FLAG_NONE;
+  out_params->semaphore_pool_capacity = 64;
+  out_params->command_buffer_pool_capacity = 16;
 }
 
 static iree_status_t iree_hal_task_device_check_params(
@@ -142,6 +154,19 @@ iree_status_t iree_hal_task_device_create(
     }
   }
 
+  if (iree_status_is_ok(status)) {
+    status = iree_hal_object_pool_allocate(
+        params->semaphore_pool_capacity,
+        IREE_HAL_OBJECT_POOL_DEFAULT_MAX_OBJECT_SIZE, host_allocator,
+        &device->semaphore_pool);
+  }
+  if (iree_status_is_ok(status)) {
+    status = iree_hal_object_pool_allocate(
+        params->command_buffer_pool_capacity,
+        IREE_HAL_OBJECT_POOL_DEFAULT_MAX_OBJECT_SIZE, host_allocator,
+        &device->command_buffer_pool);
+  }
+
   if (iree_status_is_ok(status)) {
     *out_device = (iree_hal_device_t*)device;
   } else {
@@ -164,9 +189,17 @@ static void iree_hal_task_device_destroy(iree_hal_device_t* base_device) {
     iree_hal_executable_loader_release(device->loaders[i]);
   }
 
+  // Profiling should have been ended by the user but if not we end it here
+  // and drop the (unreportable) flush errors.
+  iree_status_ignore(iree_hal_local_profiler_end(device->profiler));
+
   iree_hal_allocator_release(device->device_allocator);
   iree_hal_channel_provider_release(device->channel_provider);
 
+  // Objects still live keep their pools alive until they are destroyed.
+  iree_hal_object_pool_release(device->command_buffer_pool);
+  iree_hal_object_pool_release(device->semaphore_pool);
+
   iree_arena_block_pool_deinitialize(&device->large_block_pool);
   iree_arena_block_pool_deinitialize(&device->small_block_pool);
 
@@ -219,6 +252,8 @@ static iree_status_t iree_hal_task_device_trim(iree_hal_device_t* base_device) {
   }
   IREE_RETURN_IF_ERROR(iree_hal_allocator_trim(device->device_allocator));
 
+  iree_hal_object_pool_trim(device->semaphore_pool);
+  iree_hal_object_pool_trim(device->command_buffer_pool);
   iree_arena_block_pool_trim(&device->small_block_pool);
   iree_arena_block_pool_trim(&device->large_block_pool);
 
@@ -261,6 +296,14 @@ static iree_status_t iree_hal_task_device_query_i64(
     }
   } else if (iree_string_view_equal(category, IREE_SV("hal.cpu"))) {
     return iree_cpu_lookup_data_by_key(key, out_value);
+  } else if (iree_string_view_equal(category,
+                                    IREE_SV("hal.device.semaphore_pool"))) {
+    return iree_hal_object_pool_query_i64(device->semaphore_pool, key,
+                                          out_value);
+  } else if (iree_string_view_equal(
+                 category, IREE_SV("hal.device.command_buffer_pool"))) {
+    return iree_hal_object_pool_query_i64(device->command_buffer_pool, key,
+                                          out_value);
   }
 
   return iree_make_status(
@@ -306,7 +349,8 @@ static iree_status_t iree_hal_task_device_create_command_buffer(
     return iree_hal_deferred_command_buffer_create(
         iree_hal_device_allocator(base_device), mode, command_categories,
         queue_affinity, binding_capacity, &device->large_block_pool,
-        device->host_allocator, out_command_buffer);
+        iree_hal_object_pool_allocator(device->command_buffer_pool),
+        out_command_buffer);
   } else {
     iree_host_size_t queue_index = iree_hal_task_device_select_queue(
         device, command_categories, queue_affinity);
@@ -314,7 +358,8 @@ static iree_status_t iree_hal_task_device_create_command_buffer(
         iree_hal_device_allocator(base_device),
         &device->queues[queue_index].scope, mode, command_categories,
         queue_affinity, binding_capacity, &device->large_block_pool,
-        device->host_allocator, out_command_buffer);
+        iree_hal_object_pool_allocator(device->command_buffer_pool),
+        out_command_buffer);
   }
 }
 
@@ -360,7 +405,7 @@ static iree_status_t iree_hal_task_device_create_semaphore(
   iree_hal_task_device_t* device = iree_hal_task_device_cast(base_device);
   return iree_hal_task_semaphore_create(
       iree_hal_task_device_shared_event_pool(device), initial_value,
-      device->host_allocator, out_semaphore);
+      iree_hal_object_pool_allocator(device->semaphore_pool), out_semaphore);
 }
 
 static iree_hal_semaphore_compatibility_t
@@ -511,27 +556,30 @@ static iree_status_t iree_hal_task_device_wait_semaphores(
 static iree_status_t iree_hal_task_device_profiling_begin(
     iree_hal_device_t* base_device,
     const iree_hal_device_profiling_options_t* options) {
-  // Unimplemented (and that's ok).
-  // We could hook in to vendor APIs (Intel/ARM/etc) or generic perf infra:
-  // https://man7.org/linux/man-pages/man2/perf_event_open.2.html
-  // Capturing things like:
-  //   PERF_COUNT_HW_CPU_CYCLES / PERF_COUNT_HW_INSTRUCTIONS
-  //   PERF_COUNT_HW_CACHE_REFERENCES / PERF_COUNT_HW_CACHE_MISSES
-  //   etc
-  // TODO(benvanik): shared iree/hal/local/profiling implementation of this.
-  return iree_ok_status();
+  iree_hal_task_device_t* device = iree_hal_task_device_cast(base_device);
+  if (device->profiler) {
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "profiling already active on the device");
+  }
+  // Only the hardware counter modes are implemented; the others are a no-op
+  // (and that's ok) as tracing already covers queue and dispatch timing.
+  return iree_hal_local_profiler_begin(options, device->host_allocator,
+                                       &device->profiler);
 }
 
 static iree_status_t iree_hal_task_device_profiling_flush(
     iree_hal_device_t* base_device) {
-  // Unimplemented (and that's ok).
-  return iree_ok_status();
+  iree_hal_task_device_t* device = iree_hal_task_device_cast(base_device);
+  if (!device->profiler) return iree_ok_status();
+  return iree_hal_local_profiler_flush(device->profiler);
 }
 
 static iree_status_t iree_hal_task_device_profiling_end(
     iree_hal_device_t* base_device) {
-  // Unimplemented (and that's ok).
-  return iree_ok_status();
+  iree_hal_task_device_t* device = iree_hal_task_device_cast(base_device);
+  iree_hal_local_profiler_t* profiler = device->profiler;
+  device->profiler = NULL;
+  return iree_hal_local_profiler_end(profiler);
 }
 
 static const iree_hal_device_vtable_t iree_hal_task_device_vtable = {
@@ -25,6 +25,15 @@ typedef struct iree_hal_task_device_params_t {
   iree_host_size_t arena_block_size;
   // Default flags for the iree_task_scope_t used for each queue.
   iree_task_scope_flags_t queue_scope_flags;
+
+  // Maximum number of destroyed semaphores whose storage is retained by the
+  // device and reused by new semaphores. 0 allocates every semaphore from the
+  // host allocator.
+  iree_host_size_t semaphore_pool_capacity;
+  // Maximum number of destroyed command buffers whose storage is retained by
+  // the device and reused by new command buffers. 0 allocates every command
+  // buffer from the host allocator.
+  iree_host_size_t command_buffer_pool_capacity;
 } iree_hal_task_device_params_t;
 
 // Initializes |out_params| to default values.
@@ -0,0 +1,287 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/local/dispatch_capture.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "iree/base/internal/synchronization.h"
+
+iree_atomic_intptr_t iree_hal_local_dispatch_capture_active_ =
+    IREE_ATOMIC_VAR_INIT(0);
+
+//===----------------------------------------------------------------------===//
+// Capture file format
+//===----------------------------------------------------------------------===//
+
+// Writes |length| bytes of |data| followed by zeros up to |alignment|.
+static bool iree_hal_local_dispatch_capture_fwrite_padded(
+    FILE* file, const void* data, iree_host_size_t length,
+    iree_host_size_t alignment) {
+  static const uint8_t padding[16] = {0};
+  iree_host_size_t padding_length =
+      iree_host_align(length, alignment) - length;
+  return fwrite(data, 1, length, file) == length &&
+         fwrite(padding, 1, padding_length, file) == padding_length;
+}
+
+IREE_API_EXPORT iree_status_t iree_hal_local_dispatch_capture_file_write(
+    const char* path, iree_string_view_t export_name, uint32_t export_ordinal,
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state) {
+  IREE_ASSERT_ARGUMENT(path);
+  IREE_ASSERT_ARGUMENT(dispatch_state);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  FILE* file = fopen(path, "wb");
+  if (!file) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(iree_status_code_from_errno(errno),
+                            "failed to open dispatch capture file '%s'", path);
+  }
+
+  iree_hal_local_dispatch_capture_file_header_t header = {
+      .magic = IREE_HAL_LOCAL_DISPATCH_CAPTURE_FILE_MAGIC,
+      .version = IREE_HAL_LOCAL_DISPATCH_CAPTURE_FILE_VERSION_0,
+      .export_ordinal = export_ordinal,
+      .name_length = (uint32_t)export_name.size,
+      .workgroup_count =
+          {
+              dispatch_state->workgroup_count_x,
+              dispatch_state->workgroup_count_y,
+              dispatch_state->workgroup_count_z,
+          },
+      .workgroup_size =
+          {
+              dispatch_state->workgroup_size_x,
+              dispatch_state->workgroup_size_y,
+              dispatch_state->workgroup_size_z,
+          },
+      .constant_count = dispatch_state->constant_count,
+      .binding_count = dispatch_state->binding_count,
+  };
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+            iree_hal_local_dispatch_capture_fwrite_padded(
+                file, export_name.data, export_name.size, 8) &&
+            iree_hal_local_dispatch_capture_fwrite_padded(
+                file, dispatch_state->constants,
+                dispatch_state->constant_count * sizeof(uint32_t), 8);
+  for (uint32_t i = 0; ok && i < dispatch_state->binding_count; ++i) {
+    iree_hal_local_dispatch_capture_file_binding_t binding = {
+        .length = dispatch_state->binding_lengths[i],
+    };
+    ok = fwrite(&binding, sizeof(binding), 1, file) == 1 &&
+         iree_hal_local_dispatch_capture_fwrite_padded(
+             file, dispatch_state->binding_ptrs[i],
+             dispatch_state->binding_lengths[i], 16);
+  }
+
+  ok = fclose(file) == 0 && ok;
+  IREE_TRACE_ZONE_END(z0);
+  return ok ? iree_ok_status()
+            : iree_make_status(IREE_STATUS_DATA_LOSS,
+                               "failed to write dispatch capture file '%s'",
+                               path);
+}
+
+IREE_API_EXPORT iree_status_t iree_hal_local_dispatch_capture_file_parse(
+    iree_const_byte_span_t contents,
+    iree_hal_local_dispatch_capture_file_t* out_file) {
+  IREE_ASSERT_ARGUMENT(out_file);
+  memset(out_file, 0, sizeof(*out_file));
+
+  const iree_hal_local_dispatch_capture_file_header_t* header =
+      (const iree_hal_local_dispatch_capture_file_header_t*)contents.data;
+  if (contents.data_length < sizeof(*header) ||
+      header->magic != IREE_HAL_LOCAL_DISPATCH_CAPTURE_FILE_MAGIC) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "not a dispatch capture file");
+  }
+  if (header->version != IREE_HAL_LOCAL_DISPATCH_CAPTURE_FILE_VERSION_0) {
+    return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                            "unsupported dispatch capture file version %u",
+                            header->version);
+  }
+  if (header->binding_count > IREE_ARRAYSIZE(out_file->bindings)) {
+    return iree_make_status(
+        IREE_STATUS_OUT_OF_RANGE,
+        "dispatch capture has %u bindings but at most %" PRIhsz
+        " are supported",
+        header->binding_count, IREE_ARRAYSIZE(out_file->bindings));
+  }
+
+  out_file->export_ordinal = header->export_ordinal;
+  memcpy(out_file->workgroup_count, header->workgroup_count,
+         sizeof(out_file->workgroup_count));
+  memcpy(out_file->workgroup_size, header->workgroup_size,
+         sizeof(out_file->workgroup_size));
+
+  // Each section is bounds checked before it is referenced.
+  iree_host_size_t offset = sizeof(*header);
+  iree_host_size_t name_length = iree_host_align(header->name_length, 8);
+  iree_host_size_t constants_length =
+      iree_host_align(header->constant_count * sizeof(uint32_t), 8);
+  if (offset + name_length + constants_length > contents.data_length) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "dispatch capture file is truncated");
+  }
+  out_file->export_name = iree_make_string_view(
+      (const char*)contents.data + offset, header->name_length);
+  offset += name_length;
+  out_file->constant_count = header->constant_count;
+  out_file->constants = (const uint32_t*)(contents.data + offset);
+  offset += constants_length;
+
+  out_file->binding_count = header->binding_count;
+  for (uint32_t i = 0; i < header->binding_count; ++i) {
+    const iree_hal_local_dispatch_capture_file_binding_t* binding =
+        (const iree_hal_local_dispatch_capture_file_binding_t*)(contents.data +
+                                                                 offset);
+    if (offset + sizeof(*binding) > contents.data_length ||
+        binding->length > contents.data_length - offset - sizeof(*binding)) {
+      return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                              "dispatch capture file is truncated");
+    }
+    offset += sizeof(*binding);
+    out_file->bindings[i] = iree_make_const_byte_span(
+        contents.data + offset, (iree_host_size_t)binding->length);
+    offset += iree_host_align((iree_host_size_t)binding->length, 16);
+  }
+
+  return iree_ok_status();
+}
+
+//===----------------------------------------------------------------------===//
+// iree_hal_local_dispatch_capture_t
+//===----------------------------------------------------------------------===//
+
+struct iree_hal_local_dispatch_capture_t {
+  iree_allocator_t host_allocator;
+  iree_string_view_t export_name;
+  uint32_t occurrence;
+  char* file_path;
+
+  // Guards the occurrence count and capture status as dispatches of the
+  // export may be issued concurrently by multiple devices.
+  iree_slim_mutex_t mutex;
+  // Number of matching dispatches seen so far.
+  uint32_t seen_count;
+  // Set once the requested dispatch has been written.
+  bool captured;
+  // Result of writing the capture file.
+  iree_status_t status;
+};
+
+IREE_API_EXPORT iree_status_t iree_hal_local_dispatch_capture_begin(
+    iree_string_view_t export_name, uint32_t occurrence, const char* file_path,
+    iree_allocator_t host_allocator,
+    iree_hal_local_dispatch_capture_t** out_capture) {
+  IREE_ASSERT_ARGUMENT(out_capture);
+  *out_capture = NULL;
+  if (iree_string_view_is_empty(export_name)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "an export name is required to capture a dispatch");
+  }
+  if (!file_path || !strlen(file_path)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "a file path is required to capture a dispatch");
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_hal_local_dispatch_capture_t* capture = NULL;
+  iree_host_size_t file_path_length = strlen(file_path);
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(
+              host_allocator,
+              sizeof(*capture) + export_name.size + file_path_length + 1,
+              (void**)&capture));
+  memset(capture, 0, sizeof(*capture));
+  capture->host_allocator = host_allocator;
+  char* export_name_storage = (char*)capture + sizeof(*capture);
+  memcpy(export_name_storage, export_name.data, export_name.size);
+  capture->export_name =
+      iree_make_string_view(export_name_storage, export_name.size);
+  capture->occurrence = occurrence;
+  capture->file_path = export_name_storage + export_name.size;
+  memcpy(capture->file_path, file_path, file_path_length + 1);
+  iree_slim_mutex_initialize(&capture->mutex);
+  capture->status = iree_ok_status();
+
+  intptr_t expected = 0;
+  if (!iree_atomic_compare_exchange_strong(
+          &iree_hal_local_dispatch_capture_active_, &expected,
+          (intptr_t)capture, iree_memory_order_acq_rel,
+          iree_memory_order_relaxed)) {
+    iree_slim_mutex_deinitialize(&capture->mutex);
+    iree_allocator_free(host_allocator, capture);
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "another dispatch capture is already active in "
+                            "this process");
+  }
+
+  *out_capture = capture;
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT iree_status_t iree_hal_local_dispatch_capture_end(
+    iree_hal_local_dispatch_capture_t* capture) {
+  if (!capture) return iree_ok_status();
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // The active pointer may already have been cleared after capturing.
+  intptr_t expected = (intptr_t)capture;
+  iree_atomic_compare_exchange_strong(&iree_hal_local_dispatch_capture_active_,
+                                      &expected, 0, iree_memory_order_acq_rel,
+                                      iree_memory_order_relaxed);
+
+  iree_status_t status = capture->status;
+  if (iree_status_is_ok(status) && !capture->captured) {
+    status = iree_make_status(
+        IREE_STATUS_NOT_FOUND,
+        "dispatch %u of export '%.*s' was not issued (%u matching dispatches "
+        "seen); only local CPU devices support dispatch capture",
+        capture->occurrence, (int)capture->export_name.size,
+        capture->export_name.data, capture->seen_count);
+  }
+
+  iree_slim_mutex_deinitialize(&capture->mutex);
+  iree_allocator_free(capture->host_allocator, capture);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+void iree_hal_local_dispatch_capture_record(
+    iree_hal_local_dispatch_capture_t* capture,
+    iree_hal_executable_t* executable, iree_host_size_t ordinal,
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state) {
+  iree_hal_executable_export_info_t info;
+  iree_status_t status = iree_hal_executable_export_info(
+      executable, (iree_hal_executable_export_ordinal_t)ordinal, &info);
+  if (!iree_status_is_ok(status)) {
+    iree_status_ignore(status);
+    return;
+  }
+  if (!iree_string_view_equal(info.name, capture->export_name)) return;
+
+  iree_slim_mutex_lock(&capture->mutex);
+  if (!capture->captured && capture->seen_count++ == capture->occurrence) {
+    IREE_TRACE_ZONE_BEGIN(z0);
+    capture->status = iree_hal_local_dispatch_capture_file_write(
+        capture->file_path, info.name, (uint32_t)ordinal, dispatch_state);
+    capture->captured = true;
+    IREE_TRACE_ZONE_END(z0);
+
+    // Nothing left to capture so let the dispatch path skip us.
+    intptr_t expected = (intptr_t)capture;
+    iree_atomic_compare_exchange_strong(
+        &iree_hal_local_dispatch_capture_active_, &expected, 0,
+        iree_memory_order_acq_rel, iree_memory_order_relaxed);
+  }
+  iree_slim_mutex_unlock(&capture->mutex);
+}
@@ -0,0 +1,129 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_HAL_LOCAL_DISPATCH_CAPTURE_H_
+#define IREE_HAL_LOCAL_DISPATCH_CAPTURE_H_
+
+#include "iree/base/api.h"
+#include "iree/base/internal/atomics.h"
+#include "iree/hal/api.h"
+#include "iree/hal/local/executable_library.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+//===----------------------------------------------------------------------===//
+// Capture file format
+//===----------------------------------------------------------------------===//
+
+#define IREE_HAL_LOCAL_DISPATCH_CAPTURE_FILE_MAGIC 0x43444C49u  // 'ILDC'
+#define IREE_HAL_LOCAL_DISPATCH_CAPTURE_FILE_VERSION_0 0u
+
+// Header at the start of a capture file. Followed by:
+//   - |name_length| bytes of the export name padded with zeros to 8 bytes
+//   - |constant_count| uint32_t constants padded with zeros to 8 bytes
+//   - |binding_count| binding records each followed by its contents padded
+//     with zeros to 16 bytes
+// All values are in host byte order.
+typedef struct iree_hal_local_dispatch_capture_file_header_t {
+  uint32_t magic;
+  uint32_t version;
+  // Ordinal of the export in the executable that was captured. Replay should
+  // prefer looking up the export by name as ordinals may differ between
+  // variants of the executable.
+  uint32_t export_ordinal;
+  uint32_t name_length;
+  uint32_t workgroup_count[3];
+  uint32_t workgroup_size[3];
+  uint32_t constant_count;
+  uint32_t binding_count;
+} iree_hal_local_dispatch_capture_file_header_t;
+
+// Binding record header.
+typedef struct iree_hal_local_dispatch_capture_file_binding_t {
+  // Length of the binding contents in bytes.
+  uint64_t length;
+} iree_hal_local_dispatch_capture_file_binding_t;
+
+// A parsed capture file referencing the file contents it was parsed from.
+typedef struct iree_hal_local_dispatch_capture_file_t {
+  iree_string_view_t export_name;
+  uint32_t export_ordinal;
+  uint32_t workgroup_count[3];
+  uint32_t workgroup_size[3];
+  uint32_t constant_count;
+  const uint32_t* constants;
+  uint32_t binding_count;
+  iree_const_byte_span_t bindings[IREE_HAL_EXECUTABLE_MAX_BINDING_COUNT];
+} iree_hal_local_dispatch_capture_file_t;
+
+// Writes the parameters and binding contents of a dispatch of export
+// |export_ordinal| named |export_name| described by |dispatch_state| to the
+// file at |path|.
+IREE_API_EXPORT iree_status_t iree_hal_local_dispatch_capture_file_write(
+    const char* path, iree_string_view_t export_name, uint32_t export_ordinal,
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state);
+
+// Parses a capture file from |contents| into |out_file|. The parsed file
+// references |contents| which must remain valid for as long as it is used.
+IREE_API_EXPORT iree_status_t iree_hal_local_dispatch_capture_file_parse(
+    iree_const_byte_span_t contents,
+    iree_hal_local_dispatch_capture_file_t* out_file);
+
+//===----------------------------------------------------------------------===//
+// iree_hal_local_dispatch_capture_t
+//===----------------------------------------------------------------------===//
+
+// Snapshots the parameters and binding contents of a single dispatch issued
+// through iree_hal_local_executable_issue_call into a capture file that
+// `iree-benchmark-executable --dispatch_capture=` can replay standalone.
+//
+// Bindings are captured immediately before the first workgroup of the dispatch
+// executes. When other workgroups of the same dispatch can run concurrently
+// (such as with local-task) outputs aliasing inputs may be partially written;
+// use local-sync for exact captures of in-place dispatches.
+//
+// Executables do not know which device issued them so at most one capture can
+// be active in the process at a time.
+typedef struct iree_hal_local_dispatch_capture_t
+    iree_hal_local_dispatch_capture_t;
+
+// Begins capturing the |occurrence|th (0-based) dispatch of any export named
+// |export_name| to the file at |file_path|.
+IREE_API_EXPORT iree_status_t iree_hal_local_dispatch_capture_begin(
+    iree_string_view_t export_name, uint32_t occurrence, const char* file_path,
+    iree_allocator_t host_allocator,
+    iree_hal_local_dispatch_capture_t** out_capture);
+
+// Ends capturing and frees |capture|. Returns an error if the requested
+// dispatch was never issued or the capture file could not be written.
+IREE_API_EXPORT iree_status_t iree_hal_local_dispatch_capture_end(
+    iree_hal_local_dispatch_capture_t* capture);
+
+// The active capture, if any. Checked by the dispatch path on every call so
+// that capturing costs a single relaxed load when disabled.
+extern iree_atomic_intptr_t iree_hal_local_dispatch_capture_active_;
+
+static inline iree_hal_local_dispatch_capture_t*
+iree_hal_local_dispatch_capture_active(void) {
+  return (iree_hal_local_dispatch_capture_t*)iree_atomic_load(
+      &iree_hal_local_dispatch_capture_active_, iree_memory_order_relaxed);
+}
+
+// Captures the dispatch of export |ordinal| of |executable| described by
+// |dispatch_state| if it is the one requested. Must be called once per
+// dispatch before its first workgroup (0,0,0) executes.
+void iree_hal_local_dispatch_capture_record(
+    iree_hal_local_dispatch_capture_t* capture,
+    iree_hal_executable_t* executable, iree_host_size_t ordinal,
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_HAL_LOCAL_DISPATCH_CAPTURE_H_
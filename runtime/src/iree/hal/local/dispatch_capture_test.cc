@@ -0,0 +1,129 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/local/dispatch_capture.h"
+
+#include <cstring>
+#include <vector>
+
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace iree {
+namespace {
+
+using ::iree::testing::status::StatusIs;
+
+// Appends |length| bytes of |data| to |file| padded with zeros to |alignment|.
+static void AppendPadded(std::vector<uint8_t>& file, const void* data,
+                         size_t length, size_t alignment) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  file.insert(file.end(), bytes, bytes + length);
+  file.insert(file.end(), iree_host_align(length, alignment) - length, 0);
+}
+
+// Appends a binding record with |length| bytes of |data| to |file|.
+static void AppendBinding(std::vector<uint8_t>& file, const void* data,
+                          size_t length) {
+  iree_hal_local_dispatch_capture_file_binding_t binding = {};
+  binding.length = length;
+  AppendPadded(file, &binding, sizeof(binding), 8);
+  AppendPadded(file, data, length, 16);
+}
+
+// Builds a capture file of export `dispatch_0` with two constants and two
+// bindings.
+static std::vector<uint8_t> MakeCaptureFile() {
+  std::vector<uint8_t> file;
+  const char name[] = "dispatch_0";
+  iree_hal_local_dispatch_capture_file_header_t header = {};
+  header.magic = IREE_HAL_LOCAL_DISPATCH_CAPTURE_FILE_MAGIC;
+  header.version = IREE_HAL_LOCAL_DISPATCH_CAPTURE_FILE_VERSION_0;
+  header.export_ordinal = 3;
+  header.name_length = sizeof(name) - 1;
+  header.workgroup_count[0] = 4;
+  header.workgroup_count[1] = 2;
+  header.workgroup_count[2] = 1;
+  header.workgroup_size[0] = 64;
+  header.workgroup_size[1] = 1;
+  header.workgroup_size[2] = 1;
+  header.constant_count = 2;
+  header.binding_count = 2;
+  AppendPadded(file, &header, sizeof(header), 8);
+  AppendPadded(file, name, header.name_length, 8);
+  const uint32_t constants[2] = {7, 9};
+  AppendPadded(file, constants, sizeof(constants), 8);
+  const float input[3] = {1.0f, 2.0f, 3.0f};
+  const uint8_t output[20] = {0};
+  AppendBinding(file, input, sizeof(input));
+  AppendBinding(file, output, sizeof(output));
+  return file;
+}
+
+TEST(DispatchCaptureFileTest, Parse) {
+  std::vector<uint8_t> contents = MakeCaptureFile();
+  iree_hal_local_dispatch_capture_file_t file;
+  IREE_ASSERT_OK(iree_hal_local_dispatch_capture_file_parse(
+      iree_make_const_byte_span(contents.data(), contents.size()), &file));
+  EXPECT_TRUE(iree_string_view_equal(file.export_name, IREE_SV("dispatch_0")));
+  EXPECT_EQ(file.export_ordinal, 3u);
+  EXPECT_EQ(file.workgroup_count[0], 4u);
+  EXPECT_EQ(file.workgroup_count[1], 2u);
+  EXPECT_EQ(file.workgroup_count[2], 1u);
+  EXPECT_EQ(file.workgroup_size[0], 64u);
+  ASSERT_EQ(file.constant_count, 2u);
+  EXPECT_EQ(file.constants[0], 7u);
+  EXPECT_EQ(file.constants[1], 9u);
+  ASSERT_EQ(file.binding_count, 2u);
+  ASSERT_EQ(file.bindings[0].data_length, 3 * sizeof(float));
+  float input[3];
+  std::memcpy(input, file.bindings[0].data, sizeof(input));
+  EXPECT_EQ(input[2], 3.0f);
+  EXPECT_EQ(file.bindings[1].data_length, 20u);
+}
+
+TEST(DispatchCaptureFileTest, InvalidMagic) {
+  std::vector<uint8_t> contents = MakeCaptureFile();
+  contents[0] ^= 0xFF;
+  iree_hal_local_dispatch_capture_file_t file;
+  EXPECT_THAT(Status(iree_hal_local_dispatch_capture_file_parse(
+                  iree_make_const_byte_span(contents.data(), contents.size()),
+                  &file)),
+              StatusIs(StatusCode::kInvalidArgument));
+}
+
+TEST(DispatchCaptureFileTest, Truncated) {
+  std::vector<uint8_t> contents = MakeCaptureFile();
+  // Drop the end of the last binding contents.
+  contents.resize(contents.size() - 24);
+  iree_hal_local_dispatch_capture_file_t file;
+  EXPECT_THAT(Status(iree_hal_local_dispatch_capture_file_parse(
+                  iree_make_const_byte_span(contents.data(), contents.size()),
+                  &file)),
+              StatusIs(StatusCode::kOutOfRange));
+}
+
+TEST(DispatchCaptureTest, EndWithoutDispatchIsNotFound) {
+  iree_hal_local_dispatch_capture_t* capture = NULL;
+  IREE_ASSERT_OK(iree_hal_local_dispatch_capture_begin(
+      IREE_SV("dispatch_0"), /*occurrence=*/0, "unused.bin",
+      iree_allocator_system(), &capture));
+  EXPECT_EQ(iree_hal_local_dispatch_capture_active(), capture);
+
+  // Only one capture may be active at a time.
+  iree_hal_local_dispatch_capture_t* other_capture = NULL;
+  EXPECT_THAT(Status(iree_hal_local_dispatch_capture_begin(
+                  IREE_SV("dispatch_1"), /*occurrence=*/0, "unused.bin",
+                  iree_allocator_system(), &other_capture)),
+              StatusIs(StatusCode::kFailedPrecondition));
+
+  EXPECT_THAT(Status(iree_hal_local_dispatch_capture_end(capture)),
+              StatusIs(StatusCode::kNotFound));
+  EXPECT_EQ(iree_hal_local_dispatch_capture_active(), nullptr);
+}
+
+}  // namespace
+}  // namespace iree
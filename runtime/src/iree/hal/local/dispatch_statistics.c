@@ -0,0 +1,237 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/local/dispatch_statistics.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "iree/base/internal/synchronization.h"
+#include "iree/hal/local/export_table.h"
+
+iree_atomic_intptr_t iree_hal_local_dispatch_statistics_active_ =
+    IREE_ATOMIC_VAR_INIT(0);
+
+// Incremented on each begin so that threads notice that their cached entry
+// belongs to a prior (possibly freed) collector.
+static iree_atomic_int32_t iree_hal_local_dispatch_statistics_generation_ =
+    IREE_ATOMIC_VAR_INIT(0);
+
+typedef struct iree_hal_local_dispatch_statistics_entry_t {
+  iree_hal_local_export_entry_t base;
+  // Summed across all workers without holding the mutex.
+  iree_atomic_int64_t time_ns;
+  // Updated once per dispatch with the mutex held.
+  uint64_t dispatch_count;
+  uint64_t workgroup_count;
+  uint64_t bytes_bound;
+  uint32_t last_workgroup_count[3];
+  bool workgroup_count_varies;
+} iree_hal_local_dispatch_statistics_entry_t;
+
+// The entry last recorded into by the calling thread.
+static iree_hal_local_thread_local iree_hal_local_export_cache_t
+    iree_hal_local_dispatch_statistics_cache_;
+
+struct iree_hal_local_dispatch_statistics_t {
+  iree_allocator_t host_allocator;
+  int32_t generation;
+
+  iree_slim_mutex_t mutex;
+  // iree_hal_local_dispatch_statistics_entry_t records guarded by the mutex.
+  iree_hal_local_export_table_t table;
+};
+
+IREE_API_EXPORT iree_status_t iree_hal_local_dispatch_statistics_allocate(
+    iree_allocator_t host_allocator,
+    iree_hal_local_dispatch_statistics_t** out_statistics) {
+  IREE_ASSERT_ARGUMENT(out_statistics);
+  *out_statistics = NULL;
+  iree_hal_local_dispatch_statistics_t* statistics = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      host_allocator, sizeof(*statistics), (void**)&statistics));
+  memset(statistics, 0, sizeof(*statistics));
+  statistics->host_allocator = host_allocator;
+  iree_slim_mutex_initialize(&statistics->mutex);
+  iree_hal_local_export_table_initialize(
+      sizeof(iree_hal_local_dispatch_statistics_entry_t), host_allocator,
+      &statistics->table);
+  *out_statistics = statistics;
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT void iree_hal_local_dispatch_statistics_free(
+    iree_hal_local_dispatch_statistics_t* statistics) {
+  if (!statistics) return;
+  iree_hal_local_dispatch_statistics_end(statistics);
+  iree_hal_local_export_table_deinitialize(&statistics->table);
+  iree_slim_mutex_deinitialize(&statistics->mutex);
+  iree_allocator_free(statistics->host_allocator, statistics);
+}
+
+IREE_API_EXPORT iree_status_t iree_hal_local_dispatch_statistics_begin(
+    iree_hal_local_dispatch_statistics_t* statistics) {
+  IREE_ASSERT_ARGUMENT(statistics);
+  if (iree_hal_local_dispatch_statistics_active() == statistics) {
+    return iree_ok_status();
+  }
+  // Bump the generation before publishing so no thread can match a cache entry
+  // from a prior collector.
+  statistics->generation =
+      iree_atomic_fetch_add(&iree_hal_local_dispatch_statistics_generation_, 1,
+                            iree_memory_order_relaxed) +
+      1;
+  intptr_t expected = 0;
+  if (!iree_atomic_compare_exchange_strong(
+          &iree_hal_local_dispatch_statistics_active_, &expected,
+          (intptr_t)statistics, iree_memory_order_acq_rel,
+          iree_memory_order_relaxed)) {
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "another device is already collecting dispatch "
+                            "statistics in this process");
+  }
+  return iree_ok_status();
+}
+
+IREE_API_EXPORT void iree_hal_local_dispatch_statistics_end(
+    iree_hal_local_dispatch_statistics_t* statistics) {
+  IREE_ASSERT_ARGUMENT(statistics);
+  intptr_t expected = (intptr_t)statistics;
+  iree_atomic_compare_exchange_strong(
+      &iree_hal_local_dispatch_statistics_active_, &expected, 0,
+      iree_memory_order_acq_rel, iree_memory_order_relaxed);
+}
+
+void iree_hal_local_dispatch_statistics_record(
+    iree_hal_local_dispatch_statistics_t* statistics,
+    iree_hal_executable_t* executable, iree_host_size_t ordinal,
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state,
+    bool first_workgroup, iree_duration_t duration_ns) {
+  iree_hal_local_export_cache_t* cache =
+      &iree_hal_local_dispatch_statistics_cache_;
+  iree_hal_local_dispatch_statistics_entry_t* entry =
+      (iree_hal_local_dispatch_statistics_entry_t*)
+          iree_hal_local_export_cache_lookup(cache, statistics->generation,
+                                             executable, ordinal);
+  if (IREE_LIKELY(entry && !first_workgroup)) {
+    iree_atomic_fetch_add(&entry->time_ns, duration_ns,
+                          iree_memory_order_relaxed);
+    return;
+  }
+
+  iree_slim_mutex_lock(&statistics->mutex);
+  entry = (iree_hal_local_dispatch_statistics_entry_t*)
+      iree_hal_local_export_table_lookup(&statistics->table, executable,
+                                         ordinal);
+  if (entry) {
+    iree_atomic_fetch_add(&entry->time_ns, duration_ns,
+                          iree_memory_order_relaxed);
+    if (first_workgroup) {
+      const uint32_t workgroup_count[3] = {
+          dispatch_state->workgroup_count_x,
+          dispatch_state->workgroup_count_y,
+          dispatch_state->workgroup_count_z,
+      };
+      if (entry->dispatch_count > 0 &&
+          memcmp(entry->last_workgroup_count, workgroup_count,
+                 sizeof(workgroup_count)) != 0) {
+        entry->workgroup_count_varies = true;
+      }
+      memcpy(entry->last_workgroup_count, workgroup_count,
+             sizeof(workgroup_count));
+      ++entry->dispatch_count;
+      entry->workgroup_count +=
+          (uint64_t)workgroup_count[0] * workgroup_count[1] *
+          workgroup_count[2];
+      for (uint8_t i = 0; i < dispatch_state->binding_count; ++i) {
+        entry->bytes_bound += dispatch_state->binding_lengths[i];
+      }
+    }
+  }
+  iree_slim_mutex_unlock(&statistics->mutex);
+
+  iree_hal_local_export_cache_update(cache, statistics->generation, executable,
+                                     ordinal,
+                                     (iree_hal_local_export_entry_t*)entry);
+}
+
+static int iree_hal_local_dispatch_statistics_entry_compare(const void* lhs,
+                                                            const void* rhs) {
+  iree_hal_local_dispatch_statistics_entry_t* a =
+      *(iree_hal_local_dispatch_statistics_entry_t* const*)lhs;
+  iree_hal_local_dispatch_statistics_entry_t* b =
+      *(iree_hal_local_dispatch_statistics_entry_t* const*)rhs;
+  int64_t a_time_ns = iree_atomic_load(&a->time_ns, iree_memory_order_relaxed);
+  int64_t b_time_ns = iree_atomic_load(&b->time_ns, iree_memory_order_relaxed);
+  if (a_time_ns != b_time_ns) return a_time_ns < b_time_ns ? 1 : -1;
+  if (a->workgroup_count != b->workgroup_count) {
+    return a->workgroup_count < b->workgroup_count ? 1 : -1;
+  }
+  return 0;
+}
+
+IREE_API_EXPORT iree_status_t iree_hal_local_dispatch_statistics_fprint(
+    FILE* file, iree_hal_local_dispatch_statistics_t* statistics) {
+  IREE_ASSERT_ARGUMENT(file);
+  IREE_ASSERT_ARGUMENT(statistics);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_slim_mutex_lock(&statistics->mutex);
+  iree_hal_local_dispatch_statistics_entry_t** sorted_entries = NULL;
+  iree_status_t status = iree_allocator_malloc(
+      statistics->host_allocator,
+      iree_max(1, statistics->table.entry_count) * sizeof(*sorted_entries),
+      (void**)&sorted_entries);
+  iree_host_size_t entry_count = 0;
+  int64_t total_time_ns = 0;
+  if (iree_status_is_ok(status)) {
+    for (iree_host_size_t i = 0; i < statistics->table.entry_capacity; ++i) {
+      iree_hal_local_dispatch_statistics_entry_t* entry =
+          (iree_hal_local_dispatch_statistics_entry_t*)
+              statistics->table.entries[i];
+      if (!entry) continue;
+      sorted_entries[entry_count++] = entry;
+      total_time_ns +=
+          iree_atomic_load(&entry->time_ns, iree_memory_order_relaxed);
+    }
+    qsort(sorted_entries, entry_count, sizeof(*sorted_entries),
+          iree_hal_local_dispatch_statistics_entry_compare);
+  }
+
+  if (iree_status_is_ok(status)) {
+    fprintf(file, "[[ iree_hal_local_dispatch_statistics_t ]]\n");
+    fprintf(file, "%6s %10s %12s %16s %12s %12s %12s  %s\n", "time%",
+            "dispatches", "workgroups", "workgroup_count", "total_ms",
+            "avg_us", "bound_MiB", "export");
+    for (iree_host_size_t i = 0; i < entry_count; ++i) {
+      iree_hal_local_dispatch_statistics_entry_t* entry = sorted_entries[i];
+      int64_t time_ns =
+          iree_atomic_load(&entry->time_ns, iree_memory_order_relaxed);
+      // A trailing `*` indicates the export was dispatched with differing
+      // workgroup counts and only the most recent is shown.
+      char workgroup_count[48];
+      snprintf(workgroup_count, sizeof(workgroup_count), "%ux%ux%u%s",
+               entry->last_workgroup_count[0], entry->last_workgroup_count[1],
+               entry->last_workgroup_count[2],
+               entry->workgroup_count_varies ? "*" : "");
+      fprintf(file,
+              "%6.2f %10" PRIu64 " %12" PRIu64 " %16s %12.3f %12.3f %12.3f"
+              "  %.*s\n",
+              total_time_ns ? 100.0 * time_ns / total_time_ns : 0.0,
+              entry->dispatch_count, entry->workgroup_count, workgroup_count,
+              time_ns / 1e6,
+              entry->dispatch_count ? time_ns / 1e3 / entry->dispatch_count
+                                    : 0.0,
+              entry->bytes_bound / (1024.0 * 1024.0),
+              (int)entry->base.name.size, entry->base.name.data);
+    }
+  }
+  iree_slim_mutex_unlock(&statistics->mutex);
+
+  iree_allocator_free(statistics->host_allocator, sorted_entries);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
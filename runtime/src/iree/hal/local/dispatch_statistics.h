@@ -0,0 +1,88 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_HAL_LOCAL_DISPATCH_STATISTICS_H_
+#define IREE_HAL_LOCAL_DISPATCH_STATISTICS_H_
+
+#include <stdio.h>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/atomics.h"
+#include "iree/hal/api.h"
+#include "iree/hal/local/executable_library.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+//===----------------------------------------------------------------------===//
+// iree_hal_local_dispatch_statistics_t
+//===----------------------------------------------------------------------===//
+
+// Lightweight per-export counters for dispatches issued through
+// iree_hal_local_executable_issue_call: dispatch count, workgroup count,
+// workgroup execution time, and bytes bound. Unlike the hardware counter
+// profiler this requires no OS support and is cheap enough to leave enabled in
+// production runs for triaging hot dispatches without an external profiler.
+//
+// Time is measured around each workgroup and summed across all worker threads
+// so that under local-task it reports CPU time spent in the export rather than
+// the wall time of its dispatches.
+//
+// Executables do not know which device issued them so at most one statistics
+// collector can be active in the process at a time. Collection may be begun
+// and ended multiple times to accumulate across several regions of interest
+// and must be ended while no dispatches are in flight.
+typedef struct iree_hal_local_dispatch_statistics_t
+    iree_hal_local_dispatch_statistics_t;
+
+// Allocates an empty statistics collector. Collection starts once begun.
+IREE_API_EXPORT iree_status_t iree_hal_local_dispatch_statistics_allocate(
+    iree_allocator_t host_allocator,
+    iree_hal_local_dispatch_statistics_t** out_statistics);
+
+// Frees |statistics|, ending collection if it is active.
+IREE_API_EXPORT void iree_hal_local_dispatch_statistics_free(
+    iree_hal_local_dispatch_statistics_t* statistics);
+
+// Makes |statistics| the active collector for all local executables.
+// Fails if another collector is active.
+IREE_API_EXPORT iree_status_t iree_hal_local_dispatch_statistics_begin(
+    iree_hal_local_dispatch_statistics_t* statistics);
+
+// Ends collection into |statistics| while retaining what was collected.
+IREE_API_EXPORT void iree_hal_local_dispatch_statistics_end(
+    iree_hal_local_dispatch_statistics_t* statistics);
+
+// Prints a table of the collected statistics to |file| ordered by descending
+// time.
+IREE_API_EXPORT iree_status_t iree_hal_local_dispatch_statistics_fprint(
+    FILE* file, iree_hal_local_dispatch_statistics_t* statistics);
+
+// The active collector, if any. Checked by the dispatch path on every call so
+// that collection costs a single relaxed load when disabled.
+extern iree_atomic_intptr_t iree_hal_local_dispatch_statistics_active_;
+
+static inline iree_hal_local_dispatch_statistics_t*
+iree_hal_local_dispatch_statistics_active(void) {
+  return (iree_hal_local_dispatch_statistics_t*)iree_atomic_load(
+      &iree_hal_local_dispatch_statistics_active_, iree_memory_order_relaxed);
+}
+
+// Records a workgroup of export |ordinal| of |executable| described by
+// |dispatch_state| that took |duration_ns| to execute. |first_workgroup| is
+// set for one workgroup per dispatch.
+void iree_hal_local_dispatch_statistics_record(
+    iree_hal_local_dispatch_statistics_t* statistics,
+    iree_hal_executable_t* executable, iree_host_size_t ordinal,
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state,
+    bool first_workgroup, iree_duration_t duration_ns);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_HAL_LOCAL_DISPATCH_STATISTICS_H_
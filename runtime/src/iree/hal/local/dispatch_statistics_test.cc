@@ -0,0 +1,70 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/local/dispatch_statistics.h"
+
+#include <cstdio>
+#include <string>
+
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace iree {
+namespace {
+
+using ::iree::testing::status::StatusIs;
+
+TEST(DispatchStatisticsTest, BeginEnd) {
+  iree_hal_local_dispatch_statistics_t* statistics = NULL;
+  IREE_ASSERT_OK(iree_hal_local_dispatch_statistics_allocate(
+      iree_allocator_system(), &statistics));
+  EXPECT_EQ(iree_hal_local_dispatch_statistics_active(), nullptr);
+  IREE_ASSERT_OK(iree_hal_local_dispatch_statistics_begin(statistics));
+  EXPECT_EQ(iree_hal_local_dispatch_statistics_active(), statistics);
+  // Beginning again accumulates into the same collector.
+  IREE_ASSERT_OK(iree_hal_local_dispatch_statistics_begin(statistics));
+  iree_hal_local_dispatch_statistics_end(statistics);
+  EXPECT_EQ(iree_hal_local_dispatch_statistics_active(), nullptr);
+  iree_hal_local_dispatch_statistics_free(statistics);
+}
+
+TEST(DispatchStatisticsTest, OneActiveCollector) {
+  iree_hal_local_dispatch_statistics_t* statistics_a = NULL;
+  iree_hal_local_dispatch_statistics_t* statistics_b = NULL;
+  IREE_ASSERT_OK(iree_hal_local_dispatch_statistics_allocate(
+      iree_allocator_system(), &statistics_a));
+  IREE_ASSERT_OK(iree_hal_local_dispatch_statistics_allocate(
+      iree_allocator_system(), &statistics_b));
+  IREE_ASSERT_OK(iree_hal_local_dispatch_statistics_begin(statistics_a));
+  EXPECT_THAT(Status(iree_hal_local_dispatch_statistics_begin(statistics_b)),
+              StatusIs(StatusCode::kFailedPrecondition));
+  // Ending an inactive collector must not end the active one.
+  iree_hal_local_dispatch_statistics_end(statistics_b);
+  EXPECT_EQ(iree_hal_local_dispatch_statistics_active(), statistics_a);
+  // Freeing ends collection.
+  iree_hal_local_dispatch_statistics_free(statistics_a);
+  EXPECT_EQ(iree_hal_local_dispatch_statistics_active(), nullptr);
+  iree_hal_local_dispatch_statistics_free(statistics_b);
+}
+
+TEST(DispatchStatisticsTest, PrintEmpty) {
+  iree_hal_local_dispatch_statistics_t* statistics = NULL;
+  IREE_ASSERT_OK(iree_hal_local_dispatch_statistics_allocate(
+      iree_allocator_system(), &statistics));
+  FILE* file = tmpfile();
+  ASSERT_NE(file, nullptr);
+  IREE_ASSERT_OK(iree_hal_local_dispatch_statistics_fprint(file, statistics));
+  std::string contents(256, '\0');
+  rewind(file);
+  contents.resize(fread(&contents[0], 1, contents.size(), file));
+  fclose(file);
+  EXPECT_NE(contents.find("dispatches"), std::string::npos);
+  EXPECT_NE(contents.find("export"), std::string::npos);
+  iree_hal_local_dispatch_statistics_free(statistics);
+}
+
+}  // namespace
+}  // namespace iree
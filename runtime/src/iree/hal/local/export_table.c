@@ -0,0 +1,130 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/local/export_table.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void iree_hal_local_export_table_initialize(
+    iree_host_size_t record_size, iree_allocator_t host_allocator,
+    iree_hal_local_export_table_t* out_table) {
+  IREE_ASSERT_ARGUMENT(out_table);
+  IREE_ASSERT(record_size >= sizeof(iree_hal_local_export_entry_t));
+  memset(out_table, 0, sizeof(*out_table));
+  out_table->host_allocator = host_allocator;
+  out_table->record_size = record_size;
+}
+
+void iree_hal_local_export_table_deinitialize(
+    iree_hal_local_export_table_t* table) {
+  IREE_ASSERT_ARGUMENT(table);
+  for (iree_host_size_t i = 0; i < table->entry_capacity; ++i) {
+    iree_hal_local_export_entry_t* entry = table->entries[i];
+    if (!entry) continue;
+    iree_hal_executable_release(entry->executable);
+    iree_allocator_free(table->host_allocator, entry);
+  }
+  iree_allocator_free(table->host_allocator, table->entries);
+  memset(table, 0, sizeof(*table));
+}
+
+static iree_host_size_t iree_hal_local_export_table_hash(
+    iree_hal_executable_t* executable, iree_host_size_t ordinal) {
+  uint64_t key = (uint64_t)(uintptr_t)executable ^ ((uint64_t)ordinal << 48);
+  key ^= key >> 33;
+  key *= 0xFF51AFD7ED558CCDull;
+  key ^= key >> 33;
+  return (iree_host_size_t)key;
+}
+
+// Grows the table to hold at least twice its current entries.
+static iree_status_t iree_hal_local_export_table_grow(
+    iree_hal_local_export_table_t* table) {
+  iree_host_size_t new_capacity =
+      table->entry_capacity ? table->entry_capacity * 2 : 64;
+  iree_hal_local_export_entry_t** new_entries = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      table->host_allocator, new_capacity * sizeof(*new_entries),
+      (void**)&new_entries));
+  memset(new_entries, 0, new_capacity * sizeof(*new_entries));
+  for (iree_host_size_t i = 0; i < table->entry_capacity; ++i) {
+    iree_hal_local_export_entry_t* entry = table->entries[i];
+    if (!entry) continue;
+    iree_host_size_t j =
+        iree_hal_local_export_table_hash(entry->executable, entry->ordinal);
+    while (new_entries[j & (new_capacity - 1)]) ++j;
+    new_entries[j & (new_capacity - 1)] = entry;
+  }
+  iree_allocator_free(table->host_allocator, table->entries);
+  table->entries = new_entries;
+  table->entry_capacity = new_capacity;
+  return iree_ok_status();
+}
+
+iree_hal_local_export_entry_t* iree_hal_local_export_table_lookup(
+    iree_hal_local_export_table_t* table, iree_hal_executable_t* executable,
+    iree_host_size_t ordinal) {
+  if (table->entry_capacity) {
+    iree_host_size_t mask = table->entry_capacity - 1;
+    for (iree_host_size_t i =
+             iree_hal_local_export_table_hash(executable, ordinal);
+         ; ++i) {
+      iree_hal_local_export_entry_t* entry = table->entries[i & mask];
+      if (!entry) break;
+      if (entry->executable == executable && entry->ordinal == ordinal) {
+        return entry;
+      }
+    }
+  }
+
+  // Keep the table at most half full.
+  if ((table->entry_count + 1) * 2 > table->entry_capacity) {
+    iree_status_t status = iree_hal_local_export_table_grow(table);
+    if (!iree_status_is_ok(status)) {
+      iree_status_ignore(status);
+      return NULL;
+    }
+  }
+
+  // Copy the export name now as it may not be queryable once the executable
+  // is released by the program.
+  char name_buffer[32];
+  iree_string_view_t name = iree_string_view_empty();
+  iree_hal_executable_export_info_t info;
+  iree_status_t status = iree_hal_executable_export_info(
+      executable, (iree_hal_executable_export_ordinal_t)ordinal, &info);
+  if (iree_status_is_ok(status) && !iree_string_view_is_empty(info.name)) {
+    name = info.name;
+  } else {
+    iree_status_ignore(status);
+    int length = snprintf(name_buffer, sizeof(name_buffer), "export_%" PRIhsz,
+                          ordinal);
+    name = iree_make_string_view(name_buffer, (iree_host_size_t)length);
+  }
+  iree_hal_local_export_entry_t* entry = NULL;
+  status = iree_allocator_malloc(table->host_allocator,
+                                 table->record_size + name.size,
+                                 (void**)&entry);
+  if (!iree_status_is_ok(status)) {
+    iree_status_ignore(status);
+    return NULL;
+  }
+  memset(entry, 0, table->record_size);
+  char* name_storage = (char*)entry + table->record_size;
+  memcpy(name_storage, name.data, name.size);
+  entry->executable = executable;
+  iree_hal_executable_retain(executable);
+  entry->ordinal = ordinal;
+  entry->name = iree_make_string_view(name_storage, name.size);
+
+  iree_host_size_t mask = table->entry_capacity - 1;
+  iree_host_size_t i = iree_hal_local_export_table_hash(executable, ordinal);
+  while (table->entries[i & mask]) ++i;
+  table->entries[i & mask] = entry;
+  ++table->entry_count;
+  return entry;
+}
@@ -0,0 +1,111 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_HAL_LOCAL_EXPORT_TABLE_H_
+#define IREE_HAL_LOCAL_EXPORT_TABLE_H_
+
+#include "iree/base/api.h"
+#include "iree/hal/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+// Declares a variable with thread storage duration.
+#if defined(IREE_COMPILER_MSVC)
+#define iree_hal_local_thread_local __declspec(thread)
+#else
+#define iree_hal_local_thread_local _Thread_local
+#endif  // IREE_COMPILER_MSVC
+
+//===----------------------------------------------------------------------===//
+// iree_hal_local_export_table_t
+//===----------------------------------------------------------------------===//
+
+// Key of a per-export record in an iree_hal_local_export_table_t.
+// Must be the first member of the record type stored in the table.
+typedef struct iree_hal_local_export_entry_t {
+  // Retained so that the key is not reused by a new executable.
+  iree_hal_executable_t* executable;
+  iree_host_size_t ordinal;
+  // Export name copied into storage trailing the record.
+  iree_string_view_t name;
+} iree_hal_local_export_entry_t;
+
+// Open-addressed table of per-export records keyed by executable and ordinal
+// used by collectors that aggregate dispatches per export. Records are
+// allocated individually so that their pointers remain stable as the table
+// grows and threads can cache them with an iree_hal_local_export_cache_t.
+//
+// Thread-compatible; users must guard lookups with their own lock.
+typedef struct iree_hal_local_export_table_t {
+  iree_allocator_t host_allocator;
+  // Size of each record including the leading iree_hal_local_export_entry_t.
+  iree_host_size_t record_size;
+  iree_host_size_t entry_count;
+  iree_host_size_t entry_capacity;  // power of two
+  // Sparse array of entry_capacity slots; unused slots are NULL.
+  iree_hal_local_export_entry_t** entries;
+} iree_hal_local_export_table_t;
+
+// Initializes |out_table| to store records of |record_size| bytes.
+void iree_hal_local_export_table_initialize(
+    iree_host_size_t record_size, iree_allocator_t host_allocator,
+    iree_hal_local_export_table_t* out_table);
+
+// Releases all executables and frees all records in |table|.
+void iree_hal_local_export_table_deinitialize(
+    iree_hal_local_export_table_t* table);
+
+// Returns the record for export |ordinal| of |executable|, inserting a zeroed
+// one if needed, or NULL if out of memory.
+iree_hal_local_export_entry_t* iree_hal_local_export_table_lookup(
+    iree_hal_local_export_table_t* table, iree_hal_executable_t* executable,
+    iree_host_size_t ordinal);
+
+//===----------------------------------------------------------------------===//
+// iree_hal_local_export_cache_t
+//===----------------------------------------------------------------------===//
+
+// The record last used by a thread. Workgroups of the same dispatch usually
+// run back-to-back on a worker and hit this without locking the table.
+// |generation| identifies the collector owning the table so that records of a
+// prior (possibly freed) collector are never matched.
+typedef struct iree_hal_local_export_cache_t {
+  int32_t generation;
+  iree_hal_executable_t* executable;
+  iree_host_size_t ordinal;
+  iree_hal_local_export_entry_t* entry;
+} iree_hal_local_export_cache_t;
+
+// Returns the cached record for export |ordinal| of |executable| in the table
+// of collector |generation| or NULL if the cache holds another.
+static inline iree_hal_local_export_entry_t* iree_hal_local_export_cache_lookup(
+    const iree_hal_local_export_cache_t* cache, int32_t generation,
+    iree_hal_executable_t* executable, iree_host_size_t ordinal) {
+  return cache->generation == generation && cache->executable == executable &&
+                 cache->ordinal == ordinal
+             ? cache->entry
+             : NULL;
+}
+
+// Caches |entry| (or NULL if lookup failed) as the record for export |ordinal|
+// of |executable| in the table of collector |generation|.
+static inline void iree_hal_local_export_cache_update(
+    iree_hal_local_export_cache_t* cache, int32_t generation,
+    iree_hal_executable_t* executable, iree_host_size_t ordinal,
+    iree_hal_local_export_entry_t* entry) {
+  cache->generation = generation;
+  cache->executable = entry ? executable : NULL;
+  cache->ordinal = ordinal;
+  cache->entry = entry;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_HAL_LOCAL_EXPORT_TABLE_H_
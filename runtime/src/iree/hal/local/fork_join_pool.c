@@ -0,0 +1,354 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/local/fork_join_pool.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "iree/base/internal/atomics.h"
+#include "iree/base/internal/cpu.h"
+#include "iree/base/internal/fpu_state.h"
+#include "iree/base/internal/synchronization.h"
+#include "iree/base/internal/threading.h"
+
+//===----------------------------------------------------------------------===//
+// iree_hal_local_fork_join_pool_t
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_hal_local_fork_join_worker_t {
+  iree_hal_local_fork_join_pool_t* pool;
+  // Participant index of the worker; the issuing thread is always 0.
+  uint32_t participant_index;
+  iree_thread_t* thread;
+  // Local memory reserved for workgroups run by the worker, grown on demand.
+  iree_byte_span_t local_memory;
+} iree_hal_local_fork_join_worker_t;
+
+struct iree_hal_local_fork_join_pool_t {
+  iree_allocator_t host_allocator;
+  iree_duration_t spin_ns;
+
+  // Held by the thread issuing a dispatch for its duration.
+  iree_slim_mutex_t mutex;
+
+  // Incremented by the issuing thread to publish a new dispatch to workers.
+  iree_atomic_int32_t epoch;
+  // Set when the pool is being freed and workers must exit.
+  iree_atomic_int32_t exiting;
+  // Posted when |epoch| or |exiting| change.
+  iree_notification_t begin_notification;
+
+  // Number of workers that have not yet finished the current dispatch.
+  iree_atomic_int32_t pending_count;
+  // Posted by the last worker to finish the current dispatch.
+  iree_notification_t end_notification;
+
+  // The current dispatch, written by the issuing thread before publishing.
+  struct {
+    iree_hal_local_executable_t* executable;
+    iree_host_size_t ordinal;
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state;
+    iree_host_size_t local_memory_size;
+    uint32_t participant_count;
+    // First failure of any participant as an iree_status_t.
+    iree_atomic_intptr_t status;
+  } dispatch;
+
+  iree_host_size_t worker_count;
+  iree_hal_local_fork_join_worker_t workers[];
+};
+
+void iree_hal_local_fork_join_pool_params_initialize(
+    iree_hal_local_fork_join_pool_params_t* out_params) {
+  memset(out_params, 0, sizeof(*out_params));
+  out_params->spin_ns = 50 * 1000;
+}
+
+// Blocks until |condition_fn| returns true, spinning for up to |spin_ns| on
+// each wait before parking.
+static void iree_hal_local_fork_join_pool_await(
+    iree_notification_t* notification, iree_condition_fn_t condition_fn,
+    void* condition_arg, iree_duration_t spin_ns) {
+  while (!condition_fn(condition_arg)) {
+    iree_wait_token_t wait_token = iree_notification_prepare_wait(notification);
+    if (condition_fn(condition_arg)) {
+      iree_notification_cancel_wait(notification);
+      break;
+    }
+    iree_notification_commit_wait(notification, wait_token, spin_ns,
+                                  IREE_TIME_INFINITE_FUTURE);
+  }
+}
+
+// Runs the workgroups of the current dispatch assigned to |participant_index|.
+static void iree_hal_local_fork_join_pool_run_range(
+    iree_hal_local_fork_join_pool_t* pool, uint32_t participant_index,
+    uint32_t processor_id, iree_byte_span_t local_memory) {
+  const iree_hal_executable_dispatch_state_v0_t* dispatch_state =
+      pool->dispatch.dispatch_state;
+  const uint32_t participant_count = pool->dispatch.participant_count;
+  if (participant_index >= participant_count) return;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Static partition of the flattened workgroup grid into contiguous ranges so
+  // that neighboring workgroups (which often share data) run on one thread.
+  const uint64_t workgroup_count_x = dispatch_state->workgroup_count_x;
+  const uint64_t workgroup_count_xy =
+      workgroup_count_x * dispatch_state->workgroup_count_y;
+  const uint64_t total_count =
+      workgroup_count_xy * dispatch_state->workgroup_count_z;
+  const uint64_t range_begin =
+      total_count * participant_index / participant_count;
+  const uint64_t range_end =
+      total_count * (participant_index + 1) / participant_count;
+
+  iree_alignas(64) iree_hal_executable_workgroup_state_v0_t workgroup_state = {
+      .workgroup_id_x = 0,
+      .workgroup_id_y = 0,
+      .workgroup_id_z = 0,
+      .processor_id = processor_id,
+      .local_memory = local_memory.data,
+      .local_memory_size = (size_t)local_memory.data_length,
+  };
+  iree_status_t status = iree_ok_status();
+  for (uint64_t i = range_begin; i < range_end; ++i) {
+    // Bail early if another participant failed.
+    if (IREE_UNLIKELY(iree_atomic_load(&pool->dispatch.status,
+                                       iree_memory_order_relaxed))) {
+      break;
+    }
+    workgroup_state.workgroup_id_x = (uint32_t)(i % workgroup_count_x);
+    workgroup_state.workgroup_id_y =
+        (uint32_t)((i % workgroup_count_xy) / workgroup_count_x);
+    workgroup_state.workgroup_id_z = (uint32_t)(i / workgroup_count_xy);
+    status = iree_hal_local_executable_issue_call(
+        pool->dispatch.executable, pool->dispatch.ordinal, dispatch_state,
+        &workgroup_state, participant_index);
+    if (!iree_status_is_ok(status)) break;
+  }
+
+  if (!iree_status_is_ok(status)) {
+    intptr_t expected = 0;
+    if (!iree_atomic_compare_exchange_strong(
+            &pool->dispatch.status, &expected, (intptr_t)status,
+            iree_memory_order_acq_rel, iree_memory_order_relaxed)) {
+      iree_status_ignore(status);
+    }
+  }
+  IREE_TRACE_ZONE_END(z0);
+}
+
+typedef struct iree_hal_local_fork_join_worker_wait_t {
+  iree_hal_local_fork_join_pool_t* pool;
+  int32_t epoch;
+} iree_hal_local_fork_join_worker_wait_t;
+
+static bool iree_hal_local_fork_join_worker_should_wake(void* arg) {
+  iree_hal_local_fork_join_worker_wait_t* wait =
+      (iree_hal_local_fork_join_worker_wait_t*)arg;
+  return iree_atomic_load(&wait->pool->epoch, iree_memory_order_acquire) !=
+             wait->epoch ||
+         iree_atomic_load(&wait->pool->exiting, iree_memory_order_acquire);
+}
+
+// Ensures |worker| has at least |size| bytes of local memory.
+static iree_status_t iree_hal_local_fork_join_worker_reserve_local_memory(
+    iree_hal_local_fork_join_worker_t* worker, iree_host_size_t size) {
+  if (worker->local_memory.data_length >= size) return iree_ok_status();
+  iree_allocator_t host_allocator = worker->pool->host_allocator;
+  iree_allocator_free(host_allocator, worker->local_memory.data);
+  worker->local_memory = iree_byte_span_empty();
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      host_allocator, size, (void**)&worker->local_memory.data));
+  worker->local_memory.data_length = size;
+  return iree_ok_status();
+}
+
+static int iree_hal_local_fork_join_worker_main(void* arg) {
+  iree_hal_local_fork_join_worker_t* worker =
+      (iree_hal_local_fork_join_worker_t*)arg;
+  iree_hal_local_fork_join_pool_t* pool = worker->pool;
+
+  // Workers only ever run dispatches and keep the same FPU state throughout.
+  iree_fpu_state_t fpu_state =
+      iree_fpu_state_push(IREE_FPU_STATE_FLAG_FLUSH_DENORMALS_TO_ZERO);
+
+  iree_cpu_processor_tag_t processor_tag = 0;
+  iree_cpu_processor_id_t processor_id = 0;
+  iree_hal_local_fork_join_worker_wait_t wait = {
+      .pool = pool,
+      .epoch = 0,
+  };
+  for (;;) {
+    iree_hal_local_fork_join_pool_await(
+        &pool->begin_notification, iree_hal_local_fork_join_worker_should_wake,
+        &wait, pool->spin_ns);
+    if (iree_atomic_load(&pool->exiting, iree_memory_order_acquire)) break;
+    wait.epoch = iree_atomic_load(&pool->epoch, iree_memory_order_acquire);
+
+    if (worker->participant_index < pool->dispatch.participant_count) {
+      iree_cpu_requery_processor_id(&processor_tag, &processor_id);
+      iree_host_size_t local_memory_size = pool->dispatch.local_memory_size;
+      iree_status_t status =
+          iree_hal_local_fork_join_worker_reserve_local_memory(
+              worker, local_memory_size);
+      if (iree_status_is_ok(status)) {
+        iree_hal_local_fork_join_pool_run_range(
+            pool, worker->participant_index, processor_id,
+            iree_make_byte_span(worker->local_memory.data,
+                                local_memory_size));
+      } else {
+        intptr_t expected = 0;
+        if (!iree_atomic_compare_exchange_strong(
+                &pool->dispatch.status, &expected, (intptr_t)status,
+                iree_memory_order_acq_rel, iree_memory_order_relaxed)) {
+          iree_status_ignore(status);
+        }
+      }
+    }
+
+    if (iree_atomic_fetch_sub(&pool->pending_count, 1,
+                              iree_memory_order_acq_rel) == 1) {
+      iree_notification_post(&pool->end_notification, IREE_ALL_WAITERS);
+    }
+  }
+
+  iree_fpu_state_pop(fpu_state);
+  return 0;
+}
+
+iree_status_t iree_hal_local_fork_join_pool_create(
+    const iree_hal_local_fork_join_pool_params_t* params,
+    iree_allocator_t host_allocator,
+    iree_hal_local_fork_join_pool_t** out_pool) {
+  IREE_ASSERT_ARGUMENT(params);
+  IREE_ASSERT_ARGUMENT(out_pool);
+  *out_pool = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, params->worker_count);
+
+  iree_hal_local_fork_join_pool_t* pool = NULL;
+  iree_host_size_t total_size =
+      sizeof(*pool) + params->worker_count * sizeof(pool->workers[0]);
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator, total_size, (void**)&pool));
+  memset(pool, 0, total_size);
+  pool->host_allocator = host_allocator;
+  pool->spin_ns = params->spin_ns;
+  iree_slim_mutex_initialize(&pool->mutex);
+  iree_notification_initialize(&pool->begin_notification);
+  iree_notification_initialize(&pool->end_notification);
+
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < params->worker_count; ++i) {
+    iree_hal_local_fork_join_worker_t* worker = &pool->workers[i];
+    worker->pool = pool;
+    worker->participant_index = (uint32_t)(i + 1);
+    char name[32];
+    snprintf(name, sizeof(name), "iree-fork-join-%u", (uint32_t)i);
+    iree_thread_create_params_t thread_params;
+    memset(&thread_params, 0, sizeof(thread_params));
+    thread_params.name = iree_make_cstring_view(name);
+    thread_params.stack_size = params->worker_stack_size;
+    status = iree_thread_create(iree_hal_local_fork_join_worker_main, worker,
+                                thread_params, host_allocator,
+                                &worker->thread);
+    if (!iree_status_is_ok(status)) break;
+    ++pool->worker_count;
+  }
+
+  if (iree_status_is_ok(status)) {
+    *out_pool = pool;
+  } else {
+    iree_hal_local_fork_join_pool_free(pool);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+void iree_hal_local_fork_join_pool_free(iree_hal_local_fork_join_pool_t* pool) {
+  if (!pool) return;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_atomic_store(&pool->exiting, 1, iree_memory_order_release);
+  iree_notification_post(&pool->begin_notification, IREE_ALL_WAITERS);
+  for (iree_host_size_t i = 0; i < pool->worker_count; ++i) {
+    iree_hal_local_fork_join_worker_t* worker = &pool->workers[i];
+    iree_thread_join(worker->thread);
+    iree_thread_release(worker->thread);
+    iree_allocator_free(pool->host_allocator, worker->local_memory.data);
+  }
+
+  iree_notification_deinitialize(&pool->end_notification);
+  iree_notification_deinitialize(&pool->begin_notification);
+  iree_slim_mutex_deinitialize(&pool->mutex);
+  iree_allocator_free(pool->host_allocator, pool);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+iree_host_size_t iree_hal_local_fork_join_pool_concurrency(
+    iree_hal_local_fork_join_pool_t* pool) {
+  return pool ? pool->worker_count + 1 : 1;
+}
+
+static bool iree_hal_local_fork_join_pool_is_idle(void* arg) {
+  iree_hal_local_fork_join_pool_t* pool =
+      (iree_hal_local_fork_join_pool_t*)arg;
+  return iree_atomic_load(&pool->pending_count, iree_memory_order_acquire) ==
+         0;
+}
+
+iree_status_t iree_hal_local_fork_join_pool_issue_dispatch(
+    iree_hal_local_fork_join_pool_t* pool,
+    iree_hal_local_executable_t* executable, iree_host_size_t ordinal,
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state,
+    uint32_t processor_id, iree_byte_span_t local_memory) {
+  IREE_ASSERT_ARGUMENT(pool);
+  IREE_ASSERT_ARGUMENT(executable);
+  IREE_ASSERT_ARGUMENT(dispatch_state);
+
+  // Dispatches too small to split or issued while another thread is using the
+  // pool run entirely on the calling thread.
+  const uint64_t total_count = (uint64_t)dispatch_state->workgroup_count_x *
+                               dispatch_state->workgroup_count_y *
+                               dispatch_state->workgroup_count_z;
+  const uint32_t participant_count =
+      (uint32_t)iree_min(total_count, (uint64_t)pool->worker_count + 1);
+  if (participant_count <= 1 || !iree_slim_mutex_try_lock(&pool->mutex)) {
+    return iree_hal_local_executable_issue_dispatch_inline(
+        executable, ordinal, dispatch_state, processor_id, local_memory);
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, participant_count);
+
+  // Publish the dispatch to all workers. Workers beyond |participant_count|
+  // wake only to acknowledge it so that every dispatch has the same join.
+  pool->dispatch.executable = executable;
+  pool->dispatch.ordinal = ordinal;
+  pool->dispatch.dispatch_state = dispatch_state;
+  pool->dispatch.local_memory_size = local_memory.data_length;
+  pool->dispatch.participant_count = participant_count;
+  iree_atomic_store(&pool->dispatch.status, 0, iree_memory_order_relaxed);
+  iree_atomic_store(&pool->pending_count, (int32_t)pool->worker_count,
+                    iree_memory_order_relaxed);
+  iree_atomic_fetch_add(&pool->epoch, 1, iree_memory_order_acq_rel);
+  iree_notification_post(&pool->begin_notification, IREE_ALL_WAITERS);
+
+  // Participate as index 0 and then wait for the workers to finish.
+  iree_hal_local_fork_join_pool_run_range(pool, /*participant_index=*/0,
+                                          processor_id, local_memory);
+  iree_hal_local_fork_join_pool_await(&pool->end_notification,
+                                      iree_hal_local_fork_join_pool_is_idle,
+                                      pool, pool->spin_ns);
+
+  iree_status_t status = (iree_status_t)iree_atomic_exchange(
+      &pool->dispatch.status, 0, iree_memory_order_acquire);
+  iree_slim_mutex_unlock(&pool->mutex);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
@@ -0,0 +1,81 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_HAL_LOCAL_FORK_JOIN_POOL_H_
+#define IREE_HAL_LOCAL_FORK_JOIN_POOL_H_
+
+#include "iree/base/api.h"
+#include "iree/hal/local/executable_library.h"
+#include "iree/hal/local/local_executable.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+//===----------------------------------------------------------------------===//
+// iree_hal_local_fork_join_pool_t
+//===----------------------------------------------------------------------===//
+
+// Parameters configuring an iree_hal_local_fork_join_pool_t.
+typedef struct iree_hal_local_fork_join_pool_params_t {
+  // Number of worker threads created in addition to the calling thread that
+  // participates in each dispatch.
+  iree_host_size_t worker_count;
+  // Duration workers and the calling thread spin waiting for a dispatch to
+  // begin or end before parking in the kernel. Spinning lowers fork/join
+  // latency for back-to-back dispatches at the cost of burning CPU time.
+  iree_duration_t spin_ns;
+  // Minimum size in bytes of each worker thread stack or 0 for the default.
+  iree_host_size_t worker_stack_size;
+} iree_hal_local_fork_join_pool_params_t;
+
+// Initializes |out_params| to default values.
+void iree_hal_local_fork_join_pool_params_initialize(
+    iree_hal_local_fork_join_pool_params_t* out_params);
+
+// A small fixed pool of threads that executes the workgroups of a single
+// dispatch in parallel with the calling thread and returns once all have
+// completed. Workgroups are statically partitioned into contiguous ranges, one
+// per participant, so there is no work stealing or queueing: this trades load
+// balancing for the lowest possible fork/join overhead and deterministic
+// workgroup-to-thread assignment. Dispatch ordering remains synchronous.
+//
+// Only one dispatch may be executing on the pool at a time. Callers from other
+// threads that find the pool busy execute their dispatch inline instead of
+// blocking.
+typedef struct iree_hal_local_fork_join_pool_t iree_hal_local_fork_join_pool_t;
+
+// Creates a pool with the given |params| and starts its worker threads.
+iree_status_t iree_hal_local_fork_join_pool_create(
+    const iree_hal_local_fork_join_pool_params_t* params,
+    iree_allocator_t host_allocator,
+    iree_hal_local_fork_join_pool_t** out_pool);
+
+// Joins all worker threads and frees |pool|.
+// No dispatches may be executing.
+void iree_hal_local_fork_join_pool_free(iree_hal_local_fork_join_pool_t* pool);
+
+// Returns the maximum number of threads that may execute a single dispatch.
+iree_host_size_t iree_hal_local_fork_join_pool_concurrency(
+    iree_hal_local_fork_join_pool_t* pool);
+
+// Executes all workgroups of export |ordinal| of |executable| described by
+// |dispatch_state| across the pool and the calling thread and waits for them
+// to complete. |local_memory| is used by the calling thread and workers
+// allocate their own of the same size. Equivalent to
+// iree_hal_local_executable_issue_dispatch_inline when the pool is busy or
+// the dispatch has a single workgroup.
+iree_status_t iree_hal_local_fork_join_pool_issue_dispatch(
+    iree_hal_local_fork_join_pool_t* pool,
+    iree_hal_local_executable_t* executable, iree_host_size_t ordinal,
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state,
+    uint32_t processor_id, iree_byte_span_t local_memory);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_HAL_LOCAL_FORK_JOIN_POOL_H_
@@ -0,0 +1,143 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/local/fork_join_pool.h"
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace iree {
+namespace {
+
+using ::iree::testing::status::StatusIs;
+
+// Executable recording how many times each workgroup of a dispatch ran.
+// Export 1 fails on its last workgroup.
+struct TestExecutable {
+  iree_hal_local_executable_t base;
+  std::vector<std::atomic<int>>* hits = nullptr;
+  std::atomic<uint32_t> max_worker_id{0};
+};
+
+static iree_status_t TestExecutableIssueCall(
+    iree_hal_local_executable_t* base_executable, iree_host_size_t ordinal,
+    const iree_hal_executable_dispatch_state_v0_t* dispatch_state,
+    const iree_hal_executable_workgroup_state_v0_t* workgroup_state,
+    uint32_t worker_id) {
+  // |base| is the first member.
+  TestExecutable* executable =
+      reinterpret_cast<TestExecutable*>(base_executable);
+  size_t index = workgroup_state->workgroup_id_x +
+                 dispatch_state->workgroup_count_x *
+                     (workgroup_state->workgroup_id_y +
+                      dispatch_state->workgroup_count_y *
+                          workgroup_state->workgroup_id_z);
+  (*executable->hits)[index].fetch_add(1);
+  uint32_t max_worker_id = executable->max_worker_id.load();
+  while (worker_id > max_worker_id &&
+         !executable->max_worker_id.compare_exchange_weak(max_worker_id,
+                                                          worker_id)) {
+  }
+  if (ordinal == 1 && index + 1 == executable->hits->size()) {
+    return iree_make_status(IREE_STATUS_DATA_LOSS, "workgroup failed");
+  }
+  return iree_ok_status();
+}
+
+class ForkJoinPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    memset(&vtable_, 0, sizeof(vtable_));
+    vtable_.issue_call = TestExecutableIssueCall;
+    iree_hal_local_executable_initialize(&vtable_, iree_allocator_system(),
+                                         &executable_.base);
+  }
+
+  void CreatePool(iree_host_size_t worker_count) {
+    iree_hal_local_fork_join_pool_params_t params;
+    iree_hal_local_fork_join_pool_params_initialize(&params);
+    params.worker_count = worker_count;
+    IREE_ASSERT_OK(iree_hal_local_fork_join_pool_create(
+        &params, iree_allocator_system(), &pool_));
+  }
+
+  void TearDown() override { iree_hal_local_fork_join_pool_free(pool_); }
+
+  // Dispatches export |ordinal| over the given workgroup count and returns
+  // the hit count of each workgroup.
+  iree_status_t Dispatch(iree_host_size_t ordinal, uint32_t x, uint32_t y,
+                         uint32_t z, std::vector<int>* out_hits) {
+    std::vector<std::atomic<int>> hits(x * y * z);
+    executable_.hits = &hits;
+    iree_hal_executable_dispatch_state_v0_t dispatch_state;
+    memset(&dispatch_state, 0, sizeof(dispatch_state));
+    dispatch_state.workgroup_size_x = 1;
+    dispatch_state.workgroup_size_y = 1;
+    dispatch_state.workgroup_size_z = 1;
+    dispatch_state.workgroup_count_x = x;
+    dispatch_state.workgroup_count_y = y;
+    dispatch_state.workgroup_count_z = z;
+    iree_status_t status = iree_hal_local_fork_join_pool_issue_dispatch(
+        pool_, &executable_.base, ordinal, &dispatch_state,
+        /*processor_id=*/0, iree_byte_span_empty());
+    out_hits->clear();
+    for (auto& hit : hits) out_hits->push_back(hit.load());
+    executable_.hits = nullptr;
+    return status;
+  }
+
+  iree_hal_local_executable_vtable_t vtable_;
+  TestExecutable executable_;
+  iree_hal_local_fork_join_pool_t* pool_ = NULL;
+};
+
+TEST_F(ForkJoinPoolTest, NoWorkers) {
+  CreatePool(0);
+  EXPECT_EQ(iree_hal_local_fork_join_pool_concurrency(pool_), 1);
+  std::vector<int> hits;
+  IREE_ASSERT_OK(Dispatch(0, 4, 3, 2, &hits));
+  EXPECT_EQ(hits, std::vector<int>(4 * 3 * 2, 1));
+  EXPECT_EQ(executable_.max_worker_id.load(), 0);
+}
+
+TEST_F(ForkJoinPoolTest, AllWorkgroupsRunOnce) {
+  CreatePool(3);
+  EXPECT_EQ(iree_hal_local_fork_join_pool_concurrency(pool_), 4);
+  std::vector<int> hits;
+  for (int i = 0; i < 32; ++i) {
+    IREE_ASSERT_OK(Dispatch(0, 7, 5, 3, &hits));
+    EXPECT_EQ(hits, std::vector<int>(7 * 5 * 3, 1));
+  }
+  EXPECT_EQ(executable_.max_worker_id.load(), 3);
+}
+
+TEST_F(ForkJoinPoolTest, FewerWorkgroupsThanWorkers) {
+  CreatePool(7);
+  std::vector<int> hits;
+  IREE_ASSERT_OK(Dispatch(0, 3, 1, 1, &hits));
+  EXPECT_EQ(hits, std::vector<int>(3, 1));
+  IREE_ASSERT_OK(Dispatch(0, 1, 1, 1, &hits));
+  EXPECT_EQ(hits, std::vector<int>(1, 1));
+  IREE_ASSERT_OK(Dispatch(0, 0, 1, 1, &hits));
+  EXPECT_TRUE(hits.empty());
+}
+
+TEST_F(ForkJoinPoolTest, PropagatesFailure) {
+  CreatePool(3);
+  std::vector<int> hits;
+  EXPECT_THAT(Status(Dispatch(1, 16, 4, 1, &hits)),
+              StatusIs(StatusCode::kDataLoss));
+  // The pool remains usable after a failure.
+  IREE_ASSERT_OK(Dispatch(0, 16, 4, 1, &hits));
+  EXPECT_EQ(hits, std::vector<int>(16 * 4, 1));
+}
+
+}  // namespace
+}  // namespace iree
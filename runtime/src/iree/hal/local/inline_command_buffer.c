@@ -25,6 +25,8 @@
 typedef struct iree_hal_inline_command_buffer_t {
   iree_hal_command_buffer_t base;
   iree_allocator_t host_allocator;
+  // Optional pool used to execute dispatch workgroups in parallel.
+  iree_hal_local_fork_join_pool_t* fork_join_pool;
 
   struct {
     // Cached and initialized dispatch state reused for all dispatches.
@@ -74,6 +76,7 @@ iree_status_t iree_hal_inline_command_buffer_initialize(
     iree_hal_allocator_t* device_allocator, iree_hal_command_buffer_mode_t mode,
     iree_hal_command_category_t command_categories,
     iree_hal_queue_affinity_t queue_affinity, iree_host_size_t binding_capacity,
+    iree_hal_local_fork_join_pool_t* fork_join_pool,
     iree_allocator_t host_allocator, iree_byte_span_t storage,
     iree_hal_command_buffer_t** out_command_buffer) {
   IREE_ASSERT_ARGUMENT(out_command_buffer);
@@ -113,6 +116,7 @@ iree_status_t iree_hal_inline_command_buffer_initialize(
       binding_capacity, (uint8_t*)command_buffer + sizeof(*command_buffer),
       &iree_hal_inline_command_buffer_vtable, &command_buffer->base);
   command_buffer->host_allocator = host_allocator;
+  command_buffer->fork_join_pool = fork_join_pool;
   iree_hal_inline_command_buffer_reset(command_buffer);
 
   *out_command_buffer = &command_buffer->base;
@@ -132,6 +136,7 @@ iree_status_t iree_hal_inline_command_buffer_create(
     iree_hal_allocator_t* device_allocator, iree_hal_command_buffer_mode_t mode,
     iree_hal_command_category_t command_categories,
     iree_hal_queue_affinity_t queue_affinity, iree_host_size_t binding_capacity,
+    iree_hal_local_fork_join_pool_t* fork_join_pool,
     iree_allocator_t host_allocator,
     iree_hal_command_buffer_t** out_command_buffer) {
   IREE_ASSERT_ARGUMENT(out_command_buffer);
@@ -147,7 +152,7 @@ iree_status_t iree_hal_inline_command_buffer_create(
   if (iree_status_is_ok(status)) {
     status = iree_hal_inline_command_buffer_initialize(
         device_allocator, mode, command_categories, queue_affinity,
-        binding_capacity, host_allocator,
+        binding_capacity, fork_join_pool, host_allocator,
         iree_make_byte_span(storage, iree_hal_inline_command_buffer_size(
                                          mode, binding_capacity)),
         &command_buffer);
@@ -413,8 +418,10 @@ static iree_status_t iree_hal_inline_command_buffer_dispatch(
     dispatch_state->workgroup_count_z = config.workgroup_count[2];
   }
 
-  // Single-threaded.
-  dispatch_state->max_concurrency = 1;
+  // Single-threaded unless workgroups are split across a fork-join pool.
+  dispatch_state->max_concurrency =
+      (uint32_t)iree_hal_local_fork_join_pool_concurrency(
+          command_buffer->fork_join_pool);
 
   // Push constants are pulled directly from the args. Note that we require 4
   // byte alignment and if the input buffer is not aligned we have to fail.
@@ -482,9 +489,16 @@ static iree_status_t iree_hal_inline_command_buffer_dispatch(
   // floating point state. Reset it.
   iree_fpu_state_t fpu_state =
       iree_fpu_state_push(IREE_FPU_STATE_FLAG_FLUSH_DENORMALS_TO_ZERO);
-  iree_status_t status = iree_hal_local_executable_issue_dispatch_inline(
-      local_executable, export_ordinal, dispatch_state,
-      command_buffer->state.processor_id, local_memory);
+  iree_status_t status = iree_ok_status();
+  if (command_buffer->fork_join_pool) {
+    status = iree_hal_local_fork_join_pool_issue_dispatch(
+        command_buffer->fork_join_pool, local_executable, export_ordinal,
+        dispatch_state, command_buffer->state.processor_id, local_memory);
+  } else {
+    status = iree_hal_local_executable_issue_dispatch_inline(
+        local_executable, export_ordinal, dispatch_state,
+        command_buffer->state.processor_id, local_memory);
+  }
   iree_fpu_state_pop(fpu_state);
 
   if (local_memory.data) {
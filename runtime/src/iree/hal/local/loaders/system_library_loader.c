@@ -124,9 +124,12 @@ static iree_status_t iree_hal_system_executable_load(
     library_data = executable_data;
   }
 
+  // Executables have no mutable global state and may be loaded many times
+  // (once per context/device) so identical ones share a single instance.
   IREE_RETURN_IF_ERROR(iree_dynamic_library_load_from_memory(
       iree_make_cstring_view("aot"), library_data,
-      IREE_DYNAMIC_LIBRARY_FLAG_NONE, host_allocator, &executable->handle));
+      IREE_DYNAMIC_LIBRARY_FLAG_DEDUPLICATE, host_allocator,
+      &executable->handle));
 
   if (debug_data.data_length > 0) {
     IREE_RETURN_IF_ERROR(iree_dynamic_library_attach_symbols_from_memory(
@@ -6,7 +6,10 @@
 
 #include "iree/hal/local/local_executable.h"
 
+#include "iree/hal/local/dispatch_capture.h"
+#include "iree/hal/local/dispatch_statistics.h"
 #include "iree/hal/local/executable_environment.h"
+#include "iree/hal/local/profiling.h"
 
 void iree_hal_local_executable_initialize(
     const iree_hal_local_executable_vtable_t* vtable,
@@ -39,10 +42,43 @@ iree_status_t iree_hal_local_executable_issue_call(
   IREE_ASSERT_ARGUMENT(executable);
   IREE_ASSERT_ARGUMENT(dispatch_state);
   IREE_ASSERT_ARGUMENT(workgroup_state);
-  return ((const iree_hal_local_executable_vtable_t*)
-              executable->resource.vtable)
-      ->issue_call(executable, ordinal, dispatch_state, workgroup_state,
-                   worker_id);
+  const iree_hal_local_executable_vtable_t* vtable =
+      (const iree_hal_local_executable_vtable_t*)executable->resource.vtable;
+  iree_hal_local_dispatch_capture_t* capture =
+      iree_hal_local_dispatch_capture_active();
+  if (IREE_UNLIKELY(capture) && workgroup_state->workgroup_id_x == 0 &&
+      workgroup_state->workgroup_id_y == 0 &&
+      workgroup_state->workgroup_id_z == 0) {
+    iree_hal_local_dispatch_capture_record(
+        capture, (iree_hal_executable_t*)executable, ordinal, dispatch_state);
+  }
+  iree_hal_local_profiler_t* profiler = iree_hal_local_profiler_acquire();
+  iree_hal_local_dispatch_statistics_t* statistics =
+      iree_hal_local_dispatch_statistics_active();
+  if (IREE_LIKELY(!profiler && !statistics)) {
+    return vtable->issue_call(executable, ordinal, dispatch_state,
+                              workgroup_state, worker_id);
+  }
+  iree_hal_local_profiler_sample_t sample;
+  if (profiler) iree_hal_local_profiler_sample_begin(profiler, &sample);
+  iree_time_t start_time_ns = statistics ? iree_time_now() : 0;
+  iree_status_t status = vtable->issue_call(
+      executable, ordinal, dispatch_state, workgroup_state, worker_id);
+  const bool first_workgroup = workgroup_state->workgroup_id_x == 0 &&
+                               workgroup_state->workgroup_id_y == 0 &&
+                               workgroup_state->workgroup_id_z == 0;
+  if (statistics) {
+    iree_hal_local_dispatch_statistics_record(
+        statistics, (iree_hal_executable_t*)executable, ordinal,
+        dispatch_state, first_workgroup, iree_time_now() - start_time_ns);
+  }
+  if (profiler) {
+    iree_hal_local_profiler_sample_end(profiler, &sample,
+                                       (iree_hal_executable_t*)executable,
+                                       ordinal, first_workgroup);
+    iree_hal_local_profiler_release(profiler);
+  }
+  return status;
 }
 
 iree_status_t iree_hal_local_executable_issue_dispatch_inline(
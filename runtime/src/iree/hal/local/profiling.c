@@ -0,0 +1,585 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/local/profiling.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "iree/base/internal/synchronization.h"
+#include "iree/base/internal/threading.h"
+#include "iree/hal/local/export_table.h"
+
+#if defined(IREE_PLATFORM_LINUX) || defined(IREE_PLATFORM_ANDROID)
+#define IREE_HAL_LOCAL_PROFILING_PERF_EVENT 1
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#define IREE_HAL_LOCAL_PROFILING_PERF_EVENT 0
+#endif  // IREE_PLATFORM_LINUX || IREE_PLATFORM_ANDROID
+
+iree_atomic_intptr_t iree_hal_local_profiler_active_ = IREE_ATOMIC_VAR_INIT(0);
+iree_atomic_int32_t iree_hal_local_profiler_readers_ = IREE_ATOMIC_VAR_INIT(0);
+
+// Incremented on each profiler begin so that threads notice that counter
+// groups opened for a prior profiler are stale.
+static iree_atomic_int32_t iree_hal_local_profiler_generation_ =
+    IREE_ATOMIC_VAR_INIT(0);
+
+//===----------------------------------------------------------------------===//
+// perf_event counter groups
+//===----------------------------------------------------------------------===//
+
+// A group of counters measuring a single thread, read with a single syscall.
+typedef struct iree_hal_local_counter_group_t {
+  // Generation of the profiler the group was opened for.
+  int32_t generation;
+  // Number of counters in the group, the counter each read value maps to, and
+  // the fd of each counter. fds[0] is the group leader that is read.
+  uint32_t count;
+  iree_hal_local_profile_counter_t
+      counters[IREE_HAL_LOCAL_PROFILE_COUNTER_COUNT];
+  int fds[IREE_HAL_LOCAL_PROFILE_COUNTER_COUNT];
+} iree_hal_local_counter_group_t;
+
+static iree_hal_local_thread_local iree_hal_local_counter_group_t
+    iree_hal_local_thread_counter_group_;
+
+#if IREE_HAL_LOCAL_PROFILING_PERF_EVENT
+
+static const uint64_t
+    iree_hal_local_perf_event_configs[IREE_HAL_LOCAL_PROFILE_COUNTER_COUNT] = {
+        [IREE_HAL_LOCAL_PROFILE_COUNTER_CYCLES] = PERF_COUNT_HW_CPU_CYCLES,
+        [IREE_HAL_LOCAL_PROFILE_COUNTER_INSTRUCTIONS] =
+            PERF_COUNT_HW_INSTRUCTIONS,
+        [IREE_HAL_LOCAL_PROFILE_COUNTER_CACHE_MISSES] =
+            PERF_COUNT_HW_CACHE_MISSES,
+        [IREE_HAL_LOCAL_PROFILE_COUNTER_STALLED_CYCLES_BACKEND] =
+            PERF_COUNT_HW_STALLED_CYCLES_BACKEND,
+};
+
+static int iree_hal_local_perf_event_open(iree_hal_local_profile_counter_t
+                                              counter,
+                                          int group_fd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = iree_hal_local_perf_event_configs[counter];
+  attr.read_format = PERF_FORMAT_GROUP;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // Measure the calling thread on whichever CPU it runs on.
+  return (int)syscall(__NR_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1,
+                      group_fd, PERF_FLAG_FD_CLOEXEC);
+}
+
+// Opens the counters in |counter_mask| for the calling thread. Counters that
+// the hardware or kernel do not support are dropped from the group.
+static void iree_hal_local_counter_group_open(
+    uint32_t counter_mask, iree_hal_local_counter_group_t* group) {
+  group->count = 0;
+  for (int i = 0; i < IREE_HAL_LOCAL_PROFILE_COUNTER_COUNT; ++i) {
+    if (!(counter_mask & (1u << i))) continue;
+    int fd = iree_hal_local_perf_event_open((iree_hal_local_profile_counter_t)i,
+                                            group->count ? group->fds[0] : -1);
+    if (fd < 0) continue;
+    group->counters[group->count] = (iree_hal_local_profile_counter_t)i;
+    group->fds[group->count] = fd;
+    ++group->count;
+  }
+}
+
+static void iree_hal_local_counter_group_close(
+    iree_hal_local_counter_group_t* group) {
+  // Members first: the group is torn down when the last fd is closed.
+  for (uint32_t i = group->count; i > 0; --i) {
+    close(group->fds[i - 1]);
+  }
+  group->count = 0;
+}
+
+static bool iree_hal_local_counter_group_read(
+    const iree_hal_local_counter_group_t* group,
+    uint64_t values[IREE_HAL_LOCAL_PROFILE_COUNTER_COUNT]) {
+  if (!group->count) return false;
+  uint64_t buffer[1 + IREE_HAL_LOCAL_PROFILE_COUNTER_COUNT];
+  ssize_t length = read(group->fds[0], buffer, sizeof(buffer));
+  if (length < (ssize_t)((1 + group->count) * sizeof(uint64_t))) return false;
+  for (uint32_t i = 0; i < group->count; ++i) {
+    values[group->counters[i]] = buffer[1 + i];
+  }
+  return true;
+}
+
+#endif  // IREE_HAL_LOCAL_PROFILING_PERF_EVENT
+
+//===----------------------------------------------------------------------===//
+// iree_hal_local_profiler_t
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_hal_local_profiler_entry_t {
+  iree_hal_local_export_entry_t base;
+  // Summed across all workers without holding the mutex.
+  iree_atomic_int64_t dispatch_count;
+  iree_atomic_int64_t workgroup_count;
+  iree_atomic_int64_t counters[IREE_HAL_LOCAL_PROFILE_COUNTER_COUNT];
+} iree_hal_local_profiler_entry_t;
+
+// The entry last sampled into by the calling thread.
+static iree_hal_local_thread_local iree_hal_local_export_cache_t
+    iree_hal_local_profiler_cache_;
+
+struct iree_hal_local_profiler_t {
+  iree_allocator_t host_allocator;
+  int32_t generation;
+  // Counters requested of each thread; threads may end up with fewer.
+  uint32_t counter_mask;
+  char* file_path;
+
+  iree_slim_mutex_t mutex;
+  // iree_hal_local_profiler_entry_t records guarded by the mutex.
+  iree_hal_local_export_table_t table;
+  // Counter groups opened on worker threads, closed when profiling ends.
+  iree_host_size_t group_count;
+  iree_host_size_t group_capacity;
+  iree_hal_local_counter_group_t* groups;
+};
+
+static iree_status_t iree_hal_local_profiler_probe(
+    uint32_t* out_counter_mask) {
+  *out_counter_mask = 0;
+#if IREE_HAL_LOCAL_PROFILING_PERF_EVENT
+  iree_hal_local_counter_group_t group;
+  iree_hal_local_counter_group_open(
+      (1u << IREE_HAL_LOCAL_PROFILE_COUNTER_COUNT) - 1, &group);
+  for (uint32_t i = 0; i < group.count; ++i) {
+    *out_counter_mask |= 1u << group.counters[i];
+  }
+  int error = errno;
+  iree_hal_local_counter_group_close(&group);
+  if (!*out_counter_mask) {
+    return iree_make_status(
+        iree_status_code_from_errno(error),
+        "perf_event_open failed (%s); hardware counters may be unavailable "
+        "in this environment or restricted by "
+        "/proc/sys/kernel/perf_event_paranoid",
+        strerror(error));
+  }
+  return iree_ok_status();
+#else
+  return iree_make_status(IREE_STATUS_UNAVAILABLE,
+                          "hardware counter profiling requires perf_event "
+                          "support (Linux/Android)");
+#endif  // IREE_HAL_LOCAL_PROFILING_PERF_EVENT
+}
+
+iree_status_t iree_hal_local_profiler_begin(
+    const iree_hal_device_profiling_options_t* options,
+    iree_allocator_t host_allocator, iree_hal_local_profiler_t** out_profiler) {
+  IREE_ASSERT_ARGUMENT(options);
+  IREE_ASSERT_ARGUMENT(out_profiler);
+  *out_profiler = NULL;
+  const iree_hal_device_profiling_mode_t counter_modes =
+      IREE_HAL_DEVICE_PROFILING_MODE_DISPATCH_COUNTERS |
+      IREE_HAL_DEVICE_PROFILING_MODE_EXECUTABLE_COUNTERS;
+  if (!iree_any_bit_set(options->mode, counter_modes)) {
+    return iree_ok_status();
+  }
+  if (!options->file_path || !strlen(options->file_path)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "a profiling file path is required to capture "
+                            "dispatch counters");
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  uint32_t counter_mask = 0;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_hal_local_profiler_probe(&counter_mask));
+
+  iree_hal_local_profiler_t* profiler = NULL;
+  iree_host_size_t file_path_length = strlen(options->file_path);
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator,
+                                sizeof(*profiler) + file_path_length + 1,
+                                (void**)&profiler));
+  memset(profiler, 0, sizeof(*profiler));
+  profiler->host_allocator = host_allocator;
+  profiler->counter_mask = counter_mask;
+  profiler->file_path = (char*)profiler + sizeof(*profiler);
+  memcpy(profiler->file_path, options->file_path, file_path_length + 1);
+  iree_slim_mutex_initialize(&profiler->mutex);
+  iree_hal_local_export_table_initialize(
+      sizeof(iree_hal_local_profiler_entry_t), host_allocator,
+      &profiler->table);
+
+  // Bump the generation before publishing so no thread can match a counter
+  // group or cache entry from a prior profiler.
+  profiler->generation =
+      iree_atomic_fetch_add(&iree_hal_local_profiler_generation_, 1,
+                            iree_memory_order_relaxed) +
+      1;
+  intptr_t expected = 0;
+  if (!iree_atomic_compare_exchange_strong(
+          &iree_hal_local_profiler_active_, &expected, (intptr_t)profiler,
+          iree_memory_order_acq_rel, iree_memory_order_relaxed)) {
+    iree_slim_mutex_deinitialize(&profiler->mutex);
+    iree_allocator_free(host_allocator, profiler);
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_FAILED_PRECONDITION,
+                            "another device is already capturing dispatch "
+                            "counters in this process");
+  }
+
+  *out_profiler = profiler;
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+// Returns the counter group of the calling thread, opening it if this is the
+// first sample on the thread for |profiler|.
+static iree_hal_local_counter_group_t* iree_hal_local_profiler_thread_group(
+    iree_hal_local_profiler_t* profiler) {
+  iree_hal_local_counter_group_t* group =
+      &iree_hal_local_thread_counter_group_;
+  if (IREE_LIKELY(group->generation == profiler->generation)) return group;
+  group->generation = profiler->generation;
+  group->count = 0;
+#if IREE_HAL_LOCAL_PROFILING_PERF_EVENT
+  iree_hal_local_counter_group_open(profiler->counter_mask, group);
+  if (!group->count) return group;
+
+  // Track the group so it can be closed when profiling ends; if that fails we
+  // close it now and the thread goes unmeasured.
+  iree_slim_mutex_lock(&profiler->mutex);
+  iree_status_t status = iree_ok_status();
+  if (profiler->group_count == profiler->group_capacity) {
+    iree_host_size_t new_capacity = iree_max(8, profiler->group_capacity * 2);
+    status = iree_allocator_realloc(profiler->host_allocator,
+                                    new_capacity * sizeof(*profiler->groups),
+                                    (void**)&profiler->groups);
+    if (iree_status_is_ok(status)) profiler->group_capacity = new_capacity;
+  }
+  if (iree_status_is_ok(status)) {
+    profiler->groups[profiler->group_count++] = *group;
+  }
+  iree_slim_mutex_unlock(&profiler->mutex);
+  if (!iree_status_is_ok(status)) {
+    iree_status_ignore(status);
+    iree_hal_local_counter_group_close(group);
+  }
+#endif  // IREE_HAL_LOCAL_PROFILING_PERF_EVENT
+  return group;
+}
+
+iree_hal_local_profiler_t* iree_hal_local_profiler_acquire_slow(void) {
+  // Register as a reader before loading the profiler again so that either
+  // iree_hal_local_profiler_end observes the reader and waits for it or this
+  // observes that the profiler was unpublished.
+  iree_atomic_fetch_add(&iree_hal_local_profiler_readers_, 1,
+                        iree_memory_order_seq_cst);
+  iree_hal_local_profiler_t* profiler =
+      (iree_hal_local_profiler_t*)iree_atomic_load(
+          &iree_hal_local_profiler_active_, iree_memory_order_seq_cst);
+  if (!profiler) {
+    iree_atomic_fetch_sub(&iree_hal_local_profiler_readers_, 1,
+                          iree_memory_order_release);
+  }
+  return profiler;
+}
+
+void iree_hal_local_profiler_sample_begin(
+    iree_hal_local_profiler_t* profiler,
+    iree_hal_local_profiler_sample_t* out_sample) {
+  out_sample->valid = false;
+#if IREE_HAL_LOCAL_PROFILING_PERF_EVENT
+  iree_hal_local_counter_group_t* group =
+      iree_hal_local_profiler_thread_group(profiler);
+  memset(out_sample->values, 0, sizeof(out_sample->values));
+  out_sample->valid =
+      iree_hal_local_counter_group_read(group, out_sample->values);
+#endif  // IREE_HAL_LOCAL_PROFILING_PERF_EVENT
+}
+
+void iree_hal_local_profiler_sample_end(
+    iree_hal_local_profiler_t* profiler,
+    const iree_hal_local_profiler_sample_t* sample,
+    iree_hal_executable_t* executable, iree_host_size_t ordinal,
+    bool first_workgroup) {
+  uint64_t values[IREE_HAL_LOCAL_PROFILE_COUNTER_COUNT] = {0};
+  bool valid = false;
+#if IREE_HAL_LOCAL_PROFILING_PERF_EVENT
+  valid = sample->valid &&
+          iree_hal_local_counter_group_read(
+              &iree_hal_local_thread_counter_group_, values);
+#endif  // IREE_HAL_LOCAL_PROFILING_PERF_EVENT
+
+  iree_hal_local_export_cache_t* cache = &iree_hal_local_profiler_cache_;
+  iree_hal_local_profiler_entry_t* entry =
+      (iree_hal_local_profiler_entry_t*)iree_hal_local_export_cache_lookup(
+          cache, profiler->generation, executable, ordinal);
+  if (IREE_UNLIKELY(!entry)) {
+    iree_slim_mutex_lock(&profiler->mutex);
+    entry = (iree_hal_local_profiler_entry_t*)
+        iree_hal_local_export_table_lookup(&profiler->table, executable,
+                                           ordinal);
+    iree_slim_mutex_unlock(&profiler->mutex);
+    if (!entry) return;
+    iree_hal_local_export_cache_update(cache, profiler->generation, executable,
+                                       ordinal, &entry->base);
+  }
+
+  if (first_workgroup) {
+    iree_atomic_fetch_add(&entry->dispatch_count, 1,
+                          iree_memory_order_relaxed);
+  }
+  iree_atomic_fetch_add(&entry->workgroup_count, 1, iree_memory_order_relaxed);
+  if (valid) {
+    for (int i = 0; i < IREE_HAL_LOCAL_PROFILE_COUNTER_COUNT; ++i) {
+      iree_atomic_fetch_add(&entry->counters[i],
+                            (int64_t)(values[i] - sample->values[i]),
+                            iree_memory_order_relaxed);
+    }
+  }
+}
+
+iree_status_t iree_hal_local_profiler_flush(
+    iree_hal_local_profiler_t* profiler) {
+  IREE_ASSERT_ARGUMENT(profiler);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  FILE* file = fopen(profiler->file_path, "wb");
+  if (!file) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(iree_status_code_from_errno(errno),
+                            "failed to open profile file '%s'",
+                            profiler->file_path);
+  }
+
+  iree_slim_mutex_lock(&profiler->mutex);
+  iree_hal_local_profile_file_header_t header = {
+      .magic = IREE_HAL_LOCAL_PROFILE_FILE_MAGIC,
+      .version = IREE_HAL_LOCAL_PROFILE_FILE_VERSION_0,
+      .counter_mask = profiler->counter_mask,
+      .record_count = (uint32_t)profiler->table.entry_count,
+  };
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+  static const uint8_t padding[8] = {0};
+  for (iree_host_size_t i = 0; ok && i < profiler->table.entry_capacity;
+       ++i) {
+    iree_hal_local_profiler_entry_t* entry =
+        (iree_hal_local_profiler_entry_t*)profiler->table.entries[i];
+    if (!entry) continue;
+    iree_hal_local_profile_file_record_t record = {
+        .name_length = (uint32_t)entry->base.name.size,
+        .dispatch_count = (uint64_t)iree_atomic_load(
+            &entry->dispatch_count, iree_memory_order_relaxed),
+        .workgroup_count = (uint64_t)iree_atomic_load(
+            &entry->workgroup_count, iree_memory_order_relaxed),
+    };
+    for (int j = 0; j < IREE_HAL_LOCAL_PROFILE_COUNTER_COUNT; ++j) {
+      record.counters[j] = (uint64_t)iree_atomic_load(
+          &entry->counters[j], iree_memory_order_relaxed);
+    }
+    iree_string_view_t name = entry->base.name;
+    iree_host_size_t padding_length =
+        iree_host_align(name.size, 8) - name.size;
+    ok = fwrite(&record, sizeof(record), 1, file) == 1 &&
+         fwrite(name.data, 1, name.size, file) == name.size &&
+         fwrite(padding, 1, padding_length, file) == padding_length;
+  }
+  iree_slim_mutex_unlock(&profiler->mutex);
+
+  ok = fclose(file) == 0 && ok;
+  IREE_TRACE_ZONE_END(z0);
+  return ok ? iree_ok_status()
+            : iree_make_status(IREE_STATUS_DATA_LOSS,
+                               "failed to write profile file '%s'",
+                               profiler->file_path);
+}
+
+iree_status_t iree_hal_local_profiler_end(iree_hal_local_profiler_t* profiler) {
+  if (!profiler) return iree_ok_status();
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Unpublish the profiler and wait for threads that acquired it before then
+  // to finish their current workgroup. Threads acquiring it afterward observe
+  // it is no longer active and release it without sampling.
+  iree_atomic_store(&iree_hal_local_profiler_active_, 0,
+                    iree_memory_order_seq_cst);
+  while (iree_atomic_load(&iree_hal_local_profiler_readers_,
+                          iree_memory_order_seq_cst) != 0) {
+    iree_thread_yield();
+  }
+
+  iree_status_t status = iree_hal_local_profiler_flush(profiler);
+
+#if IREE_HAL_LOCAL_PROFILING_PERF_EVENT
+  for (iree_host_size_t i = 0; i < profiler->group_count; ++i) {
+    iree_hal_local_counter_group_close(&profiler->groups[i]);
+  }
+#endif  // IREE_HAL_LOCAL_PROFILING_PERF_EVENT
+  iree_allocator_free(profiler->host_allocator, profiler->groups);
+  iree_hal_local_export_table_deinitialize(&profiler->table);
+  iree_slim_mutex_deinitialize(&profiler->mutex);
+  iree_allocator_free(profiler->host_allocator, profiler);
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+//===----------------------------------------------------------------------===//
+// Profile file summaries
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_hal_local_profile_summary_row_t {
+  const iree_hal_local_profile_file_record_t* record;
+  iree_string_view_t name;
+} iree_hal_local_profile_summary_row_t;
+
+static int iree_hal_local_profile_summary_row_compare(const void* lhs,
+                                                      const void* rhs) {
+  uint64_t lhs_cycles =
+      ((const iree_hal_local_profile_summary_row_t*)lhs)
+          ->record->counters[IREE_HAL_LOCAL_PROFILE_COUNTER_CYCLES];
+  uint64_t rhs_cycles =
+      ((const iree_hal_local_profile_summary_row_t*)rhs)
+          ->record->counters[IREE_HAL_LOCAL_PROFILE_COUNTER_CYCLES];
+  return lhs_cycles < rhs_cycles ? 1 : (lhs_cycles > rhs_cycles ? -1 : 0);
+}
+
+static double iree_hal_local_profile_ratio(uint64_t numerator,
+                                           uint64_t denominator) {
+  return denominator ? (double)numerator / (double)denominator : 0.0;
+}
+
+// Reads the entire file at |path| into |out_data| allocated from
+// |host_allocator|.
+static iree_status_t iree_hal_local_profile_file_read(
+    const char* path, iree_allocator_t host_allocator,
+    iree_byte_span_t* out_data) {
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+    return iree_make_status(iree_status_code_from_errno(errno),
+                            "failed to open profile file '%s'", path);
+  }
+  iree_status_t status = iree_ok_status();
+  long length = -1;
+  if (fseek(file, 0, SEEK_END) == 0) length = ftell(file);
+  if (length < 0 || fseek(file, 0, SEEK_SET) != 0) {
+    status = iree_make_status(IREE_STATUS_DATA_LOSS,
+                              "failed to query profile file '%s' size", path);
+  }
+  uint8_t* data = NULL;
+  if (iree_status_is_ok(status)) {
+    status = iree_allocator_malloc(host_allocator,
+                                   iree_max(1, (iree_host_size_t)length),
+                                   (void**)&data);
+  }
+  if (iree_status_is_ok(status) &&
+      fread(data, 1, (size_t)length, file) != (size_t)length) {
+    status = iree_make_status(IREE_STATUS_DATA_LOSS,
+                              "failed to read profile file '%s'", path);
+  }
+  fclose(file);
+  if (iree_status_is_ok(status)) {
+    *out_data = iree_make_byte_span(data, (iree_host_size_t)length);
+  } else {
+    iree_allocator_free(host_allocator, data);
+  }
+  return status;
+}
+
+IREE_API_EXPORT iree_status_t iree_hal_local_profile_file_fprint(
+    FILE* file, const char* path, iree_allocator_t host_allocator) {
+  IREE_ASSERT_ARGUMENT(file);
+  IREE_ASSERT_ARGUMENT(path);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_byte_span_t data = iree_byte_span_empty();
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_hal_local_profile_file_read(path, host_allocator, &data));
+
+  iree_status_t status = iree_ok_status();
+  const iree_hal_local_profile_file_header_t* header =
+      (const iree_hal_local_profile_file_header_t*)data.data;
+  if (data.data_length < sizeof(*header) ||
+      header->magic != IREE_HAL_LOCAL_PROFILE_FILE_MAGIC ||
+      header->version != IREE_HAL_LOCAL_PROFILE_FILE_VERSION_0) {
+    status = iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "'%s' is not a local HAL profile file", path);
+  }
+
+  iree_hal_local_profile_summary_row_t* rows = NULL;
+  if (iree_status_is_ok(status)) {
+    status = iree_allocator_malloc(
+        host_allocator, iree_max(1, header->record_count) * sizeof(*rows),
+        (void**)&rows);
+  }
+  iree_host_size_t offset = sizeof(*header);
+  for (uint32_t i = 0; iree_status_is_ok(status) && i < header->record_count;
+       ++i) {
+    const iree_hal_local_profile_file_record_t* record =
+        (const iree_hal_local_profile_file_record_t*)(data.data + offset);
+    if (offset + sizeof(*record) > data.data_length ||
+        offset + sizeof(*record) + record->name_length > data.data_length) {
+      status = iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                                "profile file '%s' is truncated", path);
+      break;
+    }
+    rows[i].record = record;
+    rows[i].name = iree_make_string_view(
+        (const char*)data.data + offset + sizeof(*record),
+        record->name_length);
+    offset += sizeof(*record) + iree_host_align(record->name_length, 8);
+  }
+
+  if (iree_status_is_ok(status)) {
+    qsort(rows, header->record_count, sizeof(*rows),
+          iree_hal_local_profile_summary_row_compare);
+    uint64_t total_cycles = 0;
+    for (uint32_t i = 0; i < header->record_count; ++i) {
+      total_cycles +=
+          rows[i].record->counters[IREE_HAL_LOCAL_PROFILE_COUNTER_CYCLES];
+    }
+    const bool has_stalls =
+        header->counter_mask &
+        (1u << IREE_HAL_LOCAL_PROFILE_COUNTER_STALLED_CYCLES_BACKEND);
+    fprintf(file,
+            "%6s %10s %12s %16s %6s %8s %8s  %s\n", "cyc%", "dispatches",
+            "workgroups", "cycles", "IPC", "MPKI", "stall%", "export");
+    for (uint32_t i = 0; i < header->record_count; ++i) {
+      const uint64_t* counters = rows[i].record->counters;
+      uint64_t cycles = counters[IREE_HAL_LOCAL_PROFILE_COUNTER_CYCLES];
+      uint64_t instructions =
+          counters[IREE_HAL_LOCAL_PROFILE_COUNTER_INSTRUCTIONS];
+      uint64_t cache_misses =
+          counters[IREE_HAL_LOCAL_PROFILE_COUNTER_CACHE_MISSES];
+      uint64_t stalled_cycles =
+          counters[IREE_HAL_LOCAL_PROFILE_COUNTER_STALLED_CYCLES_BACKEND];
+      char stalls[16] = "-";
+      if (has_stalls) {
+        snprintf(stalls, sizeof(stalls), "%.1f",
+                 100.0 * iree_hal_local_profile_ratio(stalled_cycles, cycles));
+      }
+      fprintf(file,
+              "%6.2f %10" PRIu64 " %12" PRIu64 " %16" PRIu64
+              " %6.2f %8.2f %8s  %.*s\n",
+              100.0 * iree_hal_local_profile_ratio(cycles, total_cycles),
+              rows[i].record->dispatch_count, rows[i].record->workgroup_count,
+              cycles, iree_hal_local_profile_ratio(instructions, cycles),
+              1000.0 * iree_hal_local_profile_ratio(cache_misses, instructions),
+              stalls, (int)rows[i].name.size, rows[i].name.data);
+    }
+  }
+
+  iree_allocator_free(host_allocator, rows);
+  iree_allocator_free(host_allocator, data.data);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
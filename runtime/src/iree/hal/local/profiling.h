@@ -0,0 +1,151 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_HAL_LOCAL_PROFILING_H_
+#define IREE_HAL_LOCAL_PROFILING_H_
+
+#include <stdio.h>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/atomics.h"
+#include "iree/hal/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+//===----------------------------------------------------------------------===//
+// Profile file format
+//===----------------------------------------------------------------------===//
+
+// Hardware counters captured per dispatch.
+typedef enum iree_hal_local_profile_counter_e {
+  IREE_HAL_LOCAL_PROFILE_COUNTER_CYCLES = 0,
+  IREE_HAL_LOCAL_PROFILE_COUNTER_INSTRUCTIONS,
+  IREE_HAL_LOCAL_PROFILE_COUNTER_CACHE_MISSES,
+  IREE_HAL_LOCAL_PROFILE_COUNTER_STALLED_CYCLES_BACKEND,
+  IREE_HAL_LOCAL_PROFILE_COUNTER_COUNT,
+} iree_hal_local_profile_counter_t;
+
+#define IREE_HAL_LOCAL_PROFILE_FILE_MAGIC 0x504C5249u  // 'IRLP'
+#define IREE_HAL_LOCAL_PROFILE_FILE_VERSION_0 0u
+
+// Header at the start of a profile file. Followed by |record_count| records.
+// All values are in host byte order: files are meant to be summarized on the
+// machine that produced them.
+typedef struct iree_hal_local_profile_file_header_t {
+  uint32_t magic;
+  uint32_t version;
+  // Bit i is set if IREE_HAL_LOCAL_PROFILE_COUNTER_* i was captured. Counters
+  // that were not captured are zero in all records.
+  uint32_t counter_mask;
+  uint32_t record_count;
+} iree_hal_local_profile_file_header_t;
+
+// Aggregate statistics for one executable export. Followed by |name_length|
+// bytes of the export name padded with zeros to a multiple of 8 bytes.
+typedef struct iree_hal_local_profile_file_record_t {
+  uint32_t name_length;
+  uint32_t reserved;
+  // Number of dispatches of the export.
+  uint64_t dispatch_count;
+  // Total number of workgroups executed across all dispatches.
+  uint64_t workgroup_count;
+  // Counter totals summed across all workgroups on all threads.
+  uint64_t counters[IREE_HAL_LOCAL_PROFILE_COUNTER_COUNT];
+} iree_hal_local_profile_file_record_t;
+
+// Prints a summary table of the profile file at |path| to |file|, ordered by
+// descending cycle count with derived IPC, cache misses per thousand
+// instructions, and the fraction of backend-stalled cycles which together point
+// at memory-bound dispatches.
+IREE_API_EXPORT iree_status_t iree_hal_local_profile_file_fprint(
+    FILE* file, const char* path, iree_allocator_t host_allocator);
+
+//===----------------------------------------------------------------------===//
+// iree_hal_local_profiler_t
+//===----------------------------------------------------------------------===//
+
+// Captures hardware performance counters around each workgroup of each
+// dispatch issued through iree_hal_local_executable_issue_call and aggregates
+// them per executable export. Uses perf_event_open with one counter group per
+// worker thread and is only available on Linux/Android.
+//
+// Executables do not know which device issued them so at most one profiler can
+// be active in the process at a time. Ending a profiler waits for dispatches
+// sampling into it to finish their current workgroup before freeing it.
+typedef struct iree_hal_local_profiler_t iree_hal_local_profiler_t;
+
+// Begins profiling as specified by |options| and returns the active profiler in
+// |out_profiler|. Returns NULL without error if |options| do not request any
+// counter mode (IREE_HAL_DEVICE_PROFILING_MODE_DISPATCH_COUNTERS or
+// IREE_HAL_DEVICE_PROFILING_MODE_EXECUTABLE_COUNTERS) as there's nothing to
+// capture. |options.file_path| is required and is overwritten on every flush.
+iree_status_t iree_hal_local_profiler_begin(
+    const iree_hal_device_profiling_options_t* options,
+    iree_allocator_t host_allocator, iree_hal_local_profiler_t** out_profiler);
+
+// Writes the statistics aggregated so far to the profile file.
+iree_status_t iree_hal_local_profiler_flush(
+    iree_hal_local_profiler_t* profiler);
+
+// Flushes and ends profiling, freeing |profiler|.
+iree_status_t iree_hal_local_profiler_end(iree_hal_local_profiler_t* profiler);
+
+// Counter values sampled at the start of a workgroup.
+typedef struct iree_hal_local_profiler_sample_t {
+  bool valid;
+  uint64_t values[IREE_HAL_LOCAL_PROFILE_COUNTER_COUNT];
+} iree_hal_local_profiler_sample_t;
+
+// The active profiler, if any. Checked by the dispatch path on every call so
+// that profiling costs a single relaxed load when disabled.
+extern iree_atomic_intptr_t iree_hal_local_profiler_active_;
+
+// Number of threads between iree_hal_local_profiler_acquire and
+// iree_hal_local_profiler_release.
+extern iree_atomic_int32_t iree_hal_local_profiler_readers_;
+
+iree_hal_local_profiler_t* iree_hal_local_profiler_acquire_slow(void);
+
+// Returns the active profiler, if any, and keeps it from being freed until
+// iree_hal_local_profiler_release is called.
+static inline iree_hal_local_profiler_t* iree_hal_local_profiler_acquire(
+    void) {
+  if (IREE_LIKELY(!iree_atomic_load(&iree_hal_local_profiler_active_,
+                                    iree_memory_order_relaxed))) {
+    return NULL;
+  }
+  return iree_hal_local_profiler_acquire_slow();
+}
+
+// Releases a profiler returned by iree_hal_local_profiler_acquire.
+static inline void iree_hal_local_profiler_release(
+    iree_hal_local_profiler_t* profiler) {
+  if (!profiler) return;
+  iree_atomic_fetch_sub(&iree_hal_local_profiler_readers_, 1,
+                        iree_memory_order_release);
+}
+
+// Samples the counters of the calling thread before a workgroup runs.
+void iree_hal_local_profiler_sample_begin(
+    iree_hal_local_profiler_t* profiler,
+    iree_hal_local_profiler_sample_t* out_sample);
+
+// Samples the counters of the calling thread after a workgroup of export
+// |ordinal| of |executable| ran and accumulates the delta since |sample|.
+// |first_workgroup| is set for one workgroup per dispatch.
+void iree_hal_local_profiler_sample_end(
+    iree_hal_local_profiler_t* profiler,
+    const iree_hal_local_profiler_sample_t* sample,
+    iree_hal_executable_t* executable, iree_host_size_t ordinal,
+    bool first_workgroup);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_HAL_LOCAL_PROFILING_H_
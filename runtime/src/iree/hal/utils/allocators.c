@@ -25,6 +25,9 @@ iree_status_t iree_hal_configure_allocator_from_spec(
   } else if (iree_string_view_equal(allocator_name, IREE_SV("debug"))) {
     status = iree_hal_debug_allocator_create(
         device, base_allocator, host_allocator, out_wrapped_allocator);
+  } else if (iree_string_view_equal(allocator_name, IREE_SV("heap"))) {
+    status = iree_hal_heap_allocator_create_from_spec(
+        config_pairs, base_allocator, host_allocator, out_wrapped_allocator);
   } else {
     return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
                             "unrecognized allocator '%.*s'",
@@ -26,6 +26,7 @@ extern "C" {
 //   some_allocator
 //   some_allocator:key=value
 //   some_allocator:key=value,key=value
+//   heap:large_pages=transparent
 iree_status_t iree_hal_configure_allocator_from_spec(
     iree_string_view_t spec, iree_hal_device_t* device,
     iree_hal_allocator_t* base_allocator,
@@ -6,6 +6,8 @@
 
 #include "iree/hal/utils/memory_file.h"
 
+#include "iree/base/internal/memory.h"
+
 //===----------------------------------------------------------------------===//
 // Configuration
 //===----------------------------------------------------------------------===//
@@ -306,8 +308,29 @@ static iree_status_t iree_hal_memory_file_read(iree_hal_file_t* base_file,
                                                iree_device_size_t length) {
   iree_hal_memory_file_t* file = iree_hal_memory_file_cast(base_file);
   iree_byte_span_t file_contents = file->storage->contents;
-  return iree_hal_buffer_map_write(buffer, buffer_offset,
-                                   file_contents.data + file_offset, length);
+  if (length == 0) return iree_ok_status();
+
+  iree_hal_buffer_mapping_t target_mapping;
+  IREE_RETURN_IF_ERROR(iree_hal_buffer_map_range(
+      buffer, IREE_HAL_MAPPING_MODE_SCOPED,
+      IREE_HAL_MEMORY_ACCESS_DISCARD_WRITE, buffer_offset, length,
+      &target_mapping));
+
+  // Reads stage file contents (such as parameters) into buffers for use by the
+  // device. The host does not read them back and large reads would otherwise
+  // evict its working set.
+  iree_memory_copy(target_mapping.contents.data,
+                   file_contents.data + file_offset, length,
+                   IREE_MEMORY_COPY_FLAG_TARGET_NOT_READ_SOON);
+
+  iree_status_t status = iree_ok_status();
+  if (!iree_all_bits_set(iree_hal_buffer_memory_type(buffer),
+                         IREE_HAL_MEMORY_TYPE_HOST_COHERENT)) {
+    status = iree_hal_buffer_mapping_flush_range(&target_mapping, 0,
+                                                 IREE_HAL_WHOLE_BUFFER);
+  }
+  iree_hal_buffer_unmap_range(&target_mapping);
+  return status;
 }
 
 static iree_status_t iree_hal_memory_file_write(
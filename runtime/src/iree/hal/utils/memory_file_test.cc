@@ -0,0 +1,101 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/utils/memory_file.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/memory.h"
+#include "iree/hal/api.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace iree {
+namespace hal {
+namespace {
+
+class MemoryFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Large enough that reads of it use non-temporal stores.
+    contents_.resize(IREE_MEMORY_COPY_NON_TEMPORAL_THRESHOLD + 4096);
+    for (size_t i = 0; i < contents_.size(); ++i) {
+      contents_[i] = (uint8_t)(i * 13 + (i >> 10));
+    }
+    IREE_ASSERT_OK(iree_hal_allocator_create_heap(
+        IREE_SV("heap"), iree_allocator_system(), iree_allocator_system(),
+        &device_allocator_));
+    iree_io_file_handle_t* handle = NULL;
+    IREE_ASSERT_OK(iree_io_file_handle_wrap_host_allocation(
+        IREE_IO_FILE_ACCESS_READ | IREE_IO_FILE_ACCESS_WRITE,
+        iree_make_byte_span(contents_.data(), contents_.size()),
+        iree_io_file_handle_release_callback_null(), iree_allocator_system(),
+        &handle));
+    IREE_ASSERT_OK(iree_hal_memory_file_wrap(
+        device_allocator_, IREE_HAL_QUEUE_AFFINITY_ANY,
+        IREE_HAL_MEMORY_ACCESS_READ | IREE_HAL_MEMORY_ACCESS_WRITE, handle,
+        iree_allocator_system(), &file_));
+    iree_io_file_handle_release(handle);
+  }
+
+  void TearDown() override {
+    iree_hal_file_release(file_);
+    iree_hal_allocator_release(device_allocator_);
+  }
+
+  iree_hal_buffer_t* AllocateBuffer(iree_device_size_t allocation_size) {
+    iree_hal_buffer_params_t params = {0};
+    params.type =
+        IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL | IREE_HAL_MEMORY_TYPE_HOST_VISIBLE;
+    params.usage =
+        IREE_HAL_BUFFER_USAGE_TRANSFER | IREE_HAL_BUFFER_USAGE_MAPPING_SCOPED;
+    iree_hal_buffer_t* buffer = NULL;
+    IREE_CHECK_OK(iree_hal_allocator_allocate_buffer(
+        device_allocator_, params, allocation_size, &buffer));
+    return buffer;
+  }
+
+  std::vector<uint8_t> contents_;
+  iree_hal_allocator_t* device_allocator_ = NULL;
+  iree_hal_file_t* file_ = NULL;
+};
+
+// Tests reads on both sides of the non-temporal copy threshold into unaligned
+// buffer offsets.
+TEST_F(MemoryFileTest, Read) {
+  static constexpr iree_device_size_t kBufferOffset = 3;
+  static constexpr uint64_t kFileOffset = 7;
+  const iree_device_size_t lengths[] = {
+      0,
+      100,
+      IREE_MEMORY_COPY_NON_TEMPORAL_THRESHOLD,
+      IREE_MEMORY_COPY_NON_TEMPORAL_THRESHOLD + 77,
+  };
+  for (iree_device_size_t length : lengths) {
+    iree_hal_buffer_t* buffer = AllocateBuffer(kBufferOffset + length + 8);
+    IREE_ASSERT_OK(iree_hal_buffer_map_zero(buffer, 0, IREE_HAL_WHOLE_BUFFER));
+    IREE_ASSERT_OK(
+        iree_hal_file_read(file_, kFileOffset, buffer, kBufferOffset, length));
+
+    std::vector<uint8_t> result(kBufferOffset + length + 8);
+    IREE_ASSERT_OK(
+        iree_hal_buffer_map_read(buffer, 0, result.data(), result.size()));
+    EXPECT_EQ(result[kBufferOffset - 1], 0);
+    EXPECT_EQ(std::memcmp(result.data() + kBufferOffset,
+                          contents_.data() + kFileOffset, length),
+              0)
+        << "length=" << length;
+    EXPECT_EQ(result[kBufferOffset + length], 0);
+    iree_hal_buffer_release(buffer);
+  }
+}
+
+}  // namespace
+}  // namespace hal
+}  // namespace iree
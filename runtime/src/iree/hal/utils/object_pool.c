@@ -0,0 +1,298 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/utils/object_pool.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "iree/base/internal/synchronization.h"
+
+// Header prefixed to every allocation made through the pool.
+// Padded out to iree_max_align_t so the user storage following it has the same
+// alignment the host allocator would have provided.
+typedef struct iree_hal_object_pool_entry_t {
+  // Next entry in the free list when the entry is retained by the pool.
+  struct iree_hal_object_pool_entry_t* next;
+  // Usable size of the allocation following the header in bytes.
+  iree_host_size_t byte_length;
+} iree_hal_object_pool_entry_t;
+
+#define IREE_HAL_OBJECT_POOL_ENTRY_SIZE \
+  iree_host_align(sizeof(iree_hal_object_pool_entry_t), iree_max_align_t)
+
+struct iree_hal_object_pool_t {
+  // One reference for the owner and one for each live allocation.
+  iree_atomic_ref_count_t ref_count;
+  // Allocator used for the pool itself and all object storage.
+  iree_allocator_t host_allocator;
+  // Maximum number of freed allocations retained in |free_list|.
+  iree_host_size_t capacity;
+  // Maximum size of a freed allocation that will be retained.
+  iree_host_size_t max_object_size;
+
+  // Guards the free list and statistics. The critical sections are only a few
+  // pointer swaps and contention is bounded by how fast callers can create and
+  // destroy the objects whose storage is pooled.
+  iree_slim_mutex_t mutex;
+  // LIFO list of freed allocations so that the most recently used (and likely
+  // still cached) storage is reused first.
+  iree_hal_object_pool_entry_t* free_list;
+  iree_host_size_t free_count;
+  uint64_t allocation_count;
+  uint64_t host_allocation_count;
+};
+
+iree_status_t iree_hal_object_pool_allocate(
+    iree_host_size_t capacity, iree_host_size_t max_object_size,
+    iree_allocator_t host_allocator, iree_hal_object_pool_t** out_pool) {
+  IREE_ASSERT_ARGUMENT(out_pool);
+  *out_pool = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_hal_object_pool_t* pool = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator, sizeof(*pool), (void**)&pool));
+  memset(pool, 0, sizeof(*pool));
+  iree_atomic_ref_count_init(&pool->ref_count);
+  pool->host_allocator = host_allocator;
+  pool->capacity = capacity;
+  pool->max_object_size = max_object_size;
+  iree_slim_mutex_initialize(&pool->mutex);
+
+  *out_pool = pool;
+  IREE_TRACE_ZONE_END(z0);
+  return iree_ok_status();
+}
+
+static void iree_hal_object_pool_destroy(iree_hal_object_pool_t* pool) {
+  iree_allocator_t host_allocator = pool->host_allocator;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_hal_object_pool_trim(pool);
+  iree_slim_mutex_deinitialize(&pool->mutex);
+  iree_allocator_free(host_allocator, pool);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+void iree_hal_object_pool_retain(iree_hal_object_pool_t* pool) {
+  if (IREE_LIKELY(pool)) {
+    iree_atomic_ref_count_inc(&pool->ref_count);
+  }
+}
+
+void iree_hal_object_pool_release(iree_hal_object_pool_t* pool) {
+  if (IREE_LIKELY(pool) && iree_atomic_ref_count_dec(&pool->ref_count) == 1) {
+    iree_hal_object_pool_destroy(pool);
+  }
+}
+
+void iree_hal_object_pool_trim(iree_hal_object_pool_t* pool) {
+  IREE_ASSERT_ARGUMENT(pool);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_slim_mutex_lock(&pool->mutex);
+  iree_hal_object_pool_entry_t* entry = pool->free_list;
+  pool->free_list = NULL;
+  pool->free_count = 0;
+  iree_slim_mutex_unlock(&pool->mutex);
+
+  while (entry) {
+    iree_hal_object_pool_entry_t* next = entry->next;
+    iree_allocator_free(pool->host_allocator, entry);
+    entry = next;
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+void iree_hal_object_pool_query_statistics(
+    iree_hal_object_pool_t* pool,
+    iree_hal_object_pool_statistics_t* out_statistics) {
+  IREE_ASSERT_ARGUMENT(pool);
+  IREE_ASSERT_ARGUMENT(out_statistics);
+  iree_slim_mutex_lock(&pool->mutex);
+  out_statistics->allocation_count = pool->allocation_count;
+  out_statistics->host_allocation_count = pool->host_allocation_count;
+  out_statistics->free_count = pool->free_count;
+  iree_slim_mutex_unlock(&pool->mutex);
+}
+
+iree_status_t iree_hal_object_pool_query_i64(iree_hal_object_pool_t* pool,
+                                             iree_string_view_t key,
+                                             int64_t* out_value) {
+  IREE_ASSERT_ARGUMENT(pool);
+  IREE_ASSERT_ARGUMENT(out_value);
+  *out_value = 0;
+  iree_hal_object_pool_statistics_t statistics;
+  iree_hal_object_pool_query_statistics(pool, &statistics);
+  if (iree_string_view_equal(key, IREE_SV("allocations"))) {
+    *out_value = (int64_t)statistics.allocation_count;
+  } else if (iree_string_view_equal(key, IREE_SV("host_allocations"))) {
+    *out_value = (int64_t)statistics.host_allocation_count;
+  } else if (iree_string_view_equal(key, IREE_SV("free"))) {
+    *out_value = (int64_t)statistics.free_count;
+  } else {
+    return iree_make_status(IREE_STATUS_NOT_FOUND,
+                            "unknown object pool statistic '%.*s'",
+                            (int)key.size, key.data);
+  }
+  return iree_ok_status();
+}
+
+static iree_hal_object_pool_entry_t* iree_hal_object_pool_entry_from_ptr(
+    void* ptr) {
+  return (iree_hal_object_pool_entry_t*)((uint8_t*)ptr -
+                                         IREE_HAL_OBJECT_POOL_ENTRY_SIZE);
+}
+
+static void* iree_hal_object_pool_entry_ptr(
+    iree_hal_object_pool_entry_t* entry) {
+  return (uint8_t*)entry + IREE_HAL_OBJECT_POOL_ENTRY_SIZE;
+}
+
+// Returns storage for an allocation of exactly |byte_length| bytes.
+// Objects of a particular type are nearly always the same size and we only
+// reuse exact matches so that the pool never hands out more memory than was
+// requested. The free list is bounded by the pool capacity so scanning it for
+// a match is cheap.
+static iree_status_t iree_hal_object_pool_acquire_entry(
+    iree_hal_object_pool_t* pool, iree_host_size_t byte_length,
+    iree_hal_object_pool_entry_t** out_entry) {
+  iree_hal_object_pool_entry_t* entry = NULL;
+  iree_slim_mutex_lock(&pool->mutex);
+  ++pool->allocation_count;
+  iree_hal_object_pool_entry_t** entry_ptr = &pool->free_list;
+  while (*entry_ptr) {
+    if ((*entry_ptr)->byte_length == byte_length) {
+      entry = *entry_ptr;
+      *entry_ptr = entry->next;
+      --pool->free_count;
+      break;
+    }
+    entry_ptr = &(*entry_ptr)->next;
+  }
+  if (!entry) ++pool->host_allocation_count;
+  iree_slim_mutex_unlock(&pool->mutex);
+
+  if (!entry) {
+    if (IREE_UNLIKELY(byte_length >
+                      IREE_HOST_SIZE_MAX - IREE_HAL_OBJECT_POOL_ENTRY_SIZE)) {
+      return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                              "allocation of %" PRIhsz " bytes too large",
+                              byte_length);
+    }
+    IREE_RETURN_IF_ERROR(iree_allocator_malloc_uninitialized(
+        pool->host_allocator, IREE_HAL_OBJECT_POOL_ENTRY_SIZE + byte_length,
+        (void**)&entry));
+    entry->byte_length = byte_length;
+  }
+  entry->next = NULL;
+
+  // Each live allocation keeps the pool (and its host allocator) alive.
+  iree_hal_object_pool_retain(pool);
+  *out_entry = entry;
+  return iree_ok_status();
+}
+
+// Returns |entry| to the free list if it fits or the host allocator otherwise.
+static void iree_hal_object_pool_release_entry(
+    iree_hal_object_pool_t* pool, iree_hal_object_pool_entry_t* entry) {
+  bool retained = false;
+  if (entry->byte_length <= pool->max_object_size) {
+    iree_slim_mutex_lock(&pool->mutex);
+    if (pool->free_count < pool->capacity) {
+      entry->next = pool->free_list;
+      pool->free_list = entry;
+      ++pool->free_count;
+      retained = true;
+    }
+    iree_slim_mutex_unlock(&pool->mutex);
+  }
+  if (!retained) {
+    iree_allocator_free(pool->host_allocator, entry);
+  }
+  iree_hal_object_pool_release(pool);
+}
+
+static iree_status_t iree_hal_object_pool_alloc(
+    iree_hal_object_pool_t* pool, iree_allocator_command_t command,
+    const iree_allocator_alloc_params_t* params, void** inout_ptr) {
+  IREE_ASSERT_ARGUMENT(params);
+  IREE_ASSERT_ARGUMENT(inout_ptr);
+  iree_host_size_t byte_length = params->byte_length;
+  if (IREE_UNLIKELY(byte_length == 0)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "allocations must be >0 bytes");
+  }
+
+  // Reallocations are rare for pooled objects and we handle them by moving
+  // the contents into new storage.
+  void* existing_ptr =
+      command == IREE_ALLOCATOR_COMMAND_REALLOC ? *inout_ptr : NULL;
+  iree_hal_object_pool_entry_t* existing_entry =
+      existing_ptr ? iree_hal_object_pool_entry_from_ptr(existing_ptr) : NULL;
+  if (existing_entry && existing_entry->byte_length == byte_length) {
+    return iree_ok_status();
+  }
+
+  iree_hal_object_pool_entry_t* entry = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_hal_object_pool_acquire_entry(pool, byte_length, &entry));
+  void* ptr = iree_hal_object_pool_entry_ptr(entry);
+  if (command == IREE_ALLOCATOR_COMMAND_CALLOC) {
+    memset(ptr, 0, byte_length);
+  } else if (existing_entry) {
+    memcpy(ptr, existing_ptr,
+           iree_min(existing_entry->byte_length, byte_length));
+    iree_hal_object_pool_release_entry(pool, existing_entry);
+  }
+
+  *inout_ptr = ptr;
+  return iree_ok_status();
+}
+
+static iree_status_t iree_hal_object_pool_free(iree_hal_object_pool_t* pool,
+                                               void** inout_ptr) {
+  IREE_ASSERT_ARGUMENT(inout_ptr);
+  void* ptr = *inout_ptr;
+  if (!ptr) return iree_ok_status();
+  iree_hal_object_pool_release_entry(pool,
+                                     iree_hal_object_pool_entry_from_ptr(ptr));
+  *inout_ptr = NULL;
+  return iree_ok_status();
+}
+
+static iree_status_t iree_hal_object_pool_ctl(void* self,
+                                              iree_allocator_command_t command,
+                                              const void* params,
+                                              void** inout_ptr) {
+  iree_hal_object_pool_t* pool = (iree_hal_object_pool_t*)self;
+  switch (command) {
+    case IREE_ALLOCATOR_COMMAND_MALLOC:
+    case IREE_ALLOCATOR_COMMAND_CALLOC:
+    case IREE_ALLOCATOR_COMMAND_REALLOC:
+      return iree_hal_object_pool_alloc(
+          pool, command, (const iree_allocator_alloc_params_t*)params,
+          inout_ptr);
+    case IREE_ALLOCATOR_COMMAND_FREE:
+      return iree_hal_object_pool_free(pool, inout_ptr);
+    default:
+      return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                              "unsupported object pool allocator command");
+  }
+}
+
+iree_allocator_t iree_hal_object_pool_allocator(iree_hal_object_pool_t* pool) {
+  IREE_ASSERT_ARGUMENT(pool);
+  iree_allocator_t allocator = {
+      .self = pool,
+      .ctl = iree_hal_object_pool_ctl,
+  };
+  return allocator;
+}
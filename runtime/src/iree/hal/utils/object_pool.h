@@ -0,0 +1,89 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_HAL_UTILS_OBJECT_POOL_H_
+#define IREE_HAL_UTILS_OBJECT_POOL_H_
+
+#include "iree/base/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+// Default maximum size of an object retained by an iree_hal_object_pool_t.
+// Larger allocations (scratch memory and such made through the same allocator)
+// are passed directly through to the underlying host allocator.
+#define IREE_HAL_OBJECT_POOL_DEFAULT_MAX_OBJECT_SIZE (4 * 1024)
+
+// A host allocator that recycles the storage of small short-lived objects.
+//
+// Devices create semaphores, command buffers, and other objects on nearly
+// every invocation and each one is a round-trip through the system allocator.
+// Routing those allocations through a pool keeps a bounded free list of the
+// storage released by destroyed objects and hands it back to new objects of
+// the same size; the objects are then reinitialized in place. Allocations that
+// cannot be serviced from the free list go to the underlying host allocator.
+//
+// The pool is used as an iree_allocator_t so that objects only need to be
+// created with the pool allocator in place of their host allocator. Each live
+// allocation retains the pool and objects may outlive whatever created the
+// pool (such as the device).
+//
+// Thread-safe: allocations may be made and freed from any thread.
+typedef struct iree_hal_object_pool_t iree_hal_object_pool_t;
+
+// Statistics tracking the effectiveness of an iree_hal_object_pool_t.
+typedef struct iree_hal_object_pool_statistics_t {
+  // Total number of allocations made through the pool.
+  uint64_t allocation_count;
+  // Number of allocations that had to be made from the host allocator.
+  // The difference from |allocation_count| is the number of host allocator
+  // round-trips the pool avoided.
+  uint64_t host_allocation_count;
+  // Number of freed allocations currently retained for reuse.
+  iree_host_size_t free_count;
+} iree_hal_object_pool_statistics_t;
+
+// Allocates an object pool that retains up to |capacity| freed allocations of
+// at most |max_object_size| bytes each. Storage is allocated from and returned
+// to |host_allocator|.
+iree_status_t iree_hal_object_pool_allocate(
+    iree_host_size_t capacity, iree_host_size_t max_object_size,
+    iree_allocator_t host_allocator, iree_hal_object_pool_t** out_pool);
+
+// Retains the given |pool| for the caller.
+void iree_hal_object_pool_retain(iree_hal_object_pool_t* pool);
+
+// Releases the given |pool| from the caller. The pool is freed once the last
+// reference and all live allocations made from it have been released.
+void iree_hal_object_pool_release(iree_hal_object_pool_t* pool);
+
+// Returns an allocator that allocates from |pool|.
+// Allocations retain the pool until they are freed.
+iree_allocator_t iree_hal_object_pool_allocator(iree_hal_object_pool_t* pool);
+
+// Frees all allocations retained for reuse back to the host allocator.
+void iree_hal_object_pool_trim(iree_hal_object_pool_t* pool);
+
+// Queries the current statistics of |pool|.
+void iree_hal_object_pool_query_statistics(
+    iree_hal_object_pool_t* pool,
+    iree_hal_object_pool_statistics_t* out_statistics);
+
+// Queries a statistic of |pool| by |key| for exposing through device queries:
+//   `allocations`: total allocations made through the pool.
+//   `host_allocations`: allocations made from the host allocator.
+//   `free`: freed allocations currently retained for reuse.
+// Returns IREE_STATUS_NOT_FOUND if the key is unknown.
+iree_status_t iree_hal_object_pool_query_i64(iree_hal_object_pool_t* pool,
+                                             iree_string_view_t key,
+                                             int64_t* out_value);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_HAL_UTILS_OBJECT_POOL_H_
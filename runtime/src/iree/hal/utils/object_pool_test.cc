@@ -0,0 +1,288 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/hal/utils/object_pool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/hal/api.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace iree {
+namespace hal {
+namespace {
+
+// Host allocator wrapping the system allocator that counts calls made to it.
+struct CountingAllocator {
+  std::atomic<int> malloc_count{0};
+  std::atomic<int> free_count{0};
+
+  static iree_status_t Ctl(void* self, iree_allocator_command_t command,
+                           const void* params, void** inout_ptr) {
+    auto* allocator = reinterpret_cast<CountingAllocator*>(self);
+    switch (command) {
+      case IREE_ALLOCATOR_COMMAND_MALLOC:
+      case IREE_ALLOCATOR_COMMAND_CALLOC:
+        ++allocator->malloc_count;
+        break;
+      case IREE_ALLOCATOR_COMMAND_REALLOC:
+        if (!*inout_ptr) ++allocator->malloc_count;
+        break;
+      case IREE_ALLOCATOR_COMMAND_FREE:
+        ++allocator->free_count;
+        break;
+      default:
+        break;
+    }
+    iree_allocator_t system = iree_allocator_system();
+    return system.ctl(system.self, command, params, inout_ptr);
+  }
+
+  iree_allocator_t allocator() { return {this, Ctl}; }
+};
+
+class ObjectPoolTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    // All storage must have been returned to the host allocator.
+    EXPECT_EQ(host.malloc_count.load(), host.free_count.load());
+  }
+
+  iree_hal_object_pool_t* AllocatePool(iree_host_size_t capacity,
+                                       iree_host_size_t max_object_size) {
+    iree_hal_object_pool_t* pool = NULL;
+    IREE_CHECK_OK(iree_hal_object_pool_allocate(
+        capacity, max_object_size, host.allocator(), &pool));
+    return pool;
+  }
+
+  CountingAllocator host;
+};
+
+TEST_F(ObjectPoolTest, Lifetime) {
+  iree_hal_object_pool_t* pool = AllocatePool(8, 256);
+  iree_hal_object_pool_statistics_t statistics;
+  iree_hal_object_pool_query_statistics(pool, &statistics);
+  EXPECT_EQ(statistics.allocation_count, 0);
+  EXPECT_EQ(statistics.host_allocation_count, 0);
+  EXPECT_EQ(statistics.free_count, 0);
+  iree_hal_object_pool_release(pool);
+}
+
+// Tests that freed storage is handed back to allocations of the same size.
+TEST_F(ObjectPoolTest, ReusesFreedStorage) {
+  iree_hal_object_pool_t* pool = AllocatePool(8, 256);
+  iree_allocator_t allocator = iree_hal_object_pool_allocator(pool);
+
+  void* a = NULL;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator, 64, &a));
+  EXPECT_EQ((uintptr_t)a % iree_max_align_t, 0);
+  iree_allocator_free(allocator, a);
+  void* b = NULL;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator, 64, &b));
+  EXPECT_EQ(a, b);
+
+  // A different size can't reuse the storage held by |b|.
+  void* c = NULL;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator, 32, &c));
+  EXPECT_NE(b, c);
+  iree_allocator_free(allocator, b);
+  iree_allocator_free(allocator, c);
+
+  iree_hal_object_pool_statistics_t statistics;
+  iree_hal_object_pool_query_statistics(pool, &statistics);
+  EXPECT_EQ(statistics.allocation_count, 3);
+  EXPECT_EQ(statistics.host_allocation_count, 2);
+  EXPECT_EQ(statistics.free_count, 2);
+
+  iree_hal_object_pool_release(pool);
+}
+
+// Tests that reused storage is zeroed when requested.
+TEST_F(ObjectPoolTest, CallocZeroesReusedStorage) {
+  iree_hal_object_pool_t* pool = AllocatePool(8, 256);
+  iree_allocator_t allocator = iree_hal_object_pool_allocator(pool);
+
+  uint8_t* a = NULL;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator, 64, (void**)&a));
+  memset(a, 0xCD, 64);
+  iree_allocator_free(allocator, a);
+  uint8_t* b = NULL;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator, 64, (void**)&b));
+  ASSERT_EQ(a, b);
+  for (int i = 0; i < 64; ++i) EXPECT_EQ(b[i], 0);
+  iree_allocator_free(allocator, b);
+
+  iree_hal_object_pool_release(pool);
+}
+
+// Tests that reallocation preserves the contents of the allocation.
+TEST_F(ObjectPoolTest, Realloc) {
+  iree_hal_object_pool_t* pool = AllocatePool(8, 256);
+  iree_allocator_t allocator = iree_hal_object_pool_allocator(pool);
+
+  uint8_t* ptr = NULL;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator, 16, (void**)&ptr));
+  for (int i = 0; i < 16; ++i) ptr[i] = (uint8_t)i;
+  IREE_ASSERT_OK(iree_allocator_realloc(allocator, 128, (void**)&ptr));
+  for (int i = 0; i < 16; ++i) EXPECT_EQ(ptr[i], i);
+  iree_allocator_free(allocator, ptr);
+
+  iree_hal_object_pool_release(pool);
+}
+
+// Tests that only up to the capacity of freed allocations are retained.
+TEST_F(ObjectPoolTest, Capacity) {
+  iree_hal_object_pool_t* pool = AllocatePool(2, 256);
+  iree_allocator_t allocator = iree_hal_object_pool_allocator(pool);
+
+  void* ptrs[4] = {NULL};
+  for (auto& ptr : ptrs) {
+    IREE_ASSERT_OK(iree_allocator_malloc(allocator, 64, &ptr));
+  }
+  for (auto& ptr : ptrs) iree_allocator_free(allocator, ptr);
+  EXPECT_EQ(host.free_count.load(), 2);
+
+  iree_hal_object_pool_statistics_t statistics;
+  iree_hal_object_pool_query_statistics(pool, &statistics);
+  EXPECT_EQ(statistics.free_count, 2);
+
+  iree_hal_object_pool_trim(pool);
+  iree_hal_object_pool_query_statistics(pool, &statistics);
+  EXPECT_EQ(statistics.free_count, 0);
+  EXPECT_EQ(host.free_count.load(), 4);
+
+  iree_hal_object_pool_release(pool);
+}
+
+// Tests that allocations over the maximum object size are not retained.
+TEST_F(ObjectPoolTest, LargeAllocationsPassThrough) {
+  iree_hal_object_pool_t* pool = AllocatePool(8, 256);
+  iree_allocator_t allocator = iree_hal_object_pool_allocator(pool);
+
+  void* ptr = NULL;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator, 1024, &ptr));
+  iree_allocator_free(allocator, ptr);
+  EXPECT_EQ(host.free_count.load(), 1);
+
+  iree_hal_object_pool_statistics_t statistics;
+  iree_hal_object_pool_query_statistics(pool, &statistics);
+  EXPECT_EQ(statistics.free_count, 0);
+
+  iree_hal_object_pool_release(pool);
+}
+
+// Tests that live allocations keep the pool alive after its owner releases it.
+TEST_F(ObjectPoolTest, AllocationsOutlivePool) {
+  iree_hal_object_pool_t* pool = AllocatePool(8, 256);
+  iree_allocator_t allocator = iree_hal_object_pool_allocator(pool);
+
+  void* ptr = NULL;
+  IREE_ASSERT_OK(iree_allocator_malloc(allocator, 64, &ptr));
+  iree_hal_object_pool_release(pool);
+  EXPECT_EQ(host.free_count.load(), 0);
+
+  // Freeing the last allocation frees the pool along with its storage.
+  iree_allocator_free(allocator, ptr);
+  EXPECT_EQ(host.free_count.load(), 2);
+}
+
+TEST_F(ObjectPoolTest, QueryI64) {
+  iree_hal_object_pool_t* pool = AllocatePool(8, 256);
+  iree_allocator_t allocator = iree_hal_object_pool_allocator(pool);
+
+  for (int i = 0; i < 4; ++i) {
+    void* ptr = NULL;
+    IREE_ASSERT_OK(iree_allocator_malloc(allocator, 64, &ptr));
+    iree_allocator_free(allocator, ptr);
+  }
+
+  int64_t value = 0;
+  IREE_ASSERT_OK(
+      iree_hal_object_pool_query_i64(pool, IREE_SV("allocations"), &value));
+  EXPECT_EQ(value, 4);
+  IREE_ASSERT_OK(iree_hal_object_pool_query_i64(
+      pool, IREE_SV("host_allocations"), &value));
+  EXPECT_EQ(value, 1);
+  IREE_ASSERT_OK(iree_hal_object_pool_query_i64(pool, IREE_SV("free"), &value));
+  EXPECT_EQ(value, 1);
+  iree_status_t status =
+      iree_hal_object_pool_query_i64(pool, IREE_SV("unknown"), &value);
+  IREE_EXPECT_STATUS_IS(IREE_STATUS_NOT_FOUND, status);
+  iree_status_ignore(status);
+
+  iree_hal_object_pool_release(pool);
+}
+
+// Tests that the fences created by each invocation stop hitting the host
+// allocator once the pool has warmed up.
+TEST_F(ObjectPoolTest, FenceHostAllocationsPerInvocation) {
+  static constexpr int kInvocationCount = 100;
+
+  // Without the pool every fence is a host allocation.
+  for (int i = 0; i < kInvocationCount; ++i) {
+    iree_hal_fence_t* fence = NULL;
+    IREE_ASSERT_OK(iree_hal_fence_create(1, host.allocator(), &fence));
+    iree_hal_fence_release(fence);
+  }
+  EXPECT_EQ(host.malloc_count.load(), kInvocationCount);
+
+  host.malloc_count = 0;
+  host.free_count = 0;
+  iree_hal_object_pool_t* pool = AllocatePool(8, 256);
+  for (int i = 0; i < kInvocationCount; ++i) {
+    iree_hal_fence_t* fence = NULL;
+    IREE_ASSERT_OK(iree_hal_fence_create(
+        1, iree_hal_object_pool_allocator(pool), &fence));
+    iree_hal_fence_release(fence);
+  }
+  // One allocation for the pool and one for the recycled fence storage.
+  EXPECT_EQ(host.malloc_count.load(), 2);
+  iree_hal_object_pool_release(pool);
+}
+
+// Tests allocating and freeing from many threads concurrently.
+TEST_F(ObjectPoolTest, Threaded) {
+  static constexpr int kThreadCount = 4;
+  static constexpr int kIterationCount = 2000;
+  iree_hal_object_pool_t* pool = AllocatePool(16, 256);
+  iree_allocator_t allocator = iree_hal_object_pool_allocator(pool);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreadCount; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kIterationCount; ++i) {
+        uint32_t* ptrs[2] = {NULL, NULL};
+        for (auto& ptr : ptrs) {
+          IREE_ASSERT_OK(iree_allocator_malloc(allocator, 64, (void**)&ptr));
+          *ptr = (uint32_t)(t * kIterationCount + i);
+        }
+        for (auto& ptr : ptrs) {
+          EXPECT_EQ(*ptr, (uint32_t)(t * kIterationCount + i));
+          iree_allocator_free(allocator, ptr);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  iree_hal_object_pool_statistics_t statistics;
+  iree_hal_object_pool_query_statistics(pool, &statistics);
+  EXPECT_EQ(statistics.allocation_count, kThreadCount * kIterationCount * 2);
+  EXPECT_LE(statistics.host_allocation_count, kThreadCount * 2);
+
+  iree_hal_object_pool_release(pool);
+}
+
+}  // namespace
+}  // namespace hal
+}  // namespace iree
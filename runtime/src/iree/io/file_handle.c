@@ -704,8 +704,16 @@ static iree_status_t iree_io_platform_map_file_view(
   }
 #endif  // MAP_HUGETLB
 
-  // Map the memory.
+  // Map the memory. MAP_HUGETLB only works for files on hugetlbfs so for
+  // regular files we retry with normal pages and advise for transparent huge
+  // pages below.
   void* ptr = mmap(NULL, adjusted_length, prot, map_flags, fd, offset);
+#if defined(MAP_HUGETLB)
+  if (ptr == MAP_FAILED && (map_flags & MAP_HUGETLB)) {
+    map_flags &= ~MAP_HUGETLB;
+    ptr = mmap(NULL, adjusted_length, prot, map_flags, fd, offset);
+  }
+#endif  // MAP_HUGETLB
   if (ptr == MAP_FAILED) {
     return iree_make_status(iree_status_code_from_errno(errno),
                             "failed to map file handle range %" PRIu64
@@ -727,6 +735,15 @@ static iree_status_t iree_io_platform_map_file_view(
   if (advice) {
     madvise(ptr, adjusted_length, advice);
   }
+#if defined(MADV_HUGEPAGE) && defined(MAP_HUGETLB)
+  // Transparent huge pages for file mappings require kernel support
+  // (CONFIG_READ_ONLY_THP_FOR_FS or a huge-page capable filesystem); the
+  // advice is ignored otherwise.
+  if (iree_all_bits_set(flags, IREE_IO_FILE_MAPPING_FLAG_LARGE_PAGES) &&
+      !(map_flags & MAP_HUGETLB)) {
+    madvise(ptr, adjusted_length, MADV_HUGEPAGE);
+  }
+#endif  // MADV_HUGEPAGE && MAP_HUGETLB
 
   *out_impl = ptr;
   *out_contents = iree_make_byte_span(ptr, adjusted_length);
@@ -258,7 +258,8 @@ enum iree_io_file_mapping_flag_bits_t {
   // larger than the normal page size (MB vs. KB) care should be used to only
   // apply this to large allocations.
   //
-  // Implemented by FILE_MAP_LARGE_PAGES/MAP_HUGETLB, where available.
+  // Implemented by FILE_MAP_LARGE_PAGES/MAP_HUGETLB, where available. On Linux
+  // files not on hugetlbfs are mapped with normal pages and MADV_HUGEPAGE.
   IREE_IO_FILE_MAPPING_FLAG_LARGE_PAGES = 1ull << 1,
 
   // Excludes the view memory from minidumps/coredumps.
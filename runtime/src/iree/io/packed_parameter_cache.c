@@ -0,0 +1,711 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/io/packed_parameter_cache.h"
+
+#include <stdio.h>
+
+#include "iree/base/internal/synchronization.h"
+#include "iree/io/file_handle.h"
+#include "iree/io/formats/irpa/irpa_builder.h"
+#include "iree/io/formats/irpa/irpa_parser.h"
+#include "iree/io/parameter_index.h"
+#include "iree/io/parameter_index_provider.h"
+
+// Alignment of the host storage of new entries. Matches the HAL heap buffer
+// alignment so that devices can import the storage directly.
+#define IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_ALIGNMENT 64
+
+//===----------------------------------------------------------------------===//
+// Packed parameter cache keys
+//===----------------------------------------------------------------------===//
+
+// 64-bit FNV-1a. Keys only need to be stable across runs and builds and
+// distinct for distinct encodings/targets; this is not a security boundary.
+static uint64_t iree_io_packed_parameter_cache_hash(uint64_t hash,
+                                                    iree_string_view_t value) {
+  for (iree_host_size_t i = 0; i < value.size; ++i) {
+    hash ^= (uint8_t)value.data[i];
+    hash *= 0x100000001B3ull;
+  }
+  return hash;
+}
+
+IREE_API_EXPORT iree_status_t iree_io_packed_parameter_cache_append_key(
+    iree_string_view_t key, iree_string_view_t encoding,
+    iree_string_view_t target, iree_string_builder_t* builder) {
+  IREE_ASSERT_ARGUMENT(builder);
+  uint64_t hash = 0xCBF29CE484222325ull;
+  hash = iree_io_packed_parameter_cache_hash(hash, encoding);
+  // Separator so that moving characters between the encoding and the target
+  // changes the hash.
+  static const char separator = 0;
+  hash = iree_io_packed_parameter_cache_hash(
+      hash, iree_make_string_view(&separator, 1));
+  hash = iree_io_packed_parameter_cache_hash(hash, target);
+  return iree_string_builder_append_format(builder, "%.*s@%016" PRIx64,
+                                           (int)key.size, key.data, hash);
+}
+
+//===----------------------------------------------------------------------===//
+// iree_io_packed_parameter_cache_t
+//===----------------------------------------------------------------------===//
+
+// State of a cache entry added by this provider.
+typedef enum iree_io_packed_parameter_cache_entry_state_e {
+  // Storage has been allocated and one or more scatters into it are in flight.
+  // The contents are undefined until all of the scatters complete.
+  IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_PENDING = 0,
+  // All writes to the entry have completed successfully and the entry will be
+  // persisted on the next flush.
+  IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_COMMITTED,
+  // A scatter into the entry failed. The entry is hidden from queries and is
+  // never persisted; a later scatter may retry populating it.
+  IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_FAILED,
+} iree_io_packed_parameter_cache_entry_state_t;
+
+// Tracks an entry added to the cache index by this provider. Entries indexed
+// from the existing sidecar are always committed and are not tracked.
+typedef struct iree_io_packed_parameter_cache_entry_t {
+  struct iree_io_packed_parameter_cache_entry_t* next;
+  // Entry in the cache index; valid for the lifetime of the index.
+  const iree_io_parameter_index_entry_t* index_entry;
+  iree_io_packed_parameter_cache_entry_state_t state;
+  // Identifier of the last scatter targeting the entry.
+  uint64_t scatter_id;
+  // Signal timepoints of the scatters in flight into the entry. Each semaphore
+  // is retained. The entry commits once all are reached and fails if any fail.
+  iree_host_size_t timepoint_capacity;
+  iree_hal_semaphore_list_t timepoints;
+} iree_io_packed_parameter_cache_entry_t;
+
+typedef struct iree_io_packed_parameter_cache_t {
+  iree_io_parameter_provider_t base;
+  iree_allocator_t host_allocator;
+  iree_string_view_t scope;
+  // NUL-terminated paths of the sidecar and the temporary file it is written
+  // to before being renamed into place.
+  const char* path;
+  const char* temp_path;
+  // Guards adding entries, their state, and flushing.
+  iree_slim_mutex_t mutex;
+  // True if entries were committed since the last flush.
+  bool dirty;
+  // Identifier assigned to the next scatter.
+  uint64_t next_scatter_id;
+  // Entries added by this provider.
+  iree_io_packed_parameter_cache_entry_t* entry_head;
+  // All existing and new entries. New entries are backed by host allocations
+  // from |host_allocator|.
+  iree_io_parameter_index_t* index;
+  // Serves loads, gathers, and scatters from |index|.
+  iree_io_parameter_provider_t* index_provider;
+} iree_io_packed_parameter_cache_t;
+
+static const iree_io_parameter_provider_vtable_t
+    iree_io_packed_parameter_cache_vtable;
+
+static iree_io_packed_parameter_cache_t* iree_io_packed_parameter_cache_cast(
+    iree_io_parameter_provider_t* IREE_RESTRICT base_provider) {
+  IREE_ASSERT_TRUE(base_provider->vtable ==
+                   &iree_io_packed_parameter_cache_vtable);
+  return (iree_io_packed_parameter_cache_t*)base_provider;
+}
+
+// Indexes the existing sidecar at |path|, if any.
+static iree_status_t iree_io_packed_parameter_cache_index_sidecar(
+    iree_string_view_t path, iree_io_parameter_index_t* index,
+    iree_allocator_t host_allocator) {
+  iree_io_file_handle_t* file_handle = NULL;
+  iree_status_t status = iree_io_file_handle_open(
+      IREE_IO_FILE_MODE_READ | IREE_IO_FILE_MODE_RANDOM_ACCESS, path,
+      host_allocator, &file_handle);
+  if (iree_status_is_not_found(status)) {
+    // No cache yet; it'll be created on the first flush.
+    iree_status_ignore(status);
+    return iree_ok_status();
+  }
+  if (iree_status_is_ok(status)) {
+    status = iree_io_parse_irpa_index(file_handle, index, host_allocator);
+  }
+  iree_io_file_handle_release(file_handle);
+  return status;
+}
+
+IREE_API_EXPORT iree_status_t iree_io_packed_parameter_cache_create(
+    iree_string_view_t scope, iree_string_view_t path,
+    iree_host_size_t max_concurrent_operations, iree_allocator_t host_allocator,
+    iree_io_parameter_provider_t** out_provider) {
+  IREE_ASSERT_ARGUMENT(out_provider);
+  *out_provider = NULL;
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_TEXT(z0, path.data, path.size);
+
+  static const char temp_suffix[] = ".tmp";
+  iree_io_packed_parameter_cache_t* cache = NULL;
+  iree_host_size_t total_size = sizeof(*cache) + scope.size + path.size + 1 +
+                                path.size + sizeof(temp_suffix);
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator, total_size, (void**)&cache));
+  iree_atomic_ref_count_init(&cache->base.ref_count);
+  cache->base.vtable = &iree_io_packed_parameter_cache_vtable;
+  cache->host_allocator = host_allocator;
+  iree_slim_mutex_initialize(&cache->mutex);
+
+  char* string_storage = (char*)cache + sizeof(*cache);
+  memcpy(string_storage, scope.data, scope.size);
+  cache->scope = iree_make_string_view(string_storage, scope.size);
+  string_storage += scope.size;
+  memcpy(string_storage, path.data, path.size);
+  string_storage[path.size] = 0;
+  cache->path = string_storage;
+  string_storage += path.size + 1;
+  memcpy(string_storage, path.data, path.size);
+  memcpy(string_storage + path.size, temp_suffix, sizeof(temp_suffix));
+  cache->temp_path = string_storage;
+
+  iree_status_t status =
+      iree_io_parameter_index_create(host_allocator, &cache->index);
+  if (iree_status_is_ok(status)) {
+    status = iree_io_packed_parameter_cache_index_sidecar(path, cache->index,
+                                                          host_allocator);
+  }
+  if (iree_status_is_ok(status)) {
+    status = iree_io_parameter_index_provider_create(
+        scope, cache->index, max_concurrent_operations, host_allocator,
+        &cache->index_provider);
+  }
+
+  if (iree_status_is_ok(status)) {
+    *out_provider = (iree_io_parameter_provider_t*)cache;
+  } else {
+    iree_io_parameter_provider_release((iree_io_parameter_provider_t*)cache);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+// Releases the timepoints tracked by |entry|.
+static void iree_io_packed_parameter_cache_entry_reset_timepoints(
+    iree_io_packed_parameter_cache_entry_t* entry) {
+  iree_hal_semaphore_list_release(entry->timepoints);
+  entry->timepoints.count = 0;
+}
+
+// Appends the timepoints of |semaphore_list| to those tracked by |entry|.
+static iree_status_t iree_io_packed_parameter_cache_entry_append_timepoints(
+    iree_io_packed_parameter_cache_t* cache,
+    iree_io_packed_parameter_cache_entry_t* entry,
+    iree_hal_semaphore_list_t semaphore_list) {
+  iree_hal_semaphore_list_t* timepoints = &entry->timepoints;
+  iree_host_size_t required_capacity =
+      timepoints->count + semaphore_list.count;
+  if (required_capacity > entry->timepoint_capacity) {
+    // Payload values and semaphores share one allocation with the payload
+    // values first so that they are aligned on all platforms.
+    iree_host_size_t new_capacity = iree_max(
+        4, iree_max(required_capacity, entry->timepoint_capacity * 2));
+    uint64_t* payload_values = NULL;
+    IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+        cache->host_allocator,
+        new_capacity * (sizeof(uint64_t) + sizeof(iree_hal_semaphore_t*)),
+        (void**)&payload_values));
+    iree_hal_semaphore_t** semaphores =
+        (iree_hal_semaphore_t**)(payload_values + new_capacity);
+    if (timepoints->count > 0) {
+      memcpy(payload_values, timepoints->payload_values,
+             timepoints->count * sizeof(*payload_values));
+      memcpy(semaphores, timepoints->semaphores,
+             timepoints->count * sizeof(*semaphores));
+    }
+    iree_allocator_free(cache->host_allocator, timepoints->payload_values);
+    timepoints->payload_values = payload_values;
+    timepoints->semaphores = semaphores;
+    entry->timepoint_capacity = new_capacity;
+  }
+  for (iree_host_size_t i = 0; i < semaphore_list.count; ++i) {
+    timepoints->semaphores[timepoints->count] = semaphore_list.semaphores[i];
+    timepoints->payload_values[timepoints->count] =
+        semaphore_list.payload_values[i];
+    iree_hal_semaphore_retain(semaphore_list.semaphores[i]);
+    ++timepoints->count;
+  }
+  return iree_ok_status();
+}
+
+// Returns the tracked entry for |index_entry| or NULL if the entry was indexed
+// from the existing sidecar.
+// Must be called with the cache mutex held.
+static iree_io_packed_parameter_cache_entry_t*
+iree_io_packed_parameter_cache_find_entry(
+    iree_io_packed_parameter_cache_t* cache,
+    const iree_io_parameter_index_entry_t* index_entry) {
+  for (iree_io_packed_parameter_cache_entry_t* entry = cache->entry_head;
+       entry; entry = entry->next) {
+    if (entry->index_entry == index_entry) return entry;
+  }
+  return NULL;
+}
+
+// Commits pending entries whose scatters have all completed and fails those
+// with any failed scatter. Entries with scatters still in flight stay pending.
+// Must be called with the cache mutex held.
+static void iree_io_packed_parameter_cache_resolve_entries(
+    iree_io_packed_parameter_cache_t* cache) {
+  for (iree_io_packed_parameter_cache_entry_t* entry = cache->entry_head;
+       entry; entry = entry->next) {
+    // Pending entries without timepoints are being scattered synchronously
+    // and are resolved by the scatter itself.
+    if (entry->state != IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_PENDING ||
+        entry->timepoints.count == 0) {
+      continue;
+    }
+    bool reached = true;
+    bool failed = false;
+    for (iree_host_size_t i = 0; i < entry->timepoints.count; ++i) {
+      uint64_t current_value = 0;
+      iree_status_t status = iree_hal_semaphore_query(
+          entry->timepoints.semaphores[i], &current_value);
+      if (!iree_status_is_ok(status)) {
+        iree_status_ignore(status);
+        failed = true;
+        break;
+      } else if (current_value < entry->timepoints.payload_values[i]) {
+        reached = false;
+      }
+    }
+    if (failed) {
+      entry->state = IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_FAILED;
+      iree_io_packed_parameter_cache_entry_reset_timepoints(entry);
+    } else if (reached) {
+      entry->state = IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_COMMITTED;
+      iree_io_packed_parameter_cache_entry_reset_timepoints(entry);
+      cache->dirty = true;
+    }
+  }
+}
+
+static void iree_io_packed_parameter_cache_destroy(
+    iree_io_parameter_provider_t* IREE_RESTRICT base_provider) {
+  iree_io_packed_parameter_cache_t* cache =
+      iree_io_packed_parameter_cache_cast(base_provider);
+  iree_allocator_t host_allocator = cache->host_allocator;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Failing to persist the cache only costs the next run the time to
+  // regenerate the entries.
+  if (cache->index_provider) {
+    iree_status_ignore(iree_io_packed_parameter_cache_flush(base_provider));
+  }
+
+  // NOTE: the host storage of new entries is released along with the file
+  // handles retained by the index and the provider file cache.
+  iree_io_parameter_provider_release(cache->index_provider);
+  iree_io_parameter_index_release(cache->index);
+  iree_io_packed_parameter_cache_entry_t* entry = cache->entry_head;
+  while (entry) {
+    iree_io_packed_parameter_cache_entry_t* next = entry->next;
+    iree_io_packed_parameter_cache_entry_reset_timepoints(entry);
+    iree_allocator_free(host_allocator, entry->timepoints.payload_values);
+    iree_allocator_free(host_allocator, entry);
+    entry = next;
+  }
+  iree_slim_mutex_deinitialize(&cache->mutex);
+
+  iree_allocator_free(host_allocator, cache);
+
+  IREE_TRACE_ZONE_END(z0);
+}
+
+static void iree_io_packed_parameter_cache_entry_release(
+    void* user_data, iree_io_file_handle_primitive_t handle_primitive) {
+  iree_io_packed_parameter_cache_t* cache =
+      (iree_io_packed_parameter_cache_t*)user_data;
+  iree_allocator_free_aligned(cache->host_allocator,
+                              handle_primitive.value.host_allocation.data);
+}
+
+// Adds a new host-backed entry for |key| to the cache index in the given
+// initial |state|.
+// Must be called with the cache mutex held.
+static iree_status_t iree_io_packed_parameter_cache_add_entry(
+    iree_io_packed_parameter_cache_t* cache, iree_string_view_t key,
+    uint64_t length, iree_io_packed_parameter_cache_entry_state_t state,
+    iree_io_packed_parameter_cache_entry_t** out_entry,
+    iree_byte_span_t* out_storage) {
+  if (length > IREE_HOST_SIZE_MAX) {
+    return iree_make_status(IREE_STATUS_OUT_OF_RANGE,
+                            "cache entry length %" PRIu64
+                            " exceeds host addressable memory",
+                            length);
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_TEXT(z0, key.data, key.size);
+  IREE_TRACE_ZONE_APPEND_VALUE_I64(z0, length);
+
+  iree_io_packed_parameter_cache_entry_t* entry = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(cache->host_allocator, sizeof(*entry),
+                                (void**)&entry));
+  entry->state = state;
+
+  void* storage = NULL;
+  iree_status_t status = iree_allocator_malloc_aligned(
+      cache->host_allocator, iree_max(1, (iree_host_size_t)length),
+      IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_ALIGNMENT, 0, &storage);
+  iree_io_file_handle_t* file_handle = NULL;
+  if (iree_status_is_ok(status)) {
+    memset(storage, 0, (iree_host_size_t)length);
+    iree_io_file_handle_release_callback_t release_callback = {
+        .fn = iree_io_packed_parameter_cache_entry_release,
+        .user_data = cache,
+    };
+    status = iree_io_file_handle_wrap_host_allocation(
+        IREE_IO_FILE_ACCESS_READ | IREE_IO_FILE_ACCESS_WRITE,
+        iree_make_byte_span(storage, (iree_host_size_t)length),
+        release_callback, cache->host_allocator, &file_handle);
+    if (!iree_status_is_ok(status)) {
+      iree_allocator_free_aligned(cache->host_allocator, storage);
+    }
+  }
+
+  if (iree_status_is_ok(status)) {
+    iree_io_parameter_index_entry_t index_entry = {
+        .key = key,
+        .metadata = iree_const_byte_span_empty(),
+        .length = length,
+        .type = IREE_IO_PARAMETER_INDEX_ENTRY_STORAGE_TYPE_FILE,
+        .storage.file.handle = file_handle,
+        .storage.file.offset = 0,
+    };
+    status = iree_io_parameter_index_add(cache->index, &index_entry);
+    iree_io_file_handle_release(file_handle);
+  }
+  if (iree_status_is_ok(status)) {
+    status =
+        iree_io_parameter_index_lookup(cache->index, key, &entry->index_entry);
+  }
+
+  if (iree_status_is_ok(status)) {
+    entry->next = cache->entry_head;
+    cache->entry_head = entry;
+    if (state == IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_COMMITTED) {
+      cache->dirty = true;
+    }
+    if (out_entry) *out_entry = entry;
+    if (out_storage) {
+      *out_storage = iree_make_byte_span(storage, (iree_host_size_t)length);
+    }
+  } else {
+    iree_allocator_free(cache->host_allocator, entry);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+IREE_API_EXPORT iree_status_t iree_io_packed_parameter_cache_reserve(
+    iree_io_parameter_provider_t* provider, iree_string_view_t key,
+    uint64_t length, iree_byte_span_t* out_storage) {
+  IREE_ASSERT_ARGUMENT(provider);
+  IREE_ASSERT_ARGUMENT(out_storage);
+  *out_storage = iree_byte_span_empty();
+  iree_io_packed_parameter_cache_t* cache =
+      iree_io_packed_parameter_cache_cast(provider);
+  iree_slim_mutex_lock(&cache->mutex);
+  const iree_io_parameter_index_entry_t* entry = NULL;
+  iree_status_t status =
+      iree_io_parameter_index_lookup(cache->index, key, &entry);
+  if (iree_status_is_ok(status)) {
+    status = iree_make_status(IREE_STATUS_ALREADY_EXISTS,
+                              "packed parameter '%.*s' is already cached",
+                              (int)key.size, key.data);
+  } else if (iree_status_is_not_found(status)) {
+    iree_status_ignore(status);
+    status = iree_io_packed_parameter_cache_add_entry(
+        cache, key, length,
+        IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_COMMITTED,
+        /*out_entry=*/NULL, out_storage);
+  }
+  iree_slim_mutex_unlock(&cache->mutex);
+  return status;
+}
+
+typedef struct iree_io_packed_parameter_cache_open_params_t {
+  const char* path;
+  iree_allocator_t host_allocator;
+} iree_io_packed_parameter_cache_open_params_t;
+
+static iree_status_t iree_io_packed_parameter_cache_open_temp_file(
+    void* user_data, iree_io_physical_offset_t archive_offset,
+    iree_io_physical_size_t archive_length,
+    iree_io_file_handle_t** out_file_handle) {
+  iree_io_packed_parameter_cache_open_params_t* params =
+      (iree_io_packed_parameter_cache_open_params_t*)user_data;
+  // Left behind by an interrupted flush, if it exists.
+  remove(params->path);
+  return iree_io_file_handle_create(
+      IREE_IO_FILE_MODE_READ | IREE_IO_FILE_MODE_WRITE,
+      iree_make_cstring_view(params->path), archive_offset + archive_length,
+      params->host_allocator, out_file_handle);
+}
+
+IREE_API_EXPORT iree_status_t
+iree_io_packed_parameter_cache_flush(iree_io_parameter_provider_t* provider) {
+  IREE_ASSERT_ARGUMENT(provider);
+  iree_io_packed_parameter_cache_t* cache =
+      iree_io_packed_parameter_cache_cast(provider);
+  iree_slim_mutex_lock(&cache->mutex);
+  iree_io_packed_parameter_cache_resolve_entries(cache);
+  if (!cache->dirty) {
+    iree_slim_mutex_unlock(&cache->mutex);
+    return iree_ok_status();
+  }
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_TRACE_ZONE_APPEND_TEXT(z0, cache->path);
+
+  // Only persist existing and committed entries. The contents of pending
+  // entries are undefined until their scatters complete and failed entries
+  // would be loaded as if they were valid by the next run.
+  iree_io_parameter_index_t* persist_index = NULL;
+  iree_status_t status =
+      iree_io_parameter_index_create(cache->host_allocator, &persist_index);
+  const iree_host_size_t entry_count =
+      iree_io_parameter_index_count(cache->index);
+  for (iree_host_size_t i = 0; i < entry_count && iree_status_is_ok(status);
+       ++i) {
+    const iree_io_parameter_index_entry_t* index_entry = NULL;
+    status = iree_io_parameter_index_get(cache->index, i, &index_entry);
+    if (!iree_status_is_ok(status)) break;
+    iree_io_packed_parameter_cache_entry_t* entry =
+        iree_io_packed_parameter_cache_find_entry(cache, index_entry);
+    if (entry &&
+        entry->state != IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_COMMITTED) {
+      continue;
+    }
+    status = iree_io_parameter_index_add(persist_index, index_entry);
+  }
+
+  // Write the whole archive to a temporary file so that concurrent readers of
+  // the sidecar (including ourselves) never observe a partial archive.
+  iree_io_parameter_index_t* built_index = NULL;
+  if (iree_status_is_ok(status)) {
+    status =
+        iree_io_parameter_index_create(cache->host_allocator, &built_index);
+  }
+  if (iree_status_is_ok(status)) {
+    iree_io_packed_parameter_cache_open_params_t open_params = {
+        .path = cache->temp_path,
+        .host_allocator = cache->host_allocator,
+    };
+    iree_io_parameter_archive_file_open_callback_t open_callback = {
+        .fn = iree_io_packed_parameter_cache_open_temp_file,
+        .user_data = &open_params,
+    };
+    status = iree_io_build_parameter_archive(persist_index, built_index,
+                                             open_callback,
+                                             /*target_file_offset=*/0,
+                                             cache->host_allocator);
+  }
+  // Closes the temporary file.
+  iree_io_parameter_index_release(built_index);
+  iree_io_parameter_index_release(persist_index);
+
+  // Replace the sidecar. Some platforms refuse to rename over an existing file
+  // so retry after removing it; open handles to the old sidecar keep their
+  // contents on platforms that allow removing open files.
+  if (iree_status_is_ok(status) &&
+      rename(cache->temp_path, cache->path) != 0) {
+    remove(cache->path);
+    if (rename(cache->temp_path, cache->path) != 0) {
+      status = iree_make_status(IREE_STATUS_UNAVAILABLE,
+                                "failed to replace packed parameter cache '%s'",
+                                cache->path);
+    }
+  }
+  if (iree_status_is_ok(status)) {
+    cache->dirty = false;
+  }
+
+  IREE_TRACE_ZONE_END(z0);
+  iree_slim_mutex_unlock(&cache->mutex);
+  return status;
+}
+
+static iree_status_t iree_io_packed_parameter_cache_notify(
+    iree_io_parameter_provider_t* base_provider,
+    iree_io_parameter_provider_signal_t signal) {
+  iree_io_packed_parameter_cache_t* cache =
+      iree_io_packed_parameter_cache_cast(base_provider);
+  return iree_io_parameter_provider_notify(cache->index_provider, signal);
+}
+
+static bool iree_io_packed_parameter_cache_query_support(
+    iree_io_parameter_provider_t* base_provider, iree_string_view_t scope) {
+  iree_io_packed_parameter_cache_t* cache =
+      iree_io_packed_parameter_cache_cast(base_provider);
+  return iree_string_view_equal(scope, cache->scope);
+}
+
+static iree_status_t iree_io_packed_parameter_cache_query_length(
+    iree_io_parameter_provider_t* base_provider, iree_string_view_t scope,
+    iree_string_view_t key, uint64_t* out_length) {
+  iree_io_packed_parameter_cache_t* cache =
+      iree_io_packed_parameter_cache_cast(base_provider);
+  IREE_RETURN_IF_ERROR(iree_io_parameter_provider_query_length(
+      cache->index_provider, scope, key, out_length));
+
+  // Pending entries are reported as present: anything ordered after the
+  // scatter producing them observes their contents. Failed entries are hidden
+  // so that programs regenerate them.
+  iree_slim_mutex_lock(&cache->mutex);
+  iree_io_packed_parameter_cache_resolve_entries(cache);
+  const iree_io_parameter_index_entry_t* index_entry = NULL;
+  iree_status_t status =
+      iree_io_parameter_index_lookup(cache->index, key, &index_entry);
+  if (iree_status_is_ok(status)) {
+    iree_io_packed_parameter_cache_entry_t* entry =
+        iree_io_packed_parameter_cache_find_entry(cache, index_entry);
+    if (entry &&
+        entry->state == IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_FAILED) {
+      status = iree_make_status(IREE_STATUS_NOT_FOUND,
+                                "packed parameter '%.*s' failed to populate",
+                                (int)key.size, key.data);
+    }
+  }
+  iree_slim_mutex_unlock(&cache->mutex);
+  if (!iree_status_is_ok(status)) *out_length = 0;
+  return status;
+}
+
+static iree_status_t iree_io_packed_parameter_cache_load(
+    iree_io_parameter_provider_t* base_provider, iree_hal_device_t* device,
+    iree_hal_queue_affinity_t queue_affinity,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list,
+    iree_string_view_t source_scope, iree_hal_buffer_params_t target_params,
+    iree_host_size_t count, iree_io_parameter_enumerator_t enumerator,
+    iree_io_parameter_emitter_t emitter) {
+  iree_io_packed_parameter_cache_t* cache =
+      iree_io_packed_parameter_cache_cast(base_provider);
+  return iree_io_parameter_provider_load(
+      cache->index_provider, device, queue_affinity, wait_semaphore_list,
+      signal_semaphore_list, source_scope, target_params, count, enumerator,
+      emitter);
+}
+
+static iree_status_t iree_io_packed_parameter_cache_gather(
+    iree_io_parameter_provider_t* base_provider, iree_hal_device_t* device,
+    iree_hal_queue_affinity_t queue_affinity,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list,
+    iree_string_view_t source_scope, iree_hal_buffer_t* target_buffer,
+    iree_host_size_t count, iree_io_parameter_enumerator_t enumerator) {
+  iree_io_packed_parameter_cache_t* cache =
+      iree_io_packed_parameter_cache_cast(base_provider);
+  return iree_io_parameter_provider_gather(
+      cache->index_provider, device, queue_affinity, wait_semaphore_list,
+      signal_semaphore_list, source_scope, target_buffer, count, enumerator);
+}
+
+static iree_status_t iree_io_packed_parameter_cache_scatter(
+    iree_io_parameter_provider_t* base_provider, iree_hal_device_t* device,
+    iree_hal_queue_affinity_t queue_affinity,
+    const iree_hal_semaphore_list_t wait_semaphore_list,
+    const iree_hal_semaphore_list_t signal_semaphore_list,
+    iree_hal_buffer_t* source_buffer, iree_string_view_t target_scope,
+    iree_host_size_t count, iree_io_parameter_enumerator_t enumerator) {
+  iree_io_packed_parameter_cache_t* cache =
+      iree_io_packed_parameter_cache_cast(base_provider);
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Add pending entries for keys not yet in the cache; the index provider then
+  // handles the scatter as with any other file-backed parameters. All entries
+  // targeted by the scatter are tagged so that they can be committed or failed
+  // based on the outcome of the scatter.
+  iree_status_t status = iree_ok_status();
+  iree_slim_mutex_lock(&cache->mutex);
+  const uint64_t scatter_id = ++cache->next_scatter_id;
+  for (iree_host_size_t i = 0; i < count && iree_status_is_ok(status); ++i) {
+    iree_string_view_t key = iree_string_view_empty();
+    iree_io_parameter_span_t span = {0};
+    status = enumerator.fn(enumerator.user_data, i, &key, &span);
+    if (!iree_status_is_ok(status)) break;
+    const iree_io_parameter_index_entry_t* index_entry = NULL;
+    iree_io_packed_parameter_cache_entry_t* entry = NULL;
+    status = iree_io_parameter_index_lookup(cache->index, key, &index_entry);
+    if (iree_status_is_ok(status)) {
+      entry = iree_io_packed_parameter_cache_find_entry(cache, index_entry);
+    } else if (iree_status_is_not_found(status)) {
+      status = iree_status_ignore(status);
+      // Size the entry to cover all spans targeting it in this scatter.
+      uint64_t length = span.parameter_offset + span.length;
+      for (iree_host_size_t j = i + 1; j < count; ++j) {
+        iree_string_view_t other_key = iree_string_view_empty();
+        iree_io_parameter_span_t other_span = {0};
+        status = enumerator.fn(enumerator.user_data, j, &other_key,
+                               &other_span);
+        if (!iree_status_is_ok(status)) break;
+        if (iree_string_view_equal(other_key, key)) {
+          length =
+              iree_max(length, other_span.parameter_offset + other_span.length);
+        }
+      }
+      if (iree_status_is_ok(status)) {
+        status = iree_io_packed_parameter_cache_add_entry(
+            cache, key, length,
+            IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_PENDING, &entry,
+            /*out_storage=*/NULL);
+      }
+    }
+    if (iree_status_is_ok(status) && entry && entry->scatter_id != scatter_id) {
+      // Entries being overwritten or retried are pending until the scatter
+      // completes.
+      entry->state = IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_PENDING;
+      entry->scatter_id = scatter_id;
+      status = iree_io_packed_parameter_cache_entry_append_timepoints(
+          cache, entry, signal_semaphore_list);
+    }
+  }
+  iree_slim_mutex_unlock(&cache->mutex);
+
+  if (iree_status_is_ok(status)) {
+    status = iree_io_parameter_provider_scatter(
+        cache->index_provider, device, queue_affinity, wait_semaphore_list,
+        signal_semaphore_list, source_buffer, target_scope, count, enumerator);
+  }
+
+  // Entries only commit once all of their scatters have signaled; scatters
+  // without signal semaphores have completed once they return.
+  iree_slim_mutex_lock(&cache->mutex);
+  for (iree_io_packed_parameter_cache_entry_t* entry = cache->entry_head;
+       entry; entry = entry->next) {
+    if (entry->scatter_id != scatter_id) continue;
+    if (!iree_status_is_ok(status)) {
+      entry->state = IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_FAILED;
+      iree_io_packed_parameter_cache_entry_reset_timepoints(entry);
+    } else if (entry->state ==
+                   IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_PENDING &&
+               entry->timepoints.count == 0) {
+      entry->state = IREE_IO_PACKED_PARAMETER_CACHE_ENTRY_STATE_COMMITTED;
+      cache->dirty = true;
+    }
+  }
+  iree_slim_mutex_unlock(&cache->mutex);
+
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+static const iree_io_parameter_provider_vtable_t
+    iree_io_packed_parameter_cache_vtable = {
+        .destroy = iree_io_packed_parameter_cache_destroy,
+        .notify = iree_io_packed_parameter_cache_notify,
+        .query_support = iree_io_packed_parameter_cache_query_support,
+        .query_length = iree_io_packed_parameter_cache_query_length,
+        .load = iree_io_packed_parameter_cache_load,
+        .gather = iree_io_packed_parameter_cache_gather,
+        .scatter = iree_io_packed_parameter_cache_scatter,
+};
@@ -0,0 +1,87 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_IO_PACKED_PARAMETER_CACHE_H_
+#define IREE_IO_PACKED_PARAMETER_CACHE_H_
+
+#include <stdint.h>
+
+#include "iree/base/api.h"
+#include "iree/hal/api.h"
+#include "iree/io/parameter_provider.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+//===----------------------------------------------------------------------===//
+// Packed parameter cache keys
+//===----------------------------------------------------------------------===//
+
+// Appends the cache key used for the packed form of the parameter |key| to
+// |builder|. The packed form depends on the data layout |encoding| (such as
+// the printed encoding attribute of the packed tensor) and the |target| it was
+// packed for (such as the executable target) and both are hashed into the key:
+// `<key>@<16 hex digits>`. Any change to either produces a new key and a stale
+// cache entry is simply never referenced again.
+IREE_API_EXPORT iree_status_t iree_io_packed_parameter_cache_append_key(
+    iree_string_view_t key, iree_string_view_t encoding,
+    iree_string_view_t target, iree_string_builder_t* builder);
+
+//===----------------------------------------------------------------------===//
+// iree_io_packed_parameter_cache_t
+//===----------------------------------------------------------------------===//
+
+// A parameter provider persisting parameters produced by programs (such as the
+// outputs of weight packing dispatches in initializers) into an IRPA sidecar
+// file so that later runs can load them directly.
+//
+// Programs check for a cached parameter with
+// iree_io_parameter_provider_query_length (`io_parameters.query`) and either
+// load/gather it or produce it and scatter it to the cache scope. Scattering
+// to a key that is not yet in the cache allocates host storage for it sized to
+// the furthest extent of the spans scattered to it. New entries are pending
+// until their scatters complete and are then written out along with all
+// existing entries when the cache is flushed; the sidecar is replaced
+// atomically where the platform allows. Entries whose scatters fail are
+// reported as not found so that programs regenerate them.
+// Entries already present in the sidecar are read-only.
+//
+// Thread-safe: scatters may be issued from multiple contexts concurrently as
+// long as they target different keys.
+
+// Creates a packed parameter cache provider handling |scope| that is backed by
+// the IRPA sidecar file at |path|. The file is indexed if it exists and will be
+// created on the first flush that has new entries otherwise.
+IREE_API_EXPORT iree_status_t iree_io_packed_parameter_cache_create(
+    iree_string_view_t scope, iree_string_view_t path,
+    iree_host_size_t max_concurrent_operations, iree_allocator_t host_allocator,
+    iree_io_parameter_provider_t** out_provider);
+
+// Returns a zero-initialized host buffer of |length| bytes backing the new
+// cache entry |key| of the cache |provider|. Hosts can use this to populate
+// the cache without going through a device. The returned memory remains valid
+// for the lifetime of the provider and must be fully written prior to the next
+// flush. Returns IREE_STATUS_ALREADY_EXISTS if |key| is already in the cache.
+IREE_API_EXPORT iree_status_t iree_io_packed_parameter_cache_reserve(
+    iree_io_parameter_provider_t* provider, iree_string_view_t key,
+    uint64_t length, iree_byte_span_t* out_storage);
+
+// Writes all cache entries to the sidecar file if any were committed since the
+// cache was created or last flushed. Entries created by scatters are only
+// committed once the signal semaphores of every scatter into them have been
+// reached; entries with scatters still in flight are left for a later flush
+// and entries whose scatters failed are never written. Flushing also happens
+// when the provider is destroyed; errors there are dropped as the cache only
+// affects load times.
+IREE_API_EXPORT iree_status_t
+iree_io_packed_parameter_cache_flush(iree_io_parameter_provider_t* provider);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_IO_PACKED_PARAMETER_CACHE_H_
@@ -0,0 +1,326 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/io/packed_parameter_cache.h"
+
+#include "iree/base/api.h"
+
+#if IREE_FILE_IO_ENABLE
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "iree/hal/drivers/local_sync/sync_device.h"
+#include "iree/io/file_handle.h"
+#include "iree/io/formats/irpa/irpa_parser.h"
+#include "iree/io/parameter_index.h"
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace iree {
+namespace io {
+namespace {
+
+using ::iree::testing::status::StatusIs;
+
+static std::string GetUniquePath(const char* unique_name) {
+  char* test_tmpdir = getenv("TEST_TMPDIR");
+  if (!test_tmpdir) test_tmpdir = getenv("TMPDIR");
+  if (!test_tmpdir) test_tmpdir = getenv("TEMP");
+  if (!test_tmpdir) {
+    std::cerr << "TEST_TMPDIR/TMPDIR/TEMP not defined\n";
+    exit(1);
+  }
+  std::random_device d;
+  std::uint64_t random = (static_cast<std::uint64_t>(d()) << 32) | d();
+  char unique_path[256];
+  snprintf(unique_path, sizeof unique_path, "%s/iree_test_%" PRIx64 "_%s",
+           test_tmpdir, random, unique_name);
+  return unique_path;
+}
+
+static std::string MakeKey(const char* key, const char* encoding,
+                           const char* target) {
+  iree_string_builder_t builder;
+  iree_string_builder_initialize(iree_allocator_system(), &builder);
+  IREE_CHECK_OK(iree_io_packed_parameter_cache_append_key(
+      iree_make_cstring_view(key), iree_make_cstring_view(encoding),
+      iree_make_cstring_view(target), &builder));
+  std::string result(iree_string_builder_buffer(&builder),
+                     iree_string_builder_size(&builder));
+  iree_string_builder_deinitialize(&builder);
+  return result;
+}
+
+TEST(PackedParameterCacheTest, Keys) {
+  std::string key = MakeKey("w0", "#encoding<a>", "x86_64");
+  EXPECT_EQ(key.rfind("w0@", 0), 0u);
+  EXPECT_EQ(key.size(), strlen("w0@") + 16);
+  // Stable.
+  EXPECT_EQ(key, MakeKey("w0", "#encoding<a>", "x86_64"));
+  // Distinct for distinct encodings and targets.
+  EXPECT_NE(key, MakeKey("w0", "#encoding<b>", "x86_64"));
+  EXPECT_NE(key, MakeKey("w0", "#encoding<a>", "aarch64"));
+  EXPECT_NE(MakeKey("w0", "ab", "c"), MakeKey("w0", "a", "bc"));
+}
+
+TEST(PackedParameterCacheTest, PersistsEntries) {
+  std::string path = GetUniquePath("packed.irpa");
+  iree_string_view_t scope = IREE_SV("packed");
+
+  // Populate a new cache; the sidecar is only written once there's something
+  // in it.
+  iree_io_parameter_provider_t* provider = NULL;
+  IREE_ASSERT_OK(iree_io_packed_parameter_cache_create(
+      scope, iree_make_cstring_view(path.c_str()), 1, iree_allocator_system(),
+      &provider));
+  EXPECT_TRUE(iree_io_parameter_provider_query_support(provider, scope));
+  EXPECT_FALSE(
+      iree_io_parameter_provider_query_support(provider, IREE_SV("other")));
+  IREE_ASSERT_OK(iree_io_packed_parameter_cache_flush(provider));
+  EXPECT_EQ(fopen(path.c_str(), "rb"), nullptr);
+
+  uint64_t length = 0;
+  EXPECT_THAT(Status(iree_io_parameter_provider_query_length(
+                  provider, scope, IREE_SV("a"), &length)),
+              StatusIs(StatusCode::kNotFound));
+  iree_byte_span_t storage = iree_byte_span_empty();
+  IREE_ASSERT_OK(iree_io_packed_parameter_cache_reserve(provider, IREE_SV("a"),
+                                                        100, &storage));
+  ASSERT_EQ(storage.data_length, 100u);
+  for (iree_host_size_t i = 0; i < storage.data_length; ++i) {
+    storage.data[i] = (uint8_t)i;
+  }
+  EXPECT_THAT(Status(iree_io_packed_parameter_cache_reserve(
+                  provider, IREE_SV("a"), 100, &storage)),
+              StatusIs(StatusCode::kAlreadyExists));
+  IREE_ASSERT_OK(iree_io_parameter_provider_query_length(
+      provider, scope, IREE_SV("a"), &length));
+  EXPECT_EQ(length, 100u);
+  iree_io_parameter_provider_release(provider);  // flushes
+
+  // Reopen: the entry should come back from the sidecar.
+  IREE_ASSERT_OK(iree_io_packed_parameter_cache_create(
+      scope, iree_make_cstring_view(path.c_str()), 1, iree_allocator_system(),
+      &provider));
+  IREE_ASSERT_OK(iree_io_parameter_provider_query_length(
+      provider, scope, IREE_SV("a"), &length));
+  EXPECT_EQ(length, 100u);
+  IREE_ASSERT_OK(iree_io_packed_parameter_cache_reserve(provider, IREE_SV("b"),
+                                                        3, &storage));
+  memcpy(storage.data, "xyz", 3);
+  IREE_ASSERT_OK(iree_io_packed_parameter_cache_flush(provider));
+  iree_io_parameter_provider_release(provider);
+
+  // Check the sidecar contents directly.
+  iree_io_file_handle_t* file_handle = NULL;
+  IREE_ASSERT_OK(iree_io_file_handle_preload(
+      IREE_IO_FILE_MODE_READ, iree_make_cstring_view(path.c_str()),
+      iree_allocator_system(), &file_handle));
+  iree_io_parameter_index_t* index = NULL;
+  IREE_ASSERT_OK(
+      iree_io_parameter_index_create(iree_allocator_system(), &index));
+  IREE_ASSERT_OK(
+      iree_io_parse_irpa_index(file_handle, index, iree_allocator_system()));
+  EXPECT_EQ(iree_io_parameter_index_count(index), 2u);
+  iree_byte_span_t contents =
+      iree_io_file_handle_primitive(file_handle).value.host_allocation;
+  const iree_io_parameter_index_entry_t* entry = NULL;
+  IREE_ASSERT_OK(iree_io_parameter_index_lookup(index, IREE_SV("a"), &entry));
+  ASSERT_EQ(entry->length, 100u);
+  for (iree_host_size_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(contents.data[entry->storage.file.offset + i], (uint8_t)i);
+  }
+  IREE_ASSERT_OK(iree_io_parameter_index_lookup(index, IREE_SV("b"), &entry));
+  ASSERT_EQ(entry->length, 3u);
+  EXPECT_EQ(memcmp(contents.data + entry->storage.file.offset, "xyz", 3), 0);
+  iree_io_parameter_index_release(index);
+  iree_io_file_handle_release(file_handle);
+
+  remove(path.c_str());
+}
+
+// A scatter of spans from a host buffer to the cache.
+struct ScatterSpan {
+  const char* key;
+  iree_io_parameter_span_t span;
+};
+
+static iree_status_t EnumerateScatterSpans(void* user_data, iree_host_size_t i,
+                                           iree_string_view_t* out_key,
+                                           iree_io_parameter_span_t* out_span) {
+  auto* spans = reinterpret_cast<std::vector<ScatterSpan>*>(user_data);
+  *out_key = iree_make_cstring_view((*spans)[i].key);
+  *out_span = (*spans)[i].span;
+  return iree_ok_status();
+}
+
+class PackedParameterCacheScatterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    iree_allocator_t host_allocator = iree_allocator_system();
+    iree_hal_allocator_t* device_allocator = NULL;
+    IREE_ASSERT_OK(iree_hal_allocator_create_heap(
+        IREE_SV("local"), host_allocator, host_allocator, &device_allocator));
+    iree_hal_sync_device_params_t params;
+    iree_hal_sync_device_params_initialize(&params);
+    IREE_ASSERT_OK(iree_hal_sync_device_create(
+        IREE_SV("local-sync"), &params, /*loader_count=*/0, /*loaders=*/NULL,
+        device_allocator, host_allocator, &device_));
+    iree_hal_allocator_release(device_allocator);
+
+    // Source buffer filled with its byte offsets.
+    iree_hal_buffer_params_t buffer_params = {0};
+    buffer_params.type =
+        IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL | IREE_HAL_MEMORY_TYPE_HOST_VISIBLE;
+    buffer_params.usage =
+        IREE_HAL_BUFFER_USAGE_TRANSFER | IREE_HAL_BUFFER_USAGE_MAPPING;
+    IREE_ASSERT_OK(iree_hal_allocator_allocate_buffer(
+        iree_hal_device_allocator(device_), buffer_params, kSourceLength,
+        &source_buffer_));
+    uint8_t source_data[kSourceLength];
+    for (iree_host_size_t i = 0; i < kSourceLength; ++i) {
+      source_data[i] = (uint8_t)i;
+    }
+    IREE_ASSERT_OK(iree_hal_buffer_map_write(source_buffer_, 0, source_data,
+                                             sizeof(source_data)));
+  }
+
+  void TearDown() override {
+    iree_hal_buffer_release(source_buffer_);
+    iree_hal_device_release(device_);
+  }
+
+  // Scatters |spans| from the source buffer to |provider| once
+  // |wait_semaphore| reaches 1 and signals |signal_semaphore| to 1.
+  iree_status_t Scatter(iree_io_parameter_provider_t* provider,
+                        iree_string_view_t scope,
+                        iree_hal_semaphore_t* wait_semaphore,
+                        iree_hal_semaphore_t* signal_semaphore,
+                        std::vector<ScatterSpan> spans) {
+    uint64_t payload_value = 1;
+    iree_hal_semaphore_list_t wait_semaphore_list = {1, &wait_semaphore,
+                                                     &payload_value};
+    iree_hal_semaphore_list_t signal_semaphore_list = {1, &signal_semaphore,
+                                                       &payload_value};
+    iree_io_parameter_enumerator_t enumerator = {EnumerateScatterSpans,
+                                                 &spans};
+    return iree_io_parameter_provider_scatter(
+        provider, device_, IREE_HAL_QUEUE_AFFINITY_ANY, wait_semaphore_list,
+        signal_semaphore_list, source_buffer_, scope, spans.size(),
+        enumerator);
+  }
+
+  iree_hal_semaphore_t* CreateSemaphore() {
+    iree_hal_semaphore_t* semaphore = NULL;
+    IREE_CHECK_OK(iree_hal_semaphore_create(
+        device_, IREE_HAL_QUEUE_AFFINITY_ANY, 0,
+        IREE_HAL_SEMAPHORE_FLAG_NONE, &semaphore));
+    return semaphore;
+  }
+
+  static constexpr iree_device_size_t kSourceLength = 64;
+  iree_hal_device_t* device_ = NULL;
+  iree_hal_buffer_t* source_buffer_ = NULL;
+};
+
+// Tests that new entries are sized to cover every span scattered to them and
+// are persisted once the scatter completes.
+TEST_F(PackedParameterCacheScatterTest, PersistsCompletedScatters) {
+  std::string path = GetUniquePath("scatter.irpa");
+  iree_string_view_t scope = IREE_SV("packed");
+  iree_io_parameter_provider_t* provider = NULL;
+  IREE_ASSERT_OK(iree_io_packed_parameter_cache_create(
+      scope, iree_make_cstring_view(path.c_str()), 1, iree_allocator_system(),
+      &provider));
+
+  // The second span ends before the first but the entry must cover both.
+  iree_hal_semaphore_t* wait_semaphore = CreateSemaphore();
+  iree_hal_semaphore_t* signal_semaphore = CreateSemaphore();
+  IREE_ASSERT_OK(iree_hal_semaphore_signal(wait_semaphore, 1));
+  IREE_ASSERT_OK(Scatter(provider, scope, wait_semaphore, signal_semaphore,
+                         {
+                             {"p", {/*parameter_offset=*/32,
+                                    /*buffer_offset=*/32, /*length=*/32}},
+                             {"p", {/*parameter_offset=*/0,
+                                    /*buffer_offset=*/0, /*length=*/32}},
+                         }));
+  IREE_ASSERT_OK(iree_hal_semaphore_wait(signal_semaphore, 1,
+                                         iree_infinite_timeout(),
+                                         IREE_HAL_WAIT_FLAG_DEFAULT));
+  iree_hal_semaphore_release(signal_semaphore);
+  iree_hal_semaphore_release(wait_semaphore);
+  IREE_ASSERT_OK(iree_io_packed_parameter_cache_flush(provider));
+  iree_io_parameter_provider_release(provider);
+
+  // Reopen and check that the whole entry came back from the sidecar.
+  iree_io_file_handle_t* file_handle = NULL;
+  IREE_ASSERT_OK(iree_io_file_handle_preload(
+      IREE_IO_FILE_MODE_READ, iree_make_cstring_view(path.c_str()),
+      iree_allocator_system(), &file_handle));
+  iree_io_parameter_index_t* index = NULL;
+  IREE_ASSERT_OK(
+      iree_io_parameter_index_create(iree_allocator_system(), &index));
+  IREE_ASSERT_OK(
+      iree_io_parse_irpa_index(file_handle, index, iree_allocator_system()));
+  const iree_io_parameter_index_entry_t* entry = NULL;
+  IREE_ASSERT_OK(iree_io_parameter_index_lookup(index, IREE_SV("p"), &entry));
+  ASSERT_EQ(entry->length, kSourceLength);
+  iree_byte_span_t contents =
+      iree_io_file_handle_primitive(file_handle).value.host_allocation;
+  for (iree_host_size_t i = 0; i < kSourceLength; ++i) {
+    EXPECT_EQ(contents.data[entry->storage.file.offset + i], (uint8_t)i);
+  }
+  iree_io_parameter_index_release(index);
+  iree_io_file_handle_release(file_handle);
+
+  remove(path.c_str());
+}
+
+// Tests that entries of failed scatters are hidden and never persisted.
+TEST_F(PackedParameterCacheScatterTest, DropsFailedScatters) {
+  std::string path = GetUniquePath("failed.irpa");
+  iree_string_view_t scope = IREE_SV("packed");
+  iree_io_parameter_provider_t* provider = NULL;
+  IREE_ASSERT_OK(iree_io_packed_parameter_cache_create(
+      scope, iree_make_cstring_view(path.c_str()), 1, iree_allocator_system(),
+      &provider));
+
+  // The producer of the scatter source failed so the scatter never runs.
+  iree_hal_semaphore_t* wait_semaphore = CreateSemaphore();
+  iree_hal_semaphore_t* signal_semaphore = CreateSemaphore();
+  iree_hal_semaphore_fail(wait_semaphore,
+                          iree_make_status(IREE_STATUS_CANCELLED));
+  iree_status_ignore(Scatter(
+      provider, scope, wait_semaphore, signal_semaphore,
+      {{"p", {/*parameter_offset=*/0, /*buffer_offset=*/0, /*length=*/64}}}));
+  iree_status_ignore(iree_hal_semaphore_wait(signal_semaphore, 1,
+                                             iree_infinite_timeout(),
+                                             IREE_HAL_WAIT_FLAG_DEFAULT));
+  iree_hal_semaphore_release(signal_semaphore);
+  iree_hal_semaphore_release(wait_semaphore);
+
+  uint64_t length = 0;
+  EXPECT_THAT(Status(iree_io_parameter_provider_query_length(
+                  provider, scope, IREE_SV("p"), &length)),
+              StatusIs(StatusCode::kNotFound));
+  IREE_ASSERT_OK(iree_io_packed_parameter_cache_flush(provider));
+  iree_io_parameter_provider_release(provider);
+  EXPECT_EQ(fopen(path.c_str(), "rb"), nullptr);
+
+  remove(path.c_str());
+}
+
+}  // namespace
+}  // namespace io
+}  // namespace iree
+
+#endif  // IREE_FILE_IO_ENABLE
@@ -115,6 +115,18 @@ static bool iree_io_parameter_index_provider_query_support(
   return iree_string_view_equal(scope, provider->scope);
 }
 
+static iree_status_t iree_io_parameter_index_provider_query_length(
+    iree_io_parameter_provider_t* base_provider, iree_string_view_t scope,
+    iree_string_view_t key, uint64_t* out_length) {
+  iree_io_parameter_index_provider_t* provider =
+      iree_io_parameter_index_provider_cast(base_provider);
+  const iree_io_parameter_index_entry_t* entry = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_io_parameter_index_lookup(provider->index, key, &entry));
+  *out_length = entry->length;
+  return iree_ok_status();
+}
+
 // Resolves a parameter with |key| for use on the given |device|.
 // Returns the entry containing the parameter metadata and a retained
 // HAL file that stores it (must be released by the caller).
@@ -943,9 +955,12 @@ static iree_status_t iree_io_parameter_index_provider_scatter(
     const iree_io_parameter_index_entry_t* target_entry = NULL;
     iree_io_parameter_span_t span;
     iree_hal_file_t* target_file = NULL;  // retained, NULL if splat
+    // Scatters overwrite the whole span and host-backed files import as
+    // buffers that are written with discard semantics.
     status = iree_io_parameter_op_batch_resolve_entry(
-        &batch, target_scope, enumerator, i, IREE_HAL_MEMORY_ACCESS_WRITE,
-        &target_entry, &span, &target_file);
+        &batch, target_scope, enumerator, i,
+        IREE_HAL_MEMORY_ACCESS_DISCARD_WRITE, &target_entry, &span,
+        &target_file);
     if (iree_status_is_ok(status)) {
       IREE_TRACE_ZONE_APPEND_TEXT(z_entry, target_entry->key.data,
                                   target_entry->key.size);
@@ -991,6 +1006,7 @@ static const iree_io_parameter_provider_vtable_t
         .destroy = iree_io_parameter_index_provider_destroy,
         .notify = iree_io_parameter_index_provider_notify,
         .query_support = iree_io_parameter_index_provider_query_support,
+        .query_length = iree_io_parameter_index_provider_query_length,
         .load = iree_io_parameter_index_provider_load,
         .gather = iree_io_parameter_index_provider_gather,
         .scatter = iree_io_parameter_index_provider_scatter,
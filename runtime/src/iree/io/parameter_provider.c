@@ -53,6 +53,19 @@ IREE_API_EXPORT bool iree_io_parameter_provider_query_support(
   return provider->vtable->query_support(provider, scope);
 }
 
+IREE_API_EXPORT iree_status_t iree_io_parameter_provider_query_length(
+    iree_io_parameter_provider_t* provider, iree_string_view_t scope,
+    iree_string_view_t key, uint64_t* out_length) {
+  IREE_ASSERT_ARGUMENT(provider);
+  IREE_ASSERT_ARGUMENT(out_length);
+  *out_length = 0;
+  if (!provider->vtable->query_length) {
+    return iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                            "parameter provider does not support queries");
+  }
+  return provider->vtable->query_length(provider, scope, key, out_length);
+}
+
 IREE_API_EXPORT iree_status_t iree_io_parameter_provider_load(
     iree_io_parameter_provider_t* provider, iree_hal_device_t* device,
     iree_hal_queue_affinity_t queue_affinity,
@@ -74,6 +74,17 @@ iree_io_parameter_provider_notify(iree_io_parameter_provider_t* provider,
 IREE_API_EXPORT bool iree_io_parameter_provider_query_support(
     iree_io_parameter_provider_t* provider, iree_string_view_t scope);
 
+// Queries the length in bytes of the parameter |key| in |scope| and returns it
+// in |out_length|. Programs can use this to check whether an optional
+// parameter (such as a cached derivative of another parameter) is available
+// before attempting to load it.
+//
+// Returns IREE_STATUS_NOT_FOUND if the parameter is not found and
+// IREE_STATUS_UNIMPLEMENTED if the provider does not support queries.
+IREE_API_EXPORT iree_status_t iree_io_parameter_provider_query_length(
+    iree_io_parameter_provider_t* provider, iree_string_view_t scope,
+    iree_string_view_t key, uint64_t* out_length);
+
 typedef iree_status_t(IREE_API_PTR* iree_io_parameter_enumerator_fn_t)(
     void* user_data, iree_host_size_t i, iree_string_view_t* out_key,
     iree_io_parameter_span_t* out_span);
@@ -196,6 +207,11 @@ typedef struct iree_io_parameter_provider_vtable_t {
   bool(IREE_API_PTR* query_support)(iree_io_parameter_provider_t* provider,
                                     iree_string_view_t scope);
 
+  // Optional; providers that cannot answer queries may leave this NULL.
+  iree_status_t(IREE_API_PTR* query_length)(
+      iree_io_parameter_provider_t* provider, iree_string_view_t scope,
+      iree_string_view_t key, uint64_t* out_length);
+
   iree_status_t(IREE_API_PTR* load)(
       iree_io_parameter_provider_t* provider, iree_hal_device_t* device,
       iree_hal_queue_affinity_t queue_affinity,
@@ -10,6 +10,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "iree/hal/utils/object_pool.h"
 #include "iree/modules/hal/utils/buffer_diagnostics.h"
 
 //===----------------------------------------------------------------------===//
@@ -28,6 +29,11 @@
 #define IREE_HAL_MODULE_MAX_STACK_COMMAND_BUFFER_BINDING_COUNT \
   ((iree_host_size_t)64)
 
+// Maximum number of released fences whose storage is retained by each module
+// state for reuse. Programs create and join a handful of fences per invocation
+// and this keeps those from hitting the host allocator in the steady state.
+#define IREE_HAL_MODULE_FENCE_POOL_CAPACITY ((iree_host_size_t)32)
+
 //===----------------------------------------------------------------------===//
 // iree_hal_module_device_policy_t
 //===----------------------------------------------------------------------===//
@@ -104,6 +110,10 @@ typedef struct iree_hal_module_state_t {
   // instead be taking a loop upon creation and scheduling work against that.
   iree_status_t loop_status;
 
+  // Pool recycling the storage of fences created by the module. Shared with
+  // forked states and retained by each fence allocated from it.
+  iree_hal_object_pool_t* fence_pool;
+
   // Shared executable cache for each device used to cache all executables
   // created in the context. We could have multiple to allow for modules to
   // create distinct sets of executables like ones for training vs inference in
@@ -133,12 +143,15 @@ iree_hal_module_alloc_state(void* self, iree_allocator_t host_allocator,
   state->devices = module->devices;
   state->loop_status = iree_ok_status();
 
-  iree_status_t status = iree_ok_status();
-  for (iree_host_size_t i = 0; i < state->device_count; ++i) {
+  iree_status_t status = iree_hal_object_pool_allocate(
+      IREE_HAL_MODULE_FENCE_POOL_CAPACITY,
+      IREE_HAL_OBJECT_POOL_DEFAULT_MAX_OBJECT_SIZE, host_allocator,
+      &state->fence_pool);
+  for (iree_host_size_t i = 0;
+       iree_status_is_ok(status) && i < state->device_count; ++i) {
     status = iree_hal_executable_cache_create(
         state->devices[i], iree_string_view_empty(),
         iree_loop_inline(&state->loop_status), &state->executable_caches[i]);
-    if (!iree_status_is_ok(status)) break;
   }
 
   if (iree_status_is_ok(status)) {
@@ -147,6 +160,7 @@ iree_hal_module_alloc_state(void* self, iree_allocator_t host_allocator,
     for (iree_host_size_t i = 0; i < state->device_count; ++i) {
       iree_hal_executable_cache_release(state->executable_caches[i]);
     }
+    iree_hal_object_pool_release(state->fence_pool);
     iree_allocator_free(host_allocator, state);
   }
   IREE_TRACE_ZONE_END(z0);
@@ -161,6 +175,7 @@ iree_hal_module_free_state(void* self, iree_vm_module_state_t* module_state) {
   for (iree_host_size_t i = 0; i < state->device_count; ++i) {
     iree_hal_executable_cache_release(state->executable_caches[i]);
   }
+  iree_hal_object_pool_release(state->fence_pool);
   iree_status_ignore(state->loop_status);
   iree_allocator_free(state->host_allocator, state);
 
@@ -192,6 +207,10 @@ static iree_status_t IREE_API_PTR iree_hal_module_fork_state(
   child_state->devices = module->devices;
   child_state->loop_status = iree_ok_status();
 
+  // Share the parent fence pool.
+  child_state->fence_pool = parent_state->fence_pool;
+  iree_hal_object_pool_retain(child_state->fence_pool);
+
   // Reference the parent executable caches.
   for (iree_host_size_t i = 0; i < child_state->device_count; ++i) {
     iree_hal_executable_cache_t* executable_cache =
@@ -1667,8 +1686,8 @@ IREE_VM_ABI_EXPORT(iree_hal_module_fence_create,  //
 
   // Create fence with room for our single semaphore.
   iree_hal_fence_t* fence = NULL;
-  iree_status_t status =
-      iree_hal_fence_create(1, state->host_allocator, &fence);
+  iree_status_t status = iree_hal_fence_create(
+      1, iree_hal_object_pool_allocator(state->fence_pool), &fence);
   if (iree_status_is_ok(status)) {
     status = iree_hal_fence_insert(fence, semaphore, 1ull);
   }
@@ -1718,7 +1737,8 @@ IREE_VM_ABI_EXPORT(iree_hal_module_fence_join,  //
   // deduplication.
   iree_hal_fence_t* joined_fence = NULL;
   IREE_RETURN_IF_ERROR(iree_hal_fence_create(
-      total_timepoint_capacity, state->host_allocator, &joined_fence));
+      total_timepoint_capacity,
+      iree_hal_object_pool_allocator(state->fence_pool), &joined_fence));
 
   // Insert all timepoints from all fences. This is slow in cases where there
   // are a lot of unique fences.
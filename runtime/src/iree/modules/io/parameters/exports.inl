@@ -26,6 +26,7 @@
 
 EXPORT_FN("gather", iree_io_parameters_module_gather, rIrrrrrrr, v)
 EXPORT_FN("load", iree_io_parameters_module_load, rIrrrIiirrr, r)
+EXPORT_FN("query", iree_io_parameters_module_query, rr, I)
 EXPORT_FN("scatter", iree_io_parameters_module_scatter, rIrrrrrrr, v)
 
 // clang-format on
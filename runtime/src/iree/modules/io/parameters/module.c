@@ -378,6 +378,36 @@ IREE_VM_ABI_EXPORT(iree_io_parameters_module_gather,   //
       enumerator_args.count, enumerator);
 }
 
+IREE_VM_ABI_EXPORT(iree_io_parameters_module_query,   //
+                   iree_io_parameters_module_state_t,  //
+                   rr, I) {
+  iree_vm_buffer_t* source_scope = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_vm_buffer_check_deref_or_null(args->r0, &source_scope));
+  iree_vm_buffer_t* key = NULL;
+  IREE_RETURN_IF_ERROR(iree_vm_buffer_check_deref(args->r1, &key));
+
+  iree_io_parameter_provider_t* provider = NULL;
+  IREE_RETURN_IF_ERROR(iree_io_parameters_module_resolve_provider(
+      IREE_IO_PARAMETERS_MODULE_CAST(module),
+      iree_vm_buffer_as_string(source_scope), &provider));
+
+  // Missing parameters are not an error: programs query to decide whether to
+  // load a parameter or to produce (and possibly scatter) it themselves.
+  uint64_t length = 0;
+  iree_status_t status = iree_io_parameter_provider_query_length(
+      provider, iree_vm_buffer_as_string(source_scope),
+      iree_vm_buffer_as_string(key), &length);
+  if (iree_status_is_not_found(status)) {
+    iree_status_ignore(status);
+    rets->i0 = -1;
+    return iree_ok_status();
+  }
+  IREE_RETURN_IF_ERROR(status);
+  rets->i0 = (int64_t)length;
+  return iree_ok_status();
+}
+
 IREE_VM_ABI_EXPORT(iree_io_parameters_module_scatter,  //
                    iree_io_parameters_module_state_t,  //
                    rIrrrrrrr, v) {
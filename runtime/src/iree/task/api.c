@@ -16,13 +16,29 @@
 // Executor configuration
 //===----------------------------------------------------------------------===//
 
+IREE_FLAG(
+    string, task_worker_spin_policy, "fixed",
+    "Policy used by workers to decide how long to spin waiting for more work\n"
+    "before parking:\n"
+    " 'fixed': always spin for --task_worker_spin_us.\n"
+    " 'latency': learn the gaps between work arriving and spin long enough\n"
+    "   to catch most of them (up to --task_worker_spin_us).\n"
+    " 'efficiency': learn the gaps between work arriving and only spin when\n"
+    "   most of them are short enough to catch.");
+
 IREE_FLAG(
     int32_t, task_worker_spin_us, 0,
     "Maximum duration in microseconds each worker should spin waiting for\n"
     "additional work. In almost all cases this should be 0 as spinning is\n"
     "often extremely harmful to system health. Only set to non-zero values\n"
     "when latency is the #1 priority (vs. thermals, system-wide scheduling,\n"
-    "etc).");
+    "etc). With adaptive spin policies this is the upper limit on the\n"
+    "learned spin and 0 uses a default limit.");
+
+IREE_FLAG(
+    int32_t, task_worker_spin_budget, 0,
+    "Maximum percentage of wall time each worker may spend spinning with an\n"
+    "adaptive --task_worker_spin_policy. 0 is unlimited.");
 
 IREE_FLAG(
     int32_t, task_worker_stack_size, 128 * 1024,
@@ -48,8 +64,19 @@ iree_status_t iree_task_executor_options_initialize_from_flags(
     iree_task_executor_options_t* out_options) {
   IREE_ASSERT_ARGUMENT(out_options);
   iree_task_executor_options_initialize(out_options);
+  IREE_RETURN_IF_ERROR(iree_task_worker_spin_policy_parse(
+      iree_make_cstring_view(FLAG_task_worker_spin_policy),
+      &out_options->worker_spin_policy));
+  if (FLAG_task_worker_spin_us < 0 || FLAG_task_worker_spin_budget < 0 ||
+      FLAG_task_worker_spin_budget > 100) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "--task_worker_spin_us= must be >= 0 and "
+                            "--task_worker_spin_budget= must be in [0, 100]");
+  }
   out_options->worker_spin_ns =
       (iree_duration_t)FLAG_task_worker_spin_us * 1000;
+  out_options->worker_spin_budget_percent =
+      (uint32_t)FLAG_task_worker_spin_budget;
   out_options->worker_stack_size =
       (iree_host_size_t)FLAG_task_worker_stack_size;
   out_options->worker_local_memory_size =
@@ -308,6 +335,9 @@ static void iree_task_flags_dump_task_topology(
     const iree_task_topology_group_t* group = &topology->groups[j];
     fprintf(stdout, "# group[%d]: '%s'\n", group->group_index, group->name);
     fprintf(stdout, "#      processor: %u\n", group->processor_index);
+    if (group->node_id != IREE_TASK_TOPOLOGY_NODE_ID_ANY) {
+      fprintf(stdout, "#      NUMA node: %u\n", group->node_id);
+    }
     fprintf(stdout, "#       affinity: ");
     if (group->ideal_thread_affinity.group_any) {
       fprintf(stdout, "group=%u (any)", group->ideal_thread_affinity.group);
@@ -29,6 +29,24 @@ void iree_task_executor_options_initialize(
   memset(out_options, 0, sizeof(*out_options));
 }
 
+iree_status_t iree_task_worker_spin_policy_parse(
+    iree_string_view_t value, iree_task_worker_spin_policy_t* out_policy) {
+  IREE_ASSERT_ARGUMENT(out_policy);
+  if (iree_string_view_equal(value, IREE_SV("fixed"))) {
+    *out_policy = IREE_TASK_WORKER_SPIN_POLICY_FIXED;
+  } else if (iree_string_view_equal(value, IREE_SV("latency"))) {
+    *out_policy = IREE_TASK_WORKER_SPIN_POLICY_LATENCY;
+  } else if (iree_string_view_equal(value, IREE_SV("efficiency"))) {
+    *out_policy = IREE_TASK_WORKER_SPIN_POLICY_EFFICIENCY;
+  } else {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "unknown worker spin policy '%.*s'; expected "
+                            "'fixed', 'latency', or 'efficiency'",
+                            (int)value.size, value.data);
+  }
+  return iree_ok_status();
+}
+
 // Returns the size of the worker local memory required by |group| in bytes.
 // We don't want destructive sharing between workers so ensure we are aligned to
 // at least the destructive interference size, even if a bit larger than what
@@ -96,7 +114,14 @@ iree_status_t iree_task_executor_create(iree_task_executor_options_t options,
   iree_atomic_ref_count_init(&executor->ref_count);
   executor->allocator = allocator;
   executor->scheduling_mode = options.scheduling_mode;
+  executor->worker_spin_policy = options.worker_spin_policy;
   executor->worker_spin_ns = options.worker_spin_ns;
+  if (options.worker_spin_policy != IREE_TASK_WORKER_SPIN_POLICY_FIXED &&
+      options.worker_spin_ns == IREE_DURATION_ZERO) {
+    executor->worker_spin_ns = IREE_TASK_WORKER_DEFAULT_MAX_ADAPTIVE_SPIN_NS;
+  }
+  executor->worker_spin_budget_percent =
+      iree_min(options.worker_spin_budget_percent, 100u);
   iree_atomic_task_slist_initialize(&executor->incoming_ready_slist);
   iree_slim_mutex_initialize(&executor->coordinator_mutex);
 
@@ -165,6 +190,7 @@ iree_status_t iree_task_executor_create(iree_task_executor_options_t options,
   if (iree_status_is_ok(status)) {
     executor->worker_base_index = options.worker_base_index;
     executor->worker_count = worker_count;
+    executor->node_id = iree_task_topology_node_id(topology);
     executor->workers =
         (iree_task_worker_t*)((uint8_t*)executor + executor_base_size);
     uint8_t* worker_local_memory =
@@ -274,6 +300,11 @@ iree_host_size_t iree_task_executor_worker_count(
   return executor->worker_count;
 }
 
+iree_task_topology_node_id_t iree_task_executor_node_id(
+    iree_task_executor_t* executor) {
+  return executor->node_id;
+}
+
 iree_event_pool_t* iree_task_executor_event_pool(
     iree_task_executor_t* executor) {
   return executor->event_pool;
@@ -127,12 +127,12 @@ extern "C" {
 //      in LIFO order.
 //
 //   c. iree_task_post_batch_submit: per-worker tasks are pushed to their
-//      respective iree_task_worker_t mailbox_slist and the workers with new
+//      respective iree_task_worker_t mailbox and the workers with new
 //      tasks are notified to wake up (if not already awake).
 //
 // 4. iree_task_worker_main_pump_once (LIFO mailbox -> FIFO thread-local list)
 //    When either woken or after completing all available thread-local work
-//    each worker will check its mailbox_slist to see if any tasks have been
+//    each worker will check its mailbox to see if any tasks have been
 //    posted.
 //
 //    a. Tasks are flushed from the LIFO mailbox into the local_task_queue FIFO
@@ -146,7 +146,7 @@ extern "C" {
 //       are made ready and placed in the executor incoming_ready_slist as with
 //       iree_task_executor_submit.
 //
-//    d. If no more thread-local work is available and the mailbox_slist is
+//    d. If no more thread-local work is available and the mailbox is
 //       empty the worker will self-nominate for coordination and attempt to don
 //       the coordinator hat with iree_task_executor_coordinate. If new work
 //       becomes available after coordination step 5 repeats.
@@ -268,6 +268,26 @@ enum iree_task_scheduling_mode_bits_t {
 };
 typedef uint32_t iree_task_scheduling_mode_t;
 
+// Controls how idle workers decide how long to spin before parking in the
+// kernel to wait for more work.
+typedef enum iree_task_worker_spin_policy_e {
+  // Each wait spins for the fixed iree_task_executor_options_t::worker_spin_ns.
+  IREE_TASK_WORKER_SPIN_POLICY_FIXED = 0,
+  // Each worker learns the distribution of gaps between going idle and
+  // receiving more work and spins long enough to catch most of them (~90%).
+  // Favors wake latency over CPU time and power.
+  IREE_TASK_WORKER_SPIN_POLICY_LATENCY,
+  // Each worker learns the distribution of gaps as with the latency policy but
+  // only spins when the majority of gaps are short enough to catch.
+  // Favors CPU time and power over wake latency.
+  IREE_TASK_WORKER_SPIN_POLICY_EFFICIENCY,
+} iree_task_worker_spin_policy_t;
+
+// Parses a worker spin policy from a string: `fixed`, `latency`, or
+// `efficiency`.
+iree_status_t iree_task_worker_spin_policy_parse(
+    iree_string_view_t value, iree_task_worker_spin_policy_t* out_policy);
+
 // Options controlling task executor behavior.
 typedef struct iree_task_executor_options_t {
   // Specifies the schedule mode used for worker and workload balancing.
@@ -281,13 +301,26 @@ typedef struct iree_task_executor_options_t {
   // TODO(benvanik): add a scope_spin_ns to control wait-idle and other
   // scope-related waits coming from outside of the task system.
 
+  // Policy used by workers to decide how long to spin before parking.
+  iree_task_worker_spin_policy_t worker_spin_policy;
+
   // Maximum duration in nanoseconds each worker should spin waiting for
-  // additional work. In almost all cases this should be IREE_DURATION_ZERO as
-  // spinning is often extremely harmful to system health. Only set to non-zero
-  // values when latency is the #1 priority (over thermals, system-wide
-  // scheduling, and the environment).
+  // additional work. With IREE_TASK_WORKER_SPIN_POLICY_FIXED every wait spins
+  // for exactly this long and in almost all cases this should be
+  // IREE_DURATION_ZERO as spinning is often extremely harmful to system health.
+  // Only set to non-zero values when latency is the #1 priority (over thermals,
+  // system-wide scheduling, and the environment).
+  //
+  // With the adaptive policies this caps the learned spin duration and
+  // IREE_DURATION_ZERO selects IREE_TASK_WORKER_DEFAULT_MAX_ADAPTIVE_SPIN_NS.
   iree_duration_t worker_spin_ns;
 
+  // Upper bound on the percentage of wall time each worker may spend spinning
+  // when using an adaptive spin policy. Once a worker exceeds its budget over
+  // the recent past it parks immediately until the budget recovers. 0 disables
+  // the budget.
+  uint32_t worker_spin_budget_percent;
+
   // Minimum size in bytes of each worker thread stack.
   // The underlying platform may allocate more stack space but _should_
   // guarantee that the available stack space is near this amount. Note that the
@@ -336,6 +369,13 @@ void iree_task_executor_trim(iree_task_executor_t* executor);
 iree_host_size_t iree_task_executor_worker_count(
     iree_task_executor_t* executor);
 
+// Returns the NUMA node all workers of the executor are bound to or
+// IREE_TASK_TOPOLOGY_NODE_ID_ANY if the workers span nodes or placement is
+// unknown. Memory used primarily by work scheduled on the executor should be
+// allocated from this node.
+iree_task_topology_node_id_t iree_task_executor_node_id(
+    iree_task_executor_t* executor);
+
 // Returns an iree_event_t pool managed by the executor.
 // Users of the task system should acquire their transient events from this.
 // Long-lived events should be allocated on their own in order to avoid
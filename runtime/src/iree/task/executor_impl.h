@@ -38,10 +38,18 @@ struct iree_task_executor_t {
   // TODO(benvanik): make mutable; currently always the same reserved value.
   iree_task_scheduling_mode_t scheduling_mode;
 
-  // Time each worker should spin before parking itself to wait for more work.
-  // IREE_DURATION_ZERO is used to disable spinning.
+  // Policy used by each worker to select how long to spin before parking.
+  iree_task_worker_spin_policy_t worker_spin_policy;
+
+  // Time each worker should spin before parking itself to wait for more work
+  // with the fixed policy or the maximum learned spin with adaptive policies.
+  // IREE_DURATION_ZERO is used to disable spinning with the fixed policy.
   iree_duration_t worker_spin_ns;
 
+  // Maximum percentage of wall time a worker may spend spinning with adaptive
+  // policies or 0 if unlimited.
+  uint32_t worker_spin_budget_percent;
+
   // State used by the work-stealing operations performed by donated threads.
   // This is **NOT SYNCHRONIZED** and relies on the fact that we actually don't
   // much care about the precise selection of workers enough to mind any tears
@@ -126,6 +134,9 @@ struct iree_task_executor_t {
   // live join/leave behavior we could change this to a registration mechanism.
   iree_host_size_t worker_count;
   iree_task_worker_t* workers;  // [worker_count]
+
+  // NUMA node shared by all workers or IREE_TASK_TOPOLOGY_NODE_ID_ANY.
+  iree_task_topology_node_id_t node_id;
 };
 
 // Merges a submission into the primary FIFO queues.
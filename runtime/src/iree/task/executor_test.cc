@@ -86,12 +86,9 @@ TEST(ExecutorTest, LifetimeStress) {
   iree_task_topology_deinitialize(&topology);
 }
 
-// Tests heavily serialized submission to an executor.
+// Issues heavily serialized submissions to an executor created with |options|.
 // This puts pressure on the overheads involved in spilling up threads.
-TEST(ExecutorTest, SubmissionStress) {
-  iree_task_executor_options_t options;
-  iree_task_executor_options_initialize(&options);
-  options.worker_local_memory_size = 64 * 1024;
+static void RunSubmissionStress(iree_task_executor_options_t options) {
   iree_task_topology_t topology;
   iree_task_topology_initialize_from_group_count(/*group_count=*/4, &topology);
   iree_task_executor_t* executor = NULL;
@@ -135,4 +132,46 @@ TEST(ExecutorTest, SubmissionStress) {
   iree_task_topology_deinitialize(&topology);
 }
 
+TEST(ExecutorTest, SubmissionStress) {
+  iree_task_executor_options_t options;
+  iree_task_executor_options_initialize(&options);
+  options.worker_local_memory_size = 64 * 1024;
+  RunSubmissionStress(options);
+}
+
+// Tests the adaptive spin policies; the short gaps between serialized
+// submissions should cause workers to learn to spin.
+TEST(ExecutorTest, SubmissionStressLatencySpin) {
+  iree_task_executor_options_t options;
+  iree_task_executor_options_initialize(&options);
+  options.worker_local_memory_size = 64 * 1024;
+  options.worker_spin_policy = IREE_TASK_WORKER_SPIN_POLICY_LATENCY;
+  RunSubmissionStress(options);
+}
+
+TEST(ExecutorTest, SubmissionStressEfficiencySpin) {
+  iree_task_executor_options_t options;
+  iree_task_executor_options_initialize(&options);
+  options.worker_local_memory_size = 64 * 1024;
+  options.worker_spin_policy = IREE_TASK_WORKER_SPIN_POLICY_EFFICIENCY;
+  options.worker_spin_ns = 50 * 1000;
+  options.worker_spin_budget_percent = 10;
+  RunSubmissionStress(options);
+}
+
+TEST(ExecutorTest, ParseSpinPolicy) {
+  iree_task_worker_spin_policy_t policy = IREE_TASK_WORKER_SPIN_POLICY_FIXED;
+  IREE_ASSERT_OK(
+      iree_task_worker_spin_policy_parse(IREE_SV("latency"), &policy));
+  EXPECT_EQ(policy, IREE_TASK_WORKER_SPIN_POLICY_LATENCY);
+  IREE_ASSERT_OK(
+      iree_task_worker_spin_policy_parse(IREE_SV("efficiency"), &policy));
+  EXPECT_EQ(policy, IREE_TASK_WORKER_SPIN_POLICY_EFFICIENCY);
+  IREE_ASSERT_OK(iree_task_worker_spin_policy_parse(IREE_SV("fixed"), &policy));
+  EXPECT_EQ(policy, IREE_TASK_WORKER_SPIN_POLICY_FIXED);
+  IREE_EXPECT_STATUS_IS(
+      IREE_STATUS_INVALID_ARGUMENT,
+      iree_task_worker_spin_policy_parse(IREE_SV("fastest"), &policy));
+}
+
 }  // namespace
@@ -9,83 +9,315 @@
 #include <stddef.h>
 #include <string.h>
 
+//===----------------------------------------------------------------------===//
+// iree_task_inbox_t
+//===----------------------------------------------------------------------===//
+
+void iree_task_inbox_initialize(iree_task_inbox_t* out_inbox) {
+  iree_atomic_store(&out_inbox->head, 0, iree_memory_order_relaxed);
+}
+
+void iree_task_inbox_deinitialize(iree_task_inbox_t* inbox) {
+  IREE_ASSERT(iree_task_inbox_is_empty(inbox));
+}
+
+void iree_task_inbox_discard(iree_task_inbox_t* inbox) {
+  iree_task_list_t list;
+  iree_task_list_initialize(&list);
+  if (iree_task_inbox_flush(inbox, &list)) {
+    iree_task_list_discard(&list);
+  }
+}
+
+bool iree_task_inbox_is_empty(iree_task_inbox_t* inbox) {
+  return iree_atomic_load(&inbox->head, iree_memory_order_relaxed) == 0;
+}
+
+void iree_task_inbox_post(iree_task_inbox_t* inbox, iree_task_list_t* list) {
+  if (iree_task_list_is_empty(list)) return;
+  iree_task_t* head = list->head;
+  iree_task_t* tail = list->tail;
+  iree_task_list_initialize(list);
+
+  // Standard Treiber push of the whole chain: link the tail to the current head
+  // and swing the head to our chain. Release ordering publishes the task
+  // contents to whoever flushes them.
+  intptr_t expected = iree_atomic_load(&inbox->head, iree_memory_order_relaxed);
+  do {
+    tail->next_task = (iree_task_t*)expected;
+  } while (!iree_atomic_compare_exchange_weak(
+      &inbox->head, &expected, (intptr_t)head, iree_memory_order_release,
+      iree_memory_order_relaxed));
+}
+
+bool iree_task_inbox_flush(iree_task_inbox_t* inbox,
+                           iree_task_list_t* out_list) {
+  // Avoid dirtying the cache line when there's nothing to take.
+  if (iree_atomic_load(&inbox->head, iree_memory_order_relaxed) == 0) {
+    return false;
+  }
+  iree_task_t* head = (iree_task_t*)iree_atomic_exchange(
+      &inbox->head, 0, iree_memory_order_acquire);
+  if (!head) return false;
+
+  // Reverse the LIFO chain into FIFO order.
+  iree_task_list_t list;
+  list.tail = head;
+  iree_task_t* prev = NULL;
+  for (iree_task_t* task = head; task != NULL;) {
+    iree_task_t* next = task->next_task;
+    task->next_task = prev;
+    prev = task;
+    task = next;
+  }
+  list.head = prev;
+  iree_task_list_append(out_list, &list);
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// iree_task_queue_t
+//===----------------------------------------------------------------------===//
+
+#define IREE_TASK_QUEUE_MASK ((int64_t)IREE_TASK_QUEUE_CAPACITY - 1)
+
+static inline void iree_task_queue_store_slot(iree_task_queue_t* queue,
+                                              int64_t index,
+                                              iree_task_t* task) {
+  iree_atomic_store(&queue->tasks[index & IREE_TASK_QUEUE_MASK],
+                    (intptr_t)task, iree_memory_order_relaxed);
+}
+
+static inline iree_task_t* iree_task_queue_load_slot(iree_task_queue_t* queue,
+                                                     int64_t index) {
+  return (iree_task_t*)iree_atomic_load(
+      &queue->tasks[index & IREE_TASK_QUEUE_MASK], iree_memory_order_relaxed);
+}
+
+// Pops the task at the bottom of the ring, racing with thieves only when it is
+// the last one. Owner only.
+static iree_task_t* iree_task_queue_take(iree_task_queue_t* queue) {
+  const int64_t bottom =
+      iree_atomic_load(&queue->bottom, iree_memory_order_relaxed) - 1;
+  // NOTE: the store of |bottom| must be ordered before the load of |top| so
+  // that either we or a concurrent thief observe the other's claim.
+  iree_atomic_store(&queue->bottom, bottom, iree_memory_order_seq_cst);
+  int64_t top = iree_atomic_load(&queue->top, iree_memory_order_seq_cst);
+  if (top > bottom) {
+    // Empty; restore the bottom.
+    iree_atomic_store(&queue->bottom, bottom + 1, iree_memory_order_relaxed);
+    return NULL;
+  }
+  iree_task_t* task = iree_task_queue_load_slot(queue, bottom);
+  if (top == bottom) {
+    // Last task; race thieves for it by claiming it from the top.
+    if (!iree_atomic_compare_exchange_strong(&queue->top, &top, top + 1,
+                                             iree_memory_order_seq_cst,
+                                             iree_memory_order_relaxed)) {
+      task = NULL;  // lost the race
+    }
+    iree_atomic_store(&queue->bottom, bottom + 1, iree_memory_order_relaxed);
+  }
+  return task;
+}
+
+// Steals the task at the top of the ring. Returns NULL if the ring is empty or
+// the race for the task was lost.
+static iree_task_t* iree_task_queue_steal(iree_task_queue_t* queue) {
+  int64_t top = iree_atomic_load(&queue->top, iree_memory_order_seq_cst);
+  const int64_t bottom =
+      iree_atomic_load(&queue->bottom, iree_memory_order_seq_cst);
+  if (top >= bottom) return NULL;
+  // NOTE: the slot may be overwritten by the owner once |top| has moved on;
+  // in that case our CAS will fail and the value is discarded.
+  iree_task_t* task = iree_task_queue_load_slot(queue, top);
+  if (!iree_atomic_compare_exchange_strong(&queue->top, &top, top + 1,
+                                           iree_memory_order_seq_cst,
+                                           iree_memory_order_relaxed)) {
+    return NULL;
+  }
+  return task;
+}
+
+// Moves all tasks in the ring to the front of the overflow list so that the
+// ring can accept a push without reordering. Owner only and only expected when
+// the ring is full.
+static void iree_task_queue_spill(iree_task_queue_t* queue) {
+  iree_task_list_t list;
+  iree_task_list_initialize(&list);
+  // NOTE: take only fails when the ring is empty (including when a thief won
+  // the race for the last task).
+  iree_task_t* task = NULL;
+  while ((task = iree_task_queue_take(queue)) != NULL) {
+    iree_task_list_push_back(&list, task);
+  }
+  iree_task_list_prepend(&queue->overflow, &list);
+}
+
+// Moves tasks from the front of the overflow list into the ring such that the
+// first task in the list will be the next to be popped. Owner only and the
+// ring must be empty as the tasks are placed below any existing ones.
+static void iree_task_queue_refill(iree_task_queue_t* queue) {
+  const int64_t bottom =
+      iree_atomic_load(&queue->bottom, iree_memory_order_relaxed);
+  const int64_t capacity = IREE_TASK_QUEUE_CAPACITY;
+
+  // Write the tasks in FIFO order above the current bottom. No thief can read
+  // these slots until the new bottom is published below.
+  int64_t count = 0;
+  while (count < capacity && !iree_task_list_is_empty(&queue->overflow)) {
+    iree_task_queue_store_slot(queue, bottom + count,
+                               iree_task_list_pop_front(&queue->overflow));
+    ++count;
+  }
+  if (!count) return;
+
+  // Reverse the slots so that the first task is at the bottom.
+  for (int64_t i = 0, j = count - 1; i < j; ++i, --j) {
+    iree_task_t* task_i = iree_task_queue_load_slot(queue, bottom + i);
+    iree_task_t* task_j = iree_task_queue_load_slot(queue, bottom + j);
+    iree_task_queue_store_slot(queue, bottom + i, task_j);
+    iree_task_queue_store_slot(queue, bottom + j, task_i);
+  }
+
+  iree_atomic_store(&queue->bottom, bottom + count, iree_memory_order_release);
+}
+
 void iree_task_queue_initialize(iree_task_queue_t* out_queue) {
   memset(out_queue, 0, sizeof(*out_queue));
-  iree_slim_mutex_initialize(&out_queue->mutex);
-  iree_task_list_initialize(&out_queue->list);
+  iree_atomic_store(&out_queue->bottom, 0, iree_memory_order_relaxed);
+  iree_atomic_store(&out_queue->top, 0, iree_memory_order_relaxed);
+  iree_task_list_initialize(&out_queue->overflow);
 }
 
 void iree_task_queue_deinitialize(iree_task_queue_t* queue) {
-  iree_task_list_discard(&queue->list);
-  iree_slim_mutex_deinitialize(&queue->mutex);
+  iree_task_list_t list;
+  iree_task_list_initialize(&list);
+  const int64_t top = iree_atomic_load(&queue->top, iree_memory_order_acquire);
+  const int64_t bottom =
+      iree_atomic_load(&queue->bottom, iree_memory_order_acquire);
+  for (int64_t i = top; i < bottom; ++i) {
+    iree_task_list_push_back(&list, iree_task_queue_load_slot(queue, i));
+  }
+  iree_task_list_append(&list, &queue->overflow);
+  iree_task_list_discard(&list);
+  iree_atomic_store(&queue->top, bottom, iree_memory_order_relaxed);
 }
 
 bool iree_task_queue_is_empty(iree_task_queue_t* queue) {
-  iree_slim_mutex_lock(&queue->mutex);
-  bool is_empty = iree_task_list_is_empty(&queue->list);
-  iree_slim_mutex_unlock(&queue->mutex);
-  return is_empty;
+  const int64_t bottom =
+      iree_atomic_load(&queue->bottom, iree_memory_order_relaxed);
+  const int64_t top = iree_atomic_load(&queue->top, iree_memory_order_acquire);
+  return top >= bottom && iree_task_list_is_empty(&queue->overflow);
 }
 
 void iree_task_queue_push_front(iree_task_queue_t* queue, iree_task_t* task) {
-  iree_slim_mutex_lock(&queue->mutex);
-  iree_task_list_push_front(&queue->list, task);
-  iree_slim_mutex_unlock(&queue->mutex);
+  int64_t bottom = iree_atomic_load(&queue->bottom, iree_memory_order_relaxed);
+  const int64_t top = iree_atomic_load(&queue->top, iree_memory_order_acquire);
+  if (bottom - top >= IREE_TASK_QUEUE_CAPACITY) {
+    iree_task_queue_spill(queue);
+    bottom = iree_atomic_load(&queue->bottom, iree_memory_order_relaxed);
+  }
+  iree_task_queue_store_slot(queue, bottom, task);
+  iree_atomic_store(&queue->bottom, bottom + 1, iree_memory_order_release);
 }
 
 void iree_task_queue_append_from_lifo_list_unsafe(iree_task_queue_t* queue,
                                                   iree_task_list_t* list) {
-  // NOTE: reversing the list outside of the lock.
   iree_task_list_reverse(list);
-  iree_slim_mutex_lock(&queue->mutex);
-  iree_task_list_append(&queue->list, list);
-  iree_slim_mutex_unlock(&queue->mutex);
+  iree_task_list_append(&queue->overflow, list);
+  if (iree_atomic_load(&queue->bottom, iree_memory_order_relaxed) <=
+      iree_atomic_load(&queue->top, iree_memory_order_acquire)) {
+    iree_task_queue_refill(queue);
+  }
 }
 
 iree_task_t* iree_task_queue_flush_from_lifo_slist(
     iree_task_queue_t* queue, iree_atomic_task_slist_t* source_slist) {
-  // Perform the flush and swap outside of the lock; acquiring the list is
-  // atomic and then we own it exclusively.
   iree_task_list_t suffix;
   iree_task_list_initialize(&suffix);
-  const bool did_flush = iree_atomic_task_slist_flush(
-      source_slist, IREE_ATOMIC_SLIST_FLUSH_ORDER_APPROXIMATE_FIFO,
-      &suffix.head, &suffix.tail);
-
-  // Append the tasks and pop off the front for return.
-  iree_slim_mutex_lock(&queue->mutex);
-  if (did_flush) iree_task_list_append(&queue->list, &suffix);
-  iree_task_t* next_task = iree_task_list_pop_front(&queue->list);
-  iree_slim_mutex_unlock(&queue->mutex);
+  if (iree_atomic_task_slist_flush(
+          source_slist, IREE_ATOMIC_SLIST_FLUSH_ORDER_APPROXIMATE_FIFO,
+          &suffix.head, &suffix.tail)) {
+    iree_task_list_append(&queue->overflow, &suffix);
+  }
+  return iree_task_queue_pop_front(queue);
+}
 
-  return next_task;
+iree_task_t* iree_task_queue_flush_from_inbox(iree_task_queue_t* queue,
+                                              iree_task_inbox_t* inbox) {
+  iree_task_inbox_flush(inbox, &queue->overflow);
+  return iree_task_queue_pop_front(queue);
 }
 
 iree_task_t* iree_task_queue_pop_front(iree_task_queue_t* queue) {
-  iree_slim_mutex_lock(&queue->mutex);
-  iree_task_t* next_task = iree_task_list_pop_front(&queue->list);
-  iree_slim_mutex_unlock(&queue->mutex);
-  return next_task;
+  iree_task_t* task = iree_task_queue_take(queue);
+  if (task || iree_task_list_is_empty(&queue->overflow)) return task;
+
+  // The ring has drained (or a thief took the last task); the next task is the
+  // head of the overflow list and the remainder moves into the ring where
+  // thieves can see it.
+  task = iree_task_list_pop_front(&queue->overflow);
+  iree_task_queue_refill(queue);
+  return task;
 }
 
 iree_task_t* iree_task_queue_try_steal(iree_task_queue_t* source_queue,
                                        iree_task_queue_t* target_queue,
                                        iree_host_size_t max_tasks) {
-  // First attempt to steal up to max_tasks from the source queue.
+  // Take at most half of the visible tasks (rounding up so that a lone task
+  // can always be stolen - the victim is likely working on its last item and
+  // we can help it out by taking this one).
+  const int64_t top =
+      iree_atomic_load(&source_queue->top, iree_memory_order_acquire);
+  const int64_t bottom =
+      iree_atomic_load(&source_queue->bottom, iree_memory_order_acquire);
+  if (top >= bottom) return NULL;
+  iree_host_size_t steal_count =
+      iree_min(max_tasks, (iree_host_size_t)((bottom - top + 1) / 2));
+
+  // Each task is claimed individually from the top; the ring only supports
+  // single-task claims as the owner may concurrently pop from the bottom.
+  // Tasks come off the top in reverse FIFO order so we prepend them.
   iree_task_list_t stolen_tasks;
   iree_task_list_initialize(&stolen_tasks);
-  if (iree_slim_mutex_try_lock(&source_queue->mutex)) {
-    iree_task_list_split(&source_queue->list, max_tasks, &stolen_tasks);
-    iree_slim_mutex_unlock(&source_queue->mutex);
+  for (iree_host_size_t i = 0; i < steal_count; ++i) {
+    iree_task_t* task = iree_task_queue_steal(source_queue);
+    if (!task) break;
+    iree_task_list_push_front(&stolen_tasks, task);
   }
+  if (iree_task_list_is_empty(&stolen_tasks)) return NULL;
 
-  // Add any stolen tasks to the target queue and pop off the head for return.
-  iree_task_t* next_task = NULL;
-  if (!iree_task_list_is_empty(&stolen_tasks)) {
-    iree_slim_mutex_lock(&target_queue->mutex);
-    iree_task_list_append(&target_queue->list, &stolen_tasks);
-    next_task = iree_task_list_pop_front(&target_queue->list);
-    iree_slim_mutex_unlock(&target_queue->mutex);
+  // Add the stolen tasks to the target queue and pop off the head for return.
+  iree_task_list_append(&target_queue->overflow, &stolen_tasks);
+  return iree_task_queue_pop_front(target_queue);
+}
+
+iree_task_t* iree_task_queue_try_steal_from_inbox(
+    iree_task_inbox_t* source_inbox, iree_task_queue_t* target_queue,
+    iree_host_size_t max_tasks) {
+  // Inboxes can only be taken whole so we take everything and post back what
+  // is over the quota.
+  iree_task_list_t remaining_tasks;
+  iree_task_list_initialize(&remaining_tasks);
+  if (!iree_task_inbox_flush(source_inbox, &remaining_tasks)) return NULL;
+  iree_task_list_t stolen_tasks;
+  iree_task_list_initialize(&stolen_tasks);
+  for (iree_host_size_t i = 0;
+       i < max_tasks && !iree_task_list_is_empty(&remaining_tasks); ++i) {
+    iree_task_list_push_back(&stolen_tasks,
+                             iree_task_list_pop_front(&remaining_tasks));
   }
-  return next_task;
+
+  // Posts are LIFO and flushed in reverse so the remainder is reversed to keep
+  // it in FIFO order for the owner.
+  if (!iree_task_list_is_empty(&remaining_tasks)) {
+    iree_task_list_reverse(&remaining_tasks);
+    iree_task_inbox_post(source_inbox, &remaining_tasks);
+  }
+  if (iree_task_list_is_empty(&stolen_tasks)) return NULL;
+
+  // Add the stolen tasks to the target queue and pop off the head for return.
+  iree_task_list_append(&target_queue->overflow, &stolen_tasks);
+  return iree_task_queue_pop_front(target_queue);
 }
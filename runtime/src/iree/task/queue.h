@@ -10,7 +10,7 @@
 #include <stdbool.h>
 
 #include "iree/base/api.h"
-#include "iree/base/internal/synchronization.h"
+#include "iree/base/internal/atomics.h"
 #include "iree/task/list.h"
 #include "iree/task/task.h"
 
@@ -18,68 +18,99 @@
 extern "C" {
 #endif  // __cplusplus
 
-// A simple work-stealing LIFO queue modeled on a Chase-Lev concurrent deque.
+//===----------------------------------------------------------------------===//
+// iree_task_inbox_t
+//===----------------------------------------------------------------------===//
+
+// A lock-free multi-producer single-consumer inbox of tasks.
+// Coordinators post batches of tasks to a worker by pushing them onto the
+// inbox and the worker (or a thief acting on its behalf) takes the entire
+// contents in one atomic exchange. Because consumers only ever take everything
+// there is no ABA hazard and posting is a single CAS on the head pointer
+// regardless of how many tasks are in the batch.
+//
+// Tasks are stored in LIFO order (most recently posted at the head) and
+// flushing reverses them back into FIFO order.
+typedef struct iree_task_inbox_t {
+  // Head of the intrusive LIFO list of posted tasks (iree_task_t*).
+  iree_atomic_intptr_t head;
+} iree_task_inbox_t;
+
+// Initializes an empty inbox in-place.
+void iree_task_inbox_initialize(iree_task_inbox_t* out_inbox);
+
+// Deinitializes an inbox. It must be empty.
+void iree_task_inbox_deinitialize(iree_task_inbox_t* inbox);
+
+// Discards all tasks currently in the inbox.
+void iree_task_inbox_discard(iree_task_inbox_t* inbox);
+
+// Returns true if the inbox is empty.
+// Note that due to races this may return both false-positives and -negatives.
+bool iree_task_inbox_is_empty(iree_task_inbox_t* inbox);
+
+// Posts a LIFO |list| of tasks to the inbox. |list| will be reset.
+// The list order is preserved such that the list head is the first task
+// returned by a LIFO walk of the inbox.
+//
+// Thread-safe; may be called from any thread concurrently with other posts and
+// flushes.
+void iree_task_inbox_post(iree_task_inbox_t* inbox, iree_task_list_t* list);
+
+// Takes all tasks from the inbox and appends them to |out_list| in FIFO order.
+// Returns true if any tasks were taken.
+//
+// Thread-safe; any number of threads may flush concurrently and each posted
+// task will be returned by exactly one of them.
+bool iree_task_inbox_flush(iree_task_inbox_t* inbox,
+                           iree_task_list_t* out_list);
+
+//===----------------------------------------------------------------------===//
+// iree_task_queue_t
+//===----------------------------------------------------------------------===//
+
+// Capacity of the lock-free ring in each queue. Must be a power of two.
+// Tasks beyond this are held in an owner-only overflow list that refills the
+// ring as it drains so the queue as a whole remains unbounded. Larger values
+// allow thieves to see more of the pending work at the cost of
+// sizeof(void*) * capacity bytes per worker.
+#if !defined(IREE_TASK_QUEUE_CAPACITY)
+#define IREE_TASK_QUEUE_CAPACITY 256
+#endif  // !IREE_TASK_QUEUE_CAPACITY
+static_assert((IREE_TASK_QUEUE_CAPACITY & (IREE_TASK_QUEUE_CAPACITY - 1)) == 0,
+              "queue capacity must be a power of two");
+
+// A work-stealing queue implemented as a Chase-Lev concurrent deque.
 // This is used by workers to maintain their thread-local working lists. The
 // workers keep the tasks they will process in FIFO order. They allow it to
-// empty and then refresh it with more tasks from the incoming worker mailbox.
+// empty and then refresh it with more tasks from the incoming worker inbox.
 // The performance bias here is to the workers as they are >90% of the
-// accesses and the only other accesses are thieves that hopefully we can just
-// improve our distribution to vs. introducing a slowdown here.
-//
-// A futex is used to synchronize access; because the common case is that of
-// only the worker that owns the queue touching it for pushing and popping items
-// this puts us into the sweet-spot of uncontended lightweight exclusive locks.
-// Since futices are effectively just single machine words managed with atomic
-// ops we can avoid a lot of the traditional atomic tomfoolery one finds in
-// systems like these that originated prior to the introduction of futices while
-// also keeping the tiny overhead of the pure atomic solutions.
-//
-// We can also take advantage of the futex providing an actual exclusive region
-// such that our data structure can be whatever we want as opposed to needing to
-// be something that someone had figured out how to make atomic. For example,
-// common implementations of work-stealing queues are all bounded as unbounded
-// atomic deques are an unsolved problem in CS.
+// accesses: pushing and popping by the owner is a handful of uncontended
+// atomic operations and only popping the very last task races with thieves.
 //
 // Very rarely when another worker runs out of work it'll try to steal tasks
 // from nearby workers and use this queue type to do it: the assumption is that
 // it's better to take the last task the victim worker will get to so that in a
 // long list of tasks it remains chugging through the head of the list with good
-// cache locality. If we end up with a lot of theft, though, it's possible for
-// the cache benefits of the pop_back approach to the worker to outweigh the
-// cache pessimism for all thieves. Let's hope we can schedule deterministic-
-// enough tiles such that theft is rare!
-//
-// Our queue variant here is tuned for the use case we have: we exclusively
-// push in multiple tasks at a time (flushed from the mailbox) and exclusively
-// pop a single task a time (what to work on next). The stealing part is batched
-// so that when a remote worker has to perform a theft it takes a good chunk of
-// tasks in one go (hopefully roughly half) to reduce the total overhead when
-// there is high imbalance in workloads.
-//
-// Flushing from the mailbox slist (LIFO) to our list (FIFO) requires a full
-// walk of the incoming task linked list. This is generally fine as the number
-// of tasks in any given flush is low(ish) and by walking in reverse order to
-// then process forward the cache should be hot as the worker starts making its
-// way back through the tasks. As we walk forward we'll be using the task fields
-// for execution and retiring of tasks (notifing dependencies/etc) and the
-// intrusive next pointer sitting next to those should be in-cache when we need
-// to access it. This, combined with slab allocation of tasks in command buffers
-// to begin with gives us the (probabilistically) same characteristics of a flat
-// array walked with an index as is common in other work queues but with the
-// flexibility to reorder tasks as we see fit (theft, redistribution/rotation,
-// reprioritization, etc).
-//
-// Similar concepts, though implemented with atomics:
-//   "Dynamic Circular Work-Stealing Deque":
-//   http://citeseerx.ist.psu.edu/viewdoc/download?doi=10.1.1.170.1097&rep=rep1&type=pdf
-//   "Correct and Efficient Work-Stealing for Weak Memory Models":
-//   https://fzn.fr/readings/ppopp13.pdf
-//   Motivating article:
-//   https://blog.molecular-matters.com/2015/08/24/job-system-2-0-lock-free-work-stealing-part-1-basics/
+// cache locality. Each stolen task costs the thief one CAS on |top| and thieves
+// never block the owner or each other.
+//
+// The classic deque has the owner push and pop LIFO at the bottom. To give the
+// owner FIFO order we load batches of tasks into the ring reversed: the first
+// task to execute is written at the bottom and the last nearest the top. Owner
+// pops from the bottom thus walk the batch forward while thieves take from the
+// top - the tail of the logical FIFO. A single pushed task (such as a yielded
+// task being reprocessed) lands at the bottom and runs next.
+//
+// Atomic deques are bounded (unbounded atomic deques require memory
+// reclamation schemes that we don't want on this path) so the queue pairs the
+// ring with an owner-only FIFO overflow list. The logical queue order is
+// [ring bottom -> ring top] followed by [overflow head -> overflow tail]. New
+// batches are appended to the overflow list and moved into the ring once it
+// has drained; the owner flushes its inbox only when the ring is empty anyway
+// so in practice batches move into the ring immediately.
 //
 // Useful diagram from https://github.com/injinj/WSQ
-// Much of this implementation is inspired from that; though significant
-// reworking was required for our FIFO->LIFO->FIFO sandwich.
 //  +--------+ <- tasks[0]
 //  |  top   | <- stealers consume here: task = tasks[top++]
 //  |        |
@@ -91,23 +122,26 @@ extern "C" {
 //  |        |
 //  +--------+ <- tasks[IREE_TASK_QUEUE_CAPACITY-1]
 //
-// Unlike that implementation, though, our task list is unbounded because we use
-// a linked list. To keep our options open, though, I've left the API of this
-// implementation compatible with classic atomic work-stealing queues. I'm
-// hopeful this will not need to be revisted for awhile, though!
-//
-// Future improvement idea: have the owner of the queue maintain a theft point
-// skip list that makes it possible for thieves to quickly come in and slice
-// off batches of tasks at the tail of the queue. Since we are a singly-linked
-// list we can't easily just walk backward and we don't want to be introducing
-// cache line contention as thieves start touching the same tasks as the worker
-// is while processing.
+// References:
+//   "Dynamic Circular Work-Stealing Deque":
+//   http://citeseerx.ist.psu.edu/viewdoc/download?doi=10.1.1.170.1097&rep=rep1&type=pdf
+//   "Correct and Efficient Work-Stealing for Weak Memory Models":
+//   https://fzn.fr/readings/ppopp13.pdf
+//   Motivating article:
+//   https://blog.molecular-matters.com/2015/08/24/job-system-2-0-lock-free-work-stealing-part-1-basics/
 typedef struct iree_task_queue_t {
-  // Must be held when manipulating the queue. >90% accesses are by the owner.
-  iree_slim_mutex_t mutex;
+  // Index one past the next task the owner will pop. Only written by the owner.
+  iree_atomic_int64_t bottom;
+
+  // Owner-only FIFO of tasks that logically follow those in the ring.
+  iree_task_list_t overflow;
 
-  // FIFO task list.
-  iree_task_list_t list IREE_GUARDED_BY(mutex);
+  // Ring of iree_task_t* indexed by [top, bottom) modulo the capacity.
+  iree_atomic_intptr_t tasks[IREE_TASK_QUEUE_CAPACITY];
+
+  // Index of the next task a thief will steal. Only ever incremented.
+  // LAYOUT: placed after the ring to keep it off the cache line of |bottom|.
+  iree_atomic_int64_t top;
 } iree_task_queue_t;
 
 // Initializes a work-stealing task queue in-place.
@@ -118,7 +152,9 @@ void iree_task_queue_initialize(iree_task_queue_t* out_queue);
 void iree_task_queue_deinitialize(iree_task_queue_t* queue);
 
 // Returns true if the queue is empty.
-// Note that due to races this may return both false-positives and -negatives.
+// Note that due to races with thieves this may return false-negatives.
+//
+// Must only be called from the owning worker's thread.
 bool iree_task_queue_is_empty(iree_task_queue_t* queue);
 
 // Pushes a task to the front of the queue.
@@ -143,6 +179,14 @@ void iree_task_queue_append_from_lifo_list_unsafe(iree_task_queue_t* queue,
 iree_task_t* iree_task_queue_flush_from_lifo_slist(
     iree_task_queue_t* queue, iree_atomic_task_slist_t* source_slist);
 
+// Flushes the |inbox| into the task queue in FIFO order.
+// Returns the first task in the queue upon success; the task may be
+// pre-existing or from the newly flushed tasks.
+//
+// Must only be called from the owning worker's thread.
+iree_task_t* iree_task_queue_flush_from_inbox(iree_task_queue_t* queue,
+                                              iree_task_inbox_t* inbox);
+
 // Pops a task from the front of the queue if any are available.
 //
 // Must only be called from the owning worker's thread.
@@ -150,9 +194,9 @@ iree_task_t* iree_task_queue_pop_front(iree_task_queue_t* queue);
 
 // Tries to steal up to |max_tasks| from the back of the queue.
 //
-// On success, up to |max_tasks| tasks that were at the tail of the
-// |source_queue| will be moved to the |target_queue| and the first of the
-// stolen tasks is returned.
+// On success, up to |max_tasks| tasks (and at most half of those visible) that
+// were at the tail of the |source_queue| will be moved to the |target_queue|
+// and the first of the stolen tasks is returned.
 //
 // On failure, NULL is returned.
 //
@@ -160,11 +204,25 @@ iree_task_t* iree_task_queue_pop_front(iree_task_queue_t* queue);
 // tasks to steal.
 //
 // It's expected this is not called from the queue's owning worker, though it's
-// valid to do so.
+// valid to do so. Must only be called from the |target_queue| owning worker's
+// thread.
 iree_task_t* iree_task_queue_try_steal(iree_task_queue_t* source_queue,
                                        iree_task_queue_t* target_queue,
                                        iree_host_size_t max_tasks);
 
+// Tries to steal up to |max_tasks| from the |source_inbox| of another worker.
+//
+// On success, up to |max_tasks| of the oldest tasks posted to the inbox will be
+// moved to the |target_queue| and the first of the stolen tasks is returned.
+// Any tasks over the quota are posted back to the |source_inbox| for its owner.
+//
+// On failure, NULL is returned.
+//
+// Must only be called from the |target_queue| owning worker's thread.
+iree_task_t* iree_task_queue_try_steal_from_inbox(
+    iree_task_inbox_t* source_inbox, iree_task_queue_t* target_queue,
+    iree_host_size_t max_tasks);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -0,0 +1,155 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <cstddef>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "iree/task/queue.h"
+
+namespace {
+
+//==============================================================================
+// Inlined timing utils
+//==============================================================================
+
+void SpinDelay(int count, int* data) {
+  // This emulates the work done executing a task.
+  for (int i = 0; i < count * 10; ++i) {
+    ++(*data);
+    benchmark::DoNotOptimize(*data);
+  }
+}
+
+//==============================================================================
+// Uncontended owner access
+//==============================================================================
+
+// Measures the owner-only path of flushing a batch of tasks into the queue and
+// popping them back off. This is what workers do >90% of the time.
+void BM_OwnerAppendPop(benchmark::State& state) {
+  const int batch_size = static_cast<int>(state.range(0));
+  std::vector<iree_task_t> tasks(batch_size);
+  iree_task_queue_t queue;
+  iree_task_queue_initialize(&queue);
+  for (auto _ : state) {
+    iree_task_list_t list = {0};
+    for (auto& task : tasks) iree_task_list_push_front(&list, &task);
+    iree_task_queue_append_from_lifo_list_unsafe(&queue, &list);
+    while (iree_task_t* task = iree_task_queue_pop_front(&queue)) {
+      benchmark::DoNotOptimize(task);
+    }
+  }
+  iree_task_queue_deinitialize(&queue);
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+BENCHMARK(BM_OwnerAppendPop)->Arg(1)->Arg(16)->Arg(256)->Arg(4096);
+
+// Measures posting single tasks to an inbox from multiple threads while others
+// concurrently flush it.
+void BM_InboxContended(benchmark::State& state) {
+  static constexpr int kTaskCount = 1024;
+  struct Shared {
+    iree_task_inbox_t inbox;
+    std::vector<iree_task_t> tasks;
+    Shared() : tasks(kTaskCount) {
+      iree_task_inbox_initialize(&inbox);
+      iree_task_list_t list = {0};
+      for (auto& task : tasks) iree_task_list_push_front(&list, &task);
+      iree_task_inbox_post(&inbox, &list);
+    }
+  };
+  static auto* shared = new Shared();
+
+  // Tasks circulate: each thread takes whatever is in the inbox when it has
+  // nothing left locally and posts its tasks back one at a time.
+  iree_task_list_t local_list = {0};
+  for (auto _ : state) {
+    if (iree_task_list_is_empty(&local_list)) {
+      iree_task_inbox_flush(&shared->inbox, &local_list);
+    }
+    if (iree_task_t* task = iree_task_list_pop_front(&local_list)) {
+      iree_task_list_t list = {0};
+      iree_task_list_push_front(&list, task);
+      iree_task_inbox_post(&shared->inbox, &list);
+    }
+  }
+  // Return anything still held so the next run starts with all tasks posted.
+  iree_task_inbox_post(&shared->inbox, &local_list);
+}
+BENCHMARK(BM_InboxContended)
+    ->UseRealTime()
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(8);
+
+//==============================================================================
+// Owner vs. thieves
+//==============================================================================
+
+// Models a worker chewing through its queue while other workers that have run
+// out of work steal from it. Thread 0 is the owner and all others are thieves.
+// Tasks circulate through an inbox: whoever executes a task posts it back to
+// the owner which flushes its inbox once its queue has emptied, just as
+// iree_task_worker_t does with its mailbox.
+void BM_OwnerVsThieves(benchmark::State& state) {
+  static constexpr int kTaskCount = 4096;
+  struct Shared {
+    iree_task_queue_t queue;
+    iree_task_inbox_t inbox;
+    std::vector<iree_task_t> tasks;
+    Shared() : tasks(kTaskCount) {
+      iree_task_queue_initialize(&queue);
+      iree_task_inbox_initialize(&inbox);
+      iree_task_list_t list = {0};
+      for (auto& task : tasks) iree_task_list_push_front(&list, &task);
+      iree_task_inbox_post(&inbox, &list);
+    }
+  };
+  static auto* shared = new Shared();
+  const int max_theft_count = static_cast<int>(state.range(0));
+
+  iree_task_queue_t local_queue;
+  iree_task_queue_initialize(&local_queue);
+  int local = 0;
+  int64_t executed_count = 0;
+  auto execute = [&](iree_task_t* task) {
+    SpinDelay(10, &local);
+    iree_task_list_t list = {0};
+    iree_task_list_push_front(&list, task);
+    iree_task_inbox_post(&shared->inbox, &list);
+    ++executed_count;
+  };
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      iree_task_t* task = iree_task_queue_pop_front(&shared->queue);
+      if (!task) {
+        task = iree_task_queue_flush_from_inbox(&shared->queue, &shared->inbox);
+      }
+      if (task) execute(task);
+    } else {
+      iree_task_t* task = iree_task_queue_try_steal(
+          &shared->queue, &local_queue, max_theft_count);
+      while (task) {
+        execute(task);
+        task = iree_task_queue_pop_front(&local_queue);
+      }
+    }
+  }
+  iree_task_queue_deinitialize(&local_queue);
+  state.SetItemsProcessed(executed_count);
+}
+BENCHMARK(BM_OwnerVsThieves)
+    ->UseRealTime()
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(8)
+    ->Arg(1)
+    ->Arg(64);
+
+}  // namespace
@@ -6,6 +6,10 @@
 
 #include "iree/task/queue.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "iree/base/internal/threading.h"
 #include "iree/testing/gtest.h"
 
@@ -336,4 +340,301 @@ TEST(QueueTest, TryStealAll) {
   iree_task_queue_deinitialize(&target_queue);
 }
 
+TEST(QueueTest, OverflowOrdered) {
+  iree_task_queue_t queue;
+  iree_task_queue_initialize(&queue);
+
+  // Append more tasks than the ring can hold; the excess stays in the overflow
+  // list and must still come out in FIFO order.
+  static constexpr int kTaskCount = IREE_TASK_QUEUE_CAPACITY * 3 + 7;
+  std::vector<iree_task_t> tasks(kTaskCount);
+  iree_task_list_t list = {0};
+  for (auto& task : tasks) iree_task_list_push_front(&list, &task);
+  iree_task_queue_append_from_lifo_list_unsafe(&queue, &list);
+
+  for (int i = 0; i < kTaskCount; ++i) {
+    ASSERT_EQ(&tasks[i], iree_task_queue_pop_front(&queue));
+  }
+  EXPECT_TRUE(iree_task_queue_is_empty(&queue));
+
+  iree_task_queue_deinitialize(&queue);
+}
+
+TEST(QueueTest, PushFrontFull) {
+  iree_task_queue_t queue;
+  iree_task_queue_initialize(&queue);
+
+  // Fill the ring exactly and then push to the front; the pushed task must run
+  // first even though the ring has to spill to make room.
+  std::vector<iree_task_t> tasks(IREE_TASK_QUEUE_CAPACITY + 1);
+  iree_task_list_t list = {0};
+  for (int i = 1; i < (int)tasks.size(); ++i) {
+    iree_task_list_push_front(&list, &tasks[i]);
+  }
+  iree_task_queue_append_from_lifo_list_unsafe(&queue, &list);
+  iree_task_queue_push_front(&queue, &tasks[0]);
+
+  for (auto& task : tasks) {
+    ASSERT_EQ(&task, iree_task_queue_pop_front(&queue));
+  }
+  EXPECT_TRUE(iree_task_queue_is_empty(&queue));
+
+  iree_task_queue_deinitialize(&queue);
+}
+
+TEST(QueueTest, FlushInboxOrdered) {
+  iree_task_queue_t queue;
+  iree_task_queue_initialize(&queue);
+  iree_task_inbox_t inbox;
+  iree_task_inbox_initialize(&inbox);
+
+  // Post two LIFO batches: b<-a then c.
+  iree_task_t task_a = {0};
+  iree_task_t task_b = {0};
+  iree_task_t task_c = {0};
+  iree_task_list_t list = {0};
+  iree_task_list_push_front(&list, &task_a);
+  iree_task_list_push_front(&list, &task_b);
+  iree_task_inbox_post(&inbox, &list);
+  EXPECT_TRUE(iree_task_list_is_empty(&list));
+  iree_task_list_push_front(&list, &task_c);
+  iree_task_inbox_post(&inbox, &list);
+  EXPECT_FALSE(iree_task_inbox_is_empty(&inbox));
+
+  EXPECT_EQ(&task_a, iree_task_queue_flush_from_inbox(&queue, &inbox));
+  EXPECT_TRUE(iree_task_inbox_is_empty(&inbox));
+  EXPECT_EQ(&task_b, iree_task_queue_pop_front(&queue));
+  EXPECT_EQ(&task_c, iree_task_queue_pop_front(&queue));
+  EXPECT_TRUE(iree_task_queue_is_empty(&queue));
+  EXPECT_FALSE(iree_task_queue_flush_from_inbox(&queue, &inbox));
+
+  iree_task_inbox_deinitialize(&inbox);
+  iree_task_queue_deinitialize(&queue);
+}
+
+TEST(QueueTest, TryStealFromInbox) {
+  iree_task_queue_t queue;
+  iree_task_queue_initialize(&queue);
+  iree_task_inbox_t inbox;
+  iree_task_inbox_initialize(&inbox);
+
+  EXPECT_EQ(NULL, iree_task_queue_try_steal_from_inbox(&inbox, &queue,
+                                                       /*max_tasks=*/2));
+
+  // Post a LIFO batch d<-c<-b<-a.
+  iree_task_t task_a = {0};
+  iree_task_t task_b = {0};
+  iree_task_t task_c = {0};
+  iree_task_t task_d = {0};
+  iree_task_list_t list = {0};
+  iree_task_list_push_front(&list, &task_a);
+  iree_task_list_push_front(&list, &task_b);
+  iree_task_list_push_front(&list, &task_c);
+  iree_task_list_push_front(&list, &task_d);
+  iree_task_inbox_post(&inbox, &list);
+
+  // Only the quota is stolen and the remainder stays posted in order.
+  EXPECT_EQ(&task_a, iree_task_queue_try_steal_from_inbox(&inbox, &queue,
+                                                          /*max_tasks=*/2));
+  EXPECT_EQ(&task_b, iree_task_queue_pop_front(&queue));
+  EXPECT_TRUE(iree_task_queue_is_empty(&queue));
+  EXPECT_FALSE(iree_task_inbox_is_empty(&inbox));
+
+  iree_task_queue_t owner_queue;
+  iree_task_queue_initialize(&owner_queue);
+  EXPECT_EQ(&task_c, iree_task_queue_flush_from_inbox(&owner_queue, &inbox));
+  EXPECT_EQ(&task_d, iree_task_queue_pop_front(&owner_queue));
+  EXPECT_TRUE(iree_task_queue_is_empty(&owner_queue));
+  EXPECT_TRUE(iree_task_inbox_is_empty(&inbox));
+
+  iree_task_queue_deinitialize(&owner_queue);
+  iree_task_inbox_deinitialize(&inbox);
+  iree_task_queue_deinitialize(&queue);
+}
+
+// Stresses an owner popping and refilling its queue while thieves steal from
+// it. Every task must be executed exactly once.
+TEST(QueueTest, StressOwnerAndThieves) {
+  static constexpr int kThiefCount = 4;
+  static constexpr int kBatchCount = 2000;
+  static constexpr int kBatchSize = 37;
+  static constexpr int kTaskCount = kBatchCount * kBatchSize;
+  std::vector<iree_task_t> tasks(kTaskCount);
+  std::vector<std::atomic<int>> execution_counts(kTaskCount);
+  for (auto& count : execution_counts) count = 0;
+  std::atomic<int> total_executed{0};
+  auto execute = [&](iree_task_t* task) {
+    ++execution_counts[task - tasks.data()];
+    ++total_executed;
+  };
+
+  iree_task_queue_t owner_queue;
+  iree_task_queue_initialize(&owner_queue);
+
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < kThiefCount; ++i) {
+    thieves.emplace_back([&, i]() {
+      iree_task_queue_t local_queue;
+      iree_task_queue_initialize(&local_queue);
+      while (total_executed.load() < kTaskCount) {
+        iree_task_t* task = iree_task_queue_try_steal(
+            &owner_queue, &local_queue, /*max_tasks=*/1 + (i % 3) * 8);
+        while (task) {
+          execute(task);
+          task = iree_task_queue_pop_front(&local_queue);
+        }
+      }
+      iree_task_queue_deinitialize(&local_queue);
+    });
+  }
+
+  // Alternate between pushing batches and popping some of the tasks so that
+  // the ring is frequently drained down to its last task.
+  for (int batch = 0; batch < kBatchCount; ++batch) {
+    iree_task_list_t list = {0};
+    for (int i = 0; i < kBatchSize; ++i) {
+      iree_task_list_push_front(&list, &tasks[batch * kBatchSize + i]);
+    }
+    iree_task_queue_append_from_lifo_list_unsafe(&owner_queue, &list);
+    for (int i = 0; i < kBatchSize - (batch % 5); ++i) {
+      iree_task_t* task = iree_task_queue_pop_front(&owner_queue);
+      if (!task) break;
+      execute(task);
+    }
+  }
+  while (iree_task_t* task = iree_task_queue_pop_front(&owner_queue)) {
+    execute(task);
+  }
+
+  for (auto& thief : thieves) thief.join();
+  EXPECT_TRUE(iree_task_queue_is_empty(&owner_queue));
+  EXPECT_EQ(kTaskCount, total_executed.load());
+  for (int i = 0; i < kTaskCount; ++i) {
+    ASSERT_EQ(1, execution_counts[i].load()) << "task " << i;
+  }
+
+  iree_task_queue_deinitialize(&owner_queue);
+}
+
+// Stresses many producers posting to an inbox while the owner and a thief
+// flush it. Every task must be received exactly once and tasks from any one
+// producer must be received in the order they were posted.
+TEST(QueueTest, StressInbox) {
+  static constexpr int kProducerCount = 4;
+  static constexpr int kTasksPerProducer = 20000;
+  static constexpr int kTaskCount = kProducerCount * kTasksPerProducer;
+  std::vector<iree_task_t> tasks(kTaskCount);
+  std::vector<std::atomic<int>> execution_counts(kTaskCount);
+  for (auto& count : execution_counts) count = 0;
+  std::atomic<int> total_executed{0};
+
+  iree_task_inbox_t inbox;
+  iree_task_inbox_initialize(&inbox);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducerCount; ++p) {
+    producers.emplace_back([&, p]() {
+      // Post in variable sized batches to exercise the chain concatenation.
+      int i = 0;
+      while (i < kTasksPerProducer) {
+        iree_task_list_t list = {0};
+        int batch_size = 1 + (i % 7);
+        for (int j = 0; j < batch_size && i < kTasksPerProducer; ++j, ++i) {
+          iree_task_list_push_front(&list, &tasks[p * kTasksPerProducer + i]);
+        }
+        iree_task_inbox_post(&inbox, &list);
+      }
+    });
+  }
+
+  // Each consumer checks that per-producer order is preserved within what it
+  // receives.
+  auto consume = [&]() {
+    iree_task_queue_t queue;
+    iree_task_queue_initialize(&queue);
+    std::vector<int> last_index(kProducerCount, -1);
+    while (total_executed.load() < kTaskCount) {
+      iree_task_t* task = iree_task_queue_flush_from_inbox(&queue, &inbox);
+      while (task) {
+        int index = (int)(task - tasks.data());
+        int producer = index / kTasksPerProducer;
+        EXPECT_LT(last_index[producer], index);
+        last_index[producer] = index;
+        ++execution_counts[index];
+        ++total_executed;
+        task = iree_task_queue_pop_front(&queue);
+      }
+    }
+    iree_task_queue_deinitialize(&queue);
+  };
+  std::thread thief(consume);
+  consume();
+
+  for (auto& producer : producers) producer.join();
+  thief.join();
+  EXPECT_TRUE(iree_task_inbox_is_empty(&inbox));
+  for (int i = 0; i < kTaskCount; ++i) {
+    ASSERT_EQ(1, execution_counts[i].load()) << "task " << i;
+  }
+
+  iree_task_inbox_deinitialize(&inbox);
+}
+
+// Stresses thieves stealing from an inbox while its owner flushes it and
+// producers post to it. Every task must be executed exactly once.
+TEST(QueueTest, StressInboxThieves) {
+  static constexpr int kThiefCount = 3;
+  static constexpr int kTaskCount = 50000;
+  std::vector<iree_task_t> tasks(kTaskCount);
+  std::vector<std::atomic<int>> execution_counts(kTaskCount);
+  for (auto& count : execution_counts) count = 0;
+  std::atomic<int> total_executed{0};
+
+  iree_task_inbox_t inbox;
+  iree_task_inbox_initialize(&inbox);
+
+  std::thread producer([&]() {
+    int i = 0;
+    while (i < kTaskCount) {
+      iree_task_list_t list = {0};
+      int batch_size = 1 + (i % 11);
+      for (int j = 0; j < batch_size && i < kTaskCount; ++j, ++i) {
+        iree_task_list_push_front(&list, &tasks[i]);
+      }
+      iree_task_inbox_post(&inbox, &list);
+    }
+  });
+
+  auto consume = [&](bool is_owner) {
+    iree_task_queue_t queue;
+    iree_task_queue_initialize(&queue);
+    while (total_executed.load() < kTaskCount) {
+      iree_task_t* task =
+          is_owner ? iree_task_queue_flush_from_inbox(&queue, &inbox)
+                   : iree_task_queue_try_steal_from_inbox(&inbox, &queue,
+                                                          /*max_tasks=*/3);
+      while (task) {
+        ++execution_counts[task - tasks.data()];
+        ++total_executed;
+        task = iree_task_queue_pop_front(&queue);
+      }
+    }
+    iree_task_queue_deinitialize(&queue);
+  };
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < kThiefCount; ++i) {
+    thieves.emplace_back(consume, /*is_owner=*/false);
+  }
+  consume(/*is_owner=*/true);
+
+  producer.join();
+  for (auto& thief : thieves) thief.join();
+  EXPECT_TRUE(iree_task_inbox_is_empty(&inbox));
+  for (int i = 0; i < kTaskCount; ++i) {
+    ASSERT_EQ(1, execution_counts[i].load()) << "task " << i;
+  }
+
+  iree_task_inbox_deinitialize(&inbox);
+}
+
 }  // namespace
@@ -17,6 +17,7 @@ void iree_task_topology_group_initialize(
   out_group->group_index = group_index;
   snprintf(out_group->name, IREE_ARRAYSIZE(out_group->name), "iree-worker-%u",
            group_index);
+  out_group->node_id = IREE_TASK_TOPOLOGY_NODE_ID_ANY;
   iree_thread_affinity_set_any(&out_group->ideal_thread_affinity);
   out_group->constructive_sharing_mask = IREE_TASK_TOPOLOGY_GROUP_MASK_ALL;
 }
@@ -76,6 +77,18 @@ iree_status_t iree_task_topology_push_group(
   return iree_ok_status();
 }
 
+iree_task_topology_node_id_t iree_task_topology_node_id(
+    const iree_task_topology_t* topology) {
+  if (topology->group_count == 0) return IREE_TASK_TOPOLOGY_NODE_ID_ANY;
+  const iree_task_topology_node_id_t node_id = topology->groups[0].node_id;
+  for (iree_host_size_t i = 1; i < topology->group_count; ++i) {
+    if (topology->groups[i].node_id != node_id) {
+      return IREE_TASK_TOPOLOGY_NODE_ID_ANY;
+    }
+  }
+  return node_id;
+}
+
 // Fixes constructive_sharing_mask values such that they represent other chosen
 // topology groups instead of processor indices. We do this so that code using
 // the topology groups doesn't need to know anything about which physical
@@ -74,6 +74,11 @@ typedef struct iree_task_topology_group_t {
   // Logical processor index.
   uint32_t processor_index;
 
+  // NUMA node the processor belongs to or IREE_TASK_TOPOLOGY_NODE_ID_ANY if
+  // unknown or the system has a single node. Workers allocate from this node
+  // and device memory used by queues scheduled on the group can be placed here.
+  iree_task_topology_node_id_t node_id;
+
   // Total cache sizes (that we care about).
   iree_task_topology_caches_t caches;
 
@@ -153,6 +158,12 @@ const iree_task_topology_group_t* iree_task_topology_get_group(
 iree_status_t iree_task_topology_push_group(
     iree_task_topology_t* topology, const iree_task_topology_group_t* group);
 
+// Returns the NUMA node shared by all groups in |topology| or
+// IREE_TASK_TOPOLOGY_NODE_ID_ANY if the groups span multiple nodes or any
+// group has an unknown node.
+iree_task_topology_node_id_t iree_task_topology_node_id(
+    const iree_task_topology_t* topology);
+
 //===----------------------------------------------------------------------===//
 // Topology initialization helpers
 //===----------------------------------------------------------------------===//
@@ -87,6 +87,8 @@ static void iree_task_topology_set_affinity_from_processor(
   out_affinity->id_assigned = 1;
   out_affinity->id = (uint32_t)(uintptr_t)processor;
 #elif defined(__linux__)
+  // NOTE: clusters are not NUMA nodes and cpuinfo does not report the NUMA
+  // node of a processor so numa_node is left unassigned.
   out_affinity->group = processor->cluster->cluster_id;
   out_affinity->id_assigned = 1;
   out_affinity->id = processor->linux_id;
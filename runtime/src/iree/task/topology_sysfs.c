@@ -382,6 +382,153 @@ static uint32_t iree_sysfs_query_cpu_capacity(uint32_t processor) {
   return capacity;
 }
 
+//===----------------------------------------------------------------------===//
+// NUMA node queries
+//===----------------------------------------------------------------------===//
+
+// Sentinel used in iree_sysfs_node_map_t for processors without a known node.
+#define IREE_SYSFS_NODE_ID_UNKNOWN UINT16_MAX
+
+// Mapping of logical processors to the NUMA nodes they belong to as reported
+// by /sys/devices/system/node/.
+typedef struct {
+  // Number of online NUMA nodes or 0 if NUMA information is unavailable.
+  uint32_t node_count;
+  // One more than the largest online node ID. Node IDs may be sparse.
+  uint32_t node_id_limit;
+  // NUMA node of each logical processor or IREE_SYSFS_NODE_ID_UNKNOWN.
+  uint16_t processor_nodes[CPU_SETSIZE];
+} iree_sysfs_node_map_t;
+
+// Callback context for assigning processors in a node cpulist to the node.
+typedef struct {
+  iree_sysfs_node_map_t* map;
+  uint16_t node_id;
+} iree_sysfs_node_cpu_context_t;
+
+// Callback for CPU list enumeration that assigns each CPU to a node.
+static bool iree_sysfs_assign_node_cpus_callback(uint32_t start_cpu,
+                                                 uint32_t end_cpu,
+                                                 void* user_data) {
+  iree_sysfs_node_cpu_context_t* ctx =
+      (iree_sysfs_node_cpu_context_t*)user_data;
+  for (uint32_t cpu = start_cpu; cpu < end_cpu && cpu < CPU_SETSIZE; ++cpu) {
+    ctx->map->processor_nodes[cpu] = ctx->node_id;
+  }
+  return true;  // Continue enumeration.
+}
+
+// Callback for node list enumeration that reads each node's cpulist.
+// Nodes without CPUs (such as memory-only CXL/HBM nodes) have empty lists.
+static bool iree_sysfs_enumerate_node_callback(uint32_t start_node,
+                                               uint32_t end_node,
+                                               void* user_data) {
+  iree_sysfs_node_map_t* map = (iree_sysfs_node_map_t*)user_data;
+  for (uint32_t node = start_node;
+       node < end_node && node < IREE_SYSFS_NODE_ID_UNKNOWN; ++node) {
+    ++map->node_count;
+    map->node_id_limit = iree_max(map->node_id_limit, node + 1);
+    char path[256];
+    snprintf(path, sizeof(path), "%s/node/node%u/cpulist",
+             iree_sysfs_get_root_path(), node);
+    char buffer[1024];
+    iree_host_size_t length = 0;
+    iree_status_t status =
+        iree_sysfs_read_small_file(path, buffer, sizeof(buffer), &length);
+    if (iree_status_is_ok(status)) {
+      iree_sysfs_node_cpu_context_t ctx = {
+          .map = map,
+          .node_id = (uint16_t)node,
+      };
+      status = iree_sysfs_parse_cpu_list(iree_make_string_view(buffer, length),
+                                         iree_sysfs_assign_node_cpus_callback,
+                                         &ctx);
+    }
+    iree_status_ignore(status);
+  }
+  return true;  // Continue enumeration.
+}
+
+// Queries the NUMA node of every logical processor.
+// If NUMA information is unavailable (kernels built without CONFIG_NUMA) the
+// map has a node_count of 0 and all processors are unknown.
+static void iree_sysfs_query_node_map(iree_sysfs_node_map_t* out_map) {
+  out_map->node_count = 0;
+  out_map->node_id_limit = 0;
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(out_map->processor_nodes);
+       ++i) {
+    out_map->processor_nodes[i] = IREE_SYSFS_NODE_ID_UNKNOWN;
+  }
+
+  // e.g. '0-1' on a dual-socket system.
+  char path[256];
+  snprintf(path, sizeof(path), "%s/node/online", iree_sysfs_get_root_path());
+  char buffer[256];
+  iree_host_size_t length = 0;
+  iree_status_t status =
+      iree_sysfs_read_small_file(path, buffer, sizeof(buffer), &length);
+  if (iree_status_is_ok(status)) {
+    status = iree_sysfs_parse_cpu_list(iree_make_string_view(buffer, length),
+                                       iree_sysfs_enumerate_node_callback,
+                                       out_map);
+  }
+  iree_status_ignore(status);
+}
+
+// Returns true if processors should be partitioned by NUMA node.
+// Single-node systems (and those without NUMA information) are partitioned by
+// cluster instead as most of those are heterogeneous SoCs where clusters are
+// the closest thing to a node.
+static inline bool iree_sysfs_node_map_is_numa(
+    const iree_sysfs_node_map_t* map) {
+  return map->node_count > 1;
+}
+
+// Returns the NUMA node of |processor| or IREE_TASK_TOPOLOGY_NODE_ID_ANY if
+// unknown or the system is not NUMA.
+static iree_task_topology_node_id_t iree_sysfs_query_numa_node_id(
+    const iree_sysfs_node_map_t* map, uint32_t processor) {
+  if (!iree_sysfs_node_map_is_numa(map) || processor >= CPU_SETSIZE ||
+      map->processor_nodes[processor] == IREE_SYSFS_NODE_ID_UNKNOWN) {
+    return IREE_TASK_TOPOLOGY_NODE_ID_ANY;
+  }
+  return map->processor_nodes[processor];
+}
+
+// Returns the topology node of |processor|: the NUMA node on multi-node systems
+// and the cluster otherwise. Returns IREE_TASK_TOPOLOGY_NODE_ID_ANY if unknown.
+static iree_task_topology_node_id_t iree_sysfs_query_topology_node_id(
+    const iree_sysfs_node_map_t* map, uint32_t processor) {
+  if (iree_sysfs_node_map_is_numa(map)) {
+    return iree_sysfs_query_numa_node_id(map, processor);
+  }
+  uint32_t cluster_id = 0;
+  iree_status_t status = iree_sysfs_query_cluster_id(processor, &cluster_id);
+  if (!iree_status_is_ok(status) || !iree_sysfs_is_valid_cluster(cluster_id)) {
+    iree_status_ignore(status);
+    return IREE_TASK_TOPOLOGY_NODE_ID_ANY;
+  }
+  return cluster_id;
+}
+
+// Assigns the node-related fields of |group| for |processor|.
+// The thread affinity NUMA node is used by the threading layer to set the
+// memory policy of the worker thread.
+static void iree_sysfs_assign_group_node(const iree_sysfs_node_map_t* map,
+                                         uint32_t processor,
+                                         iree_task_topology_group_t* group) {
+  group->node_id = iree_sysfs_query_numa_node_id(map, processor);
+  if (group->node_id != IREE_TASK_TOPOLOGY_NODE_ID_ANY) {
+    group->ideal_thread_affinity.numa_node_assigned = 1;
+    group->ideal_thread_affinity.numa_node = group->node_id;
+  }
+  const iree_task_topology_node_id_t topology_node_id =
+      iree_sysfs_query_topology_node_id(map, processor);
+  if (topology_node_id != IREE_TASK_TOPOLOGY_NODE_ID_ANY) {
+    group->ideal_thread_affinity.group = topology_node_id;
+  }
+}
+
 //===----------------------------------------------------------------------===//
 // Cache hierarchy queries
 //===----------------------------------------------------------------------===//
@@ -482,6 +629,13 @@ static void iree_sysfs_populate_cache_info(
 //===----------------------------------------------------------------------===//
 
 iree_host_size_t iree_task_topology_query_node_count(void) {
+  // Prefer NUMA nodes when the system has more than one.
+  iree_sysfs_node_map_t node_map;
+  iree_sysfs_query_node_map(&node_map);
+  if (iree_sysfs_node_map_is_numa(&node_map)) {
+    return node_map.node_id_limit;
+  }
+
   // Count unique cluster IDs across all processors.
   const uint32_t processor_count = iree_sysfs_query_processor_count();
   if (processor_count == 0) {
@@ -510,6 +664,13 @@ iree_host_size_t iree_task_topology_query_node_count(void) {
 
 iree_task_topology_node_id_t iree_task_topology_query_current_node(void) {
   const uint32_t current_cpu = iree_sysfs_query_current_cpu();
+  iree_sysfs_node_map_t node_map;
+  iree_sysfs_query_node_map(&node_map);
+  if (iree_sysfs_node_map_is_numa(&node_map)) {
+    const iree_task_topology_node_id_t node_id =
+        iree_sysfs_query_numa_node_id(&node_map, current_cpu);
+    return node_id != IREE_TASK_TOPOLOGY_NODE_ID_ANY ? node_id : 0;
+  }
   uint32_t cluster_id = 0;
   iree_status_t status = iree_sysfs_query_cluster_id(current_cpu, &cluster_id);
   if (iree_status_is_ok(status)) {
@@ -694,6 +855,9 @@ iree_status_t iree_task_topology_initialize_from_logical_cpu_set(
   iree_task_topology_initialize(out_topology);
   out_topology->group_count = cpu_count;
 
+  iree_sysfs_node_map_t node_map;
+  iree_sysfs_query_node_map(&node_map);
+
   // Populate each group from sysfs.
   for (iree_host_size_t i = 0; i < cpu_count; ++i) {
     iree_task_topology_group_t* group = &out_topology->groups[i];
@@ -707,14 +871,8 @@ iree_status_t iree_task_topology_initialize_from_logical_cpu_set(
     group->ideal_thread_affinity.id_assigned = 1;
     group->ideal_thread_affinity.id = cpu_ids[i];
 
-    // Query cluster ID for affinity grouping.
-    uint32_t cluster_id = 0;
-    iree_status_t cluster_status =
-        iree_sysfs_query_cluster_id(cpu_ids[i], &cluster_id);
-    if (iree_status_is_ok(cluster_status)) {
-      group->ideal_thread_affinity.group = cluster_id;
-    }
-    iree_status_ignore(cluster_status);
+    // Query NUMA node/cluster ID for affinity grouping and memory placement.
+    iree_sysfs_assign_group_node(&node_map, cpu_ids[i], group);
   }
 
   iree_status_t status =
@@ -840,6 +998,9 @@ iree_status_t iree_task_topology_initialize_from_physical_cores(
 
   iree_task_topology_initialize(out_topology);
 
+  iree_sysfs_node_map_t node_map;
+  iree_sysfs_query_node_map(&node_map);
+
   // Find unique cores by enumerating processors and grouping by core_id.
   // We build a simple map of core_id -> first processor in that core.
   uint32_t core_map[IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT];
@@ -853,20 +1014,16 @@ iree_status_t iree_task_topology_initialize_from_physical_cores(
       continue;  // Skip CPUs we can't query.
     }
 
-    // Filter by cluster/node if specified.
+    // Filter by NUMA node/cluster if specified.
     if (node_id != IREE_TASK_TOPOLOGY_NODE_ID_ANY) {
-      // Only filter if cluster info is valid and doesn't match.
-      uint32_t cluster_id = 0;
-      iree_status_t cluster_status =
-          iree_sysfs_query_cluster_id(cpu, &cluster_id);
-      // When invalid we skip filtering on invalid values to avoid removing all
-      // cores on homogeneous systems.
-      if (iree_status_is_ok(cluster_status) &&
-          iree_sysfs_is_valid_cluster(cluster_id) &&
-          cluster_id != (uint32_t)node_id) {
-        continue;  // Wrong cluster.
+      // Only filter if node info is valid and doesn't match. When invalid we
+      // skip filtering to avoid removing all cores on homogeneous systems.
+      const iree_task_topology_node_id_t cpu_node_id =
+          iree_sysfs_query_topology_node_id(&node_map, cpu);
+      if (cpu_node_id != IREE_TASK_TOPOLOGY_NODE_ID_ANY &&
+          cpu_node_id != node_id) {
+        continue;  // Wrong node.
       }
-      iree_status_ignore(cluster_status);
     }
 
     // Filter by performance level on heterogeneous systems (ARM big.LITTLE).
@@ -967,14 +1124,8 @@ iree_status_t iree_task_topology_initialize_from_physical_cores(
     group->ideal_thread_affinity.id_assigned = 1;
     group->ideal_thread_affinity.id = processor;
 
-    uint32_t cluster_id = 0;
-    iree_status_t cluster_status =
-        iree_sysfs_query_cluster_id(processor, &cluster_id);
-    if (iree_status_is_ok(cluster_status)) {
-      group->ideal_thread_affinity.group = cluster_id;
-    } else {
-      iree_status_ignore(cluster_status);
-    }
+    // Query NUMA node/cluster ID for affinity grouping and memory placement.
+    iree_sysfs_assign_group_node(&node_map, processor, group);
   }
 
   iree_status_t status =
@@ -65,6 +65,34 @@ TEST(TopologyTest, Construction) {
   iree_task_topology_deinitialize(&topology);
 }
 
+TEST(TopologyTest, NodeId) {
+  iree_task_topology_t topology;
+  iree_task_topology_initialize(&topology);
+
+  // Empty topologies have no node.
+  EXPECT_EQ(IREE_TASK_TOPOLOGY_NODE_ID_ANY,
+            iree_task_topology_node_id(&topology));
+
+  // Groups default to no node.
+  iree_task_topology_group_t group;
+  iree_task_topology_group_initialize(0, &group);
+  EXPECT_EQ(IREE_TASK_TOPOLOGY_NODE_ID_ANY, group.node_id);
+
+  // All groups on the same node.
+  group.node_id = 1;
+  IREE_EXPECT_OK(iree_task_topology_push_group(&topology, &group));
+  IREE_EXPECT_OK(iree_task_topology_push_group(&topology, &group));
+  EXPECT_EQ(1, iree_task_topology_node_id(&topology));
+
+  // Groups spanning nodes.
+  group.node_id = 0;
+  IREE_EXPECT_OK(iree_task_topology_push_group(&topology, &group));
+  EXPECT_EQ(IREE_TASK_TOPOLOGY_NODE_ID_ANY,
+            iree_task_topology_node_id(&topology));
+
+  iree_task_topology_deinitialize(&topology);
+}
+
 TEST(TopologyTest, MaxCapacity) {
   iree_task_topology_t topology;
   iree_task_topology_initialize(&topology);
@@ -131,6 +159,10 @@ static void EnsureTopologyValid(iree_host_size_t max_group_count,
     const iree_task_topology_group_t* group =
         iree_task_topology_get_group(topology, i);
     EXPECT_EQ(i, group->group_index);
+    // Memory is only placed on a NUMA node when the group is known to be on it.
+    if (group->ideal_thread_affinity.numa_node_assigned) {
+      EXPECT_EQ(group->node_id, group->ideal_thread_affinity.numa_node);
+    }
   }
 }
 
@@ -94,6 +94,32 @@ extern "C" {
 // memory).
 #define IREE_TASK_DISPATCH_MAX_TILES_PER_SHARD_RESERVATION (8)
 
+// Maximum spin duration learned by the adaptive worker spin policies when the
+// executor options don't specify one. Gaps longer than this are better served
+// by parking the worker in the kernel.
+#define IREE_TASK_WORKER_DEFAULT_MAX_ADAPTIVE_SPIN_NS (200 /*us*/ * 1000)
+
+// log2 of the upper bound in nanoseconds of the smallest bucket in the
+// per-worker idle gap histogram used by the adaptive spin policies. Each
+// subsequent bucket doubles the bound such that with the default 10 and 16
+// buckets the histogram covers gaps from <1us to >16ms.
+#define IREE_TASK_WORKER_GAP_HISTOGRAM_MIN_SHIFT (10)
+#define IREE_TASK_WORKER_GAP_HISTOGRAM_BUCKET_COUNT (16)
+
+// Number of gap samples after which the per-worker gap histogram is decayed by
+// halving all counts. Lower values adapt to workload changes more quickly at
+// the cost of noisier spin selection.
+#define IREE_TASK_WORKER_GAP_HISTOGRAM_DECAY_COUNT (256)
+
+// Minimum number of gap samples a worker must have observed before the
+// adaptive spin policies will spin at all.
+#define IREE_TASK_WORKER_GAP_HISTOGRAM_MIN_SAMPLES (8)
+
+// Wall time window over which the worker spin budget is accounted. Spin and
+// wall time accumulators are halved each time the window is exceeded so the
+// budget tracks the recent past.
+#define IREE_TASK_WORKER_SPIN_BUDGET_WINDOW_NS (100 /*ms*/ * 1000000)
+
 // Whether to enable per-tile colors for each tile tracing zone based on the
 // tile grid xyz. Not cheap and can be disabled to reduce tracing overhead.
 // TODO(#4017): make per-tile color tracing fast enough to always have on.
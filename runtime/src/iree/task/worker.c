@@ -20,6 +20,8 @@
 #define IREE_TASK_WORKER_MIN_STACK_SIZE (32 * 1024)
 
 static int iree_task_worker_main(iree_task_worker_t* worker);
+static void iree_task_worker_spin_state_initialize(
+    iree_task_worker_t* worker, const iree_task_topology_group_t* group);
 
 iree_status_t iree_task_worker_initialize(
     iree_task_executor_t* executor, iree_host_size_t worker_index,
@@ -44,8 +46,9 @@ iree_status_t iree_task_worker_initialize(
 
   iree_notification_initialize(&out_worker->wake_notification);
   iree_notification_initialize(&out_worker->state_notification);
-  iree_atomic_task_slist_initialize(&out_worker->mailbox_slist);
+  iree_task_inbox_initialize(&out_worker->mailbox);
   iree_task_queue_initialize(&out_worker->local_task_queue);
+  iree_task_worker_spin_state_initialize(out_worker, topology_group);
 
   iree_task_worker_state_t initial_state = IREE_TASK_WORKER_STATE_RUNNING;
   iree_atomic_store(&out_worker->state, initial_state,
@@ -130,13 +133,12 @@ void iree_task_worker_deinitialize(iree_task_worker_t* worker) {
   // Release unfinished tasks by flushing the mailbox (which if we're here can't
   // get anything more posted to it) and then discarding everything we still
   // have a reference to.
-  iree_atomic_task_slist_discard(&worker->mailbox_slist);
-  iree_task_list_discard(&worker->local_task_queue.list);
+  iree_task_inbox_discard(&worker->mailbox);
+  iree_task_queue_deinitialize(&worker->local_task_queue);
 
   iree_notification_deinitialize(&worker->wake_notification);
   iree_notification_deinitialize(&worker->state_notification);
-  iree_atomic_task_slist_deinitialize(&worker->mailbox_slist);
-  iree_task_queue_deinitialize(&worker->local_task_queue);
+  iree_task_inbox_deinitialize(&worker->mailbox);
 
   IREE_TRACE_ZONE_END(z0);
 }
@@ -176,8 +178,7 @@ void iree_task_worker_post_tasks(iree_task_worker_t* worker,
                                  iree_task_list_t* list) {
   // Move the list into the mailbox. Note that the mailbox is LIFO and this list
   // is concatenated with its current order preserved (which should be LIFO).
-  iree_atomic_task_slist_concat(&worker->mailbox_slist, list->head, list->tail);
-  memset(list, 0, sizeof(*list));
+  iree_task_inbox_post(&worker->mailbox, list);
 }
 
 iree_task_t* iree_task_worker_try_steal_task(iree_task_worker_t* worker,
@@ -189,13 +190,200 @@ iree_task_t* iree_task_worker_try_steal_task(iree_task_worker_t* worker,
                                                 target_queue, max_tasks);
   if (task) return task;
 
-  // If we still didn't steal any tasks then let's try the slist instead.
-  task = iree_atomic_task_slist_pop(&worker->mailbox_slist);
+  // If we still didn't steal any tasks then let's try the mailbox instead.
+  // The worker is likely busy with a long task if it hasn't flushed it yet.
+  // Only up to |max_tasks| are taken and the rest are left for the worker.
+  task = iree_task_queue_try_steal_from_inbox(&worker->mailbox, target_queue,
+                                              max_tasks);
   if (task) return task;
 
   return NULL;
 }
 
+//===----------------------------------------------------------------------===//
+// Adaptive spinning
+//===----------------------------------------------------------------------===//
+
+#if IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION
+// Returns a leaked "|worker_name| |suffix|" string for use as a plot name.
+static const char* iree_task_worker_make_plot_name(const char* worker_name,
+                                                   const char* suffix) {
+  char buffer[64];
+  int length =
+      snprintf(buffer, sizeof(buffer), "%s %s", worker_name, suffix);
+  IREE_LEAK_CHECK_DISABLE_PUSH();
+  char* name = malloc(length + 1);
+  memcpy(name, buffer, length + 1);
+  IREE_LEAK_CHECK_DISABLE_POP();
+  return name;
+}
+#endif  // IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION
+
+static void iree_task_worker_spin_state_initialize(
+    iree_task_worker_t* worker, const iree_task_topology_group_t* group) {
+  iree_task_worker_spin_state_t* state = &worker->spin_state;
+  memset(state, 0, sizeof(*state));
+  state->budget_last_ns = iree_time_now();
+  IREE_TRACE({
+    state->trace_gap_name =
+        iree_task_worker_make_plot_name(group->name, "idle gap ns");
+    state->trace_gap_p50_name =
+        iree_task_worker_make_plot_name(group->name, "idle gap p50 ns");
+    state->trace_gap_p90_name =
+        iree_task_worker_make_plot_name(group->name, "idle gap p90 ns");
+    state->trace_spin_name =
+        iree_task_worker_make_plot_name(group->name, "spin ns");
+    state->trace_spin_hit_name =
+        iree_task_worker_make_plot_name(group->name, "spin hit %");
+    IREE_TRACE_SET_PLOT_TYPE(state->trace_spin_hit_name,
+                             IREE_TRACING_PLOT_TYPE_PERCENTAGE, /*step=*/true,
+                             /*fill=*/false, /*color=*/0);
+  });
+}
+
+// Returns the exclusive upper bound in nanoseconds of gap histogram |bucket|.
+static iree_duration_t iree_task_worker_gap_bucket_bound(int bucket) {
+  return (iree_duration_t)1 << (IREE_TASK_WORKER_GAP_HISTOGRAM_MIN_SHIFT +
+                                bucket);
+}
+
+// Returns the gap histogram bucket |gap_ns| falls into.
+static int iree_task_worker_gap_bucket(iree_duration_t gap_ns) {
+  if (gap_ns < iree_task_worker_gap_bucket_bound(0)) return 0;
+  const int log2_gap = 63 - iree_math_count_leading_zeros_u64(gap_ns);
+  return iree_min(log2_gap - IREE_TASK_WORKER_GAP_HISTOGRAM_MIN_SHIFT + 1,
+                  IREE_TASK_WORKER_GAP_HISTOGRAM_BUCKET_COUNT - 1);
+}
+
+// Returns the upper bound of the histogram bucket containing the |percentile|
+// of observed gaps.
+static iree_duration_t iree_task_worker_gap_percentile(
+    const iree_task_worker_spin_state_t* state, uint32_t percentile) {
+  const uint32_t target = (state->gap_count * percentile + 99) / 100;
+  uint32_t cumulative = 0;
+  for (int i = 0; i < IREE_TASK_WORKER_GAP_HISTOGRAM_BUCKET_COUNT - 1; ++i) {
+    cumulative += state->gap_histogram[i];
+    if (cumulative >= target) return iree_task_worker_gap_bucket_bound(i);
+  }
+  return iree_task_worker_gap_bucket_bound(
+      IREE_TASK_WORKER_GAP_HISTOGRAM_BUCKET_COUNT - 1);
+}
+
+iree_duration_t iree_task_worker_spin_state_select_spin_ns(
+    const iree_task_worker_spin_state_t* state,
+    iree_task_worker_spin_policy_t policy, iree_duration_t max_spin_ns,
+    uint32_t spin_budget_percent) {
+  uint32_t target_percentile = 0;
+  uint32_t min_hit_percent = 0;
+  switch (policy) {
+    default:
+    case IREE_TASK_WORKER_SPIN_POLICY_FIXED:
+      return max_spin_ns;
+    case IREE_TASK_WORKER_SPIN_POLICY_LATENCY:
+      // Catch nearly all gaps and spin so long as some fraction is caught.
+      target_percentile = 90;
+      min_hit_percent = 10;
+      break;
+    case IREE_TASK_WORKER_SPIN_POLICY_EFFICIENCY:
+      // Only spin when the typical gap is short enough to be caught.
+      target_percentile = 50;
+      min_hit_percent = 50;
+      break;
+  }
+
+  // Don't guess until we've seen enough gaps to have some idea.
+  if (state->gap_count < IREE_TASK_WORKER_GAP_HISTOGRAM_MIN_SAMPLES) {
+    return IREE_DURATION_ZERO;
+  }
+
+  // Stop spinning if it hasn't been paying off (such as when the thread that
+  // would wake us can't run while we spin). The spin statistics are decayed
+  // along with the gap histogram so that we periodically try again.
+  if (state->spin_count >= IREE_TASK_WORKER_GAP_HISTOGRAM_MIN_SAMPLES &&
+      state->spin_hit_count * 100 < state->spin_count * min_hit_percent) {
+    return IREE_DURATION_ZERO;
+  }
+
+  // Park immediately if we've spent more than our budget spinning recently.
+  if (spin_budget_percent > 0 &&
+      state->budget_spin_ns * 100 >
+          state->budget_window_ns * spin_budget_percent) {
+    return IREE_DURATION_ZERO;
+  }
+
+  // Spin long enough to catch the target fraction of gaps (up to the limit)
+  // so long as enough of them would be caught to be worth it.
+  const iree_duration_t spin_ns =
+      iree_min(iree_task_worker_gap_percentile(state, target_percentile),
+               max_spin_ns);
+  uint32_t caught_count = 0;
+  for (int i = 0; i < IREE_TASK_WORKER_GAP_HISTOGRAM_BUCKET_COUNT &&
+                  iree_task_worker_gap_bucket_bound(i) <= spin_ns;
+       ++i) {
+    caught_count += state->gap_histogram[i];
+  }
+  if (caught_count * 100 < state->gap_count * min_hit_percent) {
+    return IREE_DURATION_ZERO;
+  }
+  return spin_ns;
+}
+
+void iree_task_worker_spin_state_record_wait(
+    iree_task_worker_spin_state_t* state, iree_duration_t spin_ns,
+    iree_time_t wait_start_ns, iree_time_t wait_end_ns) {
+  const iree_duration_t gap_ns = wait_end_ns - wait_start_ns;
+
+  // A wait that finished before the spin did never entered the kernel.
+  if (spin_ns > 0) {
+    ++state->spin_count;
+    if (gap_ns < spin_ns) ++state->spin_hit_count;
+  }
+
+  // Add the gap to the histogram and decay it (and the spin statistics) once
+  // it has enough samples so that it tracks the recent behavior of the
+  // workload.
+  ++state->gap_histogram[iree_task_worker_gap_bucket(gap_ns)];
+  if (++state->gap_count >= IREE_TASK_WORKER_GAP_HISTOGRAM_DECAY_COUNT) {
+    state->gap_count = 0;
+    for (int i = 0; i < IREE_TASK_WORKER_GAP_HISTOGRAM_BUCKET_COUNT; ++i) {
+      state->gap_histogram[i] /= 2;
+      state->gap_count += state->gap_histogram[i];
+    }
+    state->spin_count /= 2;
+    state->spin_hit_count /= 2;
+  }
+
+  // Account the time spent spinning against the wall time since the last wait.
+  state->budget_window_ns += wait_end_ns - state->budget_last_ns;
+  state->budget_spin_ns += iree_min(gap_ns, spin_ns);
+  state->budget_last_ns = wait_end_ns;
+  while (state->budget_window_ns > IREE_TASK_WORKER_SPIN_BUDGET_WINDOW_NS) {
+    state->budget_window_ns /= 2;
+    state->budget_spin_ns /= 2;
+  }
+}
+
+#if IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION
+// Plots the adaptive spin state of |worker| after a wait of |gap_ns| that spun
+// for up to |spin_ns|.
+static void iree_task_worker_plot_spin_state(iree_task_worker_t* worker,
+                                             iree_duration_t spin_ns,
+                                             iree_duration_t gap_ns) {
+  const iree_task_worker_spin_state_t* state = &worker->spin_state;
+  IREE_TRACE_PLOT_VALUE_I64(state->trace_gap_name, gap_ns);
+  IREE_TRACE_PLOT_VALUE_I64(state->trace_gap_p50_name,
+                            iree_task_worker_gap_percentile(state, 50));
+  IREE_TRACE_PLOT_VALUE_I64(state->trace_gap_p90_name,
+                            iree_task_worker_gap_percentile(state, 90));
+  IREE_TRACE_PLOT_VALUE_I64(state->trace_spin_name, spin_ns);
+  IREE_TRACE_PLOT_VALUE_F32(
+      state->trace_spin_hit_name,
+      state->spin_count
+          ? 100.0f * state->spin_hit_count / (float)state->spin_count
+          : 0.0f);
+}
+#endif  // IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION
+
 // Executes a task on a worker.
 // Only task types that are scheduled to workers are handled; all others must be
 // handled by the coordinator during scheduling.
@@ -252,8 +440,8 @@ static bool iree_task_worker_pump_once(
     // first place (large uneven workloads for various workers, bad distribution
     // in the face of heterogenous multi-core architectures where some workers
     // complete tasks faster than others, etc).
-    task = iree_task_queue_flush_from_lifo_slist(&worker->local_task_queue,
-                                                 &worker->mailbox_slist);
+    task = iree_task_queue_flush_from_inbox(&worker->local_task_queue,
+                                            &worker->mailbox);
   }
 
 #if IREE_TASK_EXECUTOR_MAX_THEFT_ATTEMPTS_DIVISOR > 0
@@ -363,10 +551,28 @@ static void iree_task_worker_pump_until_exit(iree_task_worker_t* worker) {
       // just using it as a pulse.
       IREE_TRACE_ZONE_BEGIN_NAMED(z_wait,
                                   "iree_task_worker_main_pump_wake_wait");
-      iree_notification_commit_wait(
-          &worker->wake_notification, wait_token,
-          /*spin_ns=*/worker->executor->worker_spin_ns,
-          /*deadline_ns=*/IREE_TIME_INFINITE_FUTURE);
+      const iree_task_executor_t* executor = worker->executor;
+      if (executor->worker_spin_policy == IREE_TASK_WORKER_SPIN_POLICY_FIXED) {
+        iree_notification_commit_wait(
+            &worker->wake_notification, wait_token, executor->worker_spin_ns,
+            /*deadline_ns=*/IREE_TIME_INFINITE_FUTURE);
+      } else {
+        // Adaptive policies learn from the duration of each wait.
+        const iree_duration_t spin_ns =
+            iree_task_worker_spin_state_select_spin_ns(
+                &worker->spin_state, executor->worker_spin_policy,
+                executor->worker_spin_ns,
+                executor->worker_spin_budget_percent);
+        const iree_time_t wait_start_ns = iree_time_now();
+        iree_notification_commit_wait(
+            &worker->wake_notification, wait_token, spin_ns,
+            /*deadline_ns=*/IREE_TIME_INFINITE_FUTURE);
+        const iree_time_t wait_end_ns = iree_time_now();
+        iree_task_worker_spin_state_record_wait(&worker->spin_state, spin_ns,
+                                                wait_start_ns, wait_end_ns);
+        IREE_TRACE(iree_task_worker_plot_spin_state(
+            worker, spin_ns, wait_end_ns - wait_start_ns));
+      }
       IREE_TRACE_ZONE_END(z_wait);
 
       // Woke from a wait - query the processor ID in case we migrated during
@@ -47,6 +47,50 @@ typedef enum iree_task_worker_state_e {
   IREE_TASK_WORKER_STATE_ZOMBIE = 2,
 } iree_task_worker_state_t;
 
+// Adaptive spin state learned by a worker from the gaps between it going idle
+// and being woken with more work. Only accessed by the worker thread.
+typedef struct iree_task_worker_spin_state_t {
+  // Histogram of observed idle gaps. Bucket i counts gaps shorter than
+  // 1 << (IREE_TASK_WORKER_GAP_HISTOGRAM_MIN_SHIFT + i) nanoseconds with the
+  // last bucket counting everything longer. Periodically decayed.
+  uint32_t gap_histogram[IREE_TASK_WORKER_GAP_HISTOGRAM_BUCKET_COUNT];
+  // Total number of samples in |gap_histogram|.
+  uint32_t gap_count;
+
+  // Decayed count of waits that spun and of those that were woken while
+  // spinning (avoiding the kernel wait).
+  uint32_t spin_count;
+  uint32_t spin_hit_count;
+
+  // Decayed wall time and time spent spinning used to enforce the budget.
+  iree_duration_t budget_window_ns;
+  iree_duration_t budget_spin_ns;
+  // Time the budget was last accounted.
+  iree_time_t budget_last_ns;
+
+  // Leaked dynamically allocated plot names; see iree_task_executor_t.
+  IREE_TRACE(const char* trace_gap_name;)
+  IREE_TRACE(const char* trace_gap_p50_name;)
+  IREE_TRACE(const char* trace_gap_p90_name;)
+  IREE_TRACE(const char* trace_spin_name;)
+  IREE_TRACE(const char* trace_spin_hit_name;)
+} iree_task_worker_spin_state_t;
+
+// Selects how long a worker with spin |state| should spin in its next idle
+// wait under |policy|. Spins are at most |max_spin_ns| and adaptive policies
+// park immediately once spinning exceeds |spin_budget_percent| of recent wall
+// time (unless 0).
+iree_duration_t iree_task_worker_spin_state_select_spin_ns(
+    const iree_task_worker_spin_state_t* state,
+    iree_task_worker_spin_policy_t policy, iree_duration_t max_spin_ns,
+    uint32_t spin_budget_percent);
+
+// Records an idle wait from |wait_start_ns| to |wait_end_ns| that spun for up
+// to |spin_ns| into the spin |state|.
+void iree_task_worker_spin_state_record_wait(
+    iree_task_worker_spin_state_t* state, iree_duration_t spin_ns,
+    iree_time_t wait_start_ns, iree_time_t wait_end_ns);
+
 // A worker within the executor pool.
 //
 // NOTE: fields in here are touched from multiple threads with lock-free
@@ -54,14 +98,14 @@ typedef enum iree_task_worker_state_e {
 // alignment and padding between particular fields is carefully (though perhaps
 // not yet correctly) selected; see the 'LAYOUT' comments below.
 typedef struct iree_task_worker_t {
-  // A LIFO mailbox used by coordinators to post tasks to this worker.
+  // A lock-free MPSC mailbox used by coordinators to post tasks to this worker.
   // As workers self-nominate to be coordinators and fan out dispatch shards
   // they can directly emplace those shards into the workers that should execute
   // them based on the work distribution policy. When workers go to look for
   // more work after their local queue empties they will flush this list and
   // move all of the tasks into their local queue and restart processing.
   // LAYOUT: must be 64b away from local_task_queue.
-  iree_atomic_task_slist_t mailbox_slist;
+  iree_task_inbox_t mailbox;
 
   // Current state of the worker (iree_task_worker_state_t).
   // LAYOUT: frequent access; next to wake_notification as they are always
@@ -70,8 +114,7 @@ typedef struct iree_task_worker_t {
 
   // Notification signaled when the worker should wake (if it is idle).
   // LAYOUT: next to state for similar access patterns; when posting other
-  //         threads will touch mailbox_slist and then send a wake
-  //         notification.
+  //         threads will touch mailbox and then send a wake notification.
   iree_notification_t wake_notification;
 
   // Notification signaled when the worker changes any state.
@@ -120,6 +163,9 @@ typedef struct iree_task_worker_t {
   // An opaque tag used to reduce the cost of processor ID queries.
   iree_cpu_processor_tag_t processor_tag;
 
+  // Learned spin policy state used when going idle.
+  iree_task_worker_spin_state_t spin_state;
+
   // Destructive interference padding between the mailbox and local task queue
   // to ensure that the worker - who is pounding on local_task_queue - doesn't
   // contend with submissions or coordinators dropping new tasks in the mailbox.
@@ -140,16 +186,16 @@ typedef struct iree_task_worker_t {
   // Worker-local FIFO queue containing the tasks that will be processed by the
   // worker. This queue supports work-stealing by other workers if they run out
   // of work of their own.
-  // LAYOUT: must be 64b away from mailbox_slist.
+  // LAYOUT: must be 64b away from mailbox.
   iree_task_queue_t local_task_queue;
 } iree_task_worker_t;
-static_assert(offsetof(iree_task_worker_t, mailbox_slist) +
-                      sizeof(iree_atomic_task_slist_t) <
+static_assert(offsetof(iree_task_worker_t, mailbox) +
+                      sizeof(iree_task_inbox_t) <
                   iree_hardware_constructive_interference_size,
-              "mailbox_slist must be in the first cache line");
+              "mailbox must be in the first cache line");
 static_assert(offsetof(iree_task_worker_t, local_task_queue) >=
                   iree_hardware_constructive_interference_size,
-              "local_task_queue must be separated from mailbox_slist by "
+              "local_task_queue must be separated from mailbox by "
               "at least a cache line");
 
 // Initializes a worker by creating its thread and configuring it for receiving
@@ -194,7 +240,9 @@ void iree_task_worker_post_tasks(iree_task_worker_t* worker,
 // Returns NULL if no tasks are available and otherwise up to |max_tasks| tasks
 // that were at the tail of the worker FIFO will be moved to the |target_queue|
 // and the first of the stolen tasks is returned. While tasks from the FIFO
-// are preferred this may also steal tasks from the mailbox.
+// are preferred this may also steal tasks from the mailbox; up to |max_tasks|
+// of the oldest tasks posted to the worker that it has not yet flushed are
+// moved to the |target_queue| and the rest are posted back to its mailbox.
 iree_task_t* iree_task_worker_try_steal_task(iree_task_worker_t* worker,
                                              iree_task_queue_t* target_queue,
                                              iree_host_size_t max_tasks);
@@ -0,0 +1,126 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/task/worker.h"
+
+#include <cstring>
+
+#include "iree/testing/gtest.h"
+
+namespace {
+
+static constexpr iree_duration_t kMaxSpinNs = 100000;  // 100us
+// Time each simulated worker spends busy between idle waits.
+static constexpr iree_duration_t kBusyNs = 1000000;  // 1ms
+// Idle gaps that fall into the second and seventh histogram buckets.
+static constexpr iree_duration_t kShortGapNs = 2000;
+static constexpr iree_duration_t kLongGapNs = 40000;
+
+// Returns the upper bound of the histogram bucket that |gap_ns| falls into.
+static iree_duration_t BucketBound(iree_duration_t gap_ns) {
+  iree_duration_t bound = (iree_duration_t)1
+                          << IREE_TASK_WORKER_GAP_HISTOGRAM_MIN_SHIFT;
+  while (bound <= gap_ns) bound <<= 1;
+  return bound;
+}
+
+class SpinStateTest : public ::testing::Test {
+ protected:
+  void SetUp() override { memset(&state_, 0, sizeof(state_)); }
+
+  // Records |count| idle waits of |gap_ns| that each spun for |spin_ns|.
+  void RecordWaits(int count, iree_duration_t gap_ns, iree_duration_t spin_ns) {
+    for (int i = 0; i < count; ++i) {
+      const iree_time_t wait_start_ns = now_ns_ + kBusyNs;
+      now_ns_ = wait_start_ns + gap_ns;
+      iree_task_worker_spin_state_record_wait(&state_, spin_ns, wait_start_ns,
+                                              now_ns_);
+    }
+  }
+
+  iree_duration_t SelectSpinNs(iree_task_worker_spin_policy_t policy,
+                               uint32_t spin_budget_percent = 0) {
+    return iree_task_worker_spin_state_select_spin_ns(
+        &state_, policy, kMaxSpinNs, spin_budget_percent);
+  }
+
+  iree_task_worker_spin_state_t state_;
+  iree_time_t now_ns_ = 0;
+};
+
+TEST_F(SpinStateTest, FixedPolicyAlwaysSpinsMax) {
+  EXPECT_EQ(SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_FIXED), kMaxSpinNs);
+  RecordWaits(64, 10 * kMaxSpinNs, /*spin_ns=*/0);
+  EXPECT_EQ(SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_FIXED), kMaxSpinNs);
+}
+
+TEST_F(SpinStateTest, AdaptiveWaitsForSamples) {
+  EXPECT_EQ(SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_LATENCY), 0);
+  RecordWaits(IREE_TASK_WORKER_GAP_HISTOGRAM_MIN_SAMPLES - 1, kShortGapNs,
+              /*spin_ns=*/0);
+  EXPECT_EQ(SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_LATENCY), 0);
+  RecordWaits(1, kShortGapNs, /*spin_ns=*/0);
+  EXPECT_EQ(SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_LATENCY),
+            BucketBound(kShortGapNs));
+}
+
+TEST_F(SpinStateTest, WindowGrowsAndShrinks) {
+  RecordWaits(16, kShortGapNs, /*spin_ns=*/0);
+  const iree_duration_t short_spin_ns =
+      SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_LATENCY);
+  EXPECT_EQ(short_spin_ns, BucketBound(kShortGapNs));
+
+  // Longer gaps grow the window to catch them.
+  RecordWaits(64, kLongGapNs, /*spin_ns=*/0);
+  const iree_duration_t long_spin_ns =
+      SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_LATENCY);
+  EXPECT_EQ(long_spin_ns, BucketBound(kLongGapNs));
+  EXPECT_GT(long_spin_ns, short_spin_ns);
+
+  // Once the long gaps decay out of the histogram the window shrinks again.
+  RecordWaits(4 * IREE_TASK_WORKER_GAP_HISTOGRAM_DECAY_COUNT, kShortGapNs,
+              /*spin_ns=*/0);
+  EXPECT_EQ(SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_LATENCY), short_spin_ns);
+}
+
+TEST_F(SpinStateTest, ParksWhenGapsExceedMax) {
+  RecordWaits(16, 10 * kMaxSpinNs, /*spin_ns=*/0);
+  EXPECT_EQ(SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_LATENCY), 0);
+  EXPECT_EQ(SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_EFFICIENCY), 0);
+}
+
+TEST_F(SpinStateTest, ParksWhenSpinsMiss) {
+  // Gaps are short but spinning never catches them (such as when the waking
+  // thread cannot run while we spin).
+  RecordWaits(16, kShortGapNs, /*spin_ns=*/kShortGapNs / 2);
+  EXPECT_EQ(SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_LATENCY), 0);
+}
+
+TEST_F(SpinStateTest, ParksWhenOverBudget) {
+  // Each wait spins ~4% of the wall time.
+  RecordWaits(16, kLongGapNs, /*spin_ns=*/kMaxSpinNs);
+  EXPECT_EQ(SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_LATENCY,
+                         /*spin_budget_percent=*/1),
+            0);
+  EXPECT_EQ(SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_LATENCY,
+                         /*spin_budget_percent=*/10),
+            BucketBound(kLongGapNs));
+}
+
+TEST_F(SpinStateTest, EfficiencyOnlySpinsForTypicalGaps) {
+  // A minority of gaps are short enough to catch.
+  RecordWaits(8, kShortGapNs, /*spin_ns=*/0);
+  RecordWaits(12, 10 * kMaxSpinNs, /*spin_ns=*/0);
+  EXPECT_EQ(SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_LATENCY), kMaxSpinNs);
+  EXPECT_EQ(SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_EFFICIENCY), 0);
+
+  // Once most gaps are short efficiency spins for them.
+  RecordWaits(16, kShortGapNs, /*spin_ns=*/0);
+  EXPECT_EQ(SelectSpinNs(IREE_TASK_WORKER_SPIN_POLICY_EFFICIENCY),
+            BucketBound(kShortGapNs));
+}
+
+}  // namespace
@@ -9,6 +9,8 @@
 #include "iree/base/internal/call_once.h"
 #include "iree/base/internal/flags.h"
 #include "iree/hal/drivers/init.h"
+#include "iree/hal/local/dispatch_capture.h"
+#include "iree/hal/local/dispatch_statistics.h"
 #include "iree/hal/utils/allocators.h"
 #include "iree/hal/utils/mpi_channel_provider.h"
 
@@ -442,9 +444,54 @@ IREE_FLAG(
     "implementations may require a file name in order to capture profiling\n"
     "information.");
 
+IREE_FLAG(
+    string, device_capture_dispatch, "",
+    "Name of an executable export to snapshot a dispatch of for standalone\n"
+    "replay with `iree-benchmark-executable --dispatch_capture=`. Only local\n"
+    "CPU devices support capture.");
+IREE_FLAG(int32_t, device_capture_dispatch_occurrence, 0,
+          "0-based index of the dispatch of `--device_capture_dispatch=` to\n"
+          "capture when the export is dispatched multiple times.");
+IREE_FLAG(string, device_capture_dispatch_file, "dispatch.capture",
+          "File path the captured dispatch is written to.");
+
+IREE_FLAG(
+    bool, device_dispatch_statistics, false,
+    "Collects per-export dispatch counts, workgroup counts, time, and bytes\n"
+    "bound on local CPU devices. The table is printed with\n"
+    "`--print_statistics` by tools that support it and otherwise on exit.");
+
+// Active capture between iree_hal_begin/end_profiling_from_flags, if any.
+static iree_hal_local_dispatch_capture_t* iree_hal_dispatch_capture_ = NULL;
+
+// Statistics accumulated across all profiling regions until flushed.
+static iree_hal_local_dispatch_statistics_t* iree_hal_dispatch_statistics_ =
+    NULL;
+
 iree_status_t iree_hal_begin_profiling_from_flags(iree_hal_device_t* device) {
   if (!device) return iree_ok_status();
 
+  // Dispatch capture is process-wide and independent of device profiling.
+  if (strlen(FLAG_device_capture_dispatch) > 0 && !iree_hal_dispatch_capture_) {
+    if (FLAG_device_capture_dispatch_occurrence < 0) {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "dispatch capture occurrence must be >= 0");
+    }
+    IREE_RETURN_IF_ERROR(iree_hal_local_dispatch_capture_begin(
+        iree_make_cstring_view(FLAG_device_capture_dispatch),
+        (uint32_t)FLAG_device_capture_dispatch_occurrence,
+        FLAG_device_capture_dispatch_file, iree_allocator_system(),
+        &iree_hal_dispatch_capture_));
+  }
+  if (FLAG_device_dispatch_statistics) {
+    if (!iree_hal_dispatch_statistics_) {
+      IREE_RETURN_IF_ERROR(iree_hal_local_dispatch_statistics_allocate(
+          iree_allocator_system(), &iree_hal_dispatch_statistics_));
+    }
+    IREE_RETURN_IF_ERROR(iree_hal_local_dispatch_statistics_begin(
+        iree_hal_dispatch_statistics_));
+  }
+
   // Today we treat these as exclusive. When we have more implementations we
   // can figure out how best to combine them.
   iree_hal_device_profiling_options_t options = {0};
@@ -470,6 +517,26 @@ iree_status_t iree_hal_begin_profiling_from_flags(iree_hal_device_t* device) {
 
 iree_status_t iree_hal_end_profiling_from_flags(iree_hal_device_t* device) {
   if (!device) return iree_ok_status();
-  if (strlen(FLAG_device_profiling_mode) == 0) return iree_ok_status();
-  return iree_hal_device_profiling_end(device);
+  iree_status_t status = iree_ok_status();
+  if (iree_hal_dispatch_capture_) {
+    status = iree_hal_local_dispatch_capture_end(iree_hal_dispatch_capture_);
+    iree_hal_dispatch_capture_ = NULL;
+  }
+  if (iree_hal_dispatch_statistics_) {
+    iree_hal_local_dispatch_statistics_end(iree_hal_dispatch_statistics_);
+  }
+  if (strlen(FLAG_device_profiling_mode) == 0) return status;
+  return iree_status_join(status, iree_hal_device_profiling_end(device));
+}
+
+iree_status_t iree_hal_flush_dispatch_statistics_from_flags(FILE* file) {
+  if (!iree_hal_dispatch_statistics_) return iree_ok_status();
+  iree_status_t status = iree_ok_status();
+  if (file) {
+    status = iree_hal_local_dispatch_statistics_fprint(
+        file, iree_hal_dispatch_statistics_);
+  }
+  iree_hal_local_dispatch_statistics_free(iree_hal_dispatch_statistics_);
+  iree_hal_dispatch_statistics_ = NULL;
+  return status;
 }
@@ -7,6 +7,8 @@
 #ifndef IREE_TOOLING_DEVICE_UTIL_H_
 #define IREE_TOOLING_DEVICE_UTIL_H_
 
+#include <stdio.h>
+
 #include "iree/base/api.h"
 #include "iree/hal/api.h"
 
@@ -52,6 +54,8 @@ iree_status_t iree_hal_device_set_default_channel_provider(
 
 // Equivalent to iree_hal_device_profiling_begin with options sourced from
 // command line flags. No-op if profiling is not enabled.
+// Also begins capturing a dispatch if `--device_capture_dispatch=` is set and
+// collecting dispatch statistics if `--device_dispatch_statistics` is set.
 // Must be matched with a call to iree_hal_end_profiling_from_flags.
 iree_status_t iree_hal_begin_profiling_from_flags(iree_hal_device_t* device);
 
@@ -59,6 +63,12 @@ iree_status_t iree_hal_begin_profiling_from_flags(iree_hal_device_t* device);
 // command line flags. No-op if profiling is not enabled.
 iree_status_t iree_hal_end_profiling_from_flags(iree_hal_device_t* device);
 
+// Prints the per-export dispatch statistics accumulated across all
+// iree_hal_begin/end_profiling_from_flags regions to |file| (if not NULL) and
+// then discards them. No-op if `--device_dispatch_statistics` is not set.
+// Tools should call this on exit if they may have begun profiling.
+iree_status_t iree_hal_flush_dispatch_statistics_from_flags(FILE* file);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
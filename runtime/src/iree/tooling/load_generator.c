@@ -0,0 +1,847 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/tooling/load_generator.h"
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+
+#include "iree/base/internal/atomics.h"
+#include "iree/base/internal/flags.h"
+#include "iree/base/internal/math.h"
+#include "iree/base/internal/synchronization.h"
+#include "iree/base/internal/threading.h"
+#include "iree/hal/api.h"
+#include "iree/io/file_contents.h"
+#include "iree/tooling/context_util.h"
+#include "iree/tooling/device_util.h"
+#include "iree/tooling/function_io.h"
+#include "iree/tooling/function_util.h"
+
+//===----------------------------------------------------------------------===//
+// Flags
+//===----------------------------------------------------------------------===//
+
+IREE_FLAG(double, load_qps, 0.0,
+          "Enables open-loop load generation at the given target request rate\n"
+          "in requests per second. Requests are issued at the target rate\n"
+          "regardless of whether prior requests have completed and latency\n"
+          "percentiles are reported instead of running google-benchmark.");
+IREE_FLAG(string, load_arrivals, "poisson",
+          "Distribution of request arrival times under --load_qps=:\n"
+          "  `poisson`: exponentially distributed inter-arrival times\n"
+          "  `constant`: fixed inter-arrival time of 1/qps");
+IREE_FLAG(double, load_duration, 10.0,
+          "Duration in seconds over which requests arrive, excluding warmup.");
+IREE_FLAG(double, load_warmup, 1.0,
+          "Duration in seconds of requests issued before measurement begins.\n"
+          "Warmup requests are executed but not recorded.");
+IREE_FLAG(int32_t, load_sessions, 1,
+          "Number of concurrent sessions serving requests. Each session has\n"
+          "its own VM context and thread issuing invocations on the shared\n"
+          "device.");
+IREE_FLAG(string, load_input_mix, "",
+          "Path to a file listing weighted input sets to draw requests from.\n"
+          "Each non-empty line not starting with `#` is an optional\n"
+          "`<weight>|` prefix followed by `;`-separated values in `--input=`\n"
+          "format, e.g. `3|1x128xf32=0;1xi32=1`. Each request picks a line\n"
+          "with probability proportional to its weight (default 1). When\n"
+          "omitted all requests use the `--input=` values.");
+IREE_FLAG(double, load_report_interval, 1.0,
+          "Interval in seconds between periodic JSON reports or 0 to only\n"
+          "report the summary.");
+IREE_FLAG(string, load_report_file, "-",
+          "File to write JSON line reports to, `-` for stdout, or empty to\n"
+          "disable JSON reports.");
+IREE_FLAG(int64_t, load_seed, 0,
+          "Seed for the arrival time and input mix random number generator.");
+
+bool iree_tooling_load_requested_from_flags(void) { return FLAG_load_qps > 0; }
+
+//===----------------------------------------------------------------------===//
+// iree_tooling_latency_histogram_t
+//===----------------------------------------------------------------------===//
+
+#define IREE_TOOLING_LATENCY_SUB_BITS \
+  IREE_TOOLING_LATENCY_HISTOGRAM_SUB_BUCKET_BITS
+#define IREE_TOOLING_LATENCY_SUB_COUNT \
+  IREE_TOOLING_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT
+
+static iree_host_size_t iree_tooling_latency_bucket_index(uint64_t value) {
+  if (value < IREE_TOOLING_LATENCY_SUB_COUNT) return (iree_host_size_t)value;
+  int exponent = 63 - iree_math_count_leading_zeros_u64(value);
+  int shift = exponent - IREE_TOOLING_LATENCY_SUB_BITS;
+  uint64_t sub_bucket = (value >> shift) & (IREE_TOOLING_LATENCY_SUB_COUNT - 1);
+  return IREE_TOOLING_LATENCY_SUB_COUNT +
+         (iree_host_size_t)shift * IREE_TOOLING_LATENCY_SUB_COUNT +
+         (iree_host_size_t)sub_bucket;
+}
+
+// Returns the largest value that maps to bucket |index|.
+static uint64_t iree_tooling_latency_bucket_upper_bound(
+    iree_host_size_t index) {
+  if (index < IREE_TOOLING_LATENCY_SUB_COUNT) return (uint64_t)index;
+  iree_host_size_t shift =
+      (index - IREE_TOOLING_LATENCY_SUB_COUNT) / IREE_TOOLING_LATENCY_SUB_COUNT;
+  uint64_t sub_bucket =
+      (index - IREE_TOOLING_LATENCY_SUB_COUNT) % IREE_TOOLING_LATENCY_SUB_COUNT;
+  uint64_t lower = (IREE_TOOLING_LATENCY_SUB_COUNT + sub_bucket) << shift;
+  return lower + ((1ull << shift) - 1);
+}
+
+void iree_tooling_latency_histogram_reset(
+    iree_tooling_latency_histogram_t* histogram) {
+  memset(histogram, 0, sizeof(*histogram));
+  histogram->min_ns = UINT64_MAX;
+}
+
+void iree_tooling_latency_histogram_record(
+    iree_tooling_latency_histogram_t* histogram, uint64_t latency_ns) {
+  ++histogram->count;
+  histogram->sum_ns += latency_ns;
+  if (latency_ns < histogram->min_ns) histogram->min_ns = latency_ns;
+  if (latency_ns > histogram->max_ns) histogram->max_ns = latency_ns;
+  ++histogram->buckets[iree_tooling_latency_bucket_index(latency_ns)];
+}
+
+void iree_tooling_latency_histogram_merge(
+    iree_tooling_latency_histogram_t* target,
+    const iree_tooling_latency_histogram_t* source) {
+  if (!source->count) return;
+  target->count += source->count;
+  target->sum_ns += source->sum_ns;
+  if (source->min_ns < target->min_ns) target->min_ns = source->min_ns;
+  if (source->max_ns > target->max_ns) target->max_ns = source->max_ns;
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(target->buckets); ++i) {
+    target->buckets[i] += source->buckets[i];
+  }
+}
+
+uint64_t iree_tooling_latency_histogram_percentile(
+    const iree_tooling_latency_histogram_t* histogram, double percentile) {
+  if (!histogram->count) return 0;
+  uint64_t rank = (uint64_t)ceil(percentile / 100.0 * histogram->count);
+  if (rank < 1) rank = 1;
+  if (rank > histogram->count) rank = histogram->count;
+  uint64_t seen = 0;
+  for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(histogram->buckets); ++i) {
+    seen += histogram->buckets[i];
+    if (seen >= rank) {
+      uint64_t value = iree_tooling_latency_bucket_upper_bound(i);
+      if (value < histogram->min_ns) value = histogram->min_ns;
+      if (value > histogram->max_ns) value = histogram->max_ns;
+      return value;
+    }
+  }
+  return histogram->max_ns;
+}
+
+iree_status_t iree_tooling_latency_histogram_append_json(
+    const iree_tooling_latency_histogram_t* histogram,
+    iree_string_builder_t* builder) {
+  double mean_ns =
+      histogram->count ? (double)histogram->sum_ns / histogram->count : 0.0;
+  return iree_string_builder_append_format(
+      builder,
+      "{\"mean\":%.3f,\"p50\":%.3f,\"p90\":%.3f,\"p99\":%.3f,\"p999\":%.3f,"
+      "\"max\":%.3f}",
+      mean_ns / 1e6,
+      iree_tooling_latency_histogram_percentile(histogram, 50.0) / 1e6,
+      iree_tooling_latency_histogram_percentile(histogram, 90.0) / 1e6,
+      iree_tooling_latency_histogram_percentile(histogram, 99.0) / 1e6,
+      iree_tooling_latency_histogram_percentile(histogram, 99.9) / 1e6,
+      histogram->max_ns / 1e6);
+}
+
+//===----------------------------------------------------------------------===//
+// Input mix
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_tooling_load_input_set_t {
+  // Cumulative weight of this and all prior sets used for weighted selection.
+  double cumulative_weight;
+  // Parsed inputs shared by all sessions. Only read during invocation.
+  iree_vm_list_t* inputs;
+} iree_tooling_load_input_set_t;
+
+typedef struct iree_tooling_load_input_mix_t {
+  iree_host_size_t count;
+  iree_tooling_load_input_set_t* sets;
+} iree_tooling_load_input_mix_t;
+
+static void iree_tooling_load_input_mix_deinitialize(
+    iree_tooling_load_input_mix_t* mix, iree_allocator_t host_allocator) {
+  for (iree_host_size_t i = 0; i < mix->count; ++i) {
+    iree_vm_list_release(mix->sets[i].inputs);
+  }
+  iree_allocator_free(host_allocator, mix->sets);
+  memset(mix, 0, sizeof(*mix));
+}
+
+static iree_status_t iree_tooling_load_input_mix_append(
+    iree_tooling_load_input_mix_t* mix, double weight,
+    iree_string_view_t arguments_cconv, iree_string_view_list_t input_list,
+    iree_hal_device_t* device, iree_hal_allocator_t* device_allocator,
+    iree_allocator_t host_allocator) {
+  if (!(weight > 0)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "input set weights must be positive (got %f)",
+                            weight);
+  }
+  iree_vm_list_t* inputs = NULL;
+  IREE_RETURN_IF_ERROR(iree_tooling_parse_variants(
+      arguments_cconv, input_list, device, device_allocator, host_allocator,
+      &inputs));
+  iree_status_t status = iree_allocator_realloc(
+      host_allocator, (mix->count + 1) * sizeof(mix->sets[0]),
+      (void**)&mix->sets);
+  if (iree_status_is_ok(status)) {
+    double prior_weight =
+        mix->count ? mix->sets[mix->count - 1].cumulative_weight : 0.0;
+    mix->sets[mix->count].cumulative_weight = prior_weight + weight;
+    mix->sets[mix->count].inputs = inputs;
+    ++mix->count;
+  } else {
+    iree_vm_list_release(inputs);
+  }
+  return status;
+}
+
+// Parses the --load_input_mix= file at |path|. See the flag for the format.
+static iree_status_t iree_tooling_load_input_mix_parse_file(
+    iree_tooling_load_input_mix_t* mix, const char* path,
+    iree_string_view_t arguments_cconv, iree_hal_device_t* device,
+    iree_hal_allocator_t* device_allocator, iree_allocator_t host_allocator) {
+  IREE_TRACE_ZONE_BEGIN(z0);
+  iree_io_file_contents_t* contents = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_io_file_contents_read(iree_make_cstring_view(path),
+                                     host_allocator, &contents));
+
+  iree_string_view_t remaining =
+      iree_make_string_view((const char*)contents->const_buffer.data,
+                            contents->const_buffer.data_length);
+  iree_string_view_t* values = NULL;
+  iree_host_size_t value_capacity = 0;
+  iree_status_t status = iree_ok_status();
+  while (iree_status_is_ok(status) && !iree_string_view_is_empty(remaining)) {
+    iree_string_view_t line = iree_string_view_empty();
+    iree_string_view_split(remaining, '\n', &line, &remaining);
+    line = iree_string_view_trim(line);
+    if (iree_string_view_is_empty(line) ||
+        iree_string_view_starts_with(line, IREE_SV("#"))) {
+      continue;
+    }
+
+    double weight = 1.0;
+    iree_host_size_t weight_end = iree_string_view_find_char(line, '|', 0);
+    if (weight_end != IREE_STRING_VIEW_NPOS) {
+      iree_string_view_t weight_str =
+          iree_string_view_trim(iree_string_view_substr(line, 0, weight_end));
+      if (!iree_string_view_atod(weight_str, &weight)) {
+        status = iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                                  "invalid input set weight `%.*s`",
+                                  (int)weight_str.size, weight_str.data);
+        break;
+      }
+      line = iree_string_view_substr(line, weight_end + 1, IREE_HOST_SIZE_MAX);
+    }
+
+    // Split the `;`-separated values; lines are short so a rescan is fine.
+    iree_host_size_t value_count = 0;
+    iree_string_view_t values_remaining = line;
+    while (iree_status_is_ok(status) &&
+           !iree_string_view_is_empty(values_remaining)) {
+      iree_string_view_t value = iree_string_view_empty();
+      iree_string_view_split(values_remaining, ';', &value, &values_remaining);
+      value = iree_string_view_trim(value);
+      if (iree_string_view_is_empty(value)) continue;
+      if (value_count == value_capacity) {
+        value_capacity = iree_max(8, value_capacity * 2);
+        status = iree_allocator_realloc(host_allocator,
+                                        value_capacity * sizeof(values[0]),
+                                        (void**)&values);
+        if (!iree_status_is_ok(status)) break;
+      }
+      values[value_count++] = value;
+    }
+    if (iree_status_is_ok(status)) {
+      iree_string_view_list_t input_list = {value_count, values};
+      status = iree_status_annotate_f(
+          iree_tooling_load_input_mix_append(mix, weight, arguments_cconv,
+                                             input_list, device,
+                                             device_allocator, host_allocator),
+          "parsing input set %" PRIhsz " of `%s`", mix->count, path);
+    }
+  }
+
+  iree_allocator_free(host_allocator, values);
+  iree_io_file_contents_free(contents);
+  if (iree_status_is_ok(status) && !mix->count) {
+    status = iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "input mix file `%s` contains no input sets",
+                              path);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+//===----------------------------------------------------------------------===//
+// Load generation
+//===----------------------------------------------------------------------===//
+
+typedef struct iree_tooling_load_generator_t iree_tooling_load_generator_t;
+
+typedef struct iree_tooling_load_session_t {
+  iree_tooling_load_generator_t* generator;
+  iree_host_size_t ordinal;
+  iree_thread_t* thread;
+  iree_vm_context_t* context;
+  iree_vm_function_t function;
+  // Failure of the session, if any. Only accessed by the session thread until
+  // it is joined.
+  iree_status_t status;
+  // Guards the histograms which are recorded by the session thread and read
+  // by the reporting thread.
+  iree_slim_mutex_t mutex;
+  // Latencies recorded since the last interval report.
+  iree_tooling_latency_histogram_t interval_latency;
+  // Latencies and service times recorded over the whole measurement period.
+  iree_tooling_latency_histogram_t total_latency;
+  iree_tooling_latency_histogram_t total_service;
+} iree_tooling_load_session_t;
+
+struct iree_tooling_load_generator_t {
+  iree_allocator_t host_allocator;
+  iree_hal_device_t* device;
+  bool is_async;
+  iree_tooling_load_input_mix_t input_mix;
+
+  // Arrival schedule. Sessions pull the next arrival in order under the lock
+  // such that requests are served first-come-first-served.
+  iree_slim_mutex_t arrival_mutex;
+  bool poisson_arrivals;
+  double interarrival_ns;
+  uint64_t rng_state;
+  iree_time_t next_arrival_ns;
+  iree_time_t measure_begin_ns;
+  iree_time_t end_ns;
+
+  // Set when any session fails so that the others stop early.
+  iree_atomic_int32_t failed;
+
+  iree_host_size_t session_count;
+  iree_tooling_load_session_t* sessions;
+};
+
+// splitmix64: small, fast, and good enough to drive arrival jitter.
+static uint64_t iree_tooling_load_rng_next(uint64_t* state) {
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// Returns a uniformly distributed value in [0, 1).
+static double iree_tooling_load_rng_uniform(uint64_t* state) {
+  return (iree_tooling_load_rng_next(state) >> 11) * 0x1.0p-53;
+}
+
+// Takes the next request from the arrival schedule. Returns false when no more
+// requests arrive before the end of the run.
+static bool iree_tooling_load_next_request(
+    iree_tooling_load_generator_t* generator, iree_time_t* out_arrival_ns,
+    iree_vm_list_t** out_inputs) {
+  iree_slim_mutex_lock(&generator->arrival_mutex);
+  iree_time_t arrival_ns = generator->next_arrival_ns;
+  bool has_request = arrival_ns < generator->end_ns &&
+                     !iree_atomic_load(&generator->failed,
+                                       iree_memory_order_relaxed);
+  if (has_request) {
+    double interarrival_ns = generator->interarrival_ns;
+    if (generator->poisson_arrivals) {
+      interarrival_ns *=
+          -log(1.0 - iree_tooling_load_rng_uniform(&generator->rng_state));
+    }
+    generator->next_arrival_ns += (iree_time_t)interarrival_ns;
+    const iree_tooling_load_input_mix_t* mix = &generator->input_mix;
+    iree_host_size_t set_index = 0;
+    if (mix->count > 1) {
+      double pick = iree_tooling_load_rng_uniform(&generator->rng_state) *
+                    mix->sets[mix->count - 1].cumulative_weight;
+      while (set_index + 1 < mix->count &&
+             mix->sets[set_index].cumulative_weight <= pick) {
+        ++set_index;
+      }
+    }
+    *out_inputs = mix->sets[set_index].inputs;
+  }
+  iree_slim_mutex_unlock(&generator->arrival_mutex);
+  *out_arrival_ns = arrival_ns;
+  return has_request;
+}
+
+static iree_status_t iree_tooling_load_session_invoke(
+    iree_tooling_load_session_t* session, iree_vm_list_t* inputs,
+    iree_vm_list_t* outputs) {
+  iree_tooling_load_generator_t* generator = session->generator;
+  iree_allocator_t host_allocator = generator->host_allocator;
+  if (!generator->is_async) {
+    return iree_vm_invoke(session->context, session->function,
+                          IREE_VM_INVOCATION_FLAG_NONE, /*policy=*/NULL,
+                          inputs, outputs, host_allocator);
+  }
+
+  // Async functions need their own fences appended so the shared input list is
+  // cloned per request.
+  iree_vm_list_t* async_inputs = NULL;
+  IREE_RETURN_IF_ERROR(
+      iree_vm_list_clone(inputs, host_allocator, &async_inputs));
+  iree_hal_fence_t* finish_fence = NULL;
+  iree_status_t status = iree_tooling_append_async_fences(
+      async_inputs, session->function, generator->device,
+      /*wait_fence=*/NULL, &finish_fence);
+  if (iree_status_is_ok(status)) {
+    status = iree_vm_invoke(session->context, session->function,
+                            IREE_VM_INVOCATION_FLAG_NONE, /*policy=*/NULL,
+                            async_inputs, outputs, host_allocator);
+  }
+  if (iree_status_is_ok(status) && finish_fence) {
+    status = iree_hal_fence_wait(finish_fence, iree_infinite_timeout(),
+                                 IREE_HAL_WAIT_FLAG_DEFAULT);
+  }
+  iree_hal_fence_release(finish_fence);
+  iree_vm_list_release(async_inputs);
+  return status;
+}
+
+static int iree_tooling_load_session_main(void* entry_arg) {
+  iree_tooling_load_session_t* session =
+      (iree_tooling_load_session_t*)entry_arg;
+  iree_tooling_load_generator_t* generator = session->generator;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  iree_vm_list_t* outputs = NULL;
+  iree_status_t status =
+      iree_vm_list_create(iree_vm_make_undefined_type_def(), 16,
+                          generator->host_allocator, &outputs);
+
+  iree_time_t arrival_ns = 0;
+  iree_vm_list_t* inputs = NULL;
+  while (iree_status_is_ok(status) &&
+         iree_tooling_load_next_request(generator, &arrival_ns, &inputs)) {
+    // Open-loop: a session that falls behind starts immediately and the time
+    // spent queued is attributed to the request latency.
+    iree_wait_until(arrival_ns);
+    iree_time_t start_ns = iree_time_now();
+    IREE_TRACE_ZONE_BEGIN_NAMED(z_request, "load_request");
+    status = iree_tooling_load_session_invoke(session, inputs, outputs);
+    IREE_TRACE_ZONE_END(z_request);
+    iree_time_t end_ns = iree_time_now();
+    iree_vm_list_clear(outputs);
+    if (!iree_status_is_ok(status)) break;
+    if (arrival_ns < generator->measure_begin_ns) continue;
+    iree_slim_mutex_lock(&session->mutex);
+    iree_tooling_latency_histogram_record(&session->interval_latency,
+                                          end_ns - arrival_ns);
+    iree_tooling_latency_histogram_record(&session->total_latency,
+                                          end_ns - arrival_ns);
+    iree_tooling_latency_histogram_record(&session->total_service,
+                                          end_ns - start_ns);
+    iree_slim_mutex_unlock(&session->mutex);
+  }
+  iree_vm_list_release(outputs);
+
+  if (!iree_status_is_ok(status)) {
+    session->status = iree_status_annotate_f(
+        status, "session %" PRIhsz " invoking function", session->ordinal);
+    iree_atomic_store(&generator->failed, 1, iree_memory_order_relaxed);
+  }
+  IREE_TRACE_ZONE_END(z0);
+  return 0;
+}
+
+static void iree_tooling_load_write_line(FILE* file,
+                                         iree_string_builder_t* builder) {
+  if (!file) return;
+  fprintf(file, "%.*s\n", (int)iree_string_builder_size(builder),
+          iree_string_builder_buffer(builder));
+  fflush(file);
+}
+
+// Emits an interval report covering requests completed since the last one.
+static iree_status_t iree_tooling_load_report_interval(
+    iree_tooling_load_generator_t* generator, iree_time_t now_ns,
+    iree_time_t interval_ns, iree_tooling_latency_histogram_t* scratch,
+    FILE* report_file) {
+  iree_tooling_latency_histogram_reset(scratch);
+  for (iree_host_size_t i = 0; i < generator->session_count; ++i) {
+    iree_tooling_load_session_t* session = &generator->sessions[i];
+    iree_slim_mutex_lock(&session->mutex);
+    iree_tooling_latency_histogram_merge(scratch, &session->interval_latency);
+    iree_tooling_latency_histogram_reset(&session->interval_latency);
+    iree_slim_mutex_unlock(&session->mutex);
+  }
+  IREE_TRACE_PLOT_VALUE_F64("load_achieved_qps",
+                            scratch->count * 1e9 / interval_ns);
+  IREE_TRACE_PLOT_VALUE_F64(
+      "load_p99_ms",
+      iree_tooling_latency_histogram_percentile(scratch, 99.0) / 1e6);
+  if (!report_file) return iree_ok_status();
+
+  iree_string_builder_t builder;
+  iree_string_builder_initialize(generator->host_allocator, &builder);
+  iree_status_t status = iree_string_builder_append_format(
+      &builder,
+      "{\"type\":\"interval\",\"time_s\":%.3f,\"completed\":%" PRIu64
+      ",\"achieved_qps\":%.3f,\"latency_ms\":",
+      (now_ns - generator->measure_begin_ns) / 1e9, scratch->count,
+      scratch->count * 1e9 / interval_ns);
+  if (iree_status_is_ok(status)) {
+    status = iree_tooling_latency_histogram_append_json(scratch, &builder);
+  }
+  if (iree_status_is_ok(status)) {
+    status = iree_string_builder_append_cstring(&builder, "}");
+  }
+  if (iree_status_is_ok(status)) {
+    iree_tooling_load_write_line(report_file, &builder);
+  }
+  iree_string_builder_deinitialize(&builder);
+  return status;
+}
+
+// Emits the summary report covering the whole measurement period.
+static iree_status_t iree_tooling_load_report_summary(
+    iree_tooling_load_generator_t* generator, iree_time_t drain_end_ns,
+    iree_tooling_latency_histogram_t* latency,
+    iree_tooling_latency_histogram_t* service, FILE* report_file,
+    FILE* summary_file) {
+  iree_tooling_latency_histogram_reset(latency);
+  iree_tooling_latency_histogram_reset(service);
+  for (iree_host_size_t i = 0; i < generator->session_count; ++i) {
+    iree_tooling_latency_histogram_merge(latency,
+                                         &generator->sessions[i].total_latency);
+    iree_tooling_latency_histogram_merge(service,
+                                         &generator->sessions[i].total_service);
+  }
+  double elapsed_s = (drain_end_ns - generator->measure_begin_ns) / 1e9;
+  double achieved_qps = elapsed_s > 0 ? latency->count / elapsed_s : 0.0;
+
+  iree_status_t status = iree_ok_status();
+  if (report_file) {
+    iree_string_builder_t builder;
+    iree_string_builder_initialize(generator->host_allocator, &builder);
+    status = iree_string_builder_append_format(
+        &builder,
+        "{\"type\":\"summary\",\"target_qps\":%.3f,\"arrivals\":\"%s\","
+        "\"sessions\":%" PRIhsz ",\"duration_s\":%.3f,\"completed\":%" PRIu64
+        ",\"achieved_qps\":%.3f,\"latency_ms\":",
+        FLAG_load_qps, FLAG_load_arrivals, generator->session_count,
+        elapsed_s, latency->count, achieved_qps);
+    if (iree_status_is_ok(status)) {
+      status = iree_tooling_latency_histogram_append_json(latency, &builder);
+    }
+    if (iree_status_is_ok(status)) {
+      status = iree_string_builder_append_cstring(&builder, ",\"service_ms\":");
+    }
+    if (iree_status_is_ok(status)) {
+      status = iree_tooling_latency_histogram_append_json(service, &builder);
+    }
+    if (iree_status_is_ok(status)) {
+      status = iree_string_builder_append_cstring(&builder, "}");
+    }
+    if (iree_status_is_ok(status)) {
+      iree_tooling_load_write_line(report_file, &builder);
+    }
+    iree_string_builder_deinitialize(&builder);
+  }
+
+  if (iree_status_is_ok(status) && summary_file) {
+    fprintf(summary_file,
+            "target %.1f qps (%s), %" PRIhsz
+            " sessions: %" PRIu64 " requests in %.2fs = %.1f qps\n",
+            FLAG_load_qps, FLAG_load_arrivals, generator->session_count,
+            latency->count, elapsed_s, achieved_qps);
+    fprintf(summary_file, "%-8s %10s %10s %10s %10s %10s %10s\n", "(ms)",
+            "mean", "p50", "p90", "p99", "p99.9", "max");
+    iree_tooling_latency_histogram_t* histograms[2] = {latency, service};
+    const char* names[2] = {"latency", "service"};
+    for (int i = 0; i < 2; ++i) {
+      const iree_tooling_latency_histogram_t* h = histograms[i];
+      double mean_ns = h->count ? (double)h->sum_ns / h->count : 0.0;
+      fprintf(summary_file, "%-8s %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+              names[i], mean_ns / 1e6,
+              iree_tooling_latency_histogram_percentile(h, 50.0) / 1e6,
+              iree_tooling_latency_histogram_percentile(h, 90.0) / 1e6,
+              iree_tooling_latency_histogram_percentile(h, 99.0) / 1e6,
+              iree_tooling_latency_histogram_percentile(h, 99.9) / 1e6,
+              h->max_ns / 1e6);
+    }
+    fflush(summary_file);
+  }
+  return status;
+}
+
+// Runs the sessions of |generator| and reports while they execute.
+static iree_status_t iree_tooling_load_run(
+    iree_tooling_load_generator_t* generator, FILE* report_file,
+    FILE* summary_file) {
+  iree_allocator_t host_allocator = generator->host_allocator;
+  IREE_TRACE_ZONE_BEGIN(z0);
+
+  // Scratch histograms used for merging session results.
+  iree_tooling_latency_histogram_t* scratch = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_allocator_malloc(host_allocator, 2 * sizeof(*scratch),
+                                (void**)&scratch));
+
+  // Give all threads a moment to spin up before the first arrival.
+  iree_time_t begin_ns = iree_time_now() + 10000000;
+  generator->next_arrival_ns = begin_ns;
+  generator->measure_begin_ns =
+      begin_ns + (iree_time_t)(FLAG_load_warmup * 1e9);
+  generator->end_ns =
+      generator->measure_begin_ns + (iree_time_t)(FLAG_load_duration * 1e9);
+
+  iree_status_t status = iree_ok_status();
+  iree_host_size_t started_count = 0;
+  for (iree_host_size_t i = 0; i < generator->session_count; ++i) {
+    iree_tooling_load_session_t* session = &generator->sessions[i];
+    char name[32];
+    snprintf(name, sizeof(name), "iree-load-%" PRIhsz, i);
+    iree_thread_create_params_t params;
+    memset(&params, 0, sizeof(params));
+    params.name = iree_make_cstring_view(name);
+    status = iree_thread_create(iree_tooling_load_session_main, session,
+                                params, host_allocator, &session->thread);
+    if (!iree_status_is_ok(status)) break;
+    ++started_count;
+  }
+  if (!iree_status_is_ok(status)) {
+    // Stop any sessions already started; they'll exit on their next request.
+    iree_atomic_store(&generator->failed, 1, iree_memory_order_relaxed);
+  }
+
+  // Emit interval reports until no more requests arrive. Reporting before the
+  // measurement begins would only cover warmup so the first interval starts
+  // with measurement.
+  iree_time_t interval_ns =
+      (iree_time_t)(FLAG_load_report_interval * 1e9);
+  if (iree_status_is_ok(status) && interval_ns > 0) {
+    iree_wait_until(generator->measure_begin_ns);
+    for (iree_host_size_t i = 0; i < generator->session_count; ++i) {
+      iree_slim_mutex_lock(&generator->sessions[i].mutex);
+      iree_tooling_latency_histogram_reset(
+          &generator->sessions[i].interval_latency);
+      iree_slim_mutex_unlock(&generator->sessions[i].mutex);
+    }
+    iree_time_t last_report_ns = generator->measure_begin_ns;
+    while (iree_status_is_ok(status) &&
+           !iree_atomic_load(&generator->failed, iree_memory_order_relaxed)) {
+      iree_time_t next_report_ns = last_report_ns + interval_ns;
+      if (next_report_ns > generator->end_ns) break;
+      iree_wait_until(next_report_ns);
+      status = iree_tooling_load_report_interval(
+          generator, next_report_ns, interval_ns, &scratch[0], report_file);
+      last_report_ns = next_report_ns;
+    }
+  }
+
+  // Wait for all sessions to drain their remaining requests.
+  for (iree_host_size_t i = 0; i < started_count; ++i) {
+    iree_thread_join(generator->sessions[i].thread);
+  }
+  iree_time_t drain_end_ns = iree_time_now();
+  for (iree_host_size_t i = 0; i < started_count; ++i) {
+    status = iree_status_join(status, generator->sessions[i].status);
+    generator->sessions[i].status = iree_ok_status();
+  }
+
+  if (iree_status_is_ok(status)) {
+    status = iree_tooling_load_report_summary(generator, drain_end_ns,
+                                              &scratch[0], &scratch[1],
+                                              report_file, summary_file);
+  }
+
+  iree_allocator_free(host_allocator, scratch);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
+
+static iree_status_t iree_tooling_load_validate_flags(void) {
+  if (!(FLAG_load_duration > 0)) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "--load_duration= must be positive");
+  }
+  if (FLAG_load_warmup < 0 || FLAG_load_report_interval < 0) {
+    return iree_make_status(
+        IREE_STATUS_INVALID_ARGUMENT,
+        "--load_warmup= and --load_report_interval= must not be negative");
+  }
+  if (FLAG_load_sessions < 1) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "--load_sessions= must be at least 1");
+  }
+  if (strcmp(FLAG_load_arrivals, "poisson") != 0 &&
+      strcmp(FLAG_load_arrivals, "constant") != 0) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "unsupported --load_arrivals= distribution `%s`; "
+                            "expected `poisson` or `constant`",
+                            FLAG_load_arrivals);
+  }
+  return iree_ok_status();
+}
+
+iree_status_t iree_tooling_run_load_from_flags(
+    iree_vm_instance_t* instance, iree_host_size_t user_module_count,
+    iree_vm_module_t** user_modules, iree_string_view_t function_name,
+    iree_string_view_list_t default_inputs, FILE* summary_file,
+    iree_allocator_t host_allocator) {
+  IREE_ASSERT_ARGUMENT(instance);
+  IREE_ASSERT_ARGUMENT(!user_module_count || user_modules);
+  IREE_TRACE_ZONE_BEGIN(z0);
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(z0, iree_tooling_load_validate_flags());
+  if (!user_module_count) {
+    IREE_TRACE_ZONE_END(z0);
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "no user module provided for load generation");
+  }
+
+  iree_vm_function_t function;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_module_lookup_function_by_name(
+              user_modules[user_module_count - 1],
+              IREE_VM_FUNCTION_LINKAGE_EXPORT, function_name, &function));
+  iree_vm_function_signature_t signature =
+      iree_vm_function_signature(&function);
+  iree_string_view_t arguments_cconv, results_cconv;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_vm_function_call_get_cconv_fragments(
+              &signature, &arguments_cconv, &results_cconv));
+
+  // Resolve dependencies once so that all sessions share the device.
+  iree_tooling_module_list_t resolved_list;
+  iree_tooling_module_list_initialize(&resolved_list);
+  iree_hal_device_t* device = NULL;
+  iree_hal_allocator_t* device_allocator = NULL;
+  IREE_RETURN_AND_END_ZONE_IF_ERROR(
+      z0, iree_tooling_resolve_modules(
+              instance, user_module_count, user_modules,
+              /*default_device_uri=*/iree_string_view_empty(), host_allocator,
+              &resolved_list, &device, &device_allocator));
+
+  iree_tooling_load_generator_t* generator = NULL;
+  iree_host_size_t session_count = (iree_host_size_t)FLAG_load_sessions;
+  iree_status_t status = iree_allocator_malloc(
+      host_allocator,
+      sizeof(*generator) + session_count * sizeof(generator->sessions[0]),
+      (void**)&generator);
+  if (iree_status_is_ok(status)) {
+    memset(generator, 0, sizeof(*generator));
+    generator->host_allocator = host_allocator;
+    generator->device = device;
+    generator->is_async = iree_string_view_equal(
+        iree_vm_function_lookup_attr_by_name(&function,
+                                             IREE_SV("iree.abi.model")),
+        IREE_SV("coarse-fences"));
+    iree_slim_mutex_initialize(&generator->arrival_mutex);
+    generator->poisson_arrivals = strcmp(FLAG_load_arrivals, "poisson") == 0;
+    generator->interarrival_ns = 1e9 / FLAG_load_qps;
+    generator->rng_state = (uint64_t)FLAG_load_seed;
+    iree_atomic_store(&generator->failed, 0, iree_memory_order_relaxed);
+    generator->sessions =
+        (iree_tooling_load_session_t*)((uint8_t*)generator +
+                                       sizeof(*generator));
+    for (iree_host_size_t i = 0; i < session_count; ++i) {
+      iree_tooling_load_session_t* session = &generator->sessions[i];
+      memset(session, 0, sizeof(*session));
+      session->generator = generator;
+      session->ordinal = i;
+      session->function = function;
+      session->status = iree_ok_status();
+      iree_slim_mutex_initialize(&session->mutex);
+      iree_tooling_latency_histogram_reset(&session->interval_latency);
+      iree_tooling_latency_histogram_reset(&session->total_latency);
+      iree_tooling_latency_histogram_reset(&session->total_service);
+    }
+    generator->session_count = session_count;
+  }
+
+  // Parse inputs once up front; they are shared across sessions.
+  if (iree_status_is_ok(status)) {
+    if (strlen(FLAG_load_input_mix) > 0) {
+      status = iree_tooling_load_input_mix_parse_file(
+          &generator->input_mix, FLAG_load_input_mix, arguments_cconv, device,
+          device_allocator, host_allocator);
+    } else {
+      status = iree_status_annotate_f(
+          iree_tooling_load_input_mix_append(
+              &generator->input_mix, 1.0, arguments_cconv, default_inputs,
+              device, device_allocator, host_allocator),
+          "parsing function inputs");
+    }
+  }
+
+  // Each session gets its own context (and thus its own module state) so that
+  // sessions do not serialize on context-level state.
+  for (iree_host_size_t i = 0; iree_status_is_ok(status) && i < session_count;
+       ++i) {
+    iree_tooling_load_session_t* session = &generator->sessions[i];
+    status = iree_vm_context_create_with_modules(
+        instance, IREE_VM_CONTEXT_FLAG_NONE, resolved_list.count,
+        resolved_list.values, host_allocator, &session->context);
+  }
+
+  FILE* report_file = NULL;
+  bool close_report_file = false;
+  if (iree_status_is_ok(status) && strlen(FLAG_load_report_file) > 0) {
+    if (strcmp(FLAG_load_report_file, "-") == 0) {
+      report_file = stdout;
+    } else {
+      report_file = fopen(FLAG_load_report_file, "wb");
+      if (!report_file) {
+        status = iree_make_status(iree_status_code_from_errno(errno),
+                                  "unable to open report file `%s`",
+                                  FLAG_load_report_file);
+      }
+      close_report_file = true;
+    }
+  }
+
+  if (iree_status_is_ok(status) && device) {
+    status = iree_status_annotate_f(iree_hal_begin_profiling_from_flags(device),
+                                    "beginning device profiling");
+  }
+  if (iree_status_is_ok(status)) {
+    status = iree_tooling_load_run(generator, report_file, summary_file);
+    if (device) {
+      status = iree_status_join(
+          status, iree_status_annotate_f(
+                      iree_hal_end_profiling_from_flags(device),
+                      "ending device profiling"));
+    }
+  }
+
+  if (close_report_file && report_file) fclose(report_file);
+  if (generator) {
+    for (iree_host_size_t i = 0; i < generator->session_count; ++i) {
+      iree_tooling_load_session_t* session = &generator->sessions[i];
+      iree_thread_release(session->thread);
+      iree_vm_context_release(session->context);
+      iree_slim_mutex_deinitialize(&session->mutex);
+    }
+    iree_tooling_load_input_mix_deinitialize(&generator->input_mix,
+                                             host_allocator);
+    iree_slim_mutex_deinitialize(&generator->arrival_mutex);
+    iree_allocator_free(host_allocator, generator);
+  }
+  iree_hal_allocator_release(device_allocator);
+  iree_hal_device_release(device);
+  iree_tooling_module_list_reset(&resolved_list);
+  IREE_TRACE_ZONE_END(z0);
+  return status;
+}
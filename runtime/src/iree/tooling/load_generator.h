@@ -0,0 +1,99 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef IREE_TOOLING_LOAD_GENERATOR_H_
+#define IREE_TOOLING_LOAD_GENERATOR_H_
+
+#include <stdio.h>
+
+#include "iree/base/api.h"
+#include "iree/vm/api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+//===----------------------------------------------------------------------===//
+// iree_tooling_latency_histogram_t
+//===----------------------------------------------------------------------===//
+
+// Each power-of-two range of latencies is split into 2^N linear sub-buckets
+// bounding the relative error of reported percentiles to 2^-N (~3%).
+#define IREE_TOOLING_LATENCY_HISTOGRAM_SUB_BUCKET_BITS 5
+#define IREE_TOOLING_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT \
+  (1 << IREE_TOOLING_LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+#define IREE_TOOLING_LATENCY_HISTOGRAM_BUCKET_COUNT       \
+  (IREE_TOOLING_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT +      \
+   (64 - IREE_TOOLING_LATENCY_HISTOGRAM_SUB_BUCKET_BITS) * \
+       IREE_TOOLING_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT)
+
+// Log-linear histogram of nanosecond latencies.
+// Not thread-safe; callers must synchronize or use one per thread and merge.
+typedef struct iree_tooling_latency_histogram_t {
+  uint64_t count;
+  uint64_t sum_ns;
+  uint64_t min_ns;
+  uint64_t max_ns;
+  uint64_t buckets[IREE_TOOLING_LATENCY_HISTOGRAM_BUCKET_COUNT];
+} iree_tooling_latency_histogram_t;
+
+// Resets |histogram| to empty.
+void iree_tooling_latency_histogram_reset(
+    iree_tooling_latency_histogram_t* histogram);
+
+// Records a single |latency_ns| sample.
+void iree_tooling_latency_histogram_record(
+    iree_tooling_latency_histogram_t* histogram, uint64_t latency_ns);
+
+// Adds all samples from |source| to |target|.
+void iree_tooling_latency_histogram_merge(
+    iree_tooling_latency_histogram_t* target,
+    const iree_tooling_latency_histogram_t* source);
+
+// Returns the latency at |percentile| (0-100] or 0 if the histogram is empty.
+// The result is the upper bound of the bucket containing the percentile
+// clamped to the recorded minimum and maximum.
+uint64_t iree_tooling_latency_histogram_percentile(
+    const iree_tooling_latency_histogram_t* histogram, double percentile);
+
+// Appends a JSON object with the mean, p50, p90, p99, p99.9, and max latencies
+// in milliseconds to |builder|.
+iree_status_t iree_tooling_latency_histogram_append_json(
+    const iree_tooling_latency_histogram_t* histogram,
+    iree_string_builder_t* builder);
+
+//===----------------------------------------------------------------------===//
+// Open-loop load generation
+//===----------------------------------------------------------------------===//
+
+// Returns true if open-loop load generation was requested with --load_qps=.
+bool iree_tooling_load_requested_from_flags(void);
+
+// Runs |function_name| in the last of |user_modules| under open-loop load as
+// configured by the --load_* flags and reports latency statistics.
+//
+// Requests arrive at the target --load_qps rate following the
+// --load_arrivals= distribution regardless of whether prior requests have
+// completed and are served in arrival order by --load_sessions= sessions, each
+// with its own VM context on a shared device. Latencies are measured from the
+// scheduled arrival time of each request and include time spent queued behind
+// other requests, the same as a client would observe.
+//
+// Inputs are either |default_inputs| (as passed to --input=) or drawn per
+// request from the weighted mix in --load_input_mix=. Interval and summary
+// reports are written to --load_report_file= as JSON lines and a summary is
+// printed to |summary_file| if not NULL.
+iree_status_t iree_tooling_run_load_from_flags(
+    iree_vm_instance_t* instance, iree_host_size_t user_module_count,
+    iree_vm_module_t** user_modules, iree_string_view_t function_name,
+    iree_string_view_list_t default_inputs, FILE* summary_file,
+    iree_allocator_t host_allocator);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // IREE_TOOLING_LOAD_GENERATOR_H_
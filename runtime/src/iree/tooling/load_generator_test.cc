@@ -0,0 +1,105 @@
+// Copyright 2025 The IREE Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "iree/tooling/load_generator.h"
+
+#include <memory>
+#include <string>
+
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace iree {
+namespace {
+
+class LatencyHistogramTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    histogram_ = std::make_unique<iree_tooling_latency_histogram_t>();
+    iree_tooling_latency_histogram_reset(histogram_.get());
+  }
+
+  double Percentile(double percentile) {
+    return (double)iree_tooling_latency_histogram_percentile(histogram_.get(),
+                                                             percentile);
+  }
+
+  std::unique_ptr<iree_tooling_latency_histogram_t> histogram_;
+};
+
+TEST_F(LatencyHistogramTest, Empty) {
+  EXPECT_EQ(histogram_->count, 0u);
+  EXPECT_EQ(Percentile(50.0), 0.0);
+  EXPECT_EQ(Percentile(100.0), 0.0);
+}
+
+TEST_F(LatencyHistogramTest, SmallValuesAreExact) {
+  for (uint64_t i = 1; i <= 20; ++i) {
+    iree_tooling_latency_histogram_record(histogram_.get(), i);
+  }
+  EXPECT_EQ(histogram_->count, 20u);
+  EXPECT_EQ(histogram_->min_ns, 1u);
+  EXPECT_EQ(histogram_->max_ns, 20u);
+  EXPECT_EQ(Percentile(50.0), 10.0);
+  EXPECT_EQ(Percentile(90.0), 18.0);
+  EXPECT_EQ(Percentile(100.0), 20.0);
+}
+
+TEST_F(LatencyHistogramTest, BoundedRelativeError) {
+  // 1us..10ms uniformly: every percentile should be within the 1/32 relative
+  // bucket width of the exact value.
+  const uint64_t count = 10000;
+  for (uint64_t i = 1; i <= count; ++i) {
+    iree_tooling_latency_histogram_record(histogram_.get(), i * 1000);
+  }
+  for (double percentile : {50.0, 90.0, 99.0, 99.9}) {
+    double expected = percentile / 100.0 * count * 1000;
+    EXPECT_NEAR(Percentile(percentile), expected, expected / 32.0)
+        << "p" << percentile;
+  }
+  EXPECT_EQ(Percentile(100.0), 10000000.0);
+}
+
+TEST_F(LatencyHistogramTest, LargeValues) {
+  iree_tooling_latency_histogram_record(histogram_.get(), UINT64_MAX);
+  iree_tooling_latency_histogram_record(histogram_.get(), 1ull << 40);
+  EXPECT_EQ(Percentile(50.0), (double)(1ull << 40) + (1ull << 35) - 1);
+  EXPECT_EQ(Percentile(100.0), (double)UINT64_MAX);
+}
+
+TEST_F(LatencyHistogramTest, Merge) {
+  auto other = std::make_unique<iree_tooling_latency_histogram_t>();
+  iree_tooling_latency_histogram_reset(other.get());
+  iree_tooling_latency_histogram_record(histogram_.get(), 5);
+  iree_tooling_latency_histogram_record(other.get(), 2);
+  iree_tooling_latency_histogram_record(other.get(), 9);
+  iree_tooling_latency_histogram_merge(histogram_.get(), other.get());
+  EXPECT_EQ(histogram_->count, 3u);
+  EXPECT_EQ(histogram_->sum_ns, 16u);
+  EXPECT_EQ(histogram_->min_ns, 2u);
+  EXPECT_EQ(histogram_->max_ns, 9u);
+  EXPECT_EQ(Percentile(50.0), 5.0);
+}
+
+TEST_F(LatencyHistogramTest, AppendJson) {
+  // Percentiles are clamped to the recorded range so a single repeated value
+  // is reported exactly.
+  iree_tooling_latency_histogram_record(histogram_.get(), 2000000);
+  iree_tooling_latency_histogram_record(histogram_.get(), 2000000);
+  iree_string_builder_t builder;
+  iree_string_builder_initialize(iree_allocator_system(), &builder);
+  IREE_ASSERT_OK(
+      iree_tooling_latency_histogram_append_json(histogram_.get(), &builder));
+  std::string json(iree_string_builder_buffer(&builder),
+                   iree_string_builder_size(&builder));
+  iree_string_builder_deinitialize(&builder);
+  EXPECT_EQ(json,
+            "{\"mean\":2.000,\"p50\":2.000,\"p90\":2.000,\"p99\":2.000,"
+            "\"p999\":2.000,\"max\":2.000}");
+}
+
+}  // namespace
+}  // namespace iree
@@ -7,8 +7,10 @@
 #include "iree/tooling/parameter_util.h"
 
 #include "iree/base/internal/flags.h"
+#include "iree/base/internal/memory.h"
 #include "iree/io/file_handle.h"
 #include "iree/io/formats/parser_registry.h"
+#include "iree/io/packed_parameter_cache.h"
 #include "iree/io/parameter_index.h"
 #include "iree/io/parameter_index_provider.h"
 #include "iree/io/scope_map.h"
@@ -24,6 +26,38 @@ IREE_FLAG(
     "  preload: read entire parameter files into wired memory on startup.\n"
     "  file: uses platform file APIs to read/write the file as needed.");
 
+IREE_FLAG(
+    string, parameter_large_pages, "none",
+    "Large page backing of parameter files loaded with\n"
+    "--parameter_mode=preload of ['none', 'transparent', 'explicit'].");
+
+// Allocator used for preloaded parameter file contents. Lives for the process
+// lifetime as preloaded file handles may be retained by loaded modules.
+static iree_memory_large_page_allocator_t iree_io_parameter_preload_allocator_;
+static bool iree_io_parameter_preload_allocator_initialized_ = false;
+
+// Returns the allocator to use for preloading parameter files based on the
+// --parameter_large_pages flag. Must be called from the main thread.
+static iree_status_t iree_io_select_parameter_preload_allocator(
+    iree_allocator_t host_allocator, iree_allocator_t* out_allocator) {
+  *out_allocator = host_allocator;
+  iree_memory_large_page_mode_t mode = IREE_MEMORY_LARGE_PAGE_MODE_NONE;
+  IREE_RETURN_IF_ERROR(
+      iree_memory_large_page_mode_parse(
+          iree_make_cstring_view(FLAG_parameter_large_pages), &mode),
+      "parsing --parameter_large_pages");
+  if (mode == IREE_MEMORY_LARGE_PAGE_MODE_NONE) return iree_ok_status();
+  if (!iree_io_parameter_preload_allocator_initialized_) {
+    iree_memory_large_page_allocator_initialize(
+        mode, /*min_allocation_size=*/0, host_allocator,
+        &iree_io_parameter_preload_allocator_);
+    iree_io_parameter_preload_allocator_initialized_ = true;
+  }
+  *out_allocator =
+      iree_memory_large_page_allocator(&iree_io_parameter_preload_allocator_);
+  return iree_ok_status();
+}
+
 // Opens the parameter file at |path| with the mode specified by the
 // --parameter_mode flag and returns its handle.
 static iree_status_t iree_io_open_parameter_file(
@@ -37,8 +71,13 @@ static iree_status_t iree_io_open_parameter_file(
   iree_status_t status = iree_ok_status();
   iree_io_file_handle_t* file_handle = NULL;
   if (strcmp(FLAG_parameter_mode, "preload") == 0) {
-    status = iree_io_file_handle_preload(IREE_IO_FILE_MODE_READ, path,
-                                         host_allocator, &file_handle);
+    iree_allocator_t preload_allocator = host_allocator;
+    status = iree_io_select_parameter_preload_allocator(host_allocator,
+                                                        &preload_allocator);
+    if (iree_status_is_ok(status)) {
+      status = iree_io_file_handle_preload(IREE_IO_FILE_MODE_READ, path,
+                                           preload_allocator, &file_handle);
+    }
   } else if (strcmp(FLAG_parameter_mode, "file") == 0) {
     status = iree_io_file_handle_open(IREE_IO_FILE_MODE_READ, path,
                                       host_allocator, &file_handle);
@@ -124,6 +163,14 @@ iree_status_t iree_tooling_build_parameter_indices_from_flags(
   return iree_ok_status();
 }
 
+IREE_FLAG_LIST(
+    string, parameter_cache,
+    "Specifies an IRPA sidecar file caching parameters produced by programs\n"
+    "(such as packed weights) under a named scope like\n"
+    "`packed=model.packed.irpa`. The file is created if it does not exist\n"
+    "and any parameters scattered to the scope are written to it when the\n"
+    "program is unloaded.");
+
 iree_status_t iree_tooling_create_parameters_module_from_flags(
     iree_vm_instance_t* instance, iree_allocator_t host_allocator,
     iree_vm_module_t** out_module) {
@@ -140,7 +187,8 @@ iree_status_t iree_tooling_create_parameters_module_from_flags(
   iree_host_size_t provider_count = 0;
   iree_io_parameter_provider_t** providers =
       (iree_io_parameter_provider_t**)iree_alloca(
-          scope_map.count * sizeof(iree_io_parameter_provider_t*));
+          (scope_map.count + FLAG_parameter_cache_list().count) *
+          sizeof(iree_io_parameter_provider_t*));
   if (iree_status_is_ok(status)) {
     for (iree_host_size_t i = 0; i < scope_map.count; ++i) {
       status = iree_io_parameter_index_provider_create(
@@ -152,6 +200,24 @@ iree_status_t iree_tooling_create_parameters_module_from_flags(
     }
   }
 
+  // Create one cache provider per `scope=path` flag.
+  if (iree_status_is_ok(status)) {
+    for (iree_host_size_t i = 0; i < FLAG_parameter_cache_list().count; ++i) {
+      iree_string_view_t flag = FLAG_parameter_cache_list().values[i];
+      iree_string_view_t scope, path;
+      if (iree_string_view_split(flag, '=', &scope, &path) == -1) {
+        path = scope;
+        scope = iree_string_view_empty();
+      }
+      status = iree_io_packed_parameter_cache_create(
+          scope, path,
+          IREE_IO_PARAMETER_INDEX_PROVIDER_DEFAULT_MAX_CONCURRENT_OPERATIONS,
+          host_allocator, &providers[provider_count]);
+      if (!iree_status_is_ok(status)) break;
+      ++provider_count;
+    }
+  }
+
   // Create the module with the list of providers.
   if (iree_status_is_ok(status)) {
     status = iree_io_parameters_module_create(
@@ -424,6 +424,8 @@ iree_status_t iree_tooling_run_module_with_data(
 
   // Print statistics after we've released the inputs/outputs and the context
   // which may be holding on to resources like constants/variables.
+  IREE_IGNORE_ERROR(iree_hal_flush_dispatch_statistics_from_flags(
+      FLAG_print_statistics ? stderr : NULL));
   if (device_allocator && FLAG_print_statistics) {
     IREE_IGNORE_ERROR(
         iree_hal_allocator_statistics_fprint(stderr, device_allocator));
@@ -57,6 +57,7 @@ IREE_VM_ABI_DEFINE_SHIM(rr, r);
 IREE_VM_ABI_DEFINE_SHIM(rr, v);
 IREE_VM_ABI_DEFINE_SHIM(rr, ii);
 IREE_VM_ABI_DEFINE_SHIM(rr, iI);
+IREE_VM_ABI_DEFINE_SHIM(rr, I);
 IREE_VM_ABI_DEFINE_SHIM(rrr, iI);
 IREE_VM_ABI_DEFINE_SHIM(rrr, r);
 IREE_VM_ABI_DEFINE_SHIM(rrCrIID, v);
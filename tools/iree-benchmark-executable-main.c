@@ -12,6 +12,7 @@
 #include "iree/base/api.h"
 #include "iree/base/internal/flags.h"
 #include "iree/hal/api.h"
+#include "iree/hal/local/dispatch_capture.h"
 #include "iree/io/file_contents.h"
 #include "iree/modules/hal/types.h"
 #include "iree/testing/benchmark.h"
@@ -31,6 +32,14 @@ IREE_FLAG(string, executable_file, "", "Path to the executable file to load.");
 
 IREE_FLAG(int32_t, entry_point, 0, "Entry point ordinal to run.");
 
+IREE_FLAG(
+    string, dispatch_capture, "",
+    "Path to a dispatch captured with `--device_capture_dispatch=` by\n"
+    "another tool. The captured constants, binding contents and workgroup\n"
+    "count are replayed against the entry point with the captured name in\n"
+    "`--executable_file=`, which may be a variant compiled with different\n"
+    "flags. Mutually exclusive with `--constant=` and `--binding=`.");
+
 IREE_FLAG_LIST(
     string, workgroup_count,
     "`x,y,z` dimensions of the workgroup count defining the number of\n"
@@ -185,6 +194,9 @@ IREE_FLAG_CALLBACK(
 typedef struct iree_benchmark_executable_args_t {
   iree_hal_device_t* device;
   iree_hal_executable_t* executable;
+  iree_hal_executable_export_ordinal_t entry_point;
+  iree_const_byte_span_t constants;
+  iree_host_size_t binding_count;
   const iree_hal_buffer_ref_t* bindings;
   uint32_t workgroup_count[3];
 } iree_benchmark_executable_args_t;
@@ -219,11 +231,8 @@ static iree_status_t iree_benchmark_executable_run(
       IREE_HAL_COMMAND_CATEGORY_DISPATCH, IREE_HAL_QUEUE_AFFINITY_ANY,
       /*binding_capacity=*/0, &command_buffer));
   IREE_RETURN_IF_ERROR(iree_hal_command_buffer_begin(command_buffer));
-  iree_const_byte_span_t constants = iree_make_const_byte_span(
-      &parsed_params.constants[0].ui32,
-      parsed_params.constant_count * sizeof(parsed_params.constants[0]));
   iree_hal_buffer_ref_list_t bindings = {
-      .count = parsed_params.binding_count,
+      .count = args->binding_count,
       .values = args->bindings,
   };
   iree_hal_dispatch_config_t config = iree_hal_make_static_dispatch_config(
@@ -231,8 +240,8 @@ static iree_status_t iree_benchmark_executable_run(
       args->workgroup_count[2]);
   for (int32_t i = 0; i < FLAG_batch_size; ++i) {
     IREE_RETURN_IF_ERROR(iree_hal_command_buffer_dispatch(
-        command_buffer, args->executable, FLAG_entry_point, config, constants,
-        bindings, IREE_HAL_DISPATCH_FLAG_NONE));
+        command_buffer, args->executable, args->entry_point, config,
+        args->constants, bindings, IREE_HAL_DISPATCH_FLAG_NONE));
     IREE_RETURN_IF_ERROR(iree_hal_command_buffer_execution_barrier(
         command_buffer, IREE_HAL_EXECUTION_STAGE_COMMAND_RETIRE,
         IREE_HAL_EXECUTION_STAGE_COMMAND_ISSUE,
@@ -342,6 +351,25 @@ static iree_status_t iree_benchmark_executable_from_flags(
       &executable_cache));
   IREE_RETURN_IF_ERROR(loop_status);
 
+  // Load the captured dispatch, if any, which replaces the dispatch parameters
+  // specified by flags.
+  iree_io_file_contents_t* capture_contents = NULL;
+  iree_hal_local_dispatch_capture_file_t capture;
+  memset(&capture, 0, sizeof(capture));
+  const bool has_capture = strlen(FLAG_dispatch_capture) > 0;
+  if (has_capture) {
+    if (parsed_params.constant_count > 0 || parsed_params.binding_count > 0) {
+      return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                              "--constant= and --binding= cannot be used with "
+                              "--dispatch_capture=");
+    }
+    IREE_RETURN_IF_ERROR(iree_io_file_contents_read(
+        iree_make_cstring_view(FLAG_dispatch_capture), host_allocator,
+        &capture_contents));
+    IREE_RETURN_IF_ERROR(iree_hal_local_dispatch_capture_file_parse(
+        capture_contents->const_buffer, &capture));
+  }
+
   // Allocate storage for buffers and populate them.
   // They only need to remain valid for the duration of the invocation and all
   // memory accessed by the invocation will come from here.
@@ -356,6 +384,25 @@ static iree_status_t iree_benchmark_executable_from_flags(
                                 parsed_params.binding_specs},
       device, device_allocator, host_allocator, &binding_list));
   iree_hal_buffer_ref_t bindings[IREE_HAL_MAX_BINDING_COUNT];
+  for (iree_host_size_t i = 0; i < capture.binding_count; ++i) {
+    // Captured bindings are uploaded as-is: the original buffer shapes and
+    // types are not needed to reproduce the dispatch.
+    iree_hal_buffer_params_t params = {
+        .usage = IREE_HAL_BUFFER_USAGE_DEFAULT,
+        .access = IREE_HAL_MEMORY_ACCESS_ALL,
+        .type = IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL,
+    };
+    iree_const_byte_span_t contents = capture.bindings[i];
+    iree_hal_buffer_t* buffer = NULL;
+    IREE_RETURN_IF_ERROR(iree_hal_allocator_allocate_buffer(
+        device_allocator, params, iree_max(1, contents.data_length), &buffer));
+    if (contents.data_length > 0) {
+      IREE_RETURN_IF_ERROR(iree_hal_device_transfer_h2d(
+          device, contents.data, buffer, 0, contents.data_length,
+          IREE_HAL_TRANSFER_BUFFER_FLAG_DEFAULT, iree_infinite_timeout()));
+    }
+    bindings[i] = iree_hal_make_buffer_ref(buffer, 0, IREE_HAL_WHOLE_BUFFER);
+  }
   for (iree_host_size_t i = 0; i < parsed_params.binding_count; ++i) {
     iree_vm_ref_t value = iree_vm_ref_null();
     IREE_RETURN_IF_ERROR(iree_vm_list_get_ref_assign(binding_list, i, &value));
@@ -411,20 +458,55 @@ static iree_status_t iree_benchmark_executable_from_flags(
   IREE_RETURN_IF_ERROR(iree_hal_executable_cache_prepare_executable(
       executable_cache, &executable_params, &executable));
 
-  // Register one benchmark per workgroup count specified.
+  // Captured dispatches are matched by name so that executables compiled with
+  // different flags (and possibly different export ordinals) can be compared.
+  iree_hal_executable_export_ordinal_t entry_point =
+      (iree_hal_executable_export_ordinal_t)FLAG_entry_point;
+  iree_const_byte_span_t constants = iree_make_const_byte_span(
+      &parsed_params.constants[0].ui32,
+      parsed_params.constant_count * sizeof(parsed_params.constants[0]));
+  iree_host_size_t binding_count = parsed_params.binding_count;
+  if (has_capture) {
+    iree_status_t lookup_status = iree_hal_executable_lookup_export_by_name(
+        executable, capture.export_name, &entry_point);
+    if (!iree_status_is_ok(lookup_status)) {
+      fprintf(stderr,
+              "warning: export '%.*s' not found by name; using captured "
+              "ordinal %u\n",
+              (int)capture.export_name.size, capture.export_name.data,
+              capture.export_ordinal);
+      iree_status_ignore(lookup_status);
+      entry_point = capture.export_ordinal;
+    }
+    constants = iree_make_const_byte_span(
+        capture.constants, capture.constant_count * sizeof(uint32_t));
+    binding_count = capture.binding_count;
+  }
+
+  // Register one benchmark per workgroup count specified, defaulting to the
+  // captured workgroup count when replaying a dispatch.
+  iree_host_size_t benchmark_count = FLAG_workgroup_count_list().count;
+  if (has_capture && benchmark_count == 0) benchmark_count = 1;
   iree_benchmark_executable_args_t* args = NULL;
   IREE_RETURN_IF_ERROR(iree_allocator_malloc(
-      host_allocator, sizeof(*args) * FLAG_workgroup_count_list().count,
-      (void**)&args));
-  for (iree_host_size_t i = 0; i < FLAG_workgroup_count_list().count; ++i) {
+      host_allocator, sizeof(*args) * benchmark_count, (void**)&args));
+  for (iree_host_size_t i = 0; i < benchmark_count; ++i) {
     args[i] = (iree_benchmark_executable_args_t){
         .device = device,
         .executable = executable,
+        .entry_point = entry_point,
+        .constants = constants,
+        .binding_count = binding_count,
         .bindings = bindings,
         .workgroup_count = {1, 1, 1},
     };
-    IREE_RETURN_IF_ERROR(iree_parse_workgroup_count(
-        FLAG_workgroup_count_list().values[i], args[i].workgroup_count));
+    if (i < FLAG_workgroup_count_list().count) {
+      IREE_RETURN_IF_ERROR(iree_parse_workgroup_count(
+          FLAG_workgroup_count_list().values[i], args[i].workgroup_count));
+    } else {
+      memcpy(args[i].workgroup_count, capture.workgroup_count,
+             sizeof(args[i].workgroup_count));
+    }
     iree_benchmark_def_t benchmark_def = {
         .flags = IREE_BENCHMARK_FLAG_MEASURE_PROCESS_CPU_TIME |
                  IREE_BENCHMARK_FLAG_USE_REAL_TIME,
@@ -435,7 +517,10 @@ static iree_status_t iree_benchmark_executable_from_flags(
         .user_data = &args[i],
     };
     char benchmark_name[512];
-    snprintf(benchmark_name, sizeof(benchmark_name) - 1, "dispatch_%ux%ux%u",
+    iree_string_view_t name_prefix =
+        has_capture ? capture.export_name : IREE_SV("dispatch");
+    snprintf(benchmark_name, sizeof(benchmark_name) - 1, "%.*s_%ux%ux%u",
+             (int)name_prefix.size, name_prefix.data,
              args[i].workgroup_count[0], args[i].workgroup_count[1],
              args[i].workgroup_count[2]);
     iree_benchmark_register(iree_make_cstring_view(benchmark_name),
@@ -443,7 +528,12 @@ static iree_status_t iree_benchmark_executable_from_flags(
   }
   iree_benchmark_run_specified();
   iree_allocator_free(host_allocator, args);
+  IREE_IGNORE_ERROR(iree_hal_flush_dispatch_statistics_from_flags(stderr));
 
+  for (iree_host_size_t i = 0; i < capture.binding_count; ++i) {
+    iree_hal_buffer_release(bindings[i].buffer);
+  }
+  iree_io_file_contents_free(capture_contents);
   iree_vm_list_release(binding_list);
   iree_hal_executable_release(executable);
   iree_io_file_contents_free(file_contents);
@@ -508,6 +598,15 @@ int main(int argc, char** argv) {
       "  --binding=4xf32=100,200,300,400\n"
       "  --binding=4xf32=0,0,0,0\n"
       "  --workgroup_count=1,1,1\n"
+      "\n"
+      "Replaying a dispatch captured from a full program run:\n"
+      "  $ iree-run-module --device=local-sync --module=model.vmfb ... \\\n"
+      "        --device_capture_dispatch=main_dispatch_0_matmul_f32 \\\n"
+      "        --device_capture_dispatch_file=matmul.capture\n"
+      "  $ iree-benchmark-executable --device=local-sync \\\n"
+      "        --executable_format=embedded-elf-x86_64 \\\n"
+      "        --executable_file=variant.so \\\n"
+      "        --dispatch_capture=matmul.capture\n"
       "\n");
 
   iree_flags_parse_checked(IREE_FLAGS_PARSE_MODE_UNDEFINED_OK, &argc, &argv);
@@ -54,6 +54,7 @@
 
 #include <array>
 #include <cstdio>
+#include <cstring>
 #include <iterator>
 #include <string>
 #include <type_traits>
@@ -64,10 +65,12 @@
 #include "iree/base/api.h"
 #include "iree/base/internal/flags.h"
 #include "iree/hal/api.h"
+#include "iree/hal/local/profiling.h"
 #include "iree/modules/hal/types.h"
 #include "iree/tooling/context_util.h"
 #include "iree/tooling/device_util.h"
 #include "iree/tooling/function_io.h"
+#include "iree/tooling/load_generator.h"
 #include "iree/vm/api.h"
 
 constexpr char kNanosecondsUnitString[] = "ns";
@@ -91,6 +94,12 @@ IREE_FLAG(string, function, "",
 IREE_FLAG(bool, print_statistics, false,
           "Prints runtime statistics to stderr on exit.");
 
+IREE_FLAG(string, print_profile_summary, "",
+          "Prints a summary of the CPU hardware counter profile file at the "
+          "given path to stdout and exits without benchmarking. Profiles are "
+          "captured by the local-task and local-sync devices with "
+          "--device_profiling_mode=dispatch and --device_profiling_file=.");
+
 IREE_FLAG_LIST(
     string, input,
     "An input value or buffer of the format:\n"
@@ -442,6 +451,8 @@ class IREEBenchmark {
     instance_.reset();
 
     // Tear down device last in order to get accurate statistics.
+    IREE_IGNORE_ERROR(iree_hal_flush_dispatch_statistics_from_flags(
+        FLAG_print_statistics ? stderr : NULL));
     if (device_allocator_ && FLAG_print_statistics) {
       IREE_IGNORE_ERROR(iree_hal_allocator_statistics_fprint(
           stderr, device_allocator_.get()));
@@ -603,6 +614,32 @@ class IREEBenchmark {
   iree_tooling_module_list_t module_list_;
   iree::vm::ref<iree_vm_list_t> inputs_;
 };
+
+// Runs --function= under open-loop load as configured by the --load_* flags
+// instead of registering google-benchmark benchmarks.
+iree_status_t RunLoadFromFlags() {
+  IREE_TRACE_SCOPE_NAMED("RunLoadFromFlags");
+  if (strlen(FLAG_function) == 0) {
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "--load_qps= requires a --function= to invoke");
+  }
+  iree_allocator_t host_allocator = iree_allocator_system();
+  iree::vm::ref<iree_vm_instance_t> instance;
+  IREE_RETURN_IF_ERROR(iree_tooling_create_instance(host_allocator, &instance));
+  iree_tooling_module_list_t module_list;
+  iree_tooling_module_list_initialize(&module_list);
+  iree_status_t status = iree_tooling_load_modules_from_flags(
+      instance.get(), host_allocator, &module_list);
+  if (iree_status_is_ok(status)) {
+    status = iree_tooling_run_load_from_flags(
+        instance.get(), module_list.count, module_list.values,
+        iree_make_cstring_view(FLAG_function), FLAG_input_list(), stderr,
+        host_allocator);
+  }
+  iree_tooling_module_list_reset(&module_list);
+  return status;
+}
+
 }  // namespace
 }  // namespace iree
 
@@ -622,6 +659,27 @@ static int runMain(int argc, char** argv) {
                            &argc, &argv);
   ::benchmark::Initialize(&argc, argv);
 
+  if (strlen(FLAG_print_profile_summary) > 0) {
+    iree_status_t status = iree_hal_local_profile_file_fprint(
+        stdout, FLAG_print_profile_summary, iree_allocator_system());
+    int exit_code = static_cast<int>(iree_status_code(status));
+    if (!iree_status_is_ok(status)) {
+      printf("%s\n", iree::Status(std::move(status)).ToString().c_str());
+    }
+    IREE_TRACE_ZONE_END(z0);
+    return exit_code;
+  }
+
+  if (iree_tooling_load_requested_from_flags()) {
+    iree_status_t status = iree::RunLoadFromFlags();
+    int exit_code = static_cast<int>(iree_status_code(status));
+    if (!iree_status_is_ok(status)) {
+      printf("%s\n", iree::Status(std::move(status)).ToString().c_str());
+    }
+    IREE_TRACE_ZONE_END(z0);
+    return exit_code;
+  }
+
   iree::IREEBenchmark iree_benchmark;
   iree_status_t status = iree_benchmark.Register();
   if (!iree_status_is_ok(status)) {
@@ -7,6 +7,8 @@
 #include <stdio.h>
 
 #include "iree/base/api.h"
+#include "iree/base/internal/flags.h"
+#include "iree/base/internal/math.h"
 #include "iree/io/file_contents.h"
 #include "iree/schemas/instruments/dispatch.h"
 
@@ -30,6 +32,11 @@ static iree_status_t iree_tooling_dump_dispatch_metadata(
   iree_instruments_DispatchFunctionDef_vec_t functions_def =
       iree_instruments_DispatchInstrumentDef_functions(instr_def);
   out_metadata->functions_def = functions_def;
+  iree_instruments_DispatchSiteDef_vec_t dispatch_sites_def =
+      iree_instruments_DispatchInstrumentDef_sites(instr_def);
+  out_metadata->dispatch_sites_def = dispatch_sites_def;
+  if (!stream) return iree_ok_status();
+
   for (iree_host_size_t i = 0;
        i < iree_instruments_DispatchFunctionDef_vec_len(functions_def); ++i) {
     fprintf(stream, "\n");
@@ -62,9 +69,6 @@ static iree_status_t iree_tooling_dump_dispatch_metadata(
           "//"
           "===---------------------------------------------------------------"
           "-------===//\n");
-  iree_instruments_DispatchSiteDef_vec_t dispatch_sites_def =
-      iree_instruments_DispatchInstrumentDef_sites(instr_def);
-  out_metadata->dispatch_sites_def = dispatch_sites_def;
   for (iree_host_size_t i = 0;
        i < iree_instruments_DispatchSiteDef_vec_len(dispatch_sites_def); ++i) {
     iree_instruments_DispatchSiteDef_table_t dispatch_site_def =
@@ -221,11 +225,186 @@ static iree_status_t iree_tooling_dump_dispatch_ringbuffer(
   return iree_ok_status();
 }
 
+//===----------------------------------------------------------------------===//
+// Dispatch profile
+//===----------------------------------------------------------------------===//
+
+// Maximum processor ID tracked when counting the processors used.
+#define IREE_TOOLING_PROFILE_MAX_PROCESSORS 4096
+
+typedef struct {
+  // Total number of dispatches of the export.
+  uint64_t invocations;
+  // Total number of workgroups executed across all dispatches.
+  uint64_t workgroups;
+  // Total bytes loaded and stored by instrumented memory accesses.
+  uint64_t bytes;
+} iree_tooling_export_profile_t;
+
+typedef struct {
+  // Set of all processor IDs that executed any workgroup.
+  uint64_t processors[IREE_TOOLING_PROFILE_MAX_PROCESSORS / 64];
+  // Number of exports written so far; used for delimiting JSON entries.
+  iree_host_size_t export_count;
+} iree_tooling_profile_state_t;
+
+static void iree_tooling_profile_print_string(const char* value,
+                                              FILE* stream) {
+  fputc('"', stream);
+  for (const char* c = value; c && *c; ++c) {
+    if (*c == '"' || *c == '\\') fputc('\\', stream);
+    fputc(*c, stream);
+  }
+  fputc('"', stream);
+}
+
+// Returns the profile of the export dispatched by the site that produced
+// |workgroup| or NULL if the site is unknown.
+static iree_tooling_export_profile_t* iree_tooling_profile_for_workgroup(
+    const iree_dispatch_metadata_t* metadata,
+    iree_tooling_export_profile_t* profiles,
+    const iree_instrument_dispatch_workgroup_t* workgroup) {
+  if (workgroup->dispatch_id >=
+      iree_instruments_DispatchSiteDef_vec_len(metadata->dispatch_sites_def)) {
+    return NULL;
+  }
+  iree_instruments_DispatchSiteDef_table_t site_def =
+      iree_instruments_DispatchSiteDef_vec_at(metadata->dispatch_sites_def,
+                                              workgroup->dispatch_id);
+  uint32_t function_ordinal =
+      iree_instruments_DispatchSiteDef_function(site_def);
+  if (function_ordinal >=
+      iree_instruments_DispatchFunctionDef_vec_len(metadata->functions_def)) {
+    return NULL;
+  }
+  return &profiles[function_ordinal];
+}
+
+// Aggregates the ringbuffer records of each export in |metadata| and prints
+// them as entries of the JSON `exports` list.
+//
+// Workgroup records are written when each workgroup starts and carry no timing
+// so the profile only includes counts; timing from other sources (such as
+// traces) can be merged in as `time_ns` before passing the profile to the
+// compiler with `--iree-hal-profile-use=`.
+static iree_status_t iree_tooling_profile_dispatch_ringbuffer(
+    const uint8_t* data_ptr, iree_host_size_t data_size,
+    const iree_dispatch_metadata_t* metadata,
+    iree_tooling_profile_state_t* state, FILE* stream) {
+  const uint64_t ring_size = data_size - IREE_INSTRUMENT_DISPATCH_PADDING;
+  const uint8_t* ring_data = data_ptr;
+  const uint64_t ring_head = *(const uint64_t*)(ring_data + data_size - 8);
+  const uint64_t ring_range = iree_min(ring_head, ring_size);
+
+  const iree_host_size_t function_count =
+      iree_instruments_DispatchFunctionDef_vec_len(metadata->functions_def);
+  iree_tooling_export_profile_t* profiles = NULL;
+  IREE_RETURN_IF_ERROR(iree_allocator_malloc(
+      iree_allocator_system(), function_count * sizeof(*profiles),
+      (void**)&profiles));
+  memset(profiles, 0, function_count * sizeof(*profiles));
+
+  iree_status_t status = iree_ok_status();
+  for (iree_host_size_t i = 0; i < ring_range && iree_status_is_ok(status);) {
+    const iree_instrument_dispatch_header_t* header =
+        (const iree_instrument_dispatch_header_t*)(ring_data + i);
+    switch (header->tag) {
+      case IREE_INSTRUMENT_DISPATCH_TYPE_WORKGROUP: {
+        const iree_instrument_dispatch_workgroup_t* workgroup =
+            (const iree_instrument_dispatch_workgroup_t*)header;
+        iree_tooling_export_profile_t* profile =
+            iree_tooling_profile_for_workgroup(metadata, profiles, workgroup);
+        if (profile) {
+          // Each dispatch executes exactly one workgroup with the zero ID.
+          if (workgroup->workgroup_id_x == 0 &&
+              workgroup->workgroup_id_y == 0 &&
+              workgroup->workgroup_id_z == 0) {
+            ++profile->invocations;
+          }
+          ++profile->workgroups;
+        }
+        if (workgroup->processor_id < IREE_TOOLING_PROFILE_MAX_PROCESSORS) {
+          state->processors[workgroup->processor_id / 64] |=
+              1ull << (workgroup->processor_id % 64);
+        }
+        i += sizeof(*workgroup);
+        break;
+      }
+      case IREE_INSTRUMENT_DISPATCH_TYPE_PRINT: {
+        const iree_instrument_dispatch_print_t* print =
+            (const iree_instrument_dispatch_print_t*)header;
+        i += iree_host_align(sizeof(*print) + print->length, 16);
+        break;
+      }
+      case IREE_INSTRUMENT_DISPATCH_TYPE_VALUE: {
+        i += sizeof(iree_instrument_dispatch_value_t);
+        break;
+      }
+      case IREE_INSTRUMENT_DISPATCH_TYPE_MEMORY_LOAD:
+      case IREE_INSTRUMENT_DISPATCH_TYPE_MEMORY_STORE: {
+        const iree_instrument_dispatch_memory_op_t* op =
+            (const iree_instrument_dispatch_memory_op_t*)header;
+        // Memory operations reference the record of their workgroup.
+        const uint64_t workgroup_offset = op->workgroup_offset;
+        if (workgroup_offset + sizeof(iree_instrument_dispatch_workgroup_t) <=
+            ring_range) {
+          const iree_instrument_dispatch_workgroup_t* workgroup =
+              (const iree_instrument_dispatch_workgroup_t*)(ring_data +
+                                                            workgroup_offset);
+          iree_tooling_export_profile_t* profile =
+              workgroup->tag == IREE_INSTRUMENT_DISPATCH_TYPE_WORKGROUP
+                  ? iree_tooling_profile_for_workgroup(metadata, profiles,
+                                                       workgroup)
+                  : NULL;
+          if (profile) profile->bytes += op->length;
+        }
+        i += sizeof(*op);
+        break;
+      }
+      default:
+        status = iree_make_status(IREE_STATUS_UNIMPLEMENTED,
+                                  "unimplemented dispatch instr type: %u",
+                                  (uint32_t)header->tag);
+        break;
+    }
+  }
+
+  for (iree_host_size_t i = 0; i < function_count && iree_status_is_ok(status);
+       ++i) {
+    const iree_tooling_export_profile_t* profile = &profiles[i];
+    if (!profile->workgroups) continue;
+    iree_instruments_DispatchFunctionDef_table_t function_def =
+        iree_instruments_DispatchFunctionDef_vec_at(metadata->functions_def, i);
+    fprintf(stream, "%s\n    {\"name\": ", state->export_count++ ? "," : "");
+    iree_tooling_profile_print_string(
+        iree_instruments_DispatchFunctionDef_name(function_def), stream);
+    fprintf(stream,
+            ", \"invocations\": %" PRIu64 ", \"workgroups\": %" PRIu64
+            ", \"bytes\": %" PRIu64 "}",
+            profile->invocations, profile->workgroups, profile->bytes);
+  }
+
+  iree_allocator_free(iree_allocator_system(), profiles);
+  return status;
+}
+
+//===----------------------------------------------------------------------===//
+// Instrument file parsing
+//===----------------------------------------------------------------------===//
+
 static iree_status_t iree_tooling_dump_instrument_file(
-    iree_const_byte_span_t file_contents, FILE* stream) {
+    iree_const_byte_span_t file_contents, bool emit_profile, FILE* stream) {
   const uint8_t* file_ptr = file_contents.data;
   iree_host_size_t file_size = file_contents.data_length;
 
+  // Metadata text is only printed when not emitting a profile.
+  FILE* metadata_stream = emit_profile ? NULL : stream;
+  iree_tooling_profile_state_t profile_state;
+  memset(&profile_state, 0, sizeof(profile_state));
+  if (emit_profile) {
+    fprintf(stream, "{\n  \"version\": 0,\n  \"exports\": [");
+  }
+
   iree_dispatch_metadata_t dispatch_metadata = {0};
   for (iree_host_size_t file_offset = 0; file_offset < file_size;) {
     const iree_idbts_chunk_header_t* header =
@@ -234,12 +413,19 @@ static iree_status_t iree_tooling_dump_instrument_file(
     switch (header->type) {
       case IREE_IDBTS_CHUNK_TYPE_DISPATCH_METADATA: {
         IREE_RETURN_IF_ERROR(iree_tooling_dump_dispatch_metadata(
-            payload, header->content_length, &dispatch_metadata, stream));
+            payload, header->content_length, &dispatch_metadata,
+            metadata_stream));
         break;
       }
       case IREE_IDBTS_CHUNK_TYPE_DISPATCH_RINGBUFFER: {
-        IREE_RETURN_IF_ERROR(iree_tooling_dump_dispatch_ringbuffer(
-            payload, header->content_length, &dispatch_metadata, stream));
+        if (emit_profile) {
+          IREE_RETURN_IF_ERROR(iree_tooling_profile_dispatch_ringbuffer(
+              payload, header->content_length, &dispatch_metadata,
+              &profile_state, stream));
+        } else {
+          IREE_RETURN_IF_ERROR(iree_tooling_dump_dispatch_ringbuffer(
+              payload, header->content_length, &dispatch_metadata, stream));
+        }
         break;
       }
       default:
@@ -251,12 +437,41 @@ static iree_status_t iree_tooling_dump_instrument_file(
         sizeof(*header) + iree_host_align(header->content_length, 16);
   }
 
+  if (emit_profile) {
+    iree_host_size_t processor_count = 0;
+    for (iree_host_size_t i = 0; i < IREE_ARRAYSIZE(profile_state.processors);
+         ++i) {
+      processor_count += iree_math_count_ones_u64(profile_state.processors[i]);
+    }
+    fprintf(stream, "\n  ],\n  \"processor_count\": %" PRIhsz "\n}\n",
+            processor_count);
+  }
+
   return iree_ok_status();
 }
 
+IREE_FLAG(string, output, "text",
+          "Output mode:\n"
+          "  'text': dispatch metadata and all ringbuffer records.\n"
+          "  'profile': JSON profile of per-export dispatch statistics\n"
+          "             suitable for `iree-compile --iree-hal-profile-use=`.");
+
 int main(int argc, char** argv) {
   IREE_TRACE_APP_ENTER();
 
+  iree_flags_set_usage(
+      "iree-dump-instruments",
+      "Dumps dispatch instrumentation data to stdout.\n"
+      "$ iree-dump-instruments [--output=text|profile] instruments.bin\n");
+  iree_flags_parse_checked(IREE_FLAGS_PARSE_MODE_DEFAULT, &argc, &argv);
+
+  const bool emit_profile = strcmp(FLAG_output, "profile") == 0;
+  if (!emit_profile && strcmp(FLAG_output, "text") != 0) {
+    fprintf(stderr, "Unsupported --output= mode '%s'\n", FLAG_output);
+    IREE_TRACE_APP_EXIT(EXIT_FAILURE);
+    return EXIT_FAILURE;
+  }
+
   if (argc < 2) {
     fprintf(stderr,
             "Syntax: iree-dump-instruments instruments.bin > instruments.txt\n"
@@ -276,6 +491,11 @@ int main(int argc, char** argv) {
             "        --input=4xf32=4 \\n"
             "        --instrument_file=instrument.bin\n"
             "  $ iree-dump-instruments instrument.bin\n"
+            "\n"
+            "Profile-guided recompilation:\n"
+            "  $ iree-dump-instruments --output=profile instrument.bin \\\n"
+            "        > profile.json\n"
+            "  $ iree-compile ... --iree-hal-profile-use=profile.json\n"
             "\n");
     IREE_TRACE_APP_EXIT(EXIT_FAILURE);
     return EXIT_FAILURE;
@@ -286,8 +506,8 @@ int main(int argc, char** argv) {
       iree_make_cstring_view(argv[1]), IREE_IO_FILE_ACCESS_READ,
       iree_allocator_system(), &file_contents);
   if (iree_status_is_ok(status)) {
-    status =
-        iree_tooling_dump_instrument_file(file_contents->const_buffer, stdout);
+    status = iree_tooling_dump_instrument_file(file_contents->const_buffer,
+                                               emit_profile, stdout);
   }
   iree_io_file_contents_free(file_contents);
 
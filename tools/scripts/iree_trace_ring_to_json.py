@@ -0,0 +1,330 @@
+#!/usr/bin/env python3
+
+# Copyright 2025 The IREE Authors
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+"""Converts an IREE ring tracing file to Chrome trace/Perfetto JSON.
+
+Ring trace files are written by runtimes built with the `ring` tracing provider
+(`-DIREE_ENABLE_RUNTIME_TRACING=ON -DIREE_TRACING_PROVIDER=ring`) when
+iree_tracing_ring_flush is called, the process receives SIGUSR2, or on exit if
+the IREE_TRACING_RING_FILE environment variable is set. See
+runtime/src/iree/base/tracing/ring.h for the file format.
+
+The output can be loaded in https://ui.perfetto.dev or chrome://tracing.
+
+Example usage:
+  $ IREE_TRACING_RING_FILE=/tmp/trace.bin iree-run-module ...
+  $ ./tools/scripts/iree_trace_ring_to_json.py /tmp/trace.bin \\
+      -o /tmp/trace.json
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+# All supported hosts are little-endian.
+_FILE_HEADER = struct.Struct("<IIQIIII")
+_THREAD_HEADER = struct.Struct("<Q32sII")
+_EVENT = struct.Struct("<QQII")
+_FILE_MAGIC = 0x52545249
+_FILE_VERSION = 0
+
+_ZONE_BEGIN = 1
+_ZONE_END = 2
+_ZONE_VALUE = 3
+_ZONE_TEXT = 4
+_PLOT_I64 = 5
+_PLOT_F64 = 6
+_MESSAGE = 7
+_FRAME_MARK = 8
+_FRAME_BEGIN = 9
+_FRAME_END = 10
+_TEXT = 11
+
+
+def parse_arguments(argv):
+    parser = argparse.ArgumentParser(
+        prog="iree_trace_ring_to_json",
+        description="Converts an IREE ring tracing file to Chrome trace JSON.",
+    )
+    parser.add_argument("input", help="Ring trace file (.bin)")
+    parser.add_argument(
+        "-o",
+        "--output",
+        default="-",
+        help="Output JSON file path or - for stdout",
+    )
+    parser.add_argument(
+        "--pid",
+        type=int,
+        default=1,
+        help="Process ID used for all events",
+    )
+    return parser.parse_args(argv)
+
+
+class Trace:
+    """Contents of a ring trace file.
+
+    Each thread is a (thread_id, name, events) tuple with events as
+    (timestamp_ns, value, string_id, type, text) tuples. |text| is the inline
+    dynamic text of the event or None if the event only references |strings|.
+    """
+
+    def __init__(
+        self,
+        flush_timestamp_ns,
+        strings,
+        threads,
+        string_overflow_count=0,
+        text_truncation_count=0,
+    ):
+        self.flush_timestamp_ns = flush_timestamp_ns
+        self.strings = strings
+        self.threads = threads
+        self.string_overflow_count = string_overflow_count
+        self.text_truncation_count = text_truncation_count
+
+
+def merge_text_events(events):
+    """Attaches the text of TEXT events to the events they continue.
+
+    TEXT events at the start of a thread whose event fell out of the ring are
+    dropped.
+    """
+    merged = []
+    chunks = []
+
+    def attach_text():
+        if merged and chunks:
+            text = b"".join(chunks).rstrip(b"\0")
+            merged[-1][4] = text.decode("utf-8", "replace")
+        chunks.clear()
+
+    for timestamp_ns, value, string_id, event_type in events:
+        if event_type == _TEXT:
+            if merged:
+                chunks.append(struct.pack("<QI", value, string_id))
+            continue
+        attach_text()
+        merged.append([timestamp_ns, value, string_id, event_type, None])
+    attach_text()
+    return [tuple(event) for event in merged]
+
+
+def read_trace(data):
+    """Parses the trace file into a Trace."""
+    (
+        magic,
+        version,
+        flush_timestamp_ns,
+        string_count,
+        thread_count,
+        string_overflow_count,
+        text_truncation_count,
+    ) = _FILE_HEADER.unpack_from(data, 0)
+    if magic != _FILE_MAGIC:
+        raise ValueError("not an IREE ring trace file (bad magic)")
+    if version != _FILE_VERSION:
+        raise ValueError(f"unsupported ring trace file version {version}")
+    offset = _FILE_HEADER.size
+
+    strings = []
+    for _ in range(string_count):
+        (length,) = struct.unpack_from("<I", data, offset)
+        offset += 4
+        strings.append(data[offset : offset + length].decode("utf-8", "replace"))
+        offset += (length + 3) & ~3
+
+    threads = []
+    for _ in range(thread_count):
+        thread_id, name, event_count, _ = _THREAD_HEADER.unpack_from(data, offset)
+        offset += _THREAD_HEADER.size
+        events_size = event_count * _EVENT.size
+        events = merge_text_events(
+            _EVENT.iter_unpack(data[offset : offset + events_size])
+        )
+        offset += events_size
+        threads.append(
+            (thread_id, name.split(b"\0", 1)[0].decode("utf-8", "replace"), events)
+        )
+    return Trace(
+        flush_timestamp_ns,
+        strings,
+        threads,
+        string_overflow_count,
+        text_truncation_count,
+    )
+
+
+def convert(trace, pid):
+    """Converts a Trace into a list of Chrome trace events."""
+    flush_timestamp_ns = trace.flush_timestamp_ns
+    strings = trace.strings
+    threads = trace.threads
+    base_ns = min(
+        (events[0][0] for _, _, events in threads if events),
+        default=flush_timestamp_ns,
+    )
+
+    def to_us(timestamp_ns):
+        return (timestamp_ns - base_ns) / 1000.0
+
+    trace_events = [
+        {
+            "ph": "M",
+            "name": "process_name",
+            "pid": pid,
+            "args": {"name": "iree"},
+        }
+    ]
+    for thread_id, thread_name, events in threads:
+        trace_events.append(
+            {
+                "ph": "M",
+                "name": "thread_name",
+                "pid": pid,
+                "tid": thread_id,
+                "args": {"name": thread_name or f"thread {thread_id}"},
+            }
+        )
+
+        # Zones are emitted as complete events so that appended values and text
+        # can be attached as args. Zones whose begin fell outside of the flushed
+        # window are dropped and zones still open at the flush are closed at it.
+        stack = []
+
+        def close_zone(zone, end_ns):
+            zone_event, begin_ns = zone
+            zone_event["dur"] = (end_ns - begin_ns) / 1000.0
+            trace_events.append(zone_event)
+
+        for timestamp_ns, value, string_id, event_type, text in events:
+            if text is None:
+                text = strings[string_id]
+            if event_type == _ZONE_BEGIN:
+                file_id, line = value >> 32, value & 0xFFFFFFFF
+                name, _, file_name = text.partition("\0")
+                if file_id:
+                    file_name = strings[file_id]
+                args = {}
+                if file_name:
+                    args["location"] = f"{file_name}:{line}"
+                stack.append(
+                    (
+                        {
+                            "ph": "X",
+                            "name": name,
+                            "pid": pid,
+                            "tid": thread_id,
+                            "ts": to_us(timestamp_ns),
+                            "args": args,
+                        },
+                        timestamp_ns,
+                    )
+                )
+            elif event_type == _ZONE_END:
+                if stack:
+                    close_zone(stack.pop(), timestamp_ns)
+            elif event_type == _ZONE_VALUE:
+                if stack:
+                    if value >= 1 << 63:
+                        value -= 1 << 64
+                    stack[-1][0]["args"].setdefault("values", []).append(value)
+            elif event_type == _ZONE_TEXT:
+                if stack:
+                    stack[-1][0]["args"].setdefault("text", []).append(text)
+            elif event_type in (_PLOT_I64, _PLOT_F64):
+                if event_type == _PLOT_F64:
+                    (value,) = struct.unpack("<d", struct.pack("<Q", value))
+                elif value >= 1 << 63:
+                    value -= 1 << 64
+                name = text
+                trace_events.append(
+                    {
+                        "ph": "C",
+                        "name": name,
+                        "pid": pid,
+                        "ts": to_us(timestamp_ns),
+                        "args": {name: value},
+                    }
+                )
+            elif event_type == _MESSAGE:
+                trace_events.append(
+                    {
+                        "ph": "i",
+                        "s": "t",
+                        "name": text,
+                        "pid": pid,
+                        "tid": thread_id,
+                        "ts": to_us(timestamp_ns),
+                        "args": {"color": f"#{value & 0xFFFFFF:06X}"},
+                    }
+                )
+            elif event_type == _FRAME_MARK:
+                trace_events.append(
+                    {
+                        "ph": "i",
+                        "s": "g",
+                        "name": text or "frame",
+                        "pid": pid,
+                        "tid": thread_id,
+                        "ts": to_us(timestamp_ns),
+                    }
+                )
+            elif event_type in (_FRAME_BEGIN, _FRAME_END):
+                name = text or "frame"
+                trace_events.append(
+                    {
+                        "ph": "b" if event_type == _FRAME_BEGIN else "e",
+                        "cat": "frame",
+                        "id": name,
+                        "name": name,
+                        "pid": pid,
+                        "tid": thread_id,
+                        "ts": to_us(timestamp_ns),
+                    }
+                )
+        while stack:
+            close_zone(stack.pop(), flush_timestamp_ns)
+
+    return trace_events
+
+
+def main(args):
+    with open(args.input, "rb") as f:
+        data = f.read()
+    trace = read_trace(data)
+    if trace.string_overflow_count:
+        print(
+            f"warning: {trace.string_overflow_count} strings overflowed the "
+            "string table and are shown as empty",
+            file=sys.stderr,
+        )
+    if trace.text_truncation_count:
+        print(
+            f"warning: {trace.text_truncation_count} dynamic texts were "
+            "truncated",
+            file=sys.stderr,
+        )
+    output = {
+        "traceEvents": convert(trace, args.pid),
+        "displayTimeUnit": "ns",
+        "metadata": {
+            "string_overflow_count": trace.string_overflow_count,
+            "text_truncation_count": trace.text_truncation_count,
+        },
+    }
+    if args.output == "-":
+        json.dump(output, sys.stdout)
+    else:
+        with open(args.output, "w") as f:
+            json.dump(output, f)
+
+
+if __name__ == "__main__":
+    main(parse_arguments(sys.argv[1:]))
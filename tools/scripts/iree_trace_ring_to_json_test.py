@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+
+# Copyright 2025 The IREE Authors
+#
+# Licensed under the Apache License v2.0 with LLVM Exceptions.
+# See https://llvm.org/LICENSE.txt for license information.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+"""Round-trip tests for iree_trace_ring_to_json.
+
+Writes ring trace files in the format produced by
+runtime/src/iree/base/tracing/ring.c and checks the converted JSON.
+
+Example usage:
+  $ python3 ./tools/scripts/iree_trace_ring_to_json_test.py
+"""
+
+import json
+import os
+import struct
+import tempfile
+import unittest
+
+import iree_trace_ring_to_json as ring
+
+
+class TraceWriter:
+    """Builds a ring trace file."""
+
+    def __init__(self, flush_timestamp_ns):
+        self.flush_timestamp_ns = flush_timestamp_ns
+        self.strings = [""]
+        self.threads = []
+        self.string_overflow_count = 0
+        self.text_truncation_count = 0
+
+    def intern(self, value):
+        if value not in self.strings:
+            self.strings.append(value)
+        return self.strings.index(value)
+
+    def add_thread(self, thread_id, name):
+        events = []
+        self.threads.append((thread_id, name, events))
+        return events
+
+    @staticmethod
+    def add_event(events, timestamp_ns, event_type, string_id=0, value=0):
+        events.append((timestamp_ns, value, string_id, event_type))
+
+    @staticmethod
+    def add_text_event(events, timestamp_ns, event_type, text, value=0):
+        """Adds an event with inline text as iree_tracing_ring_record_text."""
+        events.append((timestamp_ns, value, 0, event_type))
+        data = text.encode("utf-8")
+        for offset in range(0, len(data), 12):
+            chunk = data[offset : offset + 12].ljust(12, b"\0")
+            chunk_value, chunk_string_id = struct.unpack("<QI", chunk)
+            events.append((timestamp_ns, chunk_value, chunk_string_id, ring._TEXT))
+
+    def serialize(self):
+        data = ring._FILE_HEADER.pack(
+            ring._FILE_MAGIC,
+            ring._FILE_VERSION,
+            self.flush_timestamp_ns,
+            len(self.strings),
+            len(self.threads),
+            self.string_overflow_count,
+            self.text_truncation_count,
+        )
+        for value in self.strings:
+            encoded = value.encode("utf-8")
+            data += struct.pack("<I", len(encoded)) + encoded
+            data += b"\0" * (((len(encoded) + 3) & ~3) - len(encoded))
+        for thread_id, name, events in self.threads:
+            data += ring._THREAD_HEADER.pack(
+                thread_id, name.encode("utf-8"), len(events), 0
+            )
+            for event in events:
+                data += ring._EVENT.pack(*event)
+        return data
+
+
+def convert(writer):
+    """Writes |writer| to a file and converts it with the script's main."""
+    with tempfile.TemporaryDirectory() as temp_dir:
+        input_path = os.path.join(temp_dir, "trace.bin")
+        output_path = os.path.join(temp_dir, "trace.json")
+        with open(input_path, "wb") as f:
+            f.write(writer.serialize())
+        ring.main(ring.parse_arguments([input_path, "-o", output_path]))
+        with open(output_path) as f:
+            return json.load(f)
+
+
+def find_events(trace, ph, name=None):
+    return [
+        event
+        for event in trace["traceEvents"]
+        if event["ph"] == ph and (name is None or event["name"] == name)
+    ]
+
+
+class RingToJsonTest(unittest.TestCase):
+    def test_static_zones(self):
+        writer = TraceWriter(flush_timestamp_ns=10000)
+        events = writer.add_thread(7, "worker[0]")
+        file_id = writer.intern("runtime/src/iree/task/worker.c")
+        writer.add_event(
+            events,
+            1000,
+            ring._ZONE_BEGIN,
+            writer.intern("iree_task_worker_main"),
+            (file_id << 32) | 42,
+        )
+        writer.add_event(events, 1500, ring._ZONE_VALUE, value=(1 << 64) - 3)
+        writer.add_event(events, 3000, ring._ZONE_END)
+
+        trace = convert(writer)
+        (zone,) = find_events(trace, "X")
+        self.assertEqual(zone["name"], "iree_task_worker_main")
+        self.assertEqual(zone["tid"], 7)
+        self.assertEqual(zone["ts"], 0.0)
+        self.assertEqual(zone["dur"], 2.0)
+        self.assertEqual(
+            zone["args"]["location"], "runtime/src/iree/task/worker.c:42"
+        )
+        self.assertEqual(zone["args"]["values"], [-3])
+        (thread_name,) = find_events(trace, "M", "thread_name")
+        self.assertEqual(thread_name["args"]["name"], "worker[0]")
+
+    def test_inline_text(self):
+        writer = TraceWriter(flush_timestamp_ns=10000)
+        events = writer.add_thread(1, "main")
+        file_id = writer.intern("module.c")
+        writer.add_text_event(
+            events,
+            1000,
+            ring._ZONE_BEGIN,
+            "a_dynamically_named_zone",
+            (file_id << 32) | 3,
+        )
+        writer.add_text_event(events, 1100, ring._ZONE_TEXT, "appended text")
+        writer.add_text_event(
+            events, 1200, ring._ZONE_BEGIN, "external\0program.mlir", 17
+        )
+        writer.add_event(events, 1300, ring._ZONE_END)
+        writer.add_event(events, 1400, ring._ZONE_END)
+        writer.add_text_event(
+            events, 1500, ring._MESSAGE, "exactly12byt", 0x112233
+        )
+
+        trace = convert(writer)
+        outer, inner = sorted(find_events(trace, "X"), key=lambda e: e["ts"])
+        self.assertEqual(outer["name"], "a_dynamically_named_zone")
+        self.assertEqual(outer["args"]["location"], "module.c:3")
+        self.assertEqual(outer["args"]["text"], ["appended text"])
+        self.assertEqual(inner["name"], "external")
+        self.assertEqual(inner["args"]["location"], "program.mlir:17")
+        (message,) = find_events(trace, "i")
+        self.assertEqual(message["name"], "exactly12byt")
+        self.assertEqual(message["args"]["color"], "#112233")
+
+    def test_orphaned_text_is_dropped(self):
+        writer = TraceWriter(flush_timestamp_ns=10000)
+        events = writer.add_thread(1, "main")
+        # The event the text belonged to was overwritten in the ring.
+        writer.add_text_event(events, 900, ring._MESSAGE, "overwritten message")
+        del events[0]
+        writer.add_event(
+            events, 1000, ring._PLOT_I64, writer.intern("queue_depth"), 5
+        )
+
+        trace = convert(writer)
+        self.assertEqual(find_events(trace, "i"), [])
+        (plot,) = find_events(trace, "C")
+        self.assertEqual(plot["args"], {"queue_depth": 5})
+
+    def test_overflow_counts(self):
+        writer = TraceWriter(flush_timestamp_ns=10000)
+        writer.string_overflow_count = 3
+        writer.text_truncation_count = 2
+
+        trace = convert(writer)
+        self.assertEqual(
+            trace["metadata"],
+            {"string_overflow_count": 3, "text_truncation_count": 2},
+        )
+
+
+if __name__ == "__main__":
+    unittest.main()